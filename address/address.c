@@ -41,6 +41,14 @@
  */
 const char AddressSpecials[] = "@.,:;<>[]\\\"()";
 
+/**
+ * AddressSpecialsWsp - Characters that end a plain word in an address
+ *
+ * #AddressSpecials plus the email whitespace characters, for use with strcspn()
+ * when copying whole runs of ordinary characters at once.
+ */
+static const char AddressSpecialsWsp[] = "@.,:;<>[]\\\"() \t\r\n";
+
 /**
  * is_special - Is this character special to an email address?
  * @param ch Character
@@ -81,6 +89,19 @@ static const char *parse_comment(const char *s, char *comment, size_t *commentle
 
   while (*s && level)
   {
+    const size_t run = strcspn(s, "()\\");
+    if (run != 0)
+    {
+      /* copy a whole run of ordinary characters in one go */
+      if (*commentlen < commentmax)
+      {
+        const size_t keep = MIN(run, commentmax - *commentlen);
+        memcpy(comment + *commentlen, s, keep);
+        *commentlen += keep;
+      }
+      s += run;
+      continue;
+    }
     if (*s == '(')
       level++;
     else if (*s == ')')
@@ -121,18 +142,27 @@ static const char *parse_quote(const char *s, char *token, size_t *tokenlen, siz
 {
   while (*s)
   {
-    if (*tokenlen < tokenmax)
-      token[*tokenlen] = *s;
-    if (*s == '\\')
+    const size_t run = strcspn(s, "\"\\");
+    if (run != 0)
     {
-      if (!*++s)
-        break;
-
+      /* copy a whole run of ordinary characters in one go */
       if (*tokenlen < tokenmax)
-        token[*tokenlen] = *s;
+      {
+        const size_t keep = MIN(run, tokenmax - *tokenlen);
+        memcpy(token + *tokenlen, s, keep);
+      }
+      *tokenlen += run;
+      s += run;
+      continue;
     }
-    else if (*s == '"')
+    if (*s == '"')
       return s + 1;
+
+    /* backslash: drop it and copy the escaped character */
+    if (!*++s)
+      break;
+    if (*tokenlen < tokenmax)
+      token[*tokenlen] = *s;
     (*tokenlen)++;
     s++;
   }
@@ -160,15 +190,14 @@ static const char *next_token(const char *s, char *token, size_t *tokenlen, size
       token[(*tokenlen)++] = *s;
     return s + 1;
   }
-  while (*s)
+  const size_t run = strcspn(s, AddressSpecialsWsp);
+  if ((run != 0) && (*tokenlen < tokenmax))
   {
-    if (mutt_str_is_email_wsp(*s) || is_special(*s))
-      break;
-    if (*tokenlen < tokenmax)
-      token[(*tokenlen)++] = *s;
-    s++;
+    const size_t keep = MIN(run, tokenmax - *tokenlen);
+    memcpy(token + *tokenlen, s, keep);
+    *tokenlen += keep;
   }
-  return s;
+  return s + run;
 }
 
 /**
@@ -754,6 +783,22 @@ void mutt_addrlist_copy(struct AddressList *dst, const struct AddressList *src,
   }
 }
 
+/**
+ * mutt_addrlist_move - Move one list of addresses onto the end of another
+ * @param dst Destination Address list
+ * @param src Source Address list
+ *
+ * The Addresses themselves are stolen, not copied, and src is left empty.
+ * Use this instead of mutt_addrlist_copy() when src is about to be cleared.
+ */
+void mutt_addrlist_move(struct AddressList *dst, struct AddressList *src)
+{
+  if (!dst || !src)
+    return;
+
+  TAILQ_CONCAT(dst, src, entries);
+}
+
 /**
  * mutt_addr_valid_msgid - Is this a valid Message ID?
  * @param msgid Message ID
@@ -95,6 +95,7 @@ void   mutt_addrlist_copy        (struct AddressList *dst, const struct AddressL
 int    mutt_addrlist_count_recips(const struct AddressList *al);
 void   mutt_addrlist_dedupe      (struct AddressList *al);
 bool   mutt_addrlist_equal       (const struct AddressList *ala, const struct AddressList *alb);
+void   mutt_addrlist_move        (struct AddressList *dst, struct AddressList *src);
 int    mutt_addrlist_parse       (struct AddressList *al, const char *s);
 int    mutt_addrlist_parse2      (struct AddressList *al, const char *s);
 void   mutt_addrlist_prepend     (struct AddressList *al, struct Address *a);
@@ -75,6 +75,94 @@
 #endif
 #endif /* HAVE_LIBIDN */
 
+/// Number of cached conversions before the cache is flushed
+#define IDNA_CACHE_MAX 1024
+
+/**
+ * struct IdnaCache - Cache of converted email addresses
+ *
+ * The conversions depend on `$charset` and `$idn_decode` / `$idn_encode`,
+ * so the settings used to fill the cache are remembered and the cache is
+ * flushed when they change.
+ */
+struct IdnaCache
+{
+  struct HashTable *table; ///< Map: "user@domain" -> converted mailbox
+  size_t count;            ///< Number of entries in the table
+  char *charset;           ///< Value of `$charset` when the cache was filled
+  bool idn;                ///< Value of `$idn_decode` / `$idn_encode`
+};
+
+/// Cache of Punycode-to-local conversions, for mutt_idna_intl_to_local()
+static struct IdnaCache IntlToLocal = { 0 };
+/// Cache of local-to-Punycode conversions, for mutt_idna_local_to_intl()
+static struct IdnaCache LocalToIntl = { 0 };
+
+/**
+ * idna_elem_free - Free a cached conversion - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void idna_elem_free(int type, void *obj, intptr_t data)
+{
+  FREE(&obj);
+}
+
+/**
+ * idna_cache_get - Find a cached conversion, validating the settings
+ * @param cache Cache to search
+ * @param key   Lookup key, e.g. "user\@domain"
+ * @param idn   Current value of `$idn_decode` / `$idn_encode`
+ * @retval ptr  Cached converted mailbox
+ * @retval NULL Not cached
+ *
+ * If `$charset` or the idn setting have changed since the cache was filled,
+ * the stale entries are dropped first.
+ */
+static const char *idna_cache_get(struct IdnaCache *cache, const char *key, bool idn)
+{
+  const char *const c_charset = cs_subset_string(NeoMutt->sub, "charset");
+
+  if (cache->table &&
+      ((cache->idn != idn) || !mutt_str_equal(cache->charset, c_charset)))
+  {
+    mutt_hash_free(&cache->table);
+    cache->count = 0;
+  }
+
+  if (!cache->table)
+  {
+    cache->table = mutt_hash_new(257, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(cache->table, idna_elem_free, 0);
+    cache->idn = idn;
+    mutt_str_replace(&cache->charset, c_charset);
+    return NULL;
+  }
+
+  return mutt_hash_find(cache->table, key);
+}
+
+/**
+ * idna_cache_put - Add a conversion to the cache
+ * @param cache   Cache to add to
+ * @param key     Lookup key, e.g. "user\@domain"
+ * @param mailbox Converted mailbox
+ *
+ * When the cache grows past #IDNA_CACHE_MAX entries it is simply flushed;
+ * a screenful of redraws will repopulate the addresses that matter.
+ */
+static void idna_cache_put(struct IdnaCache *cache, const char *key, const char *mailbox)
+{
+  if (cache->count >= IDNA_CACHE_MAX)
+  {
+    mutt_hash_free(&cache->table);
+    cache->table = mutt_hash_new(257, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(cache->table, idna_elem_free, 0);
+    cache->count = 0;
+  }
+
+  mutt_hash_insert(cache->table, key, mutt_str_dup(mailbox));
+  cache->count++;
+}
+
 #ifdef HAVE_LIBIDN
 /**
  * check_idn - Is domain in Punycode?
@@ -141,7 +229,7 @@ int mutt_idna_to_ascii_lz(const char *input, char **output, uint8_t flags)
  *
  * @note The caller must free the returned string.
  */
-char *mutt_idna_intl_to_local(const char *user, const char *domain, uint8_t flags)
+static char *intl_to_local(const char *user, const char *domain, uint8_t flags)
 {
   char *mailbox = NULL;
   char *reversed_user = NULL, *reversed_domain = NULL;
@@ -248,7 +336,50 @@ cleanup:
 }
 
 /**
- * mutt_idna_local_to_intl - Convert an email's domain to Punycode
+ * mutt_idna_intl_to_local - Convert an email's domain from Punycode
+ * @param user   Username
+ * @param domain Domain
+ * @param flags  Flags, e.g. #MI_MAY_BE_IRREVERSIBLE
+ * @retval ptr  Newly allocated local email address
+ * @retval NULL Error in conversion
+ *
+ * Caching wrapper around intl_to_local().  Index redraws convert the same
+ * senders over and over, so successful conversions are remembered until
+ * `$charset` or `$idn_decode` change.
+ *
+ * @note The caller must free the returned string.
+ */
+char *mutt_idna_intl_to_local(const char *user, const char *domain, uint8_t flags)
+{
+  char key[1024];
+  if (!user || !domain ||
+      ((mutt_str_len(user) + mutt_str_len(domain) + 3) > sizeof(key)))
+  {
+    return intl_to_local(user, domain, flags);
+  }
+
+  /* The reversibility check can reject an address that #MI_MAY_BE_IRREVERSIBLE
+   * would accept, so the flags are part of the key */
+  snprintf(key, sizeof(key), "%c%s@%s", '0' + flags, user, domain);
+
+#ifdef HAVE_LIBIDN
+  const bool c_idn_decode = cs_subset_bool(NeoMutt->sub, "idn_decode");
+#else
+  const bool c_idn_decode = false;
+#endif
+  const char *cached = idna_cache_get(&IntlToLocal, key, c_idn_decode);
+  if (cached)
+    return mutt_str_dup(cached);
+
+  char *mailbox = intl_to_local(user, domain, flags);
+  if (mailbox)
+    idna_cache_put(&IntlToLocal, key, mailbox);
+
+  return mailbox;
+}
+
+/**
+ * local_to_intl - Convert an email's domain to Punycode
  * @param user   Username
  * @param domain Domain
  * @retval ptr  Newly allocated Punycode email address
@@ -261,7 +392,7 @@ cleanup:
  *
  * @note The caller must free the returned string.
  */
-char *mutt_idna_local_to_intl(const char *user, const char *domain)
+static char *local_to_intl(const char *user, const char *domain)
 {
   char *mailbox = NULL;
   char *tmp = NULL;
@@ -305,6 +436,45 @@ cleanup:
   return mailbox;
 }
 
+/**
+ * mutt_idna_local_to_intl - Convert an email's domain to Punycode
+ * @param user   Username
+ * @param domain Domain
+ * @retval ptr  Newly allocated Punycode email address
+ * @retval NULL Error in conversion
+ *
+ * Caching wrapper around local_to_intl().  Successful conversions are
+ * remembered until `$charset` or `$idn_encode` change.
+ *
+ * @note The caller must free the returned string.
+ */
+char *mutt_idna_local_to_intl(const char *user, const char *domain)
+{
+  char key[1024];
+  if (!user || !domain ||
+      ((mutt_str_len(user) + mutt_str_len(domain) + 2) > sizeof(key)))
+  {
+    return local_to_intl(user, domain);
+  }
+
+  snprintf(key, sizeof(key), "%s@%s", user, domain);
+
+#ifdef HAVE_LIBIDN
+  const bool c_idn_encode = cs_subset_bool(NeoMutt->sub, "idn_encode");
+#else
+  const bool c_idn_encode = false;
+#endif
+  const char *cached = idna_cache_get(&LocalToIntl, key, c_idn_encode);
+  if (cached)
+    return mutt_str_dup(cached);
+
+  char *mailbox = local_to_intl(user, domain);
+  if (mailbox)
+    idna_cache_put(&LocalToIntl, key, mailbox);
+
+  return mailbox;
+}
+
 /**
  * mutt_idna_print_version - Create an IDN version string
  * @retval ptr Version string
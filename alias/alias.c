@@ -56,6 +56,12 @@
 
 struct AliasList Aliases = TAILQ_HEAD_INITIALIZER(Aliases); ///< List of all the user's email aliases
 
+static struct HashTable *AliasesByName = NULL; ///< Hash Table of aliases (alias name -> alias)
+
+static struct Alias **NameIndex = NULL; ///< Aliases sorted by name, for completion
+static size_t NameIndexLen = 0;         ///< Number of entries in #NameIndex
+static bool NameIndexDirty = true;      ///< #NameIndex needs rebuilding
+
 /**
  * write_safe_address - Defang malicious email addresses
  * @param fp File to write to
@@ -270,25 +276,144 @@ static bool string_is_address(const char *str, const char *user, const char *dom
 }
 
 /**
- * alias_lookup - Find an Alias
+ * alias_find - Find an Alias by name
  * @param name Alias name to find
- * @retval ptr  Address for the Alias
+ * @retval ptr  Matching Alias
  * @retval NULL No such Alias
  *
  * @note The search is case-insensitive
  */
-struct AddressList *alias_lookup(const char *name)
+struct Alias *alias_find(const char *name)
 {
-  struct Alias *a = NULL;
+  if (AliasesByName)
+    return mutt_hash_find(AliasesByName, name);
 
+  struct Alias *a = NULL;
   TAILQ_FOREACH(a, &Aliases, entries)
   {
     if (mutt_istr_equal(name, a->name))
-      return &a->addr;
+      return a;
   }
   return NULL;
 }
 
+/**
+ * alias_hash_add - Add an Alias to the name index
+ * @param alias Alias to add
+ *
+ * Call after the Alias has been named and inserted into #Aliases.
+ * alias_free() removes the entry again.
+ */
+void alias_hash_add(struct Alias *alias)
+{
+  if (!alias || !alias->name || !AliasesByName)
+    return;
+
+  mutt_hash_insert(AliasesByName, alias->name, alias);
+  NameIndexDirty = true;
+}
+
+/**
+ * name_index_compare - Compare two aliases by name - Implements ::sort_t - @ingroup sort_api
+ */
+static int name_index_compare(const void *a, const void *b)
+{
+  const struct Alias *aa = *(struct Alias const *const *) a;
+  const struct Alias *ab = *(struct Alias const *const *) b;
+
+  return mutt_str_cmp(aa->name, ab->name);
+}
+
+/**
+ * name_index_build - Rebuild the sorted name index from #Aliases
+ *
+ * Sorting once per change, lazily on the next lookup, keeps loading a big
+ * alias file linear - a sorted insert per alias would be quadratic.
+ */
+static void name_index_build(void)
+{
+  size_t num = 0;
+  struct Alias *np = NULL;
+  TAILQ_FOREACH(np, &Aliases, entries)
+  {
+    if (np->name)
+      num++;
+  }
+
+  mutt_mem_realloc(&NameIndex, MAX(num, 1) * sizeof(struct Alias *));
+  NameIndexLen = 0;
+  TAILQ_FOREACH(np, &Aliases, entries)
+  {
+    if (np->name)
+      NameIndex[NameIndexLen++] = np;
+  }
+
+  qsort(NameIndex, NameIndexLen, sizeof(struct Alias *), name_index_compare);
+  NameIndexDirty = false;
+}
+
+/**
+ * alias_complete_prefix - Find the aliases whose name starts with a prefix
+ * @param[in]  prefix Prefix to match
+ * @param[out] num    Number of matching aliases
+ * @retval ptr  First match in the sorted name index
+ * @retval NULL No alias matches
+ *
+ * Two binary searches bound the run of matches, so a keystroke costs
+ * O(log n) instead of a walk over every alias.  The result points into the
+ * index and is sorted by name; it's valid until the aliases next change.
+ */
+struct Alias **alias_complete_prefix(const char *prefix, size_t *num)
+{
+  *num = 0;
+  if (!prefix || (prefix[0] == '\0'))
+    return NULL;
+
+  if (NameIndexDirty)
+    name_index_build();
+
+  const size_t plen = strlen(prefix);
+
+  /* first name with the prefix... */
+  size_t lo = 0;
+  for (size_t span = NameIndexLen; span != 0; span /= 2)
+  {
+    const size_t mid = lo + (span / 2);
+    if (strncmp(NameIndex[mid]->name, prefix, plen) < 0)
+      lo = mid + 1, span--;
+  }
+
+  /* ...and first name past it */
+  size_t hi = lo;
+  for (size_t span = NameIndexLen - lo; span != 0; span /= 2)
+  {
+    const size_t mid = hi + (span / 2);
+    if (strncmp(NameIndex[mid]->name, prefix, plen) <= 0)
+      hi = mid + 1, span--;
+  }
+
+  if (lo == hi)
+    return NULL;
+
+  *num = hi - lo;
+  return &NameIndex[lo];
+}
+
+/**
+ * alias_lookup - Find an Alias
+ * @param name Alias name to find
+ * @retval ptr  Address for the Alias
+ * @retval NULL No such Alias
+ *
+ * @note The search is case-insensitive
+ */
+struct AddressList *alias_lookup(const char *name)
+{
+  struct Alias *a = alias_find(name);
+
+  return a ? &a->addr : NULL;
+}
+
 /**
  * mutt_expand_aliases - Expand aliases in a List of Addresses
  * @param al AddressList
@@ -497,6 +622,7 @@ retry_name:
 
   alias_reverse_add(alias);
   TAILQ_INSERT_TAIL(&Aliases, alias, entries);
+  alias_hash_add(alias);
 
   const char *const alias_file = cs_subset_path(sub, "alias_file");
   mutt_buffer_strcpy(buf, alias_file);
@@ -649,6 +775,14 @@ void alias_free(struct Alias **ptr)
   struct EventAlias ev_a = { alias };
   notify_send(NeoMutt->notify, NT_ALIAS, NT_ALIAS_DELETE, &ev_a);
 
+  /* the hash matches on the data pointer too, so an unindexed namesake of
+   * this alias (e.g. from a query) can't remove the real entry */
+  if (AliasesByName && alias->name)
+  {
+    mutt_hash_delete(AliasesByName, alias->name, alias);
+    NameIndexDirty = true;
+  }
+
   FREE(&alias->name);
   FREE(&alias->comment);
   mutt_addrlist_clear(&(alias->addr));
@@ -675,6 +809,9 @@ void aliaslist_free(struct AliasList *al)
  */
 void alias_init(void)
 {
+  /* the keys are the aliases' own name strings; alias_free() removes the
+   * entry before freeing the name */
+  AliasesByName = mutt_hash_new(1031, MUTT_HASH_STRCASECMP);
   alias_reverse_init();
 }
 
@@ -690,4 +827,8 @@ void alias_shutdown(void)
   }
   aliaslist_free(&Aliases);
   alias_reverse_shutdown();
+  mutt_hash_free(&AliasesByName);
+  FREE(&NameIndex);
+  NameIndexLen = 0;
+  NameIndexDirty = true;
 }
@@ -90,11 +90,7 @@ enum CommandResult parse_alias(struct Buffer *buf, struct Buffer *s,
   }
 
   /* check to see if an alias with this name already exists */
-  TAILQ_FOREACH(tmp, &Aliases, entries)
-  {
-    if (mutt_istr_equal(tmp->name, name))
-      break;
-  }
+  tmp = alias_find(name);
 
   if (tmp)
   {
@@ -111,6 +107,7 @@ enum CommandResult parse_alias(struct Buffer *buf, struct Buffer *s,
     tmp = alias_new();
     tmp->name = name;
     TAILQ_INSERT_TAIL(&Aliases, tmp, entries);
+    alias_hash_add(tmp);
     event = NT_ALIAS_ADD;
   }
   tmp->addr = al;
@@ -177,15 +174,12 @@ enum CommandResult parse_unalias(struct Buffer *buf, struct Buffer *s,
       return MUTT_CMD_SUCCESS;
     }
 
-    TAILQ_FOREACH(np, &Aliases, entries)
+    np = alias_find(buf->data);
+    if (np)
     {
-      if (!mutt_istr_equal(buf->data, np->name))
-        continue;
-
       TAILQ_REMOVE(&Aliases, np, entries);
       alias_reverse_delete(np);
       alias_free(&np);
-      break;
     }
   } while (MoreArgs(s));
   return MUTT_CMD_SUCCESS;
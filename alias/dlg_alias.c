@@ -390,24 +390,19 @@ int alias_complete(char *buf, size_t buflen, struct ConfigSubset *sub)
 
   if (buf[0] != '\0')
   {
-    TAILQ_FOREACH(np, &Aliases, entries)
+    size_t num = 0;
+    struct Alias **matches = alias_complete_prefix(buf, &num);
+    if (num != 0)
     {
-      if (np->name && mutt_strn_equal(np->name, buf, strlen(buf)))
-      {
-        if (bestname[0] == '\0') /* init */
-        {
-          mutt_str_copy(bestname, np->name,
-                        MIN(mutt_str_len(np->name) + 1, sizeof(bestname)));
-        }
-        else
-        {
-          int i;
-          for (i = 0; np->name[i] && (np->name[i] == bestname[i]); i++)
-            ; // do nothing
-
-          bestname[i] = '\0';
-        }
-      }
+      /* the index is sorted, so every match shares the common prefix of the
+       * first and the last one */
+      const char *first = matches[0]->name;
+      const char *last = matches[num - 1]->name;
+      size_t i;
+      for (i = 0; first[i] && (first[i] == last[i]); i++)
+        ; // do nothing
+
+      mutt_str_copy(bestname, first, MIN(i + 1, sizeof(bestname)));
     }
 
     if (bestname[0] != '\0')
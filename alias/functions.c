@@ -66,8 +66,7 @@ static int op_create_alias(struct AliasMenuData *mdata, int op)
       struct AddressList al = TAILQ_HEAD_INITIALIZER(al);
       if (alias_to_addrlist(&al, avp->alias))
       {
-        mutt_addrlist_copy(&naddr, &al, false);
-        mutt_addrlist_clear(&al);
+        mutt_addrlist_move(&naddr, &al);
       }
     }
 
@@ -149,8 +148,7 @@ static int op_generic_select_entry(struct AliasMenuData *mdata, int op)
       struct AddressList al = TAILQ_HEAD_INITIALIZER(al);
       if (alias_to_addrlist(&al, avp->alias))
       {
-        mutt_addrlist_copy(&e->env->to, &al, false);
-        mutt_addrlist_clear(&al);
+        mutt_addrlist_move(&e->env->to, &al);
       }
     }
   }
@@ -159,8 +157,7 @@ static int op_generic_select_entry(struct AliasMenuData *mdata, int op)
     struct AddressList al = TAILQ_HEAD_INITIALIZER(al);
     if (alias_to_addrlist(&al, ARRAY_GET(&mdata->ava, menu_get_index(menu))->alias))
     {
-      mutt_addrlist_copy(&e->env->to, &al, false);
-      mutt_addrlist_clear(&al);
+      mutt_addrlist_move(&e->env->to, &al);
     }
   }
   struct Mailbox *m_cur = get_current_mailbox();
@@ -58,6 +58,9 @@ void alias_init    (void);
 void alias_shutdown(void);
 
 void                alias_create           (struct AddressList *al, const struct ConfigSubset *sub);
+struct Alias      **alias_complete_prefix  (const char *prefix, size_t *num);
+struct Alias       *alias_find             (const char *name);
+void                alias_hash_add         (struct Alias *alias);
 struct AddressList *alias_lookup           (const char *name);
 
 bool                mutt_addr_is_user      (const struct Address *addr);
@@ -66,6 +66,27 @@ void alternates_init(void)
   notify_set_parent(AlternatesNotify, NeoMutt->notify);
 }
 
+/**
+ * mutt_alternates_fingerprint - Mix the alternates patterns into an MD5 digest
+ * @param md5ctx MD5 context to update
+ *
+ * The header cache stores Envelope::disp_author, which depends on which
+ * addresses count as the user's own, so its version has to change when the
+ * patterns change.
+ */
+void mutt_alternates_fingerprint(struct Md5Ctx *md5ctx)
+{
+  struct RegexNode *np = NULL;
+  STAILQ_FOREACH(np, &Alternates, entries)
+  {
+    mutt_md5_process(np->regex->pattern, md5ctx);
+  }
+  STAILQ_FOREACH(np, &UnAlternates, entries)
+  {
+    mutt_md5_process(np->regex->pattern, md5ctx);
+  }
+}
+
 /**
  * mutt_alternates_reset - Clear the recipient valid flag of all emails
  */
@@ -28,6 +28,7 @@
 #include "core/lib.h"
 
 struct Buffer;
+struct Md5Ctx;
 
 /**
  * enum NotifyAlternates - Alternates command notification types
@@ -49,6 +50,7 @@ void alternates_free(void);
 enum CommandResult parse_alternates  (struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
 enum CommandResult parse_unalternates(struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
 
+void mutt_alternates_fingerprint(struct Md5Ctx *md5ctx);
 bool mutt_alternates_match(const char *addr);
 void mutt_alternates_reset(struct Mailbox *m);
 
@@ -262,8 +262,12 @@ int mutt_count_body_parts(struct Mailbox *m, struct Email *e, FILE *fp)
 
   if (e->body->parts)
     keep_parts = true;
-  else
+  else if ((e->body->type == TYPE_MULTIPART) || (e->body->type == TYPE_MESSAGE))
+  {
+    /* only these types have sub-parts; for anything else the top-level Body
+     * from the header parse is all count_body_parts() needs */
     mutt_parse_mime_message(e, fp);
+  }
 
   if (!STAILQ_EMPTY(&AttachAllow) || !STAILQ_EMPTY(&AttachExclude) ||
       !STAILQ_EMPTY(&InlineAllow) || !STAILQ_EMPTY(&InlineExclude))
@@ -281,6 +285,35 @@ int mutt_count_body_parts(struct Mailbox *m, struct Email *e, FILE *fp)
   return e->attach_total;
 }
 
+/**
+ * mutt_attachments_fingerprint - Mix the attachment-counting config into an MD5 hash
+ * @param md5ctx MD5 context
+ *
+ * The cached attachment counts (Email::attach_total) depend on the
+ * `attachments` command and `$count_alternatives`.  Mixing them into the
+ * header cache checksum invalidates cached counts when the config changes.
+ */
+void mutt_attachments_fingerprint(struct Md5Ctx *md5ctx)
+{
+  struct ListHead *lists[] = { &AttachAllow, &AttachExclude, &InlineAllow, &InlineExclude };
+
+  for (size_t i = 0; i < mutt_array_size(lists); i++)
+  {
+    struct ListNode *np = NULL;
+    STAILQ_FOREACH(np, lists[i], entries)
+    {
+      const struct AttachMatch *a = (const struct AttachMatch *) np->data;
+      mutt_md5_process(a->major, md5ctx);
+      mutt_md5_process(a->minor, md5ctx);
+    }
+    mutt_md5_process("|", md5ctx); /* keep the four lists distinct */
+  }
+
+  const bool c_count_alternatives =
+      cs_subset_bool(NeoMutt->sub, "count_alternatives");
+  mutt_md5_process_bytes(&c_count_alternatives, sizeof(c_count_alternatives), md5ctx);
+}
+
 /**
  * mutt_attachments_reset - Reset the attachment count for all Emails
  */
@@ -589,6 +622,11 @@ enum CommandResult parse_unattachments(struct Buffer *buf, struct Buffer *s,
  * mutt_parse_mime_message - Parse a MIME email
  * @param e Email
  * @param fp File to parse
+ *
+ * The parsed structure is cached in Email::body and reused on later calls, so
+ * reopening the attachment view of a large message doesn't walk its MIME
+ * parts again.  The mailbox backends free the cached tree when the message
+ * changes on disk.
  */
 void mutt_parse_mime_message(struct Email *e, FILE *fp)
 {
@@ -603,7 +641,6 @@ void mutt_parse_mime_message(struct Email *e, FILE *fp)
     {
       e->security = crypt_query(e->body);
     }
+    e->attach_valid = false;
   }
-
-  e->attach_valid = false;
 }
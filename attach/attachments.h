@@ -27,6 +27,7 @@
 
 struct Email;
 struct Mailbox;
+struct Md5Ctx;
 
 /**
  * enum NotifyAttach - Attachments notification types
@@ -45,6 +46,7 @@ enum NotifyAttach
 void attach_init(void);
 void attach_free(void);
 
+void mutt_attachments_fingerprint(struct Md5Ctx *md5ctx);
 void mutt_attachments_reset (struct Mailbox *m);
 int  mutt_count_body_parts  (struct Mailbox *m, struct Email *e, FILE *fp);
 void mutt_parse_mime_message(struct Email *e, FILE *fp);
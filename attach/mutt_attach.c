@@ -84,7 +84,7 @@ int mutt_get_tmp_attachment(struct Body *a)
   if ((fp_in = fopen(a->filename, "r")) &&
       (fp_out = mutt_file_fopen(mutt_buffer_string(tmpfile), "w")))
   {
-    mutt_file_copy_stream(fp_in, fp_out);
+    mutt_file_copy_contents(fp_in, fp_out);
     mutt_str_replace(&a->filename, mutt_buffer_string(tmpfile));
     a->unlink = true;
 
@@ -983,7 +983,11 @@ int mutt_save_attachment(FILE *fp, struct Body *m, const char *path,
       return -1;
     }
 
-    if (mutt_file_copy_stream(fp_old, fp_new) == -1)
+    /* The content is stored verbatim, so the kernel can clone it for us */
+    const int copied = (opt == MUTT_SAVE_APPEND) ?
+                           mutt_file_copy_stream(fp_old, fp_new) :
+                           mutt_file_copy_contents(fp_old, fp_new);
+    if (copied == -1)
     {
       mutt_error(_("Write fault"));
       mutt_file_fclose(&fp_old);
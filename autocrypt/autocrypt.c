@@ -257,6 +257,27 @@ cleanup:
   return rc;
 }
 
+/**
+ * mutt_autocrypt_batch_begin - Start batching Autocrypt database writes
+ *
+ * Call before an operation that processes many messages, e.g. opening or
+ * checking a mailbox.  The peer updates from their Autocrypt headers are then
+ * committed as one transaction by mutt_autocrypt_batch_end(), instead of one
+ * fsync-backed transaction per message.  Calls may nest.
+ */
+void mutt_autocrypt_batch_begin(void)
+{
+  mutt_autocrypt_db_batch_begin();
+}
+
+/**
+ * mutt_autocrypt_batch_end - Finish batching Autocrypt database writes
+ */
+void mutt_autocrypt_batch_end(void)
+{
+  mutt_autocrypt_db_batch_end();
+}
+
 /**
  * mutt_autocrypt_process_autocrypt_header - Parse an Autocrypt email header
  * @param e   Email
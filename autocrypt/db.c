@@ -51,6 +51,57 @@ static sqlite3_stmt *GossipHistoryInsertStmt;
 
 sqlite3 *AutocryptDB = NULL;
 
+static int BatchDepth = 0;        ///< Nesting depth of db_batch_begin() calls
+static bool BatchTxnOpen = false; ///< A batch transaction is open on the database
+
+/**
+ * autocrypt_db_batch_write - Note a write during a batch
+ *
+ * Called before each statement that modifies the database.  If a batch is
+ * active, the enclosing transaction is opened lazily here: header processing
+ * only writes for messages that actually carry a newer Autocrypt header, and
+ * the database itself may not be connected until the first one is seen.
+ * Without a batch, each write stays in its own implicit transaction.
+ */
+static void autocrypt_db_batch_write(void)
+{
+  if ((BatchDepth == 0) || BatchTxnOpen || !AutocryptDB)
+    return;
+
+  if (sqlite3_exec(AutocryptDB, "BEGIN IMMEDIATE;", NULL, NULL, NULL) == SQLITE_OK)
+    BatchTxnOpen = true;
+}
+
+/**
+ * mutt_autocrypt_db_batch_begin - Start batching database writes
+ *
+ * Until the matching mutt_autocrypt_db_batch_end(), peer updates are grouped
+ * into a single transaction instead of paying one fsync per message.
+ * Calls may nest; only the outermost pair commits.
+ */
+void mutt_autocrypt_db_batch_begin(void)
+{
+  BatchDepth++;
+}
+
+/**
+ * mutt_autocrypt_db_batch_end - Finish batching database writes
+ *
+ * Commits the batch transaction, if any writes opened one.
+ */
+void mutt_autocrypt_db_batch_end(void)
+{
+  if (BatchDepth == 0)
+    return;
+
+  BatchDepth--;
+  if ((BatchDepth == 0) && BatchTxnOpen)
+  {
+    sqlite3_exec(AutocryptDB, "COMMIT;", NULL, NULL, NULL);
+    BatchTxnOpen = false;
+  }
+}
+
 /**
  * autocrypt_db_create - Create an Autocrypt SQLite database
  * @param db_path Path to database file
@@ -133,6 +184,12 @@ void mutt_autocrypt_db_close(void)
   if (!AutocryptDB)
     return;
 
+  if (BatchTxnOpen)
+  {
+    sqlite3_exec(AutocryptDB, "COMMIT;", NULL, NULL, NULL);
+    BatchTxnOpen = false;
+  }
+
   sqlite3_finalize(AccountGetStmt);
   AccountGetStmt = NULL;
   sqlite3_finalize(AccountInsertStmt);
@@ -659,6 +716,7 @@ int mutt_autocrypt_db_peer_insert(struct Address *addr, struct AutocryptPeer *pe
   if (sqlite3_bind_text(PeerInsertStmt, 9, peer->gossip_keydata, -1, SQLITE_STATIC) != SQLITE_OK)
     goto cleanup;
 
+  autocrypt_db_batch_write();
   if (sqlite3_step(PeerInsertStmt) != SQLITE_DONE)
     goto cleanup;
 
@@ -718,6 +776,7 @@ int mutt_autocrypt_db_peer_update(struct AutocryptPeer *peer)
   if (sqlite3_bind_text(PeerUpdateStmt, 9, peer->email_addr, -1, SQLITE_STATIC) != SQLITE_OK)
     goto cleanup;
 
+  autocrypt_db_batch_write();
   if (sqlite3_step(PeerUpdateStmt) != SQLITE_DONE)
     goto cleanup;
 
@@ -795,6 +854,7 @@ int mutt_autocrypt_db_peer_history_insert(struct Address *addr,
   if (sqlite3_bind_text(PeerHistoryInsertStmt, 4, peerhist->keydata, -1, SQLITE_STATIC) != SQLITE_OK)
     goto cleanup;
 
+  autocrypt_db_batch_write();
   if (sqlite3_step(PeerHistoryInsertStmt) != SQLITE_DONE)
     goto cleanup;
 
@@ -885,6 +945,7 @@ int mutt_autocrypt_db_gossip_history_insert(struct Address *addr,
     goto cleanup;
   }
 
+  autocrypt_db_batch_write();
   if (sqlite3_step(GossipHistoryInsertStmt) != SQLITE_DONE)
     goto cleanup;
 
@@ -30,10 +30,15 @@
 #include "config.h"
 #include <dirent.h>
 #include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <time.h>
 #include <unistd.h>
+#include <utime.h>
 #include "mutt/lib.h"
 #include "config/lib.h"
 #include "email/lib.h"
@@ -41,15 +46,43 @@
 #include "lib.h"
 #include "mutt_account.h"
 #include "muttlib.h"
+#ifdef USE_HCACHE_COMPRESSION
+#include "compress/lib.h"
+#endif
 
 struct ConnAccount;
 
+#ifdef USE_HCACHE_COMPRESSION
+/// Magic prefix of compressed cache entries.  It starts with a NUL byte,
+/// which can't occur at the start of a message, so plain entries written by
+/// older versions are still recognised and migration is transparent.
+static const char BcacheMagic[] = "\0NMBC1";
+
+/**
+ * struct BcachePut - Pending mutt_bcache_put() file
+ *
+ * With compression enabled, put() hands the caller a plain temporary file
+ * and remembers it here, so that commit() can compress its contents into
+ * the cache while the caller carries on using the plain copy.
+ */
+struct BcachePut
+{
+  char *id; ///< Cache id the file belongs to
+  FILE *fp; ///< Plain temporary file the caller writes to
+  STAILQ_ENTRY(BcachePut) entries;
+};
+STAILQ_HEAD(BcachePutList, BcachePut);
+#endif
+
 /**
  * struct BodyCache - Local cache of email bodies
  */
 struct BodyCache
 {
   char *path; ///< On-disk path to the file
+#ifdef USE_HCACHE_COMPRESSION
+  struct BcachePutList puts; ///< put() files awaiting commit()
+#endif
 };
 
 /**
@@ -132,6 +165,283 @@ static int mutt_bcache_move(struct BodyCache *bcache, const char *id, const char
   return rc;
 }
 
+/**
+ * struct BcacheEntry - Cache entry seen by bcache_prune()
+ */
+struct BcacheEntry
+{
+  char *name;   ///< Filename relative to BodyCache.path
+  off_t size;   ///< Size of the entry in bytes
+  time_t mtime; ///< Time of last use
+};
+
+/**
+ * bcache_sort_mtime - Compare the last-use times of two cache entries - Implements ::sort_t - @ingroup sort_api
+ */
+static int bcache_sort_mtime(const void *a, const void *b)
+{
+  const struct BcacheEntry *ea = a;
+  const struct BcacheEntry *eb = b;
+
+  return (ea->mtime > eb->mtime) - (ea->mtime < eb->mtime);
+}
+
+/**
+ * bcache_prune - Evict old entries to keep the cache within its quota
+ * @param bcache  Body cache
+ * @param keep_id Id of the entry that was just committed, never evicted
+ *
+ * If $message_cache_size is set, measure the cache directory and unlink the
+ * least recently used entries until the total fits.  mutt_bcache_get()
+ * refreshes the mtime of every entry it reads, so sorting by mtime gives the
+ * use order even on noatime filesystems.
+ */
+static void bcache_prune(struct BodyCache *bcache, const char *keep_id)
+{
+  const long c_message_cache_size =
+      cs_subset_long(NeoMutt->sub, "message_cache_size");
+  if (c_message_cache_size <= 0)
+    return;
+
+  DIR *d = opendir(bcache->path);
+  if (!d)
+    return;
+
+  struct BcacheEntry *entries = NULL;
+  int num = 0;
+  int max = 0;
+  long long total = 0;
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  struct dirent *de = NULL;
+  while ((de = readdir(d)))
+  {
+    if (mutt_str_startswith(de->d_name, "."))
+      continue;
+
+    /* skip uncommitted files and POP's header cache, which shares the dir */
+    const size_t len = mutt_str_len(de->d_name);
+    if ((len > 4) && mutt_str_equal(de->d_name + len - 4, ".tmp"))
+      continue;
+    if ((len > 7) && mutt_str_equal(de->d_name + len - 7, ".hcache"))
+      continue;
+
+    mutt_buffer_printf(path, "%s%s", bcache->path, de->d_name);
+    struct stat st = { 0 };
+    if ((stat(mutt_buffer_string(path), &st) != 0) || !S_ISREG(st.st_mode))
+      continue;
+
+    if (num == max)
+    {
+      max += 128;
+      mutt_mem_realloc(&entries, max * sizeof(struct BcacheEntry));
+    }
+    entries[num].name = mutt_str_dup(de->d_name);
+    entries[num].size = st.st_size;
+    entries[num].mtime = st.st_mtime;
+    num++;
+    total += st.st_size;
+  }
+  closedir(d);
+
+  if (total > c_message_cache_size)
+  {
+    qsort(entries, num, sizeof(struct BcacheEntry), bcache_sort_mtime);
+    for (int i = 0; (i < num) && (total > c_message_cache_size); i++)
+    {
+      if (mutt_str_equal(entries[i].name, keep_id))
+        continue;
+      mutt_buffer_printf(path, "%s%s", bcache->path, entries[i].name);
+      mutt_debug(LL_DEBUG3, "bcache: prune: '%s'\n", mutt_buffer_string(path));
+      if (unlink(mutt_buffer_string(path)) == 0)
+        total -= entries[i].size;
+    }
+  }
+
+  for (int i = 0; i < num; i++)
+    FREE(&entries[i].name);
+  FREE(&entries);
+  mutt_buffer_pool_release(&path);
+}
+
+#ifdef USE_HCACHE_COMPRESSION
+/**
+ * bcache_compress_ops - Get the configured message cache compressor
+ * @retval ptr  Compression operations
+ * @retval NULL Compression isn't enabled
+ */
+static const struct ComprOps *bcache_compress_ops(void)
+{
+  const char *const c_message_cache_compress_method =
+      cs_subset_string(NeoMutt->sub, "message_cache_compress_method");
+  if (!c_message_cache_compress_method)
+    return NULL;
+
+  return compress_get_ops(c_message_cache_compress_method);
+}
+
+/**
+ * bcache_put_find - Find a pending put() file by its cache id
+ * @param bcache Body cache
+ * @param id     Per-mailbox unique identifier for the message
+ * @retval ptr  Matching entry
+ * @retval NULL Not found
+ */
+static struct BcachePut *bcache_put_find(struct BodyCache *bcache, const char *id)
+{
+  struct BcachePut *bp = NULL;
+  STAILQ_FOREACH(bp, &bcache->puts, entries)
+  {
+    if (mutt_str_equal(bp->id, id))
+      return bp;
+  }
+  return NULL;
+}
+
+/**
+ * bcache_put_remove - Forget a pending put() file
+ * @param bcache Body cache
+ * @param bp     Entry to remove
+ *
+ * The temporary file itself belongs to the caller of mutt_bcache_put() and
+ * isn't closed here.
+ */
+static void bcache_put_remove(struct BodyCache *bcache, struct BcachePut *bp)
+{
+  STAILQ_REMOVE(&bcache->puts, bp, BcachePut, entries);
+  FREE(&bp->id);
+  FREE(&bp);
+}
+
+/**
+ * bcache_commit_compressed - Compress a pending put() file into the cache
+ * @param bcache Body cache
+ * @param bp     Pending file from mutt_bcache_put()
+ * @param cops   Compression operations
+ * @retval  0 Success
+ * @retval -1 Error
+ *
+ * The cache entry gets a magic prefix, the name of the compression method
+ * and the plain size, followed by the compressed data.
+ */
+static int bcache_commit_compressed(struct BodyCache *bcache,
+                                    struct BcachePut *bp, const struct ComprOps *cops)
+{
+  const short c_message_cache_compress_level =
+      cs_subset_number(NeoMutt->sub, "message_cache_compress_level");
+  int rc = -1;
+  char *data = NULL;
+  void *cctx = NULL;
+
+  /* don't disturb the caller's file position; it keeps using the plain file */
+  const long pos = ftell(bp->fp);
+  fflush(bp->fp);
+  const long size = mutt_file_get_size_fp(bp->fp);
+  rewind(bp->fp);
+  if (size > 0)
+  {
+    data = mutt_mem_malloc(size);
+    if (fread(data, 1, size, bp->fp) == (size_t) size)
+      cctx = cops->open(c_message_cache_compress_level);
+  }
+
+  if (cctx)
+  {
+    size_t clen = 0;
+    void *cbuf = cops->compress(cctx, data, size, &clen);
+    if (cbuf)
+    {
+      struct Buffer *path = mutt_buffer_pool_get();
+      mutt_buffer_printf(path, "%s%s.tmp", bcache->path, bp->id);
+
+      FILE *fp_out = mutt_file_fopen(mutt_buffer_string(path), "w");
+      if (fp_out)
+      {
+        const uint64_t dlen = size;
+        const size_t nlen = strlen(cops->name) + 1;
+        if ((fwrite(BcacheMagic, 1, sizeof(BcacheMagic), fp_out) == sizeof(BcacheMagic)) &&
+            (fwrite(cops->name, 1, nlen, fp_out) == nlen) &&
+            (fwrite(&dlen, sizeof(dlen), 1, fp_out) == 1) &&
+            (fwrite(cbuf, 1, clen, fp_out) == clen))
+        {
+          rc = 0;
+        }
+        mutt_file_fclose(&fp_out);
+
+        struct Buffer *tmpid = mutt_buffer_pool_get();
+        mutt_buffer_printf(tmpid, "%s.tmp", bp->id);
+        if (rc == 0)
+          rc = mutt_bcache_move(bcache, mutt_buffer_string(tmpid), bp->id);
+        else
+          unlink(mutt_buffer_string(path));
+        mutt_buffer_pool_release(&tmpid);
+      }
+      mutt_buffer_pool_release(&path);
+    }
+    cops->close(&cctx);
+  }
+
+  FREE(&data);
+  fseek(bp->fp, pos, SEEK_SET);
+  return rc;
+}
+
+/**
+ * bcache_decompress - Decompress a cache entry to a temporary file
+ * @param fp Compressed cache file, positioned after the magic
+ * @retval ptr  Plain temporary file
+ * @retval NULL Error, treat the entry as missing
+ */
+static FILE *bcache_decompress(FILE *fp)
+{
+  /* NUL-terminated name of the compression method */
+  char method[32];
+  size_t mlen = 0;
+  int ch;
+  while (((ch = fgetc(fp)) != EOF) && (ch != '\0'))
+  {
+    if (mlen == (sizeof(method) - 1))
+      return NULL;
+    method[mlen++] = ch;
+  }
+  method[mlen] = '\0';
+  if (ch == EOF)
+    return NULL;
+
+  const struct ComprOps *cops = compress_get_ops(method);
+  uint64_t dlen = 0;
+  if (!cops || (fread(&dlen, sizeof(dlen), 1, fp) != 1) || (dlen == 0))
+    return NULL;
+
+  const long offset = ftell(fp);
+  const long size = mutt_file_get_size_fp(fp);
+  if (size <= offset)
+    return NULL;
+  const size_t clen = size - offset;
+
+  char *cbuf = mutt_mem_malloc(clen);
+  FILE *fp_plain = NULL;
+  void *cctx = NULL;
+  if (fread(cbuf, 1, clen, fp) == clen)
+    cctx = cops->open(cops->min_level);
+  if (cctx)
+  {
+    void *data = cops->decompress(cctx, cbuf, clen);
+    if (data)
+    {
+      fp_plain = mutt_file_mkstemp();
+      if (fp_plain && (fwrite(data, 1, dlen, fp_plain) == dlen))
+        rewind(fp_plain);
+      else
+        mutt_file_fclose(&fp_plain);
+    }
+    cops->close(&cctx);
+  }
+  FREE(&cbuf);
+  return fp_plain;
+}
+#endif /* USE_HCACHE_COMPRESSION */
+
 /**
  * mutt_bcache_open - Open an Email-Body Cache
  * @param account current mailbox' account (required)
@@ -148,6 +458,9 @@ struct BodyCache *mutt_bcache_open(struct ConnAccount *account, const char *mail
     return NULL;
 
   struct BodyCache *bcache = mutt_mem_calloc(1, sizeof(struct BodyCache));
+#ifdef USE_HCACHE_COMPRESSION
+  STAILQ_INIT(&bcache->puts);
+#endif
   if (bcache_path(account, mailbox, bcache) < 0)
   {
     mutt_bcache_close(&bcache);
@@ -167,6 +480,13 @@ void mutt_bcache_close(struct BodyCache **bcache)
 {
   if (!bcache || !*bcache)
     return;
+#ifdef USE_HCACHE_COMPRESSION
+  struct BcachePut *bp = NULL, *tmp = NULL;
+  STAILQ_FOREACH_SAFE(bp, &(*bcache)->puts, entries, tmp)
+  {
+    bcache_put_remove(*bcache, bp);
+  }
+#endif
   FREE(&(*bcache)->path);
   FREE(bcache);
 }
@@ -188,6 +508,27 @@ FILE *mutt_bcache_get(struct BodyCache *bcache, const char *id)
   mutt_buffer_addstr(path, id);
 
   FILE *fp = mutt_file_fopen(mutt_buffer_string(path), "r");
+  if (fp)
+  {
+    /* record the use for bcache_prune(); atime is unreliable under noatime */
+    utime(mutt_buffer_string(path), NULL);
+  }
+
+#ifdef USE_HCACHE_COMPRESSION
+  if (fp)
+  {
+    char magic[sizeof(BcacheMagic)];
+    if ((fread(magic, 1, sizeof(magic), fp) == sizeof(magic)) &&
+        (memcmp(magic, BcacheMagic, sizeof(magic)) == 0))
+    {
+      FILE *fp_plain = bcache_decompress(fp);
+      mutt_file_fclose(&fp);
+      fp = fp_plain; /* NULL turns a corrupt entry into a cache miss */
+    }
+    else
+      rewind(fp);
+  }
+#endif
 
   mutt_debug(LL_DEBUG3, "bcache: get: '%s': %s\n", mutt_buffer_string(path),
              fp ? "yes" : "no");
@@ -234,6 +575,32 @@ FILE *mutt_bcache_put(struct BodyCache *bcache, const char *id)
 
   mutt_debug(LL_DEBUG3, "bcache: put: '%s'\n", path);
 
+#ifdef USE_HCACHE_COMPRESSION
+  if (bcache_compress_ops())
+  {
+    /* the caller gets a plain temporary file; mutt_bcache_commit()
+     * compresses its contents into the cache */
+    FILE *fp = mutt_file_mkstemp();
+    if (fp)
+    {
+      struct BcachePut *bp = bcache_put_find(bcache, id);
+      if (bp)
+      {
+        bp->fp = fp; /* the previous put() was never committed */
+      }
+      else
+      {
+        bp = mutt_mem_calloc(1, sizeof(struct BcachePut));
+        bp->id = mutt_str_dup(id);
+        bp->fp = fp;
+        STAILQ_INSERT_TAIL(&bcache->puts, bp, entries);
+      }
+    }
+    mutt_buffer_pool_release(&path);
+    return fp;
+  }
+#endif
+
   FILE *fp = mutt_file_fopen(mutt_buffer_string(path), "w+");
   mutt_buffer_pool_release(&path);
   return fp;
@@ -248,11 +615,31 @@ FILE *mutt_bcache_put(struct BodyCache *bcache, const char *id)
  */
 int mutt_bcache_commit(struct BodyCache *bcache, const char *id)
 {
+#ifdef USE_HCACHE_COMPRESSION
+  if (bcache && id && (*id != '\0'))
+  {
+    struct BcachePut *bp = bcache_put_find(bcache, id);
+    if (bp)
+    {
+      const struct ComprOps *cops = bcache_compress_ops();
+      int rc = -1;
+      if (cops)
+        rc = bcache_commit_compressed(bcache, bp, cops);
+      bcache_put_remove(bcache, bp);
+      if (rc == 0)
+        bcache_prune(bcache, id);
+      return rc;
+    }
+  }
+#endif
+
   struct Buffer *tmpid = mutt_buffer_pool_get();
   mutt_buffer_printf(tmpid, "%s.tmp", id);
 
   int rc = mutt_bcache_move(bcache, mutt_buffer_string(tmpid), id);
   mutt_buffer_pool_release(&tmpid);
+  if (rc == 0)
+    bcache_prune(bcache, id);
   return rc;
 }
 
@@ -0,0 +1,130 @@
+/**
+ * @file
+ * Config used by libbcache
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page bcache_config Config used by libbcache
+ *
+ * Config used by libbcache
+ */
+
+#include "config.h"
+#include <stddef.h>
+#include <config/lib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "mutt/lib.h"
+#include "core/lib.h"
+
+#if defined(USE_HCACHE_COMPRESSION)
+#include "compress/lib.h"
+
+/**
+ * bcache_compress_method_validator - Validate the "message_cache_compress_method" config variable - Implements ConfigDef::validator() - @ingroup cfg_def_validator
+ */
+static int bcache_compress_method_validator(const struct ConfigSet *cs,
+                                            const struct ConfigDef *cdef,
+                                            intptr_t value, struct Buffer *err)
+{
+  if (value == 0)
+    return CSR_SUCCESS;
+
+  const char *str = (const char *) value;
+
+  if (compress_get_ops(str))
+    return CSR_SUCCESS;
+
+  mutt_buffer_printf(err, _("Invalid value for option %s: %s"), cdef->name, str);
+  return CSR_ERR_INVALID;
+}
+
+/**
+ * bcache_compress_level_validator - Validate the "message_cache_compress_level" config variable - Implements ConfigDef::validator() - @ingroup cfg_def_validator
+ */
+static int bcache_compress_level_validator(const struct ConfigSet *cs,
+                                           const struct ConfigDef *cdef,
+                                           intptr_t value, struct Buffer *err)
+{
+  const char *const c_message_cache_compress_method =
+      cs_subset_string(NeoMutt->sub, "message_cache_compress_method");
+  if (!c_message_cache_compress_method)
+  {
+    mutt_buffer_printf(err, _("Set option %s before setting %s"),
+                       "message_cache_compress_method", cdef->name);
+    return CSR_ERR_INVALID;
+  }
+
+  const struct ComprOps *cops = compress_get_ops(c_message_cache_compress_method);
+  if (!cops)
+  {
+    mutt_buffer_printf(err, _("Invalid value for option %s: %s"),
+                       "message_cache_compress_method", c_message_cache_compress_method);
+    return CSR_ERR_INVALID;
+  }
+
+  if ((value < cops->min_level) || (value > cops->max_level))
+  {
+    // L10N: This applies to the "$message_cache_compress_level" config variable.
+    //       It shows the minimum and maximum values, e.g. 'between 1 and 22'
+    mutt_buffer_printf(err, _("Option %s must be between %d and %d inclusive"),
+                       cdef->name, cops->min_level, cops->max_level);
+    return CSR_ERR_INVALID;
+  }
+
+  return CSR_SUCCESS;
+}
+
+static struct ConfigDef BcacheVarsComp[] = {
+  // clang-format off
+  // These two are not in alphabetical order because `level`s validator depends on `method`
+  { "message_cache_compress_method", DT_STRING, 0, 0, bcache_compress_method_validator,
+    "(bcache) Enable message cache compression"
+  },
+  { "message_cache_compress_level", DT_NUMBER|DT_NOT_NEGATIVE, 1, 0, bcache_compress_level_validator,
+    "(bcache) Level of compression for method"
+  },
+  { NULL },
+  // clang-format on
+};
+#endif
+
+static struct ConfigDef BcacheVars[] = {
+  // clang-format off
+  { "message_cache_size", DT_LONG|DT_NOT_NEGATIVE, 0, 0, NULL,
+    "(bcache) Maximum size of the message cache in bytes (0 for no limit)"
+  },
+  { NULL },
+  // clang-format on
+};
+
+/**
+ * config_init_bcache - Register bcache config variables - Implements ::module_init_config_t - @ingroup cfg_module_api
+ */
+bool config_init_bcache(struct ConfigSet *cs)
+{
+  bool rc = cs_register_variables(cs, BcacheVars, 0);
+
+#if defined(USE_HCACHE_COMPRESSION)
+  rc |= cs_register_variables(cs, BcacheVarsComp, 0);
+#endif
+
+  return rc;
+}
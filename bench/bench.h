@@ -0,0 +1,79 @@
+/**
+ * @file
+ * Shared definitions for the benchmark harness
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_BENCH_BENCH_H
+#define MUTT_BENCH_BENCH_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * typedef bench_fn_t - Prototype for one benchmark
+ * @param num_iter Number of iterations to run
+ *
+ * The harness times the whole call, so any one-off setup should be hoisted
+ * into the first call or kept cheap relative to the loop.
+ */
+typedef void (*bench_fn_t)(size_t num_iter);
+
+/**
+ * struct Benchmark - One registered benchmark
+ */
+struct Benchmark
+{
+  const char *name;    ///< Name, used to select benchmarks on the command line
+  bench_fn_t function; ///< Function containing the timed loop
+  size_t num_iter;     ///< Default number of iterations
+};
+
+uint64_t bench_time_ns(void);
+uint64_t bench_cpu_ns(void);
+
+/**
+ * struct CorpusConfig - Shape of a generated mail corpus
+ *
+ * The same config always produces the same corpus, so a perf bug can be
+ * reported as a seed instead of a sanitized copy of a production mailbox.
+ */
+struct CorpusConfig
+{
+  uint32_t seed;          ///< Seed for the generator's own PRNG
+  size_t num_msgs;        ///< Number of messages
+  int max_thread_depth;   ///< Deepest reply chain, 0 disables threading
+  int percent_encoded;    ///< Messages with an RFC2047-encoded subject, 0-100
+  int percent_attach;     ///< Messages with a base64 attachment, 0-100
+  size_t extra_headers;   ///< Mean bytes of X-header padding per message
+};
+
+/* corpus.c */
+void  bench_corpus_message(struct Buffer *buf, size_t index);
+FILE *bench_corpus_mbox(size_t num_msgs);
+int   bench_corpus_write(const char *type, const char *path,
+                         const struct CorpusConfig *cfg);
+
+/* one file per benchmark, like the unit tests */
+void bench_mutt_istr_find(size_t num_iter);
+void bench_pattern_exec(size_t num_iter);
+void bench_rfc822_read_header(size_t num_iter);
+void bench_rfc2047_decode(size_t num_iter);
+
+#endif /* MUTT_BENCH_BENCH_H */
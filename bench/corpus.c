@@ -0,0 +1,362 @@
+/**
+ * @file
+ * Synthetic mail corpus for the benchmarks
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page bench_corpus Synthetic mail corpus
+ *
+ * Deterministic generator of realistic-looking messages, so that every run of
+ * the benchmarks parses exactly the same bytes.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <string.h>
+#include <sys/stat.h>
+#include "mutt/lib.h"
+#include "bench.h"
+
+/// Subjects to cycle through, including some that need rfc2047 decoding
+static const char *Subjects[] = {
+  "Minutes of yesterday's meeting",
+  "Re: Minutes of yesterday's meeting",
+  "[neomutt-users] Fwd: question about the index",
+  "=?utf-8?Q?Caf=C3=A9_prices_are_going_up?=",
+  "=?utf-8?B?6IGq5piO55qE?= quarterly report",
+};
+
+/// Sender names to cycle through
+static const char *Senders[] = {
+  "Alice Example <alice@example.com>",
+  "bob@example.org",
+  "\"Chan, Charlie\" <charlie.chan@example.net>",
+  "=?utf-8?Q?D=C3=B6rte?= <doerte@example.de>",
+};
+
+/**
+ * bench_corpus_message - Generate one message
+ * @param buf   Buffer for the result
+ * @param index Position of the message in the corpus
+ *
+ * The same index always yields the same message.  Every tenth message
+ * references the previous one, so a corpus also contains threads.
+ */
+void bench_corpus_message(struct Buffer *buf, size_t index)
+{
+  mutt_buffer_reset(buf);
+
+  mutt_buffer_add_printf(buf, "From: %s\n", Senders[index % mutt_array_size(Senders)]);
+  mutt_buffer_add_printf(buf, "To: neomutt-devel@neomutt.org\n");
+  mutt_buffer_add_printf(buf, "Subject: %s\n",
+                         Subjects[index % mutt_array_size(Subjects)]);
+  mutt_buffer_add_printf(buf, "Message-ID: <corpus.%zu@example.com>\n", index);
+  if ((index % 10) != 0)
+    mutt_buffer_add_printf(buf, "In-Reply-To: <corpus.%zu@example.com>\n", index - 1);
+  mutt_buffer_add_printf(buf, "Date: Mon, %zu Feb 2021 %02zu:%02zu:00 +0000\n",
+                         (index % 28) + 1, index % 24, index % 60);
+  mutt_buffer_addstr(buf, "MIME-Version: 1.0\n");
+  mutt_buffer_addstr(buf, "Content-Type: text/plain; charset=utf-8\n");
+  mutt_buffer_addstr(buf, "\n");
+
+  for (size_t i = 0; i < ((index % 20) + 2); i++)
+  {
+    mutt_buffer_add_printf(buf, "Line %zu of the body of message %zu, padding it out "
+                                "to a plausible length.\n",
+                           i, index);
+  }
+}
+
+/**
+ * bench_corpus_mbox - Generate an mbox of consecutive corpus messages
+ * @param num_msgs Number of messages to generate
+ * @retval ptr Unlinked temporary file, rewound, owned by the caller
+ * @retval NULL Error
+ */
+FILE *bench_corpus_mbox(size_t num_msgs)
+{
+  FILE *fp = mutt_file_mkstemp();
+  if (!fp)
+    return NULL;
+
+  struct Buffer *buf = mutt_buffer_pool_get();
+  for (size_t i = 0; i < num_msgs; i++)
+  {
+    bench_corpus_message(buf, i);
+    fprintf(fp, "From alice@example.com Mon Feb  1 12:00:00 2021\n%s\n",
+            mutt_buffer_string(buf));
+  }
+  mutt_buffer_pool_release(&buf);
+
+  rewind(fp);
+  return fp;
+}
+
+/**
+ * corpus_rand - Step the corpus PRNG (xorshift32)
+ * @param[in,out] state PRNG state, must not be 0
+ * @retval num Next pseudo-random number
+ *
+ * Not libc rand(): the sequence must be identical on every platform for a
+ * seed to describe the same corpus everywhere.
+ */
+static uint32_t corpus_rand(uint32_t *state)
+{
+  uint32_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+/**
+ * corpus_render - Render one seeded message
+ * @param buf     Buffer for the result
+ * @param cfg     Shape of the corpus
+ * @param rng     PRNG state
+ * @param index   Position of the message in the corpus
+ * @param parents Message each one replies to, -1 for thread roots
+ */
+static void corpus_render(struct Buffer *buf, const struct CorpusConfig *cfg,
+                          uint32_t *rng, size_t index, const long *parents)
+{
+  mutt_buffer_reset(buf);
+
+  const char *subject = Subjects[corpus_rand(rng) % mutt_array_size(Subjects)];
+  if ((long) (corpus_rand(rng) % 100) < cfg->percent_encoded)
+    subject = "=?utf-8?Q?Caf=C3=A9_run_=E2=84=96?=";
+
+  mutt_buffer_add_printf(buf, "From: %s\n",
+                         Senders[corpus_rand(rng) % mutt_array_size(Senders)]);
+  mutt_buffer_addstr(buf, "To: neomutt-devel@neomutt.org\n");
+  mutt_buffer_add_printf(buf, "Subject: %s%s\n",
+                         (parents[index] >= 0) ? "Re: " : "", subject);
+  mutt_buffer_add_printf(buf, "Message-ID: <corpus.%u.%zu@example.com>\n",
+                         cfg->seed, index);
+
+  if (parents[index] >= 0)
+  {
+    mutt_buffer_add_printf(buf, "In-Reply-To: <corpus.%u.%ld@example.com>\n",
+                           cfg->seed, parents[index]);
+    long chain[16];
+    size_t num_chain = 0;
+    for (long p = parents[index]; (p >= 0) && (num_chain < mutt_array_size(chain));
+         p = parents[p])
+    {
+      chain[num_chain++] = p;
+    }
+    mutt_buffer_addstr(buf, "References:");
+    while (num_chain > 0) // oldest first
+      mutt_buffer_add_printf(buf, " <corpus.%u.%ld@example.com>", cfg->seed,
+                             chain[--num_chain]);
+    mutt_buffer_addstr(buf, "\n");
+  }
+
+  mutt_buffer_add_printf(buf, "Date: Mon, %zu Feb 2021 %02zu:%02zu:00 +0000\n",
+                         (index % 28) + 1, index % 24, index % 60);
+
+  if (cfg->extra_headers != 0)
+  {
+    /* 50%-150% of the mean, so header sizes vary like real folders do */
+    size_t target = (cfg->extra_headers * (50 + (corpus_rand(rng) % 101))) / 100;
+    for (size_t h = 0; target > 0; h++)
+    {
+      const size_t want = 60 + (corpus_rand(rng) % 10);
+      const size_t len = MIN(target, want);
+      mutt_buffer_add_printf(buf, "X-Corpus-%zu:", h);
+      for (size_t i = 0; i < len; i++)
+        mutt_buffer_addch(buf, 'a' + (corpus_rand(rng) % 26));
+      mutt_buffer_addstr(buf, "\n");
+      target -= len;
+    }
+  }
+
+  mutt_buffer_addstr(buf, "MIME-Version: 1.0\n");
+
+  const bool attach = ((long) (corpus_rand(rng) % 100) < cfg->percent_attach);
+  if (attach)
+    mutt_buffer_addstr(buf, "Content-Type: multipart/mixed; boundary=\"corpus-boundary\"\n");
+  else
+    mutt_buffer_addstr(buf, "Content-Type: text/plain; charset=utf-8\n");
+  mutt_buffer_addstr(buf, "\n");
+
+  if (attach)
+  {
+    mutt_buffer_addstr(buf, "--corpus-boundary\n"
+                            "Content-Type: text/plain; charset=utf-8\n\n");
+  }
+
+  const size_t num_lines = 2 + (corpus_rand(rng) % 20);
+  for (size_t i = 0; i < num_lines; i++)
+  {
+    mutt_buffer_add_printf(buf, "Line %zu of the body of message %zu, padding it out "
+                                "to a plausible length.\n",
+                           i, index);
+  }
+
+  if (attach)
+  {
+    static const char b64[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+                              "abcdefghijklmnopqrstuvwxyz0123456789+/";
+    mutt_buffer_addstr(buf, "\n--corpus-boundary\n"
+                            "Content-Type: application/octet-stream\n"
+                            "Content-Disposition: attachment; filename=\"blob.bin\"\n"
+                            "Content-Transfer-Encoding: base64\n\n");
+    const size_t num_b64_lines = 8 + (corpus_rand(rng) % 48);
+    for (size_t i = 0; i < num_b64_lines; i++)
+    {
+      for (size_t c = 0; c < 72; c++)
+        mutt_buffer_addch(buf, b64[corpus_rand(rng) % 64]);
+      mutt_buffer_addstr(buf, "\n");
+    }
+    mutt_buffer_addstr(buf, "--corpus-boundary--\n");
+  }
+}
+
+/**
+ * corpus_parents - Pick a reply parent for every message
+ * @param cfg     Shape of the corpus
+ * @param rng     PRNG state
+ * @param parents Array of cfg->num_msgs entries to fill, -1 for thread roots
+ *
+ * Half the messages reply to an earlier message, as long as that keeps the
+ * chain within CorpusConfig::max_thread_depth.
+ */
+static void corpus_parents(const struct CorpusConfig *cfg, uint32_t *rng, long *parents)
+{
+  int *depths = mutt_mem_calloc(cfg->num_msgs, sizeof(int));
+
+  for (size_t i = 0; i < cfg->num_msgs; i++)
+  {
+    parents[i] = -1;
+    if ((i == 0) || (cfg->max_thread_depth <= 0) || ((corpus_rand(rng) % 2) != 0))
+      continue;
+
+    const size_t p = corpus_rand(rng) % i;
+    if (depths[p] < cfg->max_thread_depth)
+    {
+      parents[i] = (long) p;
+      depths[i] = depths[p] + 1;
+    }
+  }
+
+  FREE(&depths);
+}
+
+/**
+ * bench_corpus_write - Write a seeded corpus to disk
+ * @param type One of "maildir", "mbox" or "mh"
+ * @param path Mailbox to create; a directory for maildir/mh, a file for mbox
+ * @param cfg  Shape of the corpus
+ * @retval  0 Success
+ * @retval -1 Error, with the reason logged to stderr
+ */
+int bench_corpus_write(const char *type, const char *path, const struct CorpusConfig *cfg)
+{
+  const bool is_mbox = mutt_str_equal(type, "mbox");
+  const bool is_maildir = mutt_str_equal(type, "maildir");
+  const bool is_mh = mutt_str_equal(type, "mh");
+  if (!is_mbox && !is_maildir && !is_mh)
+  {
+    fprintf(stderr, "unknown mailbox type: %s\n", type);
+    return -1;
+  }
+
+  uint32_t rng = cfg->seed ? cfg->seed : 1; // xorshift can't leave 0
+  long *parents = mutt_mem_calloc(cfg->num_msgs, sizeof(long));
+  corpus_parents(cfg, &rng, parents);
+
+  int rc = -1;
+  FILE *fp_mbox = NULL;
+  struct Buffer *buf = mutt_buffer_pool_get();
+  struct Buffer *file = mutt_buffer_pool_get();
+
+  if (is_mbox)
+  {
+    fp_mbox = fopen(path, "w");
+    if (!fp_mbox)
+    {
+      perror(path);
+      goto done;
+    }
+  }
+  else
+  {
+    static const char *subdirs[] = { "", "/cur", "/new", "/tmp" };
+    for (size_t i = 0; i < (is_maildir ? mutt_array_size(subdirs) : 1); i++)
+    {
+      mutt_buffer_printf(file, "%s%s", path, subdirs[i]);
+      if (mutt_file_mkdir(mutt_buffer_string(file), S_IRWXU) < 0)
+      {
+        perror(mutt_buffer_string(file));
+        goto done;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < cfg->num_msgs; i++)
+  {
+    corpus_render(buf, cfg, &rng, i, parents);
+
+    if (is_mbox)
+    {
+      fprintf(fp_mbox, "From alice@example.com Mon Feb  1 12:00:00 2021\n%s\n",
+              mutt_buffer_string(buf));
+      continue;
+    }
+
+    if (is_maildir)
+    {
+      /* 60% already read and moved to cur/, like a folder in daily use */
+      if ((corpus_rand(&rng) % 100) < 60)
+        mutt_buffer_printf(file, "%s/cur/%u.%zu.corpus:2,S", path, cfg->seed, i);
+      else
+        mutt_buffer_printf(file, "%s/new/%u.%zu.corpus", path, cfg->seed, i);
+    }
+    else
+      mutt_buffer_printf(file, "%s/%zu", path, i + 1);
+
+    FILE *fp = fopen(mutt_buffer_string(file), "w");
+    if (!fp)
+    {
+      perror(mutt_buffer_string(file));
+      goto done;
+    }
+    fputs(mutt_buffer_string(buf), fp);
+    fclose(fp);
+  }
+
+  if (is_mh)
+  {
+    mutt_buffer_printf(file, "%s/.mh_sequences", path);
+    FILE *fp = fopen(mutt_buffer_string(file), "w");
+    if (fp)
+      fclose(fp);
+  }
+
+  rc = 0;
+done:
+  mutt_file_fclose(&fp_mbox);
+  mutt_buffer_pool_release(&buf);
+  mutt_buffer_pool_release(&file);
+  FREE(&parents);
+  return rc;
+}
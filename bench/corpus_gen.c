@@ -0,0 +1,137 @@
+/**
+ * @file
+ * Generate a synthetic mailbox from a seed
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page bench_corpus_gen Generate a synthetic mailbox from a seed
+ *
+ * Standalone tool writing a maildir, mbox or mh mailbox whose shape is fully
+ * described by its command line.  A slow folder can then be reproduced by
+ * quoting the command that generated it, instead of shipping the folder.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "bench.h"
+
+/**
+ * usage - Show the command line options
+ * @param name argv[0]
+ */
+static void usage(const char *name)
+{
+  printf("usage: %s [options] -o path\n", name);
+  printf("  -o PATH  mailbox to create: a directory (maildir/mh) or file (mbox)\n");
+  printf("  -t TYPE  mailbox type: maildir (default), mbox or mh\n");
+  printf("  -n NUM   number of messages (default 1000)\n");
+  printf("  -s SEED  seed; the same options and seed give the same mailbox\n");
+  printf("  -d NUM   maximum thread depth, 0 for no threads (default 4)\n");
+  printf("  -e PCT   %% of messages with an rfc2047-encoded subject (default 20)\n");
+  printf("  -a PCT   %% of messages with a base64 attachment (default 10)\n");
+  printf("  -x NUM   mean bytes of X-header padding per message (default 0)\n");
+}
+
+/**
+ * main - Generate a synthetic mailbox
+ * @param argc Number of command line arguments
+ * @param argv List of command line arguments
+ * @retval 0 Success
+ * @retval 1 Error
+ */
+int main(int argc, char *argv[])
+{
+  struct CorpusConfig cfg = {
+    .seed = 42,
+    .num_msgs = 1000,
+    .max_thread_depth = 4,
+    .percent_encoded = 20,
+    .percent_attach = 10,
+    .extra_headers = 0,
+  };
+  const char *type = "maildir";
+  const char *path = NULL;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "a:d:e:hn:o:s:t:x:")) != -1)
+  {
+    switch (opt)
+    {
+      case 'a':
+        cfg.percent_attach = atoi(optarg);
+        break;
+      case 'd':
+        cfg.max_thread_depth = atoi(optarg);
+        break;
+      case 'e':
+        cfg.percent_encoded = atoi(optarg);
+        break;
+      case 'n':
+        cfg.num_msgs = strtoul(optarg, NULL, 10);
+        break;
+      case 'o':
+        path = optarg;
+        break;
+      case 's':
+        cfg.seed = strtoul(optarg, NULL, 10);
+        break;
+      case 't':
+        type = optarg;
+        break;
+      case 'x':
+        cfg.extra_headers = strtoul(optarg, NULL, 10);
+        break;
+      case 'h':
+      default:
+        usage(argv[0]);
+        return (opt == 'h') ? 0 : 1;
+    }
+  }
+
+  if (!path || (optind != argc))
+  {
+    usage(argv[0]);
+    return 1;
+  }
+
+  /* The library code expects a NeoMutt, even though nothing is configured */
+  struct ConfigSet *cs = cs_new(30);
+  NeoMutt = neomutt_new(cs);
+
+  int rc = bench_corpus_write(type, path, &cfg);
+
+  neomutt_free(&NeoMutt);
+  cs_free(&cs);
+
+  if (rc < 0)
+    return 1;
+
+  printf("%s: %s, %zu messages, seed %u, depth %d, %d%% encoded, %d%% attachments, %zu header bytes\n",
+         path, type, cfg.num_msgs, cfg.seed, cfg.max_thread_depth,
+         cfg.percent_encoded, cfg.percent_attach, cfg.extra_headers);
+
+  mutt_buffer_pool_free();
+  return 0;
+}
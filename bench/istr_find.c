@@ -0,0 +1,61 @@
+/**
+ * @file
+ * Benchmark for mutt_istr_find()
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include "mutt/lib.h"
+#include "bench.h"
+
+/// Haystacks shaped like the header lines the search usually runs over
+static const char *Haystacks[] = {
+  "Content-Type: multipart/mixed; boundary=\"=-=-=\"",
+  "Subject: Re: [PATCH v3 2/7] Rework the connection timeout handling",
+  "X-Spam-Status: No, score=-2.6 required=5.0 tests=BAYES_00,DKIM_SIGNED",
+  "Received: from mail.example.com (mail.example.com [203.0.113.7]) by "
+  "mx.example.net with ESMTPS id abc123 for <user@example.net>",
+};
+
+/// Needles: an early hit, a late hit and two misses
+static const char *Needles[] = {
+  "content-type",
+  "ESMTPS",
+  "X-NotPresent",
+  "attachment",
+};
+
+/**
+ * bench_mutt_istr_find - Measure a case-insensitive substring search
+ * @param num_iter Number of searches to run
+ *
+ * One iteration searches one haystack for one needle, cycling through the
+ * combinations so hits and misses are mixed like in header matching.
+ */
+void bench_mutt_istr_find(size_t num_iter)
+{
+  for (size_t i = 0; i < num_iter; i++)
+  {
+    const char *haystack = Haystacks[i % mutt_array_size(Haystacks)];
+    const char *needle = Needles[(i / mutt_array_size(Haystacks)) % mutt_array_size(Needles)];
+    volatile const char *result = mutt_istr_find(haystack, needle);
+    (void) result;
+  }
+}
@@ -0,0 +1,260 @@
+/**
+ * @file
+ * Benchmark hub
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page bench_main Benchmark hub
+ *
+ * Microbenchmarks for the hot paths of the libraries.
+ *
+ * The numbers are only comparable on one machine between two builds of the
+ * same tree, e.g. before and after an optimisation.  Wall-clock and CPU time
+ * are both reported; a large gap between them means the benchmark was
+ * descheduled and the run should be repeated on a quieter machine.
+ */
+
+#include "config.h"
+#include <locale.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
+#include "bench.h"
+
+#define CONFIG_INIT_TYPE(CS, NAME)                                             \
+  extern const struct ConfigSetType Cst##NAME;                                 \
+  cs_register_type(CS, &Cst##NAME)
+
+/// All the registered benchmarks
+// clang-format off
+static const struct Benchmark Benchmarks[] = {
+  { "mutt_istr_find",          bench_mutt_istr_find,     2000000 },
+  { "mutt_pattern_exec",       bench_pattern_exec,       200    },
+  { "mutt_rfc822_read_header", bench_rfc822_read_header, 20000  },
+  { "rfc2047_decode",          bench_rfc2047_decode,     200000 },
+};
+// clang-format on
+
+static struct ConfigDef Vars[] = {
+  // clang-format off
+  { "assumed_charset", DT_STRING,                                0,           0,     NULL, },
+  { "auto_subscribe",  DT_BOOL,                                  false,       0,     NULL, },
+  { "charset",         DT_STRING|DT_NOT_EMPTY|DT_CHARSET_SINGLE, IP "utf-8",  0,     NULL, },
+  { "idn_decode",      DT_BOOL,                                  true,        0,     NULL, },
+  { "idn_encode",      DT_BOOL,                                  true,        0,     NULL, },
+  { "mark_old",        DT_BOOL,                                  true,        0,     NULL, },
+  { "rfc2047_parameters", DT_BOOL,                               false,       0,     NULL, },
+  { "reply_regex",     DT_REGEX,   IP "^((re|aw|sv)(\\[[0-9]+\\])*:[ \t]*)*", 0,     NULL, },
+  { "spam_separator",  DT_STRING,                                IP ",",      0,     NULL, },
+  { "thorough_search", DT_BOOL,                                  true,        0,     NULL, },
+  { "tmpdir",          DT_PATH|DT_PATH_DIR|DT_NOT_EMPTY,         IP TMPDIR,   0,     NULL, },
+  { "weed",            DT_BOOL,                                  true,        0,     NULL, },
+  { NULL },
+  // clang-format on
+};
+
+/**
+ * bench_time_ns - Wall-clock time
+ * @retval num Nanoseconds from an arbitrary fixed point
+ */
+uint64_t bench_time_ns(void)
+{
+  struct timespec tp = { 0 };
+  clock_gettime(CLOCK_MONOTONIC, &tp);
+  return ((uint64_t) tp.tv_sec * 1000000000ULL) + tp.tv_nsec;
+}
+
+/**
+ * bench_cpu_ns - CPU time consumed by the process
+ * @retval num Nanoseconds of CPU time
+ */
+uint64_t bench_cpu_ns(void)
+{
+  struct timespec tp = { 0 };
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &tp);
+  return ((uint64_t) tp.tv_sec * 1000000000ULL) + tp.tv_nsec;
+}
+
+/**
+ * bench_neomutt_create - Set up a NeoMutt for the benchmarks to use
+ * @retval ptr NeoMutt
+ */
+static struct NeoMutt *bench_neomutt_create(void)
+{
+  struct ConfigSet *cs = cs_new(50);
+  CONFIG_INIT_TYPE(cs, Address);
+  CONFIG_INIT_TYPE(cs, Bool);
+  CONFIG_INIT_TYPE(cs, Enum);
+  CONFIG_INIT_TYPE(cs, Long);
+  CONFIG_INIT_TYPE(cs, Mbtable);
+  CONFIG_INIT_TYPE(cs, Number);
+  CONFIG_INIT_TYPE(cs, Path);
+  CONFIG_INIT_TYPE(cs, Quad);
+  CONFIG_INIT_TYPE(cs, Regex);
+  CONFIG_INIT_TYPE(cs, Slist);
+  CONFIG_INIT_TYPE(cs, Sort);
+  CONFIG_INIT_TYPE(cs, String);
+
+  return neomutt_new(cs);
+}
+
+/**
+ * bench_neomutt_destroy - Free the benchmarks' NeoMutt
+ * @param ptr NeoMutt to free
+ */
+static void bench_neomutt_destroy(struct NeoMutt **ptr)
+{
+  struct ConfigSet *cs = (*ptr)->sub->cs;
+  neomutt_free(ptr);
+  cs_free(&cs);
+}
+
+/**
+ * usage - Show the command line options
+ * @param name argv[0]
+ */
+static void usage(const char *name)
+{
+  printf("usage: %s [-l] [-n iterations] [-j file.json] [benchmark ...]\n", name);
+  printf("  -l       list the benchmarks and exit\n");
+  printf("  -n NUM   run NUM iterations instead of each benchmark's default\n");
+  printf("  -j FILE  also write the results to FILE as JSON\n");
+  printf("With no benchmark names, all benchmarks are run.\n");
+}
+
+/**
+ * main - Run the benchmarks
+ * @param argc Number of command line arguments
+ * @param argv List of command line arguments
+ * @retval 0 Success
+ * @retval 1 Error
+ */
+int main(int argc, char *argv[])
+{
+  size_t num_iter = 0;
+  const char *json_file = NULL;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "hj:ln:")) != -1)
+  {
+    switch (opt)
+    {
+      case 'j':
+        json_file = optarg;
+        break;
+      case 'l':
+        for (size_t i = 0; i < mutt_array_size(Benchmarks); i++)
+          printf("%s\n", Benchmarks[i].name);
+        return 0;
+      case 'n':
+        if (mutt_str_atoul(optarg, (unsigned long *) &num_iter) < 0)
+        {
+          fprintf(stderr, "invalid iteration count: %s\n", optarg);
+          return 1;
+        }
+        break;
+      case 'h':
+      default:
+        usage(argv[0]);
+        return (opt == 'h') ? 0 : 1;
+    }
+  }
+
+  for (int i = optind; i < argc; i++)
+  {
+    bool found = false;
+    for (size_t j = 0; !found && (j < mutt_array_size(Benchmarks)); j++)
+      found = mutt_str_equal(argv[i], Benchmarks[j].name);
+    if (!found)
+    {
+      fprintf(stderr, "unknown benchmark: %s (use -l for a list)\n", argv[i]);
+      return 1;
+    }
+  }
+
+  setlocale(LC_ALL, "");
+  NeoMutt = bench_neomutt_create();
+  if (!cs_register_variables(NeoMutt->sub->cs, Vars, 0))
+    return 1;
+
+  FILE *fp_json = NULL;
+  if (json_file)
+  {
+    fp_json = mutt_file_fopen(json_file, "w");
+    if (!fp_json)
+    {
+      perror(json_file);
+      return 1;
+    }
+    fputs("[", fp_json);
+  }
+
+  size_t num_run = 0;
+  for (size_t i = 0; i < mutt_array_size(Benchmarks); i++)
+  {
+    const struct Benchmark *b = &Benchmarks[i];
+
+    if (optind != argc)
+    {
+      bool wanted = false;
+      for (int j = optind; !wanted && (j < argc); j++)
+        wanted = mutt_str_equal(argv[j], b->name);
+      if (!wanted)
+        continue;
+    }
+
+    const size_t iters = (num_iter != 0) ? num_iter : b->num_iter;
+
+    const uint64_t wall_start = bench_time_ns();
+    const uint64_t cpu_start = bench_cpu_ns();
+    b->function(iters);
+    const uint64_t cpu_ns = bench_cpu_ns() - cpu_start;
+    const uint64_t wall_ns = bench_time_ns() - wall_start;
+
+    printf("%-28s %10zu iters  %10.3f ms wall  %10.3f ms cpu  %10.1f ns/iter\n",
+           b->name, iters, wall_ns / 1e6, cpu_ns / 1e6, (double) wall_ns / iters);
+
+    if (fp_json)
+    {
+      fprintf(fp_json,
+              "%s\n  { \"name\": \"%s\", \"iterations\": %zu, \"wall_ns\": %llu, \"cpu_ns\": %llu }",
+              (num_run == 0) ? "" : ",", b->name, iters,
+              (unsigned long long) wall_ns, (unsigned long long) cpu_ns);
+    }
+    num_run++;
+  }
+
+  if (fp_json)
+  {
+    fputs("\n]\n", fp_json);
+    mutt_file_fclose(&fp_json);
+  }
+
+  bench_neomutt_destroy(&NeoMutt);
+  mutt_buffer_pool_free();
+
+  return 0;
+}
@@ -0,0 +1,94 @@
+/**
+ * @file
+ * Benchmark for mutt_pattern_exec()
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include "mutt/lib.h"
+#include "address/lib.h"
+#include "email/lib.h"
+#include "pattern/lib.h"
+#include "bench.h"
+
+/// Number of corpus messages the patterns are run against
+#define NUM_EMAILS 100
+
+/// Patterns to evaluate: substring, regex, address and a compound one
+static const char *Patterns[] = {
+  "~s meeting",
+  "~s \"^\\\\[neomutt-users\\\\]\"",
+  "~f alice",
+  "(~f alice ~s minutes) | ~s report",
+};
+
+/**
+ * bench_pattern_exec - Measure matching patterns against emails
+ * @param num_iter Number of passes to make
+ *
+ * One iteration runs every pattern against every corpus email, the shape of a
+ * `limit` or `color index` over a mailbox.  Header-only patterns are used, so
+ * no Mailbox or message body is needed.
+ */
+void bench_pattern_exec(size_t num_iter)
+{
+  static struct Email *emails[NUM_EMAILS] = { 0 };
+  static struct PatternList *pats[mutt_array_size(Patterns)] = { 0 };
+
+  if (!emails[0])
+  {
+    struct Buffer *buf = mutt_buffer_pool_get();
+    for (size_t i = 0; i < NUM_EMAILS; i++)
+    {
+      FILE *fp = mutt_file_mkstemp();
+      bench_corpus_message(buf, i);
+      fputs(mutt_buffer_string(buf), fp);
+      rewind(fp);
+
+      emails[i] = email_new();
+      emails[i]->env = mutt_rfc822_read_header(fp, emails[i], false, false);
+      mutt_file_fclose(&fp);
+    }
+
+    struct Buffer err = mutt_buffer_make(256);
+    for (size_t i = 0; i < mutt_array_size(Patterns); i++)
+    {
+      pats[i] = mutt_pattern_comp(NULL, NULL, Patterns[i], MUTT_PC_NO_FLAGS, &err);
+      if (!pats[i])
+        fprintf(stderr, "%s: %s\n", Patterns[i], mutt_buffer_string(&err));
+    }
+    mutt_buffer_dealloc(&err);
+    mutt_buffer_pool_release(&buf);
+  }
+
+  for (size_t n = 0; n < num_iter; n++)
+  {
+    for (size_t p = 0; p < mutt_array_size(Patterns); p++)
+    {
+      if (!pats[p])
+        continue;
+      for (size_t i = 0; i < NUM_EMAILS; i++)
+      {
+        mutt_pattern_exec(SLIST_FIRST(pats[p]), MUTT_MATCH_FULL_ADDRESS, NULL,
+                          emails[i], NULL);
+      }
+    }
+  }
+}
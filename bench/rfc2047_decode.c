@@ -0,0 +1,54 @@
+/**
+ * @file
+ * Benchmark for rfc2047_decode()
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include "mutt/lib.h"
+#include "email/lib.h"
+#include "bench.h"
+
+/// Headers to decode: plain ASCII (the common case), 'Q', 'B' and split words
+static const char *Samples[] = {
+  "Minutes of yesterday's meeting",
+  "=?utf-8?Q?Caf=C3=A9_prices_are_going_up?=",
+  "=?utf-8?B?6IGq5piO55qE?= quarterly report",
+  "=?UTF-8?Q?Kvie=C4=8Diame=20drauge=20pildyti=20ESO=20pasi=C5=BEad=C4?="
+  "\n =?UTF-8?Q?=97jim=C5=B3=20girliand=C4=85!?=",
+  "=?iso-8859-1?Q?R=E9sum=E9?= attached",
+};
+
+/**
+ * bench_rfc2047_decode - Measure decoding an encoded-word header
+ * @param num_iter Number of headers to decode
+ *
+ * One iteration duplicates one sample and decodes it in place, matching how
+ * the parser calls rfc2047_decode() on each header line.
+ */
+void bench_rfc2047_decode(size_t num_iter)
+{
+  for (size_t i = 0; i < num_iter; i++)
+  {
+    char *str = mutt_str_dup(Samples[i % mutt_array_size(Samples)]);
+    rfc2047_decode(&str);
+    FREE(&str);
+  }
+}
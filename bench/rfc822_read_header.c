@@ -0,0 +1,65 @@
+/**
+ * @file
+ * Benchmark for mutt_rfc822_read_header()
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "config.h"
+#include <stdio.h>
+#include "mutt/lib.h"
+#include "address/lib.h"
+#include "email/lib.h"
+#include "bench.h"
+
+/// Distinct messages to cycle through, so one cache-hot header isn't all we measure
+#define NUM_MESSAGES 50
+
+/**
+ * bench_rfc822_read_header - Measure parsing a message header
+ * @param num_iter Number of headers to parse
+ *
+ * One iteration parses the header of one corpus message, including the
+ * rfc2047 decoding and address parsing that entails.
+ */
+void bench_rfc822_read_header(size_t num_iter)
+{
+  static FILE *fps[NUM_MESSAGES] = { 0 };
+
+  if (!fps[0])
+  {
+    struct Buffer *buf = mutt_buffer_pool_get();
+    for (size_t i = 0; i < NUM_MESSAGES; i++)
+    {
+      fps[i] = mutt_file_mkstemp();
+      bench_corpus_message(buf, i);
+      fputs(mutt_buffer_string(buf), fps[i]);
+    }
+    mutt_buffer_pool_release(&buf);
+  }
+
+  for (size_t i = 0; i < num_iter; i++)
+  {
+    FILE *fp = fps[i % NUM_MESSAGES];
+    rewind(fp);
+
+    struct Email *e = email_new();
+    e->env = mutt_rfc822_read_header(fp, e, false, false);
+    email_free(&e);
+  }
+}
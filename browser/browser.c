@@ -96,6 +96,7 @@
 #include "mx.h"
 #include "opcodes.h"
 #include "options.h"
+#include "maildir/lib.h"
 #ifdef USE_IMAP
 #include "imap/lib.h"
 #endif
@@ -548,6 +549,29 @@ static void add_folder(struct Menu *menu, struct BrowserState *state,
   ARRAY_ADD(&state->entry, ff);
 }
 
+ARRAY_HEAD(BrowserPathArray, char *);
+ARRAY_HEAD(BrowserBoolArray, bool);
+
+/**
+ * struct BrowserStatCtx - Shared state for the parallel lstat() pass
+ */
+struct BrowserStatCtx
+{
+  char **paths;    ///< Full paths of the directory entries
+  struct stat *st; ///< Out: stat info for each entry
+  bool *ok;        ///< Out: whether each lstat() succeeded
+};
+
+/**
+ * browser_stat_worker - lstat() one directory entry - Implements ::mutt_worker_fn_t
+ */
+static void browser_stat_worker(size_t index, void *wdata)
+{
+  struct BrowserStatCtx *ctx = wdata;
+
+  ctx->ok[index] = (lstat(ctx->paths[index], &ctx->st[index]) == 0);
+}
+
 /**
  * init_state - Initialise a browser state
  * @param state BrowserState to initialise
@@ -643,8 +667,16 @@ static int examine_directory(struct Mailbox *m, struct Menu *menu,
 
     init_state(state, menu);
 
-    struct MailboxList ml = STAILQ_HEAD_INITIALIZER(ml);
-    neomutt_mailboxlist_get_all(&ml, NeoMutt, MUTT_MAILBOX_ANY);
+    /* A Maildir++ root keeps its subfolders as dot-directories, which the
+     * mask normally hides; list the ones that are themselves maildirs */
+    const bool maildirpp = (mx_path_probe(d) == MUTT_MAILDIR);
+
+    /* First pass: collect the matching names.  The lstat() calls - the slow
+     * part on a network filesystem - are issued as one parallel batch below,
+     * instead of one blocking call per entry. */
+    struct BrowserPathArray names = ARRAY_HEAD_INITIALIZER;
+    struct BrowserPathArray paths = ARRAY_HEAD_INITIALIZER;
+    struct BrowserBoolArray subfolder = ARRAY_HEAD_INITIALIZER;
     while ((de = readdir(dp)))
     {
       if (mutt_str_equal(de->d_name, "."))
@@ -654,38 +686,101 @@ static int examine_directory(struct Mailbox *m, struct Menu *menu,
       {
         continue;
       }
+      bool is_subfolder = false;
       const struct Regex *c_mask = cs_subset_regex(NeoMutt->sub, "mask");
       if (!mutt_regex_match(c_mask, de->d_name))
       {
-        continue;
+        /* Maildir++ subfolder candidate?  Verified after the stat pass */
+        is_subfolder = maildirpp && (de->d_name[0] == '.') &&
+                       !mutt_str_equal(de->d_name, "..");
+        if (!is_subfolder)
+          continue;
       }
 
       mutt_buffer_concat_path(buf, d, de->d_name);
-      if (lstat(mutt_buffer_string(buf), &st) == -1)
-        continue;
+      char *name = mutt_str_dup(de->d_name);
+      char *path = mutt_buffer_strdup(buf);
+      ARRAY_ADD(&names, name);
+      ARRAY_ADD(&paths, path);
+      ARRAY_ADD(&subfolder, is_subfolder);
+    }
+    closedir(dp);
 
-      /* No size for directories or symlinks */
-      if (S_ISDIR(st.st_mode) || S_ISLNK(st.st_mode))
-        st.st_size = 0;
-      else if (!S_ISREG(st.st_mode))
-        continue;
+    const size_t num_entries = ARRAY_SIZE(&paths);
+    if (num_entries != 0)
+    {
+      struct stat *stats = mutt_mem_calloc(num_entries, sizeof(struct stat));
+      bool *ok = mutt_mem_calloc(num_entries, sizeof(bool));
+      struct BrowserStatCtx ctx = { paths.entries, stats, ok };
 
-      struct MailboxNode *np = NULL;
-      STAILQ_FOREACH(np, &ml, entries)
-      {
-        if (mutt_str_equal(mutt_buffer_string(buf), mailbox_path(np->mailbox)))
-          break;
-      }
+      const short c_browser_stat_threads =
+          cs_subset_number(NeoMutt->sub, "browser_stat_threads");
+      mutt_worker_run(browser_stat_worker, &ctx, num_entries, c_browser_stat_threads);
 
-      if (np && m && mutt_str_equal(np->mailbox->realpath, m->realpath))
+      struct MailboxList ml = STAILQ_HEAD_INITIALIZER(ml);
+      neomutt_mailboxlist_get_all(&ml, NeoMutt, MUTT_MAILBOX_ANY);
+      for (size_t i = 0; i < num_entries; i++)
       {
-        np->mailbox->msg_count = m->msg_count;
-        np->mailbox->msg_unread = m->msg_unread;
+        if (!ok[i])
+          continue;
+
+        struct stat *st_entry = &stats[i];
+        const char *path = *ARRAY_GET(&paths, i);
+
+        /* hidden entries only survive if they really are Maildir++ subfolders */
+        if (*ARRAY_GET(&subfolder, i) &&
+            (!S_ISDIR(st_entry->st_mode) || (mx_path_probe(path) != MUTT_MAILDIR)))
+        {
+          continue;
+        }
+
+        /* No size for directories or symlinks */
+        if (S_ISDIR(st_entry->st_mode) || S_ISLNK(st_entry->st_mode))
+        {
+          st_entry->st_size = 0;
+
+          /* ...except a Maildir++ root, whose quota file has it for free */
+          uint64_t q_size = 0;
+          if (S_ISDIR(st_entry->st_mode) &&
+              (maildir_quota_usage(path, &q_size, NULL) == 0))
+          {
+            st_entry->st_size = q_size;
+          }
+        }
+        else if (!S_ISREG(st_entry->st_mode))
+          continue;
+        struct MailboxNode *np = NULL;
+        STAILQ_FOREACH(np, &ml, entries)
+        {
+          if (mutt_str_equal(path, mailbox_path(np->mailbox)))
+            break;
+        }
+
+        if (np && m && mutt_str_equal(np->mailbox->realpath, m->realpath))
+        {
+          np->mailbox->msg_count = m->msg_count;
+          np->mailbox->msg_unread = m->msg_unread;
+        }
+        add_folder(menu, state, *ARRAY_GET(&names, i), NULL, st_entry,
+                   np ? np->mailbox : NULL, NULL);
       }
-      add_folder(menu, state, de->d_name, NULL, &st, np ? np->mailbox : NULL, NULL);
+      neomutt_mailboxlist_clear(&ml);
+      FREE(&stats);
+      FREE(&ok);
     }
-    neomutt_mailboxlist_clear(&ml);
-    closedir(dp);
+
+    char **p = NULL;
+    ARRAY_FOREACH(p, &names)
+    {
+      FREE(p);
+    }
+    ARRAY_FREE(&names);
+    ARRAY_FOREACH(p, &paths)
+    {
+      FREE(p);
+    }
+    ARRAY_FREE(&paths);
+    ARRAY_FREE(&subfolder);
   }
   browser_sort(state);
   rc = 0;
@@ -793,6 +888,11 @@ static int examine_mailboxes(struct Mailbox *m, struct Menu *menu, struct Browse
           st2.st_mtime = 0;
         if (st2.st_mtime > st.st_mtime)
           st.st_mtime = st2.st_mtime;
+
+        /* a Maildir++ root's quota file has the tree's size for free */
+        uint64_t q_size = 0;
+        if (maildir_quota_usage(mailbox_path(np->mailbox), &q_size, NULL) == 0)
+          st.st_size = q_size;
       }
 
       add_folder(menu, state, mutt_buffer_string(mailbox), np->mailbox->name,
@@ -1604,17 +1704,17 @@ void mutt_buffer_select_file(struct Buffer *file, SelectFileFlags flags,
         /* else leave error on screen */
         break;
       }
+#endif
 
       case OP_RENAME_MAILBOX:
       {
         int index = menu_get_index(menu);
         struct FolderFile *ff = ARRAY_GET(&state.entry, index);
-        if (!ff->imap)
-        {
-          mutt_error(_("Rename is only supported for IMAP mailboxes"));
-        }
-        else
+        if (!ff)
+          break;
+        if (ff->imap)
         {
+#ifdef USE_IMAP
           if (imap_mailbox_rename(ff->name) >= 0)
           {
             destroy_state(&state);
@@ -1626,7 +1726,55 @@ void mutt_buffer_select_file(struct Buffer *file, SelectFileFlags flags,
             browser_highlight_default(&state, menu);
             init_menu(&state, menu, m, sbar);
           }
+#endif
+          break;
         }
+
+        struct Buffer *src = mutt_buffer_pool_get();
+        struct Buffer *dst = mutt_buffer_pool_get();
+        if (state.is_mailbox_list)
+        {
+          mutt_buffer_strcpy(src, ff->name);
+          mutt_buffer_expand_path(src);
+        }
+        else
+        {
+          mutt_buffer_concat_path(src, mutt_buffer_string(&LastDir), ff->name);
+        }
+
+        if (mx_path_probe(mutt_buffer_string(src)) != MUTT_MAILDIR)
+        {
+          mutt_error(_("Rename is only supported for IMAP and maildir mailboxes"));
+        }
+        else if (m && mutt_str_equal(mailbox_path(m), mutt_buffer_string(src)))
+        {
+          mutt_error(_("Can't rename currently selected mailbox"));
+        }
+        else
+        {
+          struct Buffer *prompt = mutt_buffer_pool_get();
+          mutt_buffer_printf(prompt, _("Rename mailbox %s to: "), ff->name);
+          mutt_buffer_copy(dst, src);
+          if ((mutt_buffer_get_field(mutt_buffer_string(prompt), dst, MUTT_COMP_FILE,
+                                     false, NULL, NULL, NULL) == 0) &&
+              !mutt_buffer_is_empty(dst))
+          {
+            mutt_buffer_expand_path(dst);
+            /* a maildir moves with one rename(2), however many messages it holds */
+            if (maildir_rename(mutt_buffer_string(src), mutt_buffer_string(dst)) == 0)
+            {
+              mutt_message(_("Mailbox renamed"));
+              mutt_unget_event(0, OP_CHECK_NEW);
+            }
+            else
+            {
+              mutt_error(_("Rename failed: %s"), strerror(errno));
+            }
+          }
+          mutt_buffer_pool_release(&prompt);
+        }
+        mutt_buffer_pool_release(&src);
+        mutt_buffer_pool_release(&dst);
         break;
       }
 
@@ -1634,14 +1782,13 @@ void mutt_buffer_select_file(struct Buffer *file, SelectFileFlags flags,
       {
         int index = menu_get_index(menu);
         struct FolderFile *ff = ARRAY_GET(&state.entry, index);
-        if (!ff->imap)
-        {
-          mutt_error(_("Delete is only supported for IMAP mailboxes"));
-        }
-        else
-        {
-          char msg[128];
+        if (!ff)
+          break;
+        char msg[128];
 
+        if (ff->imap)
+        {
+#ifdef USE_IMAP
           // TODO(sileht): It could be better to select INBOX instead. But I
           // don't want to manipulate Mailboxes/mailbox->account here for now.
           // Let's just protect neomutt against crash for now. #1417
@@ -1673,10 +1820,57 @@ void mutt_buffer_select_file(struct Buffer *file, SelectFileFlags flags,
           {
             mutt_message(_("Mailbox not deleted"));
           }
+#endif
+          break;
+        }
+
+        struct Buffer *path = mutt_buffer_pool_get();
+        if (state.is_mailbox_list)
+        {
+          mutt_buffer_strcpy(path, ff->name);
+          mutt_buffer_expand_path(path);
+        }
+        else
+        {
+          mutt_buffer_concat_path(path, mutt_buffer_string(&LastDir), ff->name);
+        }
+
+        if (mx_path_probe(mutt_buffer_string(path)) != MUTT_MAILDIR)
+        {
+          mutt_error(_("Delete is only supported for IMAP and maildir mailboxes"));
+        }
+        else if (m && mutt_str_equal(mailbox_path(m), mutt_buffer_string(path)))
+        {
+          mutt_error(_("Can't delete currently selected mailbox"));
+        }
+        else
+        {
+          snprintf(msg, sizeof(msg), _("Really delete mailbox \"%s\"?"), ff->name);
+          if (mutt_yesorno(msg, MUTT_NO) == MUTT_YES)
+          {
+            if (maildir_remove(mutt_buffer_string(path)) == 0)
+            {
+              /* free the mailbox from the browser */
+              FREE(&ff->name);
+              FREE(&ff->desc);
+              /* and move all other entries up */
+              ARRAY_REMOVE(&state.entry, ff);
+              mutt_message(_("Mailbox deleted"));
+              init_menu(&state, menu, m, sbar);
+            }
+            else
+            {
+              mutt_error(_("Mailbox deletion failed: %s"), strerror(errno));
+            }
+          }
+          else
+          {
+            mutt_message(_("Mailbox not deleted"));
+          }
         }
+        mutt_buffer_pool_release(&path);
         break;
       }
-#endif
 
       case OP_GOTO_PARENT:
       case OP_CHANGE_DIRECTORY:
@@ -35,6 +35,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include "mutt/lib.h"
 #include "address/lib.h"
@@ -66,6 +67,153 @@ static struct ListHead MuttrcStack = STAILQ_HEAD_INITIALIZER(MuttrcStack);
 
 #define MAX_ERRS 128
 
+/// Magic first token of a compiled rc file; bump the number on format changes
+static const char RcCompiledMagic[] = "NMRC1";
+
+/**
+ * rc_cache_name - Build the path of the compiled copy of an rc file
+ * @param rcfile Absolute path of the rc file
+ * @param dir    Cache directory, `$config_cache`
+ * @param path   Buffer for the result
+ */
+static void rc_cache_name(const char *rcfile, const char *dir, struct Buffer *path)
+{
+  unsigned int hash = 5381;
+  for (const unsigned char *p = (const unsigned char *) rcfile; *p != '\0'; p++)
+    hash = (hash * 33) + *p;
+
+  mutt_buffer_printf(path, "%s/%s-%08x.rc", dir, mutt_path_basename(rcfile), hash);
+}
+
+/**
+ * rc_cache_open - Open a still-valid compiled copy of an rc file
+ * @param rcfile Absolute path of the rc file
+ * @retval ptr  Compiled copy, positioned after its header
+ * @retval NULL No copy, or the rc file or the charsets changed
+ *
+ * The compiled copy holds the preprocessed lines of the rc file:
+ * continuations are already joined and `$config_charset` conversion is
+ * already done.  It's only used while the rc file keeps the size and mtime
+ * recorded in the header, and the charsets their compile-time values.
+ */
+static FILE *rc_cache_open(const char *rcfile)
+{
+  const char *const c_config_cache = cs_subset_path(NeoMutt->sub, "config_cache");
+  if (!c_config_cache)
+    return NULL;
+
+  struct stat st = { 0 };
+  if (stat(rcfile, &st) != 0)
+    return NULL;
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  rc_cache_name(rcfile, c_config_cache, path);
+  FILE *fp = mutt_file_fopen(mutt_buffer_string(path), "r");
+  mutt_buffer_pool_release(&path);
+  if (!fp)
+    return NULL;
+
+  const char *const c_config_charset =
+      cs_subset_string(NeoMutt->sub, "config_charset");
+  const char *const c_charset = cs_subset_string(NeoMutt->sub, "charset");
+
+  char magic[16] = { 0 };
+  char conv_from[64] = { 0 };
+  char conv_to[64] = { 0 };
+  long long mtime = 0;
+  long long size = 0;
+  if ((fscanf(fp, "%15s %lld %lld %63s %63s", magic, &mtime, &size, conv_from,
+              conv_to) != 5) ||
+      !mutt_str_equal(magic, RcCompiledMagic) || (mtime != (long long) st.st_mtime) ||
+      (size != (long long) st.st_size) ||
+      !mutt_str_equal(conv_from, c_config_charset ? c_config_charset : "-") ||
+      !mutt_str_equal(conv_to, c_charset ? c_charset : "-"))
+  {
+    mutt_file_fclose(&fp);
+    return NULL;
+  }
+
+  /* skip the rest of the header line */
+  int ch;
+  while (((ch = fgetc(fp)) != EOF) && (ch != '\n'))
+    ; // do nothing
+
+  mutt_debug(LL_DEBUG2, "Replaying compiled copy of '%s'\n", rcfile);
+  return fp;
+}
+
+/**
+ * rc_cache_create - Start writing a compiled copy of an rc file
+ * @param rcfile Absolute path of the rc file
+ * @param path   Buffer for the path of the temporary file
+ * @retval ptr  Temporary file to fill with preprocessed lines
+ * @retval NULL Caching is disabled, or the file can't be created
+ *
+ * Put the copy in place with rc_cache_commit(), or throw it away with
+ * rc_cache_abort().
+ */
+static FILE *rc_cache_create(const char *rcfile, struct Buffer *path)
+{
+  const char *const c_config_cache = cs_subset_path(NeoMutt->sub, "config_cache");
+  if (!c_config_cache)
+    return NULL;
+
+  struct stat st = { 0 };
+  if (stat(rcfile, &st) != 0)
+    return NULL;
+
+  if (mutt_file_mkdir(c_config_cache, S_IRWXU) < 0)
+    return NULL;
+
+  rc_cache_name(rcfile, c_config_cache, path);
+  mutt_buffer_addstr(path, ".tmp");
+  FILE *fp = mutt_file_fopen(mutt_buffer_string(path), "w");
+  if (!fp)
+    return NULL;
+
+  const char *const c_config_charset =
+      cs_subset_string(NeoMutt->sub, "config_charset");
+  const char *const c_charset = cs_subset_string(NeoMutt->sub, "charset");
+  fprintf(fp, "%s %lld %lld %s %s\n", RcCompiledMagic, (long long) st.st_mtime,
+          (long long) st.st_size, c_config_charset ? c_config_charset : "-",
+          c_charset ? c_charset : "-");
+  return fp;
+}
+
+/**
+ * rc_cache_abort - Throw away a partially written compiled copy
+ * @param fp   File from rc_cache_create()
+ * @param path Path of the temporary file
+ */
+static void rc_cache_abort(FILE **fp, struct Buffer *path)
+{
+  if (!fp || !*fp)
+    return;
+
+  mutt_file_fclose(fp);
+  unlink(mutt_buffer_string(path));
+}
+
+/**
+ * rc_cache_commit - Put a finished compiled copy into place
+ * @param fp     File from rc_cache_create()
+ * @param rcfile Absolute path of the rc file
+ * @param path   Path of the temporary file
+ */
+static void rc_cache_commit(FILE **fp, const char *rcfile, struct Buffer *path)
+{
+  if (!fp || !*fp)
+    return;
+
+  mutt_file_fclose(fp);
+
+  const char *const c_config_cache = cs_subset_path(NeoMutt->sub, "config_cache");
+  struct Buffer *dst = mutt_buffer_pool_get();
+  rc_cache_name(rcfile, c_config_cache, dst);
+  rename(mutt_buffer_string(path), mutt_buffer_string(dst));
+  mutt_buffer_pool_release(&dst);
+}
+
 /**
  * enum GroupState - Type of email address group
  */
@@ -185,11 +333,40 @@ int source_rc(const char *rcfile_path, struct Buffer *err)
 
   mutt_debug(LL_DEBUG2, "Reading configuration file '%s'\n", rcfile);
 
-  FILE *fp = mutt_open_read(rcfile, &pid);
-  if (!fp)
+  bool compiled = false;
+  FILE *fp_compile = NULL;
+  struct Buffer *compile_path = NULL;
+  char *compile_from = NULL;
+  char *compile_to = NULL;
+
+  FILE *fp = NULL;
+  if (!ispipe)
   {
-    mutt_buffer_printf(err, "%s: %s", rcfile, strerror(errno));
-    return -1;
+    fp = rc_cache_open(rcfile);
+    compiled = (fp != NULL);
+  }
+  if (compiled)
+  {
+    pid = -1;
+  }
+  else
+  {
+    fp = mutt_open_read(rcfile, &pid);
+    if (!fp)
+    {
+      mutt_buffer_printf(err, "%s: %s", rcfile, strerror(errno));
+      return -1;
+    }
+    if (!ispipe)
+    {
+      compile_path = mutt_buffer_pool_get();
+      fp_compile = rc_cache_create(rcfile, compile_path);
+      if (fp_compile)
+      {
+        compile_from = mutt_str_dup(cs_subset_string(NeoMutt->sub, "config_charset"));
+        compile_to = mutt_str_dup(cs_subset_string(NeoMutt->sub, "charset"));
+      }
+    }
   }
 
   token = mutt_buffer_pool_get();
@@ -200,7 +377,8 @@ int source_rc(const char *rcfile_path, struct Buffer *err)
     const char *const c_config_charset =
         cs_subset_string(NeoMutt->sub, "config_charset");
     const char *const c_charset = cs_subset_string(NeoMutt->sub, "charset");
-    const bool conv = c_config_charset && c_charset;
+    /* lines from a compiled copy are already converted */
+    const bool conv = !compiled && c_config_charset && c_charset;
     if (conv)
     {
       currentline = mutt_str_dup(line);
@@ -211,6 +389,19 @@ int source_rc(const char *rcfile_path, struct Buffer *err)
     else
       currentline = line;
 
+    if (fp_compile)
+    {
+      /* a charset change mid-file means later lines convert differently;
+       * a compiled copy can't represent that */
+      if (!mutt_str_equal(compile_from, c_config_charset) ||
+          !mutt_str_equal(compile_to, c_charset))
+      {
+        rc_cache_abort(&fp_compile, compile_path);
+      }
+      else
+        fprintf(fp_compile, "%s\n", currentline);
+    }
+
     mutt_buffer_strcpy(linebuf, currentline);
 
     mutt_buffer_reset(err);
@@ -220,6 +411,7 @@ int source_rc(const char *rcfile_path, struct Buffer *err)
       mutt_error(_("Error in %s, line %d: %s"), rcfile, lineno, err->data);
       if (--rc < -MAX_ERRS)
       {
+        rc_cache_abort(&fp_compile, compile_path);
         if (conv)
           FREE(&currentline);
         break;
@@ -246,6 +438,11 @@ int source_rc(const char *rcfile_path, struct Buffer *err)
       FREE(&currentline);
   }
 
+  rc_cache_commit(&fp_compile, rcfile, compile_path);
+  mutt_buffer_pool_release(&compile_path);
+  FREE(&compile_from);
+  FREE(&compile_to);
+
   FREE(&line);
   mutt_file_fclose(&fp);
   if (pid != -1)
@@ -495,6 +692,7 @@ enum CommandResult parse_ignore(struct Buffer *buf, struct Buffer *s,
     remove_from_stailq(&UnIgnore, buf->data);
     add_to_stailq(&Ignore, buf->data);
   } while (MoreArgs(s));
+  mutt_matches_ignore_flush();
 
   return MUTT_CMD_SUCCESS;
 }
@@ -1450,6 +1648,7 @@ enum CommandResult parse_unignore(struct Buffer *buf, struct Buffer *s,
 
     remove_from_stailq(&Ignore, buf->data);
   } while (MoreArgs(s));
+  mutt_matches_ignore_flush();
 
   return MUTT_CMD_SUCCESS;
 }
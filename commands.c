@@ -1238,6 +1238,10 @@ static bool check_traditional_pgp(struct Mailbox *m, struct Email *e)
 
     e->security |= PGP_TRADITIONAL_CHECKED;
     mx_msg_close(m, &msg);
+
+    /* Email::security is serialised whole, so remember the verdict across
+     * sessions rather than rescanning the body every time */
+    mx_save_hcache(m, e);
   }
   return rc;
 }
@@ -29,6 +29,7 @@
 #include "config.h"
 #include <dirent.h>
 #include <errno.h>
+#include <limits.h>
 #include <string.h>
 #include <sys/stat.h>
 #include "mutt/lib.h"
@@ -44,6 +45,118 @@
 #include "nntp/lib.h"
 #endif
 
+/**
+ * mailbox_frecency - Score a Mailbox by visit count and recency
+ * @param m Mailbox
+ * @retval num Score, higher is better
+ *
+ * Classic "frecency": every visit counts, recent visits count more.
+ */
+static double mailbox_frecency(const struct Mailbox *m)
+{
+  if (m->visits == 0)
+    return 0.0;
+
+  const time_t age = mutt_date_epoch() - m->last_visited.tv_sec;
+  double weight = 0.5;
+  if (age < 3600)
+    weight = 4.0;
+  else if (age < (24 * 3600))
+    weight = 2.0;
+  else if (age < (7 * 24 * 3600))
+    weight = 1.0;
+
+  return m->visits * weight;
+}
+
+/**
+ * complete_frecency - Complete a mailbox path from the known Mailboxes
+ * @param buf    Buffer containing pathname
+ * @param buflen Length of buffer
+ * @retval  0 Success, buf has been completed
+ * @retval -1 No known Mailbox matches the prefix
+ *
+ * Serve the completion from the Mailboxes NeoMutt already knows about
+ * (`mailboxes` command, visited folders) without touching the filesystem or
+ * the IMAP server.  Several matches complete to their longest common
+ * prefix; if that adds nothing, the highest frecency score decides.
+ * Unknown prefixes make the caller fall back to directory enumeration.
+ */
+static int complete_frecency(char *buf, size_t buflen)
+{
+  if (buf[0] == '\0')
+    return -1;
+
+  struct Buffer *expanded = mutt_buffer_pool_get();
+  mutt_buffer_strcpy(expanded, buf);
+  mutt_buffer_expand_path(expanded);
+  const char *prefix = mutt_buffer_string(expanded);
+  const size_t prefix_len = mutt_buffer_len(expanded);
+
+  struct Mailbox *m_best = NULL;
+  double best_score = -1.0;
+  char common[PATH_MAX] = { 0 };
+  size_t common_len = 0;
+  int num_matches = 0;
+
+  struct MailboxList ml = STAILQ_HEAD_INITIALIZER(ml);
+  neomutt_mailboxlist_get_all(&ml, NeoMutt, MUTT_MAILBOX_ANY);
+  struct MailboxNode *np = NULL;
+  STAILQ_FOREACH(np, &ml, entries)
+  {
+    struct Mailbox *m = np->mailbox;
+    const char *path = mailbox_path(m);
+    if (!mutt_strn_equal(path, prefix, prefix_len))
+      continue;
+
+    num_matches++;
+    if (num_matches == 1)
+    {
+      mutt_str_copy(common, path, sizeof(common));
+      common_len = mutt_str_len(common);
+    }
+    else
+    {
+      size_t i = 0;
+      while ((i < common_len) && (common[i] == path[i]))
+        i++;
+      common[i] = '\0';
+      common_len = i;
+    }
+
+    const double score = mailbox_frecency(m);
+    if (score > best_score)
+    {
+      best_score = score;
+      m_best = m;
+    }
+  }
+  neomutt_mailboxlist_clear(&ml);
+  mutt_buffer_pool_release(&expanded);
+
+  if (num_matches == 0)
+    return -1;
+
+  const char *result = common;
+  if ((num_matches > 1) && (common_len <= prefix_len))
+    result = mailbox_path(m_best); /* ambiguous: the frecency score decides */
+
+  /* keep the '=' / '+' shorthand the user typed */
+  if ((buf[0] == '=') || (buf[0] == '+'))
+  {
+    const char *const c_folder = cs_subset_string(NeoMutt->sub, "folder");
+    const size_t flen = mutt_str_len(c_folder);
+    if ((flen > 0) && mutt_strn_equal(result, c_folder, flen) && (result[flen] == '/'))
+    {
+      mutt_str_copy(buf + 1, result + flen + 1, buflen - 1);
+      return 0;
+    }
+  }
+
+  mutt_str_copy(buf, result, buflen);
+  return 0;
+}
+
 /**
  * mutt_complete - Attempt to complete a partial pathname
  * @param buf    Buffer containing pathname
@@ -77,6 +190,10 @@ int mutt_complete(char *buf, size_t buflen)
     return nntp_complete(buf, buflen);
 #endif
 
+  /* serve known Mailboxes from memory before enumerating anything */
+  if (complete_frecency(buf, buflen) == 0)
+    return 0;
+
   const char *const c_spool_file = cs_subset_string(NeoMutt->sub, "spool_file");
   const char *const c_folder = cs_subset_string(NeoMutt->sub, "folder");
 #ifdef USE_IMAP
@@ -55,6 +55,27 @@
 
 struct Email;
 
+/**
+ * struct CompCacheEntry - A decompressed mailbox kept for reuse
+ *
+ * The open-hook has to decompress the whole archive, which dwarfs the cost
+ * of parsing it.  So the plaintext copy is kept for the rest of the session
+ * and reopening the mailbox skips the open-hook, as long as the compressed
+ * file hasn't changed since the copy was made.
+ */
+struct CompCacheEntry
+{
+  char *realpath;        ///< Path of the compressed file
+  char *plainpath;       ///< Path of its decompressed copy
+  FILE *fp_plain;        ///< Unlinked copy, kept while the mailbox is closed
+  long size;             ///< Size of the compressed file when decompressed
+  struct timespec mtime; ///< Mtime of the compressed file when decompressed
+};
+ARRAY_HEAD(CompCacheArray, struct CompCacheEntry);
+
+/// Decompressed copies of this session's compressed mailboxes
+static struct CompCacheArray CompCache = ARRAY_HEAD_INITIALIZER;
+
 static const struct Command comp_commands[] = {
   // clang-format off
   { "append-hook", mutt_parse_hook, MUTT_APPEND_HOOK },
@@ -71,6 +92,140 @@ void mutt_comp_init(void)
   COMMANDS_REGISTER(comp_commands);
 }
 
+/**
+ * comp_cache_find - Look up the decompressed copy of a compressed file
+ * @param realpath Path of the compressed file
+ * @retval ptr  Matching cache entry
+ * @retval NULL No copy has been made this session
+ */
+static struct CompCacheEntry *comp_cache_find(const char *realpath)
+{
+  struct CompCacheEntry *cce = NULL;
+  ARRAY_FOREACH(cce, &CompCache)
+  {
+    if (mutt_str_equal(cce->realpath, realpath))
+      return cce;
+  }
+  return NULL;
+}
+
+/**
+ * comp_cache_store - Remember a freshly decompressed copy of a Mailbox
+ * @param m Mailbox
+ *
+ * Record the compressed file's size and mtime, so that later opens can tell
+ * whether the plaintext copy is still current.
+ */
+static void comp_cache_store(struct Mailbox *m)
+{
+  struct stat st = { 0 };
+  if (stat(m->realpath, &st) != 0)
+    return;
+
+  struct CompCacheEntry *cce = comp_cache_find(m->realpath);
+  if (!cce)
+  {
+    struct CompCacheEntry cce_new = { 0 };
+    cce_new.realpath = mutt_str_dup(m->realpath);
+    cce_new.plainpath = mutt_str_dup(mailbox_path(m));
+    ARRAY_ADD(&CompCache, cce_new);
+    cce = ARRAY_LAST(&CompCache);
+  }
+
+  cce->size = (long) st.st_size;
+  mutt_file_get_stat_timespec(&cce->mtime, &st, MUTT_STAT_MTIME);
+}
+
+/**
+ * comp_cache_valid - Is the decompressed copy of a Mailbox still current?
+ * @param m Mailbox
+ * @retval true The plaintext copy matches the compressed file
+ */
+static bool comp_cache_valid(struct Mailbox *m)
+{
+  struct CompCacheEntry *cce = comp_cache_find(m->realpath);
+  if (!cce || !mutt_str_equal(cce->plainpath, mailbox_path(m)))
+    return false;
+
+  struct stat st = { 0 };
+  if (stat(m->realpath, &st) != 0)
+    return false;
+
+  if ((long) st.st_size != cce->size)
+    return false;
+  if (mutt_file_stat_timespec_compare(&st, MUTT_STAT_MTIME, &cce->mtime) != 0)
+    return false;
+
+  return (access(mailbox_path(m), R_OK) == 0);
+}
+
+/**
+ * comp_cache_forget - Drop the decompressed copy of a compressed file
+ * @param realpath Path of the compressed file
+ *
+ * The plaintext file itself is not removed; the caller deals with that.
+ */
+static void comp_cache_forget(const char *realpath)
+{
+  struct CompCacheEntry *cce = NULL;
+  ARRAY_FOREACH(cce, &CompCache)
+  {
+    if (mutt_str_equal(cce->realpath, realpath))
+    {
+      mutt_file_fclose(&cce->fp_plain);
+      FREE(&cce->realpath);
+      FREE(&cce->plainpath);
+      ARRAY_REMOVE(&CompCache, cce);
+      return;
+    }
+  }
+}
+
+/**
+ * comp_cache_detach - Take the plaintext copy off the filesystem
+ * @param m Mailbox being closed
+ *
+ * Keep the decompressed copy as an open, unlinked file: the contents stay
+ * available for the next open, but a crash or kill can't leave the
+ * plaintext lying around in the temp dir.
+ */
+static void comp_cache_detach(struct Mailbox *m)
+{
+  struct CompCacheEntry *cce = comp_cache_find(m->realpath);
+  if (!cce || cce->fp_plain)
+    return;
+
+  cce->fp_plain = mutt_file_fopen(cce->plainpath, "r");
+  if (cce->fp_plain)
+  {
+    remove(cce->plainpath);
+  }
+  else
+  {
+    /* can't hold on to it safely - drop the copy instead */
+    remove(cce->plainpath);
+    comp_cache_forget(m->realpath);
+  }
+}
+
+/**
+ * mutt_comp_cleanup - Remove the session's decompressed mailbox copies
+ */
+void mutt_comp_cleanup(void)
+{
+  struct CompCacheEntry *cce = NULL;
+  ARRAY_FOREACH(cce, &CompCache)
+  {
+    if (cce->fp_plain)
+      mutt_file_fclose(&cce->fp_plain); // already unlinked
+    else
+      remove(cce->plainpath);
+    FREE(&cce->realpath);
+    FREE(&cce->plainpath);
+  }
+  ARRAY_FREE(&CompCache);
+}
+
 /**
  * lock_realpath - Try to lock the ctx->realpath
  * @param m    Mailbox to lock
@@ -155,6 +310,52 @@ static int setup_paths(struct Mailbox *m)
   /* Setup the right paths */
   mutt_str_replace(&m->realpath, mailbox_path(m));
 
+  /* Reuse the contents of an earlier decompression */
+  struct CompCacheEntry *cce = comp_cache_find(m->realpath);
+  if (cce && cce->fp_plain)
+  {
+    /* The copy survived only as an unlinked open file - put it back on
+     * disk under a fresh temporary name */
+    struct Buffer *tmp = mutt_buffer_pool_get();
+    mutt_buffer_mktemp(tmp);
+
+    FILE *fp = mutt_file_fopen(mutt_buffer_string(tmp), "w");
+    bool ok = false;
+    if (fp)
+    {
+      rewind(cce->fp_plain);
+      ok = (mutt_file_copy_stream(cce->fp_plain, fp) >= 0);
+      ok = (mutt_file_fclose(&fp) == 0) && ok;
+      if (!ok)
+        remove(mutt_buffer_string(tmp));
+    }
+
+    if (ok)
+    {
+      mutt_file_fclose(&cce->fp_plain);
+      mutt_str_replace(&cce->plainpath, mutt_buffer_string(tmp));
+      mutt_buffer_copy(&m->pathbuf, tmp);
+      mutt_buffer_pool_release(&tmp);
+      return 0;
+    }
+
+    /* fall back to a fresh decompression */
+    mutt_buffer_pool_release(&tmp);
+    comp_cache_forget(m->realpath);
+    cce = NULL;
+  }
+  else if (cce)
+  {
+    mutt_buffer_strcpy(&m->pathbuf, cce->plainpath);
+
+    /* Make sure the file still exists, without truncating it */
+    FILE *fp = mutt_file_fopen(mailbox_path(m), "a");
+    if (!fp)
+      return -1;
+    mutt_file_fclose(&fp);
+    return 0;
+  }
+
   /* We will uncompress to TMPDIR */
   struct Buffer *buf = mutt_buffer_pool_get();
   mutt_buffer_mktemp(buf);
@@ -459,9 +660,13 @@ static enum MxOpenReturns comp_mbox_open(struct Mailbox *m)
     goto cmo_fail;
   }
 
-  int rc = execute_command(m, ci->cmd_open, _("Decompressing %s"));
-  if (rc == 0)
-    goto cmo_fail;
+  if (!comp_cache_valid(m))
+  {
+    int rc = execute_command(m, ci->cmd_open, _("Decompressing %s"));
+    if (rc == 0)
+      goto cmo_fail;
+    comp_cache_store(m);
+  }
 
   unlock_realpath(m);
 
@@ -484,6 +689,7 @@ static enum MxOpenReturns comp_mbox_open(struct Mailbox *m)
 
 cmo_fail:
   /* remove the partial uncompressed file */
+  comp_cache_forget(m->realpath);
   (void) remove(mailbox_path(m));
   compress_info_free(m);
   return MX_OPEN_ERROR;
@@ -526,11 +732,15 @@ static bool comp_mbox_open_append(struct Mailbox *m, OpenMailboxFlags flags)
   /* Open the existing mailbox, unless we are appending */
   if (!ci->cmd_append && (mutt_file_get_size(m->realpath) > 0))
   {
-    int rc = execute_command(m, ci->cmd_open, _("Decompressing %s"));
-    if (rc == 0)
+    if (!comp_cache_valid(m))
     {
-      mutt_error(_("Compress command failed: %s"), ci->cmd_open);
-      goto cmoa_fail2;
+      int rc = execute_command(m, ci->cmd_open, _("Decompressing %s"));
+      if (rc == 0)
+      {
+        mutt_error(_("Compress command failed: %s"), ci->cmd_open);
+        goto cmoa_fail2;
+      }
+      comp_cache_store(m);
     }
     m->type = mx_path_probe(mailbox_path(m));
   }
@@ -560,6 +770,7 @@ static bool comp_mbox_open_append(struct Mailbox *m, OpenMailboxFlags flags)
 
 cmoa_fail2:
   /* remove the partial uncompressed file */
+  comp_cache_forget(m->realpath);
   (void) remove(mailbox_path(m));
 cmoa_fail1:
   /* Free the compress_info to prevent close from trying to recompress */
@@ -604,6 +815,7 @@ static enum MxStatus comp_mbox_check(struct Mailbox *m)
   unlock_realpath(m);
   if (rc == 0)
     return MX_STATUS_ERROR;
+  comp_cache_store(m);
 
   return ops->mbox_check(m);
 }
@@ -656,6 +868,8 @@ static enum MxStatus comp_mbox_sync(struct Mailbox *m)
 
 sync_cleanup:
   store_size(m);
+  if (check == MX_STATUS_OK)
+    comp_cache_store(m); /* the plaintext matches the new compressed file */
   unlock_realpath(m);
   return check;
 }
@@ -707,7 +921,10 @@ static enum MxStatus comp_mbox_close(struct Mailbox *m)
       mutt_error(_("Error. Preserving temporary file: %s"), mailbox_path(m));
     }
     else
+    {
+      comp_cache_forget(m->realpath);
       remove(mailbox_path(m));
+    }
 
     unlock_realpath(m);
   }
@@ -716,14 +933,22 @@ static enum MxStatus comp_mbox_close(struct Mailbox *m)
     /* If the file was removed, remove the compressed folder too */
     if (access(mailbox_path(m), F_OK) != 0)
     {
+      comp_cache_forget(m->realpath);
       const bool c_save_empty = cs_subset_bool(NeoMutt->sub, "save_empty");
       if (!c_save_empty)
       {
         remove(m->realpath);
       }
     }
+    else if (comp_cache_valid(m))
+    {
+      /* Keep the plaintext copy, so reopening the mailbox can skip the
+       * open-hook - but only as an unlinked open file, never on disk */
+      comp_cache_detach(m);
+    }
     else
     {
+      comp_cache_forget(m->realpath);
       remove(mailbox_path(m));
     }
   }
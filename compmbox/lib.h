@@ -55,6 +55,7 @@ struct CompressInfo
 };
 
 void mutt_comp_init(void);
+void mutt_comp_cleanup(void);
 bool mutt_comp_can_append(struct Mailbox *m);
 bool mutt_comp_can_read(const char *path);
 int  mutt_comp_valid_command(const char *cmd);
@@ -1703,6 +1703,7 @@ static int op_compose_edit_message(struct ComposeSharedData *shared, int op)
     mutt_edit_file(c_editor, shared->email->body->filename);
     mutt_rfc3676_space_stuff(shared->email);
     mutt_update_encoding(shared->email->body, shared->sub);
+    mutt_attach_keyword_prescan(shared->email->body, shared->sub);
     menu_queue_redraw(shared->adata->menu, MENU_REDRAW_FULL);
     /* Unconditional hook since editor was invoked */
     mutt_message_hook(NULL, shared->email, MUTT_SEND2_HOOK);
@@ -1728,6 +1729,7 @@ static int op_compose_ispell(struct ComposeSharedData *shared, int op)
   }
 
   mutt_update_encoding(shared->email->body, shared->sub);
+  mutt_attach_keyword_prescan(shared->email->body, shared->sub);
   notify_send(shared->email->notify, NT_EMAIL, NT_EMAIL_CHANGE_ATTACH, NULL);
   return IR_SUCCESS;
 }
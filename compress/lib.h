@@ -49,6 +49,7 @@
 #ifndef MUTT_COMPRESS_LIB_H
 #define MUTT_COMPRESS_LIB_H
 
+#include <stdbool.h>
 #include <stdlib.h>
 
 /**
@@ -106,6 +107,54 @@ struct ComprOps
    */
   void *(*decompress)(void *cctx, const char *cbuf, size_t clen);
 
+  /**
+   * @defgroup compress_learn learn()
+   * @ingroup compress_api
+   *
+   * learn - Feed a record into the dictionary trainer
+   * @param[in] cctx Compression context
+   * @param[in] data Uncompressed record
+   * @param[in] dlen Length of the record
+   * @retval true A dictionary has just been trained; fetch it with serialize_dict()
+   *
+   * Optional - may be NULL.  Backends with trained-dictionary support collect
+   * sample records here; once enough have been seen, a dictionary is trained
+   * and used for all subsequent compress() calls.
+   */
+  bool (*learn)(void *cctx, const char *data, size_t dlen);
+
+  /**
+   * @defgroup compress_serialize_dict serialize_dict()
+   * @ingroup compress_api
+   *
+   * serialize_dict - Get the dictionary in use, for persisting
+   * @param[in]  cctx Compression context
+   * @param[out] dlen Length of the dictionary
+   * @retval ptr  The dictionary
+   * @retval NULL No dictionary has been trained or loaded
+   *
+   * Optional - may be NULL.
+   *
+   * @note This function returns a pointer to data, which will be freed by the
+   *       close() function.
+   */
+  void *(*serialize_dict)(void *cctx, size_t *dlen);
+
+  /**
+   * @defgroup compress_load_dict load_dict()
+   * @ingroup compress_api
+   *
+   * load_dict - Install a previously trained dictionary
+   * @param[in] cctx Compression context
+   * @param[in] data The dictionary
+   * @param[in] dlen Length of the dictionary
+   * @retval true Success
+   *
+   * Optional - may be NULL.  A context with a loaded dictionary compresses
+   * with it and stops collecting samples.
+   */
+  bool (*load_dict)(void *cctx, const char *data, size_t dlen);
+
   /**
    * @defgroup compress_close close()
    * @ingroup compress_api
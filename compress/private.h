@@ -34,4 +34,19 @@
     .close      = compr_##_name##_close,            \
   };
 
+/* For backends that also implement trained dictionaries */
+#define COMPRESS_OPS_DICT(_name, _min_level, _max_level) \
+  const struct ComprOps compr_##_name##_ops = {          \
+    .name           = #_name,                            \
+    .min_level      = _min_level,                        \
+    .max_level      = _max_level,                        \
+    .open           = compr_##_name##_open,              \
+    .compress       = compr_##_name##_compress,          \
+    .decompress     = compr_##_name##_decompress,        \
+    .learn          = compr_##_name##_learn,             \
+    .serialize_dict = compr_##_name##_serialize_dict,    \
+    .load_dict      = compr_##_name##_load_dict,         \
+    .close          = compr_##_name##_close,             \
+  };
+
 #endif /* MUTT_COMPRESS_PRIVATE_H */
@@ -28,7 +28,10 @@
  */
 
 #include "config.h"
+#include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
+#include <zdict.h>
 #include <zstd.h>
 #include "private.h"
 #include "mutt/lib.h"
@@ -37,6 +40,11 @@
 #define MIN_COMP_LEVEL 1  ///< Minimum compression level for zstd
 #define MAX_COMP_LEVEL 22 ///< Maximum compression level for zstd
 
+#define DICT_SIZE (16 * 1024)              ///< Size of a trained dictionary
+#define DICT_SAMPLE_LIMIT (2 * 1024 * 1024) ///< Stop collecting samples beyond this
+#define DICT_MIN_SAMPLES 128               ///< Don't train on fewer records
+#define DICT_MAX_SAMPLES 2048              ///< Train once this many records are seen
+
 /**
  * struct ComprZstdCtx - Private Zstandard Compression Context
  */
@@ -47,14 +55,59 @@ struct ComprZstdCtx
 
   ZSTD_CCtx *cctx; ///< Compression context
   ZSTD_DCtx *dctx; ///< Decompression context
+
+  char *samples;        ///< Sample records collected for training, back to back
+  size_t samples_len;   ///< Total length of the samples
+  size_t *sample_sizes; ///< Length of each sample
+  size_t num_samples;   ///< Number of samples collected
+
+  void *dict;        ///< Trained or loaded dictionary
+  size_t dict_len;   ///< Length of the dictionary
+  ZSTD_CDict *cdict; ///< Digested dictionary for compression
+  ZSTD_DDict *ddict; ///< Digested dictionary for decompression
 };
 
+/**
+ * zstd_dict_install - Digest a dictionary for use, taking ownership
+ * @param ctx  Zstandard context
+ * @param dict Dictionary data; freed on failure
+ * @param dlen Length of the dictionary
+ * @retval true Success
+ */
+static bool zstd_dict_install(struct ComprZstdCtx *ctx, void *dict, size_t dlen)
+{
+  ZSTD_CDict *cdict = ZSTD_createCDict(dict, dlen, ctx->level);
+  ZSTD_DDict *ddict = ZSTD_createDDict(dict, dlen);
+  if (!cdict || !ddict)
+  {
+    // LCOV_EXCL_START
+    ZSTD_freeCDict(cdict);
+    ZSTD_freeDDict(ddict);
+    FREE(&dict);
+    return false;
+    // LCOV_EXCL_STOP
+  }
+
+  ctx->dict = dict;
+  ctx->dict_len = dlen;
+  ctx->cdict = cdict;
+  ctx->ddict = ddict;
+
+  /* the samples have served their purpose */
+  FREE(&ctx->samples);
+  FREE(&ctx->sample_sizes);
+  ctx->samples_len = 0;
+  ctx->num_samples = 0;
+
+  return true;
+}
+
 /**
  * compr_zstd_open - Implements ComprOps::open() - @ingroup compress_open
  */
 static void *compr_zstd_open(short level)
 {
-  struct ComprZstdCtx *ctx = mutt_mem_malloc(sizeof(struct ComprZstdCtx));
+  struct ComprZstdCtx *ctx = mutt_mem_calloc(1, sizeof(struct ComprZstdCtx));
 
   ctx->buf = mutt_mem_malloc(ZSTD_compressBound(1024 * 128));
   ctx->cctx = ZSTD_createCCtx();
@@ -96,7 +149,11 @@ static void *compr_zstd_compress(void *cctx, const char *data, size_t dlen, size
   size_t len = ZSTD_compressBound(dlen);
   mutt_mem_realloc(&ctx->buf, len);
 
-  size_t ret = ZSTD_compressCCtx(ctx->cctx, ctx->buf, len, data, dlen, ctx->level);
+  size_t ret;
+  if (ctx->cdict)
+    ret = ZSTD_compress_usingCDict(ctx->cctx, ctx->buf, len, data, dlen, ctx->cdict);
+  else
+    ret = ZSTD_compressCCtx(ctx->cctx, ctx->buf, len, data, dlen, ctx->level);
   if (ZSTD_isError(ret))
     return NULL; // LCOV_EXCL_LINE
 
@@ -124,13 +181,108 @@ static void *compr_zstd_decompress(void *cctx, const char *cbuf, size_t clen)
     return NULL; // LCOV_EXCL_LINE
   mutt_mem_realloc(&ctx->buf, len);
 
-  size_t ret = ZSTD_decompressDCtx(ctx->dctx, ctx->buf, len, cbuf, clen);
+  size_t ret;
+  if (ZSTD_getDictID_fromFrame(cbuf, clen) != 0)
+  {
+    /* the record was compressed with a trained dictionary */
+    if (!ctx->ddict)
+      return NULL;
+    ret = ZSTD_decompress_usingDDict(ctx->dctx, ctx->buf, len, cbuf, clen, ctx->ddict);
+  }
+  else
+  {
+    ret = ZSTD_decompressDCtx(ctx->dctx, ctx->buf, len, cbuf, clen);
+  }
   if (ZSTD_isError(ret))
     return NULL; // LCOV_EXCL_LINE
 
   return ctx->buf;
 }
 
+/**
+ * compr_zstd_learn - Implements ComprOps::learn() - @ingroup compress_learn
+ *
+ * Small header records compress poorly on their own because every frame
+ * starts from nothing.  Collect them as samples; once enough have been seen,
+ * train a dictionary of the bytes they share, and compress every later
+ * record against it.
+ */
+static bool compr_zstd_learn(void *cctx, const char *data, size_t dlen)
+{
+  struct ComprZstdCtx *ctx = cctx;
+
+  if (!ctx || ctx->cdict || (dlen == 0))
+    return false;
+
+  if (ctx->samples_len < DICT_SAMPLE_LIMIT)
+  {
+    mutt_mem_realloc(&ctx->samples, ctx->samples_len + dlen);
+    memcpy(ctx->samples + ctx->samples_len, data, dlen);
+    ctx->samples_len += dlen;
+
+    mutt_mem_realloc(&ctx->sample_sizes, (ctx->num_samples + 1) * sizeof(size_t));
+    ctx->sample_sizes[ctx->num_samples++] = dlen;
+  }
+
+  if ((ctx->num_samples < DICT_MAX_SAMPLES) &&
+      ((ctx->samples_len < DICT_SAMPLE_LIMIT) || (ctx->num_samples < DICT_MIN_SAMPLES)))
+  {
+    return false;
+  }
+
+  void *dict = mutt_mem_malloc(DICT_SIZE);
+  size_t dl = ZDICT_trainFromBuffer(dict, DICT_SIZE, ctx->samples,
+                                    ctx->sample_sizes, ctx->num_samples);
+  if (ZDICT_isError(dl))
+  {
+    /* e.g. the samples are too uniform - don't try again this session */
+    mutt_debug(LL_DEBUG1, "zstd dictionary training failed: %s\n", ZDICT_getErrorName(dl));
+    FREE(&dict);
+    FREE(&ctx->samples);
+    FREE(&ctx->sample_sizes);
+    ctx->samples_len = 0;
+    ctx->num_samples = 0;
+    return false;
+  }
+
+  if (!zstd_dict_install(ctx, dict, dl))
+    return false; // LCOV_EXCL_LINE
+
+  mutt_debug(LL_DEBUG2, "zstd dictionary trained: %zu bytes from %zu records\n",
+             ctx->dict_len, ctx->num_samples);
+  return true;
+}
+
+/**
+ * compr_zstd_serialize_dict - Implements ComprOps::serialize_dict() - @ingroup compress_serialize_dict
+ */
+static void *compr_zstd_serialize_dict(void *cctx, size_t *dlen)
+{
+  struct ComprZstdCtx *ctx = cctx;
+
+  if (!ctx || !ctx->dict)
+    return NULL;
+
+  *dlen = ctx->dict_len;
+  return ctx->dict;
+}
+
+/**
+ * compr_zstd_load_dict - Implements ComprOps::load_dict() - @ingroup compress_load_dict
+ */
+static bool compr_zstd_load_dict(void *cctx, const char *data, size_t dlen)
+{
+  struct ComprZstdCtx *ctx = cctx;
+
+  if (!ctx || ctx->cdict || (dlen == 0))
+    return false;
+
+  void *dict = mutt_mem_malloc(dlen);
+  memcpy(dict, data, dlen);
+
+  return zstd_dict_install(ctx, dict, dlen);
+}
+
 /**
  * compr_zstd_close - Implements ComprOps::close() - @ingroup compress_close
  */
@@ -147,8 +299,14 @@ static void compr_zstd_close(void **cctx)
   if (ctx->dctx)
     ZSTD_freeDCtx(ctx->dctx);
 
+  ZSTD_freeCDict(ctx->cdict);
+  ZSTD_freeDDict(ctx->ddict);
+  FREE(&ctx->dict);
+  FREE(&ctx->samples);
+  FREE(&ctx->sample_sizes);
+
   FREE(&ctx->buf);
   FREE(cctx);
 }
 
-COMPRESS_OPS(zstd, MIN_COMP_LEVEL, MAX_COMP_LEVEL)
+COMPRESS_OPS_DICT(zstd, MIN_COMP_LEVEL, MAX_COMP_LEVEL)
@@ -331,3 +331,35 @@ const char *cs_subset_string(const struct ConfigSubset *sub, const char *name)
 
   return (const char *) value;
 }
+
+/**
+ * cs_subset_cached - Get a config item's native value through a cache
+ * @param sub   Config Subset
+ * @param name  Name of config item
+ * @param cache Caller-owned cache, initialised to `{ 0 }`
+ * @retval intptr_t Native value
+ *
+ * The name is only resolved (inheritance chain walk plus hash lookup) when
+ * the cache is stale: on the first call, after any config change, or when
+ * asked about a different Subset.  In the common case a hot loop pays one
+ * generation compare per call.
+ */
+intptr_t cs_subset_cached(const struct ConfigSubset *sub, const char *name,
+                          struct ConfigCache *cache)
+{
+  assert(sub && name && cache);
+
+  const uint64_t generation = cs_subset_generation();
+  if ((cache->sub == sub) && (cache->generation == generation))
+    return cache->value;
+
+  struct HashElem *he = cs_subset_create_inheritance(sub, name);
+  assert(he);
+
+  cache->value = cs_subset_he_native_get(sub, he, NULL);
+  assert(cache->value != INT_MIN);
+  cache->sub = sub;
+  cache->generation = generation;
+
+  return cache->value;
+}
@@ -24,10 +24,27 @@
 #define MUTT_CONFIG_HELPERS_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "quad.h"
 
 struct ConfigSubset;
 
+/**
+ * struct ConfigCache - Cached config lookup
+ *
+ * Lets a hot path resolve a config item once and reuse the native value
+ * until the config changes.  Initialise to `{ 0 }`; the zero generation
+ * never matches, so the first call always resolves.
+ *
+ * @sa cs_subset_cached()
+ */
+struct ConfigCache
+{
+  const struct ConfigSubset *sub; ///< Subset the value was resolved against
+  uint64_t generation;            ///< cs_subset_generation() when resolved
+  intptr_t value;                 ///< Cached native value
+};
+
 const struct Address *cs_subset_address(const struct ConfigSubset *sub, const char *name);
 bool                  cs_subset_bool   (const struct ConfigSubset *sub, const char *name);
 unsigned char         cs_subset_enum   (const struct ConfigSubset *sub, const char *name);
@@ -41,4 +58,6 @@ const struct Slist *  cs_subset_slist  (const struct ConfigSubset *sub, const ch
 short                 cs_subset_sort   (const struct ConfigSubset *sub, const char *name);
 const char *          cs_subset_string (const struct ConfigSubset *sub, const char *name);
 
+intptr_t cs_subset_cached(const struct ConfigSubset *sub, const char *name, struct ConfigCache *cache);
+
 #endif /* MUTT_CONFIG_HELPERS_H */
@@ -48,6 +48,21 @@ static const struct Mapping ConfigEventNames[] = {
   // clang-format on
 };
 
+/// Bumped on every config change, so cached lookups can spot staleness
+static uint64_t ConfigGeneration = 1;
+
+/**
+ * cs_subset_generation - Generation number of the config
+ * @retval num Generation number
+ *
+ * The number changes whenever any config item does, in any Subset.
+ * @sa cs_subset_cached()
+ */
+uint64_t cs_subset_generation(void)
+{
+  return ConfigGeneration;
+}
+
 /**
  * elem_list_sort - Sort two HashElem pointers to config
  * @param a First HashElem
@@ -232,6 +247,8 @@ void cs_subset_notify_observers(const struct ConfigSubset *sub,
   if (!sub || !he)
     return;
 
+  ConfigGeneration++;
+
   struct HashElem *he_base = cs_get_base(he);
   struct EventConfig ev_c = { sub, he_base->key.strkey, he };
   mutt_debug(LL_NOTIFY, "%s: %s\n",
@@ -79,6 +79,7 @@ void                 cs_subset_free(struct ConfigSubset **ptr);
 struct HashElem *cs_subset_create_inheritance(const struct ConfigSubset *sub, const char *name);
 struct HashElem *cs_subset_lookup            (const struct ConfigSubset *sub, const char *name);
 void             cs_subset_notify_observers  (const struct ConfigSubset *sub, struct HashElem *he, enum NotifyConfig ev);
+uint64_t         cs_subset_generation        (void);
 
 intptr_t cs_subset_he_native_get          (const struct ConfigSubset *sub, struct HashElem *he,                    struct Buffer *err);
 int      cs_subset_he_native_set          (const struct ConfigSubset *sub, struct HashElem *he, intptr_t value,    struct Buffer *err);
@@ -36,6 +36,9 @@ static struct ConfigDef ConnVars[] = {
   { "connect_timeout", DT_NUMBER, 30, 0, NULL,
     "Timeout for making network connections (-1 to wait indefinitely)"
   },
+  { "oauth_token_lifetime", DT_NUMBER|DT_NOT_NEGATIVE, 3300, 0, NULL,
+    "How long (in seconds) to reuse an OAuth access token"
+  },
   { "preconnect", DT_STRING, 0, 0, NULL,
     "(socket) External command to run prior to opening a socket"
   },
@@ -64,6 +67,9 @@ static struct ConfigDef ConnVarsSsl[] = {
   { "ssl_force_tls", DT_BOOL, true, 0, NULL,
     "(ssl) Require TLS encryption for all connections"
   },
+  { "ssl_session_cache", DT_PATH|DT_PATH_DIR, 0, 0, NULL,
+    "(ssl) Directory where TLS sessions are cached for faster reconnection"
+  },
   { "ssl_starttls", DT_QUAD, MUTT_YES, 0, NULL,
     "(ssl) Use STARTTLS on servers advertising the capability"
   },
@@ -32,13 +32,60 @@
 #include <stdio.h>
 #include <string.h>
 #include <sys/types.h>
+#include <time.h>
 #include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
 #include "gui/lib.h"
 #include "mutt.h"
 #include "connaccount.h"
 #include "mutt_globals.h"
 #include "options.h"
 
+/**
+ * struct OAuthToken - A cached OAuth access token
+ */
+struct OAuthToken
+{
+  char *cmd;      ///< Refresh command that produced the token
+  char *token;    ///< Access token returned by the command
+  time_t expires; ///< Time from which the token is no longer trusted
+};
+ARRAY_HEAD(OAuthTokenArray, struct OAuthToken);
+
+/// Access tokens from the `$*_oauth_refresh_command`s, reused until they
+/// expire so that reconnects don't fork the refresh helper again
+static struct OAuthTokenArray OAuthTokens = ARRAY_HEAD_INITIALIZER;
+
+/**
+ * oauth_cache_find - Find the cache entry for a refresh command
+ * @param cmd Refresh command
+ * @retval ptr  Matching entry
+ * @retval NULL Not found
+ */
+static struct OAuthToken *oauth_cache_find(const char *cmd)
+{
+  struct OAuthToken *ot = NULL;
+  ARRAY_FOREACH(ot, &OAuthTokens)
+  {
+    if (mutt_str_equal(ot->cmd, cmd))
+      return ot;
+  }
+  return NULL;
+}
+
+/**
+ * oauth_cache_wipe - Securely erase a cached token
+ * @param ot Entry to erase
+ */
+static void oauth_cache_wipe(struct OAuthToken *ot)
+{
+  if (ot->token)
+    memset(ot->token, 0, mutt_str_len(ot->token));
+  FREE(&ot->token);
+  ot->expires = 0;
+}
+
 /**
  * mutt_account_getuser - Retrieve username into ConnAccount, if necessary
  * @param cac ConnAccount to fill
@@ -186,39 +233,63 @@ char *mutt_account_getoauthbearer(struct ConnAccount *cac, bool xoauth2)
     return NULL;
   }
 
-  FILE *fp = NULL;
-  pid_t pid = filter_create(cmd, NULL, &fp, NULL);
-  if (pid < 0)
-  {
-    mutt_perror(_("Unable to run refresh command"));
-    return NULL;
-  }
+  const short c_oauth_token_lifetime =
+      cs_subset_number(NeoMutt->sub, "oauth_token_lifetime");
 
+  char *token = NULL;
   size_t token_size = 0;
-  char *token = mutt_file_read_line(NULL, &token_size, fp, NULL, MUTT_RL_NO_FLAGS);
-  mutt_file_fclose(&fp);
-  filter_wait(pid);
-
-  /* The refresh cmd in some cases will invoke gpg to decrypt a token */
-  if (!OptNoCurses)
-    mutt_need_hard_redraw();
 
-  /* The refresh cmd in some cases will invoke gpg to decrypt a token */
-  if (!OptNoCurses)
-    mutt_need_hard_redraw();
-
-  if (!token || (*token == '\0'))
+  struct OAuthToken *cached = oauth_cache_find(cmd);
+  if (cached && cached->token && (mutt_date_epoch() < cached->expires))
   {
-    mutt_error(_("Command returned empty string"));
-    FREE(&token);
-    return NULL;
+    token = mutt_str_dup(cached->token);
+    token_size = mutt_str_len(token);
   }
 
-  if ((!xoauth2 && (token_size > 512)) || (xoauth2 && (token_size > 4096)))
+  if (!token)
   {
-    mutt_error(_("OAUTH token is too big: %ld"), token_size);
-    FREE(&token);
-    return NULL;
+    FILE *fp = NULL;
+    pid_t pid = filter_create(cmd, NULL, &fp, NULL);
+    if (pid < 0)
+    {
+      mutt_perror(_("Unable to run refresh command"));
+      return NULL;
+    }
+
+    token = mutt_file_read_line(NULL, &token_size, fp, NULL, MUTT_RL_NO_FLAGS);
+    mutt_file_fclose(&fp);
+    filter_wait(pid);
+
+    /* The refresh cmd in some cases will invoke gpg to decrypt a token */
+    if (!OptNoCurses)
+      mutt_need_hard_redraw();
+
+    if (!token || (*token == '\0'))
+    {
+      mutt_error(_("Command returned empty string"));
+      FREE(&token);
+      return NULL;
+    }
+
+    if ((!xoauth2 && (token_size > 512)) || (xoauth2 && (token_size > 4096)))
+    {
+      mutt_error(_("OAUTH token is too big: %ld"), token_size);
+      FREE(&token);
+      return NULL;
+    }
+
+    if (c_oauth_token_lifetime > 0)
+    {
+      if (!cached)
+      {
+        struct OAuthToken ot = { mutt_str_dup(cmd), NULL, 0 };
+        ARRAY_ADD(&OAuthTokens, ot);
+        cached = ARRAY_LAST(&OAuthTokens);
+      }
+      oauth_cache_wipe(cached);
+      cached->token = mutt_str_dup(token);
+      cached->expires = mutt_date_epoch() + c_oauth_token_lifetime;
+    }
   }
 
   /* 4500 is chosen to allow for both a token that is 4096-long plus a
@@ -246,3 +317,38 @@ char *mutt_account_getoauthbearer(struct ConnAccount *cac, bool xoauth2)
 
   return encoded_token;
 }
+
+/**
+ * mutt_account_oauth_invalidate - Drop an Account's cached OAuth token
+ * @param cac Account to use
+ *
+ * Called when the server rejects a token, so the next attempt runs the
+ * refresh command again instead of replaying the rejected token.
+ */
+void mutt_account_oauth_invalidate(struct ConnAccount *cac)
+{
+  if (!cac || !cac->get_field)
+    return;
+
+  const char *cmd = cac->get_field(MUTT_CA_OAUTH_CMD, cac->gf_data);
+  if (!cmd)
+    return;
+
+  struct OAuthToken *ot = oauth_cache_find(cmd);
+  if (ot)
+    oauth_cache_wipe(ot);
+}
+
+/**
+ * mutt_account_oauth_cleanup - Free the OAuth token cache
+ */
+void mutt_account_oauth_cleanup(void)
+{
+  struct OAuthToken *ot = NULL;
+  ARRAY_FOREACH(ot, &OAuthTokens)
+  {
+    oauth_cache_wipe(ot);
+    FREE(&ot->cmd);
+  }
+  ARRAY_FREE(&OAuthTokens);
+}
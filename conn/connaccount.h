@@ -70,10 +70,12 @@ struct ConnAccount
   void *gf_data;          ///< Private data to pass to get_field()
 };
 
-int   mutt_account_getlogin      (struct ConnAccount *account);
-char *mutt_account_getoauthbearer(struct ConnAccount *account, bool xoauth2);
-int   mutt_account_getpass       (struct ConnAccount *account);
-int   mutt_account_getuser       (struct ConnAccount *account);
-void  mutt_account_unsetpass     (struct ConnAccount *account);
+int   mutt_account_getlogin       (struct ConnAccount *account);
+char *mutt_account_getoauthbearer (struct ConnAccount *account, bool xoauth2);
+int   mutt_account_getpass        (struct ConnAccount *account);
+int   mutt_account_getuser        (struct ConnAccount *account);
+void  mutt_account_oauth_cleanup  (void);
+void  mutt_account_oauth_invalidate(struct ConnAccount *account);
+void  mutt_account_unsetpass      (struct ConnAccount *account);
 
 #endif /* MUTT_CONN_CONNACCOUNT_H */
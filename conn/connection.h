@@ -49,8 +49,11 @@ struct Connection
 {
   struct ConnAccount account; ///< Account details: username, password, etc
   unsigned int ssf;           ///< Security strength factor, in bits (see notes)
-  char inbuf[1024];           ///< Buffer for incoming traffic
+  char *inbuf;                ///< Buffer for incoming traffic, see socket_fill_inbuf()
+  size_t inbufsize;           ///< Current size of inbuf
   int bufpos;                 ///< Current position in the buffer
+  char outbuf[4096];          ///< Buffer for outgoing traffic
+  int outlen;                 ///< Amount of data waiting to be written
   int fd;                     ///< Socket file descriptor
   int available;              ///< Amount of data waiting to be read
   void *sockdata;             ///< Backend-specific socket data
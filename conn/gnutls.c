@@ -28,12 +28,14 @@
  */
 
 #include "config.h"
+#include <fcntl.h>
 #include <gnutls/gnutls.h>
 #include <gnutls/x509.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
+#include <unistd.h>
 #include "private.h"
 #include "mutt/lib.h"
 #include "config/lib.h"
@@ -632,6 +634,11 @@ static int tls_check_certificate(struct Connection *conn)
   int certerr, savedcert, rc = 0;
   int max_preauth_pass = -1;
 
+  /* The certificate was checked when the resumed session was first
+   * established; the server can only resume it while it holds the keys */
+  if (gnutls_session_is_resumed(state))
+    return 1;
+
   /* tls_verify_peers() calls gnutls_certificate_verify_peers2(),
    * which verifies the auth_type is GNUTLS_CRD_CERTIFICATE
    * and that get_certificate_type() for the server is GNUTLS_CRT_X509.
@@ -879,6 +886,96 @@ static int tls_set_priority(struct TlsSockData *data)
 }
 #endif
 
+/**
+ * tls_session_path - Build the cache-file path for a Connection's TLS session
+ * @param conn Connection to a server
+ * @param path Buffer for the result
+ * @retval true $ssl_session_cache is set and @a path was filled
+ */
+static bool tls_session_path(struct Connection *conn, struct Buffer *path)
+{
+  const char *const c_ssl_session_cache =
+      cs_subset_path(NeoMutt->sub, "ssl_session_cache");
+  if (!c_ssl_session_cache)
+    return false;
+
+  mutt_buffer_printf(path, "%s/%s_%d", c_ssl_session_cache,
+                     conn->account.host, conn->account.port);
+  return true;
+}
+
+/**
+ * tls_session_restore - Offer a cached session to the server for resumption
+ * @param conn Connection to a server
+ *
+ * Must be called before gnutls_handshake().  If the server still honours the
+ * session (or its ticket), the handshake completes in one round trip instead
+ * of two.  A stale session is simply ignored by the server.
+ */
+static void tls_session_restore(struct Connection *conn)
+{
+  struct TlsSockData *data = conn->sockdata;
+  struct Buffer *path = mutt_buffer_pool_get();
+
+  if (tls_session_path(conn, path))
+  {
+    FILE *fp = mutt_file_fopen(mutt_buffer_string(path), "rb");
+    if (fp)
+    {
+      char buf[8192];
+      const size_t len = fread(buf, 1, sizeof(buf), fp);
+      if ((len > 0) && (len < sizeof(buf)))
+        gnutls_session_set_data(data->state, buf, len);
+      mutt_file_fclose(&fp);
+    }
+  }
+
+  mutt_buffer_pool_release(&path);
+}
+
+/**
+ * tls_session_store - Save the session for a later resumption
+ * @param conn Connection to a server
+ *
+ * Called when the connection is shut down: with TLS 1.3 the session ticket
+ * only arrives some time after the handshake, so saving at close time is the
+ * only point where it's reliably available.
+ */
+static void tls_session_store(struct Connection *conn)
+{
+  struct TlsSockData *data = conn->sockdata;
+  struct Buffer *path = mutt_buffer_pool_get();
+
+  if (tls_session_path(conn, path))
+  {
+    gnutls_datum_t sd = { 0 };
+    if ((gnutls_session_get_data2(data->state, &sd) == 0) && (sd.size > 0))
+    {
+      /* whoever can read a session ticket can decrypt its resumed traffic,
+       * so the file must be 0600 from the moment it exists */
+      FILE *fp = NULL;
+      const int fd = open(mutt_buffer_string(path),
+                          O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW, S_IRUSR | S_IWUSR);
+      if (fd >= 0)
+      {
+        /* the creation mode doesn't apply if the file already existed */
+        if (fchmod(fd, S_IRUSR | S_IWUSR) == 0)
+          fp = fdopen(fd, "wb");
+        if (!fp)
+          close(fd);
+      }
+      if (fp)
+      {
+        fwrite(sd.data, 1, sd.size, fp);
+        mutt_file_fclose(&fp);
+      }
+      gnutls_free(sd.data);
+    }
+  }
+
+  mutt_buffer_pool_release(&path);
+}
+
 /**
  * tls_negotiate - Negotiate TLS connection
  * @param conn Connection to a server
@@ -958,6 +1055,8 @@ static int tls_negotiate(struct Connection *conn)
 
   gnutls_credentials_set(data->state, GNUTLS_CRD_CERTIFICATE, data->xcred);
 
+  tls_session_restore(conn);
+
   do
   {
     err = gnutls_handshake(data->state);
@@ -1028,6 +1127,8 @@ static int tls_socket_close(struct Connection *conn)
   struct TlsSockData *data = conn->sockdata;
   if (data)
   {
+    tls_session_store(conn);
+
     /* shut down only the write half to avoid hanging waiting for the remote to respond.
      *
      * RFC5246 7.2.1. "Closure Alerts"
@@ -28,6 +28,7 @@
 
 #include "config.h"
 #include <errno.h>
+#include <fcntl.h>
 #include <openssl/asn1.h>
 #include <openssl/bio.h>
 #include <openssl/err.h>
@@ -85,6 +86,10 @@ static int HostExDataIndex = -1;
  * non-null. */
 static int SkipModeExDataIndex = -1;
 
+/* index for storing the Connection in the SSL structure, so the
+ * new-session callback can find the account it belongs to */
+static int ConnExDataIndex = -1;
+
 /* keep a handle on accepted certificates in case we want to
  * open up another connection to the same server in this session */
 static STACK_OF(X509) *SslSessionCerts = NULL;
@@ -1111,6 +1116,96 @@ static int ssl_verify_callback(int preverify_ok, X509_STORE_CTX *ctx)
   return true;
 }
 
+/**
+ * ssl_session_path - Build the cache-file path for a Connection's TLS session
+ * @param conn Connection to a server
+ * @param path Buffer for the result
+ * @retval true $ssl_session_cache is set and @a path was filled
+ */
+static bool ssl_session_path(struct Connection *conn, struct Buffer *path)
+{
+  const char *const c_ssl_session_cache =
+      cs_subset_path(NeoMutt->sub, "ssl_session_cache");
+  if (!c_ssl_session_cache)
+    return false;
+
+  mutt_buffer_printf(path, "%s/%s_%d", c_ssl_session_cache,
+                     conn->account.host, conn->account.port);
+  return true;
+}
+
+/**
+ * ssl_session_new_cb - Save a negotiated session for later resumption
+ * @param ssl  SSL connection the session belongs to
+ * @param sess Session established by the server
+ * @retval 0 Always: no reference to the session is kept
+ *
+ * Registered with SSL_CTX_sess_set_new_cb() when $ssl_session_cache is set.
+ * A callback is the only reliable capture point: with TLS 1.3 the session
+ * ticket arrives some time after SSL_connect() returns.
+ */
+static int ssl_session_new_cb(SSL *ssl, SSL_SESSION *sess)
+{
+  struct Connection *conn = SSL_get_ex_data(ssl, ConnExDataIndex);
+  if (!conn)
+    return 0;
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  if (ssl_session_path(conn, path))
+  {
+    /* session tickets allow decryption of the traffic they resume, so the
+     * file must be 0600 from the moment it exists */
+    FILE *fp = NULL;
+    const int fd = open(mutt_buffer_string(path),
+                        O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW, S_IRUSR | S_IWUSR);
+    if (fd >= 0)
+    {
+      /* the creation mode doesn't apply if the file already existed */
+      if (fchmod(fd, S_IRUSR | S_IWUSR) == 0)
+        fp = fdopen(fd, "wb");
+      if (!fp)
+        close(fd);
+    }
+    if (fp)
+    {
+      PEM_write_SSL_SESSION(fp, sess);
+      mutt_file_fclose(&fp);
+    }
+  }
+  mutt_buffer_pool_release(&path);
+
+  return 0;
+}
+
+/**
+ * ssl_session_restore - Offer a cached session to the server for resumption
+ * @param conn    Connection to a server
+ * @param ssldata SSL socket data
+ *
+ * Must happen before SSL_connect().  If the server accepts the session, the
+ * handshake completes in one round trip; if not, it falls back to a full
+ * handshake transparently.
+ */
+static void ssl_session_restore(struct Connection *conn, struct SslSockData *ssldata)
+{
+  struct Buffer *path = mutt_buffer_pool_get();
+  if (ssl_session_path(conn, path))
+  {
+    FILE *fp = mutt_file_fopen(mutt_buffer_string(path), "rb");
+    if (fp)
+    {
+      SSL_SESSION *sess = PEM_read_SSL_SESSION(fp, NULL, NULL, NULL);
+      if (sess)
+      {
+        SSL_set_session(ssldata->ssl, sess);
+        SSL_SESSION_free(sess);
+      }
+      mutt_file_fclose(&fp);
+    }
+  }
+  mutt_buffer_pool_release(&path);
+}
+
 /**
  * ssl_negotiate - Attempt to negotiate SSL over the wire
  * @param conn    Connection to a server
@@ -1154,6 +1249,22 @@ static int ssl_negotiate(struct Connection *conn, struct SslSockData *ssldata)
     return -1;
   }
 
+  ConnExDataIndex = SSL_get_ex_new_index(0, "conn", NULL, NULL, NULL);
+  if (ConnExDataIndex == -1)
+  {
+    mutt_debug(LL_DEBUG1,
+               "#5 failed to get index for application specific data\n");
+    return -1;
+  }
+
+  if (!SSL_set_ex_data(ssldata->ssl, ConnExDataIndex, conn))
+  {
+    mutt_debug(LL_DEBUG1, "#6 failed to save connection in SSL structure\n");
+    return -1;
+  }
+
+  ssl_session_restore(conn, ssldata);
+
   SSL_set_verify(ssldata->ssl, SSL_VERIFY_PEER, ssl_verify_callback);
   SSL_set_mode(ssldata->ssl, SSL_MODE_AUTO_RETRY);
 
@@ -1289,6 +1400,15 @@ static int ssl_setup(struct Connection *conn)
     mutt_error(_("Warning: error enabling ssl_verify_partial_chains"));
   }
 
+  const char *const c_ssl_session_cache =
+      cs_subset_path(NeoMutt->sub, "ssl_session_cache");
+  if (c_ssl_session_cache)
+  {
+    SSL_CTX_set_session_cache_mode(sockdata(conn)->sctx,
+                                   SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(sockdata(conn)->sctx, ssl_session_new_cb);
+  }
+
   sockdata(conn)->ssl = SSL_new(sockdata(conn)->sctx);
   SSL_set_fd(sockdata(conn)->ssl, conn->fd);
 
@@ -58,6 +58,7 @@
 #include <stdbool.h>
 #endif
 
+#ifndef HAVE_GETADDRINFO
 /**
  * socket_connect - Set up to connect to a socket fd
  * @param fd File descriptor to connect with
@@ -113,6 +114,383 @@ static int socket_connect(int fd, struct sockaddr *sa)
 
   return save_errno;
 }
+#endif /* !HAVE_GETADDRINFO */
+
+#ifdef HAVE_GETADDRINFO
+/// Delay before the next connection attempt may start while another is still
+/// racing, per RFC 8305 (Happy Eyeballs)
+#define CONNECT_ATTEMPT_DELAY_MS 250
+
+/**
+ * socket_connect_race - Race connection attempts across addresses
+ * @param conn Connection to open
+ * @param res  Resolved addresses to try
+ * @retval  0 Success, conn->fd holds the connected socket
+ * @retval >0 An errno, e.g. ETIMEDOUT
+ * @retval -1 Error
+ *
+ * Instead of giving every address a full timeout before the next one may be
+ * tried, start a non-blocking connect to the first address and, every
+ * #CONNECT_ATTEMPT_DELAY_MS, to the next one - alternating between address
+ * families.  The first attempt to complete wins and the others are dropped,
+ * so an unreachable IPv6 address delays the IPv4 fallback by the stagger
+ * interval, not by a whole TCP timeout.  `$connect_timeout` bounds the whole
+ * race.
+ */
+static int socket_connect_race(struct Connection *conn, struct addrinfo *res)
+{
+  size_t num = 0;
+  for (struct addrinfo *cur = res; cur; cur = cur->ai_next)
+    num++;
+  if (num == 0)
+    return -1;
+
+  /* Interleave the address families, keeping the resolver's preference first */
+  struct addrinfo **order = mutt_mem_calloc(num, sizeof(*order));
+  {
+    struct addrinfo **prim = mutt_mem_calloc(num, sizeof(*prim));
+    struct addrinfo **sec = mutt_mem_calloc(num, sizeof(*sec));
+    size_t np = 0, ns = 0;
+    for (struct addrinfo *cur = res; cur; cur = cur->ai_next)
+    {
+      if (cur->ai_family == res->ai_family)
+        prim[np++] = cur;
+      else
+        sec[ns++] = cur;
+    }
+    for (size_t i = 0, p = 0, s = 0; i < num; i++)
+    {
+      const bool want_prim = ((i % 2) == 0);
+      if ((want_prim && (p < np)) || (s >= ns))
+        order[i] = prim[p++];
+      else
+        order[i] = sec[s++];
+    }
+    FREE(&prim);
+    FREE(&sec);
+  }
+
+  int *fds = mutt_mem_calloc(num, sizeof(int));
+  for (size_t i = 0; i < num; i++)
+    fds[i] = -1;
+
+  const short c_connect_timeout =
+      cs_subset_number(NeoMutt->sub, "connect_timeout");
+  uint64_t ms = mutt_date_epoch_ms();
+  const uint64_t deadline =
+      (c_connect_timeout > 0) ? (ms + ((uint64_t) c_connect_timeout * 1000)) : 0;
+  uint64_t next_start = ms;
+
+  size_t started = 0;
+  size_t active = 0;
+  int winner = -1;
+  int save_errno = 0;
+
+  /* FreeBSD's connect() does not respect SA_RESTART, meaning
+   * a SIGWINCH will cause the connect to fail. */
+  sigset_t set;
+  sigemptyset(&set);
+  sigaddset(&set, SIGWINCH);
+  sigprocmask(SIG_BLOCK, &set, NULL);
+  mutt_sig_allow_interrupt(true);
+
+  while (winner < 0)
+  {
+    ms = mutt_date_epoch_ms();
+    if ((deadline != 0) && (ms >= deadline))
+    {
+      save_errno = ETIMEDOUT;
+      break;
+    }
+
+    /* start the next attempt when nothing is racing yet,
+     * or the stagger delay has elapsed */
+    while ((started < num) && ((active == 0) || (ms >= next_start)))
+    {
+      struct addrinfo *cur = order[started];
+      int fd = socket(cur->ai_family, cur->ai_socktype, cur->ai_protocol);
+      started++;
+      if (fd < 0)
+        continue;
+
+      const int flags = fcntl(fd, F_GETFL, 0);
+      (void) fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+      if (connect(fd, cur->ai_addr, cur->ai_addrlen) == 0)
+      {
+        winner = fd;
+        break;
+      }
+      if (errno == EINPROGRESS)
+      {
+        fds[started - 1] = fd;
+        active++;
+        next_start = ms + CONNECT_ATTEMPT_DELAY_MS;
+      }
+      else
+      {
+        save_errno = errno;
+        close(fd);
+      }
+    }
+    if (winner >= 0)
+      break;
+
+    if ((active == 0) && (started == num))
+      break; /* every attempt failed outright */
+
+    fd_set wfds;
+    FD_ZERO(&wfds);
+    int maxfd = -1;
+    for (size_t i = 0; i < started; i++)
+    {
+      if (fds[i] < 0)
+        continue;
+      FD_SET(fds[i], &wfds);
+      if (fds[i] > maxfd)
+        maxfd = fds[i];
+    }
+
+    uint64_t wait_until = (started < num) ? next_start : deadline;
+    if ((deadline != 0) && ((wait_until == 0) || (deadline < wait_until)))
+      wait_until = deadline;
+
+    struct timeval tv;
+    struct timeval *tvp = NULL;
+    ms = mutt_date_epoch_ms();
+    if (wait_until != 0)
+    {
+      const uint64_t delta = (wait_until > ms) ? (wait_until - ms) : 0;
+      tv.tv_sec = delta / 1000;
+      tv.tv_usec = (delta % 1000) * 1000;
+      tvp = &tv;
+    }
+
+    const int rc = select(maxfd + 1, NULL, &wfds, NULL, tvp);
+    if (rc < 0)
+    {
+      if ((errno == EINTR) && !SigInt)
+        continue;
+      save_errno = errno;
+      SigInt = false; /* reset in case we caught SIGINT while waiting */
+      break;
+    }
+    if (rc == 0)
+      continue; /* stagger delay or deadline elapsed */
+
+    for (size_t i = 0; i < started; i++)
+    {
+      if ((fds[i] < 0) || !FD_ISSET(fds[i], &wfds))
+        continue;
+
+      int err = 0;
+      socklen_t errlen = sizeof(err);
+      if (getsockopt(fds[i], SOL_SOCKET, SO_ERROR, &err, &errlen) != 0)
+        err = errno;
+      if (err == 0)
+      {
+        winner = fds[i];
+        fds[i] = -1;
+        active--;
+        break;
+      }
+      mutt_debug(LL_DEBUG2, "Connection failed. errno: %d\n", err);
+      save_errno = err;
+      close(fds[i]);
+      fds[i] = -1;
+      active--;
+    }
+  }
+
+  mutt_sig_allow_interrupt(false);
+  sigprocmask(SIG_UNBLOCK, &set, NULL);
+
+  for (size_t i = 0; i < started; i++)
+  {
+    if (fds[i] >= 0)
+      close(fds[i]);
+  }
+  FREE(&fds);
+  FREE(&order);
+
+  if (winner < 0)
+    return (save_errno != 0) ? save_errno : -1;
+
+  const int flags = fcntl(winner, F_GETFL, 0);
+  (void) fcntl(winner, F_SETFL, flags & ~O_NONBLOCK);
+  (void) fcntl(winner, F_SETFD, FD_CLOEXEC);
+  conn->fd = winner;
+  return 0;
+}
+
+/**
+ * struct PreConn - A TCP connection opened ahead of need
+ */
+struct PreConn
+{
+  char host[128];      ///< Server name, as it appears in ConnAccount.host
+  unsigned short port; ///< Port to connect to
+  int fd;              ///< Connected socket, or -1
+};
+ARRAY_HEAD(PreConnArray, struct PreConn);
+
+/// Connections opened in parallel at startup, waiting to be adopted by
+/// raw_socket_open().  Filled once by mutt_preconn_start(); each worker only
+/// writes its own slot, so no locking is needed.
+static struct PreConnArray PreConns = ARRAY_HEAD_INITIALIZER;
+
+/// Copy of `$connect_timeout`, read before the workers start
+static short PreConnTimeout = 0;
+
+/**
+ * preconn_worker - Open a TCP connection to one server - Implements ::mutt_worker_fn_t
+ *
+ * Resolve the host and try the addresses in the resolver's order.  This runs
+ * on a worker thread, so there are no progress messages, no SIGINT handling
+ * and no Happy-Eyeballs racing - `$connect_timeout` bounds each attempt and
+ * an unreachable server only costs its own worker time.
+ */
+static void preconn_worker(size_t index, void *wdata)
+{
+  struct PreConn *pc = ARRAY_GET((struct PreConnArray *) wdata, index);
+
+  char port[6];
+  snprintf(port, sizeof(port), "%d", pc->port);
+
+  struct addrinfo hints = { 0 };
+  const bool c_use_ipv6 = cs_subset_bool(NeoMutt->sub, "use_ipv6");
+  hints.ai_family = c_use_ipv6 ? AF_UNSPEC : AF_INET;
+  hints.ai_socktype = SOCK_STREAM;
+
+  struct addrinfo *res = NULL;
+  if (getaddrinfo(pc->host, port, &hints, &res) != 0)
+    return;
+
+  for (struct addrinfo *cur = res; cur && (pc->fd < 0); cur = cur->ai_next)
+  {
+    int fd = socket(cur->ai_family, cur->ai_socktype, cur->ai_protocol);
+    if (fd < 0)
+      continue;
+
+    const int flags = fcntl(fd, F_GETFL, 0);
+    (void) fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+
+    int rc = connect(fd, cur->ai_addr, cur->ai_addrlen);
+    if ((rc != 0) && (errno == EINPROGRESS))
+    {
+      fd_set wfds;
+      FD_ZERO(&wfds);
+      FD_SET(fd, &wfds);
+      struct timeval tv = { PreConnTimeout, 0 };
+      struct timeval *tvp = (PreConnTimeout > 0) ? &tv : NULL;
+      if (select(fd + 1, NULL, &wfds, NULL, tvp) == 1)
+      {
+        int err = 0;
+        socklen_t errlen = sizeof(err);
+        if ((getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &errlen) == 0) && (err == 0))
+          rc = 0;
+      }
+    }
+
+    if (rc == 0)
+    {
+      (void) fcntl(fd, F_SETFL, flags & ~O_NONBLOCK);
+      (void) fcntl(fd, F_SETFD, FD_CLOEXEC);
+      pc->fd = fd;
+    }
+    else
+    {
+      close(fd);
+    }
+  }
+
+  freeaddrinfo(res);
+}
+
+/**
+ * preconn_adopt - Take over a pre-opened connection to a server
+ * @param conn Connection to open
+ * @retval true conn->fd holds a connected socket
+ *
+ * A pre-opened socket may have been closed by the server in the meantime, so
+ * peek at it first; a dead one is thrown away and the caller connects from
+ * scratch, exactly as if the pre-connect had never happened.
+ */
+static bool preconn_adopt(struct Connection *conn)
+{
+  struct PreConn *pc = NULL;
+  ARRAY_FOREACH(pc, &PreConns)
+  {
+    if ((pc->fd < 0) || (pc->port != conn->account.port) ||
+        !mutt_istr_equal(pc->host, conn->account.host))
+    {
+      continue;
+    }
+
+    const int fd = pc->fd;
+    pc->fd = -1;
+
+    char c;
+    const ssize_t rc = recv(fd, &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    if ((rc == 0) || ((rc < 0) && (errno != EAGAIN) && (errno != EWOULDBLOCK)))
+    {
+      close(fd); /* the server hung up on us */
+      return false;
+    }
+
+    conn->fd = fd;
+    return true;
+  }
+  return false;
+}
+#endif /* HAVE_GETADDRINFO */
+
+/**
+ * mutt_preconn_start - Open TCP connections to several servers in parallel
+ * @param cacs        Servers to connect to
+ * @param num         Number of servers
+ * @param num_threads Number of threads to use
+ *
+ * Establish the TCP leg of every Account's connection concurrently at
+ * startup, so the serial opens later only pay for the TLS handshake and
+ * authentication (which need the UI for certificate and password prompts and
+ * must stay on the main thread).  Blocks until every connect has succeeded,
+ * failed or timed out.
+ */
+void mutt_preconn_start(const struct ConnAccount *cacs, size_t num, size_t num_threads)
+{
+#ifdef HAVE_GETADDRINFO
+  if (!cacs || (num == 0))
+    return;
+
+  for (size_t i = 0; i < num; i++)
+  {
+    struct PreConn pc = { { 0 } };
+    mutt_str_copy(pc.host, cacs[i].host, sizeof(pc.host));
+    pc.port = cacs[i].port;
+    pc.fd = -1;
+    ARRAY_ADD(&PreConns, pc);
+  }
+
+  PreConnTimeout = cs_subset_number(NeoMutt->sub, "connect_timeout");
+  mutt_worker_run(preconn_worker, &PreConns, ARRAY_SIZE(&PreConns), num_threads);
+#endif
+}
+
+/**
+ * mutt_preconn_cleanup - Close any pre-opened connections that were never used
+ */
+void mutt_preconn_cleanup(void)
+{
+#ifdef HAVE_GETADDRINFO
+  struct PreConn *pc = NULL;
+  ARRAY_FOREACH(pc, &PreConns)
+  {
+    if (pc->fd >= 0)
+      close(pc->fd);
+  }
+  ARRAY_FREE(&PreConns);
+#endif
+}
 
 /**
  * raw_socket_open - Open a socket - Implements Connection::open() - @ingroup connection_open
@@ -126,11 +504,13 @@ int raw_socket_open(struct Connection *conn)
 #ifdef HAVE_GETADDRINFO
   /* --- IPv4/6 --- */
 
+  if (preconn_adopt(conn))
+    return 0;
+
   /* "65536\0" */
   char port[6];
   struct addrinfo hints;
   struct addrinfo *res = NULL;
-  struct addrinfo *cur = NULL;
 
   /* we accept v4 or v6 STREAM sockets */
   memset(&hints, 0, sizeof(hints));
@@ -173,23 +553,7 @@ int raw_socket_open(struct Connection *conn)
   if (!OptNoCurses)
     mutt_message(_("Connecting to %s..."), conn->account.host);
 
-  rc = -1;
-  for (cur = res; cur; cur = cur->ai_next)
-  {
-    int fd = socket(cur->ai_family, cur->ai_socktype, cur->ai_protocol);
-    if (fd >= 0)
-    {
-      rc = socket_connect(fd, cur->ai_addr);
-      if (rc == 0)
-      {
-        (void) fcntl(fd, F_SETFD, FD_CLOEXEC);
-        conn->fd = fd;
-        break;
-      }
-      else
-        close(fd);
-    }
-  }
+  rc = socket_connect_race(conn, res);
 
   freeaddrinfo(res);
 #else
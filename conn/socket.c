@@ -42,6 +42,60 @@
 #include "protos.h"
 #include "ssl.h"
 
+#define SOCKET_INBUF_BASE 1024          ///< Initial size of Connection::inbuf
+#define SOCKET_INBUF_MAX (256 * 1024)   ///< Upper limit for Connection::inbuf
+
+/**
+ * socket_fill_inbuf - Refill a Connection's read buffer
+ * @param conn Connection to a server
+ * @retval >0 Number of bytes now available
+ * @retval -1 Error, the socket has been closed
+ *
+ * The buffer starts at #SOCKET_INBUF_BASE and doubles whenever a read fills
+ * it completely, i.e. when the network has more data queued than the buffer
+ * can take.  An interactive session never grows it; a bulk transfer (a large
+ * IMAP literal, an NNTP overview) quickly reaches #SOCKET_INBUF_MAX and pays
+ * far fewer read() calls and TLS records.  mutt_socket_close() releases the
+ * buffer, so an idle connection doesn't sit on the large allocation.
+ */
+static int socket_fill_inbuf(struct Connection *conn)
+{
+  if (conn->fd < 0)
+  {
+    mutt_debug(LL_DEBUG1, "attempt to read from closed connection\n");
+    return -1;
+  }
+
+  if (mutt_socket_flush(conn) < 0)
+    return -1;
+
+  if (!conn->inbuf)
+  {
+    conn->inbufsize = SOCKET_INBUF_BASE;
+    conn->inbuf = mutt_mem_malloc(conn->inbufsize);
+  }
+  else if ((conn->available > 0) && ((size_t) conn->available == conn->inbufsize) &&
+           (conn->inbufsize < SOCKET_INBUF_MAX))
+  {
+    conn->inbufsize *= 2;
+    mutt_mem_realloc(&conn->inbuf, conn->inbufsize);
+  }
+
+  conn->available = conn->read(conn, conn->inbuf, conn->inbufsize);
+  conn->bufpos = 0;
+  if (conn->available == 0)
+  {
+    mutt_error(_("Connection to %s closed"), conn->account.host);
+  }
+  if (conn->available <= 0)
+  {
+    mutt_socket_close(conn);
+    return -1;
+  }
+
+  return conn->available;
+}
+
 /**
  * socket_preconnect - Execute a command before opening a socket
  * @retval 0  Success
@@ -67,6 +121,49 @@ static int socket_preconnect(void)
   return 0;
 }
 
+/**
+ * socket_buffer_write - Queue data in a Connection's write buffer
+ * @param conn Connection to a server
+ * @param buf  Buffer with data to write
+ * @param len  Length of data to write
+ * @retval >=0 Number of bytes accepted
+ * @retval  -1 Error, see errno
+ *
+ * Small fragments coalesce in Connection::outbuf until the buffer is flushed;
+ * data too big for the buffer is written out directly.
+ */
+static int socket_buffer_write(struct Connection *conn, const char *buf, size_t len)
+{
+  /* make room for this fragment */
+  if (len > (sizeof(conn->outbuf) - conn->outlen))
+  {
+    if (mutt_socket_flush(conn) < 0)
+      return -1;
+  }
+
+  if (len <= sizeof(conn->outbuf))
+  {
+    memcpy(conn->outbuf + conn->outlen, buf, len);
+    conn->outlen += len;
+    return len;
+  }
+
+  size_t sent = 0;
+  while (sent < len)
+  {
+    const int rc = conn->write(conn, buf + sent, len - sent);
+    if (rc < 0)
+      return -1;
+
+    if (rc < (len - sent))
+      mutt_debug(LL_DEBUG3, "short write (%d of %zu bytes)\n", rc, len - sent);
+
+    sent += rc;
+  }
+
+  return sent;
+}
+
 /**
  * mutt_socket_open - Simple wrapper
  * @param conn Connection to a server
@@ -104,16 +201,62 @@ int mutt_socket_close(struct Connection *conn)
   if (conn->fd < 0)
     mutt_debug(LL_DEBUG1, "Attempt to close closed connection\n");
   else
+  {
+    /* best effort: push out anything still waiting in the write buffer */
+    for (int sent = 0; sent < conn->outlen;)
+    {
+      const int w = conn->write(conn, conn->outbuf + sent, conn->outlen - sent);
+      if (w < 0)
+        break;
+      sent += w;
+    }
+    conn->outlen = 0;
     rc = conn->close(conn);
+  }
 
   conn->fd = -1;
   conn->ssf = 0;
+  FREE(&conn->inbuf);
+  conn->inbufsize = 0;
   conn->bufpos = 0;
+  conn->outlen = 0;
   conn->available = 0;
 
   return rc;
 }
 
+/**
+ * mutt_socket_flush - Write any buffered data to a Connection
+ * @param conn Connection to a server
+ * @retval  0 Success
+ * @retval -1 Error, the socket has been closed
+ *
+ * Writes are buffered in Connection::outbuf and flushed here, before a reply
+ * is read, or at an explicit command boundary.  Coalescing the fragments of a
+ * command into one write() saves syscalls and, on an encrypted Connection,
+ * avoids sending a TLS record per fragment.
+ */
+int mutt_socket_flush(struct Connection *conn)
+{
+  int sent = 0;
+
+  while (sent < conn->outlen)
+  {
+    const int rc = conn->write(conn, conn->outbuf + sent, conn->outlen - sent);
+    if (rc < 0)
+    {
+      conn->outlen = 0;
+      mutt_debug(LL_DEBUG1, "error writing (%s), closing socket\n", strerror(errno));
+      mutt_socket_close(conn);
+      return -1;
+    }
+    sent += rc;
+  }
+
+  conn->outlen = 0;
+  return 0;
+}
+
 /**
  * mutt_socket_read - Read from a Connection
  * @param conn Connection a server
@@ -124,6 +267,9 @@ int mutt_socket_close(struct Connection *conn)
  */
 int mutt_socket_read(struct Connection *conn, char *buf, size_t len)
 {
+  if (mutt_socket_flush(conn) < 0)
+    return -1;
+
   return conn->read(conn, buf, len);
 }
 
@@ -137,7 +283,7 @@ int mutt_socket_read(struct Connection *conn, char *buf, size_t len)
  */
 int mutt_socket_write(struct Connection *conn, const char *buf, size_t len)
 {
-  return conn->write(conn, buf, len);
+  return socket_buffer_write(conn, buf, len);
 }
 
 /**
@@ -151,8 +297,6 @@ int mutt_socket_write(struct Connection *conn, const char *buf, size_t len)
  */
 int mutt_socket_write_d(struct Connection *conn, const char *buf, int len, int dbg)
 {
-  int sent = 0;
-
   mutt_debug(dbg, "%d> %s", conn->fd, buf);
 
   if (conn->fd < 0)
@@ -161,21 +305,15 @@ int mutt_socket_write_d(struct Connection *conn, const char *buf, int len, int d
     return -1;
   }
 
-  while (sent < len)
+  const int sent = socket_buffer_write(conn, buf, len);
+  if (sent < 0)
   {
-    const int rc = conn->write(conn, buf + sent, len - sent);
-    if (rc < 0)
+    if (conn->fd >= 0)
     {
       mutt_debug(LL_DEBUG1, "error writing (%s), closing socket\n", strerror(errno));
       mutt_socket_close(conn);
-
-      return -1;
     }
-
-    if (rc < len - sent)
-      mutt_debug(LL_DEBUG3, "short write (%d of %d bytes)\n", rc, len - sent);
-
-    sent += rc;
+    return -1;
   }
 
   return sent;
@@ -194,6 +332,9 @@ int mutt_socket_poll(struct Connection *conn, time_t wait_secs)
   if (conn->bufpos < conn->available)
     return conn->available - conn->bufpos;
 
+  if (mutt_socket_flush(conn) < 0)
+    return -1;
+
   if (conn->poll)
     return conn->poll(conn, wait_secs);
 
@@ -211,29 +352,46 @@ int mutt_socket_readchar(struct Connection *conn, char *c)
 {
   if (conn->bufpos >= conn->available)
   {
-    if (conn->fd >= 0)
-      conn->available = conn->read(conn, conn->inbuf, sizeof(conn->inbuf));
-    else
-    {
-      mutt_debug(LL_DEBUG1, "attempt to read from closed connection\n");
+    if (socket_fill_inbuf(conn) < 0)
       return -1;
-    }
-    conn->bufpos = 0;
-    if (conn->available == 0)
-    {
-      mutt_error(_("Connection to %s closed"), conn->account.host);
-    }
-    if (conn->available <= 0)
-    {
-      mutt_socket_close(conn);
-      return -1;
-    }
   }
   *c = conn->inbuf[conn->bufpos];
   conn->bufpos++;
   return 1;
 }
 
+/**
+ * mutt_socket_read_buf - Read a block of bytes without copying them
+ * @param[in]  conn Connection to a server
+ * @param[out] pbuf Set to the data, valid until the next read on @a conn
+ * @param[in]  max  Maximum number of bytes wanted
+ * @retval >0 Success, number of bytes available at @a pbuf
+ * @retval -1 Error
+ *
+ * The pointer references the Connection's own read buffer, so a
+ * length-delimited consumer (e.g. an IMAP literal) can process the data in
+ * chunks instead of one mutt_socket_readchar() call per byte.  The returned
+ * bytes count as consumed.
+ */
+int mutt_socket_read_buf(struct Connection *conn, const char **pbuf, size_t max)
+{
+  if (max == 0)
+    return 0;
+
+  if (conn->bufpos >= conn->available)
+  {
+    if (socket_fill_inbuf(conn) < 0)
+      return -1;
+  }
+
+  size_t len = conn->available - conn->bufpos;
+  if (len > max)
+    len = max;
+  *pbuf = conn->inbuf + conn->bufpos;
+  conn->bufpos += len;
+  return len;
+}
+
 /**
  * mutt_socket_readln_d - Read a line from a socket
  * @param buf    Buffer to store the line
@@ -24,8 +24,10 @@
 #ifndef MUTT_CONN_SOCKET_H
 #define MUTT_CONN_SOCKET_H
 
+#include <stddef.h>
 #include <time.h>
 
+struct ConnAccount;
 struct Connection;
 
 /**
@@ -38,12 +40,16 @@ enum ConnectionType
   MUTT_CONNECTION_SSL,    ///< SSL/TLS-encrypted connection
 };
 
+void               mutt_preconn_cleanup(void);
+void               mutt_preconn_start  (const struct ConnAccount *cacs, size_t num, size_t num_threads);
 int                mutt_socket_close   (struct Connection *conn);
 void               mutt_socket_empty   (struct Connection *conn);
+int                mutt_socket_flush   (struct Connection *conn);
 struct Connection *mutt_socket_new     (enum ConnectionType type);
 int                mutt_socket_open    (struct Connection *conn);
 int                mutt_socket_poll    (struct Connection *conn, time_t wait_secs);
 int                mutt_socket_read    (struct Connection *conn, char *buf, size_t len);
+int                mutt_socket_read_buf(struct Connection *conn, const char **pbuf, size_t max);
 int                mutt_socket_readchar(struct Connection *conn, char *c);
 int                mutt_socket_readln_d(char *buf, size_t buflen, struct Connection *conn, int dbg);
 int                mutt_socket_write   (struct Connection *conn, const char *buf, size_t len);
@@ -142,8 +142,10 @@ void ctx_update(struct Context *ctx)
   m->changed = false;
 
   mutt_clear_threads(ctx->threads);
+  ctx->threads_valid = false;
 
   const bool c_score = cs_subset_bool(NeoMutt->sub, "score");
+  const bool defer_score = c_score && mutt_score_deferrable();
   struct Email *e = NULL;
   for (int msgno = 0; msgno < m->msg_count; msgno++)
   {
@@ -192,7 +194,12 @@ void ctx_update(struct Context *ctx)
     mutt_label_hash_add(m, e);
 
     if (c_score)
-      mutt_score_message(ctx->mailbox, e, false);
+    {
+      if (defer_score)
+        e->scored = false; /* scored on demand, see mutt_score_require() */
+      else
+        mutt_score_message(ctx->mailbox, e, false);
+    }
 
     if (e->changed)
       m->changed = true;
@@ -227,6 +234,33 @@ static void update_tables(struct Context *ctx)
 
   int i, j, padding;
 
+  const bool c_maildir_trash = cs_subset_bool(NeoMutt->sub, "maildir_trash");
+  const bool keep_deleted = (m->type == MUTT_MAILDIR) && c_maildir_trash;
+
+  /* If no messages are leaving the mailbox, the tables are still valid and
+   * the counters have been kept up to date by mutt_set_flag() - just clear
+   * the change markers, so e.g. syncing flags on a huge folder stays cheap */
+  bool compact = false;
+  for (i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e || e->quasi_deleted || (e->deleted && !keep_deleted))
+    {
+      compact = true;
+      break;
+    }
+  }
+  if (!compact)
+  {
+    for (i = 0; i < m->msg_count; i++)
+    {
+      m->emails[i]->changed = false;
+      m->emails[i]->env->changed = false;
+    }
+    m->changed = false;
+    return;
+  }
+
   /* update memory to reflect the new state of the mailbox */
   m->vcount = 0;
   ctx->vsize = 0;
@@ -241,9 +275,7 @@ static void update_tables(struct Context *ctx)
   {
     if (!m->emails[i])
       break;
-    const bool c_maildir_trash = cs_subset_bool(NeoMutt->sub, "maildir_trash");
-    if (!m->emails[i]->quasi_deleted &&
-        (!m->emails[i]->deleted || ((m->type == MUTT_MAILDIR) && c_maildir_trash)))
+    if (!m->emails[i]->quasi_deleted && (!m->emails[i]->deleted || keep_deleted))
     {
       if (i != j)
       {
@@ -295,6 +327,9 @@ static void update_tables(struct Context *ctx)
         mutt_hash_delete(m->id_hash, m->emails[i]->env->message_id, m->emails[i]);
       mutt_label_hash_remove(m, m->emails[i]);
 
+      /* unhook the message from the thread tree while it's still valid */
+      mutt_thread_ctx_remove(ctx->threads, m->emails[i]);
+
 #ifdef USE_IMAP
       if (m->type == MUTT_IMAP)
         imap_notify_delete_email(m, m->emails[i]);
@@ -305,6 +340,10 @@ static void update_tables(struct Context *ctx)
     }
   }
   m->msg_count = j;
+
+  /* the thread tree no longer references the expunged messages, so the
+   * NT_MAILBOX_RESORT that follows the sync can rethread incrementally */
+  ctx->threads_valid = true;
 }
 
 /**
@@ -330,7 +369,8 @@ int ctx_mailbox_observer(struct NotifyCallback *nc)
       update_tables(ctx);
       break;
     case NT_MAILBOX_RESORT:
-      mutt_sort_headers(ctx->mailbox, ctx->threads, true, &ctx->vsize);
+      mutt_sort_headers(ctx->mailbox, ctx->threads, !ctx->threads_valid, &ctx->vsize);
+      ctx->threads_valid = false;
       break;
     default:
       return 0;
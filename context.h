@@ -45,6 +45,7 @@ struct Context
   struct Menu *menu;                 ///< Needed for pattern compilation
 
   bool collapsed : 1;                ///< Are all threads collapsed?
+  bool threads_valid : 1;            ///< Does the thread tree still match the Mailbox?
 
   struct Mailbox *mailbox;           ///< Current Mailbox
   struct Notify *notify;             ///< Notifications: #NotifyContext, #EventContext
@@ -127,6 +127,7 @@ struct Mailbox
 
   struct Account *account;            ///< Account that owns this Mailbox
   int opened;                         ///< Number of times mailbox is opened
+  int visits;                         ///< Number of times the user has opened this Mailbox
 
   bool visible;                       ///< True if a result of "mailboxes"
 
@@ -106,6 +106,7 @@ void dump_envelope(const struct Envelope *env)
   OPT_STRING(subject);
   OPT_STRING(real_subj);
   OPT_STRING(disp_subj);
+  OPT_STRING(disp_author);
   OPT_STRING(message_id);
   OPT_STRING(supersedes);
   OPT_STRING(date);
@@ -1316,6 +1316,7 @@ void dot_envelope(FILE *fp, struct Envelope *env, struct ListHead *links)
 #undef ADDR_LIST
 
   dot_type_string(fp, "date", env->date, false);
+  dot_type_string(fp, "disp_author", env->disp_author, false);
   dot_type_string(fp, "disp_subj", env->disp_subj, false);
   dot_type_string(fp, "followup_to", env->followup_to, false);
   dot_type_string(fp, "list_post", env->list_post, false);
@@ -32,6 +32,7 @@
  * | debug/graphviz.c    | @subpage debug_graphviz    |
  * | debug/notify.c      | @subpage debug_notify      |
  * | debug/parse_test.c  | @subpage debug_parse       |
+ * | debug/timing.c      | @subpage debug_timing      |
  * | debug/window.c      | @subpage debug_window      |
  */
 
@@ -87,6 +88,12 @@ void dump_pager(struct PagerPrivateData *priv);
 // Parse Set
 void test_parse_set(void);
 
+// Timing
+void timing_add  (const char *name, size_t num);
+void timing_dump (const char *label);
+void timing_start(const char *name);
+void timing_stop (const char *name);
+
 // Window
 void debug_win_dump(void);
 
@@ -0,0 +1,156 @@
+/**
+ * @file
+ * Timing of the slow phases
+ *
+ * @authors
+ * Copyright (C) 2021 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page debug_timing Timing of the slow phases
+ *
+ * Accumulate named timers and counters around the phases of a slow operation,
+ * e.g. opening a large folder, and log a summary when it completes.
+ *
+ * The summary is one `timing:` line per timer/counter in the debug log
+ * (`-d 1` or higher), in `key=value` form for easy scraping:
+ *
+ *     timing: label="/var/mail/inbox" phase="mbox_open" calls=1 total_us=421773
+ *
+ * The timers are not thread-safe; only use them from the main thread.
+ */
+
+#include "config.h"
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "mutt/lib.h"
+#include "lib.h"
+
+/// Maximum number of distinct timers and counters
+#define TIMING_SLOTS_MAX 32
+
+/**
+ * struct TimingSlot - One named timer or counter
+ */
+struct TimingSlot
+{
+  const char *name;  ///< Name, a string literal
+  uint64_t start_ns; ///< Start of the open interval, 0 if none (timers)
+  uint64_t total_ns; ///< Time accumulated so far (timers)
+  size_t count;      ///< Completed intervals (timers), or the tally (counters)
+};
+
+static struct TimingSlot Timers[TIMING_SLOTS_MAX];   ///< All the timers
+static struct TimingSlot Counters[TIMING_SLOTS_MAX]; ///< All the counters
+
+/**
+ * timing_now_ns - Read the monotonic clock
+ * @retval num Nanoseconds from an arbitrary fixed point
+ */
+static uint64_t timing_now_ns(void)
+{
+  struct timespec tp = { 0 };
+  clock_gettime(CLOCK_MONOTONIC, &tp);
+  return ((uint64_t) tp.tv_sec * 1000000000ULL) + tp.tv_nsec;
+}
+
+/**
+ * timing_slot - Find a named slot, creating it if necessary
+ * @param slots Table to search
+ * @param name  Name to find
+ * @retval ptr  The slot
+ * @retval NULL The table is full
+ */
+static struct TimingSlot *timing_slot(struct TimingSlot *slots, const char *name)
+{
+  for (size_t i = 0; i < TIMING_SLOTS_MAX; i++)
+  {
+    if (!slots[i].name)
+    {
+      slots[i].name = name;
+      return &slots[i];
+    }
+    if (mutt_str_equal(slots[i].name, name))
+      return &slots[i];
+  }
+  return NULL;
+}
+
+/**
+ * timing_start - Start (or resume) a named timer
+ * @param name Timer name, a string literal
+ */
+void timing_start(const char *name)
+{
+  struct TimingSlot *slot = timing_slot(Timers, name);
+  if (!slot || (slot->start_ns != 0))
+    return;
+
+  slot->start_ns = timing_now_ns();
+}
+
+/**
+ * timing_stop - Stop a named timer and accumulate the interval
+ * @param name Timer name, as passed to timing_start()
+ */
+void timing_stop(const char *name)
+{
+  struct TimingSlot *slot = timing_slot(Timers, name);
+  if (!slot || (slot->start_ns == 0))
+    return;
+
+  slot->total_ns += timing_now_ns() - slot->start_ns;
+  slot->start_ns = 0;
+  slot->count++;
+}
+
+/**
+ * timing_add - Add to a named counter
+ * @param name Counter name, a string literal
+ * @param num  Amount to add
+ */
+void timing_add(const char *name, size_t num)
+{
+  struct TimingSlot *slot = timing_slot(Counters, name);
+  if (!slot)
+    return;
+
+  slot->count += num;
+}
+
+/**
+ * timing_dump - Log all the timers and counters, then reset them
+ * @param label Operation the measurements belong to, e.g. a mailbox path
+ */
+void timing_dump(const char *label)
+{
+  for (size_t i = 0; (i < TIMING_SLOTS_MAX) && Timers[i].name; i++)
+  {
+    mutt_debug(LL_DEBUG1, "timing: label=\"%s\" phase=\"%s\" calls=%zu total_us=%llu\n",
+               NONULL(label), Timers[i].name, Timers[i].count,
+               (unsigned long long) (Timers[i].total_ns / 1000));
+  }
+  for (size_t i = 0; (i < TIMING_SLOTS_MAX) && Counters[i].name; i++)
+  {
+    mutt_debug(LL_DEBUG1, "timing: label=\"%s\" counter=\"%s\" value=%zu\n",
+               NONULL(label), Counters[i].name, Counters[i].count);
+  }
+
+  memset(Timers, 0, sizeof(Timers));
+  memset(Counters, 0, sizeof(Counters));
+}
@@ -446,6 +446,18 @@
 ** desirable to \fIunset\fP this variable.
 */
 
+{ "browser_stat_threads", DT_NUMBER, 0 },
+/*
+** .pp
+** Number of threads the folder browser uses to \fCstat(2)\fP directory
+** entries.  Opening the browser on a directory with thousands of entries
+** on a network filesystem can take several seconds because each entry is
+** queried in turn; setting this to the number of available CPUs issues
+** the queries concurrently.
+** .pp
+** Set to 0 or 1 to query the entries serially, as before.
+*/
+
 #ifdef USE_NNTP
 { "catchup_newsgroup", DT_QUAD, MUTT_ASKYES },
 /*
@@ -574,6 +586,21 @@
 ** or from editing with edit-headers).
 */
 
+{ "config_cache", DT_PATH, 0 },
+/*
+** .pp
+** Set this to a directory and NeoMutt will keep a compiled copy of every
+** config file it reads: the lines are stored with continuations already
+** joined and $$config_charset conversion already applied, keyed by the
+** file's size and modification time.  Later launches replay the compiled
+** copy instead of re-reading and re-converting each sourced file, which
+** speeds up start-up for large, deeply-sourced configurations.
+** .pp
+** The commands themselves are still executed normally, so backticks and
+** \fCsource\fP pipes behave exactly as without the cache.  A compiled copy
+** is discarded automatically as soon as its config file changes.
+*/
+
 { "config_charset", DT_STRING, 0 },
 /*
 ** .pp
@@ -1545,6 +1572,43 @@
 ** This results in much smaller cache file sizes and may even improve speed.
 */
 #endif
+
+#ifdef HAVE_ROCKSDB
+{ "header_cache_rocksdb_block_cache_size", DT_LONG, 33554432 },
+/*
+** .pp
+** Size, in bytes, of the block cache used by the \fCrocksdb\fP header cache
+** backend.  Hot index and data blocks are served from memory instead of
+** disk.  Set to \fI0\fP to use the RocksDB default (a few megabytes).
+*/
+
+{ "header_cache_rocksdb_bloom_bits", DT_NUMBER, 10 },
+/*
+** .pp
+** Number of bloom filter bits per key for the \fCrocksdb\fP header cache
+** backend.  Bloom filters let lookups for messages that aren't cached yet
+** (every newly arrived message) return without any disk reads.  Set to
+** \fI0\fP to disable the filters.
+*/
+
+{ "header_cache_rocksdb_compression", DT_STRING, 0 },
+/*
+** .pp
+** Compression method used by the \fCrocksdb\fP header cache backend for its
+** data blocks.  One of \fCnone\fP, \fCsnappy\fP, \fCzlib\fP, \fCbzip2\fP,
+** \fClz4\fP, \fClz4hc\fP, \fCxpress\fP or \fCzstd\fP, provided RocksDB was
+** built with the matching library.  Unset means no compression.
+*/
+#endif
+
+{ "header_cache_writebehind", DT_BOOL, false },
+/*
+** .pp
+** When \fIset\fP, header cache records are stored by a background thread
+** instead of synchronously.  This keeps flag syncs on large folders from
+** stalling on database latency.  All pending records are flushed when the
+** cache is closed.
+*/
 #endif
 
 { "header_color_partial", DT_BOOL, false },
@@ -1791,6 +1855,15 @@
 ** headers.
 */
 
+{ "imap_fetch_pipeline", DT_BOOL, false },
+/*
+** .pp
+** When \fIset\fP, the headers downloaded while opening a mailbox are parsed
+** on a worker thread while the network transfer continues, instead of
+** alternating between reading the socket and parsing.  This can hide most of
+** the parse time on high-latency connections.
+*/
+
 { "imap_headers", DT_STRING, 0 },
 /*
 ** .pp
@@ -1905,6 +1978,17 @@
 ** to 0 to disable timing out.
 */
 
+{ "imap_prefetch_count", DT_NUMBER, 0 },
+/*
+** .pp
+** When set to a value greater than 0, opening a message also fetches the
+** bodies of up to this many of the following visible messages into the
+** body cache (see $$message_cachedir), using a single pipelined FETCH.
+** Moving through a thread then reads from local disk instead of paying a
+** network round-trip per message.  BODY.PEEK is used, so the prefetched
+** messages remain unread.
+*/
+
 { "imap_qresync", DT_BOOL, false },
 /*
 ** .pp
@@ -2197,6 +2281,25 @@
 ** how often (in seconds) NeoMutt will update message counts.
 */
 
+{ "mail_check_threads", DT_NUMBER, 0 },
+/*
+** .pp
+** Number of threads used to poll the mailboxes for new mail.  With many
+** mailboxes on slow storage (e.g. maildirs on NFS), one poll cycle can
+** block NeoMutt for a noticeable time; setting this to the number of
+** available CPUs lets independent mailboxes be checked concurrently.
+** The mailboxes of one account are always checked one after another, and
+** server-based mailboxes (IMAP, POP, NNTP, notmuch) are always checked
+** from the main thread.
+** .pp
+** When set, the TCP connections to the mail servers are also established
+** in parallel at startup, so several accounts don't wait for each
+** other's connects.  TLS negotiation and authentication still happen one
+** at a time, as they may need to prompt for certificates or passwords.
+** .pp
+** Set to 0 or 1 to check all mailboxes serially, as before.
+*/
+
 { "mailcap_path", DT_SLIST, "~/.mailcap:" PKGDATADIR "/mailcap:" SYSCONFDIR "/mailcap:/etc/mailcap:/usr/etc/mailcap:/usr/local/etc/mailcap" },
 /*
 ** .pp
@@ -2243,6 +2346,16 @@
 */
 #endif
 
+{ "maildir_parse_threads", DT_NUMBER, 0 },
+/*
+** .pp
+** Number of worker threads used to parse message headers when opening a
+** Maildir or MH mailbox.  When this is \fC0\fP (the default) or \fC1\fP,
+** headers are parsed one at a time on the main thread.  On large mailboxes
+** with a cold header cache, setting this close to the number of CPU cores
+** lets the open scale with core count instead of per-file disk latency.
+*/
+
 { "maildir_trash", DT_BOOL, false },
 /*
 ** .pp
@@ -2305,6 +2418,27 @@
 ** This can also be set using the \fC-m\fP command-line option.
 */
 
+{ "mbox_offset_index", DT_BOOL, false },
+/*
+** .pp
+** If \fIset\fP, NeoMutt keeps an index of message offsets next to each mbox
+** folder (as \fC.<name>.nmidx\fP).  When the folder is opened again and its
+** size, mtime and tail checksum still match, NeoMutt seeks straight to each
+** message's headers instead of scanning the whole file, which makes
+** reopening large folders almost instant.  The index is discarded whenever
+** it doesn't exactly match the folder.
+*/
+
+{ "mbox_use_mmap", DT_BOOL, false },
+/*
+** .pp
+** If \fIset\fP, mbox and mmdf folders are parsed by mapping the file into
+** memory and scanning it for message separators, instead of reading it one
+** line at a time.  This can open multi-gigabyte spools considerably faster.
+** If the file can't be mapped (e.g. it isn't a regular file), NeoMutt falls
+** back to the line-based parser.
+*/
+
 { "me_too", DT_BOOL, false },
 /*
 ** .pp
@@ -2346,6 +2480,37 @@
 ** (especially for large folders).
 */
 
+#ifdef USE_HCACHE_COMPRESSION
+{ "message_cache_compress_level", DT_NUMBER, 1 },
+/*
+** .pp
+** When NeoMutt is compiled with lz4, zstd or zlib, this option can be used
+** to setup the compression level for the message cache.
+*/
+
+{ "message_cache_compress_method", DT_STRING, 0 },
+/*
+** .pp
+** When NeoMutt is compiled with lz4, zstd or zlib, the message cache can
+** compress the cached message bodies with one of these methods.  This
+** results in much smaller cache directories, at the cost of a little CPU
+** time.  Entries written before compression was enabled are still read
+** transparently.
+*/
+#endif
+
+{ "message_cache_size", DT_LONG, 0 },
+/*
+** .pp
+** If set to a non-zero value, the message cache is kept within this many
+** bytes.  Whenever a new message is added to the cache, the least recently
+** used entries are removed until the cache fits again.  Reading a cached
+** message marks it as recently used, so frequently read messages stay
+** local.
+** .pp
+** When this is \fI0\fP (the default), the cache grows without bound.
+*/
+
 { "message_cachedir", DT_PATH, 0 },
 /*
 ** .pp
@@ -2496,6 +2661,21 @@
 */
 #endif
 
+#ifdef USE_INOTIFY
+{ "monitor_debounce", DT_NUMBER, 50 },
+/*
+** .pp
+** When the filesystem monitor sees a change, it waits this many
+** milliseconds for further events before waking NeoMutt up.  As long as
+** events keep arriving within the window, they are coalesced, so a bulk
+** mail delivery triggers one mailbox check instead of one per message.
+** The total delay is capped at one second and a keypress always ends the
+** wait immediately.
+** .pp
+** Set to 0 to disable coalescing and wake up on the first event.
+*/
+#endif
+
 { "move", DT_QUAD, MUTT_NO },
 /*
 ** .pp
@@ -2725,6 +2905,18 @@
 ** articles headers will be saved in cache when you quit newsgroup.
 */
 
+#ifdef USE_ZLIB
+{ "nntp_deflate", DT_BOOL, true },
+/*
+** .pp
+** When \fIset\fP, NeoMutt will use the COMPRESS DEFLATE extension (RFC8054)
+** if advertised by the news server.
+** .pp
+** Overview data compresses particularly well, so entering large
+** newsgroups is much faster over a compressed connection.
+*/
+#endif
+
 { "nntp_listgroup", DT_BOOL, true },
 /*
 ** .pp
@@ -2764,6 +2956,21 @@
 */
 #endif
 
+{ "oauth_token_lifetime", DT_NUMBER, 3300 },
+/*
+** .pp
+** How long (in seconds) an access token obtained from a
+** $$imap_oauth_refresh_command, $$pop_oauth_refresh_command or
+** $$smtp_oauth_refresh_command may be reused.  While a token is fresh,
+** reconnecting doesn't run the refresh command again, so reconnects after
+** a network blip authenticate without forking the helper.  A token the
+** server rejects is dropped from the cache immediately.
+** .pp
+** Most providers issue tokens that are valid for an hour; the default
+** leaves a safety margin.  Set to 0 to run the refresh command on every
+** authentication, as before.
+*/
+
 { "pager", DT_COMMAND, "builtin" },
 /*
 ** .pp
@@ -2859,6 +3066,17 @@
 ** .pp
 */
 
+{ "pattern_threads", DT_NUMBER, 0 },
+/*
+** .pp
+** Number of worker threads used to match a pattern against the messages of a
+** folder, e.g. for \fC<limit>\fP or \fC<tag-pattern>\fP.  Threads are only
+** used for patterns which can be matched from the headers alone; patterns
+** which need to open the message (e.g. \fC~b\fP) are always matched serially.
+** .pp
+** When set to \fI0\fP (the default) or \fI1\fP, no threads are created.
+*/
+
 { "pgp_auto_decode", DT_BOOL, false },
 /*
 ** .pp
@@ -4654,6 +4872,19 @@
 ** if you are the only one who can read the file.
 */
 
+{ "smtp_persist", DT_BOOL, false },
+/*
+** .pp
+** When \fIset\fP, the connection to the SMTP server (see $$smtp_url) is kept
+** open after a message has been sent and reused for the next one, instead of
+** reconnecting and re-authenticating for every message.  This speeds up
+** sending many messages in one session considerably.
+** .pp
+** The connection is checked with an SMTP "RSET" before being reused, and a
+** fresh one is opened transparently if the server has closed it in the
+** meantime.
+*/
+
 { "smtp_url", DT_STRING, 0 },
 /*
 ** .pp
@@ -4879,6 +5110,20 @@
 #endif
 
 #ifdef USE_SSL
+{ "ssl_session_cache", DT_PATH, 0 },
+/*
+** .pp
+** If set to the path of an existing directory, TLS sessions are saved
+** there, named after the server's host and port, and offered to the server
+** again on the next connection.  A server that accepts the session skips a
+** round trip of the handshake, which speeds up reconnects after an IMAP
+** timeout and short scripted invocations of NeoMutt.
+** .pp
+** Session files can be used to decrypt the connections they resume, so the
+** directory should be private.  NeoMutt creates the files readable by
+** their owner only.
+*/
+
 { "ssl_starttls", DT_QUAD, MUTT_YES },
 /*
 ** .pp
@@ -36,13 +36,28 @@
 #include "mime.h"
 #include "parameter.h"
 
+/// Slab allocator shared by all Bodies
+static struct Slab *BodySlab = NULL;
+
+/**
+ * mutt_body_pool_cleanup - Release the memory behind the Body allocator
+ *
+ * All the Bodies must have been freed already.
+ */
+void mutt_body_pool_cleanup(void)
+{
+  mutt_slab_free(&BodySlab);
+}
+
 /**
  * mutt_body_new - Create a new Body
  * @retval ptr Newly allocated Body
  */
 struct Body *mutt_body_new(void)
 {
-  struct Body *p = mutt_mem_calloc(1, sizeof(struct Body));
+  if (!BodySlab)
+    BodySlab = mutt_slab_new(sizeof(struct Body), 256);
+  struct Body *p = mutt_slab_alloc(BodySlab);
 
   p->disposition = DISP_ATTACH;
   p->use_disp = true;
@@ -93,7 +108,7 @@ void mutt_body_free(struct Body **ptr)
 
     mutt_env_free(&b->mime_headers);
     mutt_body_free(&b->parts);
-    FREE(&b);
+    mutt_slab_release(BodySlab, (void **) &b);
   }
 
   *ptr = NULL;
@@ -94,5 +94,6 @@ bool         mutt_body_cmp_strict(const struct Body *b1, const struct Body *b2);
 void         mutt_body_free      (struct Body **ptr);
 char *       mutt_body_get_charset(struct Body *b, char *buf, size_t buflen);
 struct Body *mutt_body_new       (void);
+void         mutt_body_pool_cleanup(void);
 
 #endif /* MUTT_EMAIL_BODY_H */
@@ -37,6 +37,19 @@
 
 void nm_edata_free(void **ptr);
 
+/// Slab allocator shared by all Emails
+static struct Slab *EmailSlab = NULL;
+
+/**
+ * email_pool_cleanup - Release the memory behind the Email allocator
+ *
+ * All the Emails must have been freed already.
+ */
+void email_pool_cleanup(void)
+{
+  mutt_slab_free(&EmailSlab);
+}
+
 /**
  * email_free - Free an Email
  * @param[out] ptr Email to free
@@ -59,6 +72,7 @@ void email_free(struct Email **ptr)
   mutt_body_free(&e->body);
   FREE(&e->tree);
   FREE(&e->path);
+  FREE(&e->display);
 #ifdef MIXMASTER
   mutt_list_free(&e->chain);
 #endif
@@ -68,7 +82,7 @@ void email_free(struct Email **ptr)
   driver_tags_free(&e->tags);
   notify_free(&e->notify);
 
-  FREE(ptr);
+  mutt_slab_release(EmailSlab, (void **) ptr);
 }
 
 /**
@@ -79,12 +93,15 @@ struct Email *email_new(void)
 {
   static size_t sequence = 0;
 
-  struct Email *e = mutt_mem_calloc(1, sizeof(struct Email));
+  if (!EmailSlab)
+    EmailSlab = mutt_slab_new(sizeof(struct Email), 256);
+  struct Email *e = mutt_slab_alloc(EmailSlab);
 #ifdef MIXMASTER
   STAILQ_INIT(&e->chain);
 #endif
   STAILQ_INIT(&e->tags);
   e->visible = true;
+  e->thread_unread = -1;
   e->sequence = sequence++;
   e->notify = notify_new();
 
@@ -71,11 +71,6 @@ struct Email
   struct Notify *notify;       ///< Notifications: #NotifyEmail, #EventEmail
   void *edata;                 ///< Driver-specific data
 
-  bool active          : 1;    ///< Message is not to be removed
-  bool changed         : 1;    ///< Email has been edited
-  bool deleted         : 1;    ///< Email is deleted
-  bool purge           : 1;    ///< Skip trash folder when deleting
-
   /**
    * edata_free - Free the private data attached to the Email
    * @param ptr Private data to be freed
@@ -93,23 +88,44 @@ struct Email
   void *nm_edata;              ///< Notmuch private data
 #endif
 
+  // The flag bits of this and the next section share one storage unit;
+  // keep them adjacent, or every Email grows by a word of padding
+  bool active          : 1;    ///< Message is not to be removed
+  bool changed         : 1;    ///< Email has been edited
+  bool deleted         : 1;    ///< Email is deleted
+  bool purge           : 1;    ///< Skip trash folder when deleting
+
   // ---------------------------------------------------------------------------
   // View data - Used by the GUI
 
   bool attach_del      : 1;    ///< Has an attachment marked for deletion
   bool attach_valid    : 1;    ///< true when the attachment count is valid
   bool display_subject : 1;    ///< Used for threading
+  bool index_color_valid : 1;  ///< The Email::author_color trio has been evaluated
   bool matched         : 1;    ///< Search matches this Email
+  bool msg_match       : 1;    ///< Result of the search identified by msg_match_key
   bool quasi_deleted   : 1;    ///< Deleted from neomutt, but not modified on disk
   bool recip_valid     : 1;    ///< Is_recipient is valid
+  bool scored          : 1;    ///< Email has been scored, see mutt_score_message()
   bool searched        : 1;    ///< Email has been searched
   bool subject_changed : 1;    ///< Used for threading
   bool tagged          : 1;    ///< Email is tagged
   bool threaded        : 1;    ///< Used for threading
+  bool display_in_pager : 1;   ///< Email::display showed this as the pager message
+  bool collapsed       : 1;    ///< Is this message part of a collapsed thread?
+  bool visible         : 1;    ///< Is this message part of the view?
 
+  size_t msg_match_key;        ///< Hash of the last header/body search run on this message, or 0
   int index;                   ///< The absolute (unsorted) message number
   int msgno;                   ///< Number displayed to the user
   struct AttrColor *attr_color; ///< Color-pair to use when displaying in the index
+  struct AttrColor *author_color;  ///< Matched `color index_author` rule, valid if Email::index_color_valid
+  struct AttrColor *flags_color;   ///< Matched `color index_flags` rule, valid if Email::index_color_valid
+  struct AttrColor *subject_color; ///< Matched `color index_subject` rule, valid if Email::index_color_valid
+  char *display;               ///< Cached formatted index line, see index_make_entry()
+  int display_width;           ///< Screen width Email::display was formatted at
+  int display_flags;           ///< Format flags used to build Email::display
+  int display_msgno;           ///< Email::msgno when Email::display was built
   int score;                   ///< Message score
   int vnum;                    ///< Virtual message number
   short attach_total;          ///< Number of qualifying attachments in message, if attach_valid
@@ -117,10 +133,10 @@ struct Email
 
   // The following are used to support collapsing threads
   struct MuttThread *thread;   ///< Thread of Emails
-  bool collapsed : 1;          ///< Is this message part of a collapsed thread?
-  bool visible   : 1;          ///< Is this message part of the view?
   size_t num_hidden;           ///< Number of hidden messages in this view
                                ///< (only valid when collapsed is set)
+  short thread_unread;         ///< Cached unread state of the thread rooted here,
+                               ///< see mutt_thread_unread(); -1 when stale
   char *tree;                  ///< Character string to print thread tree
 };
 
@@ -185,6 +201,7 @@ struct EventHeader
 bool          email_cmp_strict(const struct Email *e1, const struct Email *e2);
 void          email_free      (struct Email **ptr);
 struct Email *email_new       (void);
+void          email_pool_cleanup(void);
 size_t        email_size      (const struct Email *e);
 
 int  emaillist_add_email(struct EmailList *el, struct Email *e);
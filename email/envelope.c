@@ -36,13 +36,28 @@
 #include "envelope.h"
 #include "email.h"
 
+/// Slab allocator shared by all Envelopes
+static struct Slab *EnvSlab = NULL;
+
+/**
+ * mutt_env_pool_cleanup - Release the memory behind the Envelope allocator
+ *
+ * All the Envelopes must have been freed already.
+ */
+void mutt_env_pool_cleanup(void)
+{
+  mutt_slab_free(&EnvSlab);
+}
+
 /**
  * mutt_env_new - Create a new Envelope
  * @retval ptr New Envelope
  */
 struct Envelope *mutt_env_new(void)
 {
-  struct Envelope *env = mutt_mem_calloc(1, sizeof(struct Envelope));
+  if (!EnvSlab)
+    EnvSlab = mutt_slab_new(sizeof(struct Envelope), 256);
+  struct Envelope *env = mutt_slab_alloc(EnvSlab);
   TAILQ_INIT(&env->return_path);
   TAILQ_INIT(&env->from);
   TAILQ_INIT(&env->to);
@@ -111,17 +126,18 @@ void mutt_env_free(struct Envelope **ptr)
   mutt_addrlist_clear(&env->mail_followup_to);
   mutt_addrlist_clear(&env->x_original_to);
 
-  FREE(&env->list_post);
-  FREE(&env->list_subscribe);
-  FREE(&env->list_unsubscribe);
+  mutt_intern_release(&env->list_post);
+  mutt_intern_release(&env->list_subscribe);
+  mutt_intern_release(&env->list_unsubscribe);
   FREE(&env->subject);
   /* real_subj is just an offset to subject and shouldn't be freed */
   FREE(&env->disp_subj);
+  FREE(&env->disp_author);
   FREE(&env->message_id);
   FREE(&env->supersedes);
   FREE(&env->date);
   FREE(&env->x_label);
-  FREE(&env->organization);
+  mutt_intern_release(&env->organization);
 #ifdef USE_NNTP
   FREE(&env->newsgroups);
   FREE(&env->xref);
@@ -140,7 +156,7 @@ void mutt_env_free(struct Envelope **ptr)
   mutt_autocrypthdr_free(&env->autocrypt_gossip);
 #endif
 
-  FREE(ptr);
+  mutt_slab_release(EnvSlab, (void **) ptr);
 }
 
 /**
@@ -190,13 +206,6 @@ void mutt_env_merge(struct Envelope *base, struct Envelope **extra)
     TAILQ_SWAP(&base->member, &(*extra)->member, Address, entries);            \
   }
 
-#define MOVE_BUFFER(member)                                                    \
-  if (mutt_buffer_is_empty(&base->member))                                     \
-  {                                                                            \
-    memcpy(&base->member, &(*extra)->member, sizeof(struct Buffer));           \
-    mutt_buffer_init(&(*extra)->member);                                       \
-  }
-
   MOVE_ADDRESSLIST(return_path);
   MOVE_ADDRESSLIST(from);
   MOVE_ADDRESSLIST(to);
@@ -237,14 +246,12 @@ void mutt_env_merge(struct Envelope *base, struct Envelope **extra)
   }
   /* spam and user headers should never be hashed, and the new envelope may
    * have better values. Use new versions regardless. */
-  mutt_buffer_dealloc(&base->spam);
+  mutt_buffer_move(&base->spam, &(*extra)->spam);
   mutt_list_free(&base->userhdrs);
-  MOVE_BUFFER(spam);
   MOVE_STAILQ(userhdrs);
 #undef MOVE_ELEM
 #undef MOVE_STAILQ
 #undef MOVE_ADDRESSLIST
-#undef MOVE_BUFFER
 
   mutt_env_free(extra);
 }
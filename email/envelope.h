@@ -70,6 +70,7 @@ struct Envelope
   char *subject;                       ///< Email's subject
   char *real_subj;                     ///< Offset of the real subject
   char *disp_subj;                     ///< Display subject (modified copy of subject)
+  char *disp_author;                   ///< Display author (cached formatted From field)
   char *message_id;                    ///< Message ID
   char *supersedes;                    ///< Supersedes header
   char *date;                          ///< Sent date
@@ -119,6 +120,7 @@ bool             mutt_env_cmp_strict (const struct Envelope *e1, const struct En
 void             mutt_env_free       (struct Envelope **ptr);
 void             mutt_env_merge      (struct Envelope *base, struct Envelope **extra);
 struct Envelope *mutt_env_new        (void);
+void             mutt_env_pool_cleanup(void);
 bool             mutt_env_notify_send(struct Email *e, enum NotifyEnvelope type);
 int              mutt_env_to_intl    (struct Envelope *env, const char **tag, char **err);
 void             mutt_env_to_local   (struct Envelope *env);
@@ -303,16 +303,125 @@ static void parse_content_language(const char *s, struct Body *ct)
   mutt_str_replace(&ct->language, s);
 }
 
+/**
+ * struct IgnoreNode - Node of the compiled Ignore/UnIgnore matcher
+ *
+ * The Ignore and UnIgnore lists are compiled into a trie indexed by
+ * lowercased bytes.  A node's flags record which list an entry ending at
+ * that node came from, so a header can be weeded in a single pass over
+ * its characters, however long the lists are.
+ */
+struct IgnoreNode
+{
+  struct IgnoreNode *next[256]; ///< Children, indexed by lowercased byte
+  bool ignore;                  ///< An Ignore entry ends here
+  bool unignore;                ///< An UnIgnore entry ends here
+};
+
+static struct IgnoreNode *IgnoreTrie = NULL; ///< Compiled Ignore/UnIgnore lists
+static bool IgnoreAll = false;   ///< Ignore contains "*"
+static bool IgnoreDirty = true;  ///< Lists changed; trie needs recompiling
+
+/**
+ * ignore_trie_free - Free a trie of IgnoreNodes
+ * @param ptr Root node to free
+ */
+static void ignore_trie_free(struct IgnoreNode **ptr)
+{
+  struct IgnoreNode *node = *ptr;
+  if (!node)
+    return;
+
+  for (size_t i = 0; i < mutt_array_size(node->next); i++)
+    ignore_trie_free(&node->next[i]);
+  FREE(ptr);
+}
+
+/**
+ * ignore_trie_insert - Add a list entry to the trie
+ * @param s        Entry to add
+ * @param unignore true if the entry comes from UnIgnore
+ */
+static void ignore_trie_insert(const char *s, bool unignore)
+{
+  struct IgnoreNode **ptr = &IgnoreTrie;
+  for (; *s; s++)
+  {
+    if (!*ptr)
+      *ptr = mutt_mem_calloc(1, sizeof(struct IgnoreNode));
+    ptr = &(*ptr)->next[tolower((unsigned char) *s)];
+  }
+
+  if (!*ptr)
+    *ptr = mutt_mem_calloc(1, sizeof(struct IgnoreNode));
+  if (unignore)
+    (*ptr)->unignore = true;
+  else
+    (*ptr)->ignore = true;
+}
+
+/**
+ * ignore_trie_compile - Recompile the trie from Ignore and UnIgnore
+ */
+static void ignore_trie_compile(void)
+{
+  ignore_trie_free(&IgnoreTrie);
+  IgnoreAll = false;
+
+  struct ListNode *np = NULL;
+  STAILQ_FOREACH(np, &Ignore, entries)
+  {
+    if (*np->data == '*')
+      IgnoreAll = true;
+    else
+      ignore_trie_insert(np->data, false);
+  }
+  STAILQ_FOREACH(np, &UnIgnore, entries)
+  {
+    ignore_trie_insert(np->data, true);
+  }
+
+  IgnoreDirty = false;
+}
+
+/**
+ * mutt_matches_ignore_flush - Note that Ignore or UnIgnore has changed
+ *
+ * The compiled matcher is dropped and rebuilt on the next weeding.
+ */
+void mutt_matches_ignore_flush(void)
+{
+  ignore_trie_free(&IgnoreTrie);
+  IgnoreDirty = true;
+}
+
 /**
  * mutt_matches_ignore - Does the string match the ignore list
  * @param s String to check
  * @retval true String matches
  *
- * Checks Ignore and UnIgnore using mutt_list_match
+ * An entry matches if it's a prefix of @a s, ignoring case; an UnIgnore
+ * match beats any Ignore match (see mutt_list_match()).
  */
 bool mutt_matches_ignore(const char *s)
 {
-  return mutt_list_match(s, &Ignore) && !mutt_list_match(s, &UnIgnore);
+  if (IgnoreDirty)
+    ignore_trie_compile();
+
+  bool ign = IgnoreAll;
+  const struct IgnoreNode *node = IgnoreTrie;
+  for (; node && s && *s; s++)
+  {
+    node = node->next[tolower((unsigned char) *s)];
+    if (!node)
+      break;
+    if (node->unignore)
+      return false;
+    if (node->ignore)
+      ign = true;
+  }
+
+  return ign;
 }
 
 /**
@@ -818,8 +927,9 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, const char *na
           char *mailto = rfc2369_first_mailto(body);
           if (mailto)
           {
-            FREE(&env->list_post);
-            env->list_post = mailto;
+            mutt_intern_release(&env->list_post);
+            env->list_post = mutt_intern(mailto);
+            FREE(&mailto);
             const bool c_auto_subscribe =
                 cs_subset_bool(NeoMutt->sub, "auto_subscribe");
             if (c_auto_subscribe)
@@ -834,8 +944,9 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, const char *na
         char *mailto = rfc2369_first_mailto(body);
         if (mailto)
         {
-          FREE(&env->list_subscribe);
-          env->list_subscribe = mailto;
+          mutt_intern_release(&env->list_subscribe);
+          env->list_subscribe = mutt_intern(mailto);
+          FREE(&mailto);
         }
         matched = true;
       }
@@ -845,8 +956,9 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, const char *na
         char *mailto = rfc2369_first_mailto(body);
         if (mailto)
         {
-          FREE(&env->list_unsubscribe);
-          env->list_unsubscribe = mailto;
+          mutt_intern_release(&env->list_unsubscribe);
+          env->list_unsubscribe = mutt_intern(mailto);
+          FREE(&mailto);
         }
         matched = true;
       }
@@ -904,7 +1016,7 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, const char *na
       if (mutt_istr_equal(name + 1, "rganization"))
       {
         if (!env->organization && !mutt_istr_equal(body, "unknown"))
-          env->organization = mutt_str_dup(body);
+          env->organization = mutt_intern(body);
       }
       break;
 
@@ -1055,21 +1167,19 @@ int mutt_rfc822_parse_line(struct Envelope *env, struct Email *e, const char *na
   if (!matched && user_hdrs)
   {
     const bool c_weed = cs_subset_bool(NeoMutt->sub, "weed");
-    char *dup = NULL;
-    mutt_str_asprintf(&dup, "%s: %s", name, body);
+    struct Buffer *hdr = mutt_buffer_pool_get();
+    mutt_buffer_printf(hdr, "%s: %s", name, body);
 
-    if (!weed || !c_weed || !mutt_matches_ignore(dup))
+    /* Weeded headers never touch the heap */
+    if (!weed || !c_weed || !mutt_matches_ignore(mutt_buffer_string(hdr)))
     {
-      struct ListNode *np = mutt_list_insert_tail(&env->userhdrs, dup);
+      struct ListNode *np = mutt_list_insert_tail(&env->userhdrs, mutt_buffer_strdup(hdr));
       if (do_2047)
       {
         rfc2047_decode(&np->data);
       }
     }
-    else
-    {
-      FREE(&dup);
-    }
+    mutt_buffer_pool_release(&hdr);
   }
 
   return matched;
@@ -1170,8 +1280,13 @@ struct Envelope *mutt_rfc822_read_header(FILE *fp, struct Email *e, bool user_hd
   char *p = NULL;
   LOFF_T loc;
   size_t linelen = 1024;
-  char *line = mutt_mem_malloc(linelen);
-  char buf[linelen + 1];
+  /* The unfolding scratch buffer comes from the pool, so opening a large
+   * folder reuses the same allocation for every message */
+  struct Buffer *linebuf = mutt_buffer_pool_get();
+  mutt_buffer_alloc(linebuf, linelen);
+  linelen = linebuf->dsize;
+  char *line = linebuf->data;
+  char buf[1024 + 1];
 
   if (e)
   {
@@ -1265,7 +1380,10 @@ struct Envelope *mutt_rfc822_read_header(FILE *fp, struct Email *e, bool user_hd
     mutt_rfc822_parse_line(env, e, line, p, user_hdrs, weed, true);
   }
 
-  FREE(&line);
+  linebuf->data = line; /* mutt_rfc822_read_line() may have grown it */
+  linebuf->dsize = linelen;
+  mutt_buffer_seek(linebuf, 0);
+  mutt_buffer_pool_release(&linebuf);
 
   if (e)
   {
@@ -1333,7 +1451,10 @@ struct Body *mutt_read_mime_header(FILE *fp, bool digest)
   struct Envelope *env = mutt_env_new();
   char *c = NULL;
   size_t linelen = 1024;
-  char *line = mutt_mem_malloc(linelen);
+  struct Buffer *linebuf = mutt_buffer_pool_get();
+  mutt_buffer_alloc(linebuf, linelen);
+  linelen = linebuf->dsize;
+  char *line = linebuf->data;
   bool matched = false;
 
   p->hdr_offset = ftello(fp);
@@ -1426,7 +1547,10 @@ struct Body *mutt_read_mime_header(FILE *fp, bool digest)
   else if ((p->type == TYPE_MESSAGE) && !p->subtype)
     p->subtype = mutt_str_dup("rfc822");
 
-  FREE(&line);
+  linebuf->data = line; /* mutt_rfc822_read_line() may have grown it */
+  linebuf->dsize = linelen;
+  mutt_buffer_seek(linebuf, 0);
+  mutt_buffer_pool_release(&linebuf);
 
   if (matched)
   {
@@ -1537,6 +1661,77 @@ bail:
  * @param counter  Number of parts processed so far
  * @retval ptr New Body containing parsed structure
  */
+/**
+ * boundary_next - Advance to the next boundary candidate line
+ * @param fp      Stream to read from
+ * @param buf     Buffer to store the candidate line
+ * @param buflen  Length of buffer
+ * @param end_off Offset beyond which candidate lines don't count
+ * @retval true  buf holds a line starting "--" and fp is positioned after it
+ * @retval false No candidate line starts before end_off
+ *
+ * The content between boundaries vastly outweighs the boundary lines, so
+ * rather than reading it line by line, scan raw blocks for "\n--" with
+ * memchr() and only hand back the lines that can be boundaries.
+ */
+static bool boundary_next(FILE *fp, char *buf, size_t buflen, LOFF_T end_off)
+{
+  char blk[8192];
+  LOFF_T pos = ftello(fp);
+  bool bol = true; /* the current position starts a line */
+
+  while (pos < end_off)
+  {
+    const size_t got = fread(blk, 1, sizeof(blk), fp);
+    if (got == 0)
+      return false;
+
+    if (bol && (got >= 2) && (blk[0] == '-') && (blk[1] == '-'))
+    {
+      if (!mutt_file_seek(fp, pos, SEEK_SET))
+        return false;
+      return fgets(buf, buflen, fp);
+    }
+
+    bool rewound = false;
+    const char *end = blk + got;
+    const char *p = blk;
+    while ((p = memchr(p, '\n', end - p)))
+    {
+      p++;
+      const LOFF_T lstart = pos + (p - blk);
+      if (lstart >= end_off)
+        return false;
+
+      if ((end - p) < 2)
+      {
+        /* "--" may straddle the block edge; resume from the line start */
+        if (!mutt_file_seek(fp, lstart, SEEK_SET))
+          return false;
+        pos = lstart;
+        bol = true;
+        rewound = true;
+        break;
+      }
+
+      if ((p[0] == '-') && (p[1] == '-'))
+      {
+        if (!mutt_file_seek(fp, lstart, SEEK_SET))
+          return false;
+        return fgets(buf, buflen, fp);
+      }
+    }
+
+    if (!rewound)
+    {
+      pos += got;
+      bol = false;
+    }
+  }
+
+  return false;
+}
+
 static struct Body *parse_multipart(FILE *fp, const char *boundary,
                                     LOFF_T end_off, bool digest, int *counter)
 {
@@ -1554,7 +1749,7 @@ static struct Body *parse_multipart(FILE *fp, const char *boundary,
   bool final = false; /* did we see the ending boundary? */
 
   const size_t blen = mutt_str_len(boundary);
-  while ((ftello(fp) < end_off) && fgets(buf, sizeof(buf), fp))
+  while (boundary_next(fp, buf, sizeof(buf), end_off))
   {
     const size_t len = mutt_str_len(buf);
 
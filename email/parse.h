@@ -38,6 +38,7 @@ enum ContentType mutt_check_mime_type     (const char *s);
 char *           mutt_extract_message_id  (const char *s, size_t *len);
 bool             mutt_is_message_type     (int type, const char *subtype);
 bool             mutt_matches_ignore      (const char *s);
+void             mutt_matches_ignore_flush(void);
 void             mutt_parse_content_type  (const char *s, struct Body *ct);
 bool             mutt_parse_mailto        (struct Envelope *env, char **body, const char *src);
 struct Body *    mutt_parse_multipart     (FILE *fp, const char *boundary, LOFF_T end_off, bool digest);
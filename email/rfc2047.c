@@ -33,7 +33,11 @@
 #include <ctype.h>
 #include <errno.h>
 #include <iconv.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 #include <stdbool.h>
+#include <stdint.h>
 #include <string.h>
 #include "mutt/lib.h"
 #include "address/lib.h"
@@ -143,6 +147,12 @@ static size_t q_encoder(char *str, const char *buf, size_t buflen, const char *t
 static char *parse_encoded_word(char *str, enum ContentEncoding *enc, char **charset,
                                 size_t *charsetlen, char **text, size_t *textlen)
 {
+  /* Every encoded word starts with "=?", so jump straight to the first
+   * candidate instead of letting the regex crawl over plain text */
+  str = strstr(str, "=?");
+  if (!str)
+    return NULL;
+
   regmatch_t *match = mutt_prex_capture(PREX_RFC2047_ENCODED_WORD, str);
   if (!match)
     return NULL;
@@ -194,7 +204,7 @@ static size_t try_block(const char *d, size_t dlen, const char *fromcode,
 
   if (fromcode)
   {
-    iconv_t cd = mutt_ch_iconv_open(tocode, fromcode, MUTT_ICONV_NO_FLAGS);
+    iconv_t cd = mutt_ch_iconv_open_cached(tocode, fromcode, MUTT_ICONV_NO_FLAGS);
     assert(cd != (iconv_t) (-1));
     ib = d;
     ibl = dlen;
@@ -204,11 +214,11 @@ static size_t try_block(const char *d, size_t dlen, const char *fromcode,
         (iconv(cd, NULL, NULL, &ob, &obl) == (size_t) (-1)))
     {
       assert(errno == E2BIG);
-      iconv_close(cd);
+      mutt_ch_iconv_close_cached(cd);
       assert(ib > d);
       return ((ib - d) == dlen) ? dlen : ib - d + 1;
     }
-    iconv_close(cd);
+    mutt_ch_iconv_close_cached(cd);
   }
   else
   {
@@ -274,7 +284,7 @@ static size_t encode_block(char *str, char *buf, size_t buflen, const char *from
     return (*encoder)(str, buf, buflen, tocode);
   }
 
-  const iconv_t cd = mutt_ch_iconv_open(tocode, fromcode, MUTT_ICONV_NO_FLAGS);
+  const iconv_t cd = mutt_ch_iconv_open_cached(tocode, fromcode, MUTT_ICONV_NO_FLAGS);
   assert(cd != (iconv_t) (-1));
   const char *ib = buf;
   size_t ibl = buflen;
@@ -284,7 +294,7 @@ static size_t encode_block(char *str, char *buf, size_t buflen, const char *from
   const size_t n1 = iconv(cd, (ICONV_CONST char **) &ib, &ibl, &ob, &obl);
   const size_t n2 = iconv(cd, NULL, NULL, &ob, &obl);
   assert(n1 != (size_t) (-1) && n2 != (size_t) (-1));
-  iconv_close(cd);
+  mutt_ch_iconv_close_cached(cd);
   return (*encoder)(str, tmp, ob - tmp, tocode);
 }
 
@@ -351,57 +361,60 @@ static void finalize_chunk(struct Buffer *res, struct Buffer *buf, char *charset
 
 /**
  * decode_word - Decode an RFC2047-encoded string
+ * @param out Buffer for the decoded text
  * @param s   String to decode
  * @param len Length of the string
  * @param enc Encoding type
- * @retval ptr Decoded string
+ * @retval true  Success
+ * @retval false Error, e.g. an invalid base64 string
  *
- * @note The caller must free the returned string
+ * The decoded text is appended to out, avoiding a temporary allocation per
+ * encoded word.
  */
-static char *decode_word(const char *s, size_t len, enum ContentEncoding enc)
+static bool decode_word(struct Buffer *out, const char *s, size_t len, enum ContentEncoding enc)
 {
   const char *it = s;
   const char *end = s + len;
 
   if (enc == ENC_QUOTED_PRINTABLE)
   {
-    struct Buffer buf = mutt_buffer_make(0);
     for (; it < end; it++)
     {
       if (*it == '_')
       {
-        mutt_buffer_addch(&buf, ' ');
+        mutt_buffer_addch(out, ' ');
       }
       else if ((it[0] == '=') && (!(it[1] & ~127) && (hexval(it[1]) != -1)) &&
                (!(it[2] & ~127) && (hexval(it[2]) != -1)))
       {
-        mutt_buffer_addch(&buf, (hexval(it[1]) << 4) | hexval(it[2]));
+        mutt_buffer_addch(out, (hexval(it[1]) << 4) | hexval(it[2]));
         it += 2;
       }
       else
       {
-        mutt_buffer_addch(&buf, *it);
+        mutt_buffer_addch(out, *it);
       }
     }
-    mutt_buffer_addch(&buf, '\0');
-    return buf.data;
+    return true;
   }
   else if (enc == ENC_BASE64)
   {
     const int olen = 3 * len / 4 + 1;
-    char *out = mutt_mem_malloc(olen);
-    int dlen = mutt_b64_decode(it, out, olen);
-    if (dlen == -1)
+    char tmp[256];
+    char *decoded = (olen <= (int) sizeof(tmp)) ? tmp : mutt_mem_malloc(olen);
+    int dlen = mutt_b64_decode(it, decoded, olen);
+    if (dlen != -1)
     {
-      FREE(&out);
-      return NULL;
+      decoded[dlen] = '\0';
+      mutt_buffer_addstr(out, decoded);
     }
-    out[dlen] = '\0';
-    return out;
+    if (decoded != tmp)
+      FREE(&decoded);
+    return (dlen != -1);
   }
 
   assert(0); /* The enc parameter has an invalid value */
-  return NULL;
+  return false;
 }
 
 /**
@@ -633,18 +646,78 @@ void rfc2047_encode(char **pd, const char *specials, int col, const char *charse
   *pd = e;
 }
 
+#ifdef HAVE_PTHREAD_CREATE
+/// The parse worker threads decode headers concurrently
+static pthread_mutex_t DecodeCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+#define decode_cache_lock() pthread_mutex_lock(&DecodeCacheMutex)
+#define decode_cache_unlock() pthread_mutex_unlock(&DecodeCacheMutex)
+#else
+#define decode_cache_lock()
+#define decode_cache_unlock()
+#endif
+
+/// Number of cached header decodes before the cache is flushed
+#define DECODE_CACHE_MAX 512
+/// Longest header string that will be cached
+#define DECODE_CACHE_KEY_MAX 256
+
+/// Map: encoded header -> decoded header, see rfc2047_decode()
+static struct HashTable *DecodeCache = NULL;
+/// Number of entries in #DecodeCache
+static size_t DecodeCacheCount = 0;
+/// Value of `$charset` when #DecodeCache was filled
+static char *DecodeCacheCharset = NULL;
+/// Value of `$assumed_charset` when #DecodeCache was filled
+static char *DecodeCacheAssumed = NULL;
+
 /**
- * rfc2047_decode - Decode any RFC2047-encoded header fields
+ * decode_cache_elem_free - Free a cached decode - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void decode_cache_elem_free(int type, void *obj, intptr_t data)
+{
+  FREE(&obj);
+}
+
+/**
+ * decode_cache_check - Validate the decode cache against the config
+ *
+ * The decoded result depends on `$charset` and `$assumed_charset`, so the
+ * cache is flushed when either changes.  It is also flushed, rather than
+ * evicted entry by entry, when it grows past #DECODE_CACHE_MAX; the hot
+ * senders of a folder will quickly repopulate it.
+ */
+static void decode_cache_check(void)
+{
+  const char *const c_charset = cs_subset_string(NeoMutt->sub, "charset");
+  const char *const c_assumed_charset = cs_subset_string(NeoMutt->sub, "assumed_charset");
+
+  if (DecodeCache && ((DecodeCacheCount >= DECODE_CACHE_MAX) ||
+                      !mutt_str_equal(DecodeCacheCharset, c_charset) ||
+                      !mutt_str_equal(DecodeCacheAssumed, c_assumed_charset)))
+  {
+    mutt_hash_free(&DecodeCache);
+    DecodeCacheCount = 0;
+  }
+
+  if (!DecodeCache)
+  {
+    DecodeCache = mutt_hash_new(257, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(DecodeCache, decode_cache_elem_free, 0);
+    mutt_str_replace(&DecodeCacheCharset, c_charset);
+    mutt_str_replace(&DecodeCacheAssumed, c_assumed_charset);
+  }
+}
+
+/**
+ * decode - Decode any RFC2047-encoded header fields
  * @param[in,out] pd  String to be decoded, and resulting decoded string
  *
  * Try to decode anything that looks like a valid RFC2047 encoded header field,
  * ignoring RFC822 parsing rules. If decoding fails, for example due to an
  * invalid base64 string, the original input is left untouched.
  */
-void rfc2047_decode(char **pd)
+static void decode(char **pd)
 {
-  if (!pd || !*pd)
-    return;
 
   struct Buffer buf = mutt_buffer_make(0); /* Output buffer            */
   char *s = *pd;            /* Read pointer                           */
@@ -704,12 +777,6 @@ void rfc2047_decode(char **pd)
     if (beg)
     {
       /* Some encoded text was found */
-      text[textlen] = '\0';
-      char *decoded = decode_word(text, textlen, enc);
-      if (!decoded)
-      {
-        return;
-      }
       if (prev.data && ((prev_charsetlen != charsetlen) ||
                         !mutt_strn_equal(prev_charset, charset, charsetlen)))
       {
@@ -718,8 +785,11 @@ void rfc2047_decode(char **pd)
         finalize_chunk(&buf, &prev, prev_charset, prev_charsetlen);
       }
 
-      mutt_buffer_addstr(&prev, decoded);
-      FREE(&decoded);
+      text[textlen] = '\0';
+      if (!decode_word(&prev, text, textlen, enc))
+      {
+        return;
+      }
       prev_charset = charset;
       prev_charsetlen = charsetlen;
       s = text + textlen + 2; /* Skip final ?= */
@@ -737,6 +807,64 @@ void rfc2047_decode(char **pd)
   *pd = buf.data;
 }
 
+/**
+ * rfc2047_decode - Decode any RFC2047-encoded header fields
+ * @param[in,out] pd  String to be decoded, and resulting decoded string
+ *
+ * Caching wrapper around decode().  A folder full of messages from the same
+ * senders decodes the same From names over and over, so the results are
+ * remembered, keyed on the raw header string.  Strings without any "=?"
+ * marker are handled without touching the decoder at all.
+ */
+void rfc2047_decode(char **pd)
+{
+  if (!pd || !*pd)
+    return;
+
+  if (!strstr(*pd, "=?"))
+  {
+    /* No encoded words: the only possible transformation is the
+     * $assumed_charset conversion of the raw 8-bit text */
+    const char *const c_assumed_charset =
+        cs_subset_string(NeoMutt->sub, "assumed_charset");
+    if (c_assumed_charset)
+      mutt_ch_convert_nonmime_string(pd);
+    return;
+  }
+
+  if (mutt_str_len(*pd) > DECODE_CACHE_KEY_MAX)
+  {
+    decode(pd);
+    return;
+  }
+
+  /* Copy the cached string out while the lock is held: a concurrent flush
+   * may free it the moment the lock is released */
+  decode_cache_lock();
+  decode_cache_check();
+  const char *cached = mutt_hash_find(DecodeCache, *pd);
+  if (cached)
+  {
+    mutt_str_replace(pd, cached);
+    decode_cache_unlock();
+    return;
+  }
+  decode_cache_unlock();
+
+  char *key = mutt_str_dup(*pd);
+  decode(pd);
+
+  decode_cache_lock();
+  decode_cache_check();
+  if (!mutt_hash_find(DecodeCache, key)) /* another thread may have raced us */
+  {
+    mutt_hash_insert(DecodeCache, key, mutt_str_dup(*pd));
+    DecodeCacheCount++;
+  }
+  decode_cache_unlock();
+  FREE(&key);
+}
+
 /**
  * rfc2047_encode_addrlist - Encode any RFC2047 headers, where required, in an Address list
  * @param al   AddressList
@@ -41,6 +41,44 @@
 #include "opcodes.h"
 #include "protos.h"
 
+/// Depth of nested bulk flag changes; while non-zero, notifications are held back
+static int FlagBatchDepth = 0;
+/// A change notification was suppressed during the current batch
+static bool FlagBatchPending = false;
+
+/**
+ * mutt_flag_batch_begin - Start a bulk flag change
+ *
+ * Each flag change normally sends an #NT_MAILBOX_CHANGE notification, and the
+ * observers (index, sidebar, ...) each do their update work per event.  Inside
+ * a begin/end scope the notifications are coalesced: mutt_flag_batch_end()
+ * sends a single summary event instead.  Scopes may nest; only the outermost
+ * end notifies.
+ */
+void mutt_flag_batch_begin(void)
+{
+  FlagBatchDepth++;
+}
+
+/**
+ * mutt_flag_batch_end - Finish a bulk flag change and notify once
+ * @param m Mailbox that was changed
+ */
+void mutt_flag_batch_end(struct Mailbox *m)
+{
+  if ((FlagBatchDepth > 0) && (--FlagBatchDepth > 0))
+    return;
+  if (!FlagBatchPending)
+    return;
+
+  FlagBatchPending = false;
+  if (m)
+  {
+    struct EventMailbox ev_m = { m };
+    notify_send(m->notify, NT_MAILBOX, NT_MAILBOX_CHANGE, &ev_m);
+  }
+}
+
 /**
  * mutt_set_flag_update - Set a flag on an email
  * @param m        Mailbox
@@ -330,9 +368,22 @@ void mutt_set_flag_update(struct Mailbox *m, struct Email *e,
 
   if (update)
   {
+    FREE(&e->display); /* the index line shows the flags */
+    if ((flag == MUTT_NEW) || (flag == MUTT_OLD) || (flag == MUTT_READ) ||
+        (flag == MUTT_REPLIED)) /* replying marks the message read */
+    {
+      mutt_thread_unread_invalidate(e);
+    }
     mutt_set_header_color(m, e);
-    struct EventMailbox ev_m = { m };
-    notify_send(m->notify, NT_MAILBOX, NT_MAILBOX_CHANGE, &ev_m);
+    if (FlagBatchDepth > 0)
+    {
+      FlagBatchPending = true;
+    }
+    else
+    {
+      struct EventMailbox ev_m = { m };
+      notify_send(m->notify, NT_MAILBOX, NT_MAILBOX_CHANGE, &ev_m);
+    }
   }
 
   /* if the message status has changed, we need to invalidate the cached
@@ -358,11 +409,13 @@ void mutt_emails_set_flag(struct Mailbox *m, struct EmailList *el,
   if (!m || !el || STAILQ_EMPTY(el))
     return;
 
+  mutt_flag_batch_begin();
   struct EmailNode *en = NULL;
   STAILQ_FOREACH(en, el, entries)
   {
     mutt_set_flag(m, en->email, flag, bf);
   }
+  mutt_flag_batch_end(m);
 }
 
 /**
@@ -392,6 +445,7 @@ int mutt_thread_set_flag(struct Mailbox *m, struct Email *e,
       cur = cur->parent;
   start = cur;
 
+  mutt_flag_batch_begin();
   if (cur->message && (cur != e->thread))
     mutt_set_flag(m, cur->message, flag, bf);
 
@@ -423,6 +477,7 @@ done:
   cur = e->thread;
   if (cur->message)
     mutt_set_flag(m, cur->message, flag, bf);
+  mutt_flag_batch_end(m);
   return 0;
 }
 
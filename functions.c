@@ -439,6 +439,7 @@ const struct MenuFuncOp OpIndex[] = { /* map: index */
   { "resend-message",                OP_RESEND },
   { "root-message",                  OP_MAIN_ROOT_MESSAGE },
   { "save-message",                  OP_SAVE },
+  { "search-mailboxes",              OP_MAIN_SEARCH_MAILBOXES },
   { "set-flag",                      OP_MAIN_SET_FLAG },
   { "show-limit",                    OP_MAIN_SHOW_LIMIT },
   { "show-log-messages",             OP_SHOW_LOG_MESSAGES },
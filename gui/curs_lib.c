@@ -927,8 +927,23 @@ size_t mutt_wstr_trunc(const char *src, size_t maxlen, size_t maxwid, size_t *wi
 
   n = mutt_str_len(src);
 
-  for (w = 0; n && (cl = mbrtowc(&wc, src, n, &mbstate)); src += cl, n -= cl)
+  for (w = 0; n; src += cl, n -= cl)
   {
+    /* In UTF-8, printable ASCII represents itself; skip the conversion */
+    if (CharsetIsUtf8 && ((unsigned char) src[0] >= 0x20) && ((unsigned char) src[0] < 0x7f))
+    {
+      cl = 1;
+      cw = 1;
+      if ((cl + l > maxlen) || (cw + w > maxwid))
+        break;
+      l += cl;
+      w += cw;
+      continue;
+    }
+
+    cl = mbrtowc(&wc, src, n, &mbstate);
+    if (cl == 0)
+      break;
     if ((cl == (size_t) (-1)) || (cl == (size_t) (-2)))
     {
       if (cl == (size_t) (-1))
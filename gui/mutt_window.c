@@ -165,6 +165,13 @@ void window_set_visible(struct MuttWindow *win, bool visible)
   if (!win)
     win = RootWindow;
 
+  if (win->state.visible != visible)
+  {
+    /* The siblings will shuffle to take up (or free) the space */
+    struct MuttWindow *dirty = win->parent ? win->parent : win;
+    dirty->actions |= WA_REFLOW;
+  }
+
   win->state.visible = visible;
 }
 
@@ -188,6 +195,7 @@ struct MuttWindow *mutt_window_new(enum WindowType type, enum MuttWindowOrientat
   win->req_rows = rows;
   win->req_cols = cols;
   win->state.visible = true;
+  win->actions = WA_REFLOW;
   win->notify = notify_new();
   TAILQ_INIT(&win->children);
   return win;
@@ -594,10 +602,39 @@ static void window_repaint(struct MuttWindow *win)
   }
 }
 
+/**
+ * window_wants_reflow - Does any Window in the tree need to be resized?
+ * @param win Window to start at
+ * @retval true A Window has #WA_REFLOW queued
+ *
+ * Hidden Windows are skipped; they take up no space and window_set_visible()
+ * will flag their parent when they're shown again.
+ */
+static bool window_wants_reflow(struct MuttWindow *win)
+{
+  if (!win || !win->state.visible)
+    return false;
+
+  if (win->actions & WA_REFLOW)
+    return true;
+
+  struct MuttWindow *np = NULL;
+  TAILQ_FOREACH(np, &win->children, entries)
+  {
+    if (window_wants_reflow(np))
+      return true;
+  }
+
+  return false;
+}
+
 /**
  * window_redraw - Reflow, recalc and repaint a tree of Windows
  * @param win Window to start at
  *
+ * The Windows are only resized if one of them has #WA_REFLOW queued;
+ * most redraws just update the contents of unchanged Windows.
+ *
  * @note If win is NULL, all windows will be redrawn
  */
 void window_redraw(struct MuttWindow *win)
@@ -605,8 +642,11 @@ void window_redraw(struct MuttWindow *win)
   if (!win)
     win = RootWindow;
 
-  window_reflow(win);
-  window_notify_all(win);
+  if (window_wants_reflow(win))
+  {
+    window_reflow(win);
+    window_notify_all(win);
+  }
 
   window_recalc(win);
   window_repaint(win);
@@ -223,6 +223,7 @@ void window_reflow(struct MuttWindow *win)
 {
   if (!win)
     return;
+  win->actions &= ~WA_REFLOW;
   if (win->orient == MUTT_WIN_ORIENT_VERTICAL)
     window_reflow_vert(win);
   else
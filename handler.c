@@ -59,6 +59,9 @@
 #ifdef ENABLE_NLS
 #include <libintl.h>
 #endif
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 
 #define BUFI_SIZE 1000
 #define BUFO_SIZE 2000
@@ -242,6 +245,19 @@ static void qp_decode_line(char *dest, char *src, size_t *l, int last)
 
   for (d = dest, s = src; *s;)
   {
+    /* only '=' needs decoding; copy the run up to the next one wholesale */
+    if (*s != '=')
+    {
+      char *eq = strchr(s, '=');
+      const size_t run = eq ? (size_t) (eq - s) : strlen(s);
+      memcpy(d, s, run);
+      d += run;
+      s += run;
+      kind = -1;
+      if (*s == '\0')
+        break;
+    }
+
     switch ((kind = qp_decode_triple(s, &c)))
     {
       case 0:
@@ -1214,6 +1230,303 @@ static int multilingual_handler(struct Body *a, struct State *s)
   return rc;
 }
 
+#if defined(HAVE_PTHREAD_CREATE) && defined(HAVE_FMEMOPEN)
+/// Only parts at least this big are worth handing to the decode thread
+#define PREDECODE_MIN_SIZE (1024 * 1024)
+/// Upper bound on the encoded bytes held in memory for the decode thread
+#define PREDECODE_BUDGET (64 * 1024 * 1024)
+
+/**
+ * struct PredecodeJob - One Mime part waiting for the decode thread
+ */
+struct PredecodeJob
+{
+  struct Body *b;                     ///< Part this decodes; only used as a key
+  char *enc;                          ///< Encoded bytes of the part (owned)
+  size_t enc_len;                     ///< Length of the encoded bytes
+  int encoding;                       ///< ENC_BASE64 or ENC_QUOTED_PRINTABLE
+  char *dec;                          ///< Decoded bytes (owned, valid when done)
+  size_t dec_len;                     ///< Length of the decoded bytes
+  bool ok;                            ///< The decode succeeded
+  bool done;                          ///< The worker has finished this job
+  STAILQ_ENTRY(PredecodeJob) entries; ///< Linked list
+};
+STAILQ_HEAD(PredecodeJobList, PredecodeJob);
+
+/**
+ * struct PredecodePipe - Decode later Mime parts while earlier ones drain
+ *
+ * While multipart_handler() runs its parts through their handlers in order, a
+ * single worker thread decodes the remaining large base64/qp parts into
+ * memory, so mutt_decode_attachment() can splice the finished bytes instead
+ * of decoding serially.  Only parts whose decode is a pure byte transform are
+ * queued - no charset conversion, no prefixing - so a part that ends up going
+ * down a different path is just wasted work, never wrong output.
+ */
+struct PredecodePipe
+{
+  pthread_t thread;             ///< Decode thread
+  pthread_mutex_t mutex;        ///< Protects the fields below
+  pthread_cond_t work;          ///< Jobs were queued, or stop was set
+  pthread_cond_t done;          ///< The worker finished a job
+  struct PredecodeJobList list; ///< Queued and finished jobs
+  bool stop;                    ///< Tell the worker to quit
+};
+
+/// Pipeline of the outermost running multipart_handler(), if any
+static struct PredecodePipe *PredecodePipe = NULL;
+
+/**
+ * predecode_job - Decode one queued part into memory
+ * @param job Job to decode
+ *
+ * Runs on the decode thread.  The job was queued with istext == false, so the
+ * decoders write plain bytes and touch nothing outside the local State.
+ */
+static void predecode_job(struct PredecodeJob *job)
+{
+  struct State ws = { 0 };
+  ws.fp_in = fmemopen(job->enc, job->enc_len, "r");
+  ws.fp_out = open_memstream(&job->dec, &job->dec_len);
+  if (ws.fp_in && ws.fp_out)
+  {
+    if (job->encoding == ENC_QUOTED_PRINTABLE)
+      decode_quoted(&ws, job->enc_len, false, (iconv_t) (-1));
+    else
+      mutt_decode_base64(&ws, job->enc_len, false, (iconv_t) (-1));
+    job->ok = true;
+  }
+  mutt_file_fclose(&ws.fp_in);
+  mutt_file_fclose(&ws.fp_out);
+  FREE(&job->enc);
+}
+
+/**
+ * predecode_main - Decode thread of a PredecodePipe
+ * @param arg PredecodePipe to work for
+ * @retval NULL Always
+ */
+static void *predecode_main(void *arg)
+{
+  struct PredecodePipe *pipe = arg;
+
+  pthread_mutex_lock(&pipe->mutex);
+  while (!pipe->stop)
+  {
+    struct PredecodeJob *job = NULL;
+    STAILQ_FOREACH(job, &pipe->list, entries)
+    {
+      if (!job->done)
+        break;
+    }
+    if (!job)
+    {
+      pthread_cond_wait(&pipe->work, &pipe->mutex);
+      continue;
+    }
+
+    pthread_mutex_unlock(&pipe->mutex);
+    predecode_job(job);
+    pthread_mutex_lock(&pipe->mutex);
+
+    job->done = true;
+    pthread_cond_broadcast(&pipe->done);
+  }
+  pthread_mutex_unlock(&pipe->mutex);
+  return NULL;
+}
+
+/**
+ * predecode_candidate - Is pre-decoding this part useful and byte-identical?
+ * @param b Body of the Mime part
+ * @retval true The part will be decoded, without charset conversion
+ *
+ * The conditions mirror mutt_body_handler() and mutt_decode_attachment():
+ * the part must have a handler that gets its transfer encoding removed first
+ * (a non-text part without one is never decoded at all), and the inline
+ * decode must run with istext == false and no iconv descriptor, so that the
+ * worker's output is byte-identical.
+ */
+static bool predecode_candidate(struct Body *b)
+{
+  if ((b->encoding != ENC_BASE64) && (b->encoding != ENC_QUOTED_PRINTABLE))
+    return false;
+  if (b->length < PREDECODE_MIN_SIZE)
+    return false;
+  if ((b->type == TYPE_MULTIPART) || (b->type == TYPE_MESSAGE))
+    return false;
+  if (mutt_is_text_part(b) && (b->disposition == DISP_INLINE))
+    return false;
+  if (((WithCrypto & APPLICATION_PGP) != 0) && mutt_is_application_pgp(b))
+    return false;
+
+  const bool c_honor_disposition =
+      cs_subset_bool(NeoMutt->sub, "honor_disposition");
+  if (c_honor_disposition && (b->disposition == DISP_ATTACH) && !OptViewAttach)
+    return false;
+
+  if (is_autoview(b))
+    return true;
+  if (((WithCrypto & APPLICATION_SMIME) != 0) && (b->type == TYPE_APPLICATION) &&
+      mutt_is_application_smime(b))
+  {
+    return true;
+  }
+  return false;
+}
+
+/**
+ * predecode_start - Queue a multipart's later parts for the decode thread
+ * @param b Body of the multipart, with its parts parsed
+ * @param s State to work with
+ * @retval true A pipeline was started; predecode_finish() must be called
+ *
+ * The first part is left to the main thread - the worker would only delay it.
+ * Non-text parts without a handler are never decoded at all, so only parts
+ * with one (autoview or S/MIME) are queued; run_decode_and_handler() removes
+ * their transfer encoding through mutt_decode_attachment() before the handler
+ * runs, and that's the stage the splice replaces.
+ */
+static bool predecode_start(struct Body *b, struct State *s)
+{
+  if (PredecodePipe || !b->parts)
+    return false;
+
+  long budget = PREDECODE_BUDGET;
+  int num = 0;
+  for (struct Body *p = b->parts->next; p; p = p->next)
+  {
+    if (predecode_candidate(p) && (p->length <= budget))
+    {
+      budget -= p->length;
+      num++;
+    }
+  }
+  if (num == 0)
+    return false;
+
+  struct PredecodePipe *pipe = mutt_mem_calloc(1, sizeof(struct PredecodePipe));
+  STAILQ_INIT(&pipe->list);
+  pthread_mutex_init(&pipe->mutex, NULL);
+  pthread_cond_init(&pipe->work, NULL);
+  pthread_cond_init(&pipe->done, NULL);
+
+  if (pthread_create(&pipe->thread, NULL, predecode_main, pipe) != 0)
+  {
+    pthread_cond_destroy(&pipe->done);
+    pthread_cond_destroy(&pipe->work);
+    pthread_mutex_destroy(&pipe->mutex);
+    FREE(&pipe);
+    return false;
+  }
+
+  budget = PREDECODE_BUDGET;
+  for (struct Body *p = b->parts->next; p; p = p->next)
+  {
+    if (!predecode_candidate(p) || (p->length > budget))
+      continue;
+    budget -= p->length;
+
+    char *enc = mutt_mem_malloc(p->length);
+    if (!mutt_file_seek(s->fp_in, p->offset, SEEK_SET) ||
+        (fread(enc, 1, p->length, s->fp_in) != (size_t) p->length))
+    {
+      FREE(&enc);
+      continue;
+    }
+
+    struct PredecodeJob *job = mutt_mem_calloc(1, sizeof(struct PredecodeJob));
+    job->b = p;
+    job->enc = enc;
+    job->enc_len = p->length;
+    job->encoding = p->encoding;
+
+    pthread_mutex_lock(&pipe->mutex);
+    STAILQ_INSERT_TAIL(&pipe->list, job, entries);
+    pthread_cond_signal(&pipe->work);
+    pthread_mutex_unlock(&pipe->mutex);
+  }
+
+  PredecodePipe = pipe;
+  return true;
+}
+
+/**
+ * predecode_take - Splice a part's pre-decoded bytes, if the worker has them
+ * @param b Body of the Mime part
+ * @param s State to write to
+ * @retval true The decoded bytes were written; nothing left to do
+ * @retval false The part wasn't queued or failed; decode it inline
+ *
+ * Blocks until the worker finishes the part if it's still in flight.
+ */
+static bool predecode_take(struct Body *b, struct State *s)
+{
+  struct PredecodePipe *pipe = PredecodePipe;
+  if (!pipe || s->prefix)
+    return false;
+
+  pthread_mutex_lock(&pipe->mutex);
+  struct PredecodeJob *job = NULL;
+  STAILQ_FOREACH(job, &pipe->list, entries)
+  {
+    if (job->b == b)
+      break;
+  }
+  while (job && !job->done)
+    pthread_cond_wait(&pipe->done, &pipe->mutex);
+  if (job)
+    STAILQ_REMOVE(&pipe->list, job, PredecodeJob, entries);
+  pthread_mutex_unlock(&pipe->mutex);
+
+  if (!job)
+    return false;
+
+  const bool ok = job->ok;
+  if (ok)
+  {
+    mutt_debug(LL_DEBUG2, "spliced %zu pre-decoded bytes\n", job->dec_len);
+    fwrite(job->dec, 1, job->dec_len, s->fp_out);
+    /* leave fp_in where the inline decode would, roughly */
+    mutt_file_seek(s->fp_in, b->offset + b->length, SEEK_SET);
+  }
+  FREE(&job->dec);
+  FREE(&job);
+  return ok;
+}
+
+/**
+ * predecode_finish - Stop the decode thread and drop unconsumed jobs
+ */
+static void predecode_finish(void)
+{
+  struct PredecodePipe *pipe = PredecodePipe;
+  if (!pipe)
+    return;
+  PredecodePipe = NULL;
+
+  pthread_mutex_lock(&pipe->mutex);
+  pipe->stop = true;
+  pthread_cond_broadcast(&pipe->work);
+  pthread_mutex_unlock(&pipe->mutex);
+  pthread_join(pipe->thread, NULL);
+
+  struct PredecodeJob *job = NULL;
+  while ((job = STAILQ_FIRST(&pipe->list)))
+  {
+    STAILQ_REMOVE_HEAD(&pipe->list, entries);
+    FREE(&job->enc);
+    FREE(&job->dec);
+    FREE(&job);
+  }
+
+  pthread_cond_destroy(&pipe->done);
+  pthread_cond_destroy(&pipe->work);
+  pthread_mutex_destroy(&pipe->mutex);
+  FREE(&pipe);
+}
+#endif /* HAVE_PTHREAD_CREATE && HAVE_FMEMOPEN */
+
 /**
  * multipart_handler - Handler for multipart emails - Implements ::handler_t - @ingroup handler_api
  */
@@ -1235,6 +1548,10 @@ static int multipart_handler(struct Body *a, struct State *s)
   else
     b = a;
 
+#if defined(HAVE_PTHREAD_CREATE) && defined(HAVE_FMEMOPEN)
+  const bool pipelined = predecode_start(b, s);
+#endif
+
   for (p = b->parts, count = 1; p; p = p->next, count++)
   {
     if (s->flags & MUTT_DISPLAY)
@@ -1280,6 +1597,11 @@ static int multipart_handler(struct Body *a, struct State *s)
     }
   }
 
+#if defined(HAVE_PTHREAD_CREATE) && defined(HAVE_FMEMOPEN)
+  if (pipelined)
+    predecode_finish();
+#endif
+
   if ((a->encoding == ENC_BASE64) || (a->encoding == ENC_QUOTED_PRINTABLE) ||
       (a->encoding == ENC_UUENCODED))
   {
@@ -1866,6 +2188,11 @@ void mutt_decode_attachment(struct Body *b, struct State *s)
   int istext = mutt_is_text_part(b) && (b->disposition == DISP_INLINE);
   iconv_t cd = (iconv_t) (-1);
 
+#if defined(HAVE_PTHREAD_CREATE) && defined(HAVE_FMEMOPEN)
+  if (predecode_take(b, s))
+    return;
+#endif
+
   if (!mutt_file_seek(s->fp_in, b->offset, SEEK_SET))
   {
     return;
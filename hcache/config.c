@@ -127,6 +127,12 @@ static struct ConfigDef HcacheVars[] = {
   { "header_cache_backend", DT_STRING, 0, 0, hcache_validator,
     "(hcache) Header cache backend to use"
   },
+  { "header_cache_gc", DT_BOOL, false, 0, NULL,
+    "(hcache) Sweep records for vanished messages when a mailbox is synced"
+  },
+  { "header_cache_writebehind", DT_BOOL, false, 0, NULL,
+    "(hcache) Store header cache records from a background thread"
+  },
   { NULL },
   // clang-format on
 };
@@ -141,6 +147,9 @@ static struct ConfigDef HcacheVarsComp[] = {
   { "header_cache_compress_level", DT_NUMBER|DT_NOT_NEGATIVE, 1, 0, compress_level_validator,
     "(hcache) Level of compression for method"
   },
+  { "header_cache_compress_dictionary", DT_BOOL, false, 0, NULL,
+    "(hcache) Train a shared dictionary over the records, if method supports it"
+  },
   { NULL },
   // clang-format on
 };
@@ -164,6 +173,48 @@ static struct ConfigDef HcacheVarsPage[] = {
 };
 #endif
 
+#if defined(HAVE_ROCKSDB)
+/**
+ * rocksdb_compression_validator - Validate the "header_cache_rocksdb_compression" config variable - Implements ConfigDef::validator() - @ingroup cfg_def_validator
+ */
+static int rocksdb_compression_validator(const struct ConfigSet *cs,
+                                         const struct ConfigDef *cdef,
+                                         intptr_t value, struct Buffer *err)
+{
+  if (value == 0)
+    return CSR_SUCCESS;
+
+  const char *str = (const char *) value;
+
+  static const char *methods[] = {
+    "none", "snappy", "zlib", "bzip2", "lz4", "lz4hc", "xpress", "zstd",
+  };
+  for (size_t i = 0; i < mutt_array_size(methods); i++)
+  {
+    if (mutt_istr_equal(str, methods[i]))
+      return CSR_SUCCESS;
+  }
+
+  mutt_buffer_printf(err, _("Invalid value for option %s: %s"), cdef->name, str);
+  return CSR_ERR_INVALID;
+}
+
+static struct ConfigDef HcacheVarsRocksdb[] = {
+  // clang-format off
+  { "header_cache_rocksdb_block_cache_size", DT_LONG|DT_NOT_NEGATIVE, 33554432, 0, NULL,
+    "(hcache) Size of the RocksDB block cache in bytes"
+  },
+  { "header_cache_rocksdb_bloom_bits", DT_NUMBER|DT_NOT_NEGATIVE, 10, 0, NULL,
+    "(hcache) Bloom filter bits per key for RocksDB (0 to disable)"
+  },
+  { "header_cache_rocksdb_compression", DT_STRING, 0, 0, rocksdb_compression_validator,
+    "(hcache) Compression method for RocksDB data blocks"
+  },
+  { NULL },
+  // clang-format on
+};
+#endif
+
 /**
  * config_init_hcache - Register hcache config variables - Implements ::module_init_config_t - @ingroup cfg_module_api
  */
@@ -187,5 +238,9 @@ bool config_init_hcache(struct ConfigSet *cs)
   rc |= cs_register_variables(cs, HcacheVarsPage, 0);
 #endif
 
+#if defined(HAVE_ROCKSDB)
+  rc |= cs_register_variables(cs, HcacheVarsRocksdb, 0);
+#endif
+
   return rc;
 }
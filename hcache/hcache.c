@@ -43,6 +43,9 @@
 #include <string.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 #include "mutt/lib.h"
 #include "config/lib.h"
 #include "email/lib.h"
@@ -51,8 +54,11 @@
 #include "compress/lib.h"
 #include "store/lib.h"
 #include "hcache/hcversion.h"
+#include "alternates.h"
+#include "attach/lib.h"
 #include "muttlib.h"
 #include "serialize.h"
+#include "subjectrx.h"
 
 #if !(defined(HAVE_BDB) || defined(HAVE_GDBM) || defined(HAVE_KC) ||           \
       defined(HAVE_LMDB) || defined(HAVE_QDBM) || defined(HAVE_ROCKSDB) ||     \
@@ -62,6 +68,220 @@
 
 static unsigned int hcachever = 0x0;
 
+#ifdef USE_HCACHE_COMPRESSION
+/// Raw key under which a trained compression dictionary is persisted
+#define HCACHE_DICT_KEY "compress-dictionary"
+#endif
+
+#ifdef HAVE_PTHREAD_CREATE
+/// Maximum number of records waiting in the write-behind queue
+#define HCACHE_WRITE_MAX 512
+/// Number of queued records drained per wakeup of the flusher thread
+#define HCACHE_WRITE_BATCH 32
+
+/**
+ * struct HcacheWrite - One record waiting in the write-behind queue
+ */
+struct HcacheWrite
+{
+  char *key;                         ///< Folder-prefixed key (owned)
+  size_t klen;                       ///< Length of the key
+  void *data;                        ///< Serialised email (owned)
+  size_t dlen;                       ///< Length of the data
+  STAILQ_ENTRY(HcacheWrite) entries; ///< Linked list
+};
+STAILQ_HEAD(HcacheWriteList, HcacheWrite);
+
+/**
+ * struct HcacheWriteQueue - Write-behind queue of one HeaderCache
+ *
+ * mutt_hcache_store() enqueues records here and returns immediately; a
+ * flusher thread drains them into the store in batches.  The queue is
+ * bounded, so a producer that outruns the store blocks rather than eating
+ * memory.  mutt_hcache_close(), mutt_hcache_delete_record() and the fetch
+ * functions all act as flush barriers: backends may cache transaction state
+ * in their context (e.g. lmdb keeps one MDB_txn), so the flusher must be
+ * idle before another thread touches the store.
+ */
+struct HcacheWriteQueue
+{
+  pthread_t thread;             ///< Flusher thread
+  pthread_mutex_t mutex;        ///< Protects all the fields below
+  pthread_cond_t work;          ///< Records were queued, or stop was set
+  pthread_cond_t room;          ///< The flusher freed space in the queue
+  struct HcacheWriteList list;  ///< Queued records
+  size_t len;                   ///< Number of queued records
+  size_t inflight;              ///< Records removed but not yet stored
+  bool stop;                    ///< Tell the flusher to finish up
+  void *store_ctx;              ///< Backend handle, StoreOps::open()
+  const struct StoreOps *ops;   ///< Store backend
+  int rc;                       ///< First error from StoreOps::store()
+};
+
+/**
+ * hcache_write_main - Flusher thread for a write-behind queue
+ * @param arg HcacheWriteQueue to drain
+ * @retval NULL Always
+ */
+static void *hcache_write_main(void *arg)
+{
+  struct HcacheWriteQueue *wq = arg;
+
+  pthread_mutex_lock(&wq->mutex);
+  while (true)
+  {
+    while ((wq->len == 0) && !wq->stop)
+      pthread_cond_wait(&wq->work, &wq->mutex);
+    if (wq->len == 0)
+      break; // stop was set and the queue is drained
+
+    struct HcacheWriteList batch = STAILQ_HEAD_INITIALIZER(batch);
+    size_t num = 0;
+    while ((num < HCACHE_WRITE_BATCH) && !STAILQ_EMPTY(&wq->list))
+    {
+      struct HcacheWrite *hw = STAILQ_FIRST(&wq->list);
+      STAILQ_REMOVE_HEAD(&wq->list, entries);
+      STAILQ_INSERT_TAIL(&batch, hw, entries);
+      num++;
+    }
+    wq->len -= num;
+    wq->inflight = num;
+    pthread_cond_broadcast(&wq->room);
+    pthread_mutex_unlock(&wq->mutex);
+
+    int rc = 0;
+    /* group the batch into one backend transaction where supported */
+    const bool txn = wq->ops->txn_begin &&
+                     (wq->ops->txn_begin(wq->store_ctx) == 0);
+    struct HcacheWrite *hw = NULL, *tmp = NULL;
+    STAILQ_FOREACH_SAFE(hw, &batch, entries, tmp)
+    {
+      int rc2 = wq->ops->store(wq->store_ctx, hw->key, hw->klen, hw->data, hw->dlen);
+      if (rc == 0)
+        rc = rc2;
+      FREE(&hw->key);
+      FREE(&hw->data);
+      FREE(&hw);
+    }
+    if (txn)
+    {
+      int rc2 = wq->ops->txn_commit(wq->store_ctx);
+      if (rc == 0)
+        rc = rc2;
+    }
+
+    pthread_mutex_lock(&wq->mutex);
+    if (wq->rc == 0)
+      wq->rc = rc;
+    wq->inflight = 0;
+    pthread_cond_broadcast(&wq->room);
+  }
+  pthread_mutex_unlock(&wq->mutex);
+  return NULL;
+}
+
+/**
+ * hcache_wq_new - Create a write-behind queue with its flusher thread
+ * @param store_ctx Backend handle from StoreOps::open()
+ * @param ops       Store backend
+ * @retval ptr  New queue
+ * @retval NULL The thread couldn't be created; store synchronously instead
+ */
+static struct HcacheWriteQueue *hcache_wq_new(void *store_ctx, const struct StoreOps *ops)
+{
+  struct HcacheWriteQueue *wq = mutt_mem_calloc(1, sizeof(struct HcacheWriteQueue));
+  STAILQ_INIT(&wq->list);
+  wq->store_ctx = store_ctx;
+  wq->ops = ops;
+  pthread_mutex_init(&wq->mutex, NULL);
+  pthread_cond_init(&wq->work, NULL);
+  pthread_cond_init(&wq->room, NULL);
+
+  if (pthread_create(&wq->thread, NULL, hcache_write_main, wq) != 0)
+  {
+    pthread_cond_destroy(&wq->room);
+    pthread_cond_destroy(&wq->work);
+    pthread_mutex_destroy(&wq->mutex);
+    FREE(&wq);
+  }
+  return wq;
+}
+
+/**
+ * hcache_wq_push - Queue one record for storing
+ * @param wq   Write-behind queue
+ * @param key  Folder-prefixed key (copied)
+ * @param klen Length of the key
+ * @param data Serialised email (copied)
+ * @param dlen Length of the data
+ * @retval 0   Success
+ * @retval num A previously queued store failed with this error code
+ *
+ * Blocks while the queue is full.
+ */
+static int hcache_wq_push(struct HcacheWriteQueue *wq, const char *key,
+                          size_t klen, void *data, size_t dlen)
+{
+  struct HcacheWrite *hw = mutt_mem_calloc(1, sizeof(struct HcacheWrite));
+  hw->key = mutt_strn_dup(key, klen);
+  hw->klen = klen;
+  hw->dlen = dlen;
+  if (dlen != 0)
+  {
+    hw->data = mutt_mem_malloc(dlen);
+    memcpy(hw->data, data, dlen);
+  }
+
+  pthread_mutex_lock(&wq->mutex);
+  while (wq->len >= HCACHE_WRITE_MAX)
+    pthread_cond_wait(&wq->room, &wq->mutex);
+  STAILQ_INSERT_TAIL(&wq->list, hw, entries);
+  wq->len++;
+  int rc = wq->rc;
+  pthread_cond_signal(&wq->work);
+  pthread_mutex_unlock(&wq->mutex);
+  return rc;
+}
+
+/**
+ * hcache_wq_drain - Wait until every queued record has been stored
+ * @param wq Write-behind queue
+ */
+static void hcache_wq_drain(struct HcacheWriteQueue *wq)
+{
+  pthread_mutex_lock(&wq->mutex);
+  while ((wq->len != 0) || (wq->inflight != 0))
+    pthread_cond_wait(&wq->room, &wq->mutex);
+  pthread_mutex_unlock(&wq->mutex);
+}
+
+/**
+ * hcache_wq_free - Flush a write-behind queue and free it
+ * @param[out] ptr Queue to free
+ *
+ * Acts as a flush barrier: the flusher thread stores everything still queued
+ * before it is joined.
+ */
+static void hcache_wq_free(struct HcacheWriteQueue **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct HcacheWriteQueue *wq = *ptr;
+
+  pthread_mutex_lock(&wq->mutex);
+  wq->stop = true;
+  pthread_cond_broadcast(&wq->work);
+  pthread_mutex_unlock(&wq->mutex);
+  pthread_join(wq->thread, NULL);
+
+  pthread_cond_destroy(&wq->room);
+  pthread_cond_destroy(&wq->work);
+  pthread_mutex_destroy(&wq->mutex);
+  FREE(ptr);
+}
+#endif /* HAVE_PTHREAD_CREATE */
+
 /**
  * header_size - Compute the size of the header with uuid validity and crc
  * @retval num Size of the header
@@ -108,9 +328,14 @@ static void *dump(struct HeaderCache *hc, const struct Email *e, int *off, uint3
   e_dump.collapsed = false;
   e_dump.visible = true;
   e_dump.num_hidden = 0;
+  e_dump.thread_unread = -1;
   e_dump.recipient = 0;
   e_dump.attr_color = NULL;
-  e_dump.attach_valid = false;
+  e_dump.author_color = NULL;
+  e_dump.flags_color = NULL;
+  e_dump.subject_color = NULL;
+  e_dump.index_color_valid = false;
+  e_dump.display = NULL;
   e_dump.path = NULL;
   e_dump.tree = NULL;
   e_dump.thread = NULL;
@@ -329,6 +554,38 @@ static char *get_foldername(const char *folder)
   return p;
 }
 
+#ifdef USE_HCACHE_COMPRESSION
+/**
+ * hcache_dict_load - Load a persisted compression dictionary, if there is one
+ * @param hc Header cache handle
+ *
+ * The dictionary is stored in the cache itself, under #HCACHE_DICT_KEY, by
+ * mutt_hcache_store() when the backend finishes training one.
+ */
+static void hcache_dict_load(struct HeaderCache *hc)
+{
+  const char *const c_header_cache_compress_method =
+      cs_subset_string(NeoMutt->sub, "header_cache_compress_method");
+  const bool c_header_cache_compress_dictionary =
+      cs_subset_bool(NeoMutt->sub, "header_cache_compress_dictionary");
+  if (!c_header_cache_compress_method || !c_header_cache_compress_dictionary)
+    return;
+
+  const struct ComprOps *cops = compress_get_ops(c_header_cache_compress_method);
+  if (!cops->load_dict)
+    return;
+
+  size_t dlen = 0;
+  void *dict = mutt_hcache_fetch_raw(hc, HCACHE_DICT_KEY, mutt_str_len(HCACHE_DICT_KEY), &dlen);
+  if (!dict)
+    return;
+
+  if (cops->load_dict(hc->cctx, dict, dlen))
+    mutt_debug(LL_DEBUG2, "loaded %s dictionary, %zu bytes\n", cops->name, dlen);
+  mutt_hcache_free_raw(hc, &dict);
+}
+#endif
+
 /**
  * mutt_hcache_open - Multiplexor for StoreOps::open
  */
@@ -374,6 +631,26 @@ struct HeaderCache *mutt_hcache_open(const char *path, const char *folder, hcach
       mutt_md5_process(np->regex->pattern, &md5ctx);
     }
 
+    /* Mix in the settings behind the cached display strings,
+     * Envelope::disp_subj and Envelope::disp_author */
+    subjrx_fingerprint(&md5ctx);
+    mutt_alternates_fingerprint(&md5ctx);
+    STAILQ_FOREACH(np, &MailLists, entries)
+    {
+      mutt_md5_process(np->regex->pattern, &md5ctx);
+    }
+    STAILQ_FOREACH(np, &SubscribedLists, entries)
+    {
+      mutt_md5_process(np->regex->pattern, &md5ctx);
+    }
+    const struct MbTable *c_from_chars = cs_subset_mbtable(NeoMutt->sub, "from_chars");
+    if (c_from_chars && c_from_chars->orig_str)
+      mutt_md5_process(c_from_chars->orig_str, &md5ctx);
+
+    /* Mix in the settings behind the cached attachment counts,
+     * Email::attach_total */
+    mutt_attachments_fingerprint(&md5ctx);
+
     /* Get a hash and take its bytes as an (unsigned int) hash version */
     mutt_md5_finish_ctx(&md5ctx, digest.charval);
     hcachever = digest.intval;
@@ -428,10 +705,110 @@ struct HeaderCache *mutt_hcache_open(const char *path, const char *folder, hcach
     }
   }
 
+#ifdef HAVE_PTHREAD_CREATE
+  const bool c_header_cache_writebehind =
+      cs_subset_bool(NeoMutt->sub, "header_cache_writebehind");
+  if (hc && hc->ctx && c_header_cache_writebehind)
+    hc->wq = hcache_wq_new(hc->ctx, ops);
+#endif
+
+#ifdef USE_HCACHE_COMPRESSION
+  if (hc && hc->ctx)
+    hcache_dict_load(hc);
+#endif
+
   mutt_buffer_pool_release(&hcpath);
   return hc;
 }
 
+/**
+ * struct HcacheOpenRequest - An in-progress background mutt_hcache_open()
+ */
+struct HcacheOpenRequest
+{
+  char *path;             ///< Location of the store, see mutt_hcache_open()
+  char *folder;           ///< Name of the folder, see mutt_hcache_open()
+  hcache_namer_t namer;   ///< How to name the store file
+  struct HeaderCache *hc; ///< Result of the open
+#ifdef HAVE_PTHREAD_CREATE
+  pthread_t thread;       ///< Thread performing the open
+  bool threaded;          ///< Thread was created; join it before reading hc
+#endif
+};
+
+#ifdef HAVE_PTHREAD_CREATE
+/**
+ * hcache_open_main - Open a header cache - Implements pthread main
+ */
+static void *hcache_open_main(void *arg)
+{
+  struct HcacheOpenRequest *req = arg;
+  req->hc = mutt_hcache_open(req->path, req->folder, req->namer);
+  return NULL;
+}
+#endif
+
+/**
+ * mutt_hcache_open_bg - Start opening a header cache in the background
+ * @param path   Location of the header cache (often as specified by the user)
+ * @param folder Name of the folder containing the messages
+ * @param namer  Optional (might be NULL) client-specific function to form the
+ *               final name of the hcache database file.
+ * @retval ptr Request token, to be redeemed with mutt_hcache_open_join()
+ *
+ * Opening a store can be slow - some backends replay a journal or compact
+ * on open.  Starting the open early and joining just before the first fetch
+ * hides that latency behind other work, e.g. scanning the folder's
+ * directory.  Between the two calls the caller must not change any
+ * configuration that mutt_hcache_open() reads, and must not open another
+ * header cache.
+ */
+struct HcacheOpenRequest *mutt_hcache_open_bg(const char *path, const char *folder,
+                                              hcache_namer_t namer)
+{
+  struct HcacheOpenRequest *req = mutt_mem_calloc(1, sizeof(struct HcacheOpenRequest));
+  req->path = mutt_str_dup(path);
+  req->folder = mutt_str_dup(folder);
+  req->namer = namer;
+
+#ifdef HAVE_PTHREAD_CREATE
+  if (path && (path[0] != '\0'))
+  {
+    req->threaded = (pthread_create(&req->thread, NULL, hcache_open_main, req) == 0);
+    if (req->threaded)
+      return req;
+  }
+#endif
+
+  req->hc = mutt_hcache_open(req->path, req->folder, req->namer);
+  return req;
+}
+
+/**
+ * mutt_hcache_open_join - Collect the result of mutt_hcache_open_bg()
+ * @param ptr Request token from mutt_hcache_open_bg()
+ * @retval ptr  Success, struct HeaderCache struct
+ * @retval NULL Failure, see mutt_hcache_open()
+ */
+struct HeaderCache *mutt_hcache_open_join(struct HcacheOpenRequest **ptr)
+{
+  if (!ptr || !*ptr)
+    return NULL;
+
+  struct HcacheOpenRequest *req = *ptr;
+
+#ifdef HAVE_PTHREAD_CREATE
+  if (req->threaded)
+    pthread_join(req->thread, NULL);
+#endif
+
+  struct HeaderCache *hc = req->hc;
+  FREE(&req->path);
+  FREE(&req->folder);
+  FREE(ptr);
+  return hc;
+}
+
 /**
  * mutt_hcache_close - Multiplexor for StoreOps::close
  */
@@ -453,28 +830,32 @@ void mutt_hcache_close(struct HeaderCache *hc)
   }
 #endif
 
+#ifdef HAVE_PTHREAD_CREATE
+  /* Flush barrier: everything still queued is stored before the backend
+   * is closed */
+  struct HcacheWriteQueue *wq = hc->wq;
+  hcache_wq_free(&wq);
+  hc->wq = NULL;
+#endif
+
   ops->close(&hc->ctx);
   FREE(&hc->folder);
   FREE(&hc);
 }
 
 /**
- * mutt_hcache_fetch - Multiplexor for StoreOps::fetch
+ * hcache_decode - Validate and deserialise a fetched blob
+ * @param hc          Header cache handle
+ * @param data        Blob fetched from the store
+ * @param dlen        Length of the blob
+ * @param uidvalidity Only restore if it matches the stored uidvalidity (0 to skip)
+ * @retval obj HCacheEntry, with a restored Email on success
  */
-struct HCacheEntry mutt_hcache_fetch(struct HeaderCache *hc, const char *key,
-                                     size_t keylen, uint32_t uidvalidity)
+static struct HCacheEntry hcache_decode(struct HeaderCache *hc, void *data,
+                                        size_t dlen, uint32_t uidvalidity)
 {
-  struct RealKey *rk = realkey(key, keylen);
   struct HCacheEntry entry = { 0 };
 
-  size_t dlen;
-  void *data = mutt_hcache_fetch_raw(hc, rk->key, rk->len, &dlen);
-  void *to_free = data;
-  if (!data)
-  {
-    goto end;
-  }
-
   /* restore uidvalidity and crc */
   size_t hlen = header_size();
   int off = 0;
@@ -483,7 +864,7 @@ struct HCacheEntry mutt_hcache_fetch(struct HeaderCache *hc, const char *key,
   assert((size_t) off == hlen);
   if (entry.crc != hc->crc || ((uidvalidity != 0) && uidvalidity != entry.uidvalidity))
   {
-    goto end;
+    return entry;
   }
 
 #ifdef USE_HCACHE_COMPRESSION
@@ -496,19 +877,124 @@ struct HCacheEntry mutt_hcache_fetch(struct HeaderCache *hc, const char *key,
     void *dblob = cops->decompress(hc->cctx, (char *) data + hlen, dlen - hlen);
     if (!dblob)
     {
-      goto end;
+      return entry;
     }
     data = (char *) dblob - hlen; /* restore skips uidvalidity and crc */
   }
 #endif
 
   entry.email = restore(data);
+  return entry;
+}
+
+/**
+ * mutt_hcache_fetch - Multiplexor for StoreOps::fetch
+ */
+struct HCacheEntry mutt_hcache_fetch(struct HeaderCache *hc, const char *key,
+                                     size_t keylen, uint32_t uidvalidity)
+{
+  struct RealKey *rk = realkey(key, keylen);
+  struct HCacheEntry entry = { 0 };
+
+  size_t dlen;
+  void *data = mutt_hcache_fetch_raw(hc, rk->key, rk->len, &dlen);
+  if (!data)
+    return entry;
 
-end:
-  mutt_hcache_free_raw(hc, &to_free);
+  entry = hcache_decode(hc, data, dlen, uidvalidity);
+  mutt_hcache_free_raw(hc, &data);
   return entry;
 }
 
+/**
+ * mutt_hcache_fetch_batch - Fetch and validate many messages' headers at once
+ * @param[in]  hc          Pointer to the struct HeaderCache structure got by mutt_hcache_open()
+ * @param[in]  keys        Array of message identification strings (NULL entries are skipped)
+ * @param[in]  keylens     Array of lengths of the strings pointed to by keys
+ * @param[in]  uidvalidity Only restore if it matches the stored uidvalidity (0 to skip)
+ * @param[out] entries     Array of count HCacheEntry to be filled in
+ * @retval  0 Success
+ * @retval -1 Failure
+ *
+ * All the keys are looked up in a single store transaction, via
+ * StoreOps::fetch_batch if the backend provides it.  Misses (and NULL keys)
+ * leave their HCacheEntry empty.
+ */
+int mutt_hcache_fetch_batch(struct HeaderCache *hc, const char **keys,
+                            const size_t *keylens, uint32_t uidvalidity,
+                            struct HCacheEntry *entries, size_t count)
+{
+  memset(entries, 0, count * sizeof(struct HCacheEntry));
+
+  const char *const c_header_cache_backend =
+      cs_subset_string(NeoMutt->sub, "header_cache_backend");
+  const struct StoreOps *ops = store_get_backend_ops(c_header_cache_backend);
+
+  if (!hc || !ops)
+    return -1;
+
+  const char **fullkeys = mutt_mem_calloc(count, sizeof(char *));
+  size_t *fullklens = mutt_mem_calloc(count, sizeof(size_t));
+  struct Buffer *paths = mutt_mem_calloc(count, sizeof(struct Buffer));
+
+  for (size_t i = 0; i < count; i++)
+  {
+    if (!keys[i])
+      continue;
+
+    struct RealKey *rk = realkey(keys[i], keylens[i]);
+    paths[i] = mutt_buffer_make(1024);
+    fullklens[i] = mutt_buffer_printf(&paths[i], "%s%.*s", hc->folder,
+                                      (int) rk->len, rk->key);
+    fullkeys[i] = mutt_buffer_string(&paths[i]);
+  }
+
+  void **values = mutt_mem_calloc(count, sizeof(void *));
+  size_t *vlens = mutt_mem_calloc(count, sizeof(size_t));
+
+#ifdef HAVE_PTHREAD_CREATE
+  /* Flush barrier: the store's transaction state isn't shareable with the
+   * flusher thread */
+  if (hc->wq)
+    hcache_wq_drain(hc->wq);
+#endif
+
+  int rc = 0;
+  if (ops->fetch_batch)
+  {
+    if (ops->fetch_batch(hc->ctx, fullkeys, fullklens, values, vlens, count) != 0)
+      rc = -1;
+  }
+  else
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      if (fullkeys[i])
+        values[i] = ops->fetch(hc->ctx, fullkeys[i], fullklens[i], &vlens[i]);
+    }
+  }
+
+  if (rc == 0)
+  {
+    for (size_t i = 0; i < count; i++)
+    {
+      if (!values[i])
+        continue;
+      entries[i] = hcache_decode(hc, values[i], vlens[i], uidvalidity);
+      ops->free(hc->ctx, &values[i]);
+    }
+  }
+
+  for (size_t i = 0; i < count; i++)
+    mutt_buffer_dealloc(&paths[i]);
+  FREE(&paths);
+  FREE(&fullkeys);
+  FREE(&fullklens);
+  FREE(&values);
+  FREE(&vlens);
+  return rc;
+}
+
 /**
  * mutt_hcache_fetch_raw - Fetch a message's header from the cache
  * @param[in]  hc     Pointer to the struct HeaderCache structure got by mutt_hcache_open()
@@ -531,6 +1017,13 @@ void *mutt_hcache_fetch_raw(struct HeaderCache *hc, const char *key,
   if (!hc || !ops)
     return NULL;
 
+#ifdef HAVE_PTHREAD_CREATE
+  /* Flush barrier: the store's transaction state isn't shareable with the
+   * flusher thread */
+  if (hc->wq)
+    hcache_wq_drain(hc->wq);
+#endif
+
   struct Buffer path = mutt_buffer_make(1024);
   keylen = mutt_buffer_printf(&path, "%s%.*s", hc->folder, (int) keylen, key);
   void *blob = ops->fetch(hc->ctx, mutt_buffer_string(&path), keylen, dlen);
@@ -576,6 +1069,18 @@ int mutt_hcache_store(struct HeaderCache *hc, const char *key, size_t keylen,
 
     const struct ComprOps *cops = compress_get_ops(c_header_cache_compress_method);
 
+    const bool c_header_cache_compress_dictionary =
+        cs_subset_bool(NeoMutt->sub, "header_cache_compress_dictionary");
+    if (c_header_cache_compress_dictionary && cops->learn &&
+        cops->learn(hc->cctx, data + hlen, dlen - hlen))
+    {
+      /* training just finished - persist the dictionary for the next session */
+      size_t dict_len = 0;
+      void *dict = cops->serialize_dict(hc->cctx, &dict_len);
+      if (dict)
+        mutt_hcache_store_raw(hc, HCACHE_DICT_KEY, mutt_str_len(HCACHE_DICT_KEY), dict, dict_len);
+    }
+
     /* data / dlen gets ptr to compressed data here */
     size_t clen = dlen;
     void *cdata = cops->compress(hc->cctx, data + hlen, dlen - hlen, &clen);
@@ -628,12 +1133,136 @@ int mutt_hcache_store_raw(struct HeaderCache *hc, const char *key,
   struct Buffer path = mutt_buffer_make(1024);
 
   keylen = mutt_buffer_printf(&path, "%s%.*s", hc->folder, (int) keylen, key);
-  int rc = ops->store(hc->ctx, mutt_buffer_string(&path), keylen, data, dlen);
+
+  int rc;
+#ifdef HAVE_PTHREAD_CREATE
+  if (hc->wq)
+    rc = hcache_wq_push(hc->wq, mutt_buffer_string(&path), keylen, data, dlen);
+  else
+#endif
+    rc = ops->store(hc->ctx, mutt_buffer_string(&path), keylen, data, dlen);
   mutt_buffer_dealloc(&path);
 
   return rc;
 }
 
+/**
+ * struct HcacheGc - State for one garbage collection sweep
+ */
+struct HcacheGc
+{
+  struct HeaderCache *hc; ///< Cache being swept
+  size_t folder_len;      ///< Length of HeaderCache.folder
+  struct HashTable *live; ///< Full keys that must survive
+  struct ListHead doomed; ///< Full keys to delete after the walk
+};
+
+/**
+ * hcache_gc_cb - Collect this folder's stale keys - Implements ::store_foreach_t - @ingroup store_foreach_api
+ *
+ * Deleting during the walk isn't allowed, so doomed keys are collected and
+ * deleted afterwards.
+ */
+static int hcache_gc_cb(const char *key, size_t klen, void *data)
+{
+  struct HcacheGc *gc = data;
+
+  /* one database may hold several folders' records; only sweep ours */
+  if ((klen <= gc->folder_len) || !mutt_strn_equal(key, gc->hc->folder, gc->folder_len))
+    return 0;
+
+  char *fullkey = mutt_strn_dup(key, klen);
+  if (mutt_hash_find_elem(gc->live, fullkey))
+    FREE(&fullkey);
+  else
+    mutt_list_insert_tail(&gc->doomed, fullkey);
+
+  return 0;
+}
+
+/**
+ * mutt_hcache_gc - Delete records that no longer match a live message
+ * @param hc      Pointer to the struct HeaderCache structure got by mutt_hcache_open()
+ * @param keys    Array of live message identification strings
+ * @param keylens Array of lengths of the strings pointed to by keys
+ * @param count   Number of entries in keys
+ * @retval num Number of records deleted
+ * @retval -1  The backend can't enumerate keys, or the walk failed
+ *
+ * Messages removed behind NeoMutt's back leave their records in the cache,
+ * and the database file only ever grows.  Walk every key under this cache's
+ * folder prefix and delete the ones that aren't in @a keys.  Requires a
+ * backend with StoreOps::foreach().
+ */
+int mutt_hcache_gc(struct HeaderCache *hc, const char **keys,
+                   const size_t *keylens, size_t count)
+{
+  const char *const c_header_cache_backend =
+      cs_subset_string(NeoMutt->sub, "header_cache_backend");
+  const struct StoreOps *ops = store_get_backend_ops(c_header_cache_backend);
+
+  if (!hc || !ops || !ops->foreach)
+    return -1;
+
+#ifdef HAVE_PTHREAD_CREATE
+  /* queued stores must land before the walk, or their keys look stale */
+  if (hc->wq)
+    hcache_wq_drain(hc->wq);
+#endif
+
+  struct HcacheGc gc = { hc, mutt_str_len(hc->folder), NULL, { 0 } };
+  STAILQ_INIT(&gc.doomed);
+  gc.live = mutt_hash_new(2 * count + 8, MUTT_HASH_STRDUP_KEYS);
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  for (size_t i = 0; i < count; i++)
+  {
+    if (!keys[i])
+      continue;
+
+    mutt_buffer_printf(path, "%s%.*s", hc->folder, (int) keylens[i], keys[i]);
+    mutt_hash_insert(gc.live, mutt_buffer_string(path), hc);
+
+    /* the stored form may carry the compression method suffix */
+    struct RealKey *rk = realkey(keys[i], keylens[i]);
+    if (rk->len != keylens[i])
+    {
+      mutt_buffer_printf(path, "%s%.*s", hc->folder, (int) rk->len, rk->key);
+      mutt_hash_insert(gc.live, mutt_buffer_string(path), hc);
+    }
+  }
+
+#ifdef USE_HCACHE_COMPRESSION
+  /* the persisted dictionary is not a message record */
+  mutt_buffer_printf(path, "%s%s", hc->folder, HCACHE_DICT_KEY);
+  mutt_hash_insert(gc.live, mutt_buffer_string(path), hc);
+#endif
+  mutt_buffer_pool_release(&path);
+
+  int deleted = -1;
+  if (ops->foreach(hc->ctx, hcache_gc_cb, &gc) == 0)
+  {
+    deleted = 0;
+    /* group the deletions into one backend transaction where supported */
+    const bool txn = ops->txn_begin && (ops->txn_begin(hc->ctx) == 0);
+    struct ListNode *np = NULL;
+    STAILQ_FOREACH(np, &gc.doomed, entries)
+    {
+      if (ops->delete_record(hc->ctx, np->data, mutt_str_len(np->data)) == 0)
+        deleted++;
+    }
+    if (txn)
+      ops->txn_commit(hc->ctx);
+
+    mutt_debug(LL_DEBUG2, "hcache gc: swept %d stale records from %s\n",
+               deleted, hc->folder);
+  }
+
+  mutt_list_free(&gc.doomed);
+  mutt_hash_free(&gc.live);
+  return deleted;
+}
+
 /**
  * mutt_hcache_delete_record - Multiplexor for StoreOps::delete_record
  */
@@ -646,6 +1275,12 @@ int mutt_hcache_delete_record(struct HeaderCache *hc, const char *key, size_t ke
       cs_subset_string(NeoMutt->sub, "header_cache_backend");
   const struct StoreOps *ops = store_get_backend_ops(c_header_cache_backend);
 
+#ifdef HAVE_PTHREAD_CREATE
+  /* Don't delete ahead of a store for the same key that's still queued */
+  if (hc->wq)
+    hcache_wq_drain(hc->wq);
+#endif
+
   struct Buffer path = mutt_buffer_make(1024);
 
   keylen = mutt_buffer_printf(&path, "%s%s", hc->folder, key);
@@ -89,6 +89,7 @@ struct HeaderCache
   unsigned int crc; ///< CRC of the cache entry
   void *ctx;        ///< Store context (handle)
   void *cctx;       ///< Compression context (handle)
+  void *wq;         ///< Write-behind queue, if $header_cache_writebehind is set
 };
 
 /**
@@ -122,6 +123,29 @@ typedef void (*hcache_namer_t)(const char *path, struct Buffer *dest);
  */
 struct HeaderCache *mutt_hcache_open(const char *path, const char *folder, hcache_namer_t namer);
 
+struct HcacheOpenRequest;
+
+/**
+ * mutt_hcache_open_bg - Start opening a header cache in the background
+ * @param path   Location of the header cache (often as specified by the user)
+ * @param folder Name of the folder containing the messages
+ * @param namer  Optional (might be NULL) client-specific function to form the
+ *               final name of the hcache database file.
+ * @retval ptr Request token, to be redeemed with mutt_hcache_open_join()
+ *
+ * The open runs on a thread so that it can overlap with other work, e.g.
+ * scanning the folder.  Every request must be joined, even on error paths.
+ */
+struct HcacheOpenRequest *mutt_hcache_open_bg(const char *path, const char *folder, hcache_namer_t namer);
+
+/**
+ * mutt_hcache_open_join - Collect the result of mutt_hcache_open_bg()
+ * @param ptr Request token from mutt_hcache_open_bg()
+ * @retval ptr  Success, struct HeaderCache struct
+ * @retval NULL Failure, see mutt_hcache_open()
+ */
+struct HeaderCache *mutt_hcache_open_join(struct HcacheOpenRequest **ptr);
+
 /**
  * mutt_hcache_close - Close the connection to the header cache
  * @param hc Pointer to the struct HeaderCache structure got by mutt_hcache_open()
@@ -154,6 +178,24 @@ int mutt_hcache_store(struct HeaderCache *hc, const char *key, size_t keylen,
  */
 struct HCacheEntry mutt_hcache_fetch(struct HeaderCache *hc, const char *key, size_t keylen, uint32_t uidvalidity);
 
+/**
+ * mutt_hcache_fetch_batch - Fetch and validate many messages' headers at once
+ * @param[in]  hc          Pointer to the struct HeaderCache structure got by mutt_hcache_open()
+ * @param[in]  keys        Array of message identification strings (NULL entries are skipped)
+ * @param[in]  keylens     Array of lengths of the strings pointed to by keys
+ * @param[in]  uidvalidity Only restore if it matches the stored uidvalidity (0 to skip)
+ * @param[out] entries     Array of count HCacheEntry to be filled in
+ * @param[in]  count       Number of keys
+ * @retval  0 Success
+ * @retval -1 Failure
+ *
+ * Looks up all the keys in a single store transaction, where the backend
+ * supports it.  Misses (and NULL keys) leave their HCacheEntry empty.
+ */
+int mutt_hcache_fetch_batch(struct HeaderCache *hc, const char **keys,
+                            const size_t *keylens, uint32_t uidvalidity,
+                            struct HCacheEntry *entries, size_t count);
+
 int mutt_hcache_store_raw(struct HeaderCache *hc, const char *key, size_t keylen,
                           void *data, size_t dlen);
 
@@ -176,4 +218,15 @@ void mutt_hcache_free_raw(struct HeaderCache *hc, void **data);
  */
 int mutt_hcache_delete_record(struct HeaderCache *hc, const char *key, size_t keylen);
 
+/**
+ * mutt_hcache_gc - Delete records that no longer match a live message
+ * @param hc      Pointer to the struct HeaderCache structure got by mutt_hcache_open()
+ * @param keys    Array of live message identification strings
+ * @param keylens Array of lengths of the strings pointed to by keys
+ * @param count   Number of entries in keys
+ * @retval num Number of records deleted
+ * @retval -1  The backend can't enumerate keys, or the walk failed
+ */
+int mutt_hcache_gc(struct HeaderCache *hc, const char **keys, const size_t *keylens, size_t count);
+
 #endif /* MUTT_HCACHE_LIB_H */
@@ -45,7 +45,10 @@
  * @param ptr Pointer to resize
  * @param size Minimum size
  *
- * The minimum size is 4KiB to avoid repeated resizing.
+ * The minimum size is 4KiB to avoid repeated resizing.  Above that, the
+ * allocation is rounded up to the next power of two: records are packed one
+ * field at a time, and growing geometrically keeps a long run of appends
+ * within one allocation instead of realloc'ing per field.
  */
 void lazy_realloc(void *ptr, size_t size)
 {
@@ -54,7 +57,11 @@ void lazy_realloc(void *ptr, size_t size)
   if (p && (size < 4096))
     return;
 
-  mutt_mem_realloc(ptr, size);
+  size_t cap = 4096;
+  while (cap < size)
+    cap <<= 1;
+
+  mutt_mem_realloc(ptr, cap);
 }
 
 /**
@@ -190,17 +197,11 @@ void serial_restore_char(char **c, const unsigned char *d, int *off, bool conver
   memcpy(*c, d + *off, size);
   if (convert && !mutt_str_is_ascii(*c, size))
   {
-    char *tmp = mutt_str_dup(*c);
+    /* Convert the copy in place - cached strings are stored in utf-8, so
+     * failure means an unusable $charset and the raw string is as good as it
+     * gets.  Taking another copy first just doubles the allocations. */
     const char *const c_charset = cs_subset_string(NeoMutt->sub, "charset");
-    if (mutt_ch_convert_string(&tmp, "utf-8", c_charset, MUTT_ICONV_NO_FLAGS) == 0)
-    {
-      FREE(c);
-      *c = tmp;
-    }
-    else
-    {
-      FREE(&tmp);
-    }
+    mutt_ch_convert_string(c, "utf-8", c_charset, MUTT_ICONV_NO_FLAGS);
   }
   *off += size;
 }
@@ -452,6 +453,14 @@ unsigned char *serial_dump_body(struct Body *c, unsigned char *d, int *off, bool
   d = serial_dump_char(nb.filename, d, off, convert);
   d = serial_dump_char(nb.d_filename, d, off, convert);
 
+  /* pack the MIME part tree, so the structure survives a restart */
+  unsigned int count = 0;
+  for (struct Body *part = c->parts; part; part = part->next)
+    count++;
+  d = serial_dump_int(count, d, off);
+  for (struct Body *part = c->parts; part; part = part->next)
+    d = serial_dump_body(part, d, off, convert);
+
   return d;
 }
 
@@ -478,6 +487,16 @@ void serial_restore_body(struct Body *c, const unsigned char *d, int *off, bool
   serial_restore_char(&c->form_name, d, off, convert);
   serial_restore_char(&c->filename, d, off, convert);
   serial_restore_char(&c->d_filename, d, off, convert);
+
+  unsigned int count = 0;
+  serial_restore_int(&count, d, off);
+  struct Body **part = &c->parts;
+  while (count--)
+  {
+    *part = mutt_body_new();
+    serial_restore_body(*part, d, off, convert);
+    part = &(*part)->next;
+  }
 }
 
 /**
@@ -510,6 +529,9 @@ unsigned char *serial_dump_envelope(struct Envelope *env, unsigned char *d,
   else
     d = serial_dump_int(-1, d, off);
 
+  d = serial_dump_char(env->disp_subj, d, off, convert);
+  d = serial_dump_char(env->disp_author, d, off, convert);
+
   d = serial_dump_char(env->message_id, d, off, false);
   d = serial_dump_char(env->supersedes, d, off, false);
   d = serial_dump_char(env->date, d, off, false);
@@ -531,6 +553,23 @@ unsigned char *serial_dump_envelope(struct Envelope *env, unsigned char *d,
   return d;
 }
 
+/**
+ * serial_intern_char - Swap a restored string for an interned copy
+ * @param[out] ptr Restored string
+ *
+ * Fields that are interned at parse time, see mutt_rfc822_parse_line(),
+ * should be shared when they come from the cache, too.
+ */
+static void serial_intern_char(char **ptr)
+{
+  if (!*ptr)
+    return;
+
+  char *plain = *ptr;
+  *ptr = mutt_intern(plain);
+  FREE(&plain);
+}
+
 /**
  * serial_restore_envelope - Unpack an Envelope from a binary blob
  * @param env     Store the unpacked Envelope here
@@ -554,6 +593,9 @@ void serial_restore_envelope(struct Envelope *env, const unsigned char *d, int *
   serial_restore_char(&env->list_post, d, off, convert);
   serial_restore_char(&env->list_subscribe, d, off, convert);
   serial_restore_char(&env->list_unsubscribe, d, off, convert);
+  serial_intern_char(&env->list_post);
+  serial_intern_char(&env->list_subscribe);
+  serial_intern_char(&env->list_unsubscribe);
 
   const bool c_auto_subscribe = cs_subset_bool(NeoMutt->sub, "auto_subscribe");
   if (c_auto_subscribe)
@@ -568,11 +610,15 @@ void serial_restore_envelope(struct Envelope *env, const unsigned char *d, int *
   else
     env->real_subj = env->subject + real_subj_off;
 
+  serial_restore_char(&env->disp_subj, d, off, convert);
+  serial_restore_char(&env->disp_author, d, off, convert);
+
   serial_restore_char(&env->message_id, d, off, false);
   serial_restore_char(&env->supersedes, d, off, false);
   serial_restore_char(&env->date, d, off, false);
   serial_restore_char(&env->x_label, d, off, convert);
   serial_restore_char(&env->organization, d, off, convert);
+  serial_intern_char(&env->organization);
 
   serial_restore_buffer(&env->spam, d, off, convert);
 
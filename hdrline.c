@@ -55,6 +55,7 @@
 #include "mutt_thread.h"
 #include "muttlib.h"
 #include "mx.h"
+#include "score.h"
 #include "sort.h"
 #include "subjectrx.h"
 #ifdef USE_NOTMUCH
@@ -368,7 +369,7 @@ static int user_is_recipient(struct Email *e)
  */
 static bool thread_is_new(struct Email *e)
 {
-  return e->collapsed && (e->num_hidden > 1) && (mutt_thread_contains_unread(e) == 1);
+  return e->collapsed && (e->num_hidden > 1) && (mutt_thread_unread(e) == 1);
 }
 
 /**
@@ -378,7 +379,7 @@ static bool thread_is_new(struct Email *e)
  */
 static bool thread_is_old(struct Email *e)
 {
-  return e->collapsed && (e->num_hidden > 1) && (mutt_thread_contains_unread(e) == 2);
+  return e->collapsed && (e->num_hidden > 1) && (mutt_thread_unread(e) == 2);
 }
 
 /**
@@ -788,8 +789,18 @@ static const char *index_format_str(char *buf, size_t buflen, size_t col, int co
       {
         const bool is_plain = (src[0] == 'p');
         colorlen = add_index_color(buf, buflen, flags, MT_COLOR_INDEX_AUTHOR);
-        make_from(e->env, tmp, sizeof(tmp), false,
-                  (is_plain ? MUTT_FORMAT_PLAIN : MUTT_FORMAT_NO_FLAGS));
+        if (!is_plain && e->env->disp_author)
+        {
+          /* Reuse the cached author string, possibly from the header cache */
+          mutt_str_copy(tmp, e->env->disp_author, sizeof(tmp));
+        }
+        else
+        {
+          make_from(e->env, tmp, sizeof(tmp), false,
+                    (is_plain ? MUTT_FORMAT_PLAIN : MUTT_FORMAT_NO_FLAGS));
+          if (!is_plain)
+            e->env->disp_author = mutt_str_dup(tmp);
+        }
         mutt_format_s(buf + colorlen, buflen - colorlen, prec, tmp);
         add_index_color(buf + colorlen, buflen - colorlen, flags, MT_COLOR_INDEX);
 
@@ -975,6 +986,7 @@ static const char *index_format_str(char *buf, size_t buflen, size_t col, int co
       break;
 
     case 'N':
+      mutt_score_require(m, e);
       if (!optional)
       {
         snprintf(fmt, sizeof(fmt), "%%%sd", prec);
@@ -1395,6 +1407,620 @@ static const char *index_format_str(char *buf, size_t buflen, size_t col, int co
   return src;
 }
 
+/**
+ * enum IdxFmtType - Type of a compiled $index_format instruction
+ */
+enum IdxFmtType
+{
+  IFI_LITERAL,  ///< Copy text verbatim
+  IFI_EXPANDO,  ///< Call index_format_str() for one field
+  IFI_PAD_EOL,  ///< `%|X` - Fill the rest of the line with a character
+  IFI_PAD_HARD, ///< `%>X` - Right-justify the rest of the format
+  IFI_PAD_SOFT, ///< `%*X` - Right-justify, the right part takes precedence
+};
+
+/**
+ * struct IdxFmtInstr - One instruction of a compiled $index_format
+ */
+struct IdxFmtInstr
+{
+  enum IdxFmtType type; ///< Instruction type, e.g. #IFI_EXPANDO
+  char op;              ///< Expando character, e.g. 's' for `%s`
+  bool to_lower;        ///< `_` modifier - Lowercase the result
+  bool no_dots;         ///< `:` modifier - Replace dots with underscores
+  bool optional;        ///< Conditional `%<x?y&z>` expando
+  char prefix[128];     ///< printf-style prefix, e.g. "-15.15"
+  char *if_str;         ///< Format if the condition matches
+  char *else_str;       ///< Format if the condition doesn't match
+  char *text;           ///< Literal text / expando argument / padding text
+};
+
+/**
+ * struct IdxFmtProg - A compiled $index_format
+ *
+ * mutt_expando_format() re-scans the format string, character by character,
+ * for every index row on every redraw.  The scan only depends on the format
+ * itself, so it's done once here and the result - literal runs and field
+ * emitters with their prefix and arguments already extracted - is executed
+ * per row instead.
+ */
+struct IdxFmtProg
+{
+  char *src;                 ///< Format this program was compiled from
+  struct IdxFmtInstr *instr; ///< Array of instructions
+  int num_instr;             ///< Number of instructions used
+  int max_instr;             ///< Size of the instr array
+  bool interpret;            ///< Format can't be compiled, e.g. a filter
+};
+
+/**
+ * idx_fmt_instr_new - Add an instruction to a compiled $index_format
+ * @param prog Program to extend
+ * @param type Type of the new instruction
+ * @retval ptr New instruction
+ */
+static struct IdxFmtInstr *idx_fmt_instr_new(struct IdxFmtProg *prog, enum IdxFmtType type)
+{
+  if (prog->num_instr == prog->max_instr)
+  {
+    prog->max_instr = (prog->max_instr == 0) ? 16 : (prog->max_instr * 2);
+    mutt_mem_realloc(&prog->instr, prog->max_instr * sizeof(struct IdxFmtInstr));
+  }
+
+  struct IdxFmtInstr *instr = &prog->instr[prog->num_instr++];
+  memset(instr, 0, sizeof(*instr));
+  instr->type = type;
+  return instr;
+}
+
+/**
+ * idx_fmt_prog_free - Free a compiled $index_format
+ * @param[out] ptr Program to free
+ */
+static void idx_fmt_prog_free(struct IdxFmtProg **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct IdxFmtProg *prog = *ptr;
+  for (int i = 0; i < prog->num_instr; i++)
+  {
+    FREE(&prog->instr[i].if_str);
+    FREE(&prog->instr[i].else_str);
+    FREE(&prog->instr[i].text);
+  }
+  FREE(&prog->instr);
+  FREE(&prog->src);
+  FREE(ptr);
+}
+
+/**
+ * idx_fmt_args_len - Measure the argument of an $index_format expando
+ * @param op  Expando character
+ * @param src Text following the expando
+ * @retval num Bytes of src that index_format_str() will consume
+ *
+ * Mirrors the argument syntax of index_format_str(): the date expandos scan
+ * to their closing bracket, `%@name@` to the closing '@', and a few flags
+ * take a one-character variant.
+ */
+static size_t idx_fmt_args_len(char op, const char *src)
+{
+  const char *p = NULL;
+
+  switch (op)
+  {
+    case 'c':
+      return (src[0] == 'r') ? 1 : 0;
+    case 'F':
+      return (src[0] == 'p') ? 1 : 0;
+    case 'G':
+      return (src[0] != '\0') ? 1 : 0;
+    case 'z':
+      return ((src[0] == 's') || (src[0] == 'c') || (src[0] == 't')) ? 1 : 0;
+    case '{':
+    case '[':
+    case '(':
+    {
+      const char close = (op == '{') ? '}' : ((op == '[') ? ']' : ')');
+      p = strchr(src, close);
+      return p ? (size_t) (p - src + 1) : mutt_str_len(src);
+    }
+    case '@':
+      p = strchr(src, '@');
+      return p ? (size_t) (p - src + 1) : 0;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * idx_fmt_compile - Compile an $index_format into a program
+ * @param src Format string
+ * @retval ptr Compiled program
+ *
+ * The parsing below matches mutt_expando_format(): `%%`, backslash escapes,
+ * the old `%?x?y&z?` conditional notation, nested `%<x?y&z>` conditionals and
+ * the `%>`, `%*` and `%|` padding expandos.
+ */
+static struct IdxFmtProg *idx_fmt_compile(const char *src)
+{
+  struct IdxFmtProg *prog = mutt_mem_calloc(1, sizeof(struct IdxFmtProg));
+  prog->src = mutt_str_dup(src);
+
+  /* formats ending in a real pipe run a filter; leave them to the interpreter */
+  const int n = mutt_str_len(src);
+  if ((n > 1) && (src[n - 1] == '|'))
+  {
+    int off = n;
+    while ((off > 0) && (src[off - 2] == '\\'))
+      off--;
+    if (((n - off) % 2) == 0)
+    {
+      prog->interpret = true;
+      return prog;
+    }
+  }
+
+  /* working copy; rewriting %? to %< may grow the string by two bytes per
+   * escaped bracket */
+  char *copy = mutt_mem_calloc((2 * n) + 1, 1);
+  memcpy(copy, src, n);
+  const char *s = copy;
+
+  struct Buffer lit = mutt_buffer_make(128);
+
+  while (*s != '\0')
+  {
+    if (*s == '%')
+    {
+      if (*++s == '%')
+      {
+        mutt_buffer_addch(&lit, '%');
+        s++;
+        continue;
+      }
+
+      if (!mutt_buffer_is_empty(&lit))
+      {
+        struct IdxFmtInstr *instr = idx_fmt_instr_new(prog, IFI_LITERAL);
+        instr->text = mutt_buffer_strdup(&lit);
+        mutt_buffer_reset(&lit);
+      }
+
+      if (*s == '?')
+      {
+        /* change original %? to new %< notation */
+        /* %?x?y&z? to %<x?y&z> where y and z are nestable */
+        char *p = (char *) s;
+        *p = '<';
+        /* skip over "x" */
+        for (; *p && (*p != '?'); p++)
+          ; // do nothing
+
+        /* nothing */
+        if (*p == '?')
+          p++;
+        /* fix up the "y&z" section */
+        for (; *p && (*p != '?'); p++)
+        {
+          /* escape '<' and '>' to work inside nested-if */
+          if ((*p == '<') || (*p == '>'))
+          {
+            memmove(p + 2, p, mutt_str_len(p) + 1);
+            *p++ = '\\';
+            *p++ = '\\';
+          }
+        }
+        if (*p == '?')
+          *p = '>';
+      }
+
+      struct IdxFmtInstr *instr = NULL;
+      char *cp = NULL;
+      size_t count = 0;
+
+      if (*s == '<')
+      {
+        instr = idx_fmt_instr_new(prog, IFI_EXPANDO);
+        instr->optional = true;
+        instr->op = *(++s);
+        s++;
+        cp = instr->prefix;
+        count = 0;
+        while ((count < (sizeof(instr->prefix) - 1)) && (*s != '\0') && (*s != '?'))
+        {
+          *cp++ = *s++;
+          count++;
+        }
+        *cp = '\0';
+
+        if (*s != '?')
+          break; /* bad format */
+        s++;
+
+        char if_str[128], else_str[128];
+        int lrbalance = 1;
+
+        /* eat the 'if' part of the string */
+        cp = if_str;
+        count = 0;
+        while ((lrbalance > 0) && (count < sizeof(if_str)) && *s)
+        {
+          if ((s[0] == '%') && (s[1] == '>'))
+          {
+            /* This is a padding expando; copy two chars and carry on */
+            *cp++ = *s++;
+            *cp++ = *s++;
+            count += 2;
+            continue;
+          }
+
+          if (*s == '\\')
+          {
+            s++;
+            *cp++ = *s++;
+          }
+          else if ((s[0] == '%') && (s[1] == '<'))
+          {
+            lrbalance++;
+          }
+          else if (s[0] == '>')
+          {
+            lrbalance--;
+          }
+          if (lrbalance == 0)
+            break;
+          if ((lrbalance == 1) && (s[0] == '&'))
+            break;
+          *cp++ = *s++;
+          count++;
+        }
+        *cp = '\0';
+
+        /* eat the 'else' part of the string (optional) */
+        if (*s == '&')
+          s++; /* skip the & */
+        cp = else_str;
+        count = 0;
+        while ((lrbalance > 0) && (count < sizeof(else_str)) && (*s != '\0'))
+        {
+          if ((s[0] == '%') && (s[1] == '>'))
+          {
+            /* This is a padding expando; copy two chars and carry on */
+            *cp++ = *s++;
+            *cp++ = *s++;
+            count += 2;
+            continue;
+          }
+
+          if (*s == '\\')
+          {
+            s++;
+            *cp++ = *s++;
+          }
+          else if ((s[0] == '%') && (s[1] == '<'))
+          {
+            lrbalance++;
+          }
+          else if (s[0] == '>')
+          {
+            lrbalance--;
+          }
+          if (lrbalance == 0)
+            break;
+          if ((lrbalance == 1) && (s[0] == '&'))
+            break;
+          *cp++ = *s++;
+          count++;
+        }
+        *cp = '\0';
+
+        if (*s == '\0')
+          break; /* bad format */
+        s++; /* move past the trailing '>' (formerly '?') */
+
+        instr->if_str = mutt_str_dup(if_str);
+        instr->else_str = mutt_str_dup(else_str);
+        continue;
+      }
+
+      char prefix[128];
+      cp = prefix;
+      count = 0;
+      while ((count < (sizeof(prefix) - 1)) && strchr("0123456789.-=", *s))
+      {
+        *cp++ = *s++;
+        count++;
+      }
+      *cp = '\0';
+
+      if (*s == '\0')
+        break; /* bad format */
+
+      char ch = *s++;
+
+      if ((ch == '>') || (ch == '*') || (ch == '|'))
+      {
+        instr = idx_fmt_instr_new(prog, (ch == '|') ? IFI_PAD_EOL :
+                                        ((ch == '>') ? IFI_PAD_HARD : IFI_PAD_SOFT));
+        instr->text = mutt_str_dup(s);
+        break; /* padding consumes the rest of the format */
+      }
+
+      instr = idx_fmt_instr_new(prog, IFI_EXPANDO);
+      mutt_str_copy(instr->prefix, prefix, sizeof(instr->prefix));
+
+      while ((ch == '_') || (ch == ':'))
+      {
+        if (ch == '_')
+          instr->to_lower = true;
+        else if (ch == ':')
+          instr->no_dots = true;
+
+        ch = *s++;
+      }
+      instr->op = ch;
+
+      const size_t alen = idx_fmt_args_len(ch, s);
+      instr->text = mutt_strn_dup(s, alen);
+      s += alen;
+    }
+    else if (*s == '\\')
+    {
+      if (!*++s)
+        break;
+      switch (*s)
+      {
+        case 'f':
+          mutt_buffer_addch(&lit, '\f');
+          break;
+        case 'n':
+          mutt_buffer_addch(&lit, '\n');
+          break;
+        case 'r':
+          mutt_buffer_addch(&lit, '\r');
+          break;
+        case 't':
+          mutt_buffer_addch(&lit, '\t');
+          break;
+        case 'v':
+          mutt_buffer_addch(&lit, '\v');
+          break;
+        default:
+          mutt_buffer_addch(&lit, *s);
+          break;
+      }
+      s++;
+    }
+    else
+    {
+      mutt_buffer_addch(&lit, *s++);
+    }
+  }
+
+  if (!mutt_buffer_is_empty(&lit))
+  {
+    struct IdxFmtInstr *instr = idx_fmt_instr_new(prog, IFI_LITERAL);
+    instr->text = mutt_buffer_strdup(&lit);
+  }
+
+  mutt_buffer_dealloc(&lit);
+  FREE(&copy);
+  return prog;
+}
+
+/**
+ * idx_fmt_exec - Run a compiled $index_format for one Email
+ * @param[in]  prog   Compiled program
+ * @param[out] buf    Buffer in which to save string
+ * @param[in]  buflen Buffer length
+ * @param[in]  cols   Number of screen columns
+ * @param[in]  data   Callback data for index_format_str()
+ * @param[in]  flags  Callback flags
+ *
+ * The emission - truncation, column accounting, padding - matches
+ * mutt_expando_format(); only the scanning is gone.
+ */
+static void idx_fmt_exec(const struct IdxFmtProg *prog, char *buf, size_t buflen,
+                         int cols, intptr_t data, MuttFormatFlags flags)
+{
+  char tmp[1024];
+  char *wptr = buf;
+  size_t wlen, len, wid;
+
+  const bool c_arrow_cursor = cs_subset_bool(NeoMutt->sub, "arrow_cursor");
+  const char *const c_arrow_string =
+      cs_subset_string(NeoMutt->sub, "arrow_string");
+
+  buflen--; /* save room for the terminal \0 */
+  wlen = ((flags & MUTT_FORMAT_ARROWCURSOR) && c_arrow_cursor) ?
+             mutt_strwidth(c_arrow_string) + 1 :
+             0;
+  size_t col = wlen;
+
+  for (int i = 0; (i < prog->num_instr) && (wlen < buflen); i++)
+  {
+    const struct IdxFmtInstr *instr = &prog->instr[i];
+    switch (instr->type)
+    {
+      case IFI_LITERAL:
+      {
+        for (const char *s = instr->text; (*s != '\0') && (wlen < buflen);)
+        {
+          int width;
+          int bytes = mutt_mb_charlen(s, &width);
+          if (bytes < 0)
+          {
+            bytes = 1;
+            width = 1;
+          }
+          if ((bytes > 0) && ((wlen + bytes) < buflen))
+          {
+            memcpy(wptr, s, bytes);
+            wptr += bytes;
+            s += bytes;
+            wlen += bytes;
+            col += width;
+          }
+          else
+          {
+            wlen = buflen;
+          }
+        }
+        break;
+      }
+
+      case IFI_EXPANDO:
+      {
+        if (instr->optional)
+          flags |= MUTT_FORMAT_OPTIONAL;
+        else
+          flags &= ~MUTT_FORMAT_OPTIONAL;
+
+        *tmp = '\0';
+        index_format_str(tmp, sizeof(tmp), col, cols, instr->op,
+                         NONULL(instr->text), instr->prefix, NONULL(instr->if_str),
+                         NONULL(instr->else_str), data, flags);
+
+        if (instr->to_lower)
+          mutt_str_lower(tmp);
+        if (instr->no_dots)
+        {
+          for (char *p = tmp; *p; p++)
+            if (*p == '.')
+              *p = '_';
+        }
+
+        len = mutt_str_len(tmp);
+        if ((len + wlen) > buflen)
+          len = mutt_wstr_trunc(tmp, buflen - wlen, cols - col, NULL);
+
+        memcpy(wptr, tmp, len);
+        wptr += len;
+        wlen += len;
+        col += mutt_strwidth(tmp);
+        break;
+      }
+
+      case IFI_PAD_HARD:
+      case IFI_PAD_SOFT:
+      {
+        /* %>X: right justify to EOL, left takes precedence
+         * %*X: right justify to EOL, right takes precedence */
+        const bool soft = (instr->type == IFI_PAD_SOFT);
+        const char *src = NONULL(instr->text);
+        int pl, pw;
+        pl = mutt_mb_charlen(src, &pw);
+        if (pl <= 0)
+        {
+          pl = 1;
+          pw = 1;
+        }
+
+        /* see if there's room to add content, else ignore */
+        if (((col < cols) && (wlen < buflen)) || soft)
+        {
+          int pad;
+
+          /* get contents after padding */
+          mutt_expando_format(tmp, sizeof(tmp), 0, cols, src + pl,
+                              index_format_str, data, flags);
+          len = mutt_str_len(tmp);
+          wid = mutt_strwidth(tmp);
+
+          pad = (cols - col - wid) / pw;
+          if (pad >= 0)
+          {
+            /* try to consume as many columns as we can, if we don't have
+             * memory for that, use as much memory as possible */
+            if (wlen + (pad * pl) + len > buflen)
+              pad = (buflen > (wlen + len)) ? ((buflen - wlen - len) / pl) : 0;
+            else
+            {
+              /* Add pre-spacing to make multi-column pad characters and
+               * the contents after padding line up */
+              while (((col + (pad * pw) + wid) < cols) && ((wlen + (pad * pl) + len) < buflen))
+              {
+                *wptr++ = ' ';
+                wlen++;
+                col++;
+              }
+            }
+            while (pad-- > 0)
+            {
+              memcpy(wptr, src, pl);
+              wptr += pl;
+              wlen += pl;
+              col += pw;
+            }
+          }
+          else if (soft)
+          {
+            int offset = ((flags & MUTT_FORMAT_ARROWCURSOR) && c_arrow_cursor) ?
+                             mutt_strwidth(c_arrow_string) + 1 :
+                             0;
+            int avail_cols = (cols > offset) ? (cols - offset) : 0;
+            /* \0-terminate buf for length computation in mutt_wstr_trunc() */
+            *wptr = '\0';
+            /* make sure right part is at most as wide as display */
+            len = mutt_wstr_trunc(tmp, buflen, avail_cols, &wid);
+            /* truncate left so that right part fits completely in */
+            wlen = mutt_wstr_trunc(buf, buflen - len, avail_cols - wid, &col);
+            wptr = buf + wlen;
+            /* Multi-column characters may be truncated in the middle.
+             * Add spacing so the right hand side lines up. */
+            while (((col + wid) < avail_cols) && ((wlen + len) < buflen))
+            {
+              *wptr++ = ' ';
+              wlen++;
+              col++;
+            }
+          }
+          if ((len + wlen) > buflen)
+            len = mutt_wstr_trunc(tmp, buflen - wlen, cols - col, NULL);
+          memcpy(wptr, tmp, len);
+          wptr += len;
+        }
+        *wptr = '\0';
+        return;
+      }
+
+      case IFI_PAD_EOL:
+      {
+        /* pad to EOL */
+        const char *src = NONULL(instr->text);
+        int pl, pw;
+        pl = mutt_mb_charlen(src, &pw);
+        if (pl <= 0)
+        {
+          pl = 1;
+          pw = 1;
+        }
+
+        /* see if there's room to add content, else ignore */
+        if ((col < cols) && (wlen < buflen))
+        {
+          int c = (cols - col) / pw;
+          if ((c > 0) && ((wlen + (c * pl)) > buflen))
+            c = ((signed) (buflen - wlen)) / pl;
+          while (c > 0)
+          {
+            memcpy(wptr, src, pl);
+            wptr += pl;
+            wlen += pl;
+            col += pw;
+            c--;
+          }
+        }
+        *wptr = '\0';
+        return;
+      }
+    }
+  }
+  *wptr = '\0';
+}
+
 /**
  * mutt_make_string - Create formatted strings using mailbox expandos
  * @param buf      Buffer for the result
@@ -1420,5 +2046,18 @@ void mutt_make_string(char *buf, size_t buflen, int cols, const char *s,
   hfi.msg_in_pager = inpgr;
   hfi.pager_progress = progress;
 
-  mutt_expando_format(buf, buflen, 0, cols, s, index_format_str, (intptr_t) &hfi, flags);
+  /* compile the format once and reuse the program for every row */
+  static struct IdxFmtProg *prog = NULL;
+  if (!prog || !mutt_str_equal(prog->src, s))
+  {
+    idx_fmt_prog_free(&prog);
+    prog = idx_fmt_compile(s);
+  }
+
+  /* index_format_str() consumes nothing without an Email, which changes how
+   * the format splits up - leave that case to the interpreter */
+  if (prog->interpret || !e)
+    mutt_expando_format(buf, buflen, 0, cols, s, index_format_str, (intptr_t) &hfi, flags);
+  else
+    idx_fmt_exec(prog, buf, buflen, cols, (intptr_t) &hfi, flags);
 }
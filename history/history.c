@@ -601,6 +601,8 @@ void mutt_hist_read_file(void)
   int line = 0, hclass, read;
   char *linebuf = NULL, *p = NULL;
   size_t buflen;
+  int n[HC_MAX] = { 0 };
+  struct HashTable *dup_hashes[HC_MAX] = { 0 };
 
   const char *const c_history_file =
       cs_subset_path(NeoMutt->sub, "history_file");
@@ -611,6 +613,38 @@ void mutt_hist_read_file(void)
   if (!fp)
     return;
 
+  const short c_history = cs_subset_number(NeoMutt->sub, "history");
+  const bool c_history_remove_dups =
+      cs_subset_bool(NeoMutt->sub, "history_remove_dups");
+  if (c_history_remove_dups)
+  {
+    for (hclass = 0; hclass < HC_MAX; hclass++)
+      dup_hashes[hclass] = mutt_hash_new(MAX(10, c_history * 2), MUTT_HASH_STRDUP_KEYS);
+  }
+
+  /* The file may hold many more entries than the rings keep: it is only
+   * compacted every `$save_history` saves.  Count the (unique) entries per
+   * class first, so the parse below can skip those that would fall out of the
+   * ring anyway -- the charset conversion and the ring shuffling are then only
+   * paid for the O(`$history`) survivors. */
+  while ((linebuf = mutt_file_read_line(linebuf, &buflen, fp, &line, MUTT_RL_NO_FLAGS)))
+  {
+    read = 0;
+    if ((sscanf(linebuf, "%d:%n", &hclass, &read) < 1) || (read == 0) ||
+        (*(p = linebuf + strlen(linebuf) - 1) != '|') || (hclass < 0))
+    {
+      break; /* reported on the second pass */
+    }
+    if (hclass >= HC_MAX)
+      continue;
+    *p = '\0';
+    if (c_history_remove_dups && (dup_hash_inc(dup_hashes[hclass], linebuf + read) > 1))
+      continue;
+    n[hclass]++;
+  }
+
+  rewind(fp);
+  line = 0;
   while ((linebuf = mutt_file_read_line(linebuf, &buflen, fp, &line, MUTT_RL_NO_FLAGS)))
   {
     read = 0;
@@ -624,6 +658,12 @@ void mutt_hist_read_file(void)
     if (hclass >= HC_MAX)
       continue;
     *p = '\0';
+    /* keep only the last occurrence of each duplicated entry */
+    if (c_history_remove_dups && (dup_hash_dec(dup_hashes[hclass], linebuf + read) > 0))
+      continue;
+    /* the ring has (`$history`+1) slots; skip entries that won't fit */
+    if (n[hclass]-- > (c_history + 1))
+      continue;
     p = mutt_str_dup(linebuf + read);
     if (p)
     {
@@ -636,6 +676,9 @@ void mutt_hist_read_file(void)
 
   mutt_file_fclose(&fp);
   FREE(&linebuf);
+  if (c_history_remove_dups)
+    for (hclass = 0; hclass < HC_MAX; hclass++)
+      mutt_hash_free(&dup_hashes[hclass]);
 }
 
 /**
@@ -63,6 +63,8 @@ struct Hook
 {
   HookFlags type;              ///< Hook type
   struct Regex regex;          ///< Regular expression
+  char *prefix;                ///< Literal prefix of the regex, for cheap rejection
+  size_t prefix_len;           ///< Length of the prefix
   char *command;               ///< Filename, command or pattern to execute
   struct PatternList *pattern; ///< Used for fcc,save,send-hook
   TAILQ_ENTRY(Hook) entries;   ///< Linked list
@@ -71,9 +73,163 @@ TAILQ_HEAD(HookList, Hook);
 
 static struct HookList Hooks = TAILQ_HEAD_INITIALIZER(Hooks);
 
+/**
+ * struct HookRef - Reference to a Hook in the per-type index
+ *
+ * A Hook can have several type bits, e.g. `fcc-save-hook`, so the index
+ * lists hold references rather than the Hooks themselves.
+ */
+struct HookRef
+{
+  struct Hook *hook;            ///< Hook in ::Hooks
+  TAILQ_ENTRY(HookRef) entries; ///< Linked list
+};
+TAILQ_HEAD(HookRefList, HookRef);
+
+/// Number of type bits in #HookFlags
+#define MUTT_HOOK_TYPE_MAX 20
+
+/// Hooks from ::Hooks indexed by type, one list per #HookFlags bit.
+/// Dispatching a hook type only walks the hooks of that type, instead of
+/// testing every hook ever defined.
+static struct HookRefList HookIndex[MUTT_HOOK_TYPE_MAX];
+static bool HookIndexInit = false;
+
 static struct HashTable *IdxFmtHooks = NULL;
 static HookFlags current_hook_type = MUTT_HOOK_NO_FLAGS;
 
+/// Empty list for hook_index_list() to return on unknown types
+static struct HookRefList HookIndexEmpty = TAILQ_HEAD_INITIALIZER(HookIndexEmpty);
+
+/**
+ * hook_index_slot - Get the index slot for one hook type
+ * @param type Hook type, see #HookFlags
+ * @retval ptr  List of hooks of that type, in definition order
+ * @retval NULL type isn't a single known type bit
+ */
+static struct HookRefList *hook_index_slot(HookFlags type)
+{
+  if (!HookIndexInit)
+  {
+    for (size_t i = 0; i < MUTT_HOOK_TYPE_MAX; i++)
+      TAILQ_INIT(&HookIndex[i]);
+    HookIndexInit = true;
+  }
+
+  if ((type == 0) || (type & (type - 1))) // not exactly one bit
+    return NULL;
+
+  size_t i = 0;
+  for (; !(type & 1); type >>= 1)
+    i++;
+
+  return (i < MUTT_HOOK_TYPE_MAX) ? &HookIndex[i] : NULL;
+}
+
+/**
+ * hook_index_list - Get the list of hooks of one type, for dispatching
+ * @param type Hook type, see #HookFlags
+ * @retval ptr List of hooks of that type; empty if the type is unknown
+ */
+static struct HookRefList *hook_index_list(HookFlags type)
+{
+  struct HookRefList *hrl = hook_index_slot(type);
+  return hrl ? hrl : &HookIndexEmpty;
+}
+
+/**
+ * hook_index_add - Add a Hook to the index list of each of its types
+ * @param hook Hook to add
+ */
+static void hook_index_add(struct Hook *hook)
+{
+  for (HookFlags bit = 1; bit != 0; bit <<= 1)
+  {
+    if (!(hook->type & bit))
+      continue;
+    struct HookRefList *hrl = hook_index_slot(bit);
+    if (!hrl)
+      continue;
+    struct HookRef *hr = mutt_mem_calloc(1, sizeof(struct HookRef));
+    hr->hook = hook;
+    TAILQ_INSERT_TAIL(hrl, hr, entries);
+  }
+}
+
+/**
+ * hook_index_remove - Drop all index references to a Hook
+ * @param hook Hook about to be deleted
+ */
+static void hook_index_remove(struct Hook *hook)
+{
+  if (!HookIndexInit)
+    return;
+
+  for (size_t i = 0; i < MUTT_HOOK_TYPE_MAX; i++)
+  {
+    struct HookRef *hr = NULL, *tmp = NULL;
+    TAILQ_FOREACH_SAFE(hr, &HookIndex[i], entries, tmp)
+    {
+      if (hr->hook == hook)
+      {
+        TAILQ_REMOVE(&HookIndex[i], hr, entries);
+        FREE(&hr);
+      }
+    }
+  }
+}
+
+/**
+ * hook_literal_prefix - Extract the literal prefix of an anchored regex
+ * @param pattern Regular expression
+ * @retval ptr  Allocated copy of the literal text after '^'
+ * @retval NULL Pattern isn't anchored, or starts with a metacharacter
+ *
+ * "^mail/lists/" gives "mail/lists/": a candidate string that fails a plain
+ * prefix comparison can't match the regex, so regexec() can be skipped.
+ */
+static char *hook_literal_prefix(const char *pattern)
+{
+  if (!pattern || (pattern[0] != '^'))
+    return NULL;
+
+  size_t len = strcspn(pattern + 1, "^$.[]()|*+?{}\\");
+
+  /* a quantifier makes the preceding character optional */
+  const char next = pattern[1 + len];
+  if ((next == '*') || (next == '?') || (next == '{'))
+    len--;
+
+  if (len == 0)
+    return NULL;
+
+  return mutt_strn_dup(pattern + 1, len);
+}
+
+/**
+ * hook_regex_match - Match a hook's regex, prefiltering on its literal prefix
+ * @param hook Hook to match
+ * @param str  String to check
+ * @retval true str matches
+ * @retval false str does not match
+ */
+static bool hook_regex_match(const struct Hook *hook, const char *str)
+{
+  /* an inverted hook "matches" on regex failure, so the shortcut only
+   * holds for plain patterns */
+  if (str && hook->prefix && !hook->regex.pat_not)
+  {
+    const bool icase = (hook->type & MUTT_CRYPT_HOOK); // compiled with REG_ICASE
+    if (icase ? !mutt_istrn_equal(str, hook->prefix, hook->prefix_len) :
+                !mutt_strn_equal(str, hook->prefix, hook->prefix_len))
+    {
+      return false;
+    }
+  }
+
+  return mutt_regex_match(&hook->regex, str);
+}
+
 /**
  * mutt_parse_hook - Parse the 'hook' family of commands - Implements Command::parse() - @ingroup command_parse
  *
@@ -294,7 +450,13 @@ enum CommandResult mutt_parse_hook(struct Buffer *buf, struct Buffer *s,
   hook->regex.pattern = mutt_buffer_strdup(pattern);
   hook->regex.regex = rx;
   hook->regex.pat_not = pat_not;
+  if (rx)
+  {
+    hook->prefix = hook_literal_prefix(hook->regex.pattern);
+    hook->prefix_len = mutt_str_len(hook->prefix);
+  }
   TAILQ_INSERT_TAIL(&Hooks, hook, entries);
+  hook_index_add(hook);
   rc = MUTT_CMD_SUCCESS;
 
 cleanup:
@@ -310,6 +472,7 @@ cleanup:
 static void delete_hook(struct Hook *h)
 {
   FREE(&h->command);
+  FREE(&h->prefix);
   FREE(&h->regex.pattern);
   if (h->regex.regex)
   {
@@ -336,6 +499,7 @@ void mutt_delete_hooks(HookFlags type)
     if ((type == MUTT_HOOK_NO_FLAGS) || (type == h->type))
     {
       TAILQ_REMOVE(&Hooks, h, entries);
+      hook_index_remove(h);
       delete_hook(h);
     }
   }
@@ -533,23 +697,21 @@ void mutt_folder_hook(const char *path, const char *desc)
   if (!path && !desc)
     return;
 
-  struct Hook *hook = NULL;
+  struct HookRef *hr = NULL;
   struct Buffer *err = mutt_buffer_pool_get();
 
   current_hook_type = MUTT_FOLDER_HOOK;
 
-  TAILQ_FOREACH(hook, &Hooks, entries)
+  TAILQ_FOREACH(hr, hook_index_list(MUTT_FOLDER_HOOK), entries)
   {
+    struct Hook *hook = hr->hook;
     if (!hook->command)
       continue;
 
-    if (!(hook->type & MUTT_FOLDER_HOOK))
-      continue;
-
     const char *match = NULL;
-    if (mutt_regex_match(&hook->regex, path))
+    if (hook_regex_match(hook, path))
       match = path;
-    else if (mutt_regex_match(&hook->regex, desc))
+    else if (hook_regex_match(hook, desc))
       match = desc;
 
     if (match)
@@ -578,15 +740,12 @@ void mutt_folder_hook(const char *path, const char *desc)
  */
 char *mutt_find_hook(HookFlags type, const char *pat)
 {
-  struct Hook *tmp = NULL;
+  struct HookRef *hr = NULL;
 
-  TAILQ_FOREACH(tmp, &Hooks, entries)
+  TAILQ_FOREACH(hr, hook_index_list(type), entries)
   {
-    if (tmp->type & type)
-    {
-      if (mutt_regex_match(&tmp->regex, pat))
-        return tmp->command;
-    }
+    if (hook_regex_match(hr->hook, pat))
+      return hr->hook->command;
   }
   return NULL;
 }
@@ -599,34 +758,32 @@ char *mutt_find_hook(HookFlags type, const char *pat)
  */
 void mutt_message_hook(struct Mailbox *m, struct Email *e, HookFlags type)
 {
-  struct Hook *hook = NULL;
+  struct HookRef *hr = NULL;
   struct PatternCache cache = { 0 };
   struct Buffer *err = mutt_buffer_pool_get();
 
   current_hook_type = type;
 
-  TAILQ_FOREACH(hook, &Hooks, entries)
+  TAILQ_FOREACH(hr, hook_index_list(type), entries)
   {
+    struct Hook *hook = hr->hook;
     if (!hook->command)
       continue;
 
-    if (hook->type & type)
+    if ((mutt_pattern_exec(SLIST_FIRST(hook->pattern), 0, m, e, &cache) > 0) ^
+        hook->regex.pat_not)
     {
-      if ((mutt_pattern_exec(SLIST_FIRST(hook->pattern), 0, m, e, &cache) > 0) ^
-          hook->regex.pat_not)
+      if (mutt_parse_rc_line(hook->command, err) == MUTT_CMD_ERROR)
       {
-        if (mutt_parse_rc_line(hook->command, err) == MUTT_CMD_ERROR)
-        {
-          mutt_error("%s", mutt_buffer_string(err));
-          current_hook_type = MUTT_HOOK_NO_FLAGS;
-          mutt_buffer_pool_release(&err);
+        mutt_error("%s", mutt_buffer_string(err));
+        current_hook_type = MUTT_HOOK_NO_FLAGS;
+        mutt_buffer_pool_release(&err);
 
-          return;
-        }
-        /* Executing arbitrary commands could affect the pattern results,
-         * so the cache has to be wiped */
-        memset(&cache, 0, sizeof(cache));
+        return;
       }
+      /* Executing arbitrary commands could affect the pattern results,
+       * so the cache has to be wiped */
+      memset(&cache, 0, sizeof(cache));
     }
   }
   mutt_buffer_pool_release(&err);
@@ -647,23 +804,21 @@ void mutt_message_hook(struct Mailbox *m, struct Email *e, HookFlags type)
 static int addr_hook(char *path, size_t pathlen, HookFlags type,
                      struct Mailbox *m, struct Email *e)
 {
-  struct Hook *hook = NULL;
+  struct HookRef *hr = NULL;
   struct PatternCache cache = { 0 };
 
   /* determine if a matching hook exists */
-  TAILQ_FOREACH(hook, &Hooks, entries)
+  TAILQ_FOREACH(hr, hook_index_list(type), entries)
   {
+    struct Hook *hook = hr->hook;
     if (!hook->command)
       continue;
 
-    if (hook->type & type)
+    if ((mutt_pattern_exec(SLIST_FIRST(hook->pattern), 0, m, e, &cache) > 0) ^
+        hook->regex.pat_not)
     {
-      if ((mutt_pattern_exec(SLIST_FIRST(hook->pattern), 0, m, e, &cache) > 0) ^
-          hook->regex.pat_not)
-      {
-        mutt_make_string(path, pathlen, 0, hook->command, m, -1, e, MUTT_FORMAT_PLAIN, NULL);
-        return 0;
-      }
+      mutt_make_string(path, pathlen, 0, hook->command, m, -1, e, MUTT_FORMAT_PLAIN, NULL);
+      return 0;
     }
   }
 
@@ -755,13 +910,13 @@ void mutt_select_fcc(struct Buffer *path, struct Email *e)
  */
 static void list_hook(struct ListHead *matches, const char *match, HookFlags hook)
 {
-  struct Hook *tmp = NULL;
+  struct HookRef *hr = NULL;
 
-  TAILQ_FOREACH(tmp, &Hooks, entries)
+  TAILQ_FOREACH(hr, hook_index_list(hook), entries)
   {
-    if ((tmp->type & hook) && mutt_regex_match(&tmp->regex, match))
+    if (hook_regex_match(hr->hook, match))
     {
-      mutt_list_insert_tail(matches, mutt_str_dup(tmp->command));
+      mutt_list_insert_tail(matches, mutt_str_dup(hr->hook->command));
     }
   }
 }
@@ -791,15 +946,16 @@ void mutt_account_hook(const char *url)
   if (inhook)
     return;
 
-  struct Hook *hook = NULL;
+  struct HookRef *hr = NULL;
   struct Buffer *err = mutt_buffer_pool_get();
 
-  TAILQ_FOREACH(hook, &Hooks, entries)
+  TAILQ_FOREACH(hr, hook_index_list(MUTT_ACCOUNT_HOOK), entries)
   {
-    if (!(hook->command && (hook->type & MUTT_ACCOUNT_HOOK)))
+    struct Hook *hook = hr->hook;
+    if (!hook->command)
       continue;
 
-    if (mutt_regex_match(&hook->regex, url))
+    if (hook_regex_match(hook, url))
     {
       inhook = true;
       mutt_debug(LL_DEBUG1, "account-hook '%s' matches '%s'\n", hook->regex.pattern, url);
@@ -829,7 +985,7 @@ done:
  */
 void mutt_timeout_hook(void)
 {
-  struct Hook *hook = NULL;
+  struct HookRef *hr = NULL;
   struct Buffer err;
   char buf[256];
 
@@ -837,12 +993,12 @@ void mutt_timeout_hook(void)
   err.data = buf;
   err.dsize = sizeof(buf);
 
-  TAILQ_FOREACH(hook, &Hooks, entries)
+  TAILQ_FOREACH(hr, hook_index_list(MUTT_TIMEOUT_HOOK), entries)
   {
-    if (!(hook->command && (hook->type & MUTT_TIMEOUT_HOOK)))
+    if (!hr->hook->command)
       continue;
 
-    if (mutt_parse_rc_line(hook->command, &err) == MUTT_CMD_ERROR)
+    if (mutt_parse_rc_line(hr->hook->command, &err) == MUTT_CMD_ERROR)
     {
       mutt_error("%s", err.data);
       mutt_buffer_reset(&err);
@@ -865,19 +1021,19 @@ void mutt_timeout_hook(void)
  */
 void mutt_startup_shutdown_hook(HookFlags type)
 {
-  struct Hook *hook = NULL;
+  struct HookRef *hr = NULL;
   struct Buffer err = mutt_buffer_make(0);
   char buf[256];
 
   err.data = buf;
   err.dsize = sizeof(buf);
 
-  TAILQ_FOREACH(hook, &Hooks, entries)
+  TAILQ_FOREACH(hr, hook_index_list(type), entries)
   {
-    if (!(hook->command && (hook->type & type)))
+    if (!hr->hook->command)
       continue;
 
-    if (mutt_parse_rc_line(hook->command, &err) == MUTT_CMD_ERROR)
+    if (mutt_parse_rc_line(hr->hook->command, &err) == MUTT_CMD_ERROR)
     {
       mutt_error("%s", err.data);
       mutt_buffer_reset(&err);
@@ -44,6 +44,7 @@ void imap_adata_free(void **ptr)
 
   struct ImapAccountData *adata = *ptr;
 
+  imap_browse_cache_clear(adata);
   FREE(&adata->capstr);
   mutt_buffer_dealloc(&adata->cmdbuf);
   FREE(&adata->buf);
@@ -53,6 +54,7 @@ void imap_adata_free(void **ptr)
   {
     if (adata->conn->close)
       adata->conn->close(adata->conn);
+    FREE(&adata->conn->inbuf);
     FREE(&adata->conn);
   }
 
@@ -61,6 +61,7 @@ struct ImapAccountData
 
   bool unicode; ///< If true, we can send UTF-8, and the server will use UTF8 rather than mUTF7
   bool qresync; ///< true, if QRESYNC is successfully ENABLE'd
+  bool notify_enabled; ///< true, if NOTIFY SET is active on this connection
 
   // if set, the response parser will store results for complicated commands here
   struct ImapList *cmdresult;
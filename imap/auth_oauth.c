@@ -103,6 +103,7 @@ enum ImapAuthRes imap_auth_oauth_xoauth2(struct ImapAccountData *adata,
     return IMAP_AUTH_SUCCESS;
   }
 
+  mutt_account_oauth_invalidate(&adata->conn->account);
   // L10N: %s is the method name, e.g. Anonymous, CRAM-MD5, GSSAPI, SASL
   mutt_error(_("%s authentication failed"), authtype);
   return IMAP_AUTH_FAILURE;
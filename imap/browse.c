@@ -47,6 +47,152 @@
 #include "mutt_logging.h"
 #include "muttlib.h"
 
+/**
+ * struct BrowseCacheItem - One line of a cached LIST response
+ */
+struct BrowseCacheItem
+{
+  char *name;       ///< Mailbox name
+  char delim;       ///< Path delimiter
+  bool noselect;    ///< Mailbox can't be selected
+  bool noinferiors; ///< Mailbox has no children
+};
+ARRAY_HEAD(BrowseCacheItemArray, struct BrowseCacheItem);
+
+/**
+ * struct BrowseCacheEntry - Cached response to one LIST command
+ */
+struct BrowseCacheEntry
+{
+  struct ImapAccountData *adata;     ///< Account the response came from
+  char *cmd;                         ///< LIST command that was sent
+  time_t fetched;                    ///< When the response arrived
+  struct BrowseCacheItemArray items; ///< Parsed response lines
+};
+ARRAY_HEAD(BrowseCacheArray, struct BrowseCacheEntry);
+
+/// Cached LIST responses, valid for `$imap_browse_cache_timeout` seconds
+static struct BrowseCacheArray BrowseCache = ARRAY_HEAD_INITIALIZER;
+
+/**
+ * browse_cache_items_free - Free the lines of a cached LIST response
+ * @param items Array of response lines
+ */
+static void browse_cache_items_free(struct BrowseCacheItemArray *items)
+{
+  struct BrowseCacheItem *item = NULL;
+  ARRAY_FOREACH(item, items)
+  {
+    FREE(&item->name);
+  }
+  ARRAY_FREE(items);
+}
+
+/**
+ * browse_cache_find - Find the cache entry for a LIST command
+ * @param adata Imap Account data
+ * @param cmd   Command string sent to the server
+ * @retval ptr  Matching entry
+ * @retval NULL No match
+ */
+static struct BrowseCacheEntry *browse_cache_find(struct ImapAccountData *adata,
+                                                  const char *cmd)
+{
+  struct BrowseCacheEntry *entry = NULL;
+  ARRAY_FOREACH(entry, &BrowseCache)
+  {
+    if ((entry->adata == adata) && mutt_str_equal(entry->cmd, cmd))
+      return entry;
+  }
+  return NULL;
+}
+
+/**
+ * browse_cache_fetch - Get a LIST response, from the cache if it's current
+ * @param adata Imap Account data
+ * @param cmd   Command string to send to the server
+ * @retval ptr  Parsed response
+ * @retval NULL Failure
+ *
+ * A cached response younger than `$imap_browse_cache_timeout` seconds is
+ * reused without a round trip.  Otherwise the command is sent and the parsed
+ * reply replaces the stale copy.
+ */
+static struct BrowseCacheEntry *browse_cache_fetch(struct ImapAccountData *adata,
+                                                   const char *cmd)
+{
+  struct BrowseCacheEntry *entry = browse_cache_find(adata, cmd);
+
+  const short c_imap_browse_cache_timeout =
+      cs_subset_number(NeoMutt->sub, "imap_browse_cache_timeout");
+  if (entry && ((mutt_date_epoch() - entry->fetched) <= c_imap_browse_cache_timeout))
+    return entry;
+
+  struct ImapList list = { 0 };
+  struct BrowseCacheItemArray items = ARRAY_HEAD_INITIALIZER;
+  int rc;
+
+  imap_cmd_start(adata, cmd);
+  adata->cmdresult = &list;
+  do
+  {
+    list.name = NULL;
+    rc = imap_cmd_step(adata);
+
+    if ((rc == IMAP_RES_CONTINUE) && list.name)
+    {
+      struct BrowseCacheItem item = { mutt_str_dup(list.name), list.delim,
+                                      list.noselect, list.noinferiors };
+      ARRAY_ADD(&items, item);
+    }
+  } while (rc == IMAP_RES_CONTINUE);
+  adata->cmdresult = NULL;
+
+  if (rc != IMAP_RES_OK)
+  {
+    browse_cache_items_free(&items);
+    return NULL;
+  }
+
+  if (!entry)
+  {
+    struct BrowseCacheEntry entry_new = { 0 };
+    entry_new.adata = adata;
+    entry_new.cmd = mutt_str_dup(cmd);
+    ARRAY_ADD(&BrowseCache, entry_new);
+    entry = ARRAY_LAST(&BrowseCache);
+  }
+  else
+  {
+    browse_cache_items_free(&entry->items);
+  }
+
+  entry->items = items;
+  entry->fetched = mutt_date_epoch();
+  return entry;
+}
+
+/**
+ * imap_browse_cache_clear - Forget the cached LIST responses of an account
+ * @param adata Imap Account data, or NULL for all accounts
+ *
+ * Called whenever the folder tree changes behind the cache's back, e.g. a
+ * mailbox is created, renamed, deleted or (un)subscribed.
+ */
+void imap_browse_cache_clear(struct ImapAccountData *adata)
+{
+  struct BrowseCacheEntry *entry = NULL;
+  ARRAY_FOREACH(entry, &BrowseCache)
+  {
+    if (adata && (entry->adata != adata))
+      continue;
+    FREE(&entry->cmd);
+    browse_cache_items_free(&entry->items);
+    ARRAY_REMOVE(&BrowseCache, entry);
+    ARRAY_FOREACH_IDX--;
+  }
+}
+
 /**
  * add_folder - Format and add an IMAP folder to the browser
  * @param delim       Path delimiter
@@ -142,32 +288,25 @@ static void add_folder(char delim, char *folder, bool noselect, bool noinferiors
 static int browse_add_list_result(struct ImapAccountData *adata, const char *cmd,
                                   struct BrowserState *state, bool isparent)
 {
-  struct ImapList list = { 0 };
-  int rc;
+  struct BrowseCacheEntry *entry = browse_cache_fetch(adata, cmd);
+  if (!entry)
+    return -1;
+
   struct Url *url = url_parse(state->folder);
 
-  imap_cmd_start(adata, cmd);
-  adata->cmdresult = &list;
-  do
+  struct BrowseCacheItem *item = NULL;
+  ARRAY_FOREACH(item, &entry->items)
   {
-    list.name = NULL;
-    rc = imap_cmd_step(adata);
-
-    if ((rc == IMAP_RES_CONTINUE) && list.name)
-    {
-      /* Let a parent folder never be selectable for navigation */
-      if (isparent)
-        list.noselect = true;
-      /* prune current folder from output */
-      if (isparent || !mutt_str_startswith(url->path, list.name))
-        add_folder(list.delim, list.name, list.noselect, list.noinferiors, state, isparent);
-    }
-  } while (rc == IMAP_RES_CONTINUE);
-  adata->cmdresult = NULL;
+    /* Let a parent folder never be selectable for navigation */
+    const bool noselect = item->noselect || isparent;
+    /* prune current folder from output */
+    if (isparent || !mutt_str_startswith(url->path, item->name))
+      add_folder(item->delim, item->name, noselect, item->noinferiors, state, isparent);
+  }
 
   url_free(&url);
 
-  return (rc == IMAP_RES_OK) ? 0 : -1;
+  return 0;
 }
 
 /**
@@ -182,7 +321,6 @@ static int browse_add_list_result(struct ImapAccountData *adata, const char *cmd
 int imap_browse(const char *path, struct BrowserState *state)
 {
   struct ImapAccountData *adata = NULL;
-  struct ImapList list = { 0 };
   struct ConnAccount cac = { { 0 } };
   char buf[PATH_MAX + 16];
   char mbox[PATH_MAX];
@@ -251,7 +389,7 @@ int imap_browse(const char *path, struct BrowserState *state)
 
   if (n)
   {
-    int rc;
+    char delim = adata->delim;
     mutt_debug(LL_DEBUG3, "mbox: %s\n", mbox);
 
     /* if our target exists and has inferiors, enter it if we
@@ -260,26 +398,24 @@ int imap_browse(const char *path, struct BrowserState *state)
     len = snprintf(buf, sizeof(buf), "%s \"\" %s", list_cmd, munged_mbox);
     if (adata->capabilities & IMAP_CAP_LIST_EXTENDED)
       snprintf(buf + len, sizeof(buf) - len, " RETURN (CHILDREN)");
-    imap_cmd_start(adata, buf);
-    adata->cmdresult = &list;
-    do
+    struct BrowseCacheEntry *entry = browse_cache_fetch(adata, buf);
+    if (entry)
     {
-      list.name = 0;
-      rc = imap_cmd_step(adata);
-      if ((rc == IMAP_RES_CONTINUE) && list.name)
+      struct BrowseCacheItem *item = NULL;
+      ARRAY_FOREACH(item, &entry->items)
       {
-        if (!list.noinferiors && list.name[0] &&
-            (imap_mxcmp(list.name, mbox) == 0) && (n < sizeof(mbox) - 1))
+        if (!item->noinferiors && item->name[0] &&
+            (imap_mxcmp(item->name, mbox) == 0) && (n < sizeof(mbox) - 1))
         {
-          mbox[n++] = list.delim;
+          delim = item->delim;
+          mbox[n++] = delim;
           mbox[n] = '\0';
         }
       }
-    } while (rc == IMAP_RES_CONTINUE);
-    adata->cmdresult = NULL;
+    }
 
     /* if we're descending a folder, mark it as current in browser_state */
-    if (mbox[n - 1] == list.delim)
+    if (mbox[n - 1] == delim)
     {
       showparents = true;
       imap_qualify_path(buf, sizeof(buf), &cac, mbox);
@@ -293,7 +429,7 @@ int imap_browse(const char *path, struct BrowserState *state)
      *  and tack on delimiter ourselves.
      * Further note: UW-IMAP servers return nothing when asked for
      *  NAMESPACES without delimiters at the end. Argh! */
-    for (n--; n >= 0 && mbox[n] != list.delim; n--)
+    for (n--; n >= 0 && mbox[n] != delim; n--)
       ; // do nothing
 
     if (n > 0) /* "aaaa/bbbb/" -> "aaaa" */
@@ -306,7 +442,7 @@ int imap_browse(const char *path, struct BrowserState *state)
       if (showparents)
       {
         mutt_debug(LL_DEBUG3, "adding parent %s\n", mbox);
-        add_folder(list.delim, mbox, true, false, state, true);
+        add_folder(delim, mbox, true, false, state, true);
       }
 
       /* if our target isn't a folder, we are in our superior */
@@ -82,6 +82,7 @@ static const char *const Capabilities[] = {
   "LIST-EXTENDED",
   "COMPRESS=DEFLATE",
   "X-GM-EXT-1",
+  "NOTIFY",
   NULL,
 };
 
@@ -845,6 +846,14 @@ static void cmd_parse_status(struct ImapAccountData *adata, char *s)
     mutt_debug(LL_DEBUG3, "Received status for an unexpected mailbox: %s\n", mailbox);
     return;
   }
+
+  /* A STATUS we didn't ask for was pushed by NOTIFY, which proves the
+   * filter covers this mailbox, so polling it can be skipped */
+  if (mdata->status_pending != 0)
+    mdata->status_pending--;
+  else if (adata->notify_enabled)
+    mdata->notify_covered = true;
+
   uint32_t olduv = mdata->uidvalidity;
   unsigned int oldun = mdata->uid_next;
 
@@ -1424,3 +1433,38 @@ int imap_cmd_idle(struct ImapAccountData *adata)
 
   return 0;
 }
+
+/**
+ * imap_cmd_keepalive - Keep the connection alive without blocking
+ * @param adata Imap Account data
+ * @retval  0 Success
+ * @retval -1 Failure
+ *
+ * Drain whatever the server has already sent, then post a NOOP without
+ * waiting for the answer.  The answer is picked up by the next reader of
+ * the connection, so a slow server can't stall the caller here.
+ */
+int imap_cmd_keepalive(struct ImapAccountData *adata)
+{
+  int rc;
+
+  while ((rc = mutt_socket_poll(adata->conn, 0)) > 0)
+  {
+    if (imap_cmd_step(adata) < 0)
+      return -1;
+  }
+  if (rc < 0)
+    return -1;
+
+  /* An earlier command is still unanswered; it already generated the
+   * traffic we need, so don't pile another NOOP onto the queue */
+  if (adata->nextcmd != adata->lastcmd)
+    return 0;
+
+  if (imap_cmd_start(adata, "NOOP") < 0)
+    return -1;
+
+  /* imap_cmd_start() only buffers the command, and the caller goes back to
+   * waiting for input, so push the NOOP onto the wire now */
+  return (mutt_socket_flush(adata->conn) < 0) ? -1 : 0;
+}
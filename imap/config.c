@@ -73,9 +73,15 @@ static struct ConfigDef ImapVars[] = {
   { "imap_authenticators", DT_SLIST|SLIST_SEP_COLON, 0, 0, imap_auth_validator,
     "(imap) List of allowed IMAP authentication methods (colon-separated)"
   },
+  { "imap_browse_cache_timeout", DT_NUMBER|DT_NOT_NEGATIVE, 300, 0, NULL,
+    "(imap) Time in seconds to reuse LIST responses in the folder browser"
+  },
   { "imap_delim_chars", DT_STRING, IP "/.", 0, NULL,
     "(imap) Characters that denote separators in IMAP folders"
   },
+  { "imap_fetch_pipeline", DT_BOOL, false, 0, NULL,
+    "(imap) Parse fetched headers on a worker thread while the transfer continues"
+  },
   { "imap_fetch_chunk_size", DT_LONG|DT_NOT_NEGATIVE, 0, 0, NULL,
     "(imap) Download headers in blocks of this size"
   },
@@ -88,6 +94,9 @@ static struct ConfigDef ImapVars[] = {
   { "imap_login", DT_STRING|DT_SENSITIVE, 0, 0, NULL,
     "(imap) Login name for the IMAP server (defaults to `$imap_user`)"
   },
+  { "imap_notify", DT_BOOL, false, 0, NULL,
+    "(imap) Use the IMAP NOTIFY extension to push new mail for subscribed folders"
+  },
   { "imap_oauth_refresh_command", DT_STRING|DT_COMMAND|DT_SENSITIVE, 0, 0, NULL,
     "(imap) External command to generate OAUTH refresh token"
   },
@@ -118,6 +127,9 @@ static struct ConfigDef ImapVars[] = {
   { "imap_poll_timeout", DT_NUMBER|DT_NOT_NEGATIVE, 15, 0, NULL,
     "(imap) Maximum time to wait for a server response"
   },
+  { "imap_prefetch_count", DT_NUMBER|DT_NOT_NEGATIVE, 0, 0, NULL,
+    "(imap) Number of upcoming message bodies to prefetch into the body cache"
+  },
   { "imap_qresync", DT_BOOL, false, 0, NULL,
     "(imap) Enable the QRESYNC extension"
   },
@@ -183,104 +183,104 @@ static void set_flag(struct Mailbox *m, AclFlags aclflag, bool flag,
 }
 
 /**
- * make_msg_set - Make a message set
- * @param[in]  m       Selected Imap Mailbox
- * @param[in]  buf     Buffer to store message set
- * @param[in]  flag    Flags to match, e.g. #MUTT_DELETED
- * @param[in]  changed Matched messages that have been altered
- * @param[in]  invert  Flag matches should be inverted
- * @param[out] pos     Cursor used for multiple calls to this function
- * @retval num Messages in the set
- *
- * @note Headers must be in #SORT_ORDER. See imap_exec_msgset() for args.
- * Pos is an opaque pointer a la strtok(). It should be 0 at first call.
+ * UidArray - Array of UIDs for a UID set
+ */
+ARRAY_HEAD(UidArray, unsigned int);
+
+/**
+ * msg_matches - Does an Email match the flag conditions?
+ * @param e       Email
+ * @param flag    Flag to match, e.g. #MUTT_DELETED
+ * @param changed Matched messages that have been altered
+ * @param invert  Flag matches should be inverted
+ * @retval true Email matches
  */
-static int make_msg_set(struct Mailbox *m, struct Buffer *buf,
-                        enum MessageType flag, bool changed, bool invert, int *pos)
+static bool msg_matches(struct Email *e, enum MessageType flag, bool changed, bool invert)
 {
-  int count = 0;             /* number of messages in message set */
-  unsigned int setstart = 0; /* start of current message range */
-  int n;
-  bool started = false;
+  bool match = false; /* whether current message matches flag condition */
 
-  struct ImapAccountData *adata = imap_adata_get(m);
-  if (!adata || (adata->mailbox != m))
-    return -1;
+  /* don't include pending expunged messages.
+   *
+   * TODO: can we unset active in cmd_parse_expunge() and
+   * cmd_parse_vanished() instead of checking for index != INT_MAX. */
+  if (!e->active || (e->index == INT_MAX))
+    return false;
 
-  for (n = *pos; (n < m->msg_count) && (mutt_buffer_len(buf) < IMAP_MAX_CMDLEN); n++)
+  switch (flag)
   {
-    struct Email *e = m->emails[n];
-    if (!e)
+    case MUTT_DELETED:
+      if (e->deleted != imap_edata_get(e)->deleted)
+        match = invert ^ e->deleted;
       break;
-    bool match = false; /* whether current message matches flag condition */
-    /* don't include pending expunged messages.
-     *
-     * TODO: can we unset active in cmd_parse_expunge() and
-     * cmd_parse_vanished() instead of checking for index != INT_MAX. */
-    if (e->active && (e->index != INT_MAX))
-    {
-      switch (flag)
-      {
-        case MUTT_DELETED:
-          if (e->deleted != imap_edata_get(e)->deleted)
-            match = invert ^ e->deleted;
-          break;
-        case MUTT_FLAG:
-          if (e->flagged != imap_edata_get(e)->flagged)
-            match = invert ^ e->flagged;
-          break;
-        case MUTT_OLD:
-          if (e->old != imap_edata_get(e)->old)
-            match = invert ^ e->old;
-          break;
-        case MUTT_READ:
-          if (e->read != imap_edata_get(e)->read)
-            match = invert ^ e->read;
-          break;
-        case MUTT_REPLIED:
-          if (e->replied != imap_edata_get(e)->replied)
-            match = invert ^ e->replied;
-          break;
-        case MUTT_TAG:
-          if (e->tagged)
-            match = true;
-          break;
-        case MUTT_TRASH:
-          if (e->deleted && !e->purge)
-            match = true;
-          break;
-        default:
-          break;
-      }
-    }
+    case MUTT_FLAG:
+      if (e->flagged != imap_edata_get(e)->flagged)
+        match = invert ^ e->flagged;
+      break;
+    case MUTT_OLD:
+      if (e->old != imap_edata_get(e)->old)
+        match = invert ^ e->old;
+      break;
+    case MUTT_READ:
+      if (e->read != imap_edata_get(e)->read)
+        match = invert ^ e->read;
+      break;
+    case MUTT_REPLIED:
+      if (e->replied != imap_edata_get(e)->replied)
+        match = invert ^ e->replied;
+      break;
+    case MUTT_TAG:
+      if (e->tagged)
+        match = true;
+      break;
+    case MUTT_TRASH:
+      if (e->deleted && !e->purge)
+        match = true;
+      break;
+    default:
+      break;
+  }
 
-    if (match && (!changed || e->changed))
-    {
-      count++;
-      if (setstart == 0)
-      {
-        setstart = imap_edata_get(e)->uid;
-        if (started)
-        {
-          mutt_buffer_add_printf(buf, ",%u", imap_edata_get(e)->uid);
-        }
-        else
-        {
-          mutt_buffer_add_printf(buf, "%u", imap_edata_get(e)->uid);
-          started = true;
-        }
-      }
-      /* tie up if the last message also matches */
-      else if (n == (m->msg_count - 1))
-        mutt_buffer_add_printf(buf, ":%u", imap_edata_get(e)->uid);
-    }
-    /* End current set if message doesn't match. */
-    else if (setstart)
+  return match && (!changed || e->changed);
+}
+
+/**
+ * make_uid_set - Append a range-compressed UID set to a command
+ * @param[in]  uids Sorted array of UIDs
+ * @param[in]  buf  Buffer to store the message set
+ * @param[out] pos  Cursor used for multiple calls to this function
+ * @retval num UIDs consumed from the array
+ *
+ * Runs of consecutive UIDs are compressed into lo:hi ranges.  Emission stops
+ * once the command grows past #IMAP_MAX_CMDLEN; the cursor lets the remainder
+ * be sent as a follow-up command.  Pos should be 0 at first call.
+ */
+static int make_uid_set(const struct UidArray *uids, struct Buffer *buf, size_t *pos)
+{
+  int count = 0; /* number of UIDs in the set */
+  size_t n = *pos;
+
+  while ((n < ARRAY_SIZE(uids)) && (mutt_buffer_len(buf) < IMAP_MAX_CMDLEN))
+  {
+    const unsigned int start = *ARRAY_GET(uids, n);
+    unsigned int end = start;
+    size_t run = 1;
+
+    /* extend the range while the UIDs are contiguous (or duplicated) */
+    while ((n + run) < ARRAY_SIZE(uids))
     {
-      if (imap_edata_get(m->emails[n - 1])->uid > setstart)
-        mutt_buffer_add_printf(buf, ":%u", imap_edata_get(m->emails[n - 1])->uid);
-      setstart = 0;
+      const unsigned int next = *ARRAY_GET(uids, n + run);
+      if ((next != end) && (next != (end + 1)))
+        break;
+      end = next;
+      run++;
     }
+
+    mutt_buffer_add_printf(buf, (count != 0) ? ",%u" : "%u", start);
+    if (end > start)
+      mutt_buffer_add_printf(buf, ":%u", end);
+
+    count += run;
+    n += run;
   }
 
   *pos = n;
@@ -458,6 +458,7 @@ int imap_create_mailbox(struct ImapAccountData *adata, const char *mailbox)
     return -1;
   }
 
+  imap_browse_cache_clear(adata);
   return 0;
 }
 
@@ -500,6 +501,8 @@ int imap_rename_mailbox(struct ImapAccountData *adata, char *oldname, const char
 
   if (imap_exec(adata, mutt_buffer_string(buf), IMAP_CMD_NO_FLAGS) != IMAP_EXEC_SUCCESS)
     rc = -1;
+  else
+    imap_browse_cache_clear(adata);
 
   mutt_buffer_pool_release(&buf);
 
@@ -526,6 +529,7 @@ int imap_delete_mailbox(struct Mailbox *m, char *path)
   if (imap_exec(m->account->adata, buf, IMAP_CMD_NO_FLAGS) != IMAP_EXEC_SUCCESS)
     return -1;
 
+  imap_browse_cache_clear(adata);
   return 0;
 }
 
@@ -581,6 +585,8 @@ void imap_logout_all(void)
     imap_logout(np->adata);
     mutt_clear_error();
   }
+
+  imap_utf7_cleanup();
 }
 
 /**
@@ -592,7 +598,8 @@ void imap_logout_all(void)
  * @retval  0 Success
  * @retval -1 Failure
  *
- * Not explicitly buffered, relies on FILE buffering.
+ * The literal is consumed in blocks straight off the Connection's read
+ * buffer, rather than one mutt_socket_readchar() round-trip per byte.
  *
  * @note Strips `\r` from `\r\n`.
  *       Apparently even literals use `\r\n`-terminated strings ?!
@@ -600,7 +607,6 @@ void imap_logout_all(void)
 int imap_read_literal(FILE *fp, struct ImapAccountData *adata,
                       unsigned long bytes, struct Progress *pbar)
 {
-  char c;
   bool r = false;
   struct Buffer buf = { 0 }; // Do not allocate, maybe it won't be used
 
@@ -610,9 +616,11 @@ int imap_read_literal(FILE *fp, struct ImapAccountData *adata,
 
   mutt_debug(LL_DEBUG2, "reading %ld bytes\n", bytes);
 
-  for (unsigned long pos = 0; pos < bytes; pos++)
+  for (unsigned long pos = 0; pos < bytes;)
   {
-    if (mutt_socket_readchar(adata->conn, &c) != 1)
+    const char *chunk = NULL;
+    const int clen = mutt_socket_read_buf(adata->conn, &chunk, bytes - pos);
+    if (clen <= 0)
     {
       mutt_debug(LL_DEBUG1, "error during read, %ld bytes read\n", pos);
       adata->status = IMAP_FATAL;
@@ -620,26 +628,48 @@ int imap_read_literal(FILE *fp, struct ImapAccountData *adata,
       mutt_buffer_dealloc(&buf);
       return -1;
     }
+    pos += clen;
 
-    if (r && (c != '\n'))
-      fputc('\r', fp);
-
-    if (c == '\r')
+    /* Write the chunk in runs delimited by '\r'.  A '\r' is held back until
+     * the next byte shows whether it starts a "\r\n" (possibly across a
+     * chunk boundary) */
+    size_t i = 0;
+    while (i < (size_t) clen)
     {
-      r = true;
-      continue;
-    }
-    else
-      r = false;
+      if (r)
+      {
+        if (chunk[i] != '\n')
+        {
+          fputc('\r', fp);
+          if (c_debug_level >= IMAP_LOG_LTRL)
+            mutt_buffer_addch(&buf, '\r');
+        }
+        r = false;
+      }
 
-    fputc(c, fp);
+      const char *cr = memchr(chunk + i, '\r', clen - i);
+      const size_t run = (cr ? (size_t) (cr - chunk) : (size_t) clen) - i;
+      if (run != 0)
+      {
+        fwrite(chunk + i, 1, run, fp);
+        if (c_debug_level >= IMAP_LOG_LTRL)
+          mutt_buffer_addstr_n(&buf, chunk + i, run);
+      }
+      i += run;
+      if (cr)
+      {
+        i++;
+        r = true;
+      }
+    }
 
-    if (pbar && !(pos % 1024))
+    if (pbar)
       progress_update(pbar, pos, -1);
-    if (c_debug_level >= IMAP_LOG_LTRL)
-      mutt_buffer_addch(&buf, c);
   }
 
+  /* Note: like the old byte-wise reader, a '\r' ending the literal is
+   * swallowed */
+
   if (c_debug_level >= IMAP_LOG_LTRL)
   {
     mutt_debug(IMAP_LOG_LTRL, "\n%s", buf.data);
@@ -899,15 +929,12 @@ bool imap_has_flag(struct ListHead *flag_list, const char *flag)
 }
 
 /**
- * compare_uid - Compare two Emails by UID - Implements ::sort_t - @ingroup sort_api
+ * compare_uid - Compare two UIDs - Implements ::sort_t - @ingroup sort_api
  */
 static int compare_uid(const void *a, const void *b)
 {
-  const struct Email *ea = *(struct Email const *const *) a;
-  const struct Email *eb = *(struct Email const *const *) b;
-
-  const unsigned int ua = imap_edata_get((struct Email *) ea)->uid;
-  const unsigned int ub = imap_edata_get((struct Email *) eb)->uid;
+  const unsigned int ua = *(const unsigned int *) a;
+  const unsigned int ub = *(const unsigned int *) b;
 
   return mutt_numeric_cmp(ua, ub);
 }
@@ -934,57 +961,43 @@ int imap_exec_msgset(struct Mailbox *m, const char *pre, const char *post,
   if (!adata || (adata->mailbox != m))
     return -1;
 
-  struct Email **emails = NULL;
-  int pos;
-  int rc;
-  int count = 0;
-
+  struct UidArray uids = ARRAY_HEAD_INITIALIZER;
   struct Buffer cmd = mutt_buffer_make(0);
+  int rc;
 
-  /* We make a copy of the headers just in case resorting doesn't give
-   exactly the original order (duplicate messages?), because other parts of
-   the ctx are tied to the header order. This may be overkill. */
-  const short c_sort = cs_subset_sort(NeoMutt->sub, "sort");
-  if (c_sort != SORT_ORDER)
+  /* Collect the matching UIDs and sort them, rather than resorting the whole
+   * Mailbox.  The set is range-compressed the same way regardless of how the
+   * index happens to be sorted. */
+  for (int i = 0; i < m->msg_count; i++)
   {
-    emails = m->emails;
-    // We overcommit here, just in case new mail arrives whilst we're sync-ing
-    m->emails = mutt_mem_malloc(m->email_max * sizeof(struct Email *));
-    memcpy(m->emails, emails, m->email_max * sizeof(struct Email *));
-
-    cs_subset_str_native_set(NeoMutt->sub, "sort", SORT_ORDER, NULL);
-    qsort(m->emails, m->msg_count, sizeof(struct Email *), compare_uid);
+    struct Email *e = m->emails[i];
+    if (!e)
+      break;
+    if (msg_matches(e, flag, changed, invert))
+      ARRAY_ADD(&uids, imap_edata_get(e)->uid);
   }
+  ARRAY_SORT(&uids, compare_uid);
 
-  pos = 0;
-
-  do
+  size_t pos = 0;
+  while (pos < ARRAY_SIZE(&uids))
   {
     mutt_buffer_reset(&cmd);
     mutt_buffer_add_printf(&cmd, "%s ", pre);
-    rc = make_msg_set(m, &cmd, flag, changed, invert, &pos);
-    if (rc > 0)
+    if (make_uid_set(&uids, &cmd, &pos) == 0)
+      break;
+    mutt_buffer_add_printf(&cmd, " %s", post);
+    if (imap_exec(adata, cmd.data, IMAP_CMD_QUEUE) != IMAP_EXEC_SUCCESS)
     {
-      mutt_buffer_add_printf(&cmd, " %s", post);
-      if (imap_exec(adata, cmd.data, IMAP_CMD_QUEUE) != IMAP_EXEC_SUCCESS)
-      {
-        rc = -1;
-        goto out;
-      }
-      count += rc;
+      rc = -1;
+      goto out;
     }
-  } while (rc > 0);
+  }
 
-  rc = count;
+  rc = ARRAY_SIZE(&uids);
 
 out:
   mutt_buffer_dealloc(&cmd);
-  if (c_sort != SORT_ORDER)
-  {
-    cs_subset_str_native_set(NeoMutt->sub, "sort", c_sort, NULL);
-    FREE(&m->emails);
-    m->emails = emails;
-  }
+  ARRAY_FREE(&uids);
 
   return rc;
 }
@@ -1125,7 +1138,8 @@ enum MxStatus imap_check_mailbox(struct Mailbox *m, bool force)
     if (imap_cmd_idle(adata) < 0)
       return MX_STATUS_ERROR;
   }
-  if (adata->state == IMAP_IDLE)
+  /* NOTIFY pushes responses without IDLE, so read the socket in that case too */
+  if ((adata->state == IMAP_IDLE) || adata->notify_enabled)
   {
     while ((rc = mutt_socket_poll(adata->conn, 0)) > 0)
     {
@@ -1194,6 +1208,19 @@ static int imap_status(struct ImapAccountData *adata, struct ImapMboxData *mdata
     return mdata->messages;
   }
 
+  /* With NOTIFY active the server pushes STATUS updates as mailboxes
+   * change, so polling them is redundant - just drain any pushed responses
+   * and report the counts we already have.  The filter only covers the
+   * selected and subscribed mailboxes, though, so a mailbox the server has
+   * never pushed a STATUS for still needs a real poll. */
+  if (adata->notify_enabled && mdata->notify_covered)
+  {
+    while (mutt_socket_poll(adata->conn, 0) > 0)
+      if (imap_cmd_step(adata) != IMAP_RES_CONTINUE)
+        break;
+    return mdata->messages;
+  }
+
   if (adata->capabilities & IMAP_CAP_IMAP4REV1)
     uidvalidity_flag = "UIDVALIDITY";
   else if (adata->capabilities & IMAP_CAP_STATUS)
@@ -1207,10 +1234,15 @@ static int imap_status(struct ImapAccountData *adata, struct ImapMboxData *mdata
   snprintf(cmd, sizeof(cmd), "STATUS %s (UIDNEXT %s UNSEEN RECENT MESSAGES)",
            mdata->munge_name, uidvalidity_flag);
 
+  /* remember that the next STATUS for this mailbox was asked for, so it
+   * isn't mistaken for one pushed by NOTIFY */
+  mdata->status_pending++;
   int rc = imap_exec(adata, cmd, queue ? IMAP_CMD_QUEUE : IMAP_CMD_NO_FLAGS | IMAP_CMD_POLL);
   if (rc < 0)
   {
     mutt_debug(LL_DEBUG1, "Error queueing command\n");
+    if (mdata->status_pending != 0)
+      mdata->status_pending--;
     return rc;
   }
   return mdata->messages;
@@ -1279,6 +1311,33 @@ int imap_mailbox_status(struct Mailbox *m, bool queue)
   return imap_status(adata, mdata, queue);
 }
 
+/**
+ * imap_flush_queued - Send an Account's queued commands and read the responses
+ * @param a Account
+ * @retval  0 Success, or nothing was queued
+ * @retval -1 Error
+ *
+ * Queued commands, e.g. the STATUS polls of unselected mailboxes, accumulate
+ * in the pipeline until something else talks to the server.  Flushing sends
+ * the whole batch in one write and collects the tagged replies, so polling N
+ * folders costs one round trip per pipeline window, not N - and the results
+ * are current instead of trailing a poll cycle behind.
+ */
+int imap_flush_queued(struct Account *a)
+{
+  if (!a || (a->type != MUTT_IMAP) || !a->adata)
+    return 0;
+
+  struct ImapAccountData *adata = a->adata;
+  if ((adata->status == IMAP_FATAL) || mutt_buffer_is_empty(&adata->cmdbuf))
+    return 0;
+
+  if (imap_exec(adata, NULL, IMAP_CMD_POLL) != IMAP_EXEC_SUCCESS)
+    return -1;
+
+  return 0;
+}
+
 /**
  * imap_subscribe - Subscribe to a mailbox
  * @param path      Mailbox path
@@ -1309,6 +1368,8 @@ int imap_subscribe(char *path, bool subscribe)
     return -1;
   }
 
+  imap_browse_cache_clear(adata); // (un)subscribing changes the LSUB results
+
   const bool c_imap_check_subscribed =
       cs_subset_bool(NeoMutt->sub, "imap_check_subscribed");
   if (c_imap_check_subscribed)
@@ -1539,7 +1600,6 @@ enum MxStatus imap_sync_mailbox(struct Mailbox *m, bool expunge, bool close)
   if (!m)
     return -1;
 
-  struct Email **emails = NULL;
   int rc;
 
   struct ImapAccountData *adata = imap_adata_get(m);
@@ -1643,18 +1703,6 @@ enum MxStatus imap_sync_mailbox(struct Mailbox *m, bool expunge, bool close)
   imap_hcache_close(mdata);
 #endif
 
-  /* presort here to avoid doing 10 resorts in imap_exec_msgset */
-  const short c_sort = cs_subset_sort(NeoMutt->sub, "sort");
-  if (c_sort != SORT_ORDER)
-  {
-    emails = m->emails;
-    m->emails = mutt_mem_malloc(m->msg_count * sizeof(struct Email *));
-    memcpy(m->emails, emails, m->msg_count * sizeof(struct Email *));
-
-    cs_subset_str_native_set(NeoMutt->sub, "sort", SORT_ORDER, NULL);
-    qsort(m->emails, m->msg_count, sizeof(struct Email *), compare_uid);
-  }
-
   rc = sync_helper(m, MUTT_ACL_DELETE, MUTT_DELETED, "\\Deleted");
   if (rc >= 0)
     rc |= sync_helper(m, MUTT_ACL_WRITE, MUTT_FLAG, "\\Flagged");
@@ -1665,13 +1713,6 @@ enum MxStatus imap_sync_mailbox(struct Mailbox *m, bool expunge, bool close)
   if (rc >= 0)
     rc |= sync_helper(m, MUTT_ACL_WRITE, MUTT_REPLIED, "\\Answered");
 
-  if (c_sort != SORT_ORDER)
-  {
-    cs_subset_str_native_set(NeoMutt->sub, "sort", c_sort, NULL);
-    FREE(&m->emails);
-    m->emails = emails;
-  }
-
   /* Flush the queued flags if any were changed in sync_helper. */
   if (rc > 0)
     if (imap_exec(adata, NULL, IMAP_CMD_NO_FLAGS) != IMAP_EXEC_SUCCESS)
@@ -1857,6 +1898,21 @@ int imap_login(struct ImapAccountData *adata)
   if (adata->state == IMAP_DISCONNECTED)
   {
     mutt_buffer_reset(&adata->cmdbuf); // purge outstanding queued commands
+    adata->notify_enabled = false;
+    if (adata->account)
+    {
+      /* NOTIFY state doesn't survive the connection */
+      struct MailboxNode *np = NULL;
+      STAILQ_FOREACH(np, &adata->account->mailboxes, entries)
+      {
+        struct ImapMboxData *mdata = imap_mdata_get(np->mailbox);
+        if (mdata)
+        {
+          mdata->notify_covered = false;
+          mdata->status_pending = 0;
+        }
+      }
+    }
     imap_open_connection(adata);
   }
   if (adata->state == IMAP_CONNECTED)
@@ -1906,6 +1962,27 @@ int imap_login(struct ImapAccountData *adata)
         imap_exec(adata, "ENABLE QRESYNC", IMAP_CMD_QUEUE);
     }
 
+    /* enable RFC5465 push notifications.  The STATUS atom makes the server
+     * send an immediate STATUS for every subscribed mailbox, priming the
+     * counts, then push updates as they change - so `$mail_check` polling
+     * becomes a fallback rather than the only source of new-mail events. */
+    const bool c_imap_notify = cs_subset_bool(NeoMutt->sub, "imap_notify");
+    if (c_imap_notify && (adata->capabilities & IMAP_CAP_NOTIFY))
+    {
+      /* Run it synchronously and check the tagged reply: if the server
+       * rejects the filter, we must keep polling with STATUS.  The flag is
+       * raised before the exec so the STATUS burst the command triggers is
+       * recognised as pushed, and lowered again on NO/BAD. */
+      adata->notify_enabled = true;
+      if (imap_exec(adata,
+                    "NOTIFY SET STATUS (SELECTED (MessageNew MessageExpunge FlagChange)) "
+                    "(SUBSCRIBED (MessageNew MessageExpunge))",
+                    IMAP_CMD_NO_FLAGS) != IMAP_EXEC_SUCCESS)
+      {
+        adata->notify_enabled = false;
+      }
+    }
+
     /* get root delimiter, '/' as default */
     adata->delim = '/';
     imap_exec(adata, "LIST \"\" \"\"", IMAP_CMD_QUEUE);
@@ -2393,12 +2470,91 @@ static int imap_tags_commit(struct Mailbox *m, struct Email *e, const char *buf)
   /* We are good sync them */
   mutt_debug(LL_DEBUG1, "NEW TAGS: %s\n", buf);
   driver_tags_replace(&e->tags, buf);
+  e->index_color_valid = false;
+  FREE(&e->display); /* the index line may show the tags */
   FREE(&imap_edata_get(e)->flags_remote);
   imap_edata_get(e)->flags_remote = driver_tags_get_with_hidden(&e->tags);
   imap_msg_save_hcache(m, e);
   return 0;
 }
 
+/**
+ * imap_tags_commit_tagged - Save the tags of all tagged messages
+ * @param m   Mailbox
+ * @param buf String containing the new tags
+ * @retval  0 Success
+ * @retval -1 Failure
+ *
+ * Batch version of imap_tags_commit() for `<tag-prefix>`: the per-message
+ * removal of the old custom flags is queued and the new flags are added with
+ * one "UID STORE" per message set, so the whole operation costs a handful of
+ * server round trips instead of two per message.
+ */
+int imap_tags_commit_tagged(struct Mailbox *m, const char *buf)
+{
+  struct ImapAccountData *adata = imap_adata_get(m);
+  if (!adata || (adata->mailbox != m))
+    return -1;
+
+  if (*buf == '\0')
+    buf = NULL;
+
+  if (!(adata->mailbox->rights & MUTT_ACL_WRITE))
+    return 0;
+
+  int rc = -1;
+  struct Buffer cmd = mutt_buffer_make(128);
+
+  /* Remove the old custom flags.  These differ per message, so queue one
+   * STORE for each, letting them share round trips. */
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      break;
+    if (!e->tagged || !imap_edata_get(e)->flags_remote)
+      continue;
+
+    mutt_buffer_printf(&cmd, "UID STORE %u -FLAGS.SILENT (%s)",
+                       imap_edata_get(e)->uid, imap_edata_get(e)->flags_remote);
+    if (imap_exec(adata, cmd.data, IMAP_CMD_QUEUE) != IMAP_EXEC_SUCCESS)
+      goto out;
+  }
+
+  /* Add the new flags to the whole message set at once */
+  if (buf)
+  {
+    mutt_buffer_printf(&cmd, "+FLAGS.SILENT (%s)", buf);
+    if (imap_exec_msgset(m, "UID STORE", cmd.data, MUTT_TAG, false, false) < 0)
+      goto out;
+  }
+
+  if (imap_exec(adata, NULL, IMAP_CMD_NO_FLAGS) != IMAP_EXEC_SUCCESS)
+    goto out;
+
+  /* We are good, sync them */
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      break;
+    if (!e->tagged)
+      continue;
+
+    driver_tags_replace(&e->tags, buf);
+    e->index_color_valid = false;
+    FREE(&e->display); /* the index line may show the tags */
+    FREE(&imap_edata_get(e)->flags_remote);
+    imap_edata_get(e)->flags_remote = driver_tags_get_with_hidden(&e->tags);
+    imap_msg_save_hcache(m, e);
+  }
+  rc = 0;
+
+out:
+  mutt_buffer_dealloc(&cmd);
+  return rc;
+}
+
 /**
  * imap_path_probe - Is this an IMAP Mailbox? - Implements MxOps::path_probe() - @ingroup mx_path_probe
  */
@@ -77,12 +77,14 @@ int imap_delete_mailbox(struct Mailbox *m, char *path);
 int imap_sync_mailbox(struct Mailbox *m, bool expunge, bool close);
 int imap_path_status(const char *path, bool queue);
 int imap_mailbox_status(struct Mailbox *m, bool queue);
+int imap_flush_queued(struct Account *a);
 int imap_subscribe(char *path, bool subscribe);
 int imap_complete(char *buf, size_t buflen, const char *path);
 int imap_fast_trash(struct Mailbox *m, const char *dest);
 enum MailboxType imap_path_probe(const char *path, const struct stat *st);
 int imap_path_canon(char *buf, size_t buflen);
 void imap_notify_delete_email(struct Mailbox *m, struct Email *e);
+int imap_tags_commit_tagged(struct Mailbox *m, const char *buf);
 
 extern struct MxOps MxImapOps;
 
@@ -93,6 +95,7 @@ int imap_mailbox_rename(const char *path);
 
 /* message.c */
 int imap_copy_messages(struct Mailbox *m, struct EmailList *el, const char *dest, enum MessageSaveOpt save_opt);
+int imap_fetch_structure(struct Mailbox *m, struct Email *e);
 
 /* socket.c */
 void imap_logout_all(void);
@@ -53,6 +53,8 @@ struct ImapMboxData
   unsigned int messages;
   unsigned int recent;
   unsigned int unseen;
+  unsigned int status_pending; ///< Our own STATUS commands awaiting a reply
+  bool notify_covered;         ///< Server pushed a STATUS for this mailbox (RFC5465 NOTIFY)
 
   // Cached data used only when the mailbox is opened
   struct HashTable *uid_hash;
@@ -67,9 +67,184 @@
 #ifdef USE_HCACHE
 #include "hcache/lib.h"
 #endif
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 
 struct BodyCache;
 
+#if defined(HAVE_PTHREAD_CREATE) && defined(HAVE_FMEMOPEN)
+/// Maximum number of raw headers waiting to be parsed
+#define IMAP_PIPE_MAX 128
+
+/**
+ * struct ImapParseJob - A fetched header waiting for the parse stage
+ */
+struct ImapParseJob
+{
+  struct Email *e;                     ///< Email to fill in (main thread owns it again after the drain)
+  char *hdr;                           ///< Raw header text (owned)
+  size_t hlen;                         ///< Length of the header text
+  long content_length;                 ///< RFC822.SIZE reported by the server
+  STAILQ_ENTRY(ImapParseJob) entries;  ///< Linked list
+};
+STAILQ_HEAD(ImapParseJobList, ImapParseJob);
+
+/**
+ * struct ImapParsePipe - Overlap header parsing with the network transfer
+ *
+ * The main thread keeps the socket saturated and hands each raw header block
+ * to a single parse thread, which runs mutt_rfc822_read_header() and fills
+ * the header cache.  The queue is bounded so a slow parser backpressures the
+ * reader instead of buffering the whole folder.
+ */
+struct ImapParsePipe
+{
+  pthread_t thread;               ///< Parse thread
+  pthread_mutex_t mutex;          ///< Protects the fields below
+  pthread_cond_t work;            ///< Jobs were queued, or stop was set
+  pthread_cond_t room;            ///< The parser freed space in the queue
+  struct ImapParseJobList list;   ///< Queued jobs
+  size_t len;                     ///< Number of queued jobs
+  bool stop;                      ///< Tell the parser to finish up
+  struct ImapMboxData *mdata;     ///< Mailbox data, for the header cache
+};
+
+/**
+ * imap_pipe_parse - Parse one fetched header
+ * @param pipe Parse pipeline
+ * @param job  Job to parse
+ */
+static void imap_pipe_parse(struct ImapParsePipe *pipe, struct ImapParseJob *job)
+{
+  FILE *fp = fmemopen(job->hdr, job->hlen, "r");
+  if (fp)
+  {
+    /* if the Date: header is missing, mutt_rfc822_read_header depends on
+     * e->received, which the main thread has already set */
+    job->e->env = mutt_rfc822_read_header(fp, job->e, false, false);
+    job->e->body->length = job->content_length;
+    mutt_file_fclose(&fp);
+#ifdef USE_HCACHE
+    imap_hcache_put(pipe->mdata, job->e);
+#endif
+  }
+  FREE(&job->hdr);
+  FREE(&job);
+}
+
+/**
+ * imap_pipe_main - Parse thread of an ImapParsePipe
+ * @param arg ImapParsePipe to drain
+ * @retval NULL Always
+ */
+static void *imap_pipe_main(void *arg)
+{
+  struct ImapParsePipe *pipe = arg;
+
+  pthread_mutex_lock(&pipe->mutex);
+  while (true)
+  {
+    while ((pipe->len == 0) && !pipe->stop)
+      pthread_cond_wait(&pipe->work, &pipe->mutex);
+    if (pipe->len == 0)
+      break; // stop was set and the queue is drained
+
+    struct ImapParseJob *job = STAILQ_FIRST(&pipe->list);
+    STAILQ_REMOVE_HEAD(&pipe->list, entries);
+    pipe->len--;
+    pthread_cond_signal(&pipe->room);
+    pthread_mutex_unlock(&pipe->mutex);
+
+    imap_pipe_parse(pipe, job);
+
+    pthread_mutex_lock(&pipe->mutex);
+  }
+  pthread_mutex_unlock(&pipe->mutex);
+  return NULL;
+}
+
+/**
+ * imap_pipe_new - Create a parse pipeline with its thread
+ * @param mdata Imap Mailbox data
+ * @retval ptr  New pipeline
+ * @retval NULL The thread couldn't be created; parse inline instead
+ */
+static struct ImapParsePipe *imap_pipe_new(struct ImapMboxData *mdata)
+{
+  struct ImapParsePipe *pipe = mutt_mem_calloc(1, sizeof(struct ImapParsePipe));
+  STAILQ_INIT(&pipe->list);
+  pipe->mdata = mdata;
+  pthread_mutex_init(&pipe->mutex, NULL);
+  pthread_cond_init(&pipe->work, NULL);
+  pthread_cond_init(&pipe->room, NULL);
+
+  if (pthread_create(&pipe->thread, NULL, imap_pipe_main, pipe) != 0)
+  {
+    pthread_cond_destroy(&pipe->room);
+    pthread_cond_destroy(&pipe->work);
+    pthread_mutex_destroy(&pipe->mutex);
+    FREE(&pipe);
+  }
+  return pipe;
+}
+
+/**
+ * imap_pipe_push - Hand one header to the parse stage
+ * @param pipe           Parse pipeline
+ * @param e              Email to fill in
+ * @param hdr            Raw header text (ownership is transferred)
+ * @param hlen           Length of the header text
+ * @param content_length RFC822.SIZE reported by the server
+ *
+ * Blocks while the queue is full.  The caller must not touch @a e again
+ * until imap_pipe_free().
+ */
+static void imap_pipe_push(struct ImapParsePipe *pipe, struct Email *e,
+                           char *hdr, size_t hlen, long content_length)
+{
+  struct ImapParseJob *job = mutt_mem_calloc(1, sizeof(struct ImapParseJob));
+  job->e = e;
+  job->hdr = hdr;
+  job->hlen = hlen;
+  job->content_length = content_length;
+
+  pthread_mutex_lock(&pipe->mutex);
+  while (pipe->len >= IMAP_PIPE_MAX)
+    pthread_cond_wait(&pipe->room, &pipe->mutex);
+  STAILQ_INSERT_TAIL(&pipe->list, job, entries);
+  pipe->len++;
+  pthread_cond_signal(&pipe->work);
+  pthread_mutex_unlock(&pipe->mutex);
+}
+
+/**
+ * imap_pipe_free - Drain a parse pipeline and free it
+ * @param[out] ptr Pipeline to free
+ *
+ * Every queued header is parsed before the thread is joined, so all the
+ * handed-off Emails are complete afterwards.
+ */
+static void imap_pipe_free(struct ImapParsePipe **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct ImapParsePipe *pipe = *ptr;
+
+  pthread_mutex_lock(&pipe->mutex);
+  pipe->stop = true;
+  pthread_cond_broadcast(&pipe->work);
+  pthread_mutex_unlock(&pipe->mutex);
+  pthread_join(pipe->thread, NULL);
+
+  pthread_cond_destroy(&pipe->room);
+  pthread_cond_destroy(&pipe->work);
+  pthread_mutex_destroy(&pipe->mutex);
+  FREE(ptr);
+}
+#endif /* HAVE_PTHREAD_CREATE && HAVE_FMEMOPEN */
+
 /**
  * msg_cache_open - Open a message cache
  * @param m     Selected Imap Mailbox
@@ -161,6 +336,148 @@ static int msg_cache_commit(struct Mailbox *m, struct Email *e)
   return mutt_bcache_commit(mdata->bcache, id);
 }
 
+/**
+ * imap_msg_prefetch - Speculatively fetch upcoming message bodies
+ * @param m     Selected Imap Mailbox
+ * @param e_cur Email the user has just opened
+ *
+ * Fetch the bodies of the next few visible messages into the body cache with
+ * one pipelined `UID FETCH`, so following the thread with `<next-entry>`
+ * becomes a local-disk read instead of a round-trip per message.  Runs on
+ * the selected connection between user commands and uses BODY.PEEK, so the
+ * prefetched messages stay unread.  Controlled by $imap_prefetch_count.
+ */
+static void imap_msg_prefetch(struct Mailbox *m, struct Email *e_cur)
+{
+  struct ImapAccountData *adata = imap_adata_get(m);
+  struct ImapMboxData *mdata = imap_mdata_get(m);
+
+  const short c_imap_prefetch_count =
+      cs_subset_number(NeoMutt->sub, "imap_prefetch_count");
+  if ((c_imap_prefetch_count < 1) || !adata || (adata->mailbox != m) ||
+      !e_cur || (e_cur->vnum < 0))
+  {
+    return;
+  }
+
+  /* Without IMAP4rev1 there is no BODY.PEEK, and RFC822 would mark the
+   * speculated messages as read */
+  if (!(adata->capabilities & IMAP_CAP_IMAP4REV1))
+    return;
+
+  mdata->bcache = msg_cache_open(m);
+  if (!mdata->bcache)
+    return;
+
+  struct Email **fetches =
+      mutt_mem_calloc(c_imap_prefetch_count, sizeof(struct Email *));
+  struct Buffer *uids = mutt_buffer_pool_get();
+  int num = 0;
+
+  for (int v = e_cur->vnum + 1; (v < m->vcount) && (num < c_imap_prefetch_count); v++)
+  {
+    struct Email *e = m->emails[m->v2r[v]];
+    if (!e || !e->active || e->deleted)
+      continue;
+
+    char id[64];
+    snprintf(id, sizeof(id), "%u-%u", mdata->uidvalidity, imap_edata_get(e)->uid);
+    if (mutt_bcache_exists(mdata->bcache, id) == 0)
+      continue;
+
+    if (!mutt_buffer_is_empty(uids))
+      mutt_buffer_addch(uids, ',');
+    mutt_buffer_add_printf(uids, "%u", imap_edata_get(e)->uid);
+    fetches[num] = e;
+    num++;
+  }
+
+  if (num == 0)
+    goto cleanup;
+
+  /* Mark the candidates inactive, so the command handler won't also try to
+   * update them - same HACK as in imap_msg_open() */
+  for (int i = 0; i < num; i++)
+    fetches[i]->active = false;
+
+  {
+    struct Buffer *cmd = mutt_buffer_pool_get();
+    mutt_buffer_printf(cmd, "UID FETCH %s BODY.PEEK[]", mutt_buffer_string(uids));
+    imap_cmd_start(adata, mutt_buffer_string(cmd));
+    mutt_buffer_pool_release(&cmd);
+  }
+
+  int rc;
+  do
+  {
+    rc = imap_cmd_step(adata);
+    if (rc != IMAP_RES_CONTINUE)
+      break;
+
+    char *pc = imap_next_word(imap_next_word(adata->buf));
+    if (!mutt_istr_startswith(pc, "FETCH"))
+      continue;
+
+    struct Email *e = NULL;
+    while (*pc)
+    {
+      pc = imap_next_word(pc);
+      if (pc[0] == '(')
+        pc++;
+      if (mutt_istr_startswith(pc, "UID"))
+      {
+        unsigned int uid = 0;
+        pc = imap_next_word(pc);
+        if (!mutt_str_atoui(pc, &uid))
+          goto restore;
+        e = mutt_hash_int_find(mdata->uid_hash, uid);
+      }
+      else if (mutt_istr_startswith(pc, "BODY[]"))
+      {
+        pc = imap_next_word(pc);
+        unsigned int bytes = 0;
+        if (imap_get_literal_count(pc, &bytes) < 0)
+          goto restore;
+
+        /* If the server sends BODY[] before UID we don't know the target
+         * yet; consume the literal into a scratch file and just lose the
+         * optimisation for this message */
+        bool discard = false;
+        FILE *fp = e ? msg_cache_put(m, e) : NULL;
+        if (!fp)
+        {
+          fp = mutt_file_mkstemp();
+          discard = true;
+          if (!fp)
+            goto restore; // can't consume the literal
+        }
+
+        const int res = imap_read_literal(fp, adata, bytes, NULL);
+        fflush(fp);
+        if ((res == 0) && !discard && !ferror(fp))
+          msg_cache_commit(m, e);
+        mutt_file_fclose(&fp);
+        if (res < 0)
+          goto restore;
+
+        /* pick up trailing line */
+        rc = imap_cmd_step(adata);
+        if (rc != IMAP_RES_CONTINUE)
+          goto restore;
+        pc = adata->buf;
+      }
+    }
+  } while (rc == IMAP_RES_CONTINUE);
+
+restore:
+  for (int i = 0; i < num; i++)
+    fetches[i]->active = true;
+
+cleanup:
+  mutt_buffer_pool_release(&uids);
+  FREE(&fetches);
+}
+
 /**
  * msg_cache_clean_cb - Delete an entry from the message cache - Implements ::bcache_list_t - @ingroup bcache_list_api
  * @retval 0 Always
@@ -390,6 +707,259 @@ static int msg_parse_fetch(struct ImapHeader *h, char *s)
   return 0;
 }
 
+/**
+ * bs_skip_element - Skip one element of a BODYSTRUCTURE response
+ * @param s Cursor into the response string
+ * @retval  0 Success
+ * @retval -1 The response is malformed or truncated
+ *
+ * An element is a quoted string, an atom (including NIL and numbers), or a
+ * balanced parenthesised list.  Literals can't be skipped - the data isn't on
+ * this line - so they count as malformed.
+ */
+static int bs_skip_element(char **s)
+{
+  *s = mutt_str_skip_whitespace(*s);
+
+  if (**s == '(')
+  {
+    (*s)++;
+    while (**s != ')')
+    {
+      if (bs_skip_element(s) < 0)
+        return -1;
+      *s = mutt_str_skip_whitespace(*s);
+    }
+    (*s)++;
+    return 0;
+  }
+
+  if (**s == '"')
+  {
+    for ((*s)++; **s != '"'; (*s)++)
+    {
+      if (**s == '\\')
+        (*s)++;
+      if (**s == '\0')
+        return -1;
+    }
+    (*s)++;
+    return 0;
+  }
+
+  if ((**s == '\0') || (**s == '{'))
+    return -1;
+
+  while (**s && (**s != ' ') && (**s != '(') && (**s != ')'))
+    (*s)++;
+  return 0;
+}
+
+/**
+ * bs_parse_string - Parse a string element of a BODYSTRUCTURE response
+ * @param[in]  s   Cursor into the response string
+ * @param[out] str Parsed string, or NULL for NIL
+ * @retval  0 Success
+ * @retval -1 The element isn't a string
+ */
+static int bs_parse_string(char **s, char **str)
+{
+  *str = NULL;
+  *s = mutt_str_skip_whitespace(*s);
+
+  if (**s == '"')
+  {
+    char *end = NULL;
+    for (end = *s + 1; *end != '"'; end++)
+    {
+      if (*end == '\\')
+        end++;
+      if (*end == '\0')
+        return -1;
+    }
+    *str = mutt_strn_dup(*s + 1, end - *s - 1);
+    *s = end + 1;
+    return 0;
+  }
+
+  if (mutt_istr_startswith(*s, "NIL"))
+  {
+    *s += 3;
+    return 0;
+  }
+
+  return -1;
+}
+
+/**
+ * bs_parse_params - Parse a parameter list of a BODYSTRUCTURE response
+ * @param s  Cursor into the response string
+ * @param pl Parameters are added to this list
+ * @retval  0 Success
+ * @retval -1 The response is malformed
+ *
+ * Parameters are sent as a flat list of attribute/value string pairs,
+ * e.g. ("CHARSET" "utf-8" "NAME" "patch.txt"), or NIL if there are none.
+ */
+static int bs_parse_params(char **s, struct ParameterList *pl)
+{
+  *s = mutt_str_skip_whitespace(*s);
+
+  if (**s != '(')
+    return bs_skip_element(s); /* NIL */
+
+  (*s)++;
+  *s = mutt_str_skip_whitespace(*s);
+  while (**s != ')')
+  {
+    char *attr = NULL;
+    char *value = NULL;
+    if ((bs_parse_string(s, &attr) < 0) || (bs_parse_string(s, &value) < 0))
+    {
+      FREE(&attr);
+      return -1;
+    }
+    if (attr)
+      mutt_param_set(pl, attr, value);
+    FREE(&attr);
+    FREE(&value);
+    *s = mutt_str_skip_whitespace(*s);
+  }
+  (*s)++;
+
+  return 0;
+}
+
+/**
+ * bs_parse_part - Parse one body of a BODYSTRUCTURE response
+ * @param s Cursor into the response string
+ * @param b Body to populate
+ * @retval  0 Success
+ * @retval -1 The response is malformed
+ *
+ * Handles both multiparts and basic parts, recursing for the children of a
+ * multipart or message/rfc822 part.  Extension data (md5, disposition,
+ * language, location) is parsed for the disposition and skipped otherwise.
+ */
+static int bs_parse_part(char **s, struct Body *b)
+{
+  char *str = NULL;
+
+  *s = mutt_str_skip_whitespace(*s);
+  if (**s != '(')
+    return -1;
+  (*s)++;
+  *s = mutt_str_skip_whitespace(*s);
+
+  struct Body **child = &b->parts;
+
+  if (**s == '(')
+  {
+    /* multipart: a list of children, then the subtype */
+    while (**s == '(')
+    {
+      *child = mutt_body_new();
+      if (bs_parse_part(s, *child) < 0)
+        return -1;
+      child = &(*child)->next;
+      *s = mutt_str_skip_whitespace(*s);
+    }
+
+    b->type = TYPE_MULTIPART;
+    if (bs_parse_string(s, &b->subtype) < 0)
+      return -1;
+
+    *s = mutt_str_skip_whitespace(*s);
+    if ((**s != ')') && (bs_parse_params(s, &b->parameter) < 0))
+      return -1;
+  }
+  else
+  {
+    /* basic part: type, subtype, params, id, description, encoding, size */
+    if (bs_parse_string(s, &str) < 0)
+      return -1;
+    b->type = mutt_check_mime_type(NONULL(str));
+    if (b->type == TYPE_OTHER)
+      b->xtype = str;
+    else
+      FREE(&str);
+
+    if ((bs_parse_string(s, &b->subtype) < 0) ||
+        (bs_parse_params(s, &b->parameter) < 0) ||
+        (bs_skip_element(s) < 0) || /* id */
+        (bs_parse_string(s, &b->description) < 0))
+    {
+      return -1;
+    }
+
+    if (bs_parse_string(s, &str) < 0)
+      return -1;
+    b->encoding = mutt_check_encoding(NONULL(str));
+    FREE(&str);
+
+    *s = mutt_str_skip_whitespace(*s);
+    unsigned long size = 0;
+    const char *end = mutt_str_atoul(*s, &size);
+    if (!end)
+      return -1;
+    b->length = size;
+    *s = (char *) end;
+
+    if ((b->type == TYPE_MESSAGE) && mutt_istr_equal(b->subtype, "rfc822"))
+    {
+      /* envelope, then the enclosed body, then the line count */
+      *s = mutt_str_skip_whitespace(*s);
+      if (**s != ')')
+      {
+        if (bs_skip_element(s) < 0) /* envelope */
+          return -1;
+        *s = mutt_str_skip_whitespace(*s);
+        if (**s == '(')
+        {
+          *child = mutt_body_new();
+          if (bs_parse_part(s, *child) < 0)
+            return -1;
+        }
+      }
+    }
+  }
+
+  /* extension data: pick out the disposition, skip the rest */
+  *s = mutt_str_skip_whitespace(*s);
+  while (**s != ')')
+  {
+    if (**s == '(')
+    {
+      char *p = *s + 1;
+      char *disp = NULL;
+      if ((bs_parse_string(&p, &disp) == 0) && disp)
+      {
+        if (mutt_istr_equal(disp, "inline"))
+          b->disposition = DISP_INLINE;
+        else if (mutt_istr_equal(disp, "attachment"))
+          b->disposition = DISP_ATTACH;
+        FREE(&disp);
+
+        struct ParameterList pl = TAILQ_HEAD_INITIALIZER(pl);
+        if (bs_parse_params(&p, &pl) == 0)
+        {
+          const char *fn = mutt_param_get(&pl, "filename");
+          if (fn && !b->filename)
+            b->filename = mutt_str_dup(fn);
+        }
+        mutt_param_free(&pl);
+      }
+      FREE(&disp);
+    }
+    if (bs_skip_element(s) < 0)
+      return -1;
+    *s = mutt_str_skip_whitespace(*s);
+  }
+  (*s)++;
+
+  return 0;
+}
+
 /**
  * msg_fetch_header - Import IMAP FETCH response into an ImapHeader
  * @param m   Mailbox
@@ -512,7 +1082,7 @@ static void imap_alloc_uid_hash(struct ImapAccountData *adata, unsigned int msn_
 {
   struct ImapMboxData *mdata = adata->mailbox->mdata;
   if (!mdata->uid_hash)
-    mdata->uid_hash = mutt_hash_int_new(MAX(6 * msn_count / 5, 30), MUTT_HASH_NO_FLAGS);
+    mdata->uid_hash = mutt_hash_int_new(MAX(6 * msn_count / 5, 30), MUTT_HASH_OPEN_ADDR);
 }
 
 /**
@@ -1073,10 +1643,20 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
   struct ImapAccountData *adata = imap_adata_get(m);
   struct ImapMboxData *mdata = imap_mdata_get(m);
   int idx = m->msg_count;
+  const int first_idx = idx;
 
   if (!adata || (adata->mailbox != m))
     return -1;
 
+#if defined(HAVE_PTHREAD_CREATE) && defined(HAVE_FMEMOPEN)
+  struct ImapParsePipe *pipe = NULL;
+  bool warmed = false; // the first header is parsed inline, see below
+  const bool c_imap_fetch_pipeline =
+      cs_subset_bool(NeoMutt->sub, "imap_fetch_pipeline");
+  if (c_imap_fetch_pipeline)
+    pipe = imap_pipe_new(mdata);
+#endif
+
   struct Buffer *hdr_list = mutt_buffer_pool_get();
   mutt_buffer_strcpy(hdr_list, want_headers);
   const char *const c_imap_headers =
@@ -1229,17 +1809,38 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
         if (*maxuid < h.edata->uid)
           *maxuid = h.edata->uid;
 
-        rewind(fp);
-        /* NOTE: if Date: header is missing, mutt_rfc822_read_header depends
-         *   on h.received being set */
-        e->env = mutt_rfc822_read_header(fp, e, false, false);
-        /* body built as a side-effect of mutt_rfc822_read_header */
-        e->body->length = h.content_length;
-        mailbox_size_add(m, e);
+#if defined(HAVE_PTHREAD_CREATE) && defined(HAVE_FMEMOPEN)
+        if (pipe && warmed)
+        {
+          /* Hand the raw header to the parse thread and keep reading the
+           * socket.  The Email must not be touched again until the pipe is
+           * drained. */
+          const long hlen = ftello(fp);
+          rewind(fp);
+          char *hdr = mutt_mem_malloc(hlen);
+          size_t got = fread(hdr, 1, hlen, fp);
+          imap_pipe_push(pipe, e, hdr, got, h.content_length);
+        }
+        else
+#endif
+        {
+          rewind(fp);
+          /* NOTE: if Date: header is missing, mutt_rfc822_read_header depends
+           *   on h.received being set */
+          e->env = mutt_rfc822_read_header(fp, e, false, false);
+          /* body built as a side-effect of mutt_rfc822_read_header */
+          e->body->length = h.content_length;
 
 #ifdef USE_HCACHE
-        imap_hcache_put(mdata, e);
+          imap_hcache_put(mdata, e);
 #endif /* USE_HCACHE */
+#if defined(HAVE_PTHREAD_CREATE) && defined(HAVE_FMEMOPEN)
+          /* Parsing the first header inline initialises the parser's lazy
+           * state (prex regexes, charset tables) on this thread, so the
+           * parse thread never races its setup */
+          warmed = true;
+#endif
+        }
 
         m->msg_count++;
 
@@ -1279,6 +1880,17 @@ static int read_headers_fetch_new(struct Mailbox *m, unsigned int msn_begin,
   retval = 0;
 
 bail:
+#if defined(HAVE_PTHREAD_CREATE) && defined(HAVE_FMEMOPEN)
+  imap_pipe_free(&pipe); // parses everything still queued
+#endif
+  /* Account the sizes in one pass - emails handed to the parse pipe only
+   * have their Body once the pipe has been drained */
+  for (int i = first_idx; i < m->msg_count; i++)
+  {
+    if (m->emails[i] && m->emails[i]->env)
+      mailbox_size_add(m, m->emails[i]);
+  }
+
   mutt_buffer_pool_release(&hdr_list);
   mutt_buffer_pool_release(&buf);
   mutt_buffer_pool_release(&tempfile);
@@ -1855,6 +2467,79 @@ int imap_cache_clean(struct Mailbox *m)
   return 0;
 }
 
+/**
+ * imap_fetch_structure - Fetch the MIME structure of an email
+ * @param m Selected Imap Mailbox
+ * @param e Email
+ * @retval  0 Success
+ * @retval -1 Failure
+ *
+ * Fetches BODYSTRUCTURE and fills in the part tree of Email::body, without
+ * downloading the message text.  The tree describes types, sizes and
+ * filenames only - the parts have no content to read - but that's enough for
+ * attachment counting and mime-type matching.  Opening the message text
+ * discards the tree and re-parses it from the text, see imap_msg_open().
+ */
+int imap_fetch_structure(struct Mailbox *m, struct Email *e)
+{
+  struct ImapAccountData *adata = imap_adata_get(m);
+  if (!adata || (adata->mailbox != m) || !e)
+    return -1;
+
+  /* already parsed from the message text, or fetched earlier; single-part
+   * messages are fully described by their headers */
+  if (imap_edata_get(e)->parsed || e->body->parts ||
+      ((e->body->type != TYPE_MULTIPART) && (e->body->type != TYPE_MESSAGE)))
+  {
+    return 0;
+  }
+
+  char buf[64];
+  snprintf(buf, sizeof(buf), "UID FETCH %u (BODYSTRUCTURE)", imap_edata_get(e)->uid);
+  imap_cmd_start(adata, buf);
+
+  int rc;
+  bool parsed = false;
+  do
+  {
+    rc = imap_cmd_step(adata);
+    if (rc != IMAP_RES_CONTINUE)
+      break;
+
+    char *pc = imap_next_word(imap_next_word(adata->buf));
+    if (!mutt_istr_startswith(pc, "FETCH"))
+      continue;
+
+    pc = (char *) mutt_istr_find(pc, "BODYSTRUCTURE ");
+    if (!pc)
+      continue;
+    pc += mutt_str_len("BODYSTRUCTURE ");
+
+    struct Body *b = mutt_body_new();
+    if (bs_parse_part(&pc, b) < 0)
+    {
+      mutt_body_free(&b);
+      continue;
+    }
+
+    /* the outer body describes the message itself; its children are the parts */
+    e->body->type = b->type;
+    mutt_str_replace(&e->body->subtype, b->subtype);
+    e->body->parts = b->parts;
+    b->parts = NULL;
+    mutt_body_free(&b);
+    parsed = true;
+  } while (rc == IMAP_RES_CONTINUE);
+
+  if ((rc != IMAP_RES_OK) || !parsed)
+  {
+    mutt_body_free(&e->body->parts);
+    return -1;
+  }
+
+  return 0;
+}
+
 /**
  * imap_set_flags - Fill the message header according to the server flags
  * @param[in]  m              Imap Selected Mailbox
@@ -1895,6 +2580,8 @@ char *imap_set_flags(struct Mailbox *m, struct Email *e, char *s, bool *server_c
   /* We take a copy of the tags so we can split the string */
   char *tags_copy = mutt_str_dup(edata->flags_remote);
   driver_tags_replace(&e->tags, tags_copy);
+  e->index_color_valid = false;
+  FREE(&e->display); /* the index line may show the tags */
   FREE(&tags_copy);
 
   /* YAUH (yet another ugly hack): temporarily set context to
@@ -1957,6 +2644,7 @@ bool imap_msg_open(struct Mailbox *m, struct Message *msg, int msgno)
   msg->fp = msg_cache_get(m, e);
   if (msg->fp)
   {
+    imap_msg_prefetch(m, e);
     if (imap_edata_get(e)->parsed)
       return true;
     goto parsemsg;
@@ -2075,8 +2763,13 @@ bool imap_msg_open(struct Mailbox *m, struct Message *msg, int msgno)
     goto bail;
 
   msg_cache_commit(m, e);
+  imap_msg_prefetch(m, e);
 
 parsemsg:
+  /* Any existing part tree came from BODYSTRUCTURE or the header cache; its
+   * offsets don't refer to this file, so re-parse from the message text */
+  mutt_body_free(&e->body->parts);
+
   /* Update the header information.  Previously, we only downloaded a
    * portion of the headers, those required for the main display.  */
   rewind(msg->fp);
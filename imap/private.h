@@ -140,8 +140,9 @@ typedef uint32_t ImapCapFlags;              ///< Flags, e.g. #IMAP_CAP_IMAP4
 #define IMAP_CAP_LIST_EXTENDED    (1 << 17) ///< RFC5258: IMAP4 LIST Command Extensions
 #define IMAP_CAP_COMPRESS         (1 << 18) ///< RFC4978: COMPRESS=DEFLATE
 #define IMAP_CAP_X_GM_EXT_1       (1 << 19) ///< https://developers.google.com/gmail/imap/imap-extensions
+#define IMAP_CAP_NOTIFY           (1 << 20) ///< RFC5465: IMAP NOTIFY extension
 
-#define IMAP_CAP_ALL             ((1 << 20) - 1)
+#define IMAP_CAP_ALL             ((1 << 21) - 1)
 
 /**
  * struct ImapList - Items in an IMAP browser
@@ -196,6 +197,9 @@ int imap_adata_find(const char *path, struct ImapAccountData **adata, struct Ima
 /* auth.c */
 int imap_authenticate(struct ImapAccountData *adata);
 
+/* browse.c */
+void imap_browse_cache_clear(struct ImapAccountData *adata);
+
 /* command.c */
 int imap_cmd_start(struct ImapAccountData *adata, const char *cmdstr);
 int imap_cmd_step(struct ImapAccountData *adata);
@@ -204,6 +208,7 @@ bool imap_code(const char *s);
 const char *imap_cmd_trailer(struct ImapAccountData *adata);
 int imap_exec(struct ImapAccountData *adata, const char *cmdstr, ImapCmdFlags flags);
 int imap_cmd_idle(struct ImapAccountData *adata);
+int imap_cmd_keepalive(struct ImapAccountData *adata);
 
 /* message.c */
 int imap_read_headers(struct Mailbox *m, unsigned int msn_begin, unsigned int msn_end, bool initial_download);
@@ -252,6 +257,7 @@ bool  mutt_account_match(const struct ConnAccount *a1, const struct ConnAccount
 /* utf7.c */
 void imap_utf_encode(bool unicode, char **s);
 void imap_utf_decode(bool unicode, char **s);
+void imap_utf7_cleanup(void);
 void imap_allow_reopen(struct Mailbox *m);
 void imap_disallow_reopen(struct Mailbox *m);
 
@@ -382,6 +382,59 @@ bail:
   return NULL;
 }
 
+/// Cached conversions, indexed by [decode][unicode], keyed by the raw name
+static struct HashTable *Utf7Cache[2][2];
+/// Config generation the cache was built against ($charset may change)
+static uint64_t Utf7CacheGeneration;
+
+/**
+ * utf7_cache_entry_free - Free a cached conversion - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void utf7_cache_entry_free(int type, void *obj, intptr_t data)
+{
+  FREE(&obj);
+}
+
+/**
+ * utf7_cache - Get the conversion cache for one direction
+ * @param decode  true for utf7-to-local, false for local-to-utf7
+ * @param unicode true if Unicode is allowed
+ * @retval ptr HashTable mapping raw name to converted name
+ *
+ * Folder names recur on every LIST/STATUS cycle, so each conversion is
+ * remembered and repeated browsing does no conversion work at all.  The
+ * results depend on $charset, so the cache is dropped whenever the config
+ * changes.
+ */
+static struct HashTable *utf7_cache(bool decode, bool unicode)
+{
+  const uint64_t generation = cs_subset_generation();
+  if (generation != Utf7CacheGeneration)
+  {
+    imap_utf7_cleanup();
+    Utf7CacheGeneration = generation;
+  }
+
+  struct HashTable **table = &Utf7Cache[decode][unicode];
+  if (!*table)
+  {
+    *table = mutt_hash_new(128, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(*table, utf7_cache_entry_free, 0);
+  }
+
+  return *table;
+}
+
+/**
+ * imap_utf7_cleanup - Free the cached folder name conversions
+ */
+void imap_utf7_cleanup(void)
+{
+  for (int i = 0; i < 2; i++)
+    for (int j = 0; j < 2; j++)
+      mutt_hash_free(&Utf7Cache[i][j]);
+}
+
 /**
  * imap_utf_encode - Encode email from local charset to UTF-8
  * @param[in]  unicode true if Unicode is allowed
@@ -398,9 +451,20 @@ void imap_utf_encode(bool unicode, char **s)
     return;
   }
 
+  struct HashTable *cache = utf7_cache(false, unicode);
+  const char *cached = mutt_hash_find(cache, *s);
+  if (cached)
+  {
+    mutt_str_replace(s, cached);
+    return;
+  }
+
+  char *key = mutt_str_dup(*s);
+
   if (mutt_ch_convert_string(s, c_charset, "utf-8", MUTT_ICONV_NO_FLAGS) != 0)
   {
     FREE(s);
+    FREE(&key);
     return;
   }
 
@@ -410,6 +474,10 @@ void imap_utf_encode(bool unicode, char **s)
     FREE(s);
     *s = utf7;
   }
+
+  if (*s)
+    mutt_hash_insert(cache, key, mutt_str_dup(*s));
+  FREE(&key);
 }
 
 /**
@@ -428,6 +496,16 @@ void imap_utf_decode(bool unicode, char **s)
     return;
   }
 
+  struct HashTable *cache = utf7_cache(true, unicode);
+  const char *cached = mutt_hash_find(cache, *s);
+  if (cached)
+  {
+    mutt_str_replace(s, cached);
+    return;
+  }
+
+  char *key = mutt_str_dup(*s);
+
   if (!unicode)
   {
     char *utf8 = utf7_to_utf8(*s, strlen(*s), 0, 0);
@@ -439,4 +517,8 @@ void imap_utf_decode(bool unicode, char **s)
   {
     FREE(s);
   }
+
+  if (*s)
+    mutt_hash_insert(cache, key, mutt_str_dup(*s));
+  FREE(&key);
 }
@@ -960,8 +960,11 @@ void imap_keepalive(void)
 
     const short c_imap_keepalive =
         cs_subset_number(NeoMutt->sub, "imap_keepalive");
+    /* Post a NOOP without waiting for the reply - a slow server mustn't
+     * freeze the caller, which is usually waiting for a keypress.  Any
+     * resulting updates are processed by the next regular mailbox check. */
     if ((adata->state >= IMAP_AUTHENTICATED) && (now >= (adata->lastread + c_imap_keepalive)))
-      imap_check_mailbox(adata->mailbox, true);
+      imap_cmd_keepalive(adata);
   }
 }
 
@@ -39,9 +39,15 @@ static struct ConfigDef IndexVars[] = {
   { "collapse_all", DT_BOOL, false, 0, NULL,
     "Collapse all threads when entering a folder"
   },
+  { "index_prerender", DT_NUMBER|DT_NOT_NEGATIVE, 0, 0, NULL,
+    "Pre-format this many index rows above and below the visible page while waiting for input"
+  },
   { "mark_macro_prefix", DT_STRING, IP "'", 0, NULL,
     "Prefix for macros using '<mark-message>'"
   },
+  { "session_file", DT_PATH|DT_PATH_FILE, 0, 0, NULL,
+    "File for saving the selected email of each mailbox between sessions"
+  },
   { "uncollapse_jump", DT_BOOL, false, 0, NULL,
     "When opening a thread, jump to the next unread message"
   },
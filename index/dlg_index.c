@@ -600,6 +600,7 @@ void change_folder_mailbox(struct Menu *menu, struct Mailbox *m, int *oldcount,
       new_last_folder = mutt_str_dup(mailbox_path(shared->mailbox));
     *oldcount = shared->mailbox->msg_count;
 
+    index_session_save(shared->mailbox, shared->email);
     const enum MxStatus check = mx_mbox_close(shared->mailbox);
     if (check == MX_STATUS_OK)
     {
@@ -662,7 +663,8 @@ void change_folder_mailbox(struct Menu *menu, struct Mailbox *m, int *oldcount,
     index_shared_data_set_context(shared, ctx);
 
     menu->max = m->msg_count;
-    menu_set_index(menu, ci_first_message(shared->mailbox));
+    const int saved = index_session_restore(shared->mailbox);
+    menu_set_index(menu, (saved >= 0) ? saved : ci_first_message(shared->mailbox));
 #ifdef USE_INOTIFY
     mutt_monitor_add(NULL);
 #endif
@@ -786,6 +788,8 @@ void index_make_entry(struct Menu *menu, char *buf, size_t buflen, int line)
 
   MuttFormatFlags flags = MUTT_FORMAT_ARROWCURSOR | MUTT_FORMAT_INDEX;
   struct MuttThread *tmp = NULL;
+  const int width = menu->win->state.cols;
+  const bool in_pager = (shared->ctx->msg_in_pager == e->msgno);
 
   const enum UseThreads c_threads = mutt_thread_style();
   if ((c_threads > UT_FLAT) && e->tree)
@@ -842,10 +846,67 @@ void index_make_entry(struct Menu *menu, char *buf, size_t buflen, int line)
     }
   }
 
+  /* The formatted line only depends on the Email and the inputs below, so
+   * reuse it until one of them changes.  Anything else that affects the
+   * line (flags, score, tags, collapsing, the thread tree, config) frees
+   * Email::display when it changes. */
+  if (e->display && (e->display_width == width) &&
+      (e->display_flags == (int) flags) && (e->display_msgno == e->msgno) &&
+      (e->display_in_pager == in_pager))
+  {
+    mutt_str_copy(buf, e->display, buflen);
+    return;
+  }
+
   const char *const c_index_format =
       cs_subset_string(shared->sub, "index_format");
-  mutt_make_string(buf, buflen, menu->win->state.cols, NONULL(c_index_format),
-                   m, shared->ctx->msg_in_pager, e, flags, NULL);
+  mutt_make_string(buf, buflen, width, NONULL(c_index_format), m,
+                   shared->ctx->msg_in_pager, e, flags, NULL);
+
+  mutt_str_replace(&e->display, buf);
+  e->display_width = width;
+  e->display_flags = flags;
+  e->display_msgno = e->msgno;
+  e->display_in_pager = in_pager;
+}
+
+/**
+ * index_prerender - Pre-format the index rows just outside the viewport
+ * @param priv Private Index data
+ *
+ * Scrolling into a fresh region formats every row on demand.  While the menu
+ * is waiting for input, format the rows a page-scroll away, so their
+ * Email::display caches are already warm when they come on screen.  The
+ * reach in each direction is `$index_prerender`; 0 disables it.
+ */
+static void index_prerender(struct IndexPrivateData *priv)
+{
+  const short c_index_prerender =
+      cs_subset_number(priv->shared->sub, "index_prerender");
+  if (c_index_prerender == 0)
+    return;
+
+  struct Menu *menu = priv->menu;
+  struct Mailbox *m = priv->shared->mailbox;
+  if (!m || (menu->max == 0))
+    return;
+
+  int first = menu->top - c_index_prerender;
+  int last = menu->top + menu->page_len + c_index_prerender;
+  if (first < 0)
+    first = 0;
+  if (last > menu->max)
+    last = menu->max;
+
+  const int width = menu->win->state.cols;
+  char buf[1024];
+  for (int line = first; line < last; line++)
+  {
+    struct Email *e = mutt_get_virt_email(m, line);
+    if (!e || (e->display && (e->display_width == width)))
+      continue;
+    index_make_entry(menu, buf, sizeof(buf), line);
+  }
 }
 
 /**
@@ -1079,7 +1140,8 @@ struct Mailbox *mutt_index_menu(struct MuttWindow *dlg, struct Mailbox *m_init)
   priv->menu->color = index_color;
   priv->menu->custom_redraw = index_custom_redraw;
   priv->menu->max = shared->mailbox ? shared->mailbox->vcount : 0;
-  menu_set_index(priv->menu, ci_first_message(shared->mailbox));
+  const int saved = index_session_restore(shared->mailbox);
+  menu_set_index(priv->menu, (saved >= 0) ? saved : ci_first_message(shared->mailbox));
   mutt_window_reflow(NULL);
 
   if (!priv->attach_msg)
@@ -1262,6 +1324,9 @@ struct Mailbox *mutt_index_menu(struct MuttWindow *dlg, struct Mailbox *m_init)
       }
       mutt_refresh();
 
+      /* the screen is up to date and we're about to block for input */
+      index_prerender(priv);
+
       if (SigWinch)
       {
         SigWinch = false;
@@ -1397,6 +1462,9 @@ void mutt_set_header_color(struct Mailbox *m, struct Email *e)
   struct PatternCache cache = { 0 };
   bool match = false;
 
+  /* whatever prompted a new line colour invalidates the part colours too */
+  e->index_color_valid = false;
+
   STAILQ_FOREACH(color, regex_colors_get_list(MT_COLOR_INDEX), entries)
   {
     if (mutt_pattern_exec(SLIST_FIRST(color->color_pattern),
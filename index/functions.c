@@ -32,6 +32,8 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <unistd.h>
+#include "private.h"
 #include "mutt/lib.h"
 #include "config/lib.h"
 #include "email/lib.h"
@@ -43,6 +45,7 @@
 #include "lib.h"
 #include "attach/lib.h"
 #include "browser/lib.h"
+#include "maildir/lib.h"
 #include "menu/lib.h"
 #include "ncrypt/lib.h"
 #include "pager/lib.h"
@@ -366,6 +369,11 @@ static int op_display_message(struct IndexSharedData *shared,
   const int index = menu_get_index(priv->menu);
   index_shared_data_set_email(shared, mutt_get_virt_email(shared->mailbox, index));
 
+  /* While this message is decoded and displayed, have the kernel fetch the
+   * following one - it's the most likely to be opened next */
+  if (shared->mailbox && (shared->mailbox->type == MUTT_MAILDIR))
+    maildir_msg_prefetch(shared->mailbox, mutt_get_virt_email(shared->mailbox, index + 1));
+
   const char *const c_pager = cs_subset_string(NeoMutt->sub, "pager");
   if (c_pager && !mutt_str_equal(c_pager, "builtin"))
   {
@@ -944,7 +952,8 @@ static int op_main_collapse_thread(struct IndexSharedData *shared,
   else if (mutt_thread_can_collapse(shared->email))
   {
     menu_set_index(priv->menu, mutt_collapse_thread(shared->email));
-    mutt_set_vnum(shared->mailbox);
+    /* only hides messages, so the virtual index can be compacted in place */
+    mutt_collapse_vnum(shared->mailbox);
   }
   else
   {
@@ -1148,6 +1157,13 @@ static int op_main_modify_tags(struct IndexSharedData *shared,
 #ifdef USE_NOTMUCH
     if (m->type == MUTT_NOTMUCH)
       nm_db_longrun_init(m, true);
+#endif
+#ifdef USE_IMAP
+    /* IMAP can update the whole message set in a few round trips */
+    const bool committed = (m->type == MUTT_IMAP) &&
+                           (imap_tags_commit_tagged(m, mutt_buffer_string(buf)) == 0);
+#else
+    const bool committed = false;
 #endif
     for (int px = 0, i = 0; i < m->msg_count; i++)
     {
@@ -1159,7 +1175,8 @@ static int op_main_modify_tags(struct IndexSharedData *shared,
 
       if (m->verbose)
         progress_update(progress, ++px, -1);
-      mx_tags_commit(m, e, mutt_buffer_string(buf));
+      if (!committed)
+        mx_tags_commit(m, e, mutt_buffer_string(buf));
       if (op == OP_MAIN_MODIFY_TAGS_THEN_HIDE)
       {
         bool still_queried = false;
@@ -1416,6 +1433,14 @@ static int op_main_next_undeleted(struct IndexSharedData *shared,
 {
   int index = menu_get_index(priv->menu);
   if (index >= (shared->mailbox->vcount - 1))
+  {
+#ifdef USE_NOTMUCH
+    /* A paged notmuch query may have more results, see nm_mbox_fetch_more() */
+    if (nm_mbox_fetch_more(shared->mailbox) > 0)
+      priv->menu->max = shared->mailbox->vcount;
+#endif
+  }
+  if (index >= (shared->mailbox->vcount - 1))
   {
     if (!priv->in_pager)
       mutt_message(_("You are on the last message"));
@@ -1590,6 +1615,62 @@ static int op_main_root_message(struct IndexSharedData *shared,
   return IR_SUCCESS;
 }
 
+/**
+ * op_main_search_mailboxes - Search a pattern in all mailboxes - Implements ::index_function_t - @ingroup index_function_api
+ *
+ * The matches are collected in a throwaway mbox folder, which is then opened
+ * read-only like any other folder.
+ */
+static int op_main_search_mailboxes(struct IndexSharedData *shared,
+                                    struct IndexPrivateData *priv, int op)
+{
+  int rc = IR_ERROR;
+  bool pager_return = true; /* return to display message in pager */
+  struct Buffer *buf = mutt_buffer_pool_get();
+  struct Buffer *fname = mutt_buffer_pool_get();
+  struct Buffer *err = mutt_buffer_pool_get();
+
+  if ((mutt_buffer_get_field(_("Search in all mailboxes: "), buf,
+                             MUTT_COMP_PATTERN | MUTT_COMP_CLEAR, false, NULL,
+                             NULL, NULL) != 0) ||
+      mutt_buffer_is_empty(buf))
+  {
+    rc = IR_NO_ACTION;
+    goto done;
+  }
+
+  mutt_buffer_mktemp(fname);
+  const int matches = mutt_pattern_search_mailboxes(
+      shared->mailbox, mutt_buffer_string(buf), mutt_buffer_string(fname), err);
+  if (matches < 0)
+  {
+    if (!mutt_buffer_is_empty(err))
+      mutt_error("%s", mutt_buffer_string(err));
+    goto done;
+  }
+  if (matches == 0)
+  {
+    mutt_message(_("No messages matched"));
+    unlink(mutt_buffer_string(fname));
+    rc = IR_NO_ACTION;
+    goto done;
+  }
+
+  mutt_message(ngettext("%d message found", "%d messages found", matches), matches);
+  change_folder_string(priv->menu, fname->data, fname->dsize, &priv->oldcount,
+                       shared, &pager_return, true);
+  rc = IR_SUCCESS;
+
+done:
+  mutt_buffer_pool_release(&buf);
+  mutt_buffer_pool_release(&fname);
+  mutt_buffer_pool_release(&err);
+  if (priv->in_pager && pager_return)
+    return IR_CONTINUE;
+  menu_queue_redraw(priv->menu, MENU_REDRAW_FULL);
+  return rc;
+}
+
 /**
  * op_main_set_flag - Set a status flag on a message - Implements ::index_function_t - @ingroup index_function_api
  *
@@ -1903,6 +1984,14 @@ static int op_next_entry(struct IndexSharedData *shared, struct IndexPrivateData
 {
   const int index = menu_get_index(priv->menu) + 1;
   if (index >= shared->mailbox->vcount)
+  {
+#ifdef USE_NOTMUCH
+    /* A paged notmuch query may have more results, see nm_mbox_fetch_more() */
+    if (nm_mbox_fetch_more(shared->mailbox) > 0)
+      priv->menu->max = shared->mailbox->vcount;
+#endif
+  }
+  if (index >= shared->mailbox->vcount)
   {
     if (!priv->in_pager)
       mutt_message(_("You are on the last message"));
@@ -2009,6 +2098,8 @@ static int op_quit(struct IndexSharedData *shared, struct IndexPrivateData *priv
     notify_send(NeoMutt->notify, NT_GLOBAL, NT_GLOBAL_SHUTDOWN, NULL);
 
     enum MxStatus check = MX_STATUS_OK;
+    if (shared->ctx)
+      index_session_save(shared->mailbox, shared->email);
     if (!shared->ctx || ((check = mx_mbox_close(shared->mailbox)) == MX_STATUS_OK))
     {
       ctx_free(&shared->ctx);
@@ -2554,6 +2645,7 @@ static int op_main_imap_logout_all(struct IndexSharedData *shared,
 {
   if (shared->mailbox && (shared->mailbox->type == MUTT_IMAP))
   {
+    index_session_save(shared->mailbox, shared->email);
     const enum MxStatus check = mx_mbox_close(shared->mailbox);
     if (check == MX_STATUS_OK)
     {
@@ -3272,6 +3364,7 @@ struct IndexFunction IndexFunctions[] = {
   { OP_MAIN_READ_SUBTHREAD,                 op_main_read_thread,                  CHECK_IN_MAILBOX | CHECK_MSGCOUNT | CHECK_READONLY | CHECK_VISIBLE },
   { OP_MAIN_READ_THREAD,                    op_main_read_thread,                  CHECK_IN_MAILBOX | CHECK_MSGCOUNT | CHECK_READONLY | CHECK_VISIBLE },
   { OP_MAIN_ROOT_MESSAGE,                   op_main_root_message,                 CHECK_IN_MAILBOX | CHECK_MSGCOUNT | CHECK_VISIBLE },
+  { OP_MAIN_SEARCH_MAILBOXES,               op_main_search_mailboxes,             CHECK_ATTACH },
   { OP_MAIN_SET_FLAG,                       op_main_set_flag,                     CHECK_IN_MAILBOX | CHECK_MSGCOUNT | CHECK_READONLY | CHECK_VISIBLE },
   { OP_MAIN_SHOW_LIMIT,                     op_main_show_limit,                   CHECK_IN_MAILBOX },
   { OP_MAIN_SYNC_FOLDER,                    op_main_sync_folder,                  CHECK_NO_FLAGS },
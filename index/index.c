@@ -212,6 +212,26 @@ static int config_reply_regex(struct Mailbox *m)
   return 0;
 }
 
+/**
+ * index_invalidate_display - Drop the cached index lines of all the emails
+ * @param m Mailbox
+ */
+static void index_invalidate_display(struct Mailbox *m)
+{
+  if (!m)
+    return;
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      break;
+    FREE(&e->display);
+    if (e->env)
+      FREE(&e->env->disp_author);
+  }
+}
+
 /**
  * index_altern_observer - Notification that an 'alternates' command has occurred - Implements ::observer_t - @ingroup observer_api
  */
@@ -225,6 +245,7 @@ static int index_altern_observer(struct NotifyCallback *nc)
   struct IndexSharedData *shared = dlg->wdata;
 
   mutt_alternates_reset(shared->mailbox);
+  index_invalidate_display(shared->mailbox); // the author column depends on 'alternates'
   mutt_debug(LL_DEBUG5, "alternates done\n");
   return 0;
 }
@@ -290,6 +311,7 @@ static int index_color_observer(struct NotifyCallback *nc)
       if (!e)
         break;
       e->attr_color = NULL;
+      e->index_color_valid = false;
     }
   }
 
@@ -312,6 +334,8 @@ static int index_config_observer(struct NotifyCallback *nc)
 
   struct EventConfig *ev_c = nc->event_data;
   struct MuttWindow *win = nc->global_data;
+  struct MuttWindow *dlg = dialog_find(win);
+  struct IndexSharedData *shared = dlg->wdata;
 
   const struct ConfigDef *cdef = ev_c->he->data;
   ConfigRedrawFlags flags = cdef->type & R_REDRAW_MASK;
@@ -323,10 +347,12 @@ static int index_config_observer(struct NotifyCallback *nc)
   if (flags & R_RESORT_INIT)
     OptResortInit = true;
 
+  /* too many config items feed into `$index_format` to track them
+   * individually, so drop the cached index lines on any change */
+  index_invalidate_display(shared->mailbox);
+
   if (mutt_str_equal(ev_c->name, "reply_regex"))
   {
-    struct MuttWindow *dlg = dialog_find(win);
-    struct IndexSharedData *shared = dlg->wdata;
     config_reply_regex(shared->mailbox);
     mutt_debug(LL_DEBUG5, "config done\n");
   }
@@ -388,6 +414,8 @@ static int index_score_observer(struct NotifyCallback *nc)
 
     mutt_score_message(m, e, true);
     e->attr_color = NULL; // Force recalc of colour
+    e->index_color_valid = false;
+    FREE(&e->display);    // %N shows the score
   }
 
   mutt_debug(LL_DEBUG5, "score done\n");
@@ -407,6 +435,7 @@ static int index_subjrx_observer(struct NotifyCallback *nc)
   struct IndexSharedData *shared = dlg->wdata;
 
   subjrx_clear_mods(shared->mailbox);
+  index_invalidate_display(shared->mailbox);
   mutt_debug(LL_DEBUG5, "subjectrx done\n");
   return 0;
 }
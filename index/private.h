@@ -25,10 +25,16 @@
 
 #include <stdbool.h>
 
+struct Email;
 struct IndexPrivateData;
 struct IndexSharedData;
+struct Mailbox;
 
 struct MuttWindow *index_window_new(struct IndexPrivateData *priv);
 struct MuttWindow *ipanel_new(bool status_on_top, struct IndexSharedData *shared);
 
+/* session.c */
+int  index_session_restore(struct Mailbox *m);
+void index_session_save   (struct Mailbox *m, struct Email *e_cur);
+
 #endif /* MUTT_INDEX_PRIVATE_H */
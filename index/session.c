@@ -0,0 +1,176 @@
+/**
+ * @file
+ * Remember the Index position between sessions
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page index_session Remember the Index position between sessions
+ *
+ * If `$session_file` is set, the Message-ID of the selected email is saved
+ * when a Mailbox is closed and the cursor is put back on that email the next
+ * time the Mailbox is opened, whether in the same session or a later one.
+ *
+ * The file holds one line per Mailbox: the mailbox path and the Message-ID,
+ * separated by a tab.  Unknown lines are preserved, so the file may be
+ * shared between NeoMutt versions.
+ */
+
+#include "config.h"
+#include <limits.h>
+#include <stdio.h>
+#include <unistd.h>
+#include "private.h"
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "context.h"
+
+/**
+ * session_find_entry - Find a Mailbox's entry in the session file
+ * @param fp  Session file
+ * @param key Mailbox path
+ * @retval ptr  Message-ID (caller must free)
+ * @retval NULL No entry for this Mailbox
+ */
+static char *session_find_entry(FILE *fp, const char *key)
+{
+  char *linebuf = NULL;
+  size_t buflen = 0;
+  int line = 0;
+  char *msgid = NULL;
+  const size_t keylen = mutt_str_len(key);
+
+  while ((linebuf = mutt_file_read_line(linebuf, &buflen, fp, &line, MUTT_RL_NO_FLAGS)))
+  {
+    if (mutt_strn_equal(linebuf, key, keylen) && (linebuf[keylen] == '\t'))
+    {
+      msgid = mutt_str_dup(linebuf + keylen + 1);
+      break;
+    }
+  }
+  FREE(&linebuf);
+  return msgid;
+}
+
+/**
+ * index_session_restore - Find the saved position in a Mailbox
+ * @param m Mailbox
+ * @retval num Index of the previously selected email
+ * @retval -1  No saved position, or the email is gone
+ */
+int index_session_restore(struct Mailbox *m)
+{
+  if (!m)
+    return -1;
+
+  const char *const c_session_file =
+      cs_subset_path(NeoMutt->sub, "session_file");
+  if (!c_session_file)
+    return -1;
+
+  FILE *fp = mutt_file_fopen(c_session_file, "r");
+  if (!fp)
+    return -1;
+
+  char *msgid = session_find_entry(fp, mailbox_path(m));
+  mutt_file_fclose(&fp);
+  if (!msgid)
+    return -1;
+
+  int rc = -1;
+  for (int i = 0; i < m->vcount; i++)
+  {
+    struct Email *e = mutt_get_virt_email(m, i);
+    if (e && e->env && mutt_str_equal(e->env->message_id, msgid))
+    {
+      rc = i;
+      break;
+    }
+  }
+  FREE(&msgid);
+  return rc;
+}
+
+/**
+ * index_session_save - Save the current position in a Mailbox
+ * @param m     Mailbox
+ * @param e_cur Selected Email
+ *
+ * The rest of the session file is kept as-is; only this Mailbox's line is
+ * replaced.  If no email is selected, the Mailbox's line is removed.
+ */
+void index_session_save(struct Mailbox *m, struct Email *e_cur)
+{
+  if (!m)
+    return;
+
+  const char *const c_session_file =
+      cs_subset_path(NeoMutt->sub, "session_file");
+  if (!c_session_file)
+    return;
+
+  const char *key = mailbox_path(m);
+  if (!key || (*key == '\0'))
+    return;
+  const size_t keylen = mutt_str_len(key);
+
+  /* keep the other mailboxes' entries */
+  struct ListHead lines = STAILQ_HEAD_INITIALIZER(lines);
+  FILE *fp = mutt_file_fopen(c_session_file, "r");
+  if (fp)
+  {
+    char *linebuf = NULL;
+    size_t buflen = 0;
+    int line = 0;
+    while ((linebuf = mutt_file_read_line(linebuf, &buflen, fp, &line, MUTT_RL_NO_FLAGS)))
+    {
+      if (mutt_strn_equal(linebuf, key, keylen) && (linebuf[keylen] == '\t'))
+        continue;
+      mutt_list_insert_tail(&lines, mutt_str_dup(linebuf));
+    }
+    FREE(&linebuf);
+    mutt_file_fclose(&fp);
+  }
+
+  char tmpfile[PATH_MAX];
+  snprintf(tmpfile, sizeof(tmpfile), "%s.tmp", c_session_file);
+  fp = mutt_file_fopen(tmpfile, "w");
+  if (!fp)
+  {
+    mutt_list_free(&lines);
+    return;
+  }
+
+  struct ListNode *np = NULL;
+  STAILQ_FOREACH(np, &lines, entries)
+  {
+    fprintf(fp, "%s\n", np->data);
+  }
+  const char *msgid = (e_cur && e_cur->env) ? e_cur->env->message_id : NULL;
+  if (msgid)
+    fprintf(fp, "%s\t%s\n", key, msgid);
+
+  if (mutt_file_fclose(&fp) == 0)
+    rename(tmpfile, c_session_file);
+  else
+    unlink(tmpfile);
+  mutt_list_free(&lines);
+}
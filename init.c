@@ -670,6 +670,7 @@ void mutt_opts_free(void)
   mutt_list_free(&Muttrc);
   mutt_list_free(&UnIgnore);
   mutt_list_free(&UserHeader);
+  mutt_matches_ignore_flush();
 
   mutt_colors_cleanup();
 
@@ -124,6 +124,50 @@ keycode_t AbortKey; ///< code of key to abort prompts, normally Ctrl-G
 
 struct KeymapList Keymaps[MENU_MAX];
 
+/// Sorted arrays of each menu's Keymaps, for binary-search key resolution
+static struct Keymap **KeymapIndex[MENU_MAX];
+/// Number of entries in each #KeymapIndex array
+static size_t KeymapIndexLen[MENU_MAX];
+/// The index arrays must be rebuilt before their next use
+static bool KeymapIndexDirty = true;
+
+/**
+ * keymap_index_build - Rebuild the sorted arrays of Keymaps
+ *
+ * The Keymaps lists are kept sorted by key sequence (km_bind_err()), so the
+ * index is just each list flattened into an array.  It is rebuilt lazily on
+ * the first keypress after a binding changes; bind/unbind are rare and
+ * km_dokey() is not.
+ */
+static void keymap_index_build(void)
+{
+  for (int i = 0; i < MENU_MAX; i++)
+  {
+    size_t count = 0;
+    struct Keymap *np = NULL;
+    STAILQ_FOREACH(np, &Keymaps[i], entries)
+    {
+      count++;
+    }
+
+    KeymapIndexLen[i] = count;
+    if (count == 0)
+    {
+      FREE(&KeymapIndex[i]);
+      continue;
+    }
+
+    mutt_mem_realloc(&KeymapIndex[i], count * sizeof(struct Keymap *));
+    count = 0;
+    STAILQ_FOREACH(np, &Keymaps[i], entries)
+    {
+      KeymapIndex[i][count++] = np;
+    }
+  }
+
+  KeymapIndexDirty = false;
+}
+
 /**
  * struct Extkey - Map key names from NeoMutt's style to Curses style
  */
@@ -437,6 +481,7 @@ static enum CommandResult km_bind_err(const char *s, enum MenuType mtype, int op
     STAILQ_INSERT_HEAD(&Keymaps[mtype], map, entries);
   }
 
+  KeymapIndexDirty = true;
   return rc;
 }
 
@@ -631,11 +676,18 @@ static int retry_generic(enum MenuType mtype, keycode_t *keys, int keyslen, int
 int km_dokey(enum MenuType mtype)
 {
   struct KeyEvent tmp = { OP_NULL, OP_NULL };
-  struct Keymap *map = STAILQ_FIRST(&Keymaps[mtype]);
   int pos = 0;
   int n = 0;
 
-  if (!map && (mtype != MENU_EDITOR))
+  if (KeymapIndexDirty)
+    keymap_index_build();
+
+  /* [lo,hi) is the range of bindings whose keys match the input so far */
+  struct Keymap **idx = KeymapIndex[mtype];
+  size_t lo = 0;
+  size_t hi = KeymapIndexLen[mtype];
+
+  if ((hi == 0) && (mtype != MENU_EDITOR))
     return retry_generic(mtype, NULL, 0, 0);
 
 #ifdef USE_IMAP
@@ -735,19 +787,38 @@ int km_dokey(enum MenuType mtype)
         continue;
     }
 
-    if (!map)
+    if (hi == lo)
       return tmp.op;
 
-    /* Nope. Business as usual */
-    while (LastKey > map->keys[pos])
+    /* Nope. Business as usual.  The range is sorted by key sequence, so
+     * narrow it to the bindings whose next key is LastKey */
+    size_t new_lo = lo;
+    for (size_t span = hi - lo; span != 0; span /= 2)
     {
-      if ((pos > map->eq) || !STAILQ_NEXT(map, entries))
-        return retry_generic(mtype, map->keys, pos, LastKey);
-      map = STAILQ_NEXT(map, entries);
+      const size_t mid = new_lo + (span / 2);
+      if (idx[mid]->keys[pos] < LastKey)
+      {
+        new_lo = mid + 1;
+        span--;
+      }
     }
+    size_t new_hi = new_lo;
+    for (size_t span = hi - new_lo; span != 0; span /= 2)
+    {
+      const size_t mid = new_hi + (span / 2);
+      if (idx[mid]->keys[pos] <= LastKey)
+      {
+        new_hi = mid + 1;
+        span--;
+      }
+    }
+
+    if (new_lo == new_hi)
+      return retry_generic(mtype, idx[lo]->keys, pos, LastKey);
 
-    if (LastKey != map->keys[pos])
-      return retry_generic(mtype, map->keys, pos, LastKey);
+    lo = new_lo;
+    hi = new_hi;
+    struct Keymap *map = idx[lo];
 
     if (++pos == map->len)
     {
@@ -777,7 +848,8 @@ int km_dokey(enum MenuType mtype)
       }
 
       generic_tokenize_push_string(map->macro, mutt_push_macro_event);
-      map = STAILQ_FIRST(&Keymaps[mtype]);
+      lo = 0;
+      hi = KeymapIndexLen[mtype];
       pos = 0;
     }
   }
@@ -1399,6 +1471,8 @@ static void km_unbind_all(struct KeymapList *km_list, unsigned long mode)
       mutt_keymap_free(&np);
     }
   }
+
+  KeymapIndexDirty = true;
 }
 
 /**
@@ -1654,5 +1728,8 @@ void mutt_keys_free(void)
   for (int i = 0; i < MENU_MAX; i++)
   {
     mutt_keymaplist_free(&Keymaps[i]);
+    FREE(&KeymapIndex[i]);
+    KeymapIndexLen[i] = 0;
   }
+  KeymapIndexDirty = true;
 }
@@ -34,6 +34,7 @@
 
 #include "config.h"
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include "mutt/lib.h"
@@ -45,6 +46,11 @@
 #include "muttlib.h"
 #include "protos.h"
 
+/// Exit codes of `test=` commands that don't depend on the attachment,
+/// keyed by the expanded command.  They can't change during the session,
+/// so each one only costs a fork once.
+static struct HashTable *TestResults = NULL;
+
 /**
  * mailcap_expand_command - Expand expandos in a command
  * @param a        Email Body
@@ -362,7 +368,24 @@ static bool rfc1524_mailcap_parse(struct Body *a, const char *filename, const ch
             else
               mutt_buffer_strcpy(afilename, NONULL(a->filename));
             mailcap_expand_command(a, mutt_buffer_string(afilename), type, command);
-            if (mutt_system(mutt_buffer_string(command)))
+
+            /* A test that doesn't reference the attachment (no %s etc.) will
+             * give the same answer for the whole session, so its exit code is
+             * cached; the codes are offset by one as the table can't store 0 */
+            const bool cacheable = (strchr(test_command, '%') == NULL);
+            intptr_t rc =
+                cacheable ? (intptr_t) mutt_hash_find(TestResults, mutt_buffer_string(command)) : 0;
+            if (rc == 0)
+            {
+              rc = mutt_system(mutt_buffer_string(command)) + 1;
+              if (cacheable)
+              {
+                if (!TestResults)
+                  TestResults = mutt_hash_new(32, MUTT_HASH_STRDUP_KEYS);
+                mutt_hash_insert(TestResults, mutt_buffer_string(command), (void *) rc);
+              }
+            }
+            if (rc != 1)
             {
               /* a non-zero exit code means test failed */
               found = false;
@@ -430,6 +453,14 @@ static bool rfc1524_mailcap_parse(struct Body *a, const char *filename, const ch
   return found;
 }
 
+/**
+ * mailcap_cleanup - Free the cached mailcap test results
+ */
+void mailcap_cleanup(void)
+{
+  mutt_hash_free(&TestResults);
+}
+
 /**
  * mailcap_entry_new - Allocate memory for a new rfc1524 entry
  * @retval ptr An un-initialized struct MailcapEntry
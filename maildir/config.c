@@ -39,6 +39,12 @@ static struct ConfigDef MaildirVars[] = {
   { "maildir_check_cur", DT_BOOL, false, 0, NULL,
     "Check both 'new' and 'cur' directories for new mail"
   },
+  { "maildir_parse_threads", DT_NUMBER|DT_NOT_NEGATIVE, 0, 0, NULL,
+    "(maildir,mh) Number of worker threads for parsing message headers (0 = no threads)"
+  },
+  { "maildir_sync_threads", DT_NUMBER|DT_NOT_NEGATIVE, 0, 0, NULL,
+    "Number of worker threads for the renames/deletes of a mailbox sync (0 = no threads)"
+  },
   { "maildir_trash", DT_BOOL, false, 0, NULL,
     "Use the maildir 'trashed' flag, rather than deleting"
   },
@@ -41,6 +41,7 @@
 #define MUTT_MAILDIR_LIB_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include "core/lib.h"
 
@@ -51,10 +52,15 @@ extern struct MxOps MxMaildirOps;
 extern struct MxOps MxMhOps;
 
 int           maildir_check_empty      (const char *path);
+int           maildir_count_messages   (const char *path);
 void          maildir_gen_flags        (char *dest, size_t destlen, struct Email *e);
 bool          maildir_msg_open_new     (struct Mailbox *m, struct Message *msg, const struct Email *e);
+void          maildir_msg_prefetch     (struct Mailbox *m, struct Email *e);
 FILE *        maildir_open_find_message(const char *folder, const char *msg, char **newname);
 void          maildir_parse_flags      (struct Email *e, const char *path);
+int           maildir_quota_usage      (const char *path, uint64_t *size, uint64_t *count);
+int           maildir_remove           (const char *path);
+int           maildir_rename           (const char *src, const char *dst);
 struct Email *maildir_parse_message    (enum MailboxType type, const char *fname, bool is_old, struct Email *e);
 struct Email *maildir_parse_stream     (enum MailboxType type, FILE *fp, const char *fname, bool is_old, struct Email *e);
 bool          maildir_sync_mailbox_message(struct Mailbox *m, int msgno, struct HeaderCache *hc);
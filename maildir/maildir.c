@@ -65,7 +65,11 @@
 #ifdef USE_NOTMUCH
 #include "notmuch/lib.h"
 #endif
+#ifdef USE_DEBUG_TIMING
+#include "debug/lib.h"
+#endif
 
+struct HcacheOpenRequest;
 struct Progress;
 
 // Flags for maildir_mbox_check()
@@ -73,6 +77,122 @@ struct Progress;
 #define MMC_NEW_DIR (1 << 0) ///< 'new' directory changed
 #define MMC_CUR_DIR (1 << 1) ///< 'cur' directory changed
 
+ARRAY_HEAD(MdPathArray, char *);
+
+/**
+ * struct MdStatCtx - Shared state for the batched recency stat() pass
+ */
+struct MdStatCtx
+{
+  char **paths;                  ///< Full paths of the candidate messages
+  bool *recent;                  ///< Out: message arrived after the last visit
+  struct timespec *ctimes;       ///< Out: ctime of each message (may be NULL)
+  struct timespec *last_visited; ///< When the user last exited the mailbox
+};
+
+/**
+ * md_stat_worker - stat() one candidate message - Implements ::mutt_worker_fn_t
+ *
+ * A message whose path can't be stat()'d counts as recent, matching the
+ * serial code path.
+ */
+static void md_stat_worker(size_t index, void *wdata)
+{
+  struct MdStatCtx *ctx = wdata;
+  struct stat st = { 0 };
+
+  if (stat(ctx->paths[index], &st) != 0)
+  {
+    ctx->recent[index] = true;
+    if (ctx->ctimes)
+      ctx->ctimes[index].tv_sec = mutt_date_epoch();
+    return;
+  }
+
+  if (ctx->ctimes)
+    mutt_file_get_stat_timespec(&ctx->ctimes[index], &st, MUTT_STAT_CTIME);
+  if (mutt_file_stat_timespec_compare(&st, MUTT_STAT_CTIME, ctx->last_visited) > 0)
+    ctx->recent[index] = true;
+}
+
+#ifdef USE_HCACHE
+/// Version of the serialized #MdCounts record; bump when the struct changes
+#define MD_COUNTS_VERSION 1
+
+/**
+ * struct MdCounts - Cached message counts for one maildir subdir
+ *
+ * Stored verbatim in the header cache, keyed by the subdir name, so that
+ * mailbox polls over unchanged maildirs don't have to readdir() them.
+ * A record is only valid while the subdir's mtime matches MdCounts.mtime.
+ */
+struct MdCounts
+{
+  uint8_t version;                  ///< Record version, #MD_COUNTS_VERSION
+  bool ctime_valid;                 ///< max_unread_ctime covers every unread message
+  struct timespec mtime;            ///< mtime of the subdir when it was scanned
+  struct timespec max_unread_ctime; ///< Newest ctime among the unread messages
+  uint32_t msg_count;               ///< Total number of messages
+  uint32_t msg_unread;              ///< Number of unread messages
+  uint32_t msg_flagged;             ///< Number of flagged messages
+};
+
+/**
+ * md_counts_fetch - Get a subdir's cached counts from the header cache
+ * @param[in]  m        Mailbox
+ * @param[in]  dir_name Subdir, e.g. 'new'
+ * @param[out] mdc      Cached counts
+ * @retval true A record was found
+ *
+ * The caller must still compare MdCounts.mtime with the subdir's mtime.
+ */
+static bool md_counts_fetch(struct Mailbox *m, const char *dir_name, struct MdCounts *mdc)
+{
+  const char *const c_header_cache =
+      cs_subset_path(NeoMutt->sub, "header_cache");
+  struct HeaderCache *hc = mutt_hcache_open(c_header_cache, mailbox_path(m), NULL);
+  if (!hc)
+    return false;
+
+  char key[32];
+  const int keylen = snprintf(key, sizeof(key), "/counts/%s", dir_name);
+
+  bool valid = false;
+  size_t dlen = 0;
+  void *data = mutt_hcache_fetch_raw(hc, key, keylen, &dlen);
+  if (data && (dlen == sizeof(*mdc)))
+  {
+    memcpy(mdc, data, sizeof(*mdc));
+    valid = (mdc->version == MD_COUNTS_VERSION);
+  }
+  mutt_hcache_free_raw(hc, &data);
+  mutt_hcache_close(hc);
+  return valid;
+}
+
+/**
+ * md_counts_store - Save a subdir's counts to the header cache
+ * @param m        Mailbox
+ * @param dir_name Subdir, e.g. 'new'
+ * @param mdc      Counts to save
+ */
+static void md_counts_store(struct Mailbox *m, const char *dir_name,
+                            const struct MdCounts *mdc)
+{
+  const char *const c_header_cache =
+      cs_subset_path(NeoMutt->sub, "header_cache");
+  struct HeaderCache *hc = mutt_hcache_open(c_header_cache, mailbox_path(m), NULL);
+  if (!hc)
+    return;
+
+  char key[32];
+  const int keylen = snprintf(key, sizeof(key), "/counts/%s", dir_name);
+
+  mutt_hcache_store_raw(hc, key, keylen, (void *) mdc, sizeof(*mdc));
+  mutt_hcache_close(hc);
+}
+#endif /* USE_HCACHE */
+
 /**
  * maildir_check_dir - Check for new mail / mail counts
  * @param m           Mailbox to check
@@ -81,6 +201,10 @@ struct Progress;
  * @param check_stats if true, count total, new, and flagged messages
  *
  * Checks the specified maildir subdir (cur or new) for new mail or mail counts.
+ *
+ * If `$maildir_parse_threads` is greater than one, the `$mail_check_recent`
+ * stat() calls are collected during the readdir() scan and issued as one
+ * parallel batch afterwards, instead of one blocking call per message.
  */
 static void maildir_check_dir(struct Mailbox *m, const char *dir_name,
                               bool check_new, bool check_stats)
@@ -98,6 +222,9 @@ static void maildir_check_dir(struct Mailbox *m, const char *dir_name,
    * the user last exited the m, then we know there is no recent mail.  */
   const bool c_mail_check_recent =
       cs_subset_bool(NeoMutt->sub, "mail_check_recent");
+  const short c_maildir_parse_threads =
+      cs_subset_number(NeoMutt->sub, "maildir_parse_threads");
+  struct MdPathArray candidates = ARRAY_HEAD_INITIALIZER;
   if (check_new && c_mail_check_recent)
   {
     if ((stat(mutt_buffer_string(path), &st) == 0) &&
@@ -110,6 +237,41 @@ static void maildir_check_dir(struct Mailbox *m, const char *dir_name,
   if (!(check_new || check_stats))
     goto cleanup;
 
+#ifdef USE_HCACHE
+  /* If the subdir is unchanged since the last scan, the counts stored in the
+   * header cache are still good and the readdir() can be skipped entirely */
+  struct timespec dir_mtime = { 0 };
+  struct timespec max_unread_ctime = { 0 };
+  bool ctimes_complete = check_new && c_mail_check_recent;
+  bool have_dir_mtime = false;
+  const int start_count = m->msg_count;
+  const int start_unread = m->msg_unread;
+  const int start_flagged = m->msg_flagged;
+  if (check_stats && (stat(mutt_buffer_string(path), &st) == 0))
+  {
+    mutt_file_get_stat_timespec(&dir_mtime, &st, MUTT_STAT_MTIME);
+    have_dir_mtime = true;
+
+    struct MdCounts mdc = { 0 };
+    if (md_counts_fetch(m, dir_name, &mdc) &&
+        (mutt_file_timespec_compare(&dir_mtime, &mdc.mtime) == 0) &&
+        (!check_new || !c_mail_check_recent || mdc.ctime_valid || (mdc.msg_unread == 0)))
+    {
+      m->msg_count += mdc.msg_count;
+      m->msg_unread += mdc.msg_unread;
+      m->msg_flagged += mdc.msg_flagged;
+      if (check_new && (mdc.msg_unread != 0) &&
+          (!c_mail_check_recent ||
+           (mutt_file_timespec_compare(&mdc.max_unread_ctime, &m->last_visited) > 0)))
+      {
+        m->has_new = true;
+        m->msg_new++;
+      }
+      goto cleanup;
+    }
+  }
+#endif
+
   dirp = opendir(mutt_buffer_string(path));
   if (!dirp)
   {
@@ -141,8 +303,26 @@ static void maildir_check_dir(struct Mailbox *m, const char *dir_name,
         if (c_mail_check_recent)
         {
           mutt_buffer_printf(msgpath, "%s/%s", mutt_buffer_string(path), de->d_name);
+          if (c_maildir_parse_threads > 1)
+          {
+            char *candidate = mutt_buffer_strdup(msgpath);
+            ARRAY_ADD(&candidates, candidate); // stat()'d by the worker pool below
+            continue;
+          }
           /* ensure this message was received since leaving this m */
-          if ((stat(mutt_buffer_string(msgpath), &st) == 0) &&
+          const int stat_rc = stat(mutt_buffer_string(msgpath), &st);
+#ifdef USE_HCACHE
+          if (stat_rc == 0)
+          {
+            struct timespec ctime_ts = { 0 };
+            mutt_file_get_stat_timespec(&ctime_ts, &st, MUTT_STAT_CTIME);
+            if (mutt_file_timespec_compare(&ctime_ts, &max_unread_ctime) > 0)
+              max_unread_ctime = ctime_ts;
+          }
+          else
+            ctimes_complete = false;
+#endif
+          if ((stat_rc == 0) &&
               (mutt_file_stat_timespec_compare(&st, MUTT_STAT_CTIME, &m->last_visited) <= 0))
           {
             continue;
@@ -154,11 +334,70 @@ static void maildir_check_dir(struct Mailbox *m, const char *dir_name,
         if (!check_stats)
           break;
       }
+#ifdef USE_HCACHE
+      else
+        ctimes_complete = false; // this unread message wasn't stat()'d
+#endif
     }
   }
 
   closedir(dirp);
 
+  const size_t num_candidates = ARRAY_SIZE(&candidates);
+  if (check_new && (num_candidates != 0))
+  {
+    bool *recent = mutt_mem_calloc(num_candidates, sizeof(bool));
+    struct timespec *ctimes = NULL;
+#ifdef USE_HCACHE
+    ctimes = mutt_mem_calloc(num_candidates, sizeof(struct timespec));
+#endif
+    struct MdStatCtx ctx = { candidates.entries, recent, ctimes, &m->last_visited };
+
+    mutt_worker_run(md_stat_worker, &ctx, num_candidates, c_maildir_parse_threads);
+
+    bool found_recent = false;
+    for (size_t i = 0; i < num_candidates; i++)
+    {
+      if (recent[i])
+        found_recent = true;
+#ifdef USE_HCACHE
+      if (mutt_file_timespec_compare(&ctimes[i], &max_unread_ctime) > 0)
+        max_unread_ctime = ctimes[i];
+#endif
+    }
+    if (found_recent)
+    {
+      m->has_new = true;
+      m->msg_new++;
+    }
+    FREE(&recent);
+    FREE(&ctimes);
+  }
+
+  char **cp = NULL;
+  ARRAY_FOREACH(cp, &candidates)
+  {
+    FREE(cp);
+  }
+  ARRAY_FREE(&candidates);
+
+#ifdef USE_HCACHE
+  /* Don't save a record whose mtime is still ticking: a delivery in the same
+   * second wouldn't invalidate it on filesystems with whole-second mtimes */
+  if (check_stats && have_dir_mtime && (dir_mtime.tv_sec < mutt_date_epoch()))
+  {
+    struct MdCounts mdc = { 0 };
+    mdc.version = MD_COUNTS_VERSION;
+    mdc.ctime_valid = ctimes_complete;
+    mdc.mtime = dir_mtime;
+    mdc.max_unread_ctime = max_unread_ctime;
+    mdc.msg_count = m->msg_count - start_count;
+    mdc.msg_unread = m->msg_unread - start_unread;
+    mdc.msg_flagged = m->msg_flagged - start_flagged;
+    md_counts_store(m, dir_name, &mdc);
+  }
+#endif
+
 cleanup:
   mutt_buffer_pool_release(&path);
   mutt_buffer_pool_release(&msgpath);
@@ -378,6 +617,53 @@ int maildir_rewrite_message(struct Mailbox *m, int msgno)
   return rc;
 }
 
+/**
+ * maildir_sync_paths - Work out where a message's flags say it should live
+ * @param m        Mailbox
+ * @param e        Email
+ * @param partpath Buffer for the new path, relative to the Mailbox
+ * @param fullpath Buffer for the new absolute path
+ * @param oldpath  Buffer for the current absolute path
+ * @retval  1 The message needs renaming
+ * @retval  0 The message is already in the right place
+ * @retval -1 Error
+ */
+static int maildir_sync_paths(struct Mailbox *m, struct Email *e, struct Buffer *partpath,
+                              struct Buffer *fullpath, struct Buffer *oldpath)
+{
+  char suffix[16];
+
+  char *p = strrchr(e->path, '/');
+  if (!p)
+  {
+    mutt_debug(LL_DEBUG1, "%s: unable to find subdir!\n", e->path);
+    return -1;
+  }
+  p++;
+  struct Buffer *newpath = mutt_buffer_pool_get();
+  mutt_buffer_strcpy(newpath, p);
+
+  /* kill the previous flags */
+  p = strchr(newpath->data, ':');
+  if (p)
+  {
+    *p = '\0';
+    newpath->dptr = p; /* fix buffer up, just to be safe */
+  }
+
+  maildir_gen_flags(suffix, sizeof(suffix), e);
+
+  mutt_buffer_printf(partpath, "%s/%s%s", (e->read || e->old) ? "cur" : "new",
+                     mutt_buffer_string(newpath), suffix);
+  mutt_buffer_printf(fullpath, "%s/%s", mailbox_path(m), mutt_buffer_string(partpath));
+  mutt_buffer_printf(oldpath, "%s/%s", mailbox_path(m), e->path);
+
+  mutt_buffer_pool_release(&newpath);
+
+  /* message hasn't really changed? */
+  return mutt_str_equal(mutt_buffer_string(fullpath), mutt_buffer_string(oldpath)) ? 0 : 1;
+}
+
 /**
  * maildir_sync_message - Sync an email to a Maildir folder
  * @param m     Mailbox
@@ -394,11 +680,9 @@ int maildir_sync_message(struct Mailbox *m, int msgno)
   if (!e)
     return -1;
 
-  struct Buffer *newpath = NULL;
   struct Buffer *partpath = NULL;
   struct Buffer *fullpath = NULL;
   struct Buffer *oldpath = NULL;
-  char suffix[16];
   int rc = 0;
 
   /* TODO: why the e->env check? */
@@ -415,40 +699,18 @@ int maildir_sync_message(struct Mailbox *m, int msgno)
   {
     /* we just have to rename the file. */
 
-    char *p = strrchr(e->path, '/');
-    if (!p)
-    {
-      mutt_debug(LL_DEBUG1, "%s: unable to find subdir!\n", e->path);
-      return -1;
-    }
-    p++;
-    newpath = mutt_buffer_pool_get();
     partpath = mutt_buffer_pool_get();
     fullpath = mutt_buffer_pool_get();
     oldpath = mutt_buffer_pool_get();
 
-    mutt_buffer_strcpy(newpath, p);
-
-    /* kill the previous flags */
-    p = strchr(newpath->data, ':');
-    if (p)
-    {
-      *p = '\0';
-      newpath->dptr = p; /* fix buffer up, just to be safe */
-    }
-
-    maildir_gen_flags(suffix, sizeof(suffix), e);
-
-    mutt_buffer_printf(partpath, "%s/%s%s", (e->read || e->old) ? "cur" : "new",
-                       mutt_buffer_string(newpath), suffix);
-    mutt_buffer_printf(fullpath, "%s/%s", mailbox_path(m), mutt_buffer_string(partpath));
-    mutt_buffer_printf(oldpath, "%s/%s", mailbox_path(m), e->path);
-
-    if (mutt_str_equal(mutt_buffer_string(fullpath), mutt_buffer_string(oldpath)))
+    const int moved = maildir_sync_paths(m, e, partpath, fullpath, oldpath);
+    if (moved < 0)
     {
-      /* message hasn't really changed */
+      rc = -1;
       goto cleanup;
     }
+    if (moved == 0)
+      goto cleanup;
 
     /* record that the message is possibly marked as trashed on disk */
     e->trash = e->deleted;
@@ -463,7 +725,6 @@ int maildir_sync_message(struct Mailbox *m, int msgno)
   }
 
 cleanup:
-  mutt_buffer_pool_release(&newpath);
   mutt_buffer_pool_release(&partpath);
   mutt_buffer_pool_release(&fullpath);
   mutt_buffer_pool_release(&oldpath);
@@ -589,34 +850,112 @@ size_t maildir_hcache_keylen(const char *fn)
   return p ? (size_t) (p - fn) : mutt_str_len(fn);
 }
 
+/**
+ * struct MdParseCtx - Shared state for parallel second-pass parsing
+ */
+struct MdParseCtx
+{
+  enum MailboxType type;        ///< Mailbox type, e.g. #MUTT_MAILDIR
+  const char *path;             ///< Mailbox path
+  struct MdEmailArray *pending; ///< Messages needing a header parse
+  struct Progress *progress;    ///< Progress bar, counted from every thread
+};
+
+/**
+ * md_parse_worker - Parse the headers of one message - Implements ::mutt_worker_fn_t
+ *
+ * On success, MdEmail.header_parsed is set; the Email of a failed parse is
+ * left for the caller to free, so the workers never touch shared state.
+ */
+static void md_parse_worker(size_t index, void *wdata)
+{
+  struct MdParseCtx *ctx = wdata;
+  struct MdEmail *md = *ARRAY_GET(ctx->pending, index);
+  char fn[PATH_MAX];
+
+  snprintf(fn, sizeof(fn), "%s/%s", ctx->path, md->email->path);
+  if (maildir_parse_message(ctx->type, fn, md->email->old, md->email))
+    md->header_parsed = true;
+
+  progress_count(ctx->progress);
+  progress_poll(ctx->progress); // Draws only on the main thread
+}
+
 /**
  * maildir_delayed_parsing - This function does the second parsing pass
- * @param[in]  m   Mailbox
- * @param[out] mda Maildir array to parse
+ * @param[in]  m     Mailbox
+ * @param[out] mda   Maildir array to parse
  * @param[in]  progress Progress bar
+ * @param[in]  hcreq Background header cache open, or NULL to open here
+ *
+ * If `$maildir_parse_threads` is greater than one, messages that miss the
+ * header cache are collected and parsed by a pool of worker threads.  Each
+ * parse is independent (one file, one Email), so results are merged back in
+ * array order afterwards.
  */
 void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
-                             struct Progress *progress)
+                             struct Progress *progress, struct HcacheOpenRequest *hcreq)
 {
   char fn[PATH_MAX];
 
 #ifdef USE_HCACHE
-  const char *const c_header_cache =
-      cs_subset_path(NeoMutt->sub, "header_cache");
-  struct HeaderCache *hc = mutt_hcache_open(c_header_cache, mailbox_path(m), NULL);
+  struct HeaderCache *hc = NULL;
+  if (hcreq)
+  {
+    hc = mutt_hcache_open_join(&hcreq);
+  }
+  else
+  {
+    const char *const c_header_cache =
+        cs_subset_path(NeoMutt->sub, "header_cache");
+    hc = mutt_hcache_open(c_header_cache, mailbox_path(m), NULL);
+  }
 #endif
 
+  const short c_maildir_parse_threads =
+      cs_subset_number(NeoMutt->sub, "maildir_parse_threads");
+  struct MdEmailArray pending = ARRAY_HEAD_INITIALIZER;
+
   struct MdEmail *md = NULL;
   struct MdEmail **mdp = NULL;
+
+#ifdef USE_HCACHE
+  /* Fetch all the cached headers in one store transaction, instead of one
+   * transaction per message */
+  const size_t num_msgs = ARRAY_SIZE(mda);
+  struct HCacheEntry *hces = NULL;
+  if (hc && (num_msgs > 0))
+  {
+#ifdef USE_DEBUG_TIMING
+    timing_start("maildir_hcache");
+#endif
+    const char **keys = mutt_mem_calloc(num_msgs, sizeof(char *));
+    size_t *keylens = mutt_mem_calloc(num_msgs, sizeof(size_t));
+    ARRAY_FOREACH(mdp, mda)
+    {
+      md = *mdp;
+      if (!md || !md->email || md->header_parsed)
+        continue;
+      keys[ARRAY_FOREACH_IDX] = md->email->path + 3;
+      keylens[ARRAY_FOREACH_IDX] = maildir_hcache_keylen(keys[ARRAY_FOREACH_IDX]);
+    }
+    hces = mutt_mem_calloc(num_msgs, sizeof(struct HCacheEntry));
+    if (mutt_hcache_fetch_batch(hc, keys, keylens, 0, hces, num_msgs) != 0)
+      FREE(&hces);
+    FREE(&keys);
+    FREE(&keylens);
+#ifdef USE_DEBUG_TIMING
+    timing_stop("maildir_hcache");
+#endif
+  }
+#endif
+
   ARRAY_FOREACH(mdp, mda)
   {
     md = *mdp;
     if (!md || !md->email || md->header_parsed)
       continue;
 
-    if (m->verbose && progress)
-      progress_update(progress, ARRAY_FOREACH_IDX, -1);
-
     snprintf(fn, sizeof(fn), "%s/%s", mailbox_path(m), md->email->path);
 
 #ifdef USE_HCACHE
@@ -629,9 +968,12 @@ void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
       rc = stat(fn, &st_lastchanged);
     }
 
-    const char *key = md->email->path + 3;
-    size_t keylen = maildir_hcache_keylen(key);
-    struct HCacheEntry hce = mutt_hcache_fetch(hc, key, keylen, 0);
+    struct HCacheEntry hce = { 0 };
+    if (hces)
+    {
+      hce = hces[ARRAY_FOREACH_IDX];
+      hces[ARRAY_FOREACH_IDX].email = NULL;
+    }
 
     if (hce.email && (rc == 0) && (st_lastchanged.st_mtime <= hce.uidvalidity))
     {
@@ -642,23 +984,80 @@ void maildir_delayed_parsing(struct Mailbox *m, struct MdEmailArray *mda,
       email_free(&md->email);
       md->email = hce.email;
       maildir_parse_flags(md->email, fn);
+      if (m->verbose)
+      {
+        /* The worker threads below share this count */
+        progress_count(progress);
+        progress_poll(progress);
+      }
+      continue;
+    }
+    email_free(&hce.email); /* stale or invalid cache entry */
+#endif
+
+    if (c_maildir_parse_threads > 1)
+    {
+      ARRAY_ADD(&pending, md); // Parsed by the worker pool below
+    }
+    else if (maildir_parse_message(m->type, fn, md->email->old, md->email))
+    {
+      md->header_parsed = true;
+#ifdef USE_HCACHE
+      const char *key = md->email->path + 3;
+      size_t keylen = maildir_hcache_keylen(key);
+      mutt_hcache_store(hc, key, keylen, md->email, 0);
+#endif
     }
     else
+      email_free(&md->email);
+
+    if ((c_maildir_parse_threads <= 1) && m->verbose)
+    {
+      progress_count(progress);
+      progress_poll(progress);
+    }
+  }
+
+#ifdef USE_HCACHE
+  FREE(&hces);
 #endif
+
+  if (!ARRAY_EMPTY(&pending))
+  {
+    struct MdParseCtx ctx = { m->type, mailbox_path(m), &pending,
+                              m->verbose ? progress : NULL };
+
+    /* Parse the first message on this thread; it warms up lazily-initialised
+     * library state (e.g. the precompiled regexes in prex) before the
+     * workers race over the rest. */
+    md_parse_worker(0, &ctx);
+
+    if (ARRAY_SIZE(&pending) > 1)
     {
-      if (maildir_parse_message(m->type, fn, md->email->old, md->email))
+      struct MdEmailArray rest = pending;
+      rest.entries = ARRAY_GET(&pending, 1);
+      rest.size--;
+      ctx.pending = &rest;
+      mutt_worker_run(md_parse_worker, &ctx, ARRAY_SIZE(&rest), c_maildir_parse_threads);
+    }
+
+    ARRAY_FOREACH(mdp, &pending)
+    {
+      md = *mdp;
+      if (!md->header_parsed)
       {
-        md->header_parsed = true;
+        email_free(&md->email);
+        continue;
+      }
 #ifdef USE_HCACHE
-        key = md->email->path + 3;
-        keylen = maildir_hcache_keylen(key);
-        mutt_hcache_store(hc, key, keylen, md->email, 0);
+      const char *key = md->email->path + 3;
+      size_t keylen = maildir_hcache_keylen(key);
+      mutt_hcache_store(hc, key, keylen, md->email, 0);
 #endif
-      }
-      else
-        email_free(&md->email);
     }
+    ARRAY_FREE(&pending);
   }
+
 #ifdef USE_HCACHE
   mutt_hcache_close(hc);
 #endif
@@ -694,10 +1093,32 @@ int maildir_read_dir(struct Mailbox *m, const char *subdir)
   }
 
   struct MdEmailArray mda = ARRAY_HEAD_INITIALIZER;
+
+  /* Open the header cache store while readdir() walks the folder - for some
+   * backends the open alone takes as long as the scan */
+  struct HcacheOpenRequest *hcreq = NULL;
+#ifdef USE_HCACHE
+  const char *const c_header_cache =
+      cs_subset_path(NeoMutt->sub, "header_cache");
+  hcreq = mutt_hcache_open_bg(c_header_cache, mailbox_path(m), NULL);
+#endif
+
+#ifdef USE_DEBUG_TIMING
+  timing_start("maildir_readdir");
+#endif
   int rc = maildir_parse_dir(m, &mda, subdir, progress);
+#ifdef USE_DEBUG_TIMING
+  timing_stop("maildir_readdir");
+  timing_add("maildir_entries", ARRAY_SIZE(&mda));
+#endif
   progress_free(&progress);
   if (rc < 0)
+  {
+#ifdef USE_HCACHE
+    mutt_hcache_close(mutt_hcache_open_join(&hcreq));
+#endif
     return -1;
+  }
 
   if (m->verbose)
   {
@@ -705,7 +1126,13 @@ int maildir_read_dir(struct Mailbox *m, const char *subdir)
     snprintf(msg, sizeof(msg), _("Reading %s..."), mailbox_path(m));
     progress = progress_new(msg, MUTT_PROGRESS_READ, ARRAY_SIZE(&mda));
   }
-  maildir_delayed_parsing(m, &mda, progress);
+#ifdef USE_DEBUG_TIMING
+  timing_start("maildir_parse");
+#endif
+  maildir_delayed_parsing(m, &mda, progress, hcreq);
+#ifdef USE_DEBUG_TIMING
+  timing_stop("maildir_parse");
+#endif
   progress_free(&progress);
 
   maildir_move_to_mailbox(m, &mda);
@@ -1035,6 +1462,110 @@ cleanup:
   return fp;
 }
 
+/**
+ * maildir_remove_subdir - Empty and remove one maildir subdirectory
+ * @param dfd  Open descriptor for the maildir itself
+ * @param name Subdirectory to remove, e.g. "cur"
+ * @retval  0 Success
+ * @retval -1 Error, see errno
+ *
+ * Unlink through the directory descriptor, so every entry costs one syscall
+ * instead of a path walk from the root.
+ */
+static int maildir_remove_subdir(int dfd, const char *name)
+{
+  int sfd = openat(dfd, name, O_RDONLY | O_DIRECTORY | O_NOFOLLOW | O_CLOEXEC);
+  if (sfd < 0)
+    return (errno == ENOENT) ? 0 : -1; /* a missing "tmp" is fine */
+
+  DIR *dp = fdopendir(sfd);
+  if (!dp)
+  {
+    close(sfd);
+    return -1;
+  }
+
+  int rc = 0;
+  struct dirent *de = NULL;
+  while ((de = readdir(dp)))
+  {
+    if (mutt_str_equal(de->d_name, ".") || mutt_str_equal(de->d_name, ".."))
+      continue;
+    if (unlinkat(sfd, de->d_name, 0) != 0)
+    {
+      rc = -1;
+      break;
+    }
+  }
+  closedir(dp); /* also closes sfd */
+
+  if (rc == 0)
+    rc = unlinkat(dfd, name, AT_REMOVEDIR);
+  return rc;
+}
+
+/**
+ * maildir_remove - Delete a maildir and all its messages
+ * @param path Maildir to delete
+ * @retval  0 Success
+ * @retval -1 Error, see errno
+ *
+ * Only the maildir structure itself (cur/new/tmp) is removed.  Anything else
+ * in the directory makes the final rmdir fail, rather than silently deleting
+ * files we don't own.
+ */
+int maildir_remove(const char *path)
+{
+  if (mx_path_probe(path) != MUTT_MAILDIR)
+  {
+    errno = ENOTDIR;
+    return -1;
+  }
+
+  int dfd = open(path, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+  if (dfd < 0)
+    return -1;
+
+  int rc = 0;
+  static const char *const subdirs[] = { "cur", "new", "tmp" };
+  for (size_t i = 0; (rc == 0) && (i < mutt_array_size(subdirs)); i++)
+    rc = maildir_remove_subdir(dfd, subdirs[i]);
+
+  close(dfd);
+  if (rc == 0)
+    rc = rmdir(path);
+  return rc;
+}
+
+/**
+ * maildir_rename - Rename a maildir
+ * @param src Current path of the maildir
+ * @param dst New path
+ * @retval  0 Success
+ * @retval -1 Error, see errno
+ *
+ * A maildir's message files don't contain the folder name, so on the same
+ * filesystem the whole folder moves with a single rename(2), no matter how
+ * many messages it holds.  Moves across filesystems are refused (EXDEV).
+ */
+int maildir_rename(const char *src, const char *dst)
+{
+  if (mx_path_probe(src) != MUTT_MAILDIR)
+  {
+    errno = ENOTDIR;
+    return -1;
+  }
+
+  struct stat st = { 0 };
+  if (stat(dst, &st) == 0)
+  {
+    errno = EEXIST;
+    return -1;
+  }
+
+  return rename(src, dst);
+}
+
 /**
  * maildir_check_empty - Is the mailbox empty
  * @param path Mailbox to check
@@ -1075,6 +1606,87 @@ int maildir_check_empty(const char *path)
   return rc;
 }
 
+/**
+ * maildir_count_messages - Count the messages in a Maildir without parsing them
+ * @param path Mailbox to check
+ * @retval num Number of messages in "cur" and "new"
+ * @retval -1  Error
+ */
+int maildir_count_messages(const char *path)
+{
+  char realpath[PATH_MAX];
+  int count = 0;
+
+  for (int iter = 0; iter < 2; iter++)
+  {
+    snprintf(realpath, sizeof(realpath), "%s/%s", path, (iter == 0) ? "cur" : "new");
+    DIR *dp = opendir(realpath);
+    if (!dp)
+      return -1;
+    struct dirent *de = NULL;
+    while ((de = readdir(dp)))
+    {
+      if (*de->d_name != '.')
+        count++;
+    }
+    closedir(dp);
+  }
+
+  return count;
+}
+
+/**
+ * maildir_quota_usage - Read a Maildir++ 'maildirsize' quota file
+ * @param[in]  path  Maildir root
+ * @param[out] size  Total number of bytes used (OPTIONAL)
+ * @param[out] count Total number of messages (OPTIONAL)
+ * @retval  0 Success
+ * @retval -1 There is no readable 'maildirsize' file
+ *
+ * Courier-style Maildir++ trees keep a 'maildirsize' file at the root: the
+ * first line defines the quota and every following line is a "bytes count"
+ * delta appended by a delivery or expunge.  Summing the deltas gives the
+ * current usage of the whole tree without walking it.
+ */
+int maildir_quota_usage(const char *path, uint64_t *size, uint64_t *count)
+{
+  char qfile[PATH_MAX];
+  snprintf(qfile, sizeof(qfile), "%s/maildirsize", path);
+
+  FILE *fp = fopen(qfile, "r");
+  if (!fp)
+    return -1;
+
+  char line[256];
+  long long total_size = 0;
+  long long total_count = 0;
+
+  /* the first line is the quota definition, e.g. "1000000000S,10000C" */
+  if (!fgets(line, sizeof(line), fp))
+  {
+    mutt_file_fclose(&fp);
+    return -1;
+  }
+
+  while (fgets(line, sizeof(line), fp))
+  {
+    long long d_size = 0;
+    long long d_count = 0;
+    if (sscanf(line, "%lld %lld", &d_size, &d_count) == 2)
+    {
+      total_size += d_size;
+      total_count += d_count;
+    }
+  }
+  mutt_file_fclose(&fp);
+
+  if (size)
+    *size = (total_size > 0) ? total_size : 0;
+  if (count)
+    *count = (total_count > 0) ? total_count : 0;
+  return 0;
+}
+
 /**
  * maildir_ac_owns_path - Check whether an Account own a Mailbox path - Implements MxOps::ac_owns_path() - @ingroup mx_ac_owns_path
  */
@@ -1320,7 +1932,7 @@ enum MxStatus maildir_mbox_check(struct Mailbox *m)
     mailbox_changed(m, NT_MAILBOX_RESORT);
 
   /* do any delayed parsing we need to do. */
-  maildir_delayed_parsing(m, &mda, NULL);
+  maildir_delayed_parsing(m, &mda, NULL, NULL);
 
   /* Incorporate new messages */
   num_new = maildir_move_to_mailbox(m, &mda);
@@ -1369,10 +1981,101 @@ static enum MxStatus maildir_mbox_check_stats(struct Mailbox *m, uint8_t flags)
   return m->msg_new ? MX_STATUS_NEW_MAIL : MX_STATUS_OK;
 }
 
+/**
+ * struct MdSyncJob - One filesystem operation of a mailbox sync
+ */
+struct MdSyncJob
+{
+  struct Email *e; ///< Email the operation belongs to
+  bool del;        ///< unlink() oldpath instead of renaming it
+  char *oldpath;   ///< Current absolute path
+  char *fullpath;  ///< New absolute path (renames only)
+  char *partpath;  ///< New Email::path (renames only)
+  int rc;          ///< Result of the operation
+};
+ARRAY_HEAD(MdSyncJobArray, struct MdSyncJob);
+
+/**
+ * md_sync_worker - Issue one sync rename/unlink - Implements ::mutt_worker_fn_t
+ *
+ * Failure to unlink is ignored, matching the serial code path.
+ */
+static void md_sync_worker(size_t index, void *wdata)
+{
+  struct MdSyncJobArray *jobs = wdata;
+  struct MdSyncJob *job = ARRAY_GET(jobs, index);
+
+  if (job->del)
+    unlink(job->oldpath);
+  else
+    job->rc = rename(job->oldpath, job->fullpath);
+}
+
+/**
+ * md_sync_jobs_free - Free the contents of a list of sync jobs
+ * @param jobs List to empty
+ */
+static void md_sync_jobs_free(struct MdSyncJobArray *jobs)
+{
+  struct MdSyncJob *job = NULL;
+  ARRAY_FOREACH(job, jobs)
+  {
+    FREE(&job->oldpath);
+    FREE(&job->fullpath);
+    FREE(&job->partpath);
+  }
+  ARRAY_FREE(jobs);
+}
+
+#ifdef USE_HCACHE
+/**
+ * maildir_hcache_gc - Sweep hcache records for messages that no longer exist
+ * @param m  Mailbox
+ * @param hc Header cache handle
+ *
+ * Deleted messages remove their own records, but messages removed by other
+ * clients leave records behind, and the database file only ever grows.
+ */
+static void maildir_hcache_gc(struct Mailbox *m, struct HeaderCache *hc)
+{
+  const char **keys = mutt_mem_calloc(m->msg_count + 2, sizeof(char *));
+  size_t *keylens = mutt_mem_calloc(m->msg_count + 2, sizeof(size_t));
+
+  size_t count = 0;
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      continue;
+    keys[count] = e->path + 3;
+    keylens[count] = maildir_hcache_keylen(keys[count]);
+    count++;
+  }
+
+  /* the subdir counts (see md_counts_store()) are not message records */
+  keys[count] = "/counts/new";
+  keylens[count] = mutt_str_len(keys[count]);
+  count++;
+  keys[count] = "/counts/cur";
+  keylens[count] = mutt_str_len(keys[count]);
+  count++;
+
+  mutt_hcache_gc(hc, keys, keylens, count);
+  FREE(&keys);
+  FREE(&keylens);
+}
+#endif
+
 /**
  * maildir_mbox_sync - Save changes to the Mailbox - Implements MxOps::mbox_sync() - @ingroup mx_mbox_sync
  * @retval enum #MxStatus
  *
+ * The deletes and flag renames are gathered up front and issued through a
+ * worker pool (see `$maildir_sync_threads`), which overlaps the filesystem
+ * round trips that dominate a purge on NFS.  Messages that need rewriting
+ * (attachment deletion, edited headers) still go through
+ * maildir_sync_message() serially.
+ *
  * @note The flag retvals come from a call to a backend sync function
  */
 enum MxStatus maildir_mbox_sync(struct Mailbox *m)
@@ -1381,8 +2084,8 @@ enum MxStatus maildir_mbox_sync(struct Mailbox *m)
   if (check == MX_STATUS_ERROR)
     return check;
 
-  struct HeaderCache *hc = NULL;
 #ifdef USE_HCACHE
+  struct HeaderCache *hc = NULL;
   const char *const c_header_cache =
       cs_subset_path(NeoMutt->sub, "header_cache");
   if (m->type == MUTT_MAILDIR)
@@ -1397,20 +2100,121 @@ enum MxStatus maildir_mbox_sync(struct Mailbox *m)
     progress = progress_new(msg, MUTT_PROGRESS_WRITE, m->msg_count);
   }
 
+  const bool c_maildir_trash = cs_subset_bool(NeoMutt->sub, "maildir_trash");
+  struct MdSyncJobArray jobs = ARRAY_HEAD_INITIALIZER;
+  struct Buffer *partpath = mutt_buffer_pool_get();
+  struct Buffer *fullpath = mutt_buffer_pool_get();
+  struct Buffer *oldpath = mutt_buffer_pool_get();
+
   for (int i = 0; i < m->msg_count; i++)
   {
     if (m->verbose)
       progress_update(progress, i, -1);
 
-    if (!maildir_sync_mailbox_message(m, i, hc))
+    struct Email *e = m->emails[i];
+    if (!e)
+      goto err_jobs;
+
+    if (e->deleted && !c_maildir_trash)
+    {
+      mutt_buffer_printf(oldpath, "%s/%s", mailbox_path(m), e->path);
+      struct MdSyncJob job = { e, true, mutt_buffer_strdup(oldpath), NULL, NULL, 0 };
+      ARRAY_ADD(&jobs, job);
+    }
+    else if (e->changed || e->attach_del ||
+             ((c_maildir_trash || e->trash) && (e->deleted != e->trash)))
+    {
+      if (e->attach_del || (e->env && e->env->changed))
+      {
+        /* rewrites change the file's contents; keep them serial */
+        if (maildir_sync_message(m, i) == -1)
+          goto err_jobs;
+      }
+      else
+      {
+        const int moved = maildir_sync_paths(m, e, partpath, fullpath, oldpath);
+        if (moved < 0)
+          goto err_jobs;
+        if (moved > 0)
+        {
+          /* record that the message is possibly marked as trashed on disk */
+          e->trash = e->deleted;
+
+          struct MdSyncJob job = { e, false, mutt_buffer_strdup(oldpath),
+                                   mutt_buffer_strdup(fullpath),
+                                   mutt_buffer_strdup(partpath), 0 };
+          ARRAY_ADD(&jobs, job);
+        }
+      }
+    }
+  }
+
+  if (ARRAY_SIZE(&jobs) != 0)
+  {
+    const short c_maildir_sync_threads =
+        cs_subset_number(NeoMutt->sub, "maildir_sync_threads");
+    mutt_worker_run(md_sync_worker, &jobs, ARRAY_SIZE(&jobs), c_maildir_sync_threads);
+  }
+
+  bool failed = false;
+  struct MdSyncJob *job = NULL;
+  ARRAY_FOREACH(job, &jobs)
+  {
+    if (job->del)
+    {
+#ifdef USE_HCACHE
+      if (hc)
+      {
+        const char *key = job->e->path + 3;
+        size_t keylen = maildir_hcache_keylen(key);
+        mutt_hcache_delete_record(hc, key, keylen);
+      }
+#endif
+    }
+    else if (job->rc == 0)
     {
-      progress_free(&progress);
-      goto err;
+      mutt_str_replace(&job->e->path, job->partpath);
     }
+    else
+    {
+      mutt_perror("rename");
+      failed = true;
+    }
+  }
+
+#ifdef USE_HCACHE
+  if (hc)
+  {
+    /* batched behind the renames, so the write-behind queue can group the
+     * records into as few store transactions as possible */
+    for (int i = 0; i < m->msg_count; i++)
+    {
+      struct Email *e = m->emails[i];
+      if (!e || !e->changed)
+        continue;
+
+      const char *key = e->path + 3;
+      size_t keylen = maildir_hcache_keylen(key);
+      mutt_hcache_store(hc, key, keylen, e, 0);
+    }
+  }
+#endif
+
+  md_sync_jobs_free(&jobs);
+  mutt_buffer_pool_release(&partpath);
+  mutt_buffer_pool_release(&fullpath);
+  mutt_buffer_pool_release(&oldpath);
+  if (failed)
+  {
+    progress_free(&progress);
+    goto err;
   }
   progress_free(&progress);
 
 #ifdef USE_HCACHE
+  const bool c_header_cache_gc = cs_subset_bool(NeoMutt->sub, "header_cache_gc");
+  if (hc && c_header_cache_gc)
+    maildir_hcache_gc(m, hc);
   if (m->type == MUTT_MAILDIR)
     mutt_hcache_close(hc);
 #endif
@@ -1438,6 +2242,13 @@ enum MxStatus maildir_mbox_sync(struct Mailbox *m)
 
   return check;
 
+err_jobs:
+  md_sync_jobs_free(&jobs);
+  mutt_buffer_pool_release(&partpath);
+  mutt_buffer_pool_release(&fullpath);
+  mutt_buffer_pool_release(&oldpath);
+  progress_free(&progress);
+
 err:
 #ifdef USE_HCACHE
   if (m->type == MUTT_MAILDIR)
@@ -1455,6 +2266,35 @@ enum MxStatus maildir_mbox_close(struct Mailbox *m)
   return MX_STATUS_OK;
 }
 
+/**
+ * maildir_msg_prefetch - Ask the kernel to read a message file
+ * @param m Mailbox
+ * @param e Email expected to be opened soon
+ *
+ * Start an asynchronous read of the message, so that it's already in the
+ * page cache by the time it's opened.  Particularly useful on network
+ * filesystems, where the fetch then overlaps with whatever the user is
+ * doing in the meantime.
+ */
+void maildir_msg_prefetch(struct Mailbox *m, struct Email *e)
+{
+#ifdef POSIX_FADV_WILLNEED
+  if (!m || !e || !e->path)
+    return;
+
+  char path[PATH_MAX];
+  snprintf(path, sizeof(path), "%s/%s", mailbox_path(m), e->path);
+
+  const int fd = open(path, O_RDONLY | O_CLOEXEC);
+  if (fd == -1)
+    return;
+
+  /* The readahead carries on after the file is closed */
+  posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+  close(fd);
+#endif
+}
+
 /**
  * maildir_msg_open - Open an email message in a Mailbox - Implements MxOps::msg_open() - @ingroup mx_msg_open
  */
@@ -1479,6 +2319,11 @@ static bool maildir_msg_open(struct Mailbox *m, struct Message *msg, int msgno)
     return false;
   }
 
+#ifdef POSIX_FADV_SEQUENTIAL
+  /* The message will be read start to finish */
+  posix_fadvise(fileno(msg->fp), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
   return true;
 }
 
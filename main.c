@@ -168,6 +168,8 @@
 #include "index/lib.h"
 #include "menu/lib.h"
 #include "ncrypt/lib.h"
+#include "pager/lib.h"
+#include "pattern/lib.h"
 #include "question/lib.h"
 #include "send/lib.h"
 #include "alternates.h"
@@ -176,15 +178,18 @@
 #include "hook.h"
 #include "init.h"
 #include "keymap.h"
+#include "mailcap.h"
 #include "mutt_globals.h"
 #include "mutt_history.h"
 #include "mutt_logging.h"
 #include "mutt_mailbox.h"
+#include "mutt_socket.h"
 #include "muttlib.h"
 #include "mx.h"
 #include "myvar.h"
 #include "options.h"
 #include "protos.h"
+#include "rfc3676.h"
 #include "subjectrx.h"
 #include "version.h"
 #ifdef ENABLE_NLS
@@ -204,6 +209,9 @@
 #ifdef USE_AUTOCRYPT
 #include "autocrypt/lib.h"
 #endif
+#ifdef USE_COMP_MBOX
+#include "compmbox/lib.h"
+#endif
 #if defined(USE_DEBUG_NOTIFY) || defined(HAVE_LIBUNWIND)
 #include "debug/lib.h"
 #endif
@@ -283,6 +291,7 @@ static bool usage(void)
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -g <server>"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -p"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -Q <variable> [-O]"));
+  puts(_("  neomutt [-n] [-e <command>] [-F <config>] -w [-f <mailbox>]"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -Z"));
   puts(_("  neomutt [-n] [-e <command>] [-F <config>] -z [-f <mailbox>]"));
   puts(_("  neomutt -v[v]\n"));
@@ -323,6 +332,8 @@ static bool usage(void)
   puts(_("  -s <subject>  Specify a subject (must be enclosed in quotes if it has spaces)"));
   puts(_("  -v            Print the NeoMutt version and compile-time definitions and exit"));
   puts(_("  -vv           Print the NeoMutt license and copyright information and exit"));
+  puts(_("  -w            Warm the caches of the specified (-f) or all defined mailboxes\n"
+         "                and exit; intended to be run from a cron job or systemd timer"));
   puts(_("  -y            Start NeoMutt with a listing of all defined mailboxes"));
   puts(_("  -Z            Open the first mailbox with new message or exit immediately with\n"
          "                exit code 1 if none is found in all defined mailboxes"));
@@ -334,6 +345,60 @@ static bool usage(void)
   return !ferror(stdout);
 }
 
+/**
+ * warm_mailbox_caches - Pre-parse mailboxes to warm their caches
+ * @param path Folder to warm, or empty to warm all the defined mailboxes
+ * @retval num Number of mailboxes warmed
+ *
+ * Open each mailbox headlessly, read-only, and close it again.  Parsing the
+ * folder pulls the header cache into the kernel page cache and adds entries
+ * for any newly delivered messages, so the next interactive open starts warm.
+ * The mailboxes are only peeked at, never modified, which makes the mode safe
+ * to run from a cron job or systemd timer alongside an interactive session.
+ */
+static int warm_mailbox_caches(const char *path)
+{
+  int warmed = 0;
+
+  if (path && (path[0] != '\0'))
+  {
+    struct Mailbox *m = mx_resolve(path);
+    if (mx_mbox_open(m, MUTT_READONLY | MUTT_QUIET | MUTT_NOSORT | MUTT_PEEK))
+    {
+      mx_mbox_close(m);
+      warmed++;
+    }
+    else
+    {
+      if (m->account)
+        account_mailbox_remove(m->account, m);
+      mailbox_free(&m);
+      mutt_error(_("Unable to open mailbox %s"), path);
+    }
+    return warmed;
+  }
+
+  struct MailboxList ml = STAILQ_HEAD_INITIALIZER(ml);
+  neomutt_mailboxlist_get_all(&ml, NeoMutt, MUTT_MAILBOX_ANY);
+  struct MailboxNode *np = NULL;
+  STAILQ_FOREACH(np, &ml, entries)
+  {
+    struct Mailbox *m = np->mailbox;
+
+    mutt_message(_("Warming %s..."), mailbox_path(m));
+
+    const bool old_peek = m->peekonly;
+    if (!mx_mbox_open(m, MUTT_READONLY | MUTT_QUIET | MUTT_NOSORT | MUTT_PEEK))
+      continue;
+    mx_mbox_close(m);
+    m->peekonly = old_peek;
+    warmed++;
+  }
+  neomutt_mailboxlist_clear(&ml);
+
+  return warmed;
+}
+
 /**
  * start_curses - Start the Curses UI
  * @retval 0 Success
@@ -504,6 +569,7 @@ main
   bool one_liner = false;
   bool hide_sensitive = false;
   bool batch_mode = false;
+  bool warm_caches = false;
   bool edit_infile = false;
 #ifdef USE_DEBUG_PARSE_TEST
   bool test_config = false;
@@ -514,6 +580,7 @@ main
   struct Buffer folder = mutt_buffer_make(0);
   struct Buffer expanded_infile = mutt_buffer_make(0);
   struct Buffer tempfile = mutt_buffer_make(0);
+  struct Buffer folder_spool = mutt_buffer_make(0);
   struct ConfigSet *cs = NULL;
 
   MuttLogger = log_disp_terminal;
@@ -553,7 +620,7 @@ main
     }
 
     /* USE_NNTP 'g:G' */
-    i = getopt(argc, argv, "+A:a:Bb:F:f:c:Dd:l:Ee:g:GH:i:hm:nOpQ:RSs:TvxyzZ");
+    i = getopt(argc, argv, "+A:a:Bb:F:f:c:Dd:l:Ee:g:GH:i:hm:nOpQ:RSs:TvwxyzZ");
     if (i != EOF)
     {
       switch (i)
@@ -641,6 +708,9 @@ main
         case 'v':
           version++;
           break;
+        case 'w':
+          warm_caches = true;
+          break;
         case 'y': /* My special hack mode */
           flags |= MUTT_CLI_SELECT;
           break;
@@ -760,9 +830,39 @@ main
     mutt_list_free(&cc_list);
   }
 
+  /* Reading a mailbox from stdin, e.g. `zcat big.mbox.gz | neomutt -f -`.
+   * Spool the stream to a temporary file so the mbox parser can seek, then
+   * hand stdin back to the terminal for the UI.  Only the headers and
+   * message offsets are held in memory; the bodies stay in the spool file,
+   * which is deleted on exit. */
+  if (explicit_folder && mutt_str_equal(mutt_buffer_string(&folder), "-"))
+  {
+    if (isatty(0))
+    {
+      mutt_error(_("Can't read a mailbox from a terminal"));
+      goto main_exit; // TEST45: neomutt -f - (no pipe)
+    }
+    mutt_buffer_mktemp(&folder_spool);
+    FILE *fp_spool = mutt_file_fopen(mutt_buffer_string(&folder_spool), "w");
+    if (!fp_spool)
+    {
+      mutt_perror(mutt_buffer_string(&folder_spool));
+      goto main_exit;
+    }
+    mutt_file_copy_stream(stdin, fp_spool);
+    mutt_file_fclose(&fp_spool);
+    if (!freopen("/dev/tty", "r", stdin))
+    {
+      mutt_perror("/dev/tty");
+      goto main_exit;
+    }
+    mutt_buffer_copy(&folder, &folder_spool);
+    flags |= MUTT_CLI_RO; /* the spool file is thrown away on exit */
+  }
+
   /* Check for a batch send. */
   if (!isatty(0) || !STAILQ_EMPTY(&queries) || !STAILQ_EMPTY(&alias_queries) ||
-      dump_variables || batch_mode)
+      dump_variables || batch_mode || warm_caches)
   {
     OptNoCurses = true;
     sendflags = SEND_BATCH;
@@ -944,6 +1044,20 @@ main
     goto main_ok; // TEST22: neomutt -B
   }
 
+  if (warm_caches)
+  {
+    mutt_buffer_expand_path(&folder);
+    int warmed = warm_mailbox_caches(mutt_buffer_string(&folder));
+#ifdef USE_IMAP
+    imap_logout_all();
+#endif
+    if (warmed > 0)
+      goto main_ok; // neomutt -w
+    if (!explicit_folder)
+      mutt_error(_("No mailboxes to warm"));
+    goto main_curses; // neomutt -n -F /dev/null -w
+  }
+
   notify_observer_add(NeoMutt->notify, NT_CONFIG, main_hist_observer, NULL);
   notify_observer_add(NeoMutt->notify, NT_CONFIG, main_log_observer, NULL);
   notify_observer_add(NeoMutt->notify, NT_CONFIG, main_config_observer, NULL);
@@ -1356,6 +1470,10 @@ main
     mutt_debug(LL_NOTIFY, "NT_GLOBAL_STARTUP\n");
     notify_send(NeoMutt->notify, NT_GLOBAL, NT_GLOBAL_STARTUP, NULL);
 
+    /* Open the TCP legs of the server connections in parallel; opening the
+     * folder and the first mailbox check will adopt them */
+    mutt_conn_preconnect();
+
     repeat_error = true;
     struct Mailbox *m = mx_resolve(mutt_buffer_string(&folder));
     const bool c_read_only = cs_subset_bool(NeoMutt->sub, "read_only");
@@ -1409,16 +1527,42 @@ main_curses:
   if (repeat_error && ErrorBufMessage)
     puts(ErrorBuf);
 main_exit:
+  if (!mutt_buffer_is_empty(&folder_spool))
+    unlink(mutt_buffer_string(&folder_spool));
   mutt_list_free(&commands);
+  mutt_account_oauth_cleanup();
+  mutt_preconn_cleanup();
   MuttLogger = log_disp_queue;
   mutt_buffer_dealloc(&folder);
   mutt_buffer_dealloc(&expanded_infile);
   mutt_buffer_dealloc(&tempfile);
+  mutt_buffer_dealloc(&folder_spool);
   mutt_list_free(&queries);
   crypto_module_free();
   rootwin_free();
+#ifdef USE_SMTP
+  mutt_smtp_cleanup();
+#endif
+  mutt_ch_cache_cleanup();
+  mutt_rfc3676_cleanup();
+  mutt_mime_types_cleanup();
+  mutt_render_cache_cleanup();
+  mutt_pattern_cache_cleanup();
+  mutt_trigram_cleanup();
+  mutt_date_index_cleanup();
+  mutt_flag_index_cleanup();
+  mx_cleanup();
+  mutt_body_pool_cleanup();
+  mutt_env_pool_cleanup();
+  email_pool_cleanup();
+  mutt_intern_cleanup();
+  mutt_mb_width_cache_cleanup();
   mutt_buffer_pool_free();
+  mutt_file_pool_free();
   mutt_envlist_free();
+#ifdef USE_COMP_MBOX
+  mutt_comp_cleanup();
+#endif
   mutt_browser_cleanup();
   mutt_commands_cleanup();
   menu_cleanup();
@@ -1428,6 +1572,7 @@ main_exit:
   attach_free();
   alternates_free();
   mutt_keys_free();
+  mailcap_cleanup();
   myvarlist_free(&MyVars);
   mutt_prex_free();
   neomutt_free(&NeoMutt);
@@ -36,6 +36,12 @@ static struct ConfigDef MboxVars[] = {
   { "check_mbox_size", DT_BOOL, false, 0, NULL,
     "(mbox,mmdf) Use mailbox size as an indicator of new mail"
   },
+  { "mbox_offset_index", DT_BOOL, false, 0, NULL,
+    "(mbox) Keep a sidecar index of message offsets for fast reopening"
+  },
+  { "mbox_use_mmap", DT_BOOL, false, 0, NULL,
+    "(mbox) Parse mbox files through mmap(2) rather than line-by-line reads"
+  },
   { NULL },
   // clang-format on
 };
@@ -61,6 +61,7 @@ extern struct MxOps MxMmdfOps;
 
 enum MxStatus    mbox_check(struct Mailbox *m, struct stat *st, bool check_stats);
 enum MailboxType mbox_path_probe(const char *path, const struct stat *st);
+int              mbox_count_messages(const char *path);
 void             mbox_reset_atime(struct Mailbox *m, struct stat *st);
 bool             mbox_test_new_folder(const char *path);
 
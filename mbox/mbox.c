@@ -41,6 +41,9 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <string.h>
+#ifdef HAVE_FMEMOPEN
+#include <sys/mman.h>
+#endif
 #include <sys/stat.h>
 #include <time.h>
 #include <unistd.h>
@@ -333,6 +336,582 @@ fail:
   return rc;
 }
 
+/// Magic string identifying an mbox offset index sidecar
+#define MBOX_INDEX_MAGIC "NeoMuttIdx1"
+/// How many bytes at the end of the mbox the index checksum covers
+#define MBOX_INDEX_TAIL 4096
+
+/**
+ * struct MboxIndexHeader - On-disk header of the mbox offset index
+ */
+struct MboxIndexHeader
+{
+  char magic[12];             ///< #MBOX_INDEX_MAGIC
+  uint32_t msg_count;         ///< Number of records that follow
+  uint64_t size;              ///< Size of the mbox when it was indexed
+  int64_t mtime;              ///< mtime of the mbox when it was indexed
+  unsigned char tail_md5[16]; ///< MD5 of the final #MBOX_INDEX_TAIL bytes
+};
+
+/**
+ * struct MboxIndexRecord - Per-message record of the mbox offset index
+ */
+struct MboxIndexRecord
+{
+  uint64_t offset; ///< Offset of the message's "From " separator line
+  int64_t length;  ///< Length of the message body
+  uint32_t lines;  ///< Number of lines in the message
+  uint32_t pad;    ///< Unused
+};
+
+/**
+ * mbox_index_path - Compose the path of the mbox offset index sidecar
+ * @param mboxpath Path to the mbox
+ * @param buf      Buffer for the result
+ *
+ * The index lives next to the mbox, as a dot-file, so it shares the mbox's
+ * filesystem and permissions.
+ */
+static void mbox_index_path(const char *mboxpath, struct Buffer *buf)
+{
+  char *dir = mutt_path_dirname(mboxpath);
+  const char *base = mutt_path_basename(mboxpath);
+  mutt_buffer_printf(buf, "%s/.%s.nmidx", NONULL(dir), NONULL(base));
+  FREE(&dir);
+}
+
+/**
+ * mbox_index_tail_md5 - Checksum the tail of an mbox file
+ * @param[in]  fp   Mbox stream
+ * @param[in]  size Size of the mbox
+ * @param[out] md5  Resulting digest
+ * @retval true Success
+ *
+ * The stream's position is preserved.
+ */
+static bool mbox_index_tail_md5(FILE *fp, LOFF_T size, unsigned char md5[16])
+{
+  char tail[MBOX_INDEX_TAIL];
+  const size_t len = MIN((size_t) size, sizeof(tail));
+  const LOFF_T pos = ftello(fp);
+
+  bool rc = false;
+  if (mutt_file_seek(fp, size - len, SEEK_SET) && (fread(tail, 1, len, fp) == len))
+  {
+    mutt_md5_bytes(tail, len, md5);
+    rc = true;
+  }
+
+  (void) mutt_file_seek(fp, pos, SEEK_SET);
+  return rc;
+}
+
+/**
+ * mbox_index_save - Write the mbox offset index sidecar
+ * @param m Mailbox
+ *
+ * Failure is silent: the index is a pure cache and the mbox may well live
+ * somewhere we can't write a dot-file (e.g. the system spool).
+ */
+static void mbox_index_save(struct Mailbox *m)
+{
+  const bool c_mbox_offset_index =
+      cs_subset_bool(NeoMutt->sub, "mbox_offset_index");
+  if (!c_mbox_offset_index || (m->type != MUTT_MBOX))
+    return;
+
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  if (!adata || !adata->fp)
+    return;
+
+  struct stat st = { 0 };
+  if (fstat(fileno(adata->fp), &st) != 0)
+    return;
+
+  struct MboxIndexHeader hdr = { MBOX_INDEX_MAGIC, 0, st.st_size, st.st_mtime, { 0 } };
+  if (!mbox_index_tail_md5(adata->fp, st.st_size, hdr.tail_md5))
+    return;
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    if (!m->emails[i]->deleted)
+      hdr.msg_count++;
+  }
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  struct Buffer *tmppath = mutt_buffer_pool_get();
+  mbox_index_path(mailbox_path(m), path);
+  mutt_buffer_printf(tmppath, "%s.tmp", mutt_buffer_string(path));
+
+  FILE *fp = mutt_file_fopen(mutt_buffer_string(tmppath), "w");
+  if (fp)
+  {
+    bool ok = (fwrite(&hdr, sizeof(hdr), 1, fp) == 1);
+    for (int i = 0; ok && (i < m->msg_count); i++)
+    {
+      struct Email *e = m->emails[i];
+      if (e->deleted)
+        continue;
+      struct MboxIndexRecord rec = { e->offset, e->body->length, e->lines, 0 };
+      ok = (fwrite(&rec, sizeof(rec), 1, fp) == 1);
+    }
+
+    if ((mutt_file_fclose(&fp) == 0) && ok)
+      rename(mutt_buffer_string(tmppath), mutt_buffer_string(path));
+    else
+      unlink(mutt_buffer_string(tmppath));
+  }
+
+  mutt_buffer_pool_release(&path);
+  mutt_buffer_pool_release(&tmppath);
+}
+
+/**
+ * mbox_index_load - Read a mailbox using its offset index sidecar
+ * @param m        Mailbox
+ * @param progress Progress bar
+ * @retval true The whole mailbox was loaded from the index
+ *
+ * Seek straight to each message's headers instead of scanning the file for
+ * separators, which skips reading the (usually much larger) bodies entirely.
+ * The index is only trusted if the mbox's size, mtime and tail checksum all
+ * still match; any inconsistency falls back to a full parse.
+ */
+static bool mbox_index_load(struct Mailbox *m, struct Progress *progress)
+{
+  const bool c_mbox_offset_index =
+      cs_subset_bool(NeoMutt->sub, "mbox_offset_index");
+  if (!c_mbox_offset_index || (m->type != MUTT_MBOX))
+    return false;
+
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  if (!adata || !adata->fp)
+    return false;
+
+  struct Buffer *path = mutt_buffer_pool_get();
+  mbox_index_path(mailbox_path(m), path);
+  FILE *fp_idx = mutt_file_fopen(mutt_buffer_string(path), "r");
+  mutt_buffer_pool_release(&path);
+  if (!fp_idx)
+    return false;
+
+  bool ok = false;
+  char buf[8192], return_path[256];
+  time_t t;
+
+  struct MboxIndexHeader hdr = { 0 };
+  unsigned char tail_md5[16];
+  if ((fread(&hdr, sizeof(hdr), 1, fp_idx) != 1) ||
+      (memcmp(hdr.magic, MBOX_INDEX_MAGIC, sizeof(hdr.magic)) != 0) ||
+      (hdr.size != (uint64_t) m->size) ||
+      (hdr.mtime != m->mtime.tv_sec) || (hdr.msg_count > (m->size / 6)) ||
+      !mbox_index_tail_md5(adata->fp, m->size, tail_md5) ||
+      (memcmp(tail_md5, hdr.tail_md5, sizeof(tail_md5)) != 0))
+  {
+    goto bail;
+  }
+
+  for (uint32_t i = 0; i < hdr.msg_count; i++)
+  {
+    struct MboxIndexRecord rec;
+    if ((fread(&rec, sizeof(rec), 1, fp_idx) != 1) ||
+        (rec.offset >= (uint64_t) m->size) || (rec.length < 0))
+    {
+      goto bail;
+    }
+
+    /* the separator must still be where the index says it is */
+    if (!mutt_file_seek(adata->fp, rec.offset, SEEK_SET) ||
+        !fgets(buf, sizeof(buf), adata->fp) ||
+        !is_from(buf, return_path, sizeof(return_path), &t))
+    {
+      goto bail;
+    }
+
+    if (m->verbose)
+      progress_update(progress, i, (int) (rec.offset / (m->size / 100 + 1)));
+
+    if (m->msg_count == m->email_max)
+      mx_alloc_memory(m);
+
+    struct Email *e = email_new();
+    m->emails[m->msg_count] = e;
+    e->received = t - mutt_date_local_tz(t);
+    e->offset = rec.offset;
+    e->index = m->msg_count;
+    m->msg_count++;
+
+    e->env = mutt_rfc822_read_header(adata->fp, e, false, false);
+    e->body->length = rec.length;
+    e->lines = rec.lines;
+
+    if ((e->body->offset + e->body->length) > m->size)
+      goto bail;
+
+    if (TAILQ_EMPTY(&e->env->return_path) && return_path[0])
+      mutt_addrlist_parse(&e->env->return_path, return_path);
+
+    if (TAILQ_EMPTY(&e->env->from))
+      mutt_addrlist_copy(&e->env->from, &e->env->return_path, false);
+  }
+
+  (void) mutt_file_seek(adata->fp, m->size, SEEK_SET);
+  ok = true;
+
+bail:
+  mutt_file_fclose(&fp_idx);
+  if (!ok)
+  {
+    /* Partial load; throw it away and let the caller do a full parse */
+    for (int i = 0; i < m->msg_count; i++)
+      email_free(&m->emails[i]);
+    m->msg_count = 0;
+    (void) mutt_file_seek(adata->fp, 0, SEEK_SET);
+  }
+  return ok;
+}
+
+/**
+ * mbox_count_messages - Count the messages in an mbox without parsing it
+ * @param path Path to the mbox
+ * @retval num Number of messages
+ * @retval -1  Error
+ *
+ * If a valid offset index sidecar exists, its message count is used for the
+ * price of checksumming the mbox's tail.  Otherwise stream the file counting
+ * the "From " separators, which still avoids allocating an Email (and
+ * parsing the headers) of every message.
+ */
+int mbox_count_messages(const char *path)
+{
+  struct stat st = { 0 };
+  if (stat(path, &st) != 0)
+    return -1;
+  if (st.st_size == 0)
+    return 0;
+
+  FILE *fp = mutt_file_fopen(path, "r");
+  if (!fp)
+    return -1;
+
+  int count = -1;
+
+  struct Buffer *idxpath = mutt_buffer_pool_get();
+  mbox_index_path(path, idxpath);
+  FILE *fp_idx = mutt_file_fopen(mutt_buffer_string(idxpath), "r");
+  mutt_buffer_pool_release(&idxpath);
+  if (fp_idx)
+  {
+    struct MboxIndexHeader hdr = { 0 };
+    unsigned char tail_md5[16];
+    if ((fread(&hdr, sizeof(hdr), 1, fp_idx) == 1) &&
+        (memcmp(hdr.magic, MBOX_INDEX_MAGIC, sizeof(hdr.magic)) == 0) &&
+        (hdr.size == (uint64_t) st.st_size) && (hdr.mtime == st.st_mtime) &&
+        mbox_index_tail_md5(fp, st.st_size, tail_md5) &&
+        (memcmp(tail_md5, hdr.tail_md5, sizeof(tail_md5)) == 0))
+    {
+      count = hdr.msg_count;
+    }
+    mutt_file_fclose(&fp_idx);
+  }
+
+  if (count < 0)
+  {
+    char buf[8192], return_path[256];
+    time_t t;
+    bool bol = true; /* only count "From " at the beginning of a line */
+    count = 0;
+
+    while (fgets(buf, sizeof(buf), fp))
+    {
+      if (bol && mutt_strn_equal(buf, "From ", 5) &&
+          is_from(buf, return_path, sizeof(return_path), &t))
+      {
+        count++;
+      }
+      bol = (strchr(buf, '\n') != NULL);
+    }
+  }
+
+  mutt_file_fclose(&fp);
+  return count;
+}
+
+/**
+ * mbox_journal_path - Compose the path of the mbox sync journal
+ * @param mboxpath Path to the mbox
+ * @param buf      Buffer for the result
+ *
+ * Like the offset index, the journal lives next to the mbox as a dot-file,
+ * so it survives exactly the crashes that the mbox itself survives.
+ */
+static void mbox_journal_path(const char *mboxpath, struct Buffer *buf)
+{
+  char *dir = mutt_path_dirname(mboxpath);
+  const char *base = mutt_path_basename(mboxpath);
+  mutt_buffer_printf(buf, "%s/.%s.nmsync", NONULL(dir), NONULL(base));
+  FREE(&dir);
+}
+
+/**
+ * mbox_journal_write - Record the intent to overwrite an mbox in place
+ * @param m        Mailbox
+ * @param offset   Offset where the in-place rewrite starts
+ * @param tempfile Temp file holding the rewritten tail
+ * @retval true The journal is safely on disk
+ *
+ * The journal exists only while the mailbox is being overwritten in place.
+ * If it is found when the mailbox is next opened, the last sync was cut
+ * short and the mailbox may be truncated mid-message; the journal records
+ * where the rewrite started and where the rewritten tail was kept.
+ */
+static bool mbox_journal_write(struct Mailbox *m, LOFF_T offset, const char *tempfile)
+{
+  struct Buffer *path = mutt_buffer_pool_get();
+  mbox_journal_path(mailbox_path(m), path);
+
+  bool rc = false;
+  FILE *fp = mutt_file_fopen(mutt_buffer_string(path), "w");
+  if (fp)
+  {
+    rc = (fprintf(fp, "rewrite-from " OFF_T_FMT "\ntail-copy %s\n", offset, tempfile) > 0) &&
+         (fflush(fp) == 0) && (fsync(fileno(fp)) == 0);
+    rc = (mutt_file_fclose(&fp) == 0) && rc;
+    if (!rc)
+      unlink(mutt_buffer_string(path));
+  }
+
+  mutt_buffer_pool_release(&path);
+  return rc;
+}
+
+/**
+ * mbox_journal_remove - Remove the mbox sync journal
+ * @param m Mailbox
+ *
+ * Call once the mailbox is whole again - the rewrite either completed or
+ * was rolled back.
+ */
+static void mbox_journal_remove(struct Mailbox *m)
+{
+  struct Buffer *path = mutt_buffer_pool_get();
+  mbox_journal_path(mailbox_path(m), path);
+  unlink(mutt_buffer_string(path));
+  mutt_buffer_pool_release(&path);
+}
+
+/**
+ * mbox_journal_check - Warn if the last sync of an mbox was interrupted
+ * @param m Mailbox
+ *
+ * A leftover journal means a sync died between starting to overwrite the
+ * mailbox and finishing; the mailbox may be missing its tail.  Leave the
+ * journal in place - it names the temp file holding the rewritten tail -
+ * and warn on every open until a sync completes.
+ */
+static void mbox_journal_check(struct Mailbox *m)
+{
+  struct Buffer *path = mutt_buffer_pool_get();
+  mbox_journal_path(mailbox_path(m), path);
+  if (access(mutt_buffer_string(path), F_OK) == 0)
+  {
+    mutt_error(_("The last sync of %s was interrupted, see %s"),
+               mailbox_path(m), mutt_buffer_string(path));
+  }
+  mutt_buffer_pool_release(&path);
+}
+
+#ifdef HAVE_FMEMOPEN
+/**
+ * mbox_parse_mailbox_mmap - Read an mbox mailbox via mmap(2)
+ * @param m        Mailbox
+ * @param progress Progress bar
+ * @retval enum #MxOpenReturns
+ *
+ * Scan for "\nFrom " message separators with memchr(3) over the mapped file
+ * and parse the headers through an fmemopen(3) stream straight out of the
+ * map, avoiding the per-line reads and copies of the fgets(3) path.
+ *
+ * @retval #MX_OPEN_ERROR The file can't be mapped; the caller should fall
+ *         back to the stream parser.
+ */
+static enum MxOpenReturns mbox_parse_mailbox_mmap(struct Mailbox *m, struct Progress *progress)
+{
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  if (!adata)
+    return MX_OPEN_ERROR;
+
+  const size_t size = m->size;
+  if (size == 0)
+    return MX_OPEN_OK;
+
+  char *base = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fileno(adata->fp), 0);
+  if (base == MAP_FAILED)
+    return MX_OPEN_ERROR;
+#ifdef MADV_SEQUENTIAL
+  madvise(base, size, MADV_SEQUENTIAL);
+#endif
+
+  FILE *fp_mem = fmemopen(base, size, "r");
+  if (!fp_mem)
+  {
+    munmap(base, size);
+    return MX_OPEN_ERROR;
+  }
+
+  char buf[8192], return_path[256];
+  struct Email *e_cur = NULL;
+  time_t t;
+  int count = 0, lines = 0;
+  size_t loc = ftello(adata->fp); // Appended mail starts part-way in
+
+  while ((loc < size) && !SigInt)
+  {
+    const char *line = base + loc;
+    const char *nl = memchr(line, '\n', size - loc);
+    const size_t linelen = nl ? (size_t) (nl - line) + 1 : size - loc;
+
+    if ((linelen >= 5) && mutt_strn_equal(line, "From ", 5))
+    {
+      /* is_from() needs a NUL-terminated copy of just this line */
+      const size_t n = MIN(linelen, sizeof(buf) - 1);
+      memcpy(buf, line, n);
+      buf[n] = '\0';
+
+      if (is_from(buf, return_path, sizeof(return_path), &t))
+      {
+        /* Save the Content-Length of the previous message */
+        if (count > 0)
+        {
+          struct Email *e = m->emails[m->msg_count - 1];
+          if (e->body->length < 0)
+          {
+            e->body->length = loc - e->body->offset - 1;
+            if (e->body->length < 0)
+              e->body->length = 0;
+          }
+          if (!e->lines)
+            e->lines = lines ? lines - 1 : 0;
+        }
+
+        count++;
+
+        if (m->verbose)
+          progress_update(progress, count, (int) (loc / (size / 100 + 1)));
+
+        if (m->msg_count == m->email_max)
+          mx_alloc_memory(m);
+
+        m->emails[m->msg_count] = email_new();
+        e_cur = m->emails[m->msg_count];
+        e_cur->received = t - mutt_date_local_tz(t);
+        e_cur->offset = loc;
+        e_cur->index = m->msg_count;
+
+        if (!mutt_file_seek(fp_mem, loc + linelen, SEEK_SET))
+          break;
+        e_cur->env = mutt_rfc822_read_header(fp_mem, e_cur, false, false);
+
+        loc = ftello(fp_mem); // Start of the body
+
+        /* If we know how long this message is, just skip over the body;
+         * validate the content-length against the separator it predicts.  */
+        if (e_cur->body->length > 0)
+        {
+          LOFF_T tmploc = ((size_t) e_cur->body->length < size) ?
+                              (LOFF_T) (loc + e_cur->body->length + 1) :
+                              -1;
+
+          if ((tmploc > 0) && ((size_t) tmploc < size))
+          {
+            if (((size_t) tmploc + 5 > size) ||
+                !mutt_strn_equal(base + tmploc, "From ", 5))
+            {
+              mutt_debug(LL_DEBUG1, "bad content-length in message %d (cl=" OFF_T_FMT ")\n",
+                         e_cur->index, e_cur->body->length);
+              e_cur->body->length = -1;
+            }
+          }
+          else if ((size_t) tmploc != size)
+          {
+            /* content-length would put us past the end of the file, so it
+             * must be wrong */
+            e_cur->body->length = -1;
+          }
+
+          if (e_cur->body->length != -1)
+          {
+            /* good content-length.  count the body's lines if we don't
+             * already know, straight off the map.  */
+            if (e_cur->lines == 0)
+            {
+              const char *p = base + loc;
+              const char *body_end = base + loc + e_cur->body->length;
+              while ((p = memchr(p, '\n', body_end - p)))
+              {
+                e_cur->lines++;
+                p++;
+              }
+            }
+
+            /* skip to the offset of the next message separator */
+            loc = tmploc;
+          }
+        }
+
+        m->msg_count++;
+
+        if (TAILQ_EMPTY(&e_cur->env->return_path) && return_path[0])
+        {
+          mutt_addrlist_parse(&e_cur->env->return_path, return_path);
+        }
+
+        if (TAILQ_EMPTY(&e_cur->env->from))
+          mutt_addrlist_copy(&e_cur->env->from, &e_cur->env->return_path, false);
+
+        lines = 0;
+        continue; // loc already points at the body or the next separator
+      }
+    }
+
+    lines++;
+    loc += linelen;
+  }
+
+  /* Only set the content-length of the previous message if we have read more
+   * than one message during _this_ invocation.  If this routine is called
+   * when new mail is received, we need to make sure not to clobber what
+   * previously was the last message since the headers may be sorted.  */
+  if (count > 0)
+  {
+    struct Email *e = m->emails[m->msg_count - 1];
+    if (e->body->length < 0)
+    {
+      e->body->length = size - e->body->offset - 1;
+      if (e->body->length < 0)
+        e->body->length = 0;
+    }
+
+    if (!e->lines)
+      e->lines = lines ? lines - 1 : 0;
+  }
+
+  mutt_file_fclose(&fp_mem);
+  munmap(base, size);
+
+  /* leave the real stream where the fgets(3) parser would have */
+  (void) mutt_file_seek(adata->fp, size, SEEK_SET);
+
+  if (SigInt)
+  {
+    SigInt = false;
+    return MX_OPEN_ABORT; /* action aborted */
+  }
+
+  return MX_OPEN_OK;
+}
+#endif /* HAVE_FMEMOPEN */
+
 /**
  * mbox_parse_mailbox - Read a mailbox from disk
  * @param m Mailbox
@@ -383,6 +962,24 @@ static enum MxOpenReturns mbox_parse_mailbox(struct Mailbox *m)
     progress = progress_new(msg, MUTT_PROGRESS_READ, 0);
   }
 
+  if ((m->msg_count == 0) && (ftello(adata->fp) == 0) && mbox_index_load(m, progress))
+  {
+    rc = MX_OPEN_OK;
+    goto fail;
+  }
+
+#ifdef HAVE_FMEMOPEN
+  const bool c_mbox_use_mmap = cs_subset_bool(NeoMutt->sub, "mbox_use_mmap");
+  if (c_mbox_use_mmap)
+  {
+    rc = mbox_parse_mailbox_mmap(m, progress);
+    if (rc != MX_OPEN_ERROR)
+      goto fail; /* parsed (or aborted) via the map */
+    /* The file couldn't be mapped, e.g. a pipe; drop back to fgets(3) */
+    rc = MX_OPEN_ERROR;
+  }
+#endif
+
   loc = ftello(adata->fp);
   while ((fgets(buf, sizeof(buf), adata->fp)) && !SigInt)
   {
@@ -522,6 +1119,8 @@ static enum MxOpenReturns mbox_parse_mailbox(struct Mailbox *m)
 
   rc = MX_OPEN_OK;
 fail:
+  if (rc == MX_OPEN_OK)
+    mbox_index_save(m);
   progress_free(&progress);
   return rc;
 }
@@ -631,34 +1230,61 @@ static int reopen_mailbox(struct Mailbox *m)
 
   if (!m->readonly)
   {
+    /* Index the old headers by Message-ID: most messages are then matched
+     * with a single hash probe instead of a sweep of the whole old array,
+     * which went quadratic when many messages had been expunged.
+     * The keys are copied because matched headers are freed mid-loop. */
+    struct HashTable *old_ids = NULL;
+    if (old_msg_count > 0)
+    {
+      old_ids = mutt_hash_new(old_msg_count * 2, MUTT_HASH_STRDUP_KEYS);
+      for (int j = 0; j < old_msg_count; j++)
+      {
+        if (e_old[j] && e_old[j]->env && e_old[j]->env->message_id)
+          mutt_hash_insert(old_ids, e_old[j]->env->message_id, &e_old[j]);
+      }
+    }
+
     for (int i = 0; i < m->msg_count; i++)
     {
       bool found = false;
+      struct Email **e_slot = NULL;
 
-      /* some messages have been deleted, and new  messages have been
-       * appended at the end; the heuristic is that old messages have then
-       * "advanced" towards the beginning of the folder, so we begin the
-       * search at index "i" */
-      int j;
-      for (j = i; j < old_msg_count; j++)
+      if (old_ids && m->emails[i]->env->message_id)
       {
-        if (!e_old[j])
-          continue;
-        if (cmp_headers(m->emails[i], e_old[j]))
-        {
+        e_slot = mutt_hash_find(old_ids, m->emails[i]->env->message_id);
+        if (e_slot && *e_slot && cmp_headers(m->emails[i], *e_slot))
           found = true;
-          break;
+      }
+
+      /* No (unique) Message-ID - fall back to scanning.  Some messages have
+       * been deleted, and new messages have been appended at the end; the
+       * heuristic is that old messages have then "advanced" towards the
+       * beginning of the folder, so we begin the search at index "i" */
+      if (!found)
+      {
+        for (int j = i; j < old_msg_count; j++)
+        {
+          if (!e_old[j])
+            continue;
+          if (cmp_headers(m->emails[i], e_old[j]))
+          {
+            found = true;
+            e_slot = &e_old[j];
+            break;
+          }
         }
       }
       if (!found)
       {
-        for (j = 0; (j < i) && (j < old_msg_count); j++)
+        for (int j = 0; (j < i) && (j < old_msg_count); j++)
         {
           if (!e_old[j])
             continue;
           if (cmp_headers(m->emails[i], e_old[j]))
           {
             found = true;
+            e_slot = &e_old[j];
             break;
           }
         }
@@ -666,26 +1292,29 @@ static int reopen_mailbox(struct Mailbox *m)
 
       if (found)
       {
+        struct Email *e_prev = *e_slot;
         m->changed = true;
-        if (e_old[j]->changed)
+        if (e_prev->changed)
         {
           /* Only update the flags if the old header was changed;
            * otherwise, the header may have been modified externally,
            * and we don't want to lose _those_ changes */
-          mutt_set_flag(m, m->emails[i], MUTT_FLAG, e_old[j]->flagged);
-          mutt_set_flag(m, m->emails[i], MUTT_REPLIED, e_old[j]->replied);
-          mutt_set_flag(m, m->emails[i], MUTT_OLD, e_old[j]->old);
-          mutt_set_flag(m, m->emails[i], MUTT_READ, e_old[j]->read);
+          mutt_set_flag(m, m->emails[i], MUTT_FLAG, e_prev->flagged);
+          mutt_set_flag(m, m->emails[i], MUTT_REPLIED, e_prev->replied);
+          mutt_set_flag(m, m->emails[i], MUTT_OLD, e_prev->old);
+          mutt_set_flag(m, m->emails[i], MUTT_READ, e_prev->read);
         }
-        mutt_set_flag(m, m->emails[i], MUTT_DELETE, e_old[j]->deleted);
-        mutt_set_flag(m, m->emails[i], MUTT_PURGE, e_old[j]->purge);
-        mutt_set_flag(m, m->emails[i], MUTT_TAG, e_old[j]->tagged);
+        mutt_set_flag(m, m->emails[i], MUTT_DELETE, e_prev->deleted);
+        mutt_set_flag(m, m->emails[i], MUTT_PURGE, e_prev->purge);
+        mutt_set_flag(m, m->emails[i], MUTT_TAG, e_prev->tagged);
 
         /* we don't need this header any more */
-        email_free(&(e_old[j]));
+        email_free(e_slot);
       }
     }
 
+    mutt_hash_free(&old_ids);
+
     /* free the remaining old headers */
     for (int j = 0; j < old_msg_count; j++)
     {
@@ -947,6 +1576,8 @@ static enum MxOpenReturns mbox_mbox_open(struct Mailbox *m)
     return MX_OPEN_ERROR;
   }
 
+  mbox_journal_check(m);
+
   mutt_sig_block();
   if (mbox_lock_mailbox(m, false, true) == -1)
   {
@@ -1156,6 +1787,168 @@ error:
   return MX_STATUS_ERROR;
 }
 
+/**
+ * struct MboxStatusPatch - An in-place Status header update
+ */
+struct MboxStatusPatch
+{
+  LOFF_T pos;     ///< Offset of the header's value in the mailbox
+  char value[16]; ///< Replacement value, padded with spaces
+  size_t len;     ///< Number of bytes to overwrite
+};
+
+/**
+ * mbox_patch_add - Plan an in-place rewrite of one Status header value
+ * @param patches     Array of planned patches
+ * @param num_patches Number of entries used in @a patches
+ * @param pos         Offset of the value (the bytes after the colon)
+ * @param len         Length of the existing value, excluding the newline
+ * @param flags       Flag characters to write, e.g. "RO"
+ * @retval true The new value fits over the old one
+ */
+static bool mbox_patch_add(struct MboxStatusPatch *patches, size_t *num_patches,
+                           LOFF_T pos, size_t len, const char *flags)
+{
+  struct MboxStatusPatch *p = &patches[*num_patches];
+
+  if ((len + 1) > sizeof(p->value)) // +1 for the leading space
+    return false;
+  if (flags[0] && ((strlen(flags) + 1) > len))
+    return false;
+
+  memset(p->value, ' ', len);
+  if (flags[0])
+    memcpy(p->value + 1, flags, strlen(flags));
+  p->pos = pos;
+  p->len = len;
+  (*num_patches)++;
+  return true;
+}
+
+/**
+ * mbox_sync_inplace - Patch flag changes over their old header bytes
+ * @param m Mailbox
+ * @retval true All changes were written in place
+ *
+ * When the only changes are message flags, rewriting the mailbox from the
+ * first changed message is gigabytes of io for a few bytes of Status: and
+ * X-Status: headers.  Overwrite those values in place instead, provided the
+ * new value fits in the old header's bytes and a header exists for every
+ * value we have to record.  If anything doesn't fit, write nothing and let
+ * the caller do the usual rewrite.
+ */
+static bool mbox_sync_inplace(struct Mailbox *m)
+{
+  if (m->type != MUTT_MBOX)
+    return false;
+
+  struct MboxAccountData *adata = mbox_adata_get(m);
+  if (!adata || !adata->fp)
+    return false;
+
+  /* structural changes need a real rewrite */
+  if (m->msg_deleted != 0)
+    return false;
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (e->deleted || e->attach_del || (e->changed && e->env->changed))
+      return false;
+  }
+
+  struct MboxStatusPatch *patches = NULL;
+  size_t num_patches = 0;
+  int num_changed = 0;
+  bool ok = false;
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e->changed)
+      continue;
+    num_changed++;
+
+    /* the values mutt_copy_hdr() would write under CH_UPDATE */
+    const char *status = e->read ? "RO" : (e->old ? "O" : "");
+    char xstatus[3] = { 0 };
+    if (e->replied)
+      mutt_str_cat(xstatus, sizeof(xstatus), "A");
+    if (e->flagged)
+      mutt_str_cat(xstatus, sizeof(xstatus), "F");
+
+    char buf[1024];
+    if (!mutt_file_seek(adata->fp, e->offset, SEEK_SET) ||
+        !fgets(buf, sizeof(buf), adata->fp) || !mutt_str_startswith(buf, "From "))
+    {
+      goto cleanup; /* message not where we expect it */
+    }
+
+    bool found_status = false;
+    bool found_xstatus = false;
+    bool at_bol = true;
+    LOFF_T pos = ftello(adata->fp);
+
+    while (pos < e->body->offset)
+    {
+      if (!fgets(buf, sizeof(buf), adata->fp))
+        goto cleanup;
+
+      const LOFF_T line_pos = pos;
+      pos = ftello(adata->fp);
+
+      const bool was_bol = at_bol;
+      at_bol = (strchr(buf, '\n') != NULL);
+      if (!was_bol)
+        continue; /* the rest of an over-long line */
+      if (buf[0] == '\n')
+        break; /* end of the headers */
+
+      size_t plen = mutt_istr_startswith(buf, "Status:");
+      const char *flags = status;
+      bool *found = &found_status;
+      if (plen == 0)
+      {
+        plen = mutt_istr_startswith(buf, "X-Status:");
+        flags = xstatus;
+        found = &found_xstatus;
+      }
+      if (plen == 0)
+        continue;
+
+      mutt_mem_realloc(&patches, (num_patches + 1) * sizeof(struct MboxStatusPatch));
+      const size_t vlen = strcspn(buf + plen, "\n");
+      if (!at_bol || /* value too long to have been written by us */
+          !mbox_patch_add(patches, &num_patches, line_pos + plen, vlen, flags))
+      {
+        goto cleanup;
+      }
+      *found = true;
+    }
+
+    /* a value we can't record in place forces a rewrite */
+    if ((status[0] && !found_status) || (xstatus[0] && !found_xstatus))
+      goto cleanup;
+  }
+
+  if (num_changed == 0)
+    goto cleanup; /* nothing to patch; let the caller report the oddity */
+
+  for (size_t i = 0; i < num_patches; i++)
+  {
+    if (!mutt_file_seek(adata->fp, patches[i].pos, SEEK_SET) ||
+        (fwrite(patches[i].value, 1, patches[i].len, adata->fp) != patches[i].len))
+    {
+      /* bail out; the caller's rewrite will leave the file consistent */
+      goto cleanup;
+    }
+  }
+  ok = (fflush(adata->fp) == 0);
+
+cleanup:
+  FREE(&patches);
+  return ok;
+}
+
 /**
  * mbox_mbox_sync - Save changes to the Mailbox - Implements MxOps::mbox_sync() - @ingroup mx_mbox_sync
  */
@@ -1169,6 +1962,8 @@ static enum MxStatus mbox_mbox_sync(struct Mailbox *m)
   char buf[32];
   int j;
   bool unlink_tempfile = false;
+  bool rename_commit = false;
+  bool journal_written = false;
   int need_sort = 0; /* flag to resort mailbox if new mail arrives */
   int first = -1;    /* first message to be written */
   LOFF_T offset;     /* location in mailbox to write changed messages */
@@ -1221,21 +2016,16 @@ static enum MxStatus mbox_mbox_sync(struct Mailbox *m)
     goto fatal;
   }
 
-  /* Create a temporary file to write the new version of the mailbox in. */
-  tempfile = mutt_buffer_pool_get();
-  mutt_buffer_mktemp(tempfile);
-  int fd = open(mutt_buffer_string(tempfile), O_WRONLY | O_EXCL | O_CREAT, 0600);
-  if ((fd == -1) || !(fp = fdopen(fd, "w")))
+  /* If only flags changed, patch the Status headers over their old bytes
+   * instead of rewriting everything after the first change */
+  if ((stat(mailbox_path(m), &st) == 0) && mbox_sync_inplace(m))
   {
-    if (fd != -1)
-    {
-      close(fd);
-      unlink_tempfile = true;
-    }
-    mutt_error(_("Could not create temporary file"));
-    goto bail;
+    mbox_unlock_mailbox(m);
+    mbox_reset_atime(m, &st); /* also restores the mtime; the size is unchanged */
+    mbox_index_save(m);       /* the index checksums the mailbox's tail bytes */
+    mutt_sig_unblock();
+    return 0; /* signal success */
   }
-  unlink_tempfile = true;
 
   /* find the first deleted/changed message.  we save a lot of time by only
    * rewriting the mailbox from the point where it has actually changed.  */
@@ -1266,6 +2056,43 @@ static enum MxStatus mbox_mbox_sync(struct Mailbox *m)
   if (m->type == MUTT_MMDF)
     offset -= (sizeof(MMDF_SEP) - 1);
 
+  /* Create a temporary file to write the new version of the mailbox in.
+   * If the whole mailbox is being rewritten, put the file next to the
+   * mailbox so the result can be rename()d into place atomically; a crash
+   * then leaves either the old or the new mailbox, never a half-written
+   * one, and the copy-back of the full file is skipped.  Otherwise (or if
+   * the mailbox's directory isn't writable) use $tmpdir and copy only the
+   * rewritten tail back over the original. */
+  tempfile = mutt_buffer_pool_get();
+  int fd = -1;
+  if (offset == 0)
+  {
+    char *dir = mutt_path_dirname(mailbox_path(m));
+    const char *base = mutt_path_basename(mailbox_path(m));
+    mutt_buffer_printf(tempfile, "%s/.%s.sync-%u", NONULL(dir), NONULL(base),
+                       (unsigned int) getpid());
+    FREE(&dir);
+    fd = open(mutt_buffer_string(tempfile), O_WRONLY | O_EXCL | O_CREAT, 0600);
+    if (fd != -1)
+      rename_commit = true;
+  }
+  if (fd == -1)
+  {
+    mutt_buffer_mktemp(tempfile);
+    fd = open(mutt_buffer_string(tempfile), O_WRONLY | O_EXCL | O_CREAT, 0600);
+  }
+  if ((fd == -1) || !(fp = fdopen(fd, "w")))
+  {
+    if (fd != -1)
+    {
+      close(fd);
+      unlink_tempfile = true;
+    }
+    mutt_error(_("Could not create temporary file"));
+    goto bail;
+  }
+  unlink_tempfile = true;
+
   /* allocate space for the new offsets */
   new_offset = mutt_mem_calloc(m->msg_count - first, sizeof(struct MUpdate));
   old_offset = mutt_mem_calloc(m->msg_count - first, sizeof(struct MUpdate));
@@ -1345,6 +2172,16 @@ static enum MxStatus mbox_mbox_sync(struct Mailbox *m)
     }
   }
 
+  /* When the new mailbox will be rename()d into place, it must be on disk
+   * before the rename, or a crash could leave the name pointing at an
+   * empty file.  The copy-back path overwrites the original either way, so
+   * it gains nothing from an fsync here. */
+  if (rename_commit && ((fflush(fp) != 0) || (fsync(fileno(fp)) != 0)))
+  {
+    mutt_perror(mutt_buffer_string(tempfile));
+    goto bail;
+  }
+
   if (mutt_file_fclose(&fp) != 0)
   {
     mutt_debug(LL_DEBUG1, "mutt_file_fclose (&) returned non-zero\n");
@@ -1361,61 +2198,92 @@ static enum MxStatus mbox_mbox_sync(struct Mailbox *m)
 
   unlink_tempfile = false;
 
-  fp = fopen(mutt_buffer_string(tempfile), "r");
-  if (!fp)
+  if (rename_commit)
   {
-    mutt_sig_unblock();
-    mx_fastclose_mailbox(m, false);
-    mutt_debug(LL_DEBUG1, "unable to reopen temp copy of mailbox!\n");
-    mutt_perror(mutt_buffer_string(tempfile));
-    FREE(&new_offset);
-    FREE(&old_offset);
-    goto fatal;
+    /* The whole mailbox was rewritten into a sibling file: move it into
+     * place.  The rename is atomic, so there is no window in which the
+     * mailbox is half-written, and nothing needs to be copied. */
+    (void) chmod(mutt_buffer_string(tempfile), st.st_mode & 07777);
+    if (rename(mutt_buffer_string(tempfile), mailbox_path(m)) == 0)
+    {
+      struct stat st_new = { 0 };
+      if (stat(mailbox_path(m), &st_new) == 0)
+        m->size = st_new.st_size;
+    }
+    else
+    {
+      /* e.g. the directory permissions changed under us; fall back to
+       * copying the rewrite back over the original */
+      rename_commit = false;
+    }
   }
 
-  if (!mutt_file_seek(adata->fp, offset, SEEK_SET) || /* seek the append location */
-      /* do a sanity check to make sure the mailbox looks ok */
-      !fgets(buf, sizeof(buf), adata->fp) ||
-      ((m->type == MUTT_MBOX) && !mutt_str_startswith(buf, "From ")) ||
-      ((m->type == MUTT_MMDF) && !mutt_str_equal(MMDF_SEP, buf)))
+  if (!rename_commit)
   {
-    mutt_debug(LL_DEBUG1, "message not in expected position\n");
-    mutt_debug(LL_DEBUG1, "    LINE: %s\n", buf);
-    i = -1;
-  }
-  else
-  {
-    if (!mutt_file_seek(adata->fp, offset, SEEK_SET)) /* return to proper offset */
+    /* Leave an intent journal while the original is overwritten in place;
+     * a crash in this window truncates the mailbox mid-message, and the
+     * journal is what tells the next open about it. */
+    journal_written = mbox_journal_write(m, offset, mutt_buffer_string(tempfile));
+
+    fp = fopen(mutt_buffer_string(tempfile), "r");
+    if (!fp)
     {
-      i = -1;
+      mutt_sig_unblock();
+      mx_fastclose_mailbox(m, false);
+      mutt_debug(LL_DEBUG1, "unable to reopen temp copy of mailbox!\n");
+      mutt_perror(mutt_buffer_string(tempfile));
+      FREE(&new_offset);
+      FREE(&old_offset);
+      goto fatal;
     }
-    else
-    {
-      /* copy the temp mailbox back into place starting at the first
-       * change/deleted message */
-      if (m->verbose)
-        mutt_message(_("Committing changes..."));
-      i = mutt_file_copy_stream(fp, adata->fp);
 
-      if (ferror(adata->fp))
-        i = -1;
+    if (!mutt_file_seek(adata->fp, offset, SEEK_SET) || /* seek the append location */
+        /* do a sanity check to make sure the mailbox looks ok */
+        !fgets(buf, sizeof(buf), adata->fp) ||
+        ((m->type == MUTT_MBOX) && !mutt_str_startswith(buf, "From ")) ||
+        ((m->type == MUTT_MMDF) && !mutt_str_equal(MMDF_SEP, buf)))
+    {
+      mutt_debug(LL_DEBUG1, "message not in expected position\n");
+      mutt_debug(LL_DEBUG1, "    LINE: %s\n", buf);
+      i = -1;
     }
-    if (i >= 0)
+    else
     {
-      m->size = ftello(adata->fp); /* update the mailbox->size of the mailbox */
-      if ((m->size < 0) || (ftruncate(fileno(adata->fp), m->size) != 0))
+      if (!mutt_file_seek(adata->fp, offset, SEEK_SET)) /* return to proper offset */
       {
         i = -1;
-        mutt_debug(LL_DEBUG1, "ftruncate() failed\n");
+      }
+      else
+      {
+        /* copy the temp mailbox back into place starting at the first
+         * change/deleted message */
+        if (m->verbose)
+          mutt_message(_("Committing changes..."));
+        i = mutt_file_copy_stream(fp, adata->fp);
+
+        if (ferror(adata->fp))
+          i = -1;
+      }
+      if (i >= 0)
+      {
+        m->size = ftello(adata->fp); /* update the mailbox->size of the mailbox */
+        if ((m->size < 0) || (ftruncate(fileno(adata->fp), m->size) != 0))
+        {
+          i = -1;
+          mutt_debug(LL_DEBUG1, "ftruncate() failed\n");
+        }
       }
     }
+
+    mutt_file_fclose(&fp);
+    fp = NULL;
   }
 
-  mutt_file_fclose(&fp);
-  fp = NULL;
   mbox_unlock_mailbox(m);
 
-  if ((mutt_file_fclose(&adata->fp) != 0) || (i == -1))
+  /* After a successful rename the old inode is already replaced, so a
+   * failure closing its stream can't hurt the data on disk. */
+  if (((mutt_file_fclose(&adata->fp) != 0) && !rename_commit) || (i == -1))
   {
     /* error occurred while writing the mailbox back, so keep the temp copy around */
 
@@ -1435,6 +2303,10 @@ static enum MxStatus mbox_mbox_sync(struct Mailbox *m)
     goto fatal;
   }
 
+  /* the mailbox is whole again */
+  if (journal_written)
+    mbox_journal_remove(m);
+
   /* Restore the previous access/modification times */
   mbox_reset_atime(m, &st);
 
@@ -1470,6 +2342,7 @@ static enum MxStatus mbox_mbox_sync(struct Mailbox *m)
   FREE(&old_offset);
   unlink(mutt_buffer_string(tempfile)); /* remove partial copy of the mailbox */
   mutt_buffer_pool_release(&tempfile);
+  mbox_index_save(m); /* offsets have moved; refresh the sidecar index */
   mutt_sig_unblock();
 
   const bool c_check_mbox_size =
@@ -47,6 +47,28 @@
 #include "opcodes.h"
 #include "options.h"
 
+/**
+ * match_color - Find the first colour rule matching an email
+ * @param cid Colour list, e.g. #MT_COLOR_INDEX_AUTHOR
+ * @param m   Mailbox
+ * @param e   Email
+ * @retval ptr Colour of the first matching rule, or NULL if none match
+ */
+static struct AttrColor *match_color(enum ColorId cid, struct Mailbox *m, struct Email *e)
+{
+  struct RegexColor *np = NULL;
+
+  STAILQ_FOREACH(np, regex_colors_get_list(cid), entries)
+  {
+    if (mutt_pattern_exec(SLIST_FIRST(np->color_pattern), MUTT_MATCH_FULL_ADDRESS, m, e, NULL))
+    {
+      return &np->attr_color;
+    }
+  }
+
+  return NULL;
+}
+
 /**
  * get_color - Choose a colour for a line of the index
  * @param index Index number
@@ -58,7 +80,6 @@
  */
 static struct AttrColor *get_color(int index, unsigned char *s)
 {
-  struct RegexColorList *rcl = NULL;
   struct RegexColor *np = NULL;
   struct Mailbox *m_cur = get_current_mailbox();
   struct Email *e = mutt_get_virt_email(m_cur, index);
@@ -67,14 +88,25 @@ static struct AttrColor *get_color(int index, unsigned char *s)
   switch (type)
   {
     case MT_COLOR_INDEX_AUTHOR:
-      rcl = regex_colors_get_list(MT_COLOR_INDEX_AUTHOR);
-      break;
     case MT_COLOR_INDEX_FLAGS:
-      rcl = regex_colors_get_list(MT_COLOR_INDEX_FLAGS);
-      break;
     case MT_COLOR_INDEX_SUBJECT:
-      rcl = regex_colors_get_list(MT_COLOR_INDEX_SUBJECT);
-      break;
+      if (!e)
+        return NULL;
+      /* Matching the colour rules is costly, so the results are cached in
+       * the Email.  Whatever changes the outcome - flags, tags, colour
+       * commands - resets Email::index_color_valid. */
+      if (!e->index_color_valid)
+      {
+        e->author_color = match_color(MT_COLOR_INDEX_AUTHOR, m_cur, e);
+        e->flags_color = match_color(MT_COLOR_INDEX_FLAGS, m_cur, e);
+        e->subject_color = match_color(MT_COLOR_INDEX_SUBJECT, m_cur, e);
+        e->index_color_valid = true;
+      }
+      if (type == MT_COLOR_INDEX_AUTHOR)
+        return e->author_color;
+      if (type == MT_COLOR_INDEX_FLAGS)
+        return e->flags_color;
+      return e->subject_color;
     case MT_COLOR_INDEX_TAG:
       STAILQ_FOREACH(np, regex_colors_get_list(MT_COLOR_INDEX_TAG), entries)
       {
@@ -90,17 +122,6 @@ static struct AttrColor *get_color(int index, unsigned char *s)
     default:
       return simple_color_get(type);
   }
-
-  STAILQ_FOREACH(np, rcl, entries)
-  {
-    if (mutt_pattern_exec(SLIST_FIRST(np->color_pattern),
-                          MUTT_MATCH_FULL_ADDRESS, m_cur, e, NULL))
-    {
-      return &np->attr_color;
-    }
-  }
-
-  return NULL;
 }
 
 /**
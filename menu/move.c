@@ -70,7 +70,10 @@ MenuRedrawFlags menu_set_and_notify(struct Menu *menu, int top, int index)
   if (top != menu->top)
   {
     menu->top = top;
-    flags |= MENU_REDRAW_FULL;
+    /* Every row is rewritten in full, so there's no need to clear the
+     * Window first (MENU_REDRAW_FULL); curses will only emit the cells
+     * that differ */
+    flags |= MENU_REDRAW_INDEX;
   }
 
   if (index != menu->current)
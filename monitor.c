@@ -39,6 +39,7 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include "mutt/lib.h"
+#include "config/lib.h"
 #include "core/lib.h"
 #include "gui/lib.h"
 #include "monitor.h"
@@ -65,6 +66,9 @@ static int MonitorContextDescriptor = -1;
 
 #define EVENT_BUFLEN MAX(4096, sizeof(struct inotify_event) + NAME_MAX + 1)
 
+/// Longest time, in milliseconds, the debounce loop may delay the main loop
+#define MONITOR_DEBOUNCE_MAX 1000
+
 /**
  * enum ResolveResult - Results for the Monitor functions
  */
@@ -88,6 +92,7 @@ struct Monitor
   ino_t st_ino;
   enum MailboxType type;
   int desc;
+  bool dirty; ///< Events arrived since the flag was last taken
 };
 
 /**
@@ -317,6 +322,65 @@ static int monitor_handle_ignore(int desc)
   return new_desc;
 }
 
+/**
+ * monitor_mark_dirty - Flag the monitor owning a watch descriptor
+ * @param desc Watch descriptor
+ */
+static void monitor_mark_dirty(int desc)
+{
+  struct Monitor *iter = Monitor;
+
+  while (iter && (iter->desc != desc))
+    iter = iter->next;
+
+  if (iter)
+    iter->dirty = true;
+}
+
+/**
+ * monitor_handle_events - Drain and dispatch the pending inotify events
+ *
+ * Reads until the (non-blocking) inotify descriptor is empty, so a burst of
+ * events is consumed in one go.
+ */
+static void monitor_handle_events(void)
+{
+  char buf[EVENT_BUFLEN] __attribute__((aligned(__alignof__(struct inotify_event))));
+
+  while (true)
+  {
+    int len = read(INotifyFd, buf, sizeof(buf));
+    if (len == -1)
+    {
+      if (errno != EAGAIN)
+      {
+        mutt_debug(LL_DEBUG2, "read inotify events failed, errno=%d %s\n",
+                   errno, strerror(errno));
+      }
+      break;
+    }
+
+    char *ptr = buf;
+    while (ptr < (buf + len))
+    {
+      const struct inotify_event *event = (const struct inotify_event *) ptr;
+      mutt_debug(LL_DEBUG3, "+ detail: descriptor=%d mask=0x%x\n", event->wd,
+                 event->mask);
+      if (event->mask & IN_IGNORED)
+      {
+        monitor_handle_ignore(event->wd);
+      }
+      else
+      {
+        if (event->wd == MonitorContextDescriptor)
+          MonitorContextChanged = true;
+        monitor_mark_dirty(event->wd);
+      }
+      ptr += sizeof(struct inotify_event) + event->len;
+    }
+  }
+}
+
 /**
  * monitor_resolve - Get the monitor for a mailbox
  * @param[out] info Details of the mailbox's monitor
@@ -397,11 +461,16 @@ static enum ResolveResult monitor_resolve(struct MonitorInfo *info, struct Mailb
  *
  * Only STDIN and INotify file handles currently expected/supported.
  * More would ask for common infrastructure (sockets?).
+ *
+ * When `$monitor_debounce` is set, the first event starts a debounce window:
+ * as long as further events keep arriving within the window, they are drained
+ * and coalesced, so a bulk maildir delivery wakes the main loop (and triggers
+ * a mailbox check) once instead of once per file.  A keypress ends the window
+ * early and the total delay is capped at #MONITOR_DEBOUNCE_MAX.
  */
 int mutt_monitor_poll(void)
 {
   int rc = 0;
-  char buf[EVENT_BUFLEN] __attribute__((aligned(__alignof__(struct inotify_event))));
 
   MonitorFilesChanged = false;
 
@@ -433,33 +502,23 @@ int mutt_monitor_poll(void)
           {
             MonitorFilesChanged = true;
             mutt_debug(LL_DEBUG3, "file change(s) detected\n");
-            char *ptr = buf;
-            const struct inotify_event *event = NULL;
+            monitor_handle_events();
 
-            while (true)
+            const short c_monitor_debounce =
+                cs_subset_number(NeoMutt->sub, "monitor_debounce");
+            int waited = 0;
+            while ((c_monitor_debounce > 0) && (waited < MONITOR_DEBOUNCE_MAX))
             {
-              int len = read(INotifyFd, buf, sizeof(buf));
-              if (len == -1)
-              {
-                if (errno != EAGAIN)
-                {
-                  mutt_debug(LL_DEBUG2, "read inotify events failed, errno=%d %s\n",
-                             errno, strerror(errno));
-                }
-                break;
-              }
-
-              while (ptr < (buf + len))
-              {
-                event = (const struct inotify_event *) ptr;
-                mutt_debug(LL_DEBUG3, "+ detail: descriptor=%d mask=0x%x\n",
-                           event->wd, event->mask);
-                if (event->mask & IN_IGNORED)
-                  monitor_handle_ignore(event->wd);
-                else if (event->wd == MonitorContextDescriptor)
-                  MonitorContextChanged = true;
-                ptr += sizeof(struct inotify_event) + event->len;
-              }
+              struct pollfd pfds[2] = {
+                { 0, POLLIN, 0 },
+                { INotifyFd, POLLIN, 0 },
+              };
+              if (poll(pfds, 2, c_monitor_debounce) <= 0)
+                break; // the burst has died down
+              if (pfds[0].revents)
+                break; // don't delay a keypress
+              monitor_handle_events();
+              waited += c_monitor_debounce;
             }
           }
         }
@@ -516,6 +575,31 @@ cleanup:
   return rc;
 }
 
+/**
+ * mutt_monitor_take_dirty - Check and clear a mailbox's dirty flag
+ * @param m Mailbox
+ * @retval true Events arrived for the mailbox since the flag was last taken
+ *
+ * A mailbox with an active watch and a clear dirty flag hasn't changed on
+ * disk, so a caller polling many mailboxes can skip it.  Mailboxes without a
+ * watch always count as dirty.
+ */
+bool mutt_monitor_take_dirty(struct Mailbox *m)
+{
+  struct MonitorInfo info;
+  monitor_info_init(&info);
+
+  bool dirty = true;
+  if (monitor_resolve(&info, m) == RESOLVE_RES_OK_EXISTING)
+  {
+    dirty = info.monitor->dirty;
+    info.monitor->dirty = false;
+  }
+
+  monitor_info_free(&info);
+  return dirty;
+}
+
 /**
  * mutt_monitor_remove - Remove a watch for a mailbox
  * @param m Mailbox
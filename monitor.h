@@ -30,8 +30,9 @@ struct Mailbox;
 extern bool MonitorFilesChanged;   ///< true after a monitored file has changed
 extern bool MonitorContextChanged; ///< true after the current mailbox has changed
 
-int mutt_monitor_add(struct Mailbox *m);
-int mutt_monitor_remove(struct Mailbox *m);
-int mutt_monitor_poll(void);
+int  mutt_monitor_add(struct Mailbox *m);
+int  mutt_monitor_poll(void);
+int  mutt_monitor_remove(struct Mailbox *m);
+bool mutt_monitor_take_dirty(struct Mailbox *m);
 
 #endif /* MUTT_MONITOR_H */
@@ -95,10 +95,14 @@ size_t mutt_b64_encode(const char *in, size_t inlen, char *out, size_t outlen)
 
   while ((inlen >= 3) && (outlen > 4))
   {
-    *out++ = B64Chars[inu[0] >> 2];
-    *out++ = B64Chars[((inu[0] << 4) & 0x30) | (inu[1] >> 4)];
-    *out++ = B64Chars[((inu[1] << 2) & 0x3c) | (inu[2] >> 6)];
-    *out++ = B64Chars[inu[2] & 0x3f];
+    /* gather the group into one register; the four lookups can then be
+     * scheduled (or vectorized) independently of the loads */
+    const unsigned int acc = ((unsigned int) inu[0] << 16) |
+                             ((unsigned int) inu[1] << 8) | inu[2];
+    *out++ = B64Chars[(acc >> 18) & 0x3f];
+    *out++ = B64Chars[(acc >> 12) & 0x3f];
+    *out++ = B64Chars[(acc >> 6) & 0x3f];
+    *out++ = B64Chars[acc & 0x3f];
     outlen -= 4;
     inlen -= 3;
     inu += 3;
@@ -138,41 +142,58 @@ int mutt_b64_decode(const char *in, char *out, size_t olen)
   if (!in || !out)
     return -1;
 
-  int len = 0;
+  size_t len = 0;
   unsigned char digit4;
 
   do
   {
+    /* look each digit up once; the checks below reuse the values */
     const unsigned char digit1 = in[0];
-    if ((digit1 > 127) || (base64val(digit1) == BAD))
+    const int val1 = (digit1 < 128) ? base64val(digit1) : BAD;
+    if (val1 == BAD)
       return -1;
     const unsigned char digit2 = in[1];
-    if ((digit2 > 127) || (base64val(digit2) == BAD))
+    const int val2 = (digit2 < 128) ? base64val(digit2) : BAD;
+    if (val2 == BAD)
       return -1;
     const unsigned char digit3 = in[2];
-    if ((digit3 > 127) || ((digit3 != '=') && (base64val(digit3) == BAD)))
+    const int val3 = (digit3 < 128) ? base64val(digit3) : BAD;
+    if ((val3 == BAD) && (digit3 != '='))
       return -1;
     digit4 = in[3];
-    if ((digit4 > 127) || ((digit4 != '=') && (base64val(digit4) == BAD)))
+    const int val4 = (digit4 < 128) ? base64val(digit4) : BAD;
+    if ((val4 == BAD) && (digit4 != '='))
       return -1;
     in += 4;
 
+    if ((val3 != BAD) && (val4 != BAD) && (len + 3 <= olen))
+    {
+      /* unpadded group with room to spare - emit all three bytes at once */
+      const unsigned int acc = ((unsigned int) val1 << 18) |
+                               ((unsigned int) val2 << 12) | (val3 << 6) | val4;
+      *out++ = acc >> 16;
+      *out++ = (acc >> 8) & 0xff;
+      *out++ = acc & 0xff;
+      len += 3;
+      continue;
+    }
+
     /* digits are already sanity-checked */
     if (len == olen)
       return len;
-    *out++ = (base64val(digit1) << 2) | (base64val(digit2) >> 4);
+    *out++ = (val1 << 2) | (val2 >> 4);
     len++;
     if (digit3 != '=')
     {
       if (len == olen)
         return len;
-      *out++ = ((base64val(digit2) << 4) & 0xf0) | (base64val(digit3) >> 2);
+      *out++ = ((val2 << 4) & 0xf0) | (val3 >> 2);
       len++;
       if (digit4 != '=')
       {
         if (len == olen)
           return len;
-        *out++ = ((base64val(digit3) << 6) & 0xc0) | base64val(digit4);
+        *out++ = ((val3 << 6) & 0xc0) | val4;
         len++;
       }
     }
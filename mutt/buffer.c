@@ -92,9 +92,10 @@ void mutt_buffer_reset(struct Buffer *buf)
  * @retval num Bytes written to Buffer
  * @retval 0   Error
  *
- * Dynamically grow a Buffer to accommodate s, in increments of 128 bytes.
- * Always one byte bigger than necessary for the null terminator, and the
- * buffer is always NUL-terminated
+ * Dynamically grow a Buffer to accommodate s.  The Buffer at least doubles
+ * each time, so that appending in a loop costs a logarithmic number of
+ * reallocations.  Always one byte bigger than necessary for the null
+ * terminator, and the buffer is always NUL-terminated
  */
 size_t mutt_buffer_addstr_n(struct Buffer *buf, const char *s, size_t len)
 {
@@ -102,7 +103,7 @@ size_t mutt_buffer_addstr_n(struct Buffer *buf, const char *s, size_t len)
     return 0;
 
   if (!buf->data || !buf->dptr || ((buf->dptr + len + 1) > (buf->data + buf->dsize)))
-    mutt_buffer_alloc(buf, buf->dsize + MAX(128, len + 1));
+    mutt_buffer_alloc(buf, MAX(2 * buf->dsize, buf->dsize + MAX(128, len + 1)));
 
   memcpy(buf->dptr, s, len);
   buf->dptr += len;
@@ -244,19 +245,6 @@ size_t mutt_buffer_addch(struct Buffer *buf, char c)
   return mutt_buffer_addstr_n(buf, &c, 1);
 }
 
-/**
- * mutt_buffer_is_empty - Is the Buffer empty?
- * @param buf Buffer to inspect
- * @retval true Buffer is empty
- */
-bool mutt_buffer_is_empty(const struct Buffer *buf)
-{
-  if (!buf || !buf->data)
-    return true;
-
-  return (buf->data[0] == '\0');
-}
-
 /**
  * mutt_buffer_alloc - Make sure a buffer can store at least new_size bytes
  * @param buf      Buffer to change
@@ -348,19 +336,6 @@ size_t mutt_buffer_substrcpy(struct Buffer *buf, const char *beg, const char *en
   return mutt_buffer_strcpy_n(buf, beg, end - beg);
 }
 
-/**
- * mutt_buffer_len - Calculate the length of a Buffer
- * @param buf Buffer
- * @retval num Size of buffer
- */
-size_t mutt_buffer_len(const struct Buffer *buf)
-{
-  if (!buf || !buf->data || !buf->dptr)
-    return 0;
-
-  return buf->dptr - buf->data;
-}
-
 /**
  * mutt_buffer_concat_path - Join a directory name and a filename
  * @param buf   Buffer to add to
@@ -457,16 +432,20 @@ size_t mutt_buffer_copy(struct Buffer *dst, const struct Buffer *src)
 }
 
 /**
- * mutt_buffer_seek - Set current read/write position to offset from beginning
- * @param buf    Buffer to use
- * @param offset Distance from the beginning
+ * mutt_buffer_move - Move a Buffer's contents to another Buffer
+ * @param dst Buffer for result
+ * @param src Buffer to move
  *
- * This is used for cases where the buffer is read from
- * A value is placed in the buffer, and then b->dptr is set back to the
- * beginning as a read marker instead of write marker.
+ * The storage is stolen, not copied, and src is left initialised but empty.
+ * Any previous contents of dst are freed.
+ * Use this instead of mutt_buffer_copy() when src is about to be freed.
  */
-void mutt_buffer_seek(struct Buffer *buf, size_t offset)
+void mutt_buffer_move(struct Buffer *dst, struct Buffer *src)
 {
-  if (buf)
-    buf->dptr = buf->data + offset;
+  if (!dst || !src || (dst == src))
+    return;
+
+  mutt_buffer_dealloc(dst);
+  *dst = *src;
+  mutt_buffer_init(src);
 }
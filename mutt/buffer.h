@@ -43,12 +43,10 @@ void           mutt_buffer_alloc        (struct Buffer *buf, size_t size);
 void           mutt_buffer_dealloc      (struct Buffer *buf);
 void           mutt_buffer_fix_dptr     (struct Buffer *buf);
 struct Buffer *mutt_buffer_init         (struct Buffer *buf);
-bool           mutt_buffer_is_empty     (const struct Buffer *buf);
-size_t         mutt_buffer_len          (const struct Buffer *buf);
 struct Buffer  mutt_buffer_make         (size_t size);
+void           mutt_buffer_move         (struct Buffer *dst, struct Buffer *src);
 void           mutt_buffer_reset        (struct Buffer *buf);
 char *         mutt_buffer_strdup       (const struct Buffer *buf);
-void           mutt_buffer_seek         (struct Buffer *buf, size_t offset);
 
 // Functions that APPEND to a Buffer
 size_t         mutt_buffer_addch        (struct Buffer *buf, char c);
@@ -82,4 +80,48 @@ static inline const char *mutt_buffer_string(const struct Buffer *buf)
   return buf->data;
 }
 
+/**
+ * mutt_buffer_len - Calculate the length of a Buffer
+ * @param buf Buffer
+ * @retval num Size of buffer
+ *
+ * This is O(1): the length is the distance of the write position from the
+ * start of the data.
+ */
+static inline size_t mutt_buffer_len(const struct Buffer *buf)
+{
+  if (!buf || !buf->data || !buf->dptr)
+    return 0;
+
+  return buf->dptr - buf->data;
+}
+
+/**
+ * mutt_buffer_is_empty - Is the Buffer empty?
+ * @param buf Buffer to inspect
+ * @retval true Buffer is empty
+ */
+static inline bool mutt_buffer_is_empty(const struct Buffer *buf)
+{
+  if (!buf || !buf->data)
+    return true;
+
+  return (buf->data[0] == '\0');
+}
+
+/**
+ * mutt_buffer_seek - Set current read/write position to offset from beginning
+ * @param buf    Buffer to use
+ * @param offset Distance from the beginning
+ *
+ * This is used for cases where the buffer is read from
+ * A value is placed in the buffer, and then b->dptr is set back to the
+ * beginning as a read marker instead of write marker.
+ */
+static inline void mutt_buffer_seek(struct Buffer *buf, size_t offset)
+{
+  if (buf)
+    buf->dptr = buf->data + offset;
+}
+
 #endif /* MUTT_LIB_BUFFER_H */
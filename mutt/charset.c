@@ -30,6 +30,9 @@
 #include <ctype.h>
 #include <errno.h>
 #include <iconv.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 #include <langinfo.h>
 #include <limits.h>
 #include <stdbool.h>
@@ -77,6 +80,8 @@ TAILQ_HEAD(LookupList, Lookup);
 
 static struct LookupList Lookups = TAILQ_HEAD_INITIALIZER(Lookups);
 
+static void iconv_cache_flush(void);
+
 /**
  * struct MimeNames - MIME name lookup entry
  */
@@ -517,6 +522,9 @@ bool mutt_ch_lookup_add(enum LookupType type, const char *pat,
 
   TAILQ_INSERT_TAIL(&Lookups, l, entries);
 
+  /* the hooks change how charsets resolve, so cached descriptors are stale */
+  iconv_cache_flush();
+
   return true;
 }
 
@@ -535,6 +543,8 @@ void mutt_ch_lookup_remove(void)
     TAILQ_REMOVE(&Lookups, l, entries);
     lookup_free(&l);
   }
+
+  iconv_cache_flush();
 }
 
 /**
@@ -610,6 +620,164 @@ iconv_t mutt_ch_iconv_open(const char *tocode, const char *fromcode, uint8_t fla
   return (iconv_t) -1;
 }
 
+/// Number of open iconv descriptors kept for reuse
+#define ICONV_CACHE_SIZE 16
+
+/**
+ * struct IconvCacheEntry - An open iconv descriptor kept for reuse
+ *
+ * rfc2047_decode() opens a descriptor per encoded word, so opening a folder
+ * of international mail used to call iconv_open()/iconv_close() hundreds of
+ * thousands of times.  Descriptors are cached here instead and checked out by
+ * mutt_ch_iconv_open_cached(); an entry that is in use is skipped, so worker
+ * threads never share a descriptor.
+ */
+struct IconvCacheEntry
+{
+  char *tocode;   ///< Target character set
+  char *fromcode; ///< Source character set
+  uint8_t flags;  ///< Flags the descriptor was opened with
+  iconv_t cd;     ///< Open conversion descriptor
+  bool in_use;    ///< Descriptor is checked out
+  size_t used;    ///< Tick of the last use, for LRU eviction
+};
+
+static struct IconvCacheEntry IconvCache[ICONV_CACHE_SIZE];
+static size_t IconvCacheTick = 0;
+#ifdef HAVE_PTHREAD_CREATE
+static pthread_mutex_t IconvCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+#define iconv_cache_lock() pthread_mutex_lock(&IconvCacheMutex)
+#define iconv_cache_unlock() pthread_mutex_unlock(&IconvCacheMutex)
+#else
+#define iconv_cache_lock()
+#define iconv_cache_unlock()
+#endif
+
+/**
+ * iconv_cache_flush - Close all the cached iconv descriptors
+ *
+ * Descriptors that are checked out are left alone; they'll be closed when
+ * they come back.
+ */
+static void iconv_cache_flush(void)
+{
+  iconv_cache_lock();
+  for (size_t i = 0; i < ICONV_CACHE_SIZE; i++)
+  {
+    struct IconvCacheEntry *entry = &IconvCache[i];
+    if (!entry->tocode || entry->in_use)
+      continue;
+    iconv_close(entry->cd);
+    FREE(&entry->tocode);
+    FREE(&entry->fromcode);
+  }
+  iconv_cache_unlock();
+}
+
+/**
+ * mutt_ch_iconv_open_cached - Get an iconv descriptor, reusing a cached one
+ * @param tocode   Current character set
+ * @param fromcode Target character set
+ * @param flags    Flags, e.g. #MUTT_ICONV_HOOK_FROM
+ * @retval ptr iconv handle for the conversion
+ *
+ * Drop-in for mutt_ch_iconv_open() - same charset canonicalisation and hook
+ * handling - but the descriptor must be returned with
+ * mutt_ch_iconv_close_cached() instead of iconv_close().
+ */
+iconv_t mutt_ch_iconv_open_cached(const char *tocode, const char *fromcode, uint8_t flags)
+{
+  iconv_cache_lock();
+  for (size_t i = 0; i < ICONV_CACHE_SIZE; i++)
+  {
+    struct IconvCacheEntry *entry = &IconvCache[i];
+    if (!entry->tocode || entry->in_use || (entry->flags != flags) ||
+        !mutt_istr_equal(entry->tocode, tocode) ||
+        !mutt_istr_equal(entry->fromcode, fromcode))
+    {
+      continue;
+    }
+    entry->in_use = true;
+    entry->used = ++IconvCacheTick;
+    iconv_cache_unlock();
+    iconv(entry->cd, NULL, NULL, NULL, NULL); // reset the shift state
+    return entry->cd;
+  }
+  iconv_cache_unlock();
+
+  iconv_t cd = mutt_ch_iconv_open(tocode, fromcode, flags);
+  if (cd == (iconv_t) -1)
+    return cd;
+
+  iconv_cache_lock();
+  struct IconvCacheEntry *slot = NULL;
+  for (size_t i = 0; i < ICONV_CACHE_SIZE; i++)
+  {
+    struct IconvCacheEntry *entry = &IconvCache[i];
+    if (entry->in_use)
+      continue;
+    if (!entry->tocode)
+    {
+      slot = entry;
+      break;
+    }
+    if (!slot || (entry->used < slot->used))
+      slot = entry;
+  }
+  if (slot)
+  {
+    if (slot->tocode)
+    {
+      iconv_close(slot->cd);
+      FREE(&slot->tocode);
+      FREE(&slot->fromcode);
+    }
+    slot->tocode = mutt_str_dup(tocode);
+    slot->fromcode = mutt_str_dup(fromcode);
+    slot->flags = flags;
+    slot->cd = cd;
+    slot->in_use = true;
+    slot->used = ++IconvCacheTick;
+  }
+  iconv_cache_unlock();
+  return cd;
+}
+
+/**
+ * mutt_ch_iconv_close_cached - Return an iconv descriptor to the cache
+ * @param cd Descriptor from mutt_ch_iconv_open_cached()
+ *
+ * A descriptor that isn't cached (e.g. because the cache was full) is simply
+ * closed.
+ */
+void mutt_ch_iconv_close_cached(iconv_t cd)
+{
+  if (cd == (iconv_t) -1)
+    return;
+
+  iconv_cache_lock();
+  for (size_t i = 0; i < ICONV_CACHE_SIZE; i++)
+  {
+    struct IconvCacheEntry *entry = &IconvCache[i];
+    if (entry->tocode && entry->in_use && (entry->cd == cd))
+    {
+      entry->in_use = false;
+      iconv_cache_unlock();
+      return;
+    }
+  }
+  iconv_cache_unlock();
+  iconv_close(cd);
+}
+
+/**
+ * mutt_ch_cache_cleanup - Close the cached iconv descriptors
+ */
+void mutt_ch_cache_cleanup(void)
+{
+  iconv_cache_flush();
+}
+
 /**
  * mutt_ch_iconv - Change the encoding of a string
  * @param[in]     cd           Iconv conversion descriptor
@@ -731,7 +899,7 @@ int mutt_ch_check(const char *s, size_t slen, const char *from, const char *to)
     return -1;
 
   int rc = 0;
-  iconv_t cd = mutt_ch_iconv_open(to, from, MUTT_ICONV_NO_FLAGS);
+  iconv_t cd = mutt_ch_iconv_open_cached(to, from, MUTT_ICONV_NO_FLAGS);
   if (cd == (iconv_t) -1)
     return -1;
 
@@ -744,7 +912,7 @@ int mutt_ch_check(const char *s, size_t slen, const char *from, const char *to)
     rc = errno;
 
   FREE(&saved_out);
-  iconv_close(cd);
+  mutt_ch_iconv_close_cached(cd);
   return rc;
 }
 
@@ -777,7 +945,7 @@ int mutt_ch_convert_string(char **ps, const char *from, const char *to, uint8_t
   const char *repls[] = { "\357\277\275", "?", 0 };
   int rc = 0;
 
-  iconv_t cd = mutt_ch_iconv_open(to, from, flags);
+  iconv_t cd = mutt_ch_iconv_open_cached(to, from, flags);
   if (cd == (iconv_t) -1)
     return -1;
 
@@ -803,7 +971,7 @@ int mutt_ch_convert_string(char **ps, const char *from, const char *to, uint8_t
   ob = buf;
 
   mutt_ch_iconv(cd, &ib, &ibl, &ob, &obl, inrepls, outrepl, &rc);
-  iconv_close(cd);
+  mutt_ch_iconv_close_cached(cd);
 
   *ob = '\0';
 
@@ -1032,6 +1200,111 @@ void mutt_ch_set_charset(const char *charset)
 #endif
 }
 
+/**
+ * enum CharsetClass - Smallest well-known repertoire that covers a string
+ */
+enum CharsetClass
+{
+  CH_CLASS_ASCII,  ///< Plain 7-bit ASCII
+  CH_CLASS_LATIN1, ///< Valid UTF-8, all code points below U+0100
+  CH_CLASS_UTF8,   ///< Valid UTF-8 with code points above U+00FF
+  CH_CLASS_OTHER,  ///< Not valid UTF-8; nothing can be assumed
+};
+
+/**
+ * ch_classify_utf8 - Find the smallest repertoire covering a UTF-8 string
+ * @param s    String to classify
+ * @param slen Length of the string
+ * @retval enum #CharsetClass of the string
+ */
+static enum CharsetClass ch_classify_utf8(const char *s, size_t slen)
+{
+  enum CharsetClass class = CH_CLASS_ASCII;
+  const unsigned char *p = (const unsigned char *) s;
+  const unsigned char *end = p + slen;
+
+  while (p < end)
+  {
+    if (*p < 0x80)
+    {
+      p++;
+      continue;
+    }
+
+    int cont;
+    unsigned int cp;
+    if ((*p & 0xe0) == 0xc0)
+    {
+      cont = 1;
+      cp = *p & 0x1f;
+    }
+    else if ((*p & 0xf0) == 0xe0)
+    {
+      cont = 2;
+      cp = *p & 0x0f;
+    }
+    else if ((*p & 0xf8) == 0xf0)
+    {
+      cont = 3;
+      cp = *p & 0x07;
+    }
+    else
+      return CH_CLASS_OTHER;
+
+    if ((end - p - 1) < cont)
+      return CH_CLASS_OTHER;
+    for (int i = 0; i < cont; i++)
+    {
+      p++;
+      if ((*p & 0xc0) != 0x80)
+        return CH_CLASS_OTHER;
+      cp = (cp << 6) | (*p & 0x3f);
+    }
+    p++;
+
+    // Reject overlong forms, surrogates and out-of-range code points
+    if ((cp < 0x80) || ((cont == 2) && (cp < 0x800)) ||
+        ((cont == 3) && (cp < 0x10000)) || (cp > 0x10ffff) ||
+        ((cp >= 0xd800) && (cp <= 0xdfff)))
+    {
+      return CH_CLASS_OTHER;
+    }
+
+    if (cp > 0xff)
+      class = CH_CLASS_UTF8;
+    else if (class == CH_CLASS_ASCII)
+      class = CH_CLASS_LATIN1;
+  }
+
+  return class;
+}
+
+/**
+ * ch_class_can_hold - Can a target charset encode a classified string?
+ * @param class Class of the string, see ch_classify_utf8()
+ * @param tocode Target charset
+ * @retval  1 Yes, every string of this class is representable
+ * @retval  0 No, the string cannot be represented
+ * @retval -1 Unknown, a full conversion is needed to tell
+ */
+static int ch_class_can_hold(enum CharsetClass class, const char *tocode)
+{
+  if (class == CH_CLASS_OTHER)
+    return -1;
+
+  char canon[128];
+  mutt_ch_canonical_charset(canon, sizeof(canon), tocode);
+
+  if (mutt_str_equal(canon, "us-ascii"))
+    return (class == CH_CLASS_ASCII) ? 1 : 0;
+  if (mutt_str_equal(canon, "iso-8859-1"))
+    return (class == CH_CLASS_UTF8) ? 0 : 1;
+  if (mutt_str_equal(canon, "utf-8"))
+    return 1;
+
+  return -1;
+}
+
 /**
  * mutt_ch_choose - Figure the best charset to encode a string
  * @param[in] fromcode Original charset of the string
@@ -1053,6 +1326,12 @@ char *mutt_ch_choose(const char *fromcode, const char *charsets, const char *u,
   size_t elen = 0, bestn = 0;
   const char *q = NULL;
 
+  /* Classify the string once, so unambiguous content needn't be
+   * test-converted through iconv for every candidate */
+  enum CharsetClass class = CH_CLASS_OTHER;
+  if (mutt_ch_is_utf8(fromcode))
+    class = ch_classify_utf8(u, ulen);
+
   for (const char *p = charsets; p; p = q ? q + 1 : 0)
   {
     q = strchr(p, ':');
@@ -1065,9 +1344,27 @@ char *mutt_ch_choose(const char *fromcode, const char *charsets, const char *u,
     memcpy(t, p, n);
     t[n] = '\0';
 
-    char *s = mutt_strn_dup(u, ulen);
-    const int rc = d ? mutt_ch_convert_string(&s, fromcode, t, MUTT_ICONV_NO_FLAGS) :
-                       mutt_ch_check(s, ulen, fromcode, t);
+    const int hold = ch_class_can_hold(class, t);
+    if (hold == 0)
+    {
+      FREE(&t);
+      continue;
+    }
+
+    char *s = NULL;
+    int rc = 0;
+    if ((hold == 1) && (!d || (class == CH_CLASS_ASCII)))
+    {
+      /* Guaranteed to fit; ASCII is even byte-identical in every candidate */
+      if (d)
+        s = mutt_strn_dup(u, ulen);
+    }
+    else
+    {
+      s = mutt_strn_dup(u, ulen);
+      rc = d ? mutt_ch_convert_string(&s, fromcode, t, MUTT_ICONV_NO_FLAGS) :
+               mutt_ch_check(s, ulen, fromcode, t);
+    }
     if (rc)
     {
       FREE(&t);
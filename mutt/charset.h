@@ -71,6 +71,7 @@ enum LookupType
 #define MUTT_ICONV_NO_FLAGS  0 ///< No flags are set
 #define MUTT_ICONV_HOOK_FROM 1 ///< apply charset-hooks to fromcode
 
+void             mutt_ch_cache_cleanup(void);
 void             mutt_ch_canonical_charset(char *buf, size_t buflen, const char *name);
 const char *     mutt_ch_charset_lookup(const char *chs);
 int              mutt_ch_check(const char *s, size_t slen, const char *from, const char *to);
@@ -87,7 +88,9 @@ char *           mutt_ch_get_default_charset(void);
 char *           mutt_ch_get_langinfo_charset(void);
 size_t           mutt_ch_iconv(iconv_t cd, const char **inbuf, size_t *inbytesleft, char **outbuf, size_t *outbytesleft, const char **inrepls, const char *outrepl, int *iconverrno);
 const char *     mutt_ch_iconv_lookup(const char *chs);
+void             mutt_ch_iconv_close_cached(iconv_t cd);
 iconv_t          mutt_ch_iconv_open(const char *tocode, const char *fromcode, uint8_t flags);
+iconv_t          mutt_ch_iconv_open_cached(const char *tocode, const char *fromcode, uint8_t flags);
 bool             mutt_ch_lookup_add(enum LookupType type, const char *pat, const char *replace, struct Buffer *err);
 void             mutt_ch_lookup_remove(void);
 void             mutt_ch_set_charset(const char *charset);
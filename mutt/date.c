@@ -27,6 +27,7 @@
  */
 
 #include "config.h"
+#include <ctype.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -181,6 +182,181 @@ static const struct Tz *find_tz(const char *s, size_t len)
   return NULL;
 }
 
+/**
+ * parse_small_int - Parse one or two decimal digits
+ * @param[in,out] s   String to parse, advanced past the digits
+ * @param[out]    num Parsed number
+ * @retval true At least one digit was parsed
+ */
+static bool parse_small_int(const char **s, int *num)
+{
+  const char *p = *s;
+  if (!isdigit((unsigned char) *p))
+    return false;
+
+  int n = *p++ - '0';
+  if (isdigit((unsigned char) *p))
+    n = (n * 10) + (*p++ - '0');
+
+  *num = n;
+  *s = p;
+  return true;
+}
+
+/**
+ * parse_month_fast - Look up a month abbreviation in a single step
+ * @param s Candidate month name, at least three bytes long
+ * @retval num Index into Months array (0-based)
+ * @retval -1  Not a month
+ *
+ * The three letters are packed into one key, so the compiler can emit a jump
+ * table instead of the linear scan done by mutt_date_check_month().
+ * The match is case-sensitive, like the RFC5322 regexes.
+ */
+static int parse_month_fast(const char *s)
+{
+#define MONTH_KEY(a, b, c) (((a) << 16) | ((b) << 8) | (c))
+  switch (MONTH_KEY(s[0], s[1], s[2]))
+  {
+    case MONTH_KEY('J', 'a', 'n'): return 0;  // clang-format off
+    case MONTH_KEY('F', 'e', 'b'): return 1;
+    case MONTH_KEY('M', 'a', 'r'): return 2;
+    case MONTH_KEY('A', 'p', 'r'): return 3;
+    case MONTH_KEY('M', 'a', 'y'): return 4;
+    case MONTH_KEY('J', 'u', 'n'): return 5;
+    case MONTH_KEY('J', 'u', 'l'): return 6;
+    case MONTH_KEY('A', 'u', 'g'): return 7;
+    case MONTH_KEY('S', 'e', 'p'): return 8;
+    case MONTH_KEY('O', 'c', 't'): return 9;
+    case MONTH_KEY('N', 'o', 'v'): return 10;
+    case MONTH_KEY('D', 'e', 'c'): return 11; // clang-format on
+  }
+#undef MONTH_KEY
+  return -1;
+}
+
+/**
+ * parse_date_fast - Parse the common fixed RFC5322 date layout
+ * @param[in]  s         String to parse
+ * @param[out] tm        Broken-down time (year is left un-normalised)
+ * @param[out] zhours    Hours away from UTC
+ * @param[out] zminutes  Minutes away from UTC
+ * @param[out] zoccident True if west of UTC
+ * @retval true The string was recognised
+ *
+ * Nearly every Date header follows
+ * `[ weekday , ] day month 4-digit-year hour:minute[:second] [ timezone ]`
+ * to the letter.  Recognise that layout with plain pointer arithmetic, which
+ * is far cheaper than a full regex match.  Anything unusual -- comments in
+ * the middle, two-digit years, trailing junk -- is left for the regex-based
+ * parser, so this function can afford to be strict.
+ */
+static bool parse_date_fast(const char *s, struct tm *tm, int *zhours,
+                            int *zminutes, bool *zoccident)
+{
+  while ((*s == ' ') || (*s == '\t'))
+    s++;
+
+  /* Optional "Mon, " weekday prefix */
+  if (isalpha((unsigned char) *s))
+  {
+    if (!isalpha((unsigned char) s[1]) || !isalpha((unsigned char) s[2]) || (s[3] != ','))
+      return false;
+    s += 4;
+    while (*s == ' ')
+      s++;
+  }
+
+  /* Day */
+  if (!parse_small_int(&s, &tm->tm_mday) || (*s != ' '))
+    return false;
+  do
+  {
+    s++;
+  } while (*s == ' ');
+
+  /* Month */
+  if (!isalpha((unsigned char) s[0]) || !isalpha((unsigned char) s[1]) ||
+      !isalpha((unsigned char) s[2]))
+  {
+    return false;
+  }
+  tm->tm_mon = parse_month_fast(s);
+  if ((tm->tm_mon < 0) || (s[3] != ' '))
+    return false;
+  s += 4;
+  while (*s == ' ')
+    s++;
+
+  /* Year - exactly four digits; the obsolete two-digit form is rare */
+  if (!isdigit((unsigned char) s[0]) || !isdigit((unsigned char) s[1]) ||
+      !isdigit((unsigned char) s[2]) || !isdigit((unsigned char) s[3]) ||
+      isdigit((unsigned char) s[4]))
+  {
+    return false;
+  }
+  tm->tm_year = ((s[0] - '0') * 1000) + ((s[1] - '0') * 100) +
+                ((s[2] - '0') * 10) + (s[3] - '0');
+  s += 4;
+  if (*s != ' ')
+    return false;
+  while (*s == ' ')
+    s++;
+
+  /* Time */
+  if (!parse_small_int(&s, &tm->tm_hour) || (*s != ':'))
+    return false;
+  s++;
+  if (!parse_small_int(&s, &tm->tm_min))
+    return false;
+  tm->tm_sec = 0;
+  if (*s == ':')
+  {
+    s++;
+    if (!parse_small_int(&s, &tm->tm_sec))
+      return false;
+  }
+  while (*s == ' ')
+    s++;
+
+  /* Time zone */
+  bool have_tz = false;
+  if ((*s == '+') || (*s == '-'))
+  {
+    if (!isdigit((unsigned char) s[1]) || !isdigit((unsigned char) s[2]) ||
+        !isdigit((unsigned char) s[3]) || !isdigit((unsigned char) s[4]))
+    {
+      return false;
+    }
+    *zoccident = (*s == '-');
+    *zhours = ((s[1] - '0') * 10) + (s[2] - '0');
+    *zminutes = ((s[3] - '0') * 10) + (s[4] - '0');
+    s += 5;
+    have_tz = true;
+  }
+  else if (isalpha((unsigned char) *s))
+  {
+    const char *end = s + 1;
+    while (isalpha((unsigned char) *end))
+      end++;
+    const struct Tz *tz = find_tz(s, end - s);
+    if (tz)
+    {
+      *zhours = tz->zhours;
+      *zminutes = tz->zminutes;
+      *zoccident = tz->zoccident;
+    }
+    s = end;
+    have_tz = true;
+  }
+  while (*s == ' ')
+    s++;
+
+  /* A trailing "(CET)"-style comment is fine, but a comment *instead of* the
+   * timezone might hide a real timezone after it - let the regex decide */
+  return (*s == '\0') || (have_tz && (*s == '('));
+}
+
 /**
  * is_leap_year_feb - Is a given February in a leap year
  * @param tm Date to be tested
@@ -458,83 +634,86 @@ time_t mutt_date_parse_date(const char *s, struct Tz *tz_out)
   if (!s)
     return -1;
 
-  bool lax = false;
+  struct tm tm = { 0 };
+  int zhours = 0;
+  int zminutes = 0;
+  bool zoccident = false;
 
-  const regmatch_t *match = mutt_prex_capture(PREX_RFC5322_DATE, s);
-  if (!match)
+  if (!parse_date_fast(s, &tm, &zhours, &zminutes, &zoccident))
   {
-    match = mutt_prex_capture(PREX_RFC5322_DATE_LAX, s);
+    bool lax = false;
+
+    const regmatch_t *match = mutt_prex_capture(PREX_RFC5322_DATE, s);
     if (!match)
     {
-      mutt_debug(LL_DEBUG1, "Could not parse date: <%s>\n", s);
-      return -1;
+      match = mutt_prex_capture(PREX_RFC5322_DATE_LAX, s);
+      if (!match)
+      {
+        mutt_debug(LL_DEBUG1, "Could not parse date: <%s>\n", s);
+        return -1;
+      }
+      lax = true;
+      mutt_debug(LL_DEBUG2, "Fallback regex for date: <%s>\n", s);
     }
-    lax = true;
-    mutt_debug(LL_DEBUG2, "Fallback regex for date: <%s>\n", s);
-  }
-
-  struct tm tm = { 0 };
 
-  // clang-format off
-  const regmatch_t *mday    = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_DAY    : PREX_RFC5322_DATE_MATCH_DAY];
-  const regmatch_t *mmonth  = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_MONTH  : PREX_RFC5322_DATE_MATCH_MONTH];
-  const regmatch_t *myear   = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_YEAR   : PREX_RFC5322_DATE_MATCH_YEAR];
-  const regmatch_t *mhour   = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_HOUR   : PREX_RFC5322_DATE_MATCH_HOUR];
-  const regmatch_t *mminute = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_MINUTE : PREX_RFC5322_DATE_MATCH_MINUTE];
-  const regmatch_t *msecond = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_SECOND : PREX_RFC5322_DATE_MATCH_SECOND];
-  const regmatch_t *mtz     = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_TZ     : PREX_RFC5322_DATE_MATCH_TZ];
-  const regmatch_t *mtzobs  = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_TZ_OBS : PREX_RFC5322_DATE_MATCH_TZ_OBS];
-  // clang-format on
+    // clang-format off
+    const regmatch_t *mday    = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_DAY    : PREX_RFC5322_DATE_MATCH_DAY];
+    const regmatch_t *mmonth  = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_MONTH  : PREX_RFC5322_DATE_MATCH_MONTH];
+    const regmatch_t *myear   = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_YEAR   : PREX_RFC5322_DATE_MATCH_YEAR];
+    const regmatch_t *mhour   = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_HOUR   : PREX_RFC5322_DATE_MATCH_HOUR];
+    const regmatch_t *mminute = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_MINUTE : PREX_RFC5322_DATE_MATCH_MINUTE];
+    const regmatch_t *msecond = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_SECOND : PREX_RFC5322_DATE_MATCH_SECOND];
+    const regmatch_t *mtz     = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_TZ     : PREX_RFC5322_DATE_MATCH_TZ];
+    const regmatch_t *mtzobs  = &match[lax ? PREX_RFC5322_DATE_LAX_MATCH_TZ_OBS : PREX_RFC5322_DATE_MATCH_TZ_OBS];
+    // clang-format on
+
+    /* Day */
+    sscanf(s + mutt_regmatch_start(mday), "%d", &tm.tm_mday);
+
+    /* Month */
+    tm.tm_mon = mutt_date_check_month(s + mutt_regmatch_start(mmonth));
+
+    /* Year */
+    sscanf(s + mutt_regmatch_start(myear), "%d", &tm.tm_year);
+
+    /* Time */
+    int sec = 0;
+    sscanf(s + mutt_regmatch_start(mhour), "%d", &tm.tm_hour);
+    sscanf(s + mutt_regmatch_start(mminute), "%d", &tm.tm_min);
+    if (mutt_regmatch_start(msecond) != -1)
+      sscanf(s + mutt_regmatch_start(msecond), "%d", &sec);
+    tm.tm_sec = sec;
+
+    /* Time zone */
+    if (mutt_regmatch_start(mtz) != -1)
+    {
+      char direction;
+      sscanf(s + mutt_regmatch_start(mtz), "%c%02d%02d", &direction, &zhours, &zminutes);
+      zoccident = (direction == '-');
+    }
+    else if (mutt_regmatch_start(mtzobs) != -1)
+    {
+      const struct Tz *tz =
+          find_tz(s + mutt_regmatch_start(mtzobs), mutt_regmatch_len(mtzobs));
+      if (tz)
+      {
+        zhours = tz->zhours;
+        zminutes = tz->zminutes;
+        zoccident = tz->zoccident;
+      }
+    }
+  }
 
-  /* Day */
-  sscanf(s + mutt_regmatch_start(mday), "%d", &tm.tm_mday);
   if (tm.tm_mday > 31)
     return -1;
+  if ((tm.tm_hour > 23) || (tm.tm_min > 59) || (tm.tm_sec > 60))
+    return -1;
 
-  /* Month */
-  tm.tm_mon = mutt_date_check_month(s + mutt_regmatch_start(mmonth));
-
-  /* Year */
-  sscanf(s + mutt_regmatch_start(myear), "%d", &tm.tm_year);
   if (tm.tm_year < 50)
     tm.tm_year += 100;
   else if (tm.tm_year >= 1900)
     tm.tm_year -= 1900;
 
-  /* Time */
-  int hour, min, sec = 0;
-  sscanf(s + mutt_regmatch_start(mhour), "%d", &hour);
-  sscanf(s + mutt_regmatch_start(mminute), "%d", &min);
-  if (mutt_regmatch_start(msecond) != -1)
-    sscanf(s + mutt_regmatch_start(msecond), "%d", &sec);
-  if ((hour > 23) || (min > 59) || (sec > 60))
-    return -1;
-  tm.tm_hour = hour;
-  tm.tm_min = min;
-  tm.tm_sec = sec;
-
-  /* Time zone */
-  int zhours = 0;
-  int zminutes = 0;
-  bool zoccident = false;
-  if (mutt_regmatch_start(mtz) != -1)
-  {
-    char direction;
-    sscanf(s + mutt_regmatch_start(mtz), "%c%02d%02d", &direction, &zhours, &zminutes);
-    zoccident = (direction == '-');
-  }
-  else if (mutt_regmatch_start(mtzobs) != -1)
-  {
-    const struct Tz *tz =
-        find_tz(s + mutt_regmatch_start(mtzobs), mutt_regmatch_len(mtzobs));
-    if (tz)
-    {
-      zhours = tz->zhours;
-      zminutes = tz->zminutes;
-      zoccident = tz->zoccident;
-    }
-  }
-
   if (tz_out)
   {
     tz_out->zhours = zhours;
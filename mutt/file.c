@@ -41,6 +41,14 @@
 #include <time.h>
 #include <unistd.h>
 #include <utime.h>
+#ifdef __linux__
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#endif
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 #include "config/lib.h"
 #include "core/lib.h"
 #include "file.h"
@@ -220,6 +228,54 @@ void mutt_file_unlink(const char *s)
   close(fd);
 }
 
+/**
+ * copy_bytes_fast - Copy file content in the kernel, bypassing userspace
+ * @param fp_in  Source file
+ * @param fp_out Destination file
+ * @param size   Maximum number of bytes to copy
+ * @retval num Number of bytes copied
+ *
+ * copy_file_range(2) needs both streams to be regular files, so this will
+ * copy nothing when either end is a pipe.  The caller copies any remaining
+ * bytes through stdio.
+ */
+static size_t copy_bytes_fast(FILE *fp_in, FILE *fp_out, size_t size)
+{
+#ifdef HAVE_COPY_FILE_RANGE
+  /* the writes below go directly to the descriptor */
+  if (fflush(fp_out) != 0)
+    return 0;
+
+  const int fd_in = fileno(fp_in);
+  const int fd_out = fileno(fp_out);
+  if ((fd_in < 0) || (fd_out < 0))
+    return 0;
+
+  /* use the stream's idea of the position; the descriptor's offset lags
+   * behind it by whatever is left in the read buffer */
+  off_t off_in = ftello(fp_in);
+  if (off_in < 0)
+    return 0;
+
+  size_t copied = 0;
+  while (copied < size)
+  {
+    const ssize_t n = copy_file_range(fd_in, &off_in, fd_out, NULL, size - copied, 0);
+    if (n <= 0)
+      break;
+    copied += n;
+  }
+
+  /* resync the stream with the bytes the kernel consumed */
+  if ((copied != 0) && (fseeko(fp_in, off_in, SEEK_SET) != 0))
+    return 0;
+
+  return copied;
+#else
+  return 0;
+#endif
+}
+
 /**
  * mutt_file_copy_bytes - Copy some content from one file to another
  * @param fp_in  Source file
@@ -233,6 +289,8 @@ int mutt_file_copy_bytes(FILE *fp_in, FILE *fp_out, size_t size)
   if (!fp_in || !fp_out)
     return -1;
 
+  size -= copy_bytes_fast(fp_in, fp_out, size);
+
   while (size > 0)
   {
     char buf[2048];
@@ -279,6 +337,75 @@ int mutt_file_copy_stream(FILE *fp_in, FILE *fp_out)
   return total;
 }
 
+/**
+ * mutt_file_copy_contents - Copy a regular file into another, in the kernel if possible
+ * @param fp_in  Source file
+ * @param fp_out Destination file
+ * @retval  n Success, number of bytes copied
+ * @retval -1 Error, see errno
+ *
+ * Where both files are regular, try to reflink the data (FICLONE, which on
+ * btrfs/XFS shares the extents at metadata speed) and otherwise move it with
+ * copy_file_range(), so the bytes never traverse userspace.  Falls back to
+ * mutt_file_copy_stream() when the kernel can't help, e.g. for pipes or
+ * filesystems without support.
+ *
+ * Both files must be positioned at the start, and fp_out must be empty, as
+ * with a freshly-opened target.
+ */
+int mutt_file_copy_contents(FILE *fp_in, FILE *fp_out)
+{
+  if (!fp_in || !fp_out)
+    return -1;
+
+#ifdef __linux__
+  if (fflush(fp_out) != 0)
+    return -1;
+
+  const int fd_in = fileno(fp_in);
+  const int fd_out = fileno(fp_out);
+  struct stat st_in = { 0 };
+  struct stat st_out = { 0 };
+
+  if ((fstat(fd_in, &st_in) == 0) && (fstat(fd_out, &st_out) == 0) &&
+      S_ISREG(st_in.st_mode) && S_ISREG(st_out.st_mode))
+  {
+#ifdef FICLONE
+    if (ioctl(fd_out, FICLONE, fd_in) == 0)
+    {
+      fseek(fp_in, 0, SEEK_END);
+      return st_in.st_size;
+    }
+#endif
+
+    off_t total = 0;
+    bool fail = false;
+    while (total < st_in.st_size)
+    {
+      const ssize_t n = copy_file_range(fd_in, NULL, fd_out, NULL,
+                                        st_in.st_size - total, 0);
+      if (n <= 0)
+      {
+        fail = true;
+        break;
+      }
+      total += n;
+    }
+    if (!fail)
+      return total;
+
+    /* Undo any partial kernel copy and stream it instead */
+    if ((lseek(fd_in, 0, SEEK_SET) != 0) || (ftruncate(fd_out, 0) != 0) ||
+        (lseek(fd_out, 0, SEEK_SET) != 0))
+    {
+      return -1;
+    }
+  }
+#endif /* __linux__ */
+
+  return mutt_file_copy_stream(fp_in, fp_out);
+}
+
 /**
  * mutt_file_symlink - Create a symlink
  * @param oldpath Existing pathname
@@ -688,59 +815,70 @@ char *mutt_file_read_line(char *line, size_t *size, FILE *fp, int *line_num, Rea
     return NULL;
 
   size_t offset = 0;
-  char *ch = NULL;
 
   if (!line)
   {
     *size = 256;
     line = mutt_mem_malloc(*size);
   }
+  else if (*size == 0)
+  {
+    /* A buffer without capacity; fgets(3) would have read nothing */
+    FREE(&line);
+    return NULL;
+  }
 
   while (true)
   {
-    if (!fgets(line + offset, *size - offset, fp))
-    {
-      FREE(&line);
-      return NULL;
-    }
-    ch = strchr(line + offset, '\n');
-    if (ch)
+    ssize_t len;
+
+    if (offset == 0)
     {
-      if (line_num)
-        (*line_num)++;
-      if (flags & MUTT_RL_EOL)
-        return line;
-      *ch = '\0';
-      if ((ch > line) && (*(ch - 1) == '\r'))
-        *--ch = '\0';
-      if (!(flags & MUTT_RL_CONT) || (ch == line) || (*(ch - 1) != '\\'))
-        return line;
-      offset = ch - line - 1;
+      /* getline(3) finds the newline and grows the buffer in a single pass,
+       * without the scan-resize-rescan cycle of an fgets(3) loop */
+      len = getline(&line, size, fp);
+      if (len < 0)
+      {
+        FREE(&line);
+        return NULL;
+      }
     }
     else
     {
-      int c;
-      c = getc(fp); /* This is kind of a hack. We want to know if the
-                        char at the current point in the input stream is EOF.
-                        feof() will only tell us if we've already hit EOF, not
-                        if the next character is EOF. So, we need to read in
-                        the next character and manually check if it is EOF. */
-      if (c == EOF)
+      /* A continuation line: read it separately and join it on */
+      char *cont = NULL;
+      size_t cont_size = 0;
+      len = getline(&cont, &cont_size, fp);
+      if (len < 0)
       {
-        /* The last line of fp isn't \n terminated */
-        if (line_num)
-          (*line_num)++;
-        return line;
+        FREE(&cont);
+        FREE(&line);
+        return NULL;
       }
-      else
+      if ((offset + len + 1) > *size)
       {
-        ungetc(c, fp); /* undo our damage */
-        /* There wasn't room for the line -- increase "line" */
-        offset = *size - 1; /* overwrite the terminating 0 */
-        *size += 256;
+        *size = offset + len + 1;
         mutt_mem_realloc(&line, *size);
       }
+      memcpy(line + offset, cont, len + 1);
+      FREE(&cont);
     }
+
+    if (line_num)
+      (*line_num)++;
+
+    char *ch = line + offset + len - 1;
+    if (*ch != '\n')
+      return line; /* The last line of fp isn't '\n' terminated */
+    if (flags & MUTT_RL_EOL)
+      return line;
+
+    *ch = '\0';
+    if ((ch > line) && (*(ch - 1) == '\r'))
+      *--ch = '\0';
+    if (!(flags & MUTT_RL_CONT) || (ch == line) || (*(ch - 1) != '\\'))
+      return line;
+    offset = ch - line - 1; /* overwrite the backslash */
   }
 }
 
@@ -972,6 +1110,102 @@ FILE *mutt_file_mkstemp_full(const char *file, int line, const char *func)
   return fp;
 }
 
+/// Maximum number of unlinked temp files kept for reuse
+#define FILE_POOL_MAX 8
+static size_t FilePoolCount = 0;
+static FILE *FilePool[FILE_POOL_MAX];
+
+#ifdef HAVE_PTHREAD_CREATE
+/// Worker threads (mutt_worker_run()) share the pool with the main thread
+static pthread_mutex_t FilePoolMutex = PTHREAD_MUTEX_INITIALIZER;
+#define file_pool_lock() pthread_mutex_lock(&FilePoolMutex)
+#define file_pool_unlock() pthread_mutex_unlock(&FilePoolMutex)
+#else
+#define file_pool_lock()
+#define file_pool_unlock()
+#endif
+
+/**
+ * mutt_file_pool_get - Get a scratch file from the file pool
+ * @retval ptr  Empty FILE handle, positioned at the start
+ * @retval NULL Error, see errno
+ *
+ * The file is already unlinked, so it vanishes when closed or released.
+ * Release it with mutt_file_pool_release() so the handle can be reused,
+ * saving the cost of creating (and shrinking) a temp file for every
+ * message that's decoded.
+ */
+FILE *mutt_file_pool_get(void)
+{
+  file_pool_lock();
+  if (FilePoolCount != 0)
+  {
+    FILE *fp = FilePool[--FilePoolCount];
+    file_pool_unlock();
+    return fp;
+  }
+  file_pool_unlock();
+
+#ifdef __linux__
+  /* An anonymous in-memory file - never touches the disk */
+  int fd = memfd_create("neomutt", MFD_CLOEXEC);
+  if (fd != -1)
+  {
+    FILE *fp = fdopen(fd, "w+");
+    if (fp)
+      return fp;
+    close(fd);
+  }
+#endif
+
+  return mutt_file_mkstemp();
+}
+
+/**
+ * mutt_file_pool_release - Return a scratch file to the file pool
+ * @param[out] ptr FILE handle to release
+ *
+ * The file is emptied and kept open for the next mutt_file_pool_get().
+ * If the pool is full, the file is simply closed.
+ */
+void mutt_file_pool_release(FILE **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  FILE *fp = *ptr;
+  *ptr = NULL;
+
+  rewind(fp);
+  if (ftruncate(fileno(fp), 0) != 0)
+  {
+    fclose(fp);
+    return;
+  }
+
+  file_pool_lock();
+  if (FilePoolCount < FILE_POOL_MAX)
+  {
+    FilePool[FilePoolCount++] = fp;
+    fp = NULL;
+  }
+  file_pool_unlock();
+
+  if (fp)
+    fclose(fp);
+}
+
+/**
+ * mutt_file_pool_free - Release all the files in the file pool
+ */
+void mutt_file_pool_free(void)
+{
+  file_pool_lock();
+  while (FilePoolCount != 0)
+    fclose(FilePool[--FilePoolCount]);
+  file_pool_unlock();
+}
+
 /**
  * mutt_file_decrease_mtime - Decrease a file's modification time by 1 second
  * @param fp Filename
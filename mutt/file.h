@@ -94,6 +94,7 @@ int         mutt_file_chmod_add_stat(const char *path, mode_t mode, struct stat
 int         mutt_file_chmod_rm(const char *path, mode_t mode);
 int         mutt_file_chmod_rm_stat(const char *path, mode_t mode, struct stat *st);
 int         mutt_file_copy_bytes(FILE *fp_in, FILE *fp_out, size_t size);
+int         mutt_file_copy_contents(FILE *fp_in, FILE *fp_out);
 int         mutt_file_copy_stream(FILE *fp_in, FILE *fp_out);
 time_t      mutt_file_decrease_mtime(const char *fp, struct stat *st);
 void        mutt_file_expand_fmt(struct Buffer *dest, const char *fmt, const char *src);
@@ -111,6 +112,9 @@ int         mutt_file_mkdir(const char *path, mode_t mode);
 FILE *      mutt_file_mkstemp_full(const char *file, int line, const char *func);
 #define     mutt_file_mkstemp() mutt_file_mkstemp_full(__FILE__, __LINE__, __func__)
 int         mutt_file_open(const char *path, uint32_t flags);
+void        mutt_file_pool_free(void);
+FILE *      mutt_file_pool_get(void);
+void        mutt_file_pool_release(FILE **ptr);
 size_t      mutt_file_quote_filename(const char *filename, char *buf, size_t buflen);
 char *      mutt_file_read_keyword(const char *file, char *buf, size_t buflen);
 char *      mutt_file_read_line(char *line, size_t *size, FILE *fp, int *line_num, ReadLineFlags flags);
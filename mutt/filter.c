@@ -27,13 +27,109 @@
  */
 
 #include "config.h"
+#include <limits.h>
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/wait.h>
 #include <unistd.h>
 #include "filter.h"
 #include "envlist.h"
+#include "memory.h"
 #include "signal2.h"
+#include "string2.h"
+
+/// Most arguments a directly-exec'd filter command may have
+#define FILTER_MAX_ARGS 63
+
+/**
+ * filter_simple_argv - Split a shell-free command line into an argv
+ * @param[in]  cmd Command line
+ * @param[out] buf Backing storage for the argv, to be freed by the caller
+ * @retval ptr  NULL-terminated argv, to be freed by the caller
+ * @retval NULL The command needs a shell
+ *
+ * A command containing quoting, redirections, expansions or any other shell
+ * metacharacter must go through `sh -c`; a plain "program arg arg" command
+ * can be exec'd directly, which saves forking a shell for every filter.
+ */
+static char **filter_simple_argv(const char *cmd, char **buf)
+{
+  if (!cmd || (*cmd == '\0'))
+    return NULL;
+
+  if (cmd[strcspn(cmd, "\"'`~$&|;<>()[]{}*?!#^\\\n\r")] != '\0')
+    return NULL;
+
+  char *copy = mutt_str_dup(cmd);
+  char **argv = mutt_mem_calloc(FILTER_MAX_ARGS + 1, sizeof(char *));
+  int argc = 0;
+
+  for (char *tok = strtok(copy, " \t"); tok; tok = strtok(NULL, " \t"))
+  {
+    if (argc == FILTER_MAX_ARGS)
+      goto bail;
+    argv[argc++] = tok;
+  }
+
+  /* no command, or a leading environment assignment */
+  if ((argc == 0) || strchr(argv[0], '='))
+    goto bail;
+
+  *buf = copy;
+  return argv;
+
+bail:
+  FREE(&copy);
+  FREE(&argv);
+  return NULL;
+}
+
+/**
+ * filter_exec_argv - Exec a filter command directly, without a shell
+ * @param argv NULL-terminated argument list
+ * @param env  Environment for the command
+ *
+ * Does not return: search $PATH from the given environment like the shell
+ * would, and _exit(127) if nothing can be exec'd.
+ */
+static void filter_exec_argv(char *const *argv, char *const *env)
+{
+  if (strchr(argv[0], '/'))
+  {
+    execve(argv[0], argv, env);
+    _exit(127);
+  }
+
+  const char *path = NULL;
+  for (int i = 0; env && env[i]; i++)
+  {
+    if (strncmp(env[i], "PATH=", 5) == 0)
+    {
+      path = env[i] + 5;
+      break;
+    }
+  }
+  if (!path)
+    path = "/usr/bin:/bin";
+
+  char buf[PATH_MAX];
+  while (*path)
+  {
+    const char *end = strchr(path, ':');
+    const size_t len = end ? (size_t) (end - path) : strlen(path);
+    if ((len != 0) && ((len + 1 + strlen(argv[0]) + 1) <= sizeof(buf)))
+    {
+      memcpy(buf, path, len);
+      buf[len] = '/';
+      strcpy(buf + len + 1, argv[0]);
+      execve(buf, argv, env);
+    }
+    path += len + (end ? 1 : 0);
+  }
+
+  _exit(127);
+}
 
 /**
  * filter_create_fd - Run a command on a pipe (optionally connect stdin/stdout)
@@ -103,6 +199,10 @@ pid_t filter_create_fd(const char *cmd, FILE **fp_in, FILE **fp_out,
     }
   }
 
+  /* simple commands skip the intermediate shell */
+  char *argbuf = NULL;
+  char **argv = filter_simple_argv(cmd, &argbuf);
+
   mutt_sig_block_system();
 
   pid = fork();
@@ -146,12 +246,16 @@ pid_t filter_create_fd(const char *cmd, FILE **fp_in, FILE **fp_out,
       close(fderr);
     }
 
+    if (argv)
+      filter_exec_argv(argv, mutt_envlist_getlist()); /* does not return */
     execle(EXEC_SHELL, "sh", "-c", cmd, NULL, mutt_envlist_getlist());
     _exit(127);
   }
   else if (pid == -1)
   {
     mutt_sig_unblock_system(true);
+    FREE(&argv);
+    FREE(&argbuf);
 
     if (fp_in)
     {
@@ -174,6 +278,9 @@ pid_t filter_create_fd(const char *cmd, FILE **fp_in, FILE **fp_out,
     return -1;
   }
 
+  FREE(&argv);
+  FREE(&argbuf);
+
   if (fp_out)
   {
     close(pout[1]);
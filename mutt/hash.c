@@ -30,29 +30,63 @@
 #include "config.h"
 #include <ctype.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
 #include "hash.h"
 #include "memory.h"
 #include "string2.h"
 
-#define SOME_PRIME 149711
+/// Multiplier for mix_lane() - 2^64 divided by the golden ratio
+#define HASH_MULT UINT64_C(0x9e3779b97f4a7c15)
+
+/**
+ * mix_lane - Fold eight bytes of key into a hash
+ * @param hash Hash accumulated so far
+ * @param lane Next eight bytes of the key
+ * @retval num Updated hash
+ *
+ * A multiply-xorshift step in the style of xxHash: the multiply spreads the
+ * lane across the high bits and the shift feeds them back down.  Byte order
+ * of the lane doesn't matter, as the hashes only have to be consistent
+ * within one table.
+ */
+static inline uint64_t mix_lane(uint64_t hash, uint64_t lane)
+{
+  hash = (hash ^ lane) * HASH_MULT;
+  return hash ^ (hash >> 32);
+}
 
 /**
  * gen_string_hash - Generate a hash from a string - Implements hash_gen_hash_t - @ingroup hash_gen_hash_api
  *
+ * The key is read eight bytes at a time: folder opens hash every Message-ID
+ * and subject in the mailbox, where a byte-at-a-time hash is measurable.
+ *
  * @note If the key is NULL or empty, the retval will be 0
  */
 static size_t gen_string_hash(union HashKey key, size_t num_elems)
 {
-  size_t hash = 0;
-  const unsigned char *s = (const unsigned char *) key.strkey;
+  const char *s = key.strkey;
   if (!s)
     return 0;
 
-  while (*s != '\0')
-    hash += ((hash << 7) + *s++);
-  hash = (hash * SOME_PRIME) % num_elems;
+  size_t len = strlen(s);
+  uint64_t hash = len * HASH_MULT;
 
-  return hash;
+  while (len >= 8)
+  {
+    uint64_t lane;
+    memcpy(&lane, s, 8);
+    hash = mix_lane(hash, lane);
+    s += 8;
+    len -= 8;
+  }
+
+  uint64_t lane = 0;
+  memcpy(&lane, s, len);
+  hash = mix_lane(hash, lane);
+
+  return hash % num_elems;
 }
 
 /**
@@ -70,16 +104,28 @@ static int cmp_string_key(union HashKey a, union HashKey b)
  */
 static size_t gen_case_string_hash(union HashKey key, size_t num_elems)
 {
-  size_t hash = 0;
   const unsigned char *s = (const unsigned char *) key.strkey;
   if (!s)
     return 0;
 
-  while (*s != '\0')
-    hash += ((hash << 7) + tolower(*s++));
-  hash = (hash * SOME_PRIME) % num_elems;
+  size_t len = strlen(key.strkey);
+  uint64_t hash = len * HASH_MULT;
+
+  while (len > 0)
+  {
+    unsigned char folded[8] = { 0 };
+    const size_t n = MIN(len, sizeof(folded));
+    for (size_t i = 0; i < n; i++)
+      folded[i] = tolower(s[i]);
+
+    uint64_t lane;
+    memcpy(&lane, folded, sizeof(lane));
+    hash = mix_lane(hash, lane);
+    s += n;
+    len -= n;
+  }
 
-  return hash;
+  return hash % num_elems;
 }
 
 /**
@@ -113,21 +159,190 @@ static int cmp_int_key(union HashKey a, union HashKey b)
 /**
  * hash_new - Create a new Hash Table
  * @param num_elems Number of elements it should contain
+ * @param open_addr If true, use open addressing instead of chained buckets
  * @retval ptr New Hash Table
  *
- * The Hash Table can contain more elements than num_elems, but they will be
- * chained together.
+ * A chained Hash Table can contain more elements than num_elems, but they will
+ * be chained together.  An open-addressing table grows instead.
  */
-static struct HashTable *hash_new(size_t num_elems)
+static struct HashTable *hash_new(size_t num_elems, bool open_addr)
 {
   struct HashTable *table = mutt_mem_calloc(1, sizeof(struct HashTable));
   if (num_elems == 0)
     num_elems = 2;
   table->num_elems = num_elems;
-  table->table = mutt_mem_calloc(num_elems, sizeof(struct HashElem *));
+  if (open_addr)
+  {
+    table->open_addr = true;
+    table->buckets = mutt_mem_calloc(num_elems, sizeof(struct HashBucket));
+  }
+  else
+  {
+    table->table = mutt_mem_calloc(num_elems, sizeof(struct HashElem *));
+  }
   return table;
 }
 
+/// Marks a deleted bucket in an open-addressing table; probes continue past it
+static struct HashElem OpenTombstone;
+
+/**
+ * open_raw_hash - Generate the full hash of a key
+ * @param table Hash Table the key belongs to
+ * @param key   Key to hash
+ * @retval num Hash of the key, not reduced modulo the table size
+ *
+ * Open-addressing tables store the full hash next to each element, so that
+ * resizing doesn't need the keys and probes can skip mismatched buckets
+ * without comparing them.
+ */
+static size_t open_raw_hash(const struct HashTable *table, union HashKey key)
+{
+  return table->gen_hash(key, SIZE_MAX);
+}
+
+/**
+ * open_hash_grow - Double the size of an open-addressing Hash Table
+ * @param table Hash Table to grow
+ *
+ * The elements are re-slotted using their stored hashes; deleted buckets are
+ * dropped.
+ */
+static void open_hash_grow(struct HashTable *table)
+{
+  const size_t old_size = table->num_elems;
+  struct HashBucket *old = table->buckets;
+
+  table->num_elems = old_size * 2;
+  table->buckets = mutt_mem_calloc(table->num_elems, sizeof(struct HashBucket));
+  table->num_used = 0;
+
+  for (size_t i = 0; i < old_size; i++)
+  {
+    if (!old[i].he || (old[i].he == &OpenTombstone))
+      continue;
+
+    size_t j = old[i].hash % table->num_elems;
+    while (table->buckets[j].he)
+      j = (j + 1) % table->num_elems;
+    table->buckets[j] = old[i];
+    table->num_used++;
+  }
+  FREE(&old);
+}
+
+/**
+ * open_hash_insert - Insert into an open-addressing Hash Table
+ * @param table Hash Table to update
+ * @param key   Key to hash on
+ * @param type  Data type
+ * @param data  Data to associate with key
+ * @retval ptr Newly inserted HashElem
+ *
+ * The table is kept at most three-quarters full, so a probe always ends at an
+ * empty bucket.
+ */
+static struct HashElem *open_hash_insert(struct HashTable *table,
+                                         union HashKey key, int type, void *data)
+{
+  if (((table->num_used + 1) * 4) > (table->num_elems * 3))
+    open_hash_grow(table);
+
+  const size_t hash = open_raw_hash(table, key);
+  size_t i = hash % table->num_elems;
+  size_t slot = SIZE_MAX;
+
+  while (true)
+  {
+    struct HashBucket *b = &table->buckets[i];
+    if (!b->he)
+      break;
+    if (b->he == &OpenTombstone)
+    {
+      if (slot == SIZE_MAX)
+        slot = i;
+    }
+    else if (!table->allow_dups && (b->hash == hash) &&
+             (table->cmp_key(b->he->key, key) == 0))
+    {
+      return NULL;
+    }
+    i = (i + 1) % table->num_elems;
+  }
+  if (slot == SIZE_MAX)
+    slot = i;
+
+  struct HashElem *he = mutt_mem_calloc(1, sizeof(struct HashElem));
+  he->key = key;
+  he->data = data;
+  he->type = type;
+
+  if (table->buckets[slot].he != &OpenTombstone)
+    table->num_used++;
+  table->buckets[slot].hash = hash;
+  table->buckets[slot].he = he;
+  return he;
+}
+
+/**
+ * open_hash_find_elem - Find a HashElem in an open-addressing Hash Table
+ * @param table Hash Table to search
+ * @param key   Key (either string or integer)
+ * @retval ptr HashElem matching the key
+ */
+static struct HashElem *open_hash_find_elem(const struct HashTable *table, union HashKey key)
+{
+  const size_t hash = open_raw_hash(table, key);
+  size_t i = hash % table->num_elems;
+
+  while (true)
+  {
+    const struct HashBucket *b = &table->buckets[i];
+    if (!b->he)
+      return NULL;
+    if ((b->he != &OpenTombstone) && (b->hash == hash) &&
+        (table->cmp_key(key, b->he->key) == 0))
+    {
+      return b->he;
+    }
+    i = (i + 1) % table->num_elems;
+  }
+}
+
+/**
+ * open_hash_delete - Remove an element from an open-addressing Hash Table
+ * @param table Hash Table to use
+ * @param key   Key (either string or integer)
+ * @param data  Private data to match (or NULL for any match)
+ *
+ * The bucket is turned into a tombstone, so probes for other keys that
+ * stepped over it still find their element.
+ */
+static void open_hash_delete(struct HashTable *table, union HashKey key, const void *data)
+{
+  const size_t hash = open_raw_hash(table, key);
+  size_t i = hash % table->num_elems;
+
+  while (true)
+  {
+    struct HashBucket *b = &table->buckets[i];
+    if (!b->he)
+      return;
+    if ((b->he != &OpenTombstone) && (b->hash == hash) &&
+        ((data == b->he->data) || !data) && (table->cmp_key(b->he->key, key) == 0))
+    {
+      struct HashElem *he = b->he;
+      b->he = &OpenTombstone;
+      if (table->hdata_free)
+        table->hdata_free(he->type, he->data, table->hdata);
+      if (table->strdup_keys)
+        FREE(&he->key.strkey);
+      FREE(&he);
+    }
+    i = (i + 1) % table->num_elems;
+  }
+}
+
 /**
  * union_hash_insert - Insert into a hash table using a union as a key
  * @param table Hash Table to update
@@ -142,6 +357,9 @@ static struct HashElem *union_hash_insert(struct HashTable *table,
   if (!table)
     return NULL; // LCOV_EXCL_LINE
 
+  if (table->open_addr)
+    return open_hash_insert(table, key, type, data);
+
   struct HashElem *he = mutt_mem_calloc(1, sizeof(struct HashElem));
   size_t hash = table->gen_hash(key, table->num_elems);
   he->key = key;
@@ -188,6 +406,9 @@ static struct HashElem *union_hash_find_elem(const struct HashTable *table, unio
   if (!table)
     return NULL; // LCOV_EXCL_LINE
 
+  if (table->open_addr)
+    return open_hash_find_elem(table, key);
+
   size_t hash = table->gen_hash(key, table->num_elems);
   struct HashElem *he = table->table[hash];
   for (; he; he = he->next)
@@ -225,6 +446,12 @@ static void union_hash_delete(struct HashTable *table, union HashKey key, const
   if (!table)
     return; // LCOV_EXCL_LINE
 
+  if (table->open_addr)
+  {
+    open_hash_delete(table, key, data);
+    return;
+  }
+
   size_t hash = table->gen_hash(key, table->num_elems);
   struct HashElem *he = table->table[hash];
   struct HashElem **last = &table->table[hash];
@@ -258,7 +485,7 @@ static void union_hash_delete(struct HashTable *table, union HashKey key, const
  */
 struct HashTable *mutt_hash_new(size_t num_elems, HashFlags flags)
 {
-  struct HashTable *table = hash_new(num_elems);
+  struct HashTable *table = hash_new(num_elems, flags & MUTT_HASH_OPEN_ADDR);
   if (flags & MUTT_HASH_STRCASECMP)
   {
     table->gen_hash = gen_case_string_hash;
@@ -284,7 +511,7 @@ struct HashTable *mutt_hash_new(size_t num_elems, HashFlags flags)
  */
 struct HashTable *mutt_hash_int_new(size_t num_elems, HashFlags flags)
 {
-  struct HashTable *table = hash_new(num_elems);
+  struct HashTable *table = hash_new(num_elems, flags & MUTT_HASH_OPEN_ADDR);
   table->gen_hash = gen_int_hash;
   table->cmp_key = cmp_int_key;
   if (flags & MUTT_HASH_ALLOW_DUPS)
@@ -405,6 +632,9 @@ void *mutt_hash_int_find(const struct HashTable *table, unsigned int intkey)
  * @retval ptr HashElem matching the key
  *
  * Unlike mutt_hash_find_elem(), this will return the first matching entry.
+ *
+ * @note An open-addressing table has no chains; the result's `next` pointer is
+ *       always NULL.
  */
 struct HashElem *mutt_hash_find_bucket(const struct HashTable *table, const char *strkey)
 {
@@ -414,6 +644,8 @@ struct HashElem *mutt_hash_find_bucket(const struct HashTable *table, const char
   union HashKey key;
 
   key.strkey = strkey;
+  if (table->open_addr)
+    return open_hash_find_elem(table, key);
   size_t hash = table->gen_hash(key, table->num_elems);
   return table->table[hash];
 }
@@ -462,6 +694,24 @@ void mutt_hash_free(struct HashTable **ptr)
   struct HashTable *table = *ptr;
   struct HashElem *elem = NULL, *tmp = NULL;
 
+  if (table->open_addr)
+  {
+    for (size_t i = 0; i < table->num_elems; i++)
+    {
+      elem = table->buckets[i].he;
+      if (!elem || (elem == &OpenTombstone))
+        continue;
+      if (table->hdata_free && elem->data)
+        table->hdata_free(elem->type, elem->data, table->hdata);
+      if (table->strdup_keys)
+        FREE(&elem->key.strkey);
+      FREE(&elem);
+    }
+    FREE(&table->buckets);
+    FREE(ptr);
+    return;
+  }
+
   for (size_t i = 0; i < table->num_elems; i++)
   {
     for (elem = table->table[i]; elem;)
@@ -491,6 +741,27 @@ struct HashElem *mutt_hash_walk(const struct HashTable *table, struct HashWalkSt
   if (!table || !state)
     return NULL;
 
+  if (table->open_addr)
+  {
+    if (state->last)
+      state->index++;
+
+    while (state->index < table->num_elems)
+    {
+      struct HashElem *he = table->buckets[state->index].he;
+      if (he && (he != &OpenTombstone))
+      {
+        state->last = he;
+        return he;
+      }
+      state->index++;
+    }
+
+    state->index = 0;
+    state->last = NULL;
+    return NULL;
+  }
+
   if (state->last && state->last->next)
   {
     state->last = state->last->next;
@@ -90,6 +90,18 @@ typedef size_t (*hash_gen_hash_t)(union HashKey key, size_t num_elems);
  */
 typedef int (*hash_cmp_key_t)(union HashKey a, union HashKey b);
 
+/**
+ * struct HashBucket - Bucket in an open-addressing Hash Table
+ *
+ * The full hash is kept alongside the element, so a probe can reject a
+ * mismatched bucket without touching the key.
+ */
+struct HashBucket
+{
+  size_t hash;         ///< Full hash of the occupant's key
+  struct HashElem *he; ///< Occupant of the bucket, NULL if empty
+};
+
 /**
  * struct HashTable - A Hash Table
  */
@@ -98,7 +110,10 @@ struct HashTable
   size_t num_elems;             ///< Number of elements in the Hash Table
   bool strdup_keys : 1;         ///< if set, the key->strkey is strdup()'d
   bool allow_dups  : 1;         ///< if set, duplicate keys are allowed
+  bool open_addr   : 1;         ///< if set, probe #buckets linearly instead of chaining in #table
   struct HashElem **table;      ///< Array of Hash keys
+  struct HashBucket *buckets;   ///< Flat bucket array (#MUTT_HASH_OPEN_ADDR only)
+  size_t num_used;              ///< Non-empty buckets, including deleted ones (#MUTT_HASH_OPEN_ADDR only)
   hash_gen_hash_t gen_hash;     ///< Function to generate hash id from the key
   hash_cmp_key_t cmp_key;       ///< Function to compare two Hash keys
   intptr_t hdata;               ///< Data to pass to the hdata_free() function
@@ -110,6 +125,7 @@ typedef uint8_t HashFlags;             ///< Flags for mutt_hash_new(), e.g. #MUT
 #define MUTT_HASH_STRCASECMP  (1 << 0) ///< use strcasecmp() to compare keys
 #define MUTT_HASH_STRDUP_KEYS (1 << 1) ///< make a copy of the keys
 #define MUTT_HASH_ALLOW_DUPS  (1 << 2) ///< allow duplicate keys to be inserted
+#define MUTT_HASH_OPEN_ADDR   (1 << 3) ///< store the elements in a flat, linearly-probed array
 
 void              mutt_hash_delete        (struct HashTable *table, const char *strkey, const void *data);
 struct HashElem * mutt_hash_find_bucket   (const struct HashTable *table, const char *strkey);
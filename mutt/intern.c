@@ -0,0 +1,144 @@
+/**
+ * @file
+ * Refcounted interning of duplicated strings
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_intern Refcounted interning of duplicated strings
+ *
+ * Some header fields, e.g. the RFC2369 list headers, repeat the same value
+ * across every message of a large folder.  Interning stores one shared,
+ * refcounted copy instead of thousands of identical strdup()s.
+ *
+ * Interned strings must be treated as immutable and released with
+ * mutt_intern_release(), never plain free().  The release function also
+ * accepts ordinary heap strings, so a field may hold a mix of both.
+ */
+
+#include "config.h"
+#include <stddef.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
+#include "intern.h"
+#include "hash.h"
+#include "memory.h"
+#include "string2.h"
+
+#ifdef HAVE_PTHREAD_CREATE
+/// The parse worker threads intern header fields concurrently
+static pthread_mutex_t InternMutex = PTHREAD_MUTEX_INITIALIZER;
+#define intern_lock() pthread_mutex_lock(&InternMutex)
+#define intern_unlock() pthread_mutex_unlock(&InternMutex)
+#else
+#define intern_lock()
+#define intern_unlock()
+#endif
+
+/**
+ * struct InternedString - A shared string and its reference count
+ */
+struct InternedString
+{
+  char *str;   ///< The single shared copy of the string
+  size_t refs; ///< Number of owners of #str
+};
+
+/// Table of all interned strings, keyed by their contents
+static struct HashTable *InternTable = NULL;
+
+/**
+ * mutt_intern - Get a shared, refcounted copy of a string
+ * @param s String to intern
+ * @retval ptr  Shared copy of @a s
+ * @retval NULL @a s was NULL
+ *
+ * The result must not be modified and must be released with
+ * mutt_intern_release().
+ */
+char *mutt_intern(const char *s)
+{
+  if (!s)
+    return NULL;
+
+  intern_lock();
+  if (!InternTable)
+    InternTable = mutt_hash_new(256, MUTT_HASH_OPEN_ADDR);
+
+  struct InternedString *is = mutt_hash_find(InternTable, s);
+  if (is)
+  {
+    is->refs++;
+    intern_unlock();
+    return is->str;
+  }
+
+  is = mutt_mem_malloc(sizeof(*is));
+  is->str = mutt_str_dup(s);
+  is->refs = 1;
+  // The key memory is the interned string itself
+  mutt_hash_insert(InternTable, is->str, is);
+  intern_unlock();
+
+  return is->str;
+}
+
+/**
+ * mutt_intern_release - Release a string obtained from mutt_intern()
+ * @param[out] ptr String to release
+ *
+ * For safety, a string that was never interned is simply freed, so callers
+ * can release a field without knowing how it was allocated.
+ */
+void mutt_intern_release(char **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  intern_lock();
+  struct InternedString *is = InternTable ? mutt_hash_find(InternTable, *ptr) : NULL;
+  if (is && (is->str == *ptr))
+  {
+    *ptr = NULL;
+    if (--is->refs == 0)
+    {
+      mutt_hash_delete(InternTable, is->str, is);
+      FREE(&is->str);
+      FREE(&is);
+    }
+    intern_unlock();
+    return;
+  }
+  intern_unlock();
+
+  FREE(ptr);
+}
+
+/**
+ * mutt_intern_cleanup - Free the interning table
+ *
+ * All the interned strings must have been released already.
+ */
+void mutt_intern_cleanup(void)
+{
+  intern_lock();
+  mutt_hash_free(&InternTable);
+  intern_unlock();
+}
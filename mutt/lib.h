@@ -40,6 +40,7 @@
  * | mutt/file.c      | @subpage mutt_file      |
  * | mutt/filter.c    | @subpage mutt_filter    |
  * | mutt/hash.c      | @subpage mutt_hash      |
+ * | mutt/intern.c    | @subpage mutt_intern    |
  * | mutt/list.c      | @subpage mutt_list      |
  * | mutt/logging.c   | @subpage mutt_logging   |
  * | mutt/mapping.c   | @subpage mutt_mapping   |
@@ -79,6 +80,7 @@
 #include "file.h"
 #include "filter.h"
 #include "hash.h"
+#include "intern.h"
 #include "list.h"
 #include "logging.h"
 #include "mapping.h"
@@ -97,9 +99,11 @@
 #include "random.h"
 #include "regex3.h"
 #include "signal2.h"
+#include "slab.h"
 #include "slist.h"
 #include "state.h"
 #include "string2.h"
+#include "worker.h"
 // IWYU pragma: end_exports
 
 #endif /* MUTT_MUTT_LIB_H */
@@ -168,12 +168,17 @@ int mutt_mb_width(const char *str, int col, bool display)
   return w;
 }
 
+/// Screen width of each BMP codepoint, cached as computed; 0 = not yet known
+static char *WidthCacheBmp = NULL;
+/// Screen width of the supplementary-plane codepoints, as #WidthCacheBmp
+static char *WidthCacheSup = NULL;
+
 /**
- * mutt_mb_wcwidth - Measure the screen width of a character
+ * mb_wcwidth - Measure the screen width of a character
  * @param wc Character to examine
  * @retval num Width in screen columns
  */
-int mutt_mb_wcwidth(wchar_t wc)
+static int mb_wcwidth(wchar_t wc)
 {
   int n = wcwidth(wc);
   if (IsWPrint(wc) && (n > 0))
@@ -185,6 +190,50 @@ int mutt_mb_wcwidth(wchar_t wc)
   return 10;
 }
 
+/**
+ * mutt_mb_wcwidth - Measure the screen width of a character
+ * @param wc Character to examine
+ * @retval num Width in screen columns
+ *
+ * The widths are cached per codepoint: the wcwidth() and iswprint() calls add
+ * up when every row is measured and truncated on every redraw.  The answer
+ * only depends on the locale, which is fixed at startup.
+ */
+int mutt_mb_wcwidth(wchar_t wc)
+{
+  char *slot = NULL;
+
+  if ((wc >= 0) && (wc < 0x10000))
+  {
+    if (!WidthCacheBmp)
+      WidthCacheBmp = mutt_mem_calloc(0x10000, sizeof(char));
+    slot = &WidthCacheBmp[wc];
+  }
+  else if ((wc >= 0x10000) && (wc < 0x110000))
+  {
+    if (!WidthCacheSup)
+      WidthCacheSup = mutt_mem_calloc(0x100000, sizeof(char));
+    slot = &WidthCacheSup[wc - 0x10000];
+  }
+  else
+  {
+    return mb_wcwidth(wc); // not a codepoint, e.g. WEOF
+  }
+
+  if (*slot == 0)
+    *slot = mb_wcwidth(wc); // the width is always 1-10
+  return *slot;
+}
+
+/**
+ * mutt_mb_width_cache_cleanup - Free the cached character widths
+ */
+void mutt_mb_width_cache_cleanup(void)
+{
+  FREE(&WidthCacheBmp);
+  FREE(&WidthCacheSup);
+}
+
 /**
  * mutt_mb_wcswidth - Measure the screen width of a string
  * @param s String to measure
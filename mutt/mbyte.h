@@ -49,6 +49,7 @@ size_t mutt_mb_mbstowcs(wchar_t **pwbuf, size_t *pwbuflen, size_t i, const char
 void   mutt_mb_wcstombs(char *dest, size_t dlen, const wchar_t *src, size_t slen);
 int    mutt_mb_wcswidth(const wchar_t *s, size_t n);
 int    mutt_mb_wcwidth(wchar_t wc);
+void   mutt_mb_width_cache_cleanup(void);
 int    mutt_mb_width(const char *str, int col, bool display);
 size_t mutt_mb_width_ceiling(const wchar_t *s, size_t n, int w1);
 
@@ -44,13 +44,21 @@ static char *NotifyTypeNames[] = {
   "NT_WINDOW",
 };
 
+/// Number of Notification types, and of observer buckets
+#define NT_TYPE_MAX mutt_array_size(NotifyTypeNames)
+
 /**
  * struct Notify - Notification API
+ *
+ * Observers are kept in one bucket (list) per #NotifyType, so sending an
+ * event only visits the observers that could match it: the event's own
+ * bucket and the #NT_ALL bucket.  Most Notify objects (e.g. every Email has
+ * one) never have any observers, so the buckets are allocated on first use.
  */
 struct Notify
 {
-  struct Notify *parent;         ///< Parent of the notification object
-  struct ObserverList observers; ///< List of observers of this object
+  struct Notify *parent;        ///< Parent of the notification object
+  struct ObserverList *buckets; ///< One list of observers per #NotifyType
 };
 
 /**
@@ -61,11 +69,26 @@ struct Notify *notify_new(void)
 {
   struct Notify *notify = mutt_mem_calloc(1, sizeof(*notify));
 
-  STAILQ_INIT(&notify->observers);
-
   return notify;
 }
 
+/**
+ * notify_buckets - Get (or create) the observer buckets of a handler
+ * @param notify Notification handler
+ * @retval ptr Array of #NT_TYPE_MAX ObserverLists
+ */
+static struct ObserverList *notify_buckets(struct Notify *notify)
+{
+  if (!notify->buckets)
+  {
+    notify->buckets = mutt_mem_calloc(NT_TYPE_MAX, sizeof(struct ObserverList));
+    for (size_t i = 0; i < NT_TYPE_MAX; i++)
+      STAILQ_INIT(&notify->buckets[i]);
+  }
+
+  return notify->buckets;
+}
+
 /**
  * notify_free - Free a notification handler
  * @param ptr Notification handler to free
@@ -79,6 +102,7 @@ void notify_free(struct Notify **ptr)
   // NOTIFY observers
 
   notify_observer_remove_all(notify);
+  FREE(&notify->buckets);
 
   FREE(ptr);
 }
@@ -98,6 +122,34 @@ void notify_set_parent(struct Notify *notify, struct Notify *parent)
   notify->parent = parent;
 }
 
+/**
+ * send_bucket - Send an event to one bucket of observers
+ * @param current       Current handler, e.g. #NeoMutt
+ * @param list          Bucket of observers to notify
+ * @param event_type    Type of event, e.g. #NT_ACCOUNT
+ * @param event_subtype Subtype, e.g. #NT_ACCOUNT_ADD
+ * @param event_data    Private data associated with the event type
+ */
+static void send_bucket(struct Notify *current, struct ObserverList *list,
+                        enum NotifyType event_type, int event_subtype, void *event_data)
+{
+  struct ObserverNode *np = NULL;
+  STAILQ_FOREACH(np, list, entries)
+  {
+    struct Observer *o = np->observer;
+    if (!o)
+      continue;
+
+    struct NotifyCallback nc = { current, event_type, event_subtype,
+                                 event_data, o->global_data };
+    if (o->callback(&nc) < 0)
+    {
+      mutt_debug(LL_DEBUG1, "failed to send notification: %s/%d, global %p, event %p\n",
+                 NotifyTypeNames[event_type], event_subtype, o->global_data, event_data);
+    }
+  }
+}
+
 /**
  * send - Send out a notification message
  * @param source        Source of the event, e.g. #Account
@@ -112,6 +164,9 @@ void notify_set_parent(struct Notify *notify, struct Notify *parent)
  * the Mailbox that owns it, the Account (owning the Mailbox) and finally the
  * NeoMutt object.
  *
+ * Only the event's own bucket and the #NT_ALL bucket are visited; observers
+ * of other event types are never touched.
+ *
  * @note If Observers call `notify_observer_remove()`, then we garbage-collect
  *       any dead list entries after we've finished.
  */
@@ -122,37 +177,29 @@ static bool send(struct Notify *source, struct Notify *current,
     return false;
 
   mutt_debug(LL_NOTIFY, "send: %d, %ld\n", event_type, event_data);
-  struct ObserverNode *np = NULL;
-  STAILQ_FOREACH(np, &current->observers, entries)
+  if (current->buckets)
   {
-    struct Observer *o = np->observer;
-    if (!o)
-      continue;
-
-    if ((o->type == NT_ALL) || (event_type == o->type))
-    {
-      struct NotifyCallback nc = { current, event_type, event_subtype,
-                                   event_data, o->global_data };
-      if (o->callback(&nc) < 0)
-      {
-        mutt_debug(LL_DEBUG1, "failed to send notification: %s/%d, global %p, event %p\n",
-                   NotifyTypeNames[event_type], event_subtype, o->global_data, event_data);
-      }
-    }
+    if (event_type != NT_ALL)
+      send_bucket(current, &current->buckets[event_type], event_type, event_subtype, event_data);
+    send_bucket(current, &current->buckets[NT_ALL], event_type, event_subtype, event_data);
   }
 
   if (current->parent)
     return send(source, current->parent, event_type, event_subtype, event_data);
 
   // Garbage collection time
-  struct ObserverNode *tmp = NULL;
-  STAILQ_FOREACH_SAFE(np, &current->observers, entries, tmp)
+  for (size_t i = 0; current->buckets && (i < NT_TYPE_MAX); i++)
   {
-    if (np->observer)
-      continue;
+    struct ObserverNode *np = NULL;
+    struct ObserverNode *tmp = NULL;
+    STAILQ_FOREACH_SAFE(np, &current->buckets[i], entries, tmp)
+    {
+      if (np->observer)
+        continue;
 
-    STAILQ_REMOVE(&current->observers, np, ObserverNode, entries);
-    FREE(&np);
+      STAILQ_REMOVE(&current->buckets[i], np, ObserverNode, entries);
+      FREE(&np);
+    }
   }
 
   return true;
@@ -183,7 +230,7 @@ bool notify_send(struct Notify *notify, enum NotifyType event_type,
  * @param global_data Private data associated with the observer
  * @retval true Successful
  *
- * New observers are added to the front of the list, giving them higher
+ * New observers are added to the front of their bucket, giving them higher
  * priority than existing observers.
  */
 bool notify_observer_add(struct Notify *notify, enum NotifyType type,
@@ -192,14 +239,19 @@ bool notify_observer_add(struct Notify *notify, enum NotifyType type,
   if (!notify || !callback)
     return false;
 
+  struct ObserverList *buckets = notify_buckets(notify);
+
   struct ObserverNode *np = NULL;
-  STAILQ_FOREACH(np, &notify->observers, entries)
+  for (size_t i = 0; i < NT_TYPE_MAX; i++)
   {
-    if (!np->observer)
-      continue;
+    STAILQ_FOREACH(np, &buckets[i], entries)
+    {
+      if (!np->observer)
+        continue;
 
-    if ((np->observer->callback == callback) && (np->observer->global_data == global_data))
-      return true;
+      if ((np->observer->callback == callback) && (np->observer->global_data == global_data))
+        return true;
+    }
   }
 
   struct Observer *o = mutt_mem_calloc(1, sizeof(*o));
@@ -209,7 +261,7 @@ bool notify_observer_add(struct Notify *notify, enum NotifyType type,
 
   np = mutt_mem_calloc(1, sizeof(*np));
   np->observer = o;
-  STAILQ_INSERT_HEAD(&notify->observers, np, entries);
+  STAILQ_INSERT_HEAD(&buckets[type], np, entries);
 
   return true;
 }
@@ -227,19 +279,22 @@ bool notify_observer_add(struct Notify *notify, enum NotifyType type,
  */
 bool notify_observer_remove(struct Notify *notify, observer_t callback, void *global_data)
 {
-  if (!notify || !callback)
+  if (!notify || !callback || !notify->buckets)
     return false;
 
-  struct ObserverNode *np = NULL;
-  STAILQ_FOREACH(np, &notify->observers, entries)
+  for (size_t i = 0; i < NT_TYPE_MAX; i++)
   {
-    if (!np->observer)
-      continue;
-
-    if ((np->observer->callback == callback) && (np->observer->global_data == global_data))
+    struct ObserverNode *np = NULL;
+    STAILQ_FOREACH(np, &notify->buckets[i], entries)
     {
-      FREE(&np->observer);
-      return true;
+      if (!np->observer)
+        continue;
+
+      if ((np->observer->callback == callback) && (np->observer->global_data == global_data))
+      {
+        FREE(&np->observer);
+        return true;
+      }
     }
   }
 
@@ -252,15 +307,18 @@ bool notify_observer_remove(struct Notify *notify, observer_t callback, void *gl
  */
 void notify_observer_remove_all(struct Notify *notify)
 {
-  if (!notify)
+  if (!notify || !notify->buckets)
     return;
 
-  struct ObserverNode *np = NULL;
-  struct ObserverNode *tmp = NULL;
-  STAILQ_FOREACH_SAFE(np, &notify->observers, entries, tmp)
+  for (size_t i = 0; i < NT_TYPE_MAX; i++)
   {
-    STAILQ_REMOVE(&notify->observers, np, ObserverNode, entries);
-    FREE(&np->observer);
-    FREE(&np);
+    struct ObserverNode *np = NULL;
+    struct ObserverNode *tmp = NULL;
+    STAILQ_FOREACH_SAFE(np, &notify->buckets[i], entries, tmp)
+    {
+      STAILQ_REMOVE(&notify->buckets[i], np, ObserverNode, entries);
+      FREE(&np->observer);
+      FREE(&np);
+    }
   }
 }
@@ -28,6 +28,9 @@
 
 #include "config.h"
 #include <stdio.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 #include "pool.h"
 #include "buffer.h"
 #include "logging.h"
@@ -39,6 +42,87 @@ static size_t BufferPoolIncrement = 20;
 static size_t BufferPoolInitialBufferSize = 1024;
 static struct Buffer **BufferPool = NULL;
 
+/// Size of a Buffer in the large class, e.g. for whole header lines
+static size_t BufferPoolLargeBufferSize = 16384;
+/// Maximum number of Buffers kept in the large class
+#define BUFFER_POOL_LARGE_MAX 8
+static size_t BufferPoolLargeCount = 0;
+static struct Buffer *BufferPoolLarge[BUFFER_POOL_LARGE_MAX];
+
+#ifdef HAVE_PTHREAD_CREATE
+/// Worker threads (mutt_worker_run()) share the pool with the main thread
+static pthread_mutex_t BufferPoolMutex = PTHREAD_MUTEX_INITIALIZER;
+#define pool_lock() pthread_mutex_lock(&BufferPoolMutex)
+#define pool_unlock() pthread_mutex_unlock(&BufferPoolMutex)
+#else
+#define pool_lock()
+#define pool_unlock()
+#endif
+
+#if defined(HAVE_PTHREAD_CREATE) && (defined(__GNUC__) || defined(__clang__))
+#define USE_POOL_TLS 1
+
+/// Number of Buffers kept in each thread's private cache
+#define POOL_TLS_MAX 4
+
+/**
+ * struct PoolTls - A thread's private cache of Buffers
+ *
+ * Get and release from this cache need no locking.  The cache is created on
+ * first use and handed back to the allocator when the thread exits, via the
+ * pthread key destructor; the global pool is the spillover.
+ */
+struct PoolTls
+{
+  struct Buffer *bufs[POOL_TLS_MAX]; ///< Stack of unused Buffers
+  size_t count;                      ///< Number of Buffers in the stack
+};
+
+static __thread struct PoolTls *ThreadPool = NULL;
+static pthread_key_t PoolTlsKey;
+static pthread_once_t PoolTlsKeyOnce = PTHREAD_ONCE_INIT;
+
+static void buffer_free(struct Buffer **p);
+
+/**
+ * pool_tls_destroy - Free a thread's Buffer cache when the thread exits
+ * @param ptr Thread's PoolTls
+ */
+static void pool_tls_destroy(void *ptr)
+{
+  struct PoolTls *tp = ptr;
+  if (!tp)
+    return;
+
+  while (tp->count)
+    buffer_free(&tp->bufs[--tp->count]);
+  FREE(&tp);
+}
+
+/**
+ * pool_tls_key_init - Create the pthread key for the thread caches
+ */
+static void pool_tls_key_init(void)
+{
+  pthread_key_create(&PoolTlsKey, pool_tls_destroy);
+}
+
+/**
+ * pool_tls - Get the current thread's Buffer cache, creating it if necessary
+ * @retval ptr Thread's PoolTls
+ */
+static struct PoolTls *pool_tls(void)
+{
+  if (!ThreadPool)
+  {
+    pthread_once(&PoolTlsKeyOnce, pool_tls_key_init);
+    ThreadPool = mutt_mem_calloc(1, sizeof(struct PoolTls));
+    pthread_setspecific(PoolTlsKey, ThreadPool);
+  }
+  return ThreadPool;
+}
+#endif /* HAVE_PTHREAD_CREATE && (__GNUC__ || __clang__) */
+
 /**
  * buffer_new - Allocate a new Buffer on the heap
  * @retval buf A newly allocated Buffer
@@ -88,10 +172,23 @@ void mutt_buffer_pool_free(void)
 {
   mutt_debug(LL_DEBUG1, "%zu of %zu returned to pool\n", BufferPoolCount, BufferPoolLen);
 
+#ifdef USE_POOL_TLS
+  /* The key destructor only runs for exiting threads, not for this one */
+  if (ThreadPool)
+  {
+    pthread_setspecific(PoolTlsKey, NULL);
+    pool_tls_destroy(ThreadPool);
+    ThreadPool = NULL;
+  }
+#endif
+
   while (BufferPoolCount)
     buffer_free(&BufferPool[--BufferPoolCount]);
   FREE(&BufferPool);
   BufferPoolLen = 0;
+
+  while (BufferPoolLargeCount)
+    buffer_free(&BufferPoolLarge[--BufferPoolLargeCount]);
 }
 
 /**
@@ -100,9 +197,28 @@ void mutt_buffer_pool_free(void)
  */
 struct Buffer *mutt_buffer_pool_get(void)
 {
-  if (BufferPoolCount == 0)
-    increase_buffer_pool();
-  return BufferPool[--BufferPoolCount];
+#ifdef USE_POOL_TLS
+  struct PoolTls *tp = pool_tls();
+  if (tp->count != 0)
+    return tp->bufs[--tp->count];
+#endif
+
+  pool_lock();
+  struct Buffer *buf = NULL;
+  if (BufferPoolLargeCount != 0)
+  {
+    /* Recycle a large Buffer before allocating; a bigger Buffer is always
+     * acceptable to the caller */
+    buf = BufferPoolLarge[--BufferPoolLargeCount];
+  }
+  else
+  {
+    if (BufferPoolCount == 0)
+      increase_buffer_pool();
+    buf = BufferPool[--BufferPoolCount];
+  }
+  pool_unlock();
+  return buf;
 }
 
 /**
@@ -114,14 +230,51 @@ void mutt_buffer_pool_release(struct Buffer **pbuf)
   if (!pbuf || !*pbuf)
     return;
 
+  struct Buffer *buf = *pbuf;
+
+#ifdef USE_POOL_TLS
+  /* Small Buffers go back to the thread's own cache, without locking */
+  if (buf->dsize <= (2 * BufferPoolInitialBufferSize))
+  {
+    struct PoolTls *tp = pool_tls();
+    if (tp->count < POOL_TLS_MAX)
+    {
+      mutt_buffer_reset(buf);
+      tp->bufs[tp->count++] = buf;
+      *pbuf = NULL;
+      return;
+    }
+  }
+#endif
+
+  pool_lock();
+  if (buf->dsize > (2 * BufferPoolInitialBufferSize))
+  {
+    /* Keep grown Buffers in the large class, so the next big header line
+     * doesn't have to grow a fresh one from scratch */
+    if (BufferPoolLargeCount < BUFFER_POOL_LARGE_MAX)
+    {
+      if (buf->dsize > BufferPoolLargeBufferSize)
+      {
+        buf->dsize = BufferPoolLargeBufferSize;
+        mutt_mem_realloc(&buf->data, buf->dsize);
+      }
+      mutt_buffer_reset(buf);
+      BufferPoolLarge[BufferPoolLargeCount++] = buf;
+      pool_unlock();
+      *pbuf = NULL;
+      return;
+    }
+  }
+
   if (BufferPoolCount >= BufferPoolLen)
   {
     mutt_debug(LL_DEBUG1, "Internal buffer pool error\n");
+    pool_unlock();
     buffer_free(pbuf);
     return;
   }
 
-  struct Buffer *buf = *pbuf;
   if ((buf->dsize > (2 * BufferPoolInitialBufferSize)) ||
       (buf->dsize < BufferPoolInitialBufferSize))
   {
@@ -130,6 +283,7 @@ void mutt_buffer_pool_release(struct Buffer **pbuf)
   }
   mutt_buffer_reset(buf);
   BufferPool[BufferPoolCount++] = buf;
+  pool_unlock();
 
   *pbuf = NULL;
 }
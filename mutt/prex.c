@@ -28,12 +28,31 @@
 
 #include "config.h"
 #include <assert.h>
+#include <ctype.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <string.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 #include "prex.h"
 #include "logging.h"
 #include "memory.h"
 
+#ifdef HAVE_PTHREAD_CREATE
+/// Parse worker threads compile and match concurrently
+static pthread_mutex_t PrexMutex = PTHREAD_MUTEX_INITIALIZER;
+#define prex_lock() pthread_mutex_lock(&PrexMutex)
+#define prex_unlock() pthread_mutex_unlock(&PrexMutex)
+#else
+#define prex_lock()
+#define prex_unlock()
+#endif
+
+#if defined(HAVE_PTHREAD_CREATE) && (defined(__GNUC__) || defined(__clang__))
+#define USE_PREX_TLS 1
+#endif
+
 #ifdef HAVE_PCRE2
 #define PCRE2_CODE_UNIT_WIDTH 8
 #include <pcre2.h>
@@ -267,6 +286,7 @@ static struct PrexStorage *prex(enum Prex which)
   assert((which >= 0) && (which < PREX_MAX) && "Invalid 'which' argument");
   struct PrexStorage *h = &storage[which];
   assert((which == h->which) && "Fix 'storage' array");
+  prex_lock();
   if (!h->re)
   {
 #ifdef HAVE_PCRE2
@@ -276,21 +296,516 @@ static struct PrexStorage *prex(enum Prex which)
     h->re = pcre2_compile((PCRE2_SPTR8) h->str, PCRE2_ZERO_TERMINATED, opt,
                           &eno, &eoff, NULL);
     assert(h->re && "Fix your RE");
-    h->mdata = pcre2_match_data_create_from_pattern(h->re, NULL);
     uint32_t ccount = 0;
     pcre2_pattern_info(h->re, PCRE2_INFO_CAPTURECOUNT, &ccount);
     assert(ccount + 1 == h->nmatches && "Number of matches do not match (...)");
+#ifndef USE_PREX_TLS
+    h->mdata = pcre2_match_data_create_from_pattern(h->re, NULL);
     h->matches = mutt_mem_calloc(h->nmatches, sizeof(*h->matches));
+#endif
 #else
     h->re = mutt_mem_calloc(1, sizeof(*h->re));
     const int rc = regcomp(h->re, h->str, REG_EXTENDED);
     assert(rc == 0 && "Fix your RE");
+#ifndef USE_PREX_TLS
     h->matches = mutt_mem_calloc(h->nmatches, sizeof(*h->matches));
+#endif
 #endif
   }
+  prex_unlock();
   return h;
 }
 
+#ifdef USE_PREX_TLS
+/**
+ * struct PrexCaptures - A thread's private capture storage
+ *
+ * The compiled regexes are shared between threads - matching against them is
+ * read-only - but every match writes its capture offsets somewhere, and
+ * callers read those offsets after mutt_prex_capture() returns, so a mutex
+ * inside the call could not protect them.  Give each thread its own arrays
+ * instead, created on first use and freed by the pthread key destructor when
+ * the thread exits.
+ */
+struct PrexCaptures
+{
+  regmatch_t *matches[PREX_MAX]; ///< Capture offsets, allocated on first use
+#ifdef HAVE_PCRE2
+  pcre2_match_data *mdata[PREX_MAX]; ///< pcre2 match blocks
+#endif
+};
+
+static __thread struct PrexCaptures *PrexTls = NULL;
+static pthread_key_t PrexTlsKey;
+static pthread_once_t PrexTlsKeyOnce = PTHREAD_ONCE_INIT;
+
+/**
+ * prex_tls_destroy - Free a thread's capture storage when the thread exits
+ * @param ptr Thread's PrexCaptures
+ */
+static void prex_tls_destroy(void *ptr)
+{
+  struct PrexCaptures *pc = ptr;
+  if (!pc)
+    return;
+
+  for (enum Prex which = 0; which < PREX_MAX; which++)
+  {
+    FREE(&pc->matches[which]);
+#ifdef HAVE_PCRE2
+    pcre2_match_data_free(pc->mdata[which]);
+#endif
+  }
+  FREE(&pc);
+}
+
+/**
+ * prex_tls_key_init - Create the pthread key for the capture storage
+ */
+static void prex_tls_key_init(void)
+{
+  pthread_key_create(&PrexTlsKey, prex_tls_destroy);
+}
+
+/**
+ * prex_captures - Get the calling thread's capture array for a regex
+ * @param h Compiled regex
+ * @retval ptr Array of h->nmatches match offsets
+ */
+static regmatch_t *prex_captures(const struct PrexStorage *h)
+{
+  if (!PrexTls)
+  {
+    pthread_once(&PrexTlsKeyOnce, prex_tls_key_init);
+    PrexTls = mutt_mem_calloc(1, sizeof(struct PrexCaptures));
+    pthread_setspecific(PrexTlsKey, PrexTls);
+  }
+  if (!PrexTls->matches[h->which])
+    PrexTls->matches[h->which] = mutt_mem_calloc(h->nmatches, sizeof(regmatch_t));
+  return PrexTls->matches[h->which];
+}
+
+#ifdef HAVE_PCRE2
+/**
+ * prex_mdata - Get the calling thread's pcre2 match block for a regex
+ * @param h Compiled regex
+ * @retval ptr pcre2 match data
+ */
+static pcre2_match_data *prex_mdata(const struct PrexStorage *h)
+{
+  prex_captures(h); /* make sure PrexTls exists */
+  if (!PrexTls->mdata[h->which])
+    PrexTls->mdata[h->which] = pcre2_match_data_create_from_pattern(h->re, NULL);
+  return PrexTls->mdata[h->which];
+}
+#endif
+#else /* !USE_PREX_TLS */
+/**
+ * prex_captures - Get the capture array for a regex
+ * @param h Compiled regex
+ * @retval ptr Array of h->nmatches match offsets
+ */
+static regmatch_t *prex_captures(const struct PrexStorage *h)
+{
+  return h->matches;
+}
+
+#ifdef HAVE_PCRE2
+/**
+ * prex_mdata - Get the pcre2 match block for a regex
+ * @param h Compiled regex
+ * @retval ptr pcre2 match data
+ */
+static pcre2_match_data *prex_mdata(const struct PrexStorage *h)
+{
+  return h->mdata;
+}
+#endif
+#endif /* USE_PREX_TLS */
+
+/// Day-of-week names, in the order #PREX_DOW matches them
+static const char *const PrexDows[] = { "Mon", "Tue", "Wed", "Thu",
+                                        "Fri", "Sat", "Sun" };
+
+/// Month names, in the order #PREX_MONTH matches them
+static const char *const PrexMonths[] = { "Jan", "Feb", "Mar", "Apr",
+                                          "May", "Jun", "Jul", "Aug",
+                                          "Sep", "Oct", "Nov", "Dec" };
+
+/**
+ * prex_scan_word - Scan one three-letter word from a table
+ * @param[in,out] sp     String to scan, updated past the word on success
+ * @param[in]     words  Table of words
+ * @param[in]     nwords Number of words in the table
+ * @retval true A word matched (case-sensitively)
+ */
+static bool prex_scan_word(const char **sp, const char *const *words, size_t nwords)
+{
+  for (size_t i = 0; i < nwords; i++)
+  {
+    if (strncmp(*sp, words[i], 3) == 0)
+    {
+      *sp += 3;
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * prex_scan_digits - Scan a run of digits
+ * @param[in,out] sp  String to scan, updated past the digits
+ * @param[in]     max Maximum number of digits to consume
+ * @retval num Number of digits consumed
+ */
+static size_t prex_scan_digits(const char **sp, size_t max)
+{
+  size_t n = 0;
+  while ((n < max) && isdigit((unsigned char) (*sp)[0]))
+  {
+    (*sp)++;
+    n++;
+  }
+  return n;
+}
+
+/**
+ * prex_set_match - Store one capture group as offsets into the string
+ * @param m    Match to fill
+ * @param base Start of the scanned string
+ * @param so   Start of the capture, or NULL if the group didn't participate
+ * @param eo   End of the capture (exclusive)
+ */
+static void prex_set_match(regmatch_t *m, const char *base, const char *so, const char *eo)
+{
+  if (so)
+  {
+    m->rm_so = so - base;
+    m->rm_eo = eo - base;
+  }
+  else
+  {
+    m->rm_so = -1;
+    m->rm_eo = -1;
+  }
+}
+
+/**
+ * prex_scan_day - Scan the day-of-month group shared by several patterns
+ * @param[in,out] sp      String to scan, updated past the day on success
+ * @param[out]    day1_so Start of a space-padded single digit day, or NULL
+ * @param[out]    day2_so Start of a two digit day, or NULL
+ * @retval true The day matched
+ *
+ * This is the `( [0-9]|[0-9]{2})` group of #PREX_MBOX_FROM and #PREX_IMAP_DATE.
+ */
+static bool prex_scan_day(const char **sp, const char **day1_so, const char **day2_so)
+{
+  const char *p = *sp;
+  *day1_so = NULL;
+  *day2_so = NULL;
+
+  if ((p[0] == ' ') && isdigit((unsigned char) p[1]))
+    *day1_so = p + 1;
+  else if (isdigit((unsigned char) p[0]) && isdigit((unsigned char) p[1]))
+    *day2_so = p;
+  else
+    return false;
+
+  *sp = p + 2;
+  return true;
+}
+
+/**
+ * prex_scan_time - Scan a `HH:MM:SS` time
+ * @param[in,out] sp String to scan, updated past the time on success
+ * @retval true The time matched
+ */
+static bool prex_scan_time(const char **sp)
+{
+  const char *p = *sp;
+  if ((prex_scan_digits(&p, 2) != 2) || (*p++ != ':') ||
+      (prex_scan_digits(&p, 2) != 2) || (*p++ != ':') || (prex_scan_digits(&p, 2) != 2))
+  {
+    return false;
+  }
+  *sp = p;
+  return true;
+}
+
+/**
+ * prex_scan_mbox_from - Scan an mbox-style From line
+ * @param m   Captures to fill
+ * @param str String to scan
+ * @retval true The line matched #PREX_MBOX_FROM
+ *
+ * Single-pass equivalent of the #PREX_MBOX_FROM regex.  It fills the same
+ * capture groups; the caller falls back to the regex when the scan fails.
+ */
+static bool prex_scan_mbox_from(regmatch_t *m, const char *str)
+{
+  const char *p = str;
+
+  if (strncmp(p, "From ", 5) != 0)
+    return false;
+  p += 5;
+
+  const char *sender_so = p;
+  while ((*p != '\0') && !isspace((unsigned char) *p))
+    p++;
+  if (p == sender_so)
+    return false;
+  const char *sender_eo = p;
+
+  if (*p != ' ')
+    return false;
+  while (*p == ' ')
+    p++;
+
+  const char *dow_so = p;
+  if (!prex_scan_word(&p, PrexDows, mutt_array_size(PrexDows)))
+    return false;
+  const char *dow_eo = p;
+
+  if (*p != ' ')
+    return false;
+  while (*p == ' ')
+    p++;
+
+  const char *month_so = p;
+  if (!prex_scan_word(&p, PrexMonths, mutt_array_size(PrexMonths)))
+    return false;
+  const char *month_eo = p;
+
+  if (*p++ != ' ') // exactly one space before the day group
+    return false;
+
+  const char *day_so = p;
+  const char *day1_so = NULL;
+  const char *day2_so = NULL;
+  if (!prex_scan_day(&p, &day1_so, &day2_so))
+    return false;
+  const char *day_eo = p;
+
+  if (*p != ' ')
+    return false;
+  while (*p == ' ')
+    p++;
+
+  const char *time_so = p;
+  if (!prex_scan_time(&p))
+    return false;
+  const char *time_eo = p;
+
+  if (*p != ' ')
+    return false;
+  while (*p == ' ')
+    p++;
+
+  const char *year_so = p;
+  if (prex_scan_digits(&p, 4) != 4)
+    return false;
+  const char *year_eo = p;
+
+  prex_set_match(&m[PREX_MBOX_FROM_MATCH_FULL], str, str, year_eo);
+  prex_set_match(&m[PREX_MBOX_FROM_MATCH_ENVSENDER], str, sender_so, sender_eo);
+  prex_set_match(&m[PREX_MBOX_FROM_MATCH_DOW], str, dow_so, dow_eo);
+  prex_set_match(&m[PREX_MBOX_FROM_MATCH_MONTH], str, month_so, month_eo);
+  prex_set_match(&m[PREX_MBOX_FROM_MATCH_DAY], str, day_so, day_eo);
+  prex_set_match(&m[PREX_MBOX_FROM_MATCH_DAY1], str, day1_so, day1_so ? day1_so + 1 : NULL);
+  prex_set_match(&m[PREX_MBOX_FROM_MATCH_DAY2], str, day2_so, day2_so ? day2_so + 2 : NULL);
+  prex_set_match(&m[PREX_MBOX_FROM_MATCH_TIME], str, time_so, time_eo);
+  prex_set_match(&m[PREX_MBOX_FROM_MATCH_YEAR], str, year_so, year_eo);
+  return true;
+}
+
+/**
+ * prex_scan_rfc5322_date - Scan an RFC5322 date
+ * @param m   Captures to fill
+ * @param str String to scan
+ * @retval true The string matched #PREX_RFC5322_DATE
+ *
+ * Single-pass equivalent of the #PREX_RFC5322_DATE regex.  It fills the same
+ * capture groups; the caller falls back to the regex when the scan fails.
+ */
+static bool prex_scan_rfc5322_date(regmatch_t *m, const char *str)
+{
+  const char *p = str;
+
+  const char *maybe_dow_so = NULL;
+  const char *maybe_dow_eo = NULL;
+  const char *dow_so = NULL;
+  const char *dow_eo = NULL;
+  if (isalpha((unsigned char) *p))
+  {
+    dow_so = p;
+    if (!prex_scan_word(&p, PrexDows, mutt_array_size(PrexDows)))
+      return false;
+    dow_eo = p;
+    if ((p[0] != ',') || (p[1] != ' '))
+      return false;
+    p += 2;
+    maybe_dow_so = dow_so;
+    maybe_dow_eo = p;
+  }
+  while (*p == ' ')
+    p++;
+
+  const char *day_so = p;
+  const size_t day_len = prex_scan_digits(&p, 2);
+  if ((day_len == 0) || isdigit((unsigned char) *p))
+    return false;
+  const char *day_eo = p;
+  if (*p++ != ' ')
+    return false;
+
+  const char *month_so = p;
+  if (!prex_scan_word(&p, PrexMonths, mutt_array_size(PrexMonths)))
+    return false;
+  const char *month_eo = p;
+  if (*p++ != ' ')
+    return false;
+
+  const char *year_so = p;
+  const size_t year_len = prex_scan_digits(&p, 4);
+  if ((year_len < 2) || isdigit((unsigned char) *p))
+    return false;
+  const char *year_eo = p;
+  if (*p++ != ' ')
+    return false;
+
+  const char *hour_so = p;
+  if (prex_scan_digits(&p, 2) != 2)
+    return false;
+  const char *hour_eo = p;
+  if (*p++ != ':')
+    return false;
+
+  const char *minute_so = p;
+  if (prex_scan_digits(&p, 2) != 2)
+    return false;
+  const char *minute_eo = p;
+
+  const char *colonsec_so = NULL;
+  const char *colonsec_eo = NULL;
+  const char *sec_so = NULL;
+  const char *sec_eo = NULL;
+  if ((p[0] == ':') && isdigit((unsigned char) p[1]) && isdigit((unsigned char) p[2]))
+  {
+    colonsec_so = p;
+    sec_so = p + 1;
+    p += 3;
+    colonsec_eo = p;
+    sec_eo = p;
+  }
+
+  while (*p == ' ')
+    p++;
+
+  const char *tzfull_so = p;
+  const char *tz_so = NULL;
+  const char *tz_eo = NULL;
+  const char *tzobs_so = NULL;
+  const char *tzobs_eo = NULL;
+  if ((*p == '+') || (*p == '-'))
+  {
+    tz_so = p;
+    p++;
+    if (prex_scan_digits(&p, 4) != 4)
+      return false;
+    tz_eo = p;
+  }
+  else if (isalpha((unsigned char) *p))
+  {
+    tzobs_so = p;
+    while (isalpha((unsigned char) *p))
+      p++;
+    tzobs_eo = p;
+  }
+  else
+  {
+    return false;
+  }
+  const char *tzfull_eo = p;
+
+  prex_set_match(&m[PREX_RFC5322_DATE_MATCH_FULL], str, str, tzfull_eo);
+  prex_set_match(&m[PREX_RFC5322_DATE_MATCH_MAYBE_DOW], str, maybe_dow_so, maybe_dow_eo);
+  prex_set_match(&m[PREX_RFC5322_DATE_MATCH_DOW], str, dow_so, dow_eo);
+  prex_set_match(&m[PREX_RFC5322_DATE_MATCH_DAY], str, day_so, day_eo);
+  prex_set_match(&m[PREX_RFC5322_DATE_MATCH_MONTH], str, month_so, month_eo);
+  prex_set_match(&m[PREX_RFC5322_DATE_MATCH_YEAR], str, year_so, year_eo);
+  prex_set_match(&m[PREX_RFC5322_DATE_MATCH_HOUR], str, hour_so, hour_eo);
+  prex_set_match(&m[PREX_RFC5322_DATE_MATCH_MINUTE], str, minute_so, minute_eo);
+  prex_set_match(&m[PREX_RFC5322_DATE_MATCH_COLONSECOND], str, colonsec_so, colonsec_eo);
+  prex_set_match(&m[PREX_RFC5322_DATE_MATCH_SECOND], str, sec_so, sec_eo);
+  prex_set_match(&m[PREX_RFC5322_DATE_MATCH_TZFULL], str, tzfull_so, tzfull_eo);
+  prex_set_match(&m[PREX_RFC5322_DATE_MATCH_TZ], str, tz_so, tz_eo);
+  prex_set_match(&m[PREX_RFC5322_DATE_MATCH_TZ_OBS], str, tzobs_so, tzobs_eo);
+  return true;
+}
+
+/**
+ * prex_scan_imap_date - Scan an IMAP `INTERNALDATE`
+ * @param m   Captures to fill
+ * @param str String to scan
+ * @retval true The string matched #PREX_IMAP_DATE at its start
+ *
+ * Single-pass equivalent of the #PREX_IMAP_DATE regex, anchored at the start
+ * of the string.  The regex isn't anchored, so a failed scan falls back to it.
+ */
+static bool prex_scan_imap_date(regmatch_t *m, const char *str)
+{
+  const char *p = str;
+
+  const char *day_so = p;
+  const char *day1_so = NULL;
+  const char *day2_so = NULL;
+  if (!prex_scan_day(&p, &day1_so, &day2_so))
+    return false;
+  const char *day_eo = p;
+  if (*p++ != '-')
+    return false;
+
+  const char *month_so = p;
+  if (!prex_scan_word(&p, PrexMonths, mutt_array_size(PrexMonths)))
+    return false;
+  const char *month_eo = p;
+  if (*p++ != '-')
+    return false;
+
+  const char *year_so = p;
+  if (prex_scan_digits(&p, 4) != 4)
+    return false;
+  const char *year_eo = p;
+  if (*p++ != ' ')
+    return false;
+
+  const char *time_so = p;
+  if (!prex_scan_time(&p))
+    return false;
+  const char *time_eo = p;
+  if (*p++ != ' ')
+    return false;
+
+  const char *tz_so = p;
+  if ((*p != '+') && (*p != '-'))
+    return false;
+  p++;
+  if (prex_scan_digits(&p, 4) != 4)
+    return false;
+  const char *tz_eo = p;
+
+  prex_set_match(&m[PREX_IMAP_DATE_MATCH_FULL], str, str, tz_eo);
+  prex_set_match(&m[PREX_IMAP_DATE_MATCH_DAY], str, day_so, day_eo);
+  prex_set_match(&m[PREX_IMAP_DATE_MATCH_DAY1], str, day1_so, day1_so ? day1_so + 1 : NULL);
+  prex_set_match(&m[PREX_IMAP_DATE_MATCH_DAY2], str, day2_so, day2_so ? day2_so + 2 : NULL);
+  prex_set_match(&m[PREX_IMAP_DATE_MATCH_MONTH], str, month_so, month_eo);
+  prex_set_match(&m[PREX_IMAP_DATE_MATCH_YEAR], str, year_so, year_eo);
+  prex_set_match(&m[PREX_IMAP_DATE_MATCH_TIME], str, time_so, time_eo);
+  prex_set_match(&m[PREX_IMAP_DATE_MATCH_TZ], str, tz_so, tz_eo);
+  return true;
+}
+
 /**
  * mutt_prex_capture - Match a precompiled regex against a string
  * @param which Which regex to return
@@ -304,9 +819,32 @@ regmatch_t *mutt_prex_capture(enum Prex which, const char *str)
     return NULL;
 
   struct PrexStorage *h = prex(which);
+  regmatch_t *m = prex_captures(h);
+
+  /* The hot, rigid formats have single-pass scanners.  They only recognise
+   * the common shape; anything unusual falls through to the regex. */
+  switch (which)
+  {
+    case PREX_MBOX_FROM:
+      if (prex_scan_mbox_from(m, str))
+        return m;
+      break;
+    case PREX_RFC5322_DATE:
+      if (prex_scan_rfc5322_date(m, str))
+        return m;
+      break;
+    case PREX_IMAP_DATE:
+      if (prex_scan_imap_date(m, str))
+        return m;
+      break;
+    default:
+      break;
+  }
+
 #ifdef HAVE_PCRE2
+  pcre2_match_data *mdata = prex_mdata(h);
   size_t len = strlen(str);
-  int rc = pcre2_match(h->re, (PCRE2_SPTR8) str, len, 0, 0, h->mdata, NULL);
+  int rc = pcre2_match(h->re, (PCRE2_SPTR8) str, len, 0, 0, mdata, NULL);
   if (rc < 0)
   {
     PCRE2_UCHAR errmsg[1024];
@@ -314,26 +852,26 @@ regmatch_t *mutt_prex_capture(enum Prex which, const char *str)
     mutt_debug(LL_DEBUG2, "pcre2_match - <%s> -> <%s> =  %s\n", h->str, str, errmsg);
     return NULL;
   }
-  PCRE2_SIZE *ovector = pcre2_get_ovector_pointer(h->mdata);
+  PCRE2_SIZE *ovector = pcre2_get_ovector_pointer(mdata);
   int i = 0;
   for (; i < rc; i++)
   {
-    h->matches[i].rm_so = ovector[i * 2];
-    h->matches[i].rm_eo = ovector[i * 2 + 1];
+    m[i].rm_so = ovector[i * 2];
+    m[i].rm_eo = ovector[i * 2 + 1];
   }
   for (; i < h->nmatches; i++)
   {
-    h->matches[i].rm_so = -1;
-    h->matches[i].rm_eo = -1;
+    m[i].rm_so = -1;
+    m[i].rm_eo = -1;
   }
 #else
-  if (regexec(h->re, str, h->nmatches, h->matches, 0))
+  if (regexec(h->re, str, h->nmatches, m, 0))
     return NULL;
 
   assert((h->re->re_nsub == (h->nmatches - 1)) &&
          "Regular expression and matches enum are out of sync");
 #endif
-  return h->matches;
+  return m;
 }
 
 /**
@@ -353,4 +891,14 @@ void mutt_prex_free(void)
 #endif
     FREE(&h->matches);
   }
+
+#ifdef USE_PREX_TLS
+  /* The key destructor runs for worker threads, but not for the main thread */
+  if (PrexTls)
+  {
+    pthread_setspecific(PrexTlsKey, NULL);
+    prex_tls_destroy(PrexTls);
+    PrexTls = NULL;
+  }
+#endif
 }
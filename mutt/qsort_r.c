@@ -29,8 +29,13 @@
 #include "config.h"
 #include <stddef.h>
 #include <stdlib.h>
+#include <string.h>
+#include "memory.h"
 #include "qsort_r.h"
 
+/// Minimum array size before looking for a presorted prefix
+#define PRESORT_MIN 64
+
 /**
  * typedef qsort_compar_t - Prototype for generic comparison function, compatible with qsort()
  * @param a First item
@@ -63,17 +68,15 @@ static int relay_compar(const void *a, const void *b)
 #endif
 
 /**
- * mutt_qsort_r - Sort an array, where the comparator has access to opaque data rather than requiring global variables
+ * qsort_dispatch - Sort an array with the platform's context-passing qsort
  * @param base   Start of the array to be sorted
  * @param nmemb  Number of elements in the array
  * @param size   Size of each array element
  * @param compar Comparison function, return <0/0/>0 to compare two elements
  * @param arg    Opaque argument to pass to @a compar
- *
- * @note This implementation might not be re-entrant: signal handlers and
- *       @a compar must not call mutt_qsort_r().
  */
-void mutt_qsort_r(void *base, size_t nmemb, size_t size, qsort_r_compar_t compar, void *arg)
+static void qsort_dispatch(void *base, size_t nmemb, size_t size,
+                           qsort_r_compar_t compar, void *arg)
 {
 #ifdef HAVE_QSORT_S
   /* FreeBSD 13, where qsort_r had incompatible signature but qsort_s works */
@@ -91,3 +94,100 @@ void mutt_qsort_r(void *base, size_t nmemb, size_t size, qsort_r_compar_t compar
   global_data = NULL;
 #endif
 }
+
+/**
+ * sorted_prefix_len - Count how many leading elements are already in order
+ * @param base   Start of the array
+ * @param nmemb  Number of elements in the array
+ * @param size   Size of each array element
+ * @param compar Comparison function
+ * @param arg    Opaque argument to pass to @a compar
+ * @retval num Length of the sorted run starting at @a base, at least 1
+ */
+static size_t sorted_prefix_len(const char *base, size_t nmemb, size_t size,
+                                qsort_r_compar_t compar, void *arg)
+{
+  size_t len = 1;
+  while ((len < nmemb) && (compar(base + ((len - 1) * size), base + (len * size), arg) <= 0))
+    len++;
+  return len;
+}
+
+/**
+ * merge_sorted_tail - Merge a sorted tail into the sorted prefix before it
+ * @param base   Start of the array
+ * @param prefix Number of sorted elements at the start
+ * @param nmemb  Number of elements in the array
+ * @param size   Size of each array element
+ * @param compar Comparison function
+ * @param arg    Opaque argument to pass to @a compar
+ *
+ * Merge from the right, so only the tail needs a temporary copy: once the
+ * tail is exhausted, the remaining prefix elements are already in place.
+ * Ties go to the tail element, keeping the newcomers after the elements
+ * that were in the array before them.
+ */
+static void merge_sorted_tail(char *base, size_t prefix, size_t nmemb,
+                              size_t size, qsort_r_compar_t compar, void *arg)
+{
+  const size_t tail = nmemb - prefix;
+  char *tmp = mutt_mem_malloc(tail * size);
+  memcpy(tmp, base + (prefix * size), tail * size);
+
+  char *dst = base + ((nmemb - 1) * size);      /* next slot to fill */
+  const char *pre = base + ((prefix - 1) * size); /* last prefix element */
+  const char *tl = tmp + ((tail - 1) * size);   /* last tail element */
+
+  while (tl >= tmp)
+  {
+    if ((pre >= base) && (compar(pre, tl, arg) > 0))
+    {
+      memcpy(dst, pre, size);
+      pre -= size;
+    }
+    else
+    {
+      memcpy(dst, tl, size);
+      tl -= size;
+    }
+    dst -= size;
+  }
+
+  FREE(&tmp);
+}
+
+/**
+ * mutt_qsort_r - Sort an array, where the comparator has access to opaque data rather than requiring global variables
+ * @param base   Start of the array to be sorted
+ * @param nmemb  Number of elements in the array
+ * @param size   Size of each array element
+ * @param compar Comparison function, return <0/0/>0 to compare two elements
+ * @param arg    Opaque argument to pass to @a compar
+ *
+ * Re-sorting after incremental delivery is the common case: the array is one
+ * long presorted run with a few new elements at the end.  Detect the run
+ * first; if only a small tail is out of order, sort just the tail and merge
+ * it back, making such re-sorts O(n) instead of O(n log n) comparisons.
+ *
+ * @note This implementation might not be re-entrant: signal handlers and
+ *       @a compar must not call mutt_qsort_r().
+ */
+void mutt_qsort_r(void *base, size_t nmemb, size_t size, qsort_r_compar_t compar, void *arg)
+{
+  if (nmemb >= PRESORT_MIN)
+  {
+    const size_t prefix = sorted_prefix_len(base, nmemb, size, compar, arg);
+    if (prefix == nmemb)
+      return; /* already sorted */
+
+    const size_t tail = nmemb - prefix;
+    if (tail <= (nmemb / 4))
+    {
+      qsort_dispatch((char *) base + (prefix * size), tail, size, compar, arg);
+      merge_sorted_tail(base, prefix, nmemb, size, compar, arg);
+      return;
+    }
+  }
+
+  qsort_dispatch(base, nmemb, size, compar, arg);
+}
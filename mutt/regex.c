@@ -45,6 +45,122 @@
 #include "regex3.h"
 #include "string2.h"
 
+/**
+ * mutt_regex_prefilter - Find a literal substring that every match must contain
+ * @param str Regular expression
+ * @retval ptr  Literal substring, to be freed by the caller
+ * @retval NULL No usable substring could be proved
+ *
+ * A string that doesn't contain the literal can't match the pattern, so a
+ * cheap substring scan can reject most candidates without running the regex
+ * engine at all, e.g. 50 `subjectrx` rules against every displayed subject.
+ *
+ * The extraction is conservative.  Alternation, groups and backslash escapes
+ * abort it; quantifiers discard the (possibly optional) character they bind
+ * to; bracket expressions, wildcards and anchors merely end the current run.
+ * Only ASCII runs are kept, as a bytewise case-insensitive scan is not sound
+ * for multibyte characters.  The longest surviving run wins.
+ */
+char *mutt_regex_prefilter(const char *str)
+{
+  const char *run = str;   /* start of the current literal run */
+  const char *best = NULL; /* longest run seen so far */
+  size_t best_len = 0;
+  const char *p = str;
+
+  for (; ; p++)
+  {
+    unsigned char c = *p;
+    size_t run_len = p - run;
+
+    if ((c != '*') && (c != '?') && (c != '{'))
+    {
+      /* A quantifier would have made the previous character optional */
+      if (run_len > best_len)
+      {
+        best = run;
+        best_len = run_len;
+      }
+    }
+
+    if (c == '\0')
+      break;
+
+    switch (c)
+    {
+      case '(':
+      case ')':
+      case '|':
+      case '\\':
+        return NULL; /* groups may repeat and escapes aren't all literal */
+
+      case '*':
+      case '?':
+      case '{':
+        if (run_len > 1) /* all but the quantified character is required */
+        {
+          if ((run_len - 1) > best_len)
+          {
+            best = run;
+            best_len = run_len - 1;
+          }
+        }
+        if (c == '{') /* skip the interval, its comma and digits look literal */
+        {
+          p = strchr(p, '}');
+          if (!p)
+            return NULL;
+        }
+        run = p + 1;
+        break;
+
+      case '[': /* bracket expressions match many things; skip them */
+        p++;
+        if (*p == '^')
+          p++;
+        if (*p == ']') /* a leading ']' is literal */
+          p++;
+        while (*p && (*p != ']'))
+        {
+          if ((*p == '[') && ((p[1] == ':') || (p[1] == '.') || (p[1] == '=')))
+          {
+            /* [:class:], [.element.] or [=equivalent=]; ']' inside is literal */
+            char delim = p[1];
+            p += 2;
+            while (*p && !((p[0] == delim) && (p[1] == ']')))
+              p++;
+            if (*p == '\0')
+              return NULL;
+            p += 2;
+          }
+          else
+            p++;
+        }
+        if (*p == '\0')
+          return NULL;
+        run = p + 1;
+        break;
+
+      case '.':
+      case '^':
+      case '$':
+      case '+': /* the character stays required, but adjacency ends here */
+        run = p + 1;
+        break;
+
+      default:
+        if (c >= 0x80) /* non-ASCII: no sound case-insensitive byte search */
+          run = p + 1;
+        break;
+    }
+  }
+
+  if (best_len < 2) /* a single byte rejects too little to pay for the scan */
+    return NULL;
+
+  return mutt_strn_dup(best, best_len);
+}
+
 /**
  * mutt_regex_compile - Create an Regex from a string
  * @param str   Regular expression
@@ -61,6 +177,8 @@ struct Regex *mutt_regex_compile(const char *str, uint16_t flags)
   rx->regex = mutt_mem_calloc(1, sizeof(regex_t));
   if (REG_COMP(rx->regex, str, flags) != 0)
     mutt_regex_free(&rx);
+  else
+    rx->prefilter = mutt_regex_prefilter(str);
 
   return rx;
 }
@@ -104,6 +222,7 @@ struct Regex *mutt_regex_new(const char *str, uint32_t flags, struct Buffer *err
     return NULL;
   }
 
+  reg->prefilter = mutt_regex_prefilter(str);
   return reg;
 }
 
@@ -117,6 +236,7 @@ void mutt_regex_free(struct Regex **r)
     return;
 
   FREE(&(*r)->pattern);
+  FREE(&(*r)->prefilter);
   if ((*r)->regex)
     regfree((*r)->regex);
   FREE(&(*r)->regex);
@@ -616,6 +736,11 @@ bool mutt_regex_capture(const struct Regex *regex, const char *str,
   if (!regex || !str || !regex->regex)
     return false;
 
+  /* A string without the mandatory literal can't match; skip the engine.
+   * The scan is case-insensitive, a superset of any REG_ICASE decision. */
+  if (regex->prefilter && !mutt_istr_find(str, regex->prefilter))
+    return regex->pat_not;
+
   int rc = regexec(regex->regex, str, nmatch, matches, 0);
   return ((rc == 0) ^ regex->pat_not);
 }
@@ -631,3 +756,20 @@ bool mutt_regex_match(const struct Regex *regex, const char *str)
 {
   return mutt_regex_capture(regex, str, 0, NULL);
 }
+
+/**
+ * mutt_regex_is_literal - Does a regular expression contain no metacharacters?
+ * @param str Regular expression
+ * @retval true str would only ever match itself
+ *
+ * A literal expression can be matched with a plain substring scan, which is
+ * much cheaper than the regex engine.  The check is conservative: any
+ * character that's special in POSIX extended syntax disqualifies the string.
+ */
+bool mutt_regex_is_literal(const char *str)
+{
+  if (!str || (*str == '\0'))
+    return false;
+
+  return (strpbrk(str, "^$.[]()|*+?{}\\") == NULL);
+}
@@ -88,8 +88,9 @@ static inline size_t mutt_regmatch_len(const regmatch_t *match)
  */
 struct Regex
 {
-  char *pattern;  ///< printable version
-  regex_t *regex; ///< compiled expression
+  char *pattern;    ///< printable version
+  regex_t *regex;   ///< compiled expression
+  char *prefilter;  ///< literal substring every match must contain, or NULL
   bool pat_not;       ///< do not match
 };
 
@@ -134,5 +135,7 @@ int             mutt_replacelist_remove(struct ReplaceList *rl, const char *pat)
 
 bool mutt_regex_match  (const struct Regex *regex, const char *str);
 bool mutt_regex_capture(const struct Regex *regex, const char *str, size_t num, regmatch_t matches[]);
+bool mutt_regex_is_literal(const char *str);
+char *mutt_regex_prefilter(const char *str);
 
 #endif /* MUTT_LIB_REGEX3_H */
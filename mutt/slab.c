@@ -0,0 +1,176 @@
+/**
+ * @file
+ * Slab allocator for fixed-size objects
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_slab Slab allocator for fixed-size objects
+ *
+ * Structs that are allocated once per message (Email, Envelope, Body) are
+ * carved out of large chunks instead of being malloc'd one by one.  A freed
+ * object goes onto a free list and is handed out again by the next
+ * allocation, so opening a huge folder costs one malloc per chunk rather
+ * than one per object, and the objects of a mailbox end up tightly packed.
+ */
+
+#include "config.h"
+#include <string.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
+#include "slab.h"
+#include "memory.h"
+
+/**
+ * struct SlabChunk - A block of objects carved out by a Slab
+ *
+ * The objects follow the header; the header is padded to two pointers to
+ * keep them suitably aligned.
+ */
+struct SlabChunk
+{
+  struct SlabChunk *next; ///< Linked list of chunks
+  void *pad;              ///< Keep the objects pointer-pair aligned
+};
+
+/**
+ * struct Slab - Allocator for objects of one fixed size
+ *
+ * The free list is threaded through the first pointer-size bytes of each
+ * free object.
+ */
+struct Slab
+{
+  size_t obj_size;          ///< Size of one object
+  size_t per_chunk;         ///< Number of objects per chunk
+  struct SlabChunk *chunks; ///< All the chunks of this Slab
+  void *free_list;          ///< Objects ready to be handed out
+#ifdef HAVE_PTHREAD_CREATE
+  pthread_mutex_t mutex;    ///< Worker threads share the Slab with the main thread
+#endif
+};
+
+#ifdef HAVE_PTHREAD_CREATE
+#define slab_lock(s) pthread_mutex_lock(&(s)->mutex)
+#define slab_unlock(s) pthread_mutex_unlock(&(s)->mutex)
+#else
+#define slab_lock(s)
+#define slab_unlock(s)
+#endif
+
+/**
+ * slab_grow - Add a chunk of objects to a Slab's free list
+ * @param slab Slab to grow
+ */
+static void slab_grow(struct Slab *slab)
+{
+  struct SlabChunk *chunk =
+      mutt_mem_malloc(sizeof(struct SlabChunk) + (slab->obj_size * slab->per_chunk));
+  chunk->next = slab->chunks;
+  slab->chunks = chunk;
+
+  char *obj = (char *) (chunk + 1);
+  for (size_t i = 0; i < slab->per_chunk; i++, obj += slab->obj_size)
+  {
+    *(void **) obj = slab->free_list;
+    slab->free_list = obj;
+  }
+}
+
+/**
+ * mutt_slab_new - Create an allocator for objects of one fixed size
+ * @param obj_size  Size of one object, at least sizeof(void *)
+ * @param per_chunk Number of objects to allocate at a time
+ * @retval ptr Newly allocated Slab
+ */
+struct Slab *mutt_slab_new(size_t obj_size, size_t per_chunk)
+{
+  struct Slab *slab = mutt_mem_calloc(1, sizeof(struct Slab));
+  slab->obj_size = (obj_size < sizeof(void *)) ? sizeof(void *) : obj_size;
+  slab->per_chunk = (per_chunk == 0) ? 1 : per_chunk;
+#ifdef HAVE_PTHREAD_CREATE
+  pthread_mutex_init(&slab->mutex, NULL);
+#endif
+  return slab;
+}
+
+/**
+ * mutt_slab_alloc - Take a zeroed object from a Slab
+ * @param slab Slab to allocate from
+ * @retval ptr Object of the Slab's size, zeroed
+ */
+void *mutt_slab_alloc(struct Slab *slab)
+{
+  slab_lock(slab);
+  if (!slab->free_list)
+    slab_grow(slab);
+
+  void *obj = slab->free_list;
+  slab->free_list = *(void **) obj;
+  slab_unlock(slab);
+
+  memset(obj, 0, slab->obj_size);
+  return obj;
+}
+
+/**
+ * mutt_slab_release - Return an object to its Slab
+ * @param[in]  slab Slab the object came from
+ * @param[out] ptr  Object to release, will be set to NULL
+ */
+void mutt_slab_release(struct Slab *slab, void **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  slab_lock(slab);
+  *(void **) *ptr = slab->free_list;
+  slab->free_list = *ptr;
+  slab_unlock(slab);
+
+  *ptr = NULL;
+}
+
+/**
+ * mutt_slab_free - Free a Slab and all its chunks
+ * @param[out] ptr Slab to free
+ *
+ * All the objects must have been released already.
+ */
+void mutt_slab_free(struct Slab **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct Slab *slab = *ptr;
+
+  struct SlabChunk *chunk = slab->chunks;
+  while (chunk)
+  {
+    struct SlabChunk *next = chunk->next;
+    FREE(&chunk);
+    chunk = next;
+  }
+
+#ifdef HAVE_PTHREAD_CREATE
+  pthread_mutex_destroy(&slab->mutex);
+#endif
+  FREE(ptr);
+}
@@ -0,0 +1,35 @@
+/**
+ * @file
+ * Slab allocator for fixed-size objects
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_LIB_SLAB_H
+#define MUTT_LIB_SLAB_H
+
+#include <stddef.h>
+
+struct Slab;
+
+struct Slab *mutt_slab_new(size_t obj_size, size_t per_chunk);
+void *mutt_slab_alloc(struct Slab *slab);
+void mutt_slab_release(struct Slab *slab, void **ptr);
+void mutt_slab_free(struct Slab **ptr);
+
+#endif /* MUTT_LIB_SLAB_H */
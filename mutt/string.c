@@ -560,19 +560,24 @@ int mutt_str_coll(const char *a, const char *b)
 }
 
 /**
- * mutt_istr_find - Find first occurrence of string (ignoring case)
+ * ascii_lower - Lowercase an ASCII character, independently of the locale
+ * @param c Character to lowercase
+ * @retval num Lowercased character
+ */
+static inline unsigned char ascii_lower(unsigned char c)
+{
+  return ((c >= 'A') && (c <= 'Z')) ? (c | 0x20) : c;
+}
+
+/**
+ * istr_find_locale - Find first occurrence of string, using the locale's case rules
  * @param haystack String to search through
  * @param needle   String to find
  * @retval ptr  First match of the search string
- * @retval NULL No match, or an error
+ * @retval NULL No match
  */
-const char *mutt_istr_find(const char *haystack, const char *needle)
+static const char *istr_find_locale(const char *haystack, const char *needle)
 {
-  if (!haystack)
-    return NULL;
-  if (!needle)
-    return haystack;
-
   const char *p = NULL, *q = NULL;
 
   while (*(p = haystack))
@@ -589,6 +594,51 @@ const char *mutt_istr_find(const char *haystack, const char *needle)
   return NULL;
 }
 
+/**
+ * mutt_istr_find - Find first occurrence of string (ignoring case)
+ * @param haystack String to search through
+ * @param needle   String to find
+ * @retval ptr  First match of the search string
+ * @retval NULL No match, or an error
+ */
+const char *mutt_istr_find(const char *haystack, const char *needle)
+{
+  if (!haystack)
+    return NULL;
+  if (!needle)
+    return haystack;
+
+  /* Needles with non-ASCII bytes keep the locale's case rules */
+  for (const char *q = needle; *q; q++)
+  {
+    if ((unsigned char) *q >= 0x80)
+      return istr_find_locale(haystack, needle);
+  }
+
+  if (*needle == '\0')
+    return (*haystack != '\0') ? haystack : NULL;
+
+  /* ASCII needles fold case independently of the locale, so protocol
+   * strings match the same way everywhere */
+  const unsigned char first = ascii_lower((unsigned char) needle[0]);
+  for (const char *p = haystack; *p; p++)
+  {
+    if (ascii_lower((unsigned char) *p) != first)
+      continue;
+    size_t i = 1;
+    while (needle[i] && p[i] &&
+           (ascii_lower((unsigned char) p[i]) == ascii_lower((unsigned char) needle[i])))
+    {
+      i++;
+    }
+    if (needle[i] == '\0')
+      return p;
+    if (p[i] == '\0')
+      return NULL; /* too little haystack left for any later match */
+  }
+  return NULL;
+}
+
 /**
  * mutt_str_skip_whitespace - Find the first non-whitespace character in a string
  * @param p String to search
@@ -0,0 +1,133 @@
+/**
+ * @file
+ * Pool of worker threads for data-parallel jobs
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page mutt_worker Pool of worker threads for data-parallel jobs
+ *
+ * Run a callback over a range of independent work items, spreading the items
+ * across a small pool of threads.  Items are handed out one at a time from a
+ * shared cursor, so uneven item costs still balance across the pool.
+ *
+ * If the platform has no pthreads, or the caller asks for fewer than two
+ * threads, the items are simply processed serially on the calling thread.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
+#include "worker.h"
+#include "logging.h"
+#include "memory.h"
+
+#ifdef HAVE_PTHREAD_CREATE
+/**
+ * struct WorkerJob - Shared state for one mutt_worker_run() invocation
+ */
+struct WorkerJob
+{
+  mutt_worker_fn_t fn; ///< Function to run on each item
+  void *wdata;         ///< Private data for the function
+  size_t count;        ///< Total number of work items
+  size_t next;         ///< Next unclaimed item, protected by #mutex
+  pthread_mutex_t mutex; ///< Protects #next
+};
+
+/**
+ * worker_main - Worker thread entry point
+ * @param arg WorkerJob shared between all threads
+ * @retval NULL Always
+ */
+static void *worker_main(void *arg)
+{
+  struct WorkerJob *job = arg;
+
+  while (true)
+  {
+    pthread_mutex_lock(&job->mutex);
+    const size_t index = job->next++;
+    pthread_mutex_unlock(&job->mutex);
+
+    if (index >= job->count)
+      break;
+
+    job->fn(index, job->wdata);
+  }
+
+  return NULL;
+}
+#endif /* HAVE_PTHREAD_CREATE */
+
+/**
+ * mutt_worker_run - Run a function over every work item, possibly in parallel
+ * @param fn          Function to run on each item
+ * @param wdata       Private data passed to every call of @a fn
+ * @param count       Number of work items
+ * @param num_threads Number of threads to use (0 or 1 means run serially)
+ * @retval num Number of threads actually used
+ *
+ * Blocks until every item has been processed.  The number of threads is
+ * capped at the number of items; extra requested threads are not created.
+ */
+size_t mutt_worker_run(mutt_worker_fn_t fn, void *wdata, size_t count, size_t num_threads)
+{
+  if (!fn || (count == 0))
+    return 0;
+
+#ifdef HAVE_PTHREAD_CREATE
+  if (num_threads > count)
+    num_threads = count;
+
+  if (num_threads > 1)
+  {
+    struct WorkerJob job = { fn, wdata, count, 0, PTHREAD_MUTEX_INITIALIZER };
+    pthread_t *threads = mutt_mem_calloc(num_threads, sizeof(pthread_t));
+    size_t started = 0;
+
+    for (; started < num_threads; started++)
+    {
+      if (pthread_create(&threads[started], NULL, worker_main, &job) != 0)
+      {
+        mutt_debug(LL_DEBUG1, "pthread_create failed after %zu threads\n", started);
+        break;
+      }
+    }
+
+    if (started > 0)
+    {
+      worker_main(&job); // The caller helps out too
+      for (size_t i = 0; i < started; i++)
+        pthread_join(threads[i], NULL);
+      FREE(&threads);
+      return started + 1;
+    }
+    FREE(&threads);
+  }
+#endif /* HAVE_PTHREAD_CREATE */
+
+  for (size_t i = 0; i < count; i++)
+    fn(i, wdata);
+
+  return 1;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file
+ * Pool of worker threads for data-parallel jobs
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MUTT_LIB_WORKER_H
+#define MUTT_LIB_WORKER_H
+
+#include <stddef.h>
+
+/**
+ * typedef mutt_worker_fn_t - Prototype for a function run on each work item
+ * @param index Index of the work item, 0..count-1
+ * @param wdata Private data passed to mutt_worker_run()
+ *
+ * The function will be called exactly once for every index, possibly from
+ * several threads at once.  It must not touch curses or any other
+ * thread-unsafe global state.
+ */
+typedef void (*mutt_worker_fn_t)(size_t index, void *wdata);
+
+size_t mutt_worker_run(mutt_worker_fn_t fn, void *wdata, size_t count, size_t num_threads);
+
+#endif /* MUTT_LIB_WORKER_H */
@@ -212,6 +212,9 @@ static struct ConfigDef MainVars[] = {
   { "browser_abbreviate_mailboxes", DT_BOOL, true, 0, NULL,
     "Abbreviate mailboxes using '~' and '=' in the browser"
   },
+  { "browser_stat_threads", DT_NUMBER|DT_NOT_NEGATIVE, 0, 0, NULL,
+    "Number of threads to stat directory entries in the browser"
+  },
   { "charset", DT_STRING|DT_NOT_EMPTY|DT_CHARSET_SINGLE, 0, 0, charset_validator,
     "Default character set for displaying text on screen"
   },
@@ -221,6 +224,9 @@ static struct ConfigDef MainVars[] = {
   { "collapse_unread", DT_BOOL, true, 0, NULL,
     "Prevent the collapse of threads with unread emails"
   },
+  { "config_cache", DT_PATH, 0, 0, NULL,
+    "Directory for compiled copies of the config files"
+  },
   { "config_charset", DT_STRING, 0, 0, charset_validator,
     "Character set that the config files are in"
   },
@@ -365,6 +371,9 @@ static struct ConfigDef MainVars[] = {
   { "mail_check_stats_interval", DT_NUMBER|DT_NOT_NEGATIVE, 60, 0, NULL,
     "How often to check for new mail"
   },
+  { "mail_check_threads", DT_NUMBER|DT_NOT_NEGATIVE, 0, 0, NULL,
+    "Number of threads to poll mailboxes for new mail"
+  },
   { "mailcap_path", DT_SLIST|SLIST_SEP_COLON, IP "~/.mailcap:" PKGDATADIR "/mailcap:" SYSCONFDIR "/mailcap:/etc/mailcap:/usr/etc/mailcap:/usr/local/etc/mailcap", 0, NULL,
     "List of mailcap files (colon-separated)"
   },
@@ -404,6 +413,11 @@ static struct ConfigDef MainVars[] = {
   { "mime_forward_rest", DT_QUAD, MUTT_YES, 0, NULL,
     "Forward all attachments, even if they can't be decoded"
   },
+#ifdef USE_INOTIFY
+  { "monitor_debounce", DT_NUMBER|DT_NOT_NEGATIVE, 50, 0, NULL,
+    "(ms) Coalesce filesystem events arriving within this window"
+  },
+#endif
   { "move", DT_QUAD, MUTT_NO, 0, NULL,
     "Move emails from `$spool_file` to `$mbox` when read"
   },
@@ -757,6 +771,7 @@ static void init_variables(struct ConfigSet *cs)
 #if defined(USE_AUTOCRYPT)
   CONFIG_INIT_VARS(cs, autocrypt);
 #endif
+  CONFIG_INIT_VARS(cs, bcache);
   CONFIG_INIT_VARS(cs, compose);
   CONFIG_INIT_VARS(cs, conn);
 #if defined(USE_HCACHE)
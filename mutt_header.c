@@ -112,6 +112,7 @@ static bool label_message(struct Mailbox *m, struct Email *e, char *new_label)
 
   e->changed = true;
   e->env->changed |= MUTT_ENV_CHANGED_XLABEL;
+  FREE(&e->display); /* the index line may show the label */
   return true;
 }
 
@@ -38,6 +38,9 @@
 #include "muttlib.h"
 #include "mx.h"
 #include "protos.h"
+#ifdef USE_IMAP
+#include "imap/lib.h"
+#endif
 
 static time_t MailboxTime = 0; ///< last time we started checking for mail
 static time_t MailboxStatsTime = 0; ///< last time we check performed mail_check_stats
@@ -77,6 +80,9 @@ static bool is_same_mailbox(struct Mailbox *m1, struct Mailbox *m2,
  * @param m_check     Mailbox to check
  * @param st_ctx      stat() info for the current Mailbox
  * @param check_stats If true, also count the total, new and flagged messages
+ *
+ * This may run on a worker thread; it only touches m_check and read-only
+ * state, so mailboxes on different Accounts can be checked concurrently.
  */
 static void mailbox_check(struct Mailbox *m_cur, struct Mailbox *m_check,
                           struct stat *st_ctx, bool check_stats)
@@ -140,11 +146,53 @@ static void mailbox_check(struct Mailbox *m_cur, struct Mailbox *m_check,
   }
   else if (c_check_mbox_size && m_cur && mutt_buffer_is_empty(&m_cur->pathbuf))
     m_check->size = (off_t) st.st_size; /* update the size of current folder */
+}
+
+/**
+ * struct MailboxPoll - One mailbox to check in a poll cycle
+ */
+struct MailboxPoll
+{
+  struct Mailbox *mailbox; ///< Mailbox to check
+  bool check_stats;        ///< Also count total, new and flagged messages
+};
+ARRAY_HEAD(MailboxPollArray, struct MailboxPoll);
+
+/**
+ * struct AccountPoll - One Account's share of a poll cycle
+ */
+struct AccountPoll
+{
+  struct MailboxPollArray polls; ///< The Account's visible mailboxes
+};
+ARRAY_HEAD(AccountPollArray, struct AccountPoll);
 
-  if (!m_check->has_new)
-    m_check->notified = false;
-  else if (!m_check->notified)
-    MailboxNotify++;
+/**
+ * struct MailboxPollCtx - Shared state for parallel mailbox polling
+ */
+struct MailboxPollCtx
+{
+  struct Mailbox *m_cur;             ///< Current Mailbox
+  struct stat *st_ctx;               ///< stat() info for the current Mailbox
+  struct AccountPollArray *accounts; ///< One entry per Account to poll
+};
+
+/**
+ * mailbox_poll_worker - Check one Account's mailboxes - Implements ::mutt_worker_fn_t
+ *
+ * The mailboxes of an Account are checked serially, so a backend that shares
+ * state between its mailboxes is never entered from two threads at once.
+ */
+static void mailbox_poll_worker(size_t index, void *wdata)
+{
+  struct MailboxPollCtx *ctx = wdata;
+  struct AccountPoll *ap = ARRAY_GET(ctx->accounts, index);
+
+  struct MailboxPoll *mp = NULL;
+  ARRAY_FOREACH(mp, &ap->polls)
+  {
+    mailbox_check(ctx->m_cur, mp->mailbox, ctx->st_ctx, mp->check_stats);
+  }
 }
 
 /**
@@ -209,21 +257,79 @@ int mutt_mailbox_check(struct Mailbox *m_cur, int force)
     st_ctx.st_ino = 0;
   }
 
-  struct MailboxList ml = STAILQ_HEAD_INITIALIZER(ml);
-  neomutt_mailboxlist_get_all(&ml, NeoMutt, MUTT_MAILBOX_ANY);
-  struct MailboxNode *np = NULL;
-  STAILQ_FOREACH(np, &ml, entries)
+  const short c_mail_check_threads =
+      cs_subset_number(NeoMutt->sub, "mail_check_threads");
+
+  /* Group the visible mailboxes by Account.  Local Accounts are independent
+   * of each other and go to the worker pool; the network backends drive
+   * shared connections and the message window, which aren't safe to touch
+   * from a worker thread, so their Accounts are checked on this thread. */
+  struct AccountPollArray parallel = ARRAY_HEAD_INITIALIZER;
+  struct AccountPollArray serial = ARRAY_HEAD_INITIALIZER;
+  struct Account *a = NULL;
+  TAILQ_FOREACH(a, &NeoMutt->accounts, entries)
   {
-    if (!np->mailbox->visible)
+    struct AccountPoll ap = { ARRAY_HEAD_INITIALIZER };
+    struct MailboxNode *np = NULL;
+    STAILQ_FOREACH(np, &a->mailboxes, entries)
+    {
+      if (!np->mailbox->visible)
+        continue;
+
+      struct MailboxPoll mp = {
+        np->mailbox,
+        check_stats || (!np->mailbox->first_check_stats_done && c_mail_check_stats),
+      };
+      ARRAY_ADD(&ap.polls, mp);
+    }
+    if (ARRAY_EMPTY(&ap.polls))
       continue;
 
-    mailbox_check(m_cur, np->mailbox, &st_ctx,
-                  check_stats || (!np->mailbox->first_check_stats_done && c_mail_check_stats));
-    if (np->mailbox->has_new)
-      MailboxCount++;
-    np->mailbox->first_check_stats_done = true;
+    const bool is_network = (a->type == MUTT_IMAP) || (a->type == MUTT_POP) ||
+                            (a->type == MUTT_NNTP) || (a->type == MUTT_NOTMUCH);
+    ARRAY_ADD(is_network ? &serial : &parallel, ap);
+  }
+
+  struct MailboxPollCtx ctx = { m_cur, &st_ctx, &parallel };
+  mutt_worker_run(mailbox_poll_worker, &ctx, ARRAY_SIZE(&parallel), c_mail_check_threads);
+
+  ctx.accounts = &serial;
+  for (size_t i = 0; i < ARRAY_SIZE(&serial); i++)
+    mailbox_poll_worker(i, &ctx);
+
+#ifdef USE_IMAP
+  /* The IMAP backend queues its STATUS polls; send each Account's batch as
+   * one pipelined round trip and collect the answers before tallying */
+  TAILQ_FOREACH(a, &NeoMutt->accounts, entries)
+  {
+    if (a->type == MUTT_IMAP)
+      imap_flush_queued(a);
+  }
+#endif
+
+  /* The workers don't touch shared state; tally the results here */
+  struct AccountPollArray *groups[] = { &parallel, &serial };
+  for (size_t i = 0; i < mutt_array_size(groups); i++)
+  {
+    struct AccountPoll *ap = NULL;
+    ARRAY_FOREACH(ap, groups[i])
+    {
+      struct MailboxPoll *mp = NULL;
+      ARRAY_FOREACH(mp, &ap->polls)
+      {
+        struct Mailbox *m = mp->mailbox;
+        if (!m->has_new)
+          m->notified = false;
+        else if (!m->notified)
+          MailboxNotify++;
+        if (m->has_new)
+          MailboxCount++;
+        m->first_check_stats_done = true;
+      }
+      ARRAY_FREE(&ap->polls);
+    }
+    ARRAY_FREE(groups[i]);
   }
-  neomutt_mailboxlist_clear(&ml);
 
   return MailboxCount;
 }
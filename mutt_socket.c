@@ -27,8 +27,12 @@
  */
 
 #include "config.h"
+#include <netdb.h>
+#include <netinet/in.h>
+#include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include "mutt/lib.h"
 #include "config/lib.h"
 #include "email/lib.h"
 #include "core/lib.h"
@@ -36,9 +40,6 @@
 #include "mutt_socket.h"
 #include "hook.h"
 #include "mutt_account.h"
-#ifndef USE_SSL
-#include "mutt/lib.h"
-#endif
 
 /**
  * mutt_conn_new - Create a new Connection
@@ -99,3 +100,91 @@ struct Connection *mutt_conn_find(const struct ConnAccount *cac)
 
   return mutt_conn_new(cac);
 }
+
+/**
+ * default_port - Default port for a network service
+ * @param service  Service name, e.g. "imap"
+ * @param fallback Port to use if the service isn't in /etc/services
+ * @retval num Port number
+ */
+static unsigned short default_port(const char *service, unsigned short fallback)
+{
+  struct servent *se = getservbyname(service, "tcp");
+  return se ? ntohs(se->s_port) : fallback;
+}
+
+/**
+ * mutt_conn_preconnect - Connect to all the Accounts' servers in parallel
+ *
+ * Walk the Accounts defined by `mailboxes` and open the TCP leg of every
+ * server connection concurrently, before the first mailbox is opened.  The
+ * serial connection setup later adopts the pre-opened sockets, so several
+ * accounts no longer wait for each other's connects.  `$mail_check_threads`
+ * enables this and sets the number of threads.
+ */
+void mutt_conn_preconnect(void)
+{
+  const short c_mail_check_threads =
+      cs_subset_number(NeoMutt->sub, "mail_check_threads");
+  if (c_mail_check_threads < 2)
+    return;
+
+  struct ConnAccount *cacs = NULL;
+  size_t num = 0;
+
+  struct Account *a = NULL;
+  TAILQ_FOREACH(a, &NeoMutt->accounts, entries)
+  {
+    if ((a->type != MUTT_IMAP) && (a->type != MUTT_POP) && (a->type != MUTT_NNTP))
+      continue;
+
+    struct MailboxNode *np = STAILQ_FIRST(&a->mailboxes);
+    if (!np)
+      continue;
+
+    struct Url *url = url_parse(mailbox_path(np->mailbox));
+    if (!url)
+      continue;
+
+    struct ConnAccount cac = { { 0 } };
+    if ((mutt_account_fromurl(&cac, url) == 0) && (cac.host[0] != '\0'))
+    {
+      if (!(cac.flags & MUTT_ACCT_PORT))
+      {
+        switch (url->scheme)
+        {
+          // clang-format off
+          case U_IMAP:  cac.port = default_port("imap",   143); break;
+          case U_IMAPS: cac.port = default_port("imaps",  993); break;
+          case U_POP:   cac.port = default_port("pop3",   110); break;
+          case U_POPS:  cac.port = default_port("pop3s",  995); break;
+          case U_NNTP:  cac.port = default_port("nntp",   119); break;
+          case U_NNTPS: cac.port = default_port("nntps",  563); break;
+          // clang-format on
+          default:
+            break;
+        }
+      }
+
+      bool dup = false;
+      for (size_t i = 0; i < num; i++)
+      {
+        if ((cacs[i].port == cac.port) && mutt_istr_equal(cacs[i].host, cac.host))
+        {
+          dup = true;
+          break;
+        }
+      }
+      if ((cac.port != 0) && !dup)
+      {
+        mutt_mem_realloc(&cacs, (num + 1) * sizeof(*cacs));
+        cacs[num++] = cac;
+      }
+    }
+    url_free(&url);
+  }
+
+  if (num > 0)
+    mutt_preconn_start(cacs, num, c_mail_check_threads);
+  FREE(&cacs);
+}
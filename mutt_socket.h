@@ -32,6 +32,7 @@ struct ConnAccount;
 
 struct Connection *mutt_conn_find(const struct ConnAccount *account);
 struct Connection *mutt_conn_new(const struct ConnAccount *account);
+void               mutt_conn_preconnect(void);
 
 #define mutt_socket_readln(buf, buflen, conn) mutt_socket_readln_d(buf, buflen, conn, MUTT_SOCK_LOG_CMD)
 #define mutt_socket_send(conn, buf)           mutt_socket_send_d(conn, buf, MUTT_SOCK_LOG_CMD)
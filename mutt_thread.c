@@ -42,6 +42,9 @@
 #include "options.h"
 #include "protos.h"
 #include "sort.h"
+#ifdef USE_HCACHE
+#include "hcache/lib.h"
+#endif
 
 /**
  * struct ThreadsContext - The "current" threading state
@@ -53,6 +56,7 @@ struct ThreadsContext
   struct HashTable *hash;  ///< Hash table for threads
   short c_sort;            ///< Last sort method
   short c_sort_aux;        ///< Last sort_aux method
+  int num_threaded;        ///< Number of messages threaded by the last pass
 };
 
 /**
@@ -88,9 +92,13 @@ struct EnumDef UseThreadsTypeDef = {
  */
 enum UseThreads mutt_thread_style(void)
 {
+  /* called per message in display loops, so cache the config lookups */
+  static struct ConfigCache UseThreadsCache = { 0 };
+  static struct ConfigCache SortCache = { 0 };
+
   const unsigned char c_use_threads =
-      cs_subset_enum(NeoMutt->sub, "use_threads");
-  const short c_sort = cs_subset_sort(NeoMutt->sub, "sort");
+      cs_subset_cached(NeoMutt->sub, "use_threads", &UseThreadsCache);
+  const short c_sort = cs_subset_cached(NeoMutt->sub, "sort", &SortCache);
   if (c_use_threads > UT_FLAT)
     return c_use_threads;
   if ((c_sort & SORT_MASK) != SORT_THREADS)
@@ -234,9 +242,9 @@ static void linearize_tree(struct ThreadsContext *tctx)
  * this calculates whether a node is the root of a subtree that has visible
  * nodes, whether a node itself is visible, whether, if invisible, it has
  * depth anyway, and whether any of its later siblings are roots of visible
- * subtrees.  while it's at it, it frees the old thread display, so we can
- * skip parts of the tree in mutt_draw_tree() if we've decided here that we
- * don't care about them any more.
+ * subtrees.  while it's at it, it frees the thread display of messages that
+ * are no longer visible; visible messages keep theirs so mutt_draw_tree()
+ * can tell whether their part of the tree actually changed.
  */
 static void calculate_visibility(struct MuttThread *tree, int *max_depth)
 {
@@ -268,12 +276,15 @@ static void calculate_visibility(struct MuttThread *tree, int *max_depth)
     tree->subtree_visible = 0;
     if (tree->message)
     {
-      FREE(&tree->message->tree);
+      tree->message->thread_unread = -1; /* visibility affects the rollup */
       if (is_visible(tree->message))
       {
         tree->deep = true;
         tree->visible = true;
+        const bool old_subject = tree->message->display_subject;
         tree->message->display_subject = need_display_subject(tree->message);
+        if (tree->message->display_subject != old_subject)
+          FREE(&tree->message->display); /* the index line may show the subject */
         for (tmp = tree; tmp; tmp = tmp->parent)
         {
           if (tmp->subtree_visible)
@@ -288,6 +299,8 @@ static void calculate_visibility(struct MuttThread *tree, int *max_depth)
       }
       else
       {
+        FREE(&tree->message->tree);
+        FREE(&tree->message->display); /* the index line may show the tree */
         tree->visible = false;
         tree->deep = !c_hide_limited;
       }
@@ -435,9 +448,26 @@ void mutt_draw_tree(struct ThreadsContext *tctx)
         }
         else
           mutt_str_copy(new_tree, arrow, ((size_t) depth * width) + 2);
-        tree->message->tree = new_tree;
+        if (mutt_str_equal(tree->message->tree, new_tree))
+        {
+          /* this part of the tree didn't change shape; keep the old string
+           * and the index line cached for it */
+          FREE(&new_tree);
+        }
+        else
+        {
+          FREE(&tree->message->tree);
+          tree->message->tree = new_tree;
+          FREE(&tree->message->display);
+        }
       }
     }
+    else if (tree->visible && tree->message && tree->message->tree)
+    {
+      /* the message is now at the top level and has no tree prefix */
+      FREE(&tree->message->tree);
+      FREE(&tree->message->display);
+    }
     if (tree->child && (depth != 0))
     {
       mypfx = pfx + (depth - 1) * width;
@@ -727,9 +757,58 @@ void mutt_clear_threads(struct ThreadsContext *tctx)
     e->threaded = false;
   }
   tctx->tree = NULL;
+  tctx->num_threaded = 0;
   mutt_hash_free(&tctx->hash);
 }
 
+/**
+ * mutt_thread_ctx_remove - Detach an Email from the thread tree
+ * @param tctx Threading context
+ * @param e    Email about to leave the mailbox, still valid
+ *
+ * Unhook the message from its MuttThread before it is freed, so that
+ * expunging a few messages doesn't force rethreading the whole mailbox from
+ * scratch.  A node with children stays behind as a "missing message"
+ * container; nodes left empty are unlinked from the tree but kept in the
+ * hash, where a later arrival with the same Message-ID can still revive
+ * them, and are reclaimed by thread_hash_destructor() on the next full
+ * rebuild.
+ */
+void mutt_thread_ctx_remove(struct ThreadsContext *tctx, struct Email *e)
+{
+  if (!tctx || !e)
+    return;
+
+  struct MuttThread *thread = e->thread;
+  e->thread = NULL;
+  e->threaded = false;
+
+  /* if the hash is gone, the nodes have already been freed */
+  if (!thread || !tctx->hash)
+    return;
+
+  /* e may be the key its thread and ancestors sort on; NULL keys make
+   * mutt_sort_subthreads() recompute them on the next pass */
+  for (struct MuttThread *tmp = thread; tmp; tmp = tmp->parent)
+  {
+    if (tmp->sort_thread_key == e)
+      tmp->sort_thread_key = NULL;
+    if (tmp->sort_aux_key == e)
+      tmp->sort_aux_key = NULL;
+  }
+
+  thread->message = NULL;
+
+  while (thread && !thread->message && !thread->child)
+  {
+    struct MuttThread *parent = thread->parent;
+    unlink_message(parent ? &parent->child : &tctx->tree, thread);
+    thread->parent = NULL;
+    thread->fake_thread = false;
+    thread = parent;
+  }
+}
+
 /**
  * compare_threads - qsort_r() function for comparing email threads
  * @param a   First thread to compare
@@ -999,6 +1078,71 @@ static void check_subjects(struct Mailbox *m, bool init)
   }
 }
 
+#ifdef USE_HCACHE
+/// Version of the serialized thread-linkage record; bump when the format changes
+#define THREAD_LINK_VERSION 1
+
+/**
+ * thread_link_fetch - Get a message's cached thread linkage
+ * @param[in]  hc     Header cache
+ * @param[in]  mid    Message-ID of the message
+ * @param[out] pseudo Parent was joined by subject, not by References
+ * @retval ptr Message-ID of the parent, to be freed by the caller
+ * @retval NULL No linkage record for this message
+ */
+static char *thread_link_fetch(struct HeaderCache *hc, const char *mid, bool *pseudo)
+{
+  struct Buffer *key = mutt_buffer_pool_get();
+  mutt_buffer_printf(key, "/thread/%s", mid);
+
+  char *parent = NULL;
+  size_t dlen = 0;
+  char *data = mutt_hcache_fetch_raw(hc, mutt_buffer_string(key),
+                                     mutt_buffer_len(key), &dlen);
+  if (data && (dlen > 2) && (data[0] == THREAD_LINK_VERSION) && (data[dlen - 1] == '\0'))
+  {
+    *pseudo = data[1];
+    parent = mutt_str_dup(data + 2);
+  }
+  mutt_hcache_free_raw(hc, (void **) &data);
+
+  mutt_buffer_pool_release(&key);
+  return parent;
+}
+
+/**
+ * thread_link_store - Save a message's thread linkage
+ * @param hc     Header cache
+ * @param mid    Message-ID of the message
+ * @param parent Message-ID of the parent, or NULL to delete the record
+ * @param pseudo Parent was joined by subject, not by References
+ */
+static void thread_link_store(struct HeaderCache *hc, const char *mid,
+                              const char *parent, bool pseudo)
+{
+  struct Buffer *key = mutt_buffer_pool_get();
+  mutt_buffer_printf(key, "/thread/%s", mid);
+
+  if (parent)
+  {
+    const size_t plen = mutt_str_len(parent);
+    char *data = mutt_mem_malloc(plen + 3);
+    data[0] = THREAD_LINK_VERSION;
+    data[1] = pseudo;
+    memcpy(data + 2, parent, plen + 1);
+    mutt_hcache_store_raw(hc, mutt_buffer_string(key), mutt_buffer_len(key),
+                          data, plen + 3);
+    FREE(&data);
+  }
+  else
+  {
+    mutt_hcache_delete_record(hc, mutt_buffer_string(key), mutt_buffer_len(key));
+  }
+
+  mutt_buffer_pool_release(&key);
+}
+#endif /* USE_HCACHE */
+
 /**
  * mutt_sort_threads - Sort email threads
  * @param tctx Threading context
@@ -1023,10 +1167,30 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
 
   if (init)
   {
-    tctx->hash = mutt_hash_new(m->msg_count * 2, MUTT_HASH_ALLOW_DUPS);
+    tctx->hash = mutt_hash_new(m->msg_count * 2, MUTT_HASH_ALLOW_DUPS | MUTT_HASH_STRDUP_KEYS);
     mutt_hash_set_destructor(tctx->hash, thread_hash_destructor, 0);
   }
 
+#ifdef USE_HCACHE
+  /* On a full rebuild, the linkage saved by the previous session lets most
+   * messages be attached to their parent directly, instead of re-deriving it
+   * from their References */
+  struct HeaderCache *hc = NULL;
+  char **links = NULL;
+  bool *links_pseudo = NULL;
+  if (init)
+  {
+    const char *const c_header_cache =
+        cs_subset_path(NeoMutt->sub, "header_cache");
+    hc = mutt_hcache_open(c_header_cache, mailbox_path(m), NULL);
+    if (hc)
+    {
+      links = mutt_mem_calloc(m->msg_count, sizeof(char *));
+      links_pseudo = mutt_mem_calloc(m->msg_count, sizeof(bool));
+    }
+  }
+#endif
+
   /* we want a quick way to see if things are actually attached to the top of the
    * thread tree or if they're just dangling, so we attach everything to a top
    * node temporarily */
@@ -1038,13 +1202,29 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
   for (thread = tctx->tree; thread; thread = thread->next)
     thread->parent = &top;
 
+  /* With strict threading there are no pseudo-threads to refresh, so the old
+   * messages (all threaded by an earlier pass) can be skipped and only the
+   * new arrivals at the end of the mailbox need to be threaded in.  Without
+   * it, every message must be visited to unlink stale pseudo-threads. */
+  const bool c_strict_threads = cs_subset_bool(NeoMutt->sub, "strict_threads");
+  int first_new = 0;
+  if (!init && c_strict_threads)
+  {
+    first_new = MIN(tctx->num_threaded, m->msg_count);
+    while ((first_new > 0) && m->emails[first_new - 1] &&
+           !m->emails[first_new - 1]->thread)
+    {
+      first_new--;
+    }
+  }
+
   /* put each new message together with the matching messageless MuttThread if it
    * exists.  otherwise, if there is a MuttThread that already has a message, thread
    * new message as an identical child.  if we didn't attach the message to a
    * MuttThread, make a new one for it. */
   const bool c_duplicate_threads =
       cs_subset_bool(NeoMutt->sub, "duplicate_threads");
-  for (i = 0; i < m->msg_count; i++)
+  for (i = first_new; i < m->msg_count; i++)
   {
     e = m->emails[i];
     if (!e)
@@ -1138,7 +1318,7 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
   }
 
   /* thread by references */
-  for (i = 0; i < m->msg_count; i++)
+  for (i = first_new; i < m->msg_count; i++)
   {
     e = m->emails[i];
     if (!e)
@@ -1151,6 +1331,28 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
     thread = e->thread;
     if (!thread)
       continue;
+
+#ifdef USE_HCACHE
+    if (links && e->env->message_id)
+    {
+      links[i] = thread_link_fetch(hc, e->env->message_id, &links_pseudo[i]);
+      const bool usable = links[i] && (!links_pseudo[i] || !c_strict_threads);
+      tnew = usable ? mutt_hash_find(tctx->hash, links[i]) : NULL;
+      if (tnew && tnew->duplicate_thread)
+        tnew = tnew->parent;
+      /* Only take the shortcut if the recorded parent actually exists; a
+       * stale record falls back to the References walk below */
+      if (tnew && tnew->message && !is_descendant(tnew, thread))
+      {
+        if (thread->parent)
+          unlink_message(&top.child, thread);
+        insert_message(&tnew->child, tnew, thread);
+        thread->fake_thread = links_pseudo[i];
+        continue;
+      }
+    }
+#endif
+
     using_refs = 0;
 
     while (true)
@@ -1226,11 +1428,43 @@ void mutt_sort_threads(struct ThreadsContext *tctx, bool init)
   tctx->tree = top.child;
 
   check_subjects(tctx->mailbox, init);
+  tctx->num_threaded = m->msg_count;
 
-  const bool c_strict_threads = cs_subset_bool(NeoMutt->sub, "strict_threads");
   if (!c_strict_threads)
     pseudo_threads(tctx);
 
+#ifdef USE_HCACHE
+  if (links)
+  {
+    /* Save the linkage that changed; reopening an unchanged mailbox writes
+     * nothing.  Messages whose parent is a ghost (a Message-ID we've never
+     * seen a message for) get no record and are re-derived each time. */
+    for (i = 0; i < m->msg_count; i++)
+    {
+      e = m->emails[i];
+      if (!e || !e->thread || e->thread->duplicate_thread || !e->env->message_id)
+        continue;
+
+      const struct MuttThread *parent = e->thread->parent;
+      const char *parent_id = NULL;
+      if (parent && parent->message)
+        parent_id = parent->message->env->message_id;
+
+      const bool pseudo = e->thread->fake_thread;
+      if (!mutt_str_equal(parent_id, links[i]) ||
+          (parent_id && (pseudo != links_pseudo[i])))
+      {
+        thread_link_store(hc, e->env->message_id, parent_id, pseudo);
+      }
+      FREE(&links[i]);
+    }
+    FREE(&links);
+    FREE(&links_pseudo);
+  }
+  if (hc)
+    mutt_hcache_close(hc);
+#endif
+
   /* if $sort_aux or similar changed after the mailbox is sorted, then
    * all the subthreads need to be resorted */
   if (tctx->tree)
@@ -1395,6 +1629,82 @@ off_t mutt_set_vnum(struct Mailbox *m)
   return vsize;
 }
 
+/**
+ * mutt_collapse_vnum - Renumber the virtual index after hiding messages
+ * @param m Mailbox
+ *
+ * Cheaper form of mutt_set_vnum() for when messages have only been hidden,
+ * e.g. after collapsing a thread: the surviving entries are already in the
+ * right order in v2r, so compact it in place.  This is O(vcount) rather than
+ * a sweep over every message in the Mailbox, which matters when a limit is
+ * active and the view is much smaller than the folder.
+ */
+void mutt_collapse_vnum(struct Mailbox *m)
+{
+  if (!m)
+    return;
+
+  int vcount = 0;
+  for (int i = 0; i < m->vcount; i++)
+  {
+    struct Email *e = m->emails[m->v2r[i]];
+    if (!e || (e->vnum < 0))
+      continue;
+
+    m->v2r[vcount] = m->v2r[i];
+    e->vnum = vcount++;
+  }
+  m->vcount = vcount;
+}
+
+/**
+ * mutt_thread_unread - Does the email's thread contain unread mail?
+ * @param e Email in the thread
+ * @retval 0 The thread has no unread mail
+ * @retval 1 The thread contains new mail
+ * @retval 2 The thread contains old unread mail
+ *
+ * A cached version of mutt_thread_contains_unread(), so rendering a
+ * collapsed thread's index line doesn't walk its whole subtree.  The result
+ * is stored on the thread's root Email; it is dropped whenever the threads
+ * are recalculated or a read flag in the thread changes.
+ */
+int mutt_thread_unread(struct Email *e)
+{
+  struct MuttThread *thread = e->thread;
+  if (!thread)
+    return mutt_thread_contains_unread(e);
+
+  while (thread->parent)
+    thread = thread->parent;
+  while (!thread->message)
+    thread = thread->child;
+  struct Email *e_root = thread->message;
+
+  if (e_root->thread_unread < 0)
+    e_root->thread_unread = mutt_thread_contains_unread(e);
+
+  return e_root->thread_unread;
+}
+
+/**
+ * mutt_thread_unread_invalidate - Drop the cached unread state of an email's thread
+ * @param e Email whose read state changed
+ */
+void mutt_thread_unread_invalidate(struct Email *e)
+{
+  struct MuttThread *thread = e->thread;
+  if (!thread)
+    return;
+
+  while (thread->parent)
+    thread = thread->parent;
+  while (thread && !thread->message)
+    thread = thread->child;
+  if (thread && thread->message)
+    thread->message->thread_unread = -1;
+}
+
 /**
  * mutt_traverse_thread - Recurse through an email thread, matching messages
  * @param e_cur Current Email
@@ -1454,6 +1764,8 @@ int mutt_traverse_thread(struct Email *e_cur, MuttThreadFlags flag)
   if (flag & (MUTT_THREAD_COLLAPSE | MUTT_THREAD_UNCOLLAPSE))
   {
     e_cur->attr_color = NULL; /* force index entry's color to be re-evaluated */
+    e_cur->index_color_valid = false;
+    FREE(&e_cur->display);
     e_cur->collapsed = flag & MUTT_THREAD_COLLAPSE;
     if (e_cur->vnum != -1)
     {
@@ -1488,6 +1800,8 @@ int mutt_traverse_thread(struct Email *e_cur, MuttThreadFlags flag)
       if (flag & (MUTT_THREAD_COLLAPSE | MUTT_THREAD_UNCOLLAPSE))
       {
         e_cur->attr_color = NULL; /* force index entry's color to be re-evaluated */
+        e_cur->index_color_valid = false;
+        FREE(&e_cur->display);
         e_cur->collapsed = flag & MUTT_THREAD_COLLAPSE;
         if (!e_root && e_cur->visible)
         {
@@ -1657,7 +1971,7 @@ int mutt_messages_in_thread(struct Mailbox *m, struct Email *e, enum MessageInTh
  */
 struct HashTable *mutt_make_id_hash(struct Mailbox *m)
 {
-  struct HashTable *hash = mutt_hash_new(m->msg_count * 2, MUTT_HASH_NO_FLAGS);
+  struct HashTable *hash = mutt_hash_new(m->msg_count * 2, MUTT_HASH_OPEN_ADDR);
 
   for (int i = 0; i < m->msg_count; i++)
   {
@@ -110,11 +110,13 @@ int mutt_aside_thread(struct Email *e, bool forwards, bool subthreads);
 
 struct ThreadsContext *mutt_thread_ctx_init          (struct Mailbox *m);
 void                   mutt_thread_ctx_free          (struct ThreadsContext **tctx);
+void                   mutt_thread_ctx_remove        (struct ThreadsContext *tctx, struct Email *e);
 void                   mutt_thread_collapse_collapsed(struct ThreadsContext *tctx);
 void                   mutt_thread_collapse          (struct ThreadsContext *tctx, bool collapse);
 bool                   mutt_thread_can_collapse      (struct Email *e);
 
 void                   mutt_clear_threads     (struct ThreadsContext *tctx);
+void                   mutt_collapse_vnum     (struct Mailbox *m);
 void                   mutt_draw_tree         (struct ThreadsContext *tctx);
 bool                   mutt_link_threads      (struct Email *parent, struct EmailList *children, struct Mailbox *m);
 struct HashTable *     mutt_make_id_hash      (struct Mailbox *m);
@@ -122,5 +124,7 @@ int                    mutt_messages_in_thread(struct Mailbox *m, struct Email *
 int                    mutt_parent_message    (struct Email *e, bool find_root);
 off_t                  mutt_set_vnum          (struct Mailbox *m);
 void                   mutt_sort_threads      (struct ThreadsContext *tctx, bool init);
+int                    mutt_thread_unread     (struct Email *e);
+void                   mutt_thread_unread_invalidate(struct Email *e);
 
 #endif /* MUTT_MUTT_THREAD_H */
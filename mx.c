@@ -33,6 +33,9 @@
 #include <errno.h>
 #include <limits.h>
 #include <locale.h>
+#ifdef HAVE_PTHREAD_CREATE
+#include <pthread.h>
+#endif
 #include <stdbool.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -78,6 +81,12 @@
 #ifdef USE_NOTMUCH
 #include "notmuch/lib.h"
 #endif
+#ifdef USE_AUTOCRYPT
+#include "autocrypt/lib.h"
+#endif
+#ifdef USE_DEBUG_TIMING
+#include "debug/lib.h"
+#endif
 #ifdef ENABLE_NLS
 #include <libintl.h>
 #endif
@@ -300,6 +309,16 @@ bool mx_mbox_ac_link(struct Mailbox *m)
  * @param flags Flags, see #OpenMailboxFlags
  * @retval true Success
  * @retval false Error
+ *
+ * @note This call is synchronous: the caller (and hence the index) doesn't see
+ *       the Mailbox until every message has been parsed.  A progressive open,
+ *       displaying the first screen while parsing continues, isn't feasible
+ *       here: the default sorts (date, threads) need every header before the
+ *       first screen's contents are even known, and nothing pumps the display
+ *       until the index dialog takes over.  Instead, the backends keep the
+ *       blocking phase short: maildir parses headers on worker threads and
+ *       batch-fetches the header cache, mbox reads via mmap and reuses its
+ *       sidecar offset index on reopen.
  */
 bool mx_mbox_open(struct Mailbox *m, OpenMailboxFlags flags)
 {
@@ -337,6 +356,7 @@ bool mx_mbox_open(struct Mailbox *m, OpenMailboxFlags flags)
   if (m->opened > 0)
   {
     m->opened++;
+    m->visits++;
     return true;
   }
 
@@ -385,8 +405,23 @@ bool mx_mbox_open(struct Mailbox *m, OpenMailboxFlags flags)
   m->msg_tagged = 0;
   m->vcount = 0;
 
+#ifdef USE_DEBUG_TIMING
+  timing_start("mbox_open");
+#endif
+#ifdef USE_AUTOCRYPT
+  /* Group the Autocrypt peer updates from header parsing into one transaction */
+  mutt_autocrypt_batch_begin();
+#endif
   enum MxOpenReturns rc = m->mx_ops->mbox_open(m);
+#ifdef USE_AUTOCRYPT
+  mutt_autocrypt_batch_end();
+#endif
+#ifdef USE_DEBUG_TIMING
+  timing_stop("mbox_open");
+  timing_add("mbox_open_msgs", m->msg_count);
+#endif
   m->opened++;
+  m->visits++;
 
   if ((rc == MX_OPEN_OK) || (rc == MX_OPEN_ABORT))
   {
@@ -436,6 +471,10 @@ void mx_fastclose_mailbox(struct Mailbox *m, bool keep_account)
   if (m->opened != 0)
     return;
 
+#ifdef USE_DEBUG_TIMING
+  timing_dump(mailbox_path(m));
+#endif
+
   /* never announce that a mailbox we've just left has new mail.
    * TODO: really belongs in mx_mbox_close, but this is a nice hook point */
   if (!m->peekonly)
@@ -1130,7 +1169,13 @@ enum MxStatus mx_mbox_check(struct Mailbox *m)
   if (!m || !m->mx_ops)
     return MX_STATUS_ERROR;
 
+#ifdef USE_AUTOCRYPT
+  mutt_autocrypt_batch_begin();
+#endif
   enum MxStatus rc = m->mx_ops->mbox_check(m);
+#ifdef USE_AUTOCRYPT
+  mutt_autocrypt_batch_end();
+#endif
   if ((rc == MX_STATUS_NEW_MAIL) || (rc == MX_STATUS_REOPENED))
   {
     mailbox_changed(m, NT_MAILBOX_INVALID);
@@ -1321,10 +1366,54 @@ bool mx_tags_is_supported(struct Mailbox *m)
   return m && m->mx_ops->tags_commit && m->mx_ops->tags_edit;
 }
 
+/**
+ * struct ProbeResult - Cached verdict of mx_path_probe()
+ */
+struct ProbeResult
+{
+  time_t mtime;          ///< Modification time of the path when it was probed
+  enum MailboxType type; ///< Type the probe found
+};
+
+/// Cache of probe results, keyed by path - Lazily created by mx_path_probe()
+static struct HashTable *ProbeCache = NULL;
+
+#ifdef HAVE_PTHREAD_CREATE
+/// The mailbox poll worker threads probe paths concurrently
+static pthread_mutex_t ProbeCacheMutex = PTHREAD_MUTEX_INITIALIZER;
+#define probe_cache_lock() pthread_mutex_lock(&ProbeCacheMutex)
+#define probe_cache_unlock() pthread_mutex_unlock(&ProbeCacheMutex)
+#else
+#define probe_cache_lock()
+#define probe_cache_unlock()
+#endif
+
+/**
+ * probe_result_free - Free a cached probe result - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void probe_result_free(int type, void *obj, intptr_t data)
+{
+  FREE(&obj);
+}
+
+/**
+ * mx_cleanup - Free the probe result cache
+ */
+void mx_cleanup(void)
+{
+  probe_cache_lock();
+  mutt_hash_free(&ProbeCache);
+  probe_cache_unlock();
+}
+
 /**
  * mx_path_probe - Find a mailbox that understands a path
  * @param path Path to examine
  * @retval num Type, e.g. #MUTT_IMAP
+ *
+ * The local probes aren't free: the mbox probe opens the file and the maildir
+ * probe stats its subdirectories.  The folder browser probes thousands of
+ * entries, so their verdicts are cached until the path changes on disk.
  */
 enum MailboxType mx_path_probe(const char *path)
 {
@@ -1334,6 +1423,7 @@ enum MailboxType mx_path_probe(const char *path)
   enum MailboxType rc = MUTT_UNKNOWN;
 
   // First, search the non-local Mailbox types (is_local == false)
+  // These probes only inspect the path string, so they're not worth caching
   for (const struct MxOps **ops = MxOps; *ops; ops++)
   {
     if ((*ops)->is_local)
@@ -1356,6 +1446,22 @@ enum MailboxType mx_path_probe(const char *path)
     return MUTT_UNKNOWN;
   }
 
+  probe_cache_lock();
+  if (!ProbeCache)
+  {
+    ProbeCache = mutt_hash_new(256, MUTT_HASH_OPEN_ADDR | MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(ProbeCache, probe_result_free, 0);
+  }
+
+  struct ProbeResult *pr = mutt_hash_find(ProbeCache, path);
+  if (pr && (pr->mtime == st.st_mtime))
+  {
+    rc = pr->type;
+    probe_cache_unlock();
+    return rc;
+  }
+  probe_cache_unlock();
+
   // Next, search the local Mailbox types (is_local == true)
   for (const struct MxOps **ops = MxOps; *ops; ops++)
   {
@@ -1363,8 +1469,26 @@ enum MailboxType mx_path_probe(const char *path)
       continue;
     rc = (*ops)->path_probe(path, &st);
     if (rc != MUTT_UNKNOWN)
-      return rc;
+      break;
+  }
+
+  /* The probes run unlocked, so another thread may have inserted the path
+   * in the meantime - look it up again */
+  probe_cache_lock();
+  pr = ProbeCache ? mutt_hash_find(ProbeCache, path) : NULL;
+  if (pr)
+  {
+    pr->mtime = st.st_mtime;
+    pr->type = rc;
+  }
+  else if (ProbeCache)
+  {
+    pr = mutt_mem_calloc(1, sizeof(*pr));
+    pr->mtime = st.st_mtime;
+    pr->type = rc;
+    mutt_hash_insert(ProbeCache, path, pr);
   }
+  probe_cache_unlock();
 
   return rc;
 }
@@ -608,6 +608,84 @@ SecurityFlags mutt_is_application_pgp(struct Body *b)
   return t;
 }
 
+/**
+ * scan_pgp_markers - Look for armour markers in a block of text
+ * @param[in]  data Text to scan (need not be NUL-terminated)
+ * @param[in]  len  Length of the text
+ * @param[in]  bol  true if data[0] sits at the beginning of a line
+ * @param[out] enc  Armour line for an encrypted message was found
+ * @param[out] sgn  Armour line for a clearsigned message was found
+ * @param[out] key  Armour line for a public key block was found
+ *
+ * The markers are only recognised at the start of a line, matching the
+ * line-oriented scan this replaces.
+ */
+static void scan_pgp_markers(const char *data, size_t len, bool bol, bool *enc,
+                             bool *sgn, bool *key)
+{
+  static const char marker[] = "-----BEGIN PGP ";
+  const size_t mlen = sizeof(marker) - 1;
+
+  for (size_t i = 0; (i + mlen) < len; i++)
+  {
+    if ((i == 0) ? !bol : (data[i - 1] != '\n'))
+      continue;
+    if (memcmp(data + i, marker, mlen) != 0)
+      continue;
+
+    const char *rest = data + i + mlen;
+    const size_t rlen = len - i - mlen;
+    if ((rlen >= 13) && (memcmp(rest, "MESSAGE-----\n", 13) == 0))
+      *enc = true;
+    else if ((rlen >= 20) && (memcmp(rest, "SIGNED MESSAGE-----\n", 20) == 0))
+      *sgn = true;
+    else if ((rlen >= 22) && (memcmp(rest, "PUBLIC KEY BLOCK-----\n", 22) == 0))
+      *key = true;
+  }
+}
+
+/**
+ * mutt_pgp_find_inline_markers - Look for inline PGP armour markers in a file
+ * @param[in]  fp  File to scan
+ * @param[out] enc Armour line for an encrypted message was found
+ * @param[out] sgn Armour line for a clearsigned message was found
+ * @param[out] key Armour line for a public key block was found
+ * @retval true Any marker was found
+ *
+ * Only the first and last 4KiB of the file are examined.  The "BEGIN" armour
+ * lines sit at the very top of an inline PGP part (or, for a trailing key
+ * block or signature, near the bottom), so reading the middle of a large
+ * message adds latency without ever finding anything new.
+ */
+bool mutt_pgp_find_inline_markers(FILE *fp, bool *enc, bool *sgn, bool *key)
+{
+  char buf[4096];
+
+  *enc = false;
+  *sgn = false;
+  *key = false;
+
+  if (fseek(fp, 0, SEEK_END) != 0)
+    return false;
+  const long size = ftell(fp);
+  if ((size < 0) || (fseek(fp, 0, SEEK_SET) != 0))
+    return false;
+
+  size_t len = fread(buf, 1, sizeof(buf), fp);
+  scan_pgp_markers(buf, len, true, enc, sgn, key);
+
+  if ((size_t) size > sizeof(buf))
+  {
+    if (fseek(fp, size - (long) sizeof(buf), SEEK_SET) == 0)
+    {
+      len = fread(buf, 1, sizeof(buf), fp);
+      scan_pgp_markers(buf, len, false, enc, sgn, key);
+    }
+  }
+
+  return *enc || *sgn || *key;
+}
+
 /**
  * mutt_is_application_smime - Does the message use S/MIME?
  * @param b Body of email
@@ -1095,6 +1173,166 @@ static void crypt_fetch_signatures(struct Body ***signatures, struct Body *a, in
   }
 }
 
+/**
+ * struct VerifyResult - Cached outcome of one signature verification
+ */
+struct VerifyResult
+{
+  int rc;       ///< Return code of the verify function
+  char *output; ///< Text the backend wrote to the display State
+};
+
+/// Verification results, keyed by a digest of signature and signed data
+static struct HashTable *VerifyCache = NULL;
+
+/**
+ * verify_result_free - Free a cached verification result - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void verify_result_free(int type, void *obj, intptr_t data)
+{
+  struct VerifyResult *vr = obj;
+  FREE(&vr->output);
+  FREE(&vr);
+}
+
+/**
+ * crypt_verify_cache_cleanup - Free the verification result cache
+ */
+void crypt_verify_cache_cleanup(void)
+{
+  mutt_hash_free(&VerifyCache);
+}
+
+/**
+ * verify_cache_key - Build the cache key for one signature
+ * @param sigbdy   Signature to check
+ * @param s        State, for the message stream
+ * @param tempfile File holding the signed data
+ * @param key      Buffer for the key
+ * @retval true Key was built
+ *
+ * The key is a digest of the signed data and the signature bytes, so it is
+ * stable across reopening the mailbox and never outlives a change to either.
+ */
+static bool verify_cache_key(struct Body *sigbdy, struct State *s,
+                             const char *tempfile, struct Buffer *key)
+{
+  if (!s->fp_in)
+    return false;
+
+  FILE *fp = mutt_file_fopen(tempfile, "r");
+  if (!fp)
+    return false;
+
+  struct Md5Ctx ctx;
+  mutt_md5_init_ctx(&ctx);
+
+  char chunk[4096];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), fp)) > 0)
+    mutt_md5_process_bytes(chunk, n, &ctx);
+  mutt_file_fclose(&fp);
+
+  const LOFF_T pos = ftello(s->fp_in);
+  bool ok = (fseeko(s->fp_in, sigbdy->offset, SEEK_SET) == 0);
+  LOFF_T remaining = ok ? sigbdy->length : 0;
+  while (remaining > 0)
+  {
+    const size_t want = MIN(sizeof(chunk), (size_t) remaining);
+    n = fread(chunk, 1, want, s->fp_in);
+    if (n == 0)
+      break;
+    mutt_md5_process_bytes(chunk, n, &ctx);
+    remaining -= n;
+  }
+  fseeko(s->fp_in, pos, SEEK_SET);
+
+  unsigned char digest[16];
+  mutt_md5_finish_ctx(&ctx, digest);
+  char asc[33];
+  mutt_md5_toascii(digest, asc);
+  mutt_buffer_strcpy(key, asc);
+  return ok;
+}
+
+/**
+ * crypt_verify_cached - Verify one signature, reusing an earlier verdict
+ * @param smime    If true, use the S/MIME backend, else PGP
+ * @param sigbdy   Signature to check
+ * @param s        State to write to
+ * @param tempfile File holding the signed data
+ * @retval 0 Success, see crypt_pgp_verify_one()
+ *
+ * The classic backends fork gpg/openssl for every signature and every
+ * display of the message repeats it.  Remember the verdict and the text the
+ * backend printed, and replay both when the same content is shown again.
+ */
+static int crypt_verify_cached(bool smime, struct Body *sigbdy,
+                               struct State *s, const char *tempfile)
+{
+  struct Buffer *key = mutt_buffer_pool_get();
+  int rc;
+
+  /* with a quoting prefix the stored text wouldn't match; don't cache */
+  if (s->prefix || !verify_cache_key(sigbdy, s, tempfile, key))
+  {
+    mutt_buffer_pool_release(&key);
+    return smime ? crypt_smime_verify_one(sigbdy, s, tempfile) :
+                   crypt_pgp_verify_one(sigbdy, s, tempfile);
+  }
+  mutt_buffer_add_printf(key, "-%c", smime ? 's' : 'p');
+
+  if (!VerifyCache)
+  {
+    VerifyCache = mutt_hash_new(64, MUTT_HASH_STRDUP_KEYS);
+    mutt_hash_set_destructor(VerifyCache, verify_result_free, 0);
+  }
+
+  struct VerifyResult *vr = mutt_hash_find(VerifyCache, mutt_buffer_string(key));
+  if (vr)
+  {
+    state_puts(s, vr->output);
+    mutt_buffer_pool_release(&key);
+    return vr->rc;
+  }
+
+  /* capture the backend's output so it can be replayed later */
+  FILE *fp_cap = mutt_file_mkstemp();
+  if (!fp_cap)
+  {
+    mutt_buffer_pool_release(&key);
+    return smime ? crypt_smime_verify_one(sigbdy, s, tempfile) :
+                   crypt_pgp_verify_one(sigbdy, s, tempfile);
+  }
+
+  struct State s_cap = *s;
+  s_cap.fp_out = fp_cap;
+  rc = smime ? crypt_smime_verify_one(sigbdy, &s_cap, tempfile) :
+               crypt_pgp_verify_one(sigbdy, &s_cap, tempfile);
+
+  struct Buffer *output = mutt_buffer_pool_get();
+  rewind(fp_cap);
+  char chunk[4096];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk) - 1, fp_cap)) > 0)
+  {
+    chunk[n] = '\0';
+    mutt_buffer_addstr(output, chunk);
+  }
+  mutt_file_fclose(&fp_cap);
+
+  state_puts(s, mutt_buffer_string(output));
+
+  vr = mutt_mem_calloc(1, sizeof(*vr));
+  vr->rc = rc;
+  vr->output = mutt_str_dup(mutt_buffer_string(output));
+  mutt_hash_insert(VerifyCache, mutt_buffer_string(key), vr);
+
+  mutt_buffer_pool_release(&output);
+  mutt_buffer_pool_release(&key);
+  return rc;
+}
+
 /**
  * mutt_should_hide_protected_subject - Should NeoMutt hide the protected subject?
  * @param e Email to test
@@ -1227,7 +1465,7 @@ int mutt_signed_handler(struct Body *b, struct State *s)
               (signatures[i]->type == TYPE_APPLICATION) &&
               mutt_istr_equal(signatures[i]->subtype, "pgp-signature"))
           {
-            if (crypt_pgp_verify_one(signatures[i], s, mutt_buffer_string(tempfile)) != 0)
+            if (crypt_verify_cached(false, signatures[i], s, mutt_buffer_string(tempfile)) != 0)
               goodsig = false;
 
             continue;
@@ -1238,7 +1476,7 @@ int mutt_signed_handler(struct Body *b, struct State *s)
               (mutt_istr_equal(signatures[i]->subtype, "x-pkcs7-signature") ||
                mutt_istr_equal(signatures[i]->subtype, "pkcs7-signature")))
           {
-            if (crypt_smime_verify_one(signatures[i], s, mutt_buffer_string(tempfile)) != 0)
+            if (crypt_verify_cached(true, signatures[i], s, mutt_buffer_string(tempfile)) != 0)
               goodsig = false;
 
             continue;
@@ -33,6 +33,7 @@ void        crypt_convert_to_7bit(struct Body *a);
 void        crypt_current_time(struct State *s, const char *app_name);
 const char *crypt_get_fingerprint_or_id(const char *p, const char **pphint, const char **ppl, const char **pps);
 bool        crypt_is_numerical_keyid(const char *s);
+void        crypt_verify_cache_cleanup(void);
 int         crypt_write_signed(struct Body *a, struct State *s, const char *tempfile);
 
 #endif /* MUTT_NCRYPT_CRYPT_H */
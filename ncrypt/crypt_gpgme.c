@@ -95,6 +95,225 @@ static struct CryptCache *id_defaults = NULL;
 static gpgme_key_t signature_key = NULL;
 static char *current_sender = NULL;
 
+/// How long a cached key lookup stays valid, in seconds
+#define KEY_CACHE_TTL (5 * 60)
+/// How long a cached verification result stays valid, in seconds
+#define VERIFY_CACHE_TTL (10 * 60)
+/// Maximum number of cached verification results
+#define VERIFY_CACHE_MAX 64
+
+/**
+ * struct KeyCache - One cached gpgme key lookup
+ *
+ * gpgme_get_key() round-trips to gpg-agent / gpgsm for every call.  The cache
+ * holds one reference per key; the TTL keeps revocations and keyring edits
+ * from going unnoticed for too long.
+ */
+struct KeyCache
+{
+  char *pattern;         ///< Fingerprint or key id the key was fetched with
+  bool secret;           ///< The lookup was for a secret key
+  bool is_smime;         ///< The lookup used the CMS protocol
+  gpgme_key_t key;       ///< The key; the cache owns one reference
+  time_t created;        ///< When the entry was added
+  struct KeyCache *next;
+};
+
+static struct KeyCache *key_cache = NULL;
+
+/**
+ * struct VerifyCache - One cached signature verification
+ *
+ * Re-opening a signed message re-runs the whole gpg verification.  The result
+ * code and the rendered signature information are remembered, keyed by a
+ * digest of the signature and the signed data, so the same message verifies
+ * instantly until the TTL expires.
+ */
+struct VerifyCache
+{
+  unsigned char digest[16]; ///< MD5 of the signature and the signed data
+  bool is_smime;            ///< Verification used the CMS protocol
+  bool display;             ///< Output was rendered with MUTT_DISPLAY set
+  int rc;                   ///< Result of verify_one()
+  char *text;               ///< Captured signature information output
+  size_t textlen;           ///< Length of the captured output
+  char *fpr;                ///< Signer fingerprint, to refresh signature_key
+  time_t created;           ///< When the entry was added
+  struct VerifyCache *next;
+};
+
+static struct VerifyCache *verify_cache = NULL;
+static int verify_cache_len = 0;
+
+/**
+ * cached_gpgme_get_key - Look up a key, consulting the key cache first
+ * @param[in]  ctx     GPGME handle
+ * @param[in]  pattern Fingerprint or key id
+ * @param[out] key     Matching key
+ * @param[in]  secret  Only match secret keys
+ * @retval num GPGME error code, e.g. GPG_ERR_NO_ERROR
+ *
+ * Drop-in for gpgme_get_key(); the caller owns a reference as usual.
+ * Expired entries are discarded along the way; failed lookups aren't cached.
+ */
+static gpgme_error_t cached_gpgme_get_key(gpgme_ctx_t ctx, const char *pattern,
+                                          gpgme_key_t *key, int secret)
+{
+  const bool is_smime = (gpgme_get_protocol(ctx) == GPGME_PROTOCOL_CMS);
+  const time_t now = mutt_date_epoch();
+
+  for (struct KeyCache **kp = &key_cache; *kp;)
+  {
+    struct KeyCache *kc = *kp;
+    if ((now - kc->created) > KEY_CACHE_TTL)
+    {
+      *kp = kc->next;
+      gpgme_key_unref(kc->key);
+      FREE(&kc->pattern);
+      FREE(&kc);
+      continue;
+    }
+    if ((kc->secret == (secret != 0)) && (kc->is_smime == is_smime) &&
+        mutt_str_equal(kc->pattern, pattern))
+    {
+      gpgme_key_ref(kc->key);
+      *key = kc->key;
+      return GPG_ERR_NO_ERROR;
+    }
+    kp = &kc->next;
+  }
+
+  gpgme_error_t err = gpgme_get_key(ctx, pattern, key, secret);
+  if (err == 0)
+  {
+    struct KeyCache *kc = mutt_mem_calloc(1, sizeof(struct KeyCache));
+    kc->pattern = mutt_str_dup(pattern);
+    kc->secret = (secret != 0);
+    kc->is_smime = is_smime;
+    kc->key = *key;
+    gpgme_key_ref(kc->key);
+    kc->created = now;
+    kc->next = key_cache;
+    key_cache = kc;
+  }
+  return err;
+}
+
+/**
+ * verify_cache_digest - Hash a message's signature and signed data
+ * @param[in]  sigbdy   Mime part containing signature
+ * @param[in]  s        State to read the signature from
+ * @param[in]  tempfile File holding the signed data
+ * @param[out] digest   Resulting MD5 digest
+ * @retval true Both parts were read and hashed
+ */
+static bool verify_cache_digest(struct Body *sigbdy, struct State *s,
+                                const char *tempfile, unsigned char digest[16])
+{
+  char buf[8192];
+  struct Md5Ctx md5ctx = { 0 };
+
+  mutt_md5_init_ctx(&md5ctx);
+
+  if (!mutt_file_seek(s->fp_in, sigbdy->offset, SEEK_SET))
+    return false;
+  for (long remaining = sigbdy->length; remaining > 0;)
+  {
+    const size_t n = fread(buf, 1, MIN((long) sizeof(buf), remaining), s->fp_in);
+    if (n == 0)
+      return false;
+    mutt_md5_process_bytes(buf, n, &md5ctx);
+    remaining -= n;
+  }
+
+  FILE *fp = mutt_file_fopen(tempfile, "r");
+  if (!fp)
+    return false;
+  size_t n;
+  while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+    mutt_md5_process_bytes(buf, n, &md5ctx);
+  mutt_file_fclose(&fp);
+
+  mutt_md5_finish_ctx(&md5ctx, digest);
+  return true;
+}
+
+/**
+ * verify_cache_find - Find a fresh cached verification result
+ * @param digest   MD5 of the signature and the signed data
+ * @param is_smime Verification uses the CMS protocol
+ * @param display  Output will be rendered with MUTT_DISPLAY set
+ * @retval ptr  Matching entry
+ * @retval NULL No fresh entry exists
+ */
+static struct VerifyCache *verify_cache_find(const unsigned char digest[16],
+                                             bool is_smime, bool display)
+{
+  const time_t now = mutt_date_epoch();
+
+  for (struct VerifyCache **vp = &verify_cache; *vp;)
+  {
+    struct VerifyCache *vc = *vp;
+    if ((now - vc->created) > VERIFY_CACHE_TTL)
+    {
+      *vp = vc->next;
+      FREE(&vc->text);
+      FREE(&vc->fpr);
+      FREE(&vc);
+      verify_cache_len--;
+      continue;
+    }
+    if ((vc->is_smime == is_smime) && (vc->display == display) &&
+        (memcmp(vc->digest, digest, sizeof(vc->digest)) == 0))
+    {
+      return vc;
+    }
+    vp = &vc->next;
+  }
+  return NULL;
+}
+
+/**
+ * verify_cache_store - Remember a verification result
+ * @param digest   MD5 of the signature and the signed data
+ * @param is_smime Verification used the CMS protocol
+ * @param display  Output was rendered with MUTT_DISPLAY set
+ * @param rc       Result of verify_one()
+ * @param text     Captured signature information (ownership is transferred)
+ * @param textlen  Length of the captured output
+ * @param fpr      Signer fingerprint, or NULL
+ *
+ * When the cache is full, the oldest entry makes room.
+ */
+static void verify_cache_store(const unsigned char digest[16], bool is_smime,
+                               bool display, int rc, char *text, size_t textlen,
+                               const char *fpr)
+{
+  if (verify_cache_len >= VERIFY_CACHE_MAX)
+  {
+    struct VerifyCache **vp = &verify_cache;
+    while ((*vp)->next)
+      vp = &(*vp)->next;
+    FREE(&(*vp)->text);
+    FREE(&(*vp)->fpr);
+    FREE(vp);
+    verify_cache_len--;
+  }
+
+  struct VerifyCache *vc = mutt_mem_calloc(1, sizeof(struct VerifyCache));
+  memcpy(vc->digest, digest, sizeof(vc->digest));
+  vc->is_smime = is_smime;
+  vc->display = display;
+  vc->rc = rc;
+  vc->text = text;
+  vc->textlen = textlen;
+  vc->fpr = mutt_str_dup(fpr);
+  vc->created = mutt_date_epoch();
+  vc->next = verify_cache;
+  verify_cache = vc;
+  verify_cache_len++;
+}
+
 #define PKA_NOTATION_NAME "pka-address@gnupg.org"
 
 #define _LINE_COMPARE(_x, _y) line_compare(_x, sizeof(_x) - 1, _y)
@@ -1815,7 +2034,7 @@ static int show_one_sig_status(gpgme_ctx_t ctx, int idx, struct State *s)
 
     if (gpg_err_code(sig->status) != GPG_ERR_NO_PUBKEY)
     {
-      err = gpgme_get_key(ctx, fpr, &key, 0); /* secret key?  */
+      err = cached_gpgme_get_key(ctx, fpr, &key, 0); /* secret key?  */
       if (err == 0)
       {
         if (!signature_key)
@@ -1889,7 +2108,7 @@ static int show_one_sig_status(gpgme_ctx_t ctx, int idx, struct State *s)
 }
 
 /**
- * verify_one - Do the actual verification step
+ * verify_one_real - Do the actual verification step
  * @param sigbdy   Mime part containing signature
  * @param s        State to read from
  * @param tempfile Temporary file to read
@@ -1901,7 +2120,8 @@ static int show_one_sig_status(gpgme_ctx_t ctx, int idx, struct State *s)
  *
  * With is_smime set to true we assume S/MIME.
  */
-static int verify_one(struct Body *sigbdy, struct State *s, const char *tempfile, bool is_smime)
+static int verify_one_real(struct Body *sigbdy, struct State *s,
+                           const char *tempfile, bool is_smime)
 {
   int badsig = -1;
   int anywarn = 0;
@@ -2023,6 +2243,88 @@ static int verify_one(struct Body *sigbdy, struct State *s, const char *tempfile
   return badsig ? 1 : anywarn ? 2 : 0;
 }
 
+/**
+ * verify_one - Verify a signature, using the verification cache
+ * @param sigbdy   Mime part containing signature
+ * @param s        State to read from
+ * @param tempfile Temporary file to read
+ * @param is_smime Is the key S/MIME?
+ * @retval  0 Success
+ * @retval  1 Bad signature
+ * @retval  2 Warnings
+ * @retval -1 Error
+ *
+ * A fresh cached result replays the captured signature information instead of
+ * running gpg again.  On a miss the real verification renders into a capture
+ * file, which is then copied out and remembered.
+ */
+static int verify_one(struct Body *sigbdy, struct State *s, const char *tempfile, bool is_smime)
+{
+  unsigned char digest[16];
+  const bool display = (s->flags & MUTT_DISPLAY);
+
+  /* the captured output has no line prefixes; don't mix the two */
+  if (s->prefix || !verify_cache_digest(sigbdy, s, tempfile, digest))
+    return verify_one_real(sigbdy, s, tempfile, is_smime);
+
+  struct VerifyCache *vc = verify_cache_find(digest, is_smime, display);
+  if (vc)
+  {
+    mutt_debug(LL_DEBUG2, "replaying cached verification, rc %d\n", vc->rc);
+    if (vc->text)
+      fwrite(vc->text, 1, vc->textlen, s->fp_out);
+    if (signature_key)
+    {
+      gpgme_key_unref(signature_key);
+      signature_key = NULL;
+    }
+    if (vc->fpr)
+    {
+      gpgme_ctx_t ctx = create_gpgme_context(is_smime);
+      gpgme_key_t key = NULL;
+      if (cached_gpgme_get_key(ctx, vc->fpr, &key, 0) == 0)
+        signature_key = key;
+      gpgme_release(ctx);
+    }
+    return vc->rc;
+  }
+
+  FILE *fp_text = mutt_file_mkstemp();
+  if (!fp_text)
+    return verify_one_real(sigbdy, s, tempfile, is_smime);
+
+  struct State cs = *s;
+  cs.fp_out = fp_text;
+  const int rc = verify_one_real(sigbdy, &cs, tempfile, is_smime);
+
+  char *text = NULL;
+  fflush(fp_text);
+  const LOFF_T textlen = ftello(fp_text);
+  if (textlen > 0)
+  {
+    rewind(fp_text);
+    text = mutt_mem_malloc(textlen);
+    if (fread(text, 1, textlen, fp_text) != (size_t) textlen)
+      FREE(&text);
+  }
+  mutt_file_fclose(&fp_text);
+
+  if (text)
+    fwrite(text, 1, textlen, s->fp_out);
+
+  if (rc >= 0)
+  {
+    const char *fpr = NULL;
+    if (signature_key && signature_key->subkeys)
+      fpr = signature_key->subkeys->fpr;
+    verify_cache_store(digest, is_smime, display, rc, text, (text ? textlen : 0), fpr);
+  }
+  else
+    FREE(&text);
+
+  return rc;
+}
+
 /**
  * pgp_gpgme_verify_one - Implements CryptModuleSpecs::verify_one() - @ingroup crypto_verify_one
  */
@@ -2581,11 +2883,11 @@ static int line_compare(const char *a, size_t n, const char *b)
  */
 static int pgp_check_traditional_one_body(FILE *fp, struct Body *b)
 {
-  char buf[8192];
   bool rc = false;
 
   bool sgn = false;
   bool enc = false;
+  bool key = false;
 
   if (b->type != TYPE_TEXT)
     return 0;
@@ -2606,23 +2908,7 @@ static int pgp_check_traditional_one_body(FILE *fp, struct Body *b)
     goto cleanup;
   }
 
-  while (fgets(buf, sizeof(buf), fp_tmp))
-  {
-    size_t plen = mutt_str_startswith(buf, "-----BEGIN PGP ");
-    if (plen != 0)
-    {
-      if (MESSAGE(buf + plen))
-      {
-        enc = true;
-        break;
-      }
-      else if (SIGNED_MESSAGE(buf + plen))
-      {
-        sgn = true;
-        break;
-      }
-    }
-  }
+  mutt_pgp_find_inline_markers(fp_tmp, &enc, &sgn, &key);
   mutt_file_fclose(&fp_tmp);
   unlink(mutt_buffer_string(tempfile));
 
@@ -42,6 +42,7 @@
 #include "core/lib.h"
 #include "cryptglue.h"
 #include "lib.h"
+#include "crypt.h"
 #include "crypt_mod.h"
 #ifndef CRYPT_BACKEND_GPGME
 #include "gui/lib.h"
@@ -147,6 +148,8 @@ void crypt_cleanup(void)
 
   if (CRYPT_MOD_CALL_CHECK(SMIME, cleanup))
     (CRYPT_MOD_CALL(SMIME, cleanup))();
+
+  crypt_verify_cache_cleanup();
 }
 
 /**
@@ -39,6 +39,7 @@
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/stat.h>
 #include <time.h>
 #include <unistd.h>
 #include "mutt/lib.h"
@@ -47,6 +48,7 @@
 #include "core/lib.h"
 #include "gnupgparse.h"
 #include "lib.h"
+#include "mutt_globals.h"
 #include "pgpinvoke.h"
 #include "pgpkey.h"
 #ifdef CRYPT_BACKEND_CLASSIC_PGP
@@ -72,6 +74,156 @@
 
 static char *chs = NULL;
 
+/// Maximum number of cached candidate lists
+#define PGP_LIST_CACHE_MAX 8
+
+/**
+ * struct PgpListCache - One cached candidate list from pgp_get_candidates()
+ *
+ * Listing a big keyring takes gpg several seconds, so the parsed result is
+ * kept around, keyed by the query and validated against the keyring files'
+ * mtime and size.  Hits hand out a deep copy, since callers splice and free
+ * the list they get.
+ */
+struct PgpListCache
+{
+  enum PgpRing keyring;      ///< Keyring the list came from
+  char *hints;               ///< Joined hint strings of the query
+  char *charset;             ///< Charset the user ids were converted to
+  time_t mtime;              ///< Latest mtime of the keyring files
+  off_t size;                ///< Total size of the keyring files
+  struct PgpKeyInfo *keys;   ///< The parsed candidate list
+  struct PgpListCache *next;
+};
+
+static struct PgpListCache *list_cache = NULL;
+
+/**
+ * pgp_keyring_signature - Fingerprint the on-disk keyring for cache validation
+ * @param[out] mtime Latest mtime of the keyring files
+ * @param[out] size  Total size of the keyring files
+ * @retval true At least one keyring file was found
+ *
+ * Combines the gnupg home's pubring (old and new format) and trust database,
+ * so both key and ownertrust changes invalidate the cache.
+ */
+static bool pgp_keyring_signature(time_t *mtime, off_t *size)
+{
+  static const char *files[] = { "pubring.kbx", "pubring.gpg", "trustdb.gpg" };
+
+  const char *home = mutt_str_getenv("GNUPGHOME");
+  struct Buffer *path = mutt_buffer_pool_get();
+  bool found = false;
+
+  for (size_t i = 0; i < mutt_array_size(files); i++)
+  {
+    if (home)
+      mutt_buffer_printf(path, "%s/%s", home, files[i]);
+    else
+      mutt_buffer_printf(path, "%s/.gnupg/%s", NONULL(HomeDir), files[i]);
+
+    struct stat st = { 0 };
+    if (stat(mutt_buffer_string(path), &st) != 0)
+      continue;
+    if (st.st_mtime > *mtime)
+      *mtime = st.st_mtime;
+    *size += st.st_size;
+    found = true;
+  }
+
+  mutt_buffer_pool_release(&path);
+  return found;
+}
+
+/**
+ * pgp_copy_key_list - Deep-copy a list of PGP keys
+ * @param keys List of keys, as built by pgp_get_candidates()
+ * @retval ptr Copied list
+ *
+ * Subkeys follow their main key in the list; the copies are re-parented the
+ * same way, so pgp_remove_key() and pgp_key_free() treat them as usual.
+ */
+static struct PgpKeyInfo *pgp_copy_key_list(struct PgpKeyInfo *keys)
+{
+  struct PgpKeyInfo *db = NULL, **kend = &db;
+  struct PgpKeyInfo *mainkey = NULL;
+
+  for (struct PgpKeyInfo *k = keys; k; k = k->next)
+  {
+    struct PgpKeyInfo *kk = mutt_mem_calloc(1, sizeof(struct PgpKeyInfo));
+    kk->keyid = mutt_str_dup(k->keyid);
+    kk->fingerprint = mutt_str_dup(k->fingerprint);
+    kk->flags = k->flags;
+    kk->keylen = k->keylen;
+    kk->gen_time = k->gen_time;
+    kk->numalg = k->numalg;
+    kk->algorithm = k->algorithm;
+
+    if (k->parent && (k->parent != k))
+      kk->parent = mainkey;
+    else
+      mainkey = kk;
+    kk->address = pgp_copy_uids(k->address, kk);
+
+    *kend = kk;
+    kend = &kk->next;
+  }
+
+  return db;
+}
+
+/**
+ * pgp_list_cache_free_entry - Free one candidate list cache entry
+ * @param[out] ptr Entry to free
+ */
+static void pgp_list_cache_free_entry(struct PgpListCache **ptr)
+{
+  struct PgpListCache *c = *ptr;
+  pgp_key_free(&c->keys);
+  FREE(&c->hints);
+  FREE(&c->charset);
+  FREE(ptr);
+}
+
+/**
+ * pgp_list_cache_store - Remember a parsed candidate list
+ * @param keyring Keyring the list came from
+ * @param hints   Joined hint strings of the query
+ * @param mtime   Latest mtime of the keyring files
+ * @param size    Total size of the keyring files
+ * @param keys    Candidate list to copy into the cache
+ *
+ * When the cache is full, the oldest entry makes room.
+ */
+static void pgp_list_cache_store(enum PgpRing keyring, const char *hints,
+                                 time_t mtime, off_t size, struct PgpKeyInfo *keys)
+{
+  int num = 0;
+  struct PgpListCache **cp = &list_cache;
+  while (*cp)
+  {
+    num++;
+    cp = &(*cp)->next;
+  }
+  if (num >= PGP_LIST_CACHE_MAX)
+  {
+    cp = &list_cache;
+    while ((*cp)->next)
+      cp = &(*cp)->next;
+    pgp_list_cache_free_entry(cp);
+  }
+
+  struct PgpListCache *c = mutt_mem_calloc(1, sizeof(struct PgpListCache));
+  c->keyring = keyring;
+  c->hints = mutt_str_dup(hints);
+  c->charset = mutt_str_dup(chs);
+  c->mtime = mtime;
+  c->size = size;
+  c->keys = pgp_copy_key_list(keys);
+  c->next = list_cache;
+  list_cache = c;
+}
+
 /**
  * fix_uid - Decode backslash-escaped user ids (in place)
  * @param uid String to decode
@@ -421,16 +573,58 @@ struct PgpKeyInfo *pgp_get_candidates(enum PgpRing keyring, struct ListHead *hin
   struct PgpKeyInfo *db = NULL, **kend = NULL, *k = NULL, *kk = NULL, *mainkey = NULL;
   bool is_sub = false;
 
+  const char *const c_charset = cs_subset_string(NeoMutt->sub, "charset");
+  mutt_str_replace(&chs, c_charset);
+
+  time_t kr_mtime = 0;
+  off_t kr_size = 0;
+  const bool have_sig = pgp_keyring_signature(&kr_mtime, &kr_size);
+
+  struct Buffer *hintstr = mutt_buffer_pool_get();
+  struct ListNode *np = NULL;
+  STAILQ_FOREACH(np, hints, entries)
+  {
+    if (!mutt_buffer_is_empty(hintstr))
+      mutt_buffer_addch(hintstr, ' ');
+    mutt_buffer_addstr(hintstr, np->data);
+  }
+
+  if (have_sig)
+  {
+    for (struct PgpListCache **cp = &list_cache; *cp;)
+    {
+      struct PgpListCache *c = *cp;
+      if ((c->keyring == keyring) && mutt_str_equal(c->charset, chs) &&
+          mutt_str_equal(c->hints, mutt_buffer_string(hintstr)))
+      {
+        if ((c->mtime == kr_mtime) && (c->size == kr_size))
+        {
+          mutt_debug(LL_DEBUG2, "reusing cached candidate list for '%s'\n",
+                     mutt_buffer_string(hintstr));
+          db = pgp_copy_key_list(c->keys);
+          mutt_buffer_pool_release(&hintstr);
+          return db;
+        }
+        /* same query, stale keyring */
+        *cp = c->next;
+        pgp_list_cache_free_entry(&c);
+        continue;
+      }
+      cp = &c->next;
+    }
+  }
+
   int fd_null = open("/dev/null", O_RDWR);
   if (fd_null == -1)
+  {
+    mutt_buffer_pool_release(&hintstr);
     return NULL;
-
-  const char *const c_charset = cs_subset_string(NeoMutt->sub, "charset");
-  mutt_str_replace(&chs, c_charset);
+  }
 
   pid = pgp_invoke_list_keys(NULL, &fp, NULL, -1, -1, fd_null, keyring, hints);
   if (pid == -1)
   {
+    mutt_buffer_pool_release(&hintstr);
     close(fd_null);
     return NULL;
   }
@@ -475,5 +669,9 @@ struct PgpKeyInfo *pgp_get_candidates(enum PgpRing keyring, struct ListHead *hin
 
   close(fd_null);
 
+  if (have_sig && db)
+    pgp_list_cache_store(keyring, mutt_buffer_string(hintstr), kr_mtime, kr_size, db);
+  mutt_buffer_pool_release(&hintstr);
+
   return db;
 }
@@ -151,6 +151,7 @@ SecurityFlags mutt_is_malformed_multipart_pgp_encrypted(struct Body *b);
 SecurityFlags mutt_is_multipart_encrypted(struct Body *b);
 SecurityFlags mutt_is_multipart_signed(struct Body *b);
 int          mutt_is_valid_multipart_pgp_encrypted(struct Body *b);
+bool         mutt_pgp_find_inline_markers(FILE *fp, bool *enc, bool *sgn, bool *key);
 int          mutt_protect(struct Email *e, char *keylist, bool postpone);
 int          mutt_protected_headers_handler(struct Body *b, struct State *s);
 bool         mutt_should_hide_protected_subject(struct Email *e);
@@ -791,7 +791,6 @@ out:
 static bool pgp_check_traditional_one_body(FILE *fp, struct Body *b)
 {
   struct Buffer *tempfile = NULL;
-  char buf[8192];
   bool rc = false;
 
   bool sgn = false;
@@ -817,19 +816,7 @@ static bool pgp_check_traditional_one_body(FILE *fp, struct Body *b)
     goto cleanup;
   }
 
-  while (fgets(buf, sizeof(buf), fp_tmp))
-  {
-    size_t plen = mutt_str_startswith(buf, "-----BEGIN PGP ");
-    if (plen != 0)
-    {
-      if (mutt_str_startswith(buf + plen, "MESSAGE-----\n"))
-        enc = true;
-      else if (mutt_str_startswith(buf + plen, "SIGNED MESSAGE-----\n"))
-        sgn = true;
-      else if (mutt_str_startswith(buf + plen, "PUBLIC KEY BLOCK-----\n"))
-        key = true;
-    }
-  }
+  mutt_pgp_find_inline_markers(fp_tmp, &enc, &sgn, &key);
   mutt_file_fclose(&fp_tmp);
   unlink(mutt_buffer_string(tempfile));
 
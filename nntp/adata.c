@@ -29,10 +29,9 @@
 #include "config.h"
 #include "private.h"
 #include "mutt/lib.h"
+#include "conn/lib.h"
 #include "adata.h"
 
-struct Connection;
-
 /**
  * nntp_adata_free - Free the private Account data - Implements Account::adata_free()
  *
@@ -48,6 +47,8 @@ void nntp_adata_free(void **ptr)
   FREE(&adata->newsrc_file);
   FREE(&adata->authenticators);
   FREE(&adata->overview_fmt);
+  if (adata->conn)
+    FREE(&adata->conn->inbuf);
   FREE(&adata->conn);
   FREE(&adata->groups_list);
   mutt_hash_free(&adata->groups_hash);
@@ -37,6 +37,7 @@ struct NntpAccountData
 {
   bool hasCAPABILITIES    : 1; ///< Server supports CAPABILITIES command
   bool hasSTARTTLS        : 1; ///< Server supports STARTTLS command
+  bool hasCOMPRESS        : 1; ///< Server supports COMPRESS DEFLATE command (RFC8054)
   bool hasDATE            : 1; ///< Server supports DATE command
   bool hasLIST_NEWSGROUPS : 1; ///< Server supports LIST_NEWSGROUPS command
   bool hasXGTITLE         : 1; ///< Server supports XGTITLE command
@@ -48,6 +49,7 @@ struct NntpAccountData
   unsigned int status     : 3;
   bool cacheable          : 1;
   bool newsrc_modified    : 1;
+  bool newsrc_dirty       : 1; ///< Memory state is newer than the .newsrc file
   FILE *fp_newsrc;
   char *newsrc_file;
   char *authenticators;
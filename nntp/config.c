@@ -94,10 +94,27 @@ static struct ConfigDef NntpVars[] = {
   // clang-format on
 };
 
+#if defined(USE_ZLIB)
+static struct ConfigDef NntpVarsZlib[] = {
+  // clang-format off
+  { "nntp_deflate", DT_BOOL, true, 0, NULL,
+    "(nntp) Compress network traffic"
+  },
+  { NULL },
+  // clang-format on
+};
+#endif
+
 /**
  * config_init_nntp - Register nntp config variables - Implements ::module_init_config_t - @ingroup cfg_module_api
  */
 bool config_init_nntp(struct ConfigSet *cs)
 {
-  return cs_register_variables(cs, NntpVars, 0);
+  bool rc = cs_register_variables(cs, NntpVars, 0);
+
+#if defined(USE_ZLIB)
+  rc |= cs_register_variables(cs, NntpVarsZlib, 0);
+#endif
+
+  return rc;
 }
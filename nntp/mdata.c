@@ -42,6 +42,7 @@ void nntp_mdata_free(void **ptr)
   nntp_acache_free(mdata);
   mutt_bcache_close(&mdata->bcache);
   FREE(&mdata->newsrc_ent);
+  FREE(&mdata->newsrc_line);
   FREE(&mdata->desc);
   FREE(ptr);
 }
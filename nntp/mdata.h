@@ -44,6 +44,7 @@ struct NntpMboxData
   bool deleted      : 1;
   unsigned int newsrc_len;
   struct NewsrcEntry *newsrc_ent;
+  char *newsrc_line; ///< Cached .newsrc line, dropped when the group changes
   struct NntpAccountData *adata;
   struct NntpAcache acache[NNTP_ACACHE_LEN];
   struct BodyCache *bcache;
@@ -35,6 +35,7 @@
 #include <limits.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/stat.h>
 #include <time.h>
@@ -153,6 +154,43 @@ void nntp_group_unread_stat(struct NntpMboxData *mdata)
   }
 }
 
+/**
+ * newsrc_ent_cmp - Compare two .newsrc entries by first article number
+ * @param a First entry
+ * @param b Second entry
+ * @retval -1 a precedes b
+ * @retval  0 a and b are identical
+ * @retval  1 b precedes a
+ */
+static int newsrc_ent_cmp(const void *a, const void *b)
+{
+  const struct NewsrcEntry *ea = a;
+  const struct NewsrcEntry *eb = b;
+
+  if (ea->first < eb->first)
+    return -1;
+  if (ea->first > eb->first)
+    return 1;
+  return 0;
+}
+
+/**
+ * nntp_newsrc_dirty - Mark a newsgroup's .newsrc state as changed
+ * @param mdata NNTP Mailbox data
+ *
+ * Drops the group's cached .newsrc line and schedules a rewrite of the file
+ * on the next nntp_newsrc_update().
+ */
+void nntp_newsrc_dirty(struct NntpMboxData *mdata)
+{
+  if (!mdata)
+    return;
+
+  FREE(&mdata->newsrc_line);
+  if (mdata->adata)
+    mdata->adata->newsrc_dirty = true;
+}
+
 /**
  * nntp_newsrc_parse - Parse .newsrc file
  * @param adata NNTP server
@@ -218,6 +256,7 @@ int nntp_newsrc_parse(struct NntpAccountData *adata)
     mdata->subscribed = false;
     mdata->newsrc_len = 0;
     FREE(&mdata->newsrc_ent);
+    FREE(&mdata->newsrc_line);
   }
 
   line = mutt_mem_malloc(st.st_size + 1);
@@ -283,10 +322,25 @@ int nntp_newsrc_parse(struct NntpAccountData *adata)
       mdata->last_message = mdata->newsrc_ent[j - 1].last;
     mdata->newsrc_len = j;
     mutt_mem_realloc(&mdata->newsrc_ent, j * sizeof(struct NewsrcEntry));
+
+    /* hand-edited files may list ranges out of order; the binary search in
+     * nntp_article_status() needs them sorted */
+    for (j = 1; j < mdata->newsrc_len; j++)
+    {
+      if (mdata->newsrc_ent[j - 1].first > mdata->newsrc_ent[j].first)
+      {
+        qsort(mdata->newsrc_ent, mdata->newsrc_len,
+              sizeof(struct NewsrcEntry), newsrc_ent_cmp);
+        break;
+      }
+    }
+
     nntp_group_unread_stat(mdata);
     mutt_debug(LL_DEBUG2, "%s\n", mdata->group);
   }
   FREE(&line);
+  /* memory now mirrors the file, no write is pending */
+  adata->newsrc_dirty = false;
   return 1;
 }
 
@@ -311,6 +365,15 @@ void nntp_newsrc_gen_entries(struct Mailbox *m)
     mailbox_changed(m, NT_MAILBOX_RESORT);
   }
 
+  /* keep the old entries, so we can tell whether anything changed */
+  const unsigned int old_len = mdata->newsrc_len;
+  struct NewsrcEntry *old_ent = NULL;
+  if (old_len)
+  {
+    old_ent = mutt_mem_malloc(old_len * sizeof(struct NewsrcEntry));
+    memcpy(old_ent, mdata->newsrc_ent, old_len * sizeof(struct NewsrcEntry));
+  }
+
   entries = mdata->newsrc_len;
   if (!entries)
   {
@@ -373,6 +436,13 @@ void nntp_newsrc_gen_entries(struct Mailbox *m)
   }
   mutt_mem_realloc(&mdata->newsrc_ent, mdata->newsrc_len * sizeof(struct NewsrcEntry));
 
+  if ((mdata->newsrc_len != old_len) ||
+      (old_len && (memcmp(mdata->newsrc_ent, old_ent, old_len * sizeof(struct NewsrcEntry)) != 0)))
+  {
+    nntp_newsrc_dirty(mdata);
+  }
+  FREE(&old_ent);
+
   if (c_sort != SORT_ORDER)
   {
     cs_subset_str_native_set(NeoMutt->sub, "sort", c_sort, NULL);
@@ -442,6 +512,10 @@ int nntp_newsrc_update(struct NntpAccountData *adata)
   if (!adata)
     return -1;
 
+  /* no group has changed since the last write */
+  if (!adata->newsrc_dirty)
+    return 0;
+
   int rc = -1;
 
   size_t buflen = 10240;
@@ -456,6 +530,21 @@ int nntp_newsrc_update(struct NntpAccountData *adata)
     if (!mdata || !mdata->newsrc_ent)
       continue;
 
+    /* reuse the cached line if the group hasn't changed */
+    const size_t start = off;
+    if (mdata->newsrc_line)
+    {
+      const size_t len = strlen(mdata->newsrc_line);
+      while (off + len + 1 > buflen)
+      {
+        buflen *= 2;
+        mutt_mem_realloc(&buf, buflen);
+      }
+      memcpy(buf + off, mdata->newsrc_line, len);
+      off += len;
+      continue;
+    }
+
     /* write newsgroup name */
     if (off + strlen(mdata->group) + 3 > buflen)
     {
@@ -485,6 +574,7 @@ int nntp_newsrc_update(struct NntpAccountData *adata)
       off += strlen(buf + off);
     }
     buf[off++] = '\n';
+    mdata->newsrc_line = mutt_strn_dup(buf + start, off - start);
   }
   buf[off] = '\0';
 
@@ -499,6 +589,7 @@ int nntp_newsrc_update(struct NntpAccountData *adata)
     {
       adata->size = st.st_size;
       adata->mtime = st.st_mtime;
+      adata->newsrc_dirty = false;
     }
     else
     {
@@ -1229,14 +1320,23 @@ void nntp_article_status(struct Mailbox *m, struct Email *e, char *group, anum_t
   if (!mdata)
     return;
 
-  for (unsigned int i = 0; i < mdata->newsrc_len; i++)
+  /* find the first range ending at or after anum; the ranges are sorted
+   * and disjoint, so it's the only one that can contain it */
+  unsigned int lo = 0;
+  unsigned int hi = mdata->newsrc_len;
+  while (lo < hi)
   {
-    if ((anum >= mdata->newsrc_ent[i].first) && (anum <= mdata->newsrc_ent[i].last))
-    {
-      /* can't use mutt_set_flag() because ctx_update() didn't get called yet */
-      e->read = true;
-      return;
-    }
+    const unsigned int mid = lo + ((hi - lo) / 2);
+    if (mdata->newsrc_ent[mid].last < anum)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  if ((lo < mdata->newsrc_len) && (anum >= mdata->newsrc_ent[lo].first))
+  {
+    /* can't use mutt_set_flag() because ctx_update() didn't get called yet */
+    e->read = true;
+    return;
   }
 
   /* article was not cached yet, it's new */
@@ -1270,6 +1370,7 @@ struct NntpMboxData *mutt_newsgroup_subscribe(struct NntpAccountData *adata, cha
     mdata->newsrc_ent[0].first = 1;
     mdata->newsrc_ent[0].last = 0;
   }
+  nntp_newsrc_dirty(mdata);
   return mdata;
 }
 
@@ -1297,6 +1398,7 @@ struct NntpMboxData *mutt_newsgroup_unsubscribe(struct NntpAccountData *adata, c
     mdata->newsrc_len = 0;
     FREE(&mdata->newsrc_ent);
   }
+  nntp_newsrc_dirty(mdata);
   return mdata;
 }
 
@@ -1324,6 +1426,7 @@ struct NntpMboxData *mutt_newsgroup_catchup(struct Mailbox *m,
     mdata->newsrc_len = 1;
     mdata->newsrc_ent[0].first = 1;
     mdata->newsrc_ent[0].last = mdata->last_message;
+    nntp_newsrc_dirty(mdata);
   }
   mdata->unread = 0;
   if (m && (m->mdata == mdata))
@@ -1363,6 +1466,7 @@ struct NntpMboxData *mutt_newsgroup_uncatchup(struct Mailbox *m,
     mdata->newsrc_len = 1;
     mdata->newsrc_ent[0].first = 1;
     mdata->newsrc_ent[0].last = mdata->first_message - 1;
+    nntp_newsrc_dirty(mdata);
   }
   if (m && (m->mdata == mdata))
   {
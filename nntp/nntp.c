@@ -98,6 +98,7 @@ struct FetchCtx
   unsigned char *messages;
   struct Progress *progress;
   struct HeaderCache *hc;
+  FILE *fp_spool; ///< Reusable scratch file for parsing overview lines
 };
 
 /**
@@ -147,6 +148,7 @@ static int nntp_capabilities(struct NntpAccountData *adata)
 
   adata->hasCAPABILITIES = false;
   adata->hasSTARTTLS = false;
+  adata->hasCOMPRESS = false;
   adata->hasDATE = false;
   adata->hasLIST_NEWSGROUPS = false;
   adata->hasLISTGROUP = false;
@@ -197,6 +199,13 @@ static int nntp_capabilities(struct NntpAccountData *adata)
 #endif
     else if (mutt_str_equal("OVER", buf))
       adata->hasOVER = true;
+    else if ((plen = mutt_str_startswith(buf, "COMPRESS ")))
+    {
+      /* RFC8054 lists the supported algorithms after the label */
+      char *p = strstr(buf + plen, "DEFLATE");
+      if (p && (p[-1] == ' ') && ((p[7] == '\0') || (p[7] == ' ')))
+        adata->hasCOMPRESS = true;
+    }
     else if (mutt_str_startswith(buf, "LIST "))
     {
       char *p = strstr(buf, " NEWSGROUPS");
@@ -773,6 +782,7 @@ static int nntp_fetch_lines(struct NntpMboxData *mdata, char *query, size_t qlen
   {
     char buf[1024];
     char *line = NULL;
+    size_t linelen = sizeof(buf);
     unsigned int lines = 0;
     size_t off = 0;
     struct Progress *progress = NULL;
@@ -786,49 +796,63 @@ static int nntp_fetch_lines(struct NntpMboxData *mdata, char *query, size_t qlen
       return 1;
     }
 
-    line = mutt_mem_malloc(sizeof(buf));
+    line = mutt_mem_malloc(linelen);
     rc = 0;
 
     if (msg)
       progress = progress_new(msg, MUTT_PROGRESS_READ, 0);
 
-    while (true)
+    /* Consume the response in buffer-sized chunks and split it into lines
+     * here, rather than one mutt_socket_readchar() call per byte - a large
+     * OVER response is millions of lines */
+    while (!done)
     {
-      char *p = NULL;
-      int chunk = mutt_socket_readln_d(buf, sizeof(buf), mdata->adata->conn, MUTT_SOCK_LOG_FULL);
-      if (chunk < 0)
+      const char *chunk = NULL;
+      const int clen = mutt_socket_read_buf(mdata->adata->conn, &chunk, sizeof(buf));
+      if (clen <= 0)
       {
         mdata->adata->status = NNTP_NONE;
         break;
       }
 
-      p = buf;
-      if (!off && (buf[0] == '.'))
+      for (int i = 0; (i < clen) && !done; i++)
       {
-        if (buf[1] == '\0')
+        if (chunk[i] != '\n')
         {
-          done = true;
-          break;
+          if ((off + 2) > linelen)
+          {
+            linelen *= 2;
+            mutt_mem_realloc(&line, linelen);
+          }
+          line[off++] = chunk[i];
+          continue;
         }
-        if (buf[1] == '.')
-          p++;
-      }
 
-      mutt_str_copy(line + off, p, sizeof(buf));
+        /* strip \r from \r\n termination */
+        if ((off != 0) && (line[off - 1] == '\r'))
+          off--;
+        line[off] = '\0';
+        mutt_debug(MUTT_SOCK_LOG_FULL, "%d< %s\n", mdata->adata->conn->fd, line);
+
+        char *p = line;
+        if (line[0] == '.')
+        {
+          if (line[1] == '\0')
+          {
+            done = true;
+            break;
+          }
+          if (line[1] == '.')
+            p++;
+        }
 
-      if (chunk >= sizeof(buf))
-        off += strlen(p);
-      else
-      {
         if (msg)
           progress_update(progress, ++lines, -1);
 
-        if ((rc == 0) && (func(line, data) < 0))
+        if ((rc == 0) && (func(p, data) < 0))
           rc = -2;
         off = 0;
       }
-
-      mutt_mem_realloc(&line, off + sizeof(buf));
     }
     FREE(&line);
     func(NULL, data);
@@ -1028,11 +1052,18 @@ static int parse_overview_line(char *line, void *data)
     return 0;
   }
 
-  /* convert overview line to header */
-  FILE *fp = mutt_file_mkstemp();
+  /* convert overview line to header, reusing one scratch file for the whole
+   * response instead of creating a temporary file per article */
+  if (!fc->fp_spool)
+    fc->fp_spool = mutt_file_mkstemp();
+  FILE *fp = fc->fp_spool;
   if (!fp)
     return -1;
 
+  rewind(fp);
+  if (ftruncate(fileno(fp), 0) != 0)
+    return -1;
+
   header = mdata->adata->overview_fmt;
   while (field)
   {
@@ -1041,10 +1072,7 @@ static int parse_overview_line(char *line, void *data)
     if (*header)
     {
       if (!strstr(header, ":full") && (fputs(header, fp) == EOF))
-      {
-        mutt_file_fclose(&fp);
         return -1;
-      }
       header = strchr(header, '\0') + 1;
     }
 
@@ -1052,11 +1080,9 @@ static int parse_overview_line(char *line, void *data)
     if (field)
       *field++ = '\0';
     if ((fputs(b, fp) == EOF) || (fputc('\n', fp) == EOF))
-    {
-      mutt_file_fclose(&fp);
       return -1;
-    }
   }
+  fflush(fp);
   rewind(fp);
 
   /* allocate memory for headers */
@@ -1069,7 +1095,6 @@ static int parse_overview_line(char *line, void *data)
   e->env = mutt_rfc822_read_header(fp, e, false, false);
   e->env->newsgroups = mutt_str_dup(mdata->group);
   e->received = e->date_sent;
-  mutt_file_fclose(&fp);
 
 #ifdef USE_HCACHE
   if (fc->hc)
@@ -1368,6 +1393,7 @@ static int nntp_fetch_headers(struct Mailbox *m, void *hc, anum_t first, anum_t
   }
 
   FREE(&fc.messages);
+  mutt_file_fclose(&fc.fp_spool);
   progress_free(&fc.progress);
   if (rc != 0)
     return -1;
@@ -1406,6 +1432,7 @@ static int nntp_group_poll(struct NntpMboxData *mdata, bool update_stat)
       mdata->newsrc_len = 1;
       mdata->newsrc_ent[0].first = 1;
       mdata->newsrc_ent[0].last = 0;
+      nntp_newsrc_dirty(mdata);
     }
   }
   mdata->first_message = first;
@@ -1859,6 +1886,25 @@ int nntp_open_connection(struct NntpAccountData *adata)
     }
   }
 
+#ifdef USE_ZLIB
+  /* RFC8054 */
+  const bool c_nntp_deflate = cs_subset_bool(NeoMutt->sub, "nntp_deflate");
+  if (c_nntp_deflate && adata->hasCOMPRESS)
+  {
+    if ((mutt_socket_send(conn, "COMPRESS DEFLATE\r\n") < 0) ||
+        (mutt_socket_readln(buf, sizeof(buf), conn) < 0))
+    {
+      return nntp_connect_error(adata);
+    }
+    if (mutt_str_startswith(buf, "206"))
+    {
+      mutt_debug(LL_DEBUG2, "NNTP compression is enabled on connection to %s\n",
+                 conn->account.host);
+      mutt_zstrm_wrap_conn(conn);
+    }
+  }
+#endif
+
   /* attempt features */
   if (nntp_attempt_features(adata) < 0)
     return -1;
@@ -2392,6 +2438,7 @@ static enum MxOpenReturns nntp_mbox_open(struct Mailbox *m)
     {
       FREE(&mdata->newsrc_ent);
       mdata->newsrc_len = 0;
+      nntp_newsrc_dirty(mdata);
       nntp_delete_group_cache(mdata);
       nntp_newsrc_update(adata);
     }
@@ -44,6 +44,11 @@ void nm_adata_free(void **ptr)
     nm_db_free(adata->db);
     adata->db = NULL;
   }
+  if (adata->db_cached)
+  {
+    nm_db_free(adata->db_cached);
+    adata->db_cached = NULL;
+  }
 
   FREE(ptr);
 }
@@ -25,6 +25,7 @@
 
 #include <notmuch.h>
 #include <stdbool.h>
+#include <time.h>
 
 struct Mailbox;
 
@@ -36,6 +37,10 @@ struct NmAccountData
   notmuch_database_t *db; ///< Connection to Notmuch database
   bool longrun : 1;       ///< A long-lived action is in progress
   bool trans : 1;         ///< Atomic transaction in progress
+  bool db_writable : 1;   ///< Current connection was opened read/write
+
+  notmuch_database_t *db_cached; ///< Read-only connection kept across releases
+  time_t db_mtime;               ///< Xapian mtime when the connection was (re)opened
 };
 
 void                  nm_adata_free(void **ptr);
@@ -182,10 +182,55 @@ notmuch_database_t *nm_db_get(struct Mailbox *m, bool writable)
   if (adata->db)
     return adata->db;
 
+  time_t mtime = 0;
+  if (nm_db_get_mtime(m, &mtime) != 0)
+    mtime = 0;
+
+  if (adata->db_cached)
+  {
+    if (writable)
+    {
+      // A writable connection must be opened for real
+      nm_db_free(adata->db_cached);
+      adata->db_cached = NULL;
+    }
+    else if (mtime != adata->db_mtime)
+    {
+      // The database has moved on; refresh the cached connection
+#if LIBNOTMUCH_CHECK_VERSION(5, 4, 0)
+      // notmuch 0.32-0.32.2 didn't bump libnotmuch version to 5.4.
+      if (notmuch_database_reopen(adata->db_cached, NOTMUCH_DATABASE_MODE_READ_ONLY) == NOTMUCH_STATUS_SUCCESS)
+      {
+        adata->db_mtime = mtime;
+      }
+      else
+#endif
+      {
+        nm_db_free(adata->db_cached);
+        adata->db_cached = NULL;
+      }
+    }
+
+    if (adata->db_cached)
+    {
+      mutt_debug(LL_DEBUG2, "nm: db reuse\n");
+      adata->db = adata->db_cached;
+      adata->db_cached = NULL;
+      adata->db_writable = false;
+      return adata->db;
+    }
+  }
+
   const char *db_filename = nm_db_get_filename(m);
   if (db_filename)
     adata->db = nm_db_do_open(db_filename, writable, true);
 
+  if (adata->db)
+  {
+    adata->db_writable = writable;
+    adata->db_mtime = mtime;
+  }
+
   return adata->db;
 }
 
@@ -201,8 +246,19 @@ int nm_db_release(struct Mailbox *m)
   if (!adata || !adata->db || nm_db_is_longrun(m))
     return -1;
 
-  mutt_debug(LL_DEBUG1, "nm: db close\n");
-  nm_db_free(adata->db);
+  if (adata->db_writable)
+  {
+    mutt_debug(LL_DEBUG1, "nm: db close\n");
+    nm_db_free(adata->db);
+  }
+  else
+  {
+    /* Keep read-only connections for reuse: opening the Xapian database takes
+     * hundreds of ms on a big store and vfolder switches do it constantly.
+     * nm_db_get() revalidates against the database mtime before reuse. */
+    mutt_debug(LL_DEBUG1, "nm: db parked\n");
+    adata->db_cached = adata->db;
+  }
   adata->db = NULL;
   adata->longrun = false;
   return 0;
@@ -56,6 +56,7 @@ void  nm_db_longrun_init         (struct Mailbox *m, bool writable);
 char *nm_email_get_folder        (struct Email *e);
 char *nm_email_get_folder_rel_db (struct Mailbox *m, struct Email *e);
 int   nm_get_all_tags            (struct Mailbox *m, char **tag_list, int *tag_count);
+int   nm_mbox_fetch_more         (struct Mailbox *m);
 bool  nm_message_is_still_queried(struct Mailbox *m, struct Email *e);
 enum MailboxType nm_path_probe   (const char *path, const struct stat *st);
 bool  nm_query_window_available  (void);
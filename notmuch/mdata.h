@@ -23,6 +23,7 @@
 #ifndef MUTT_NOTMUCH_MDATA_H
 #define MUTT_NOTMUCH_MDATA_H
 
+#include <notmuch.h>
 #include "query.h"
 
 struct Mailbox;
@@ -40,6 +41,12 @@ struct NmMboxData
   struct Progress *progress;   ///< A progress bar
   int oldmsgcount;
   int ignmsgcount;             ///< Ignored messages
+
+  unsigned long lastmod;       ///< DB revision when the counts were last computed
+  bool counts_valid : 1;       ///< Mailbox counts are current for revision `lastmod`
+
+  notmuch_query_t *open_query;    ///< Live query whose results are paged in on demand
+  notmuch_messages_t *open_msgs;  ///< Cursor into Notmuch's results for the open query
 };
 
 void                  nm_mdata_free(void **ptr);
@@ -502,6 +502,8 @@ static int update_email_tags(struct Email *e, notmuch_message_t *msg)
 
   /* new version */
   driver_tags_replace(&e->tags, new_tags);
+  e->index_color_valid = false;
+  FREE(&e->display); /* the index line may show the tags */
   FREE(&new_tags);
 
   new_tags = driver_tags_get_transformed(&e->tags);
@@ -779,13 +781,12 @@ static void append_message(struct HeaderCache *h, struct Mailbox *m,
   if (!e)
 #endif
   {
-    if (access(path, F_OK) == 0)
-    {
-      /* We pass is_old=false as argument here, but e->old will be updated later
-       * by update_message_path() (called by init_email() below).  */
-      e = maildir_parse_message(MUTT_MAILDIR, path, false, NULL);
-    }
-    else
+    /* We pass is_old=false as argument here, but e->old will be updated later
+     * by update_message_path() (called by init_email() below).  Opening the
+     * file is also our existence check - a separate access() would just stat
+     * every result twice.  */
+    e = maildir_parse_message(MUTT_MAILDIR, path, false, NULL);
+    if (!e)
     {
       /* maybe moved try find it... */
       char *folder = get_folder_from_path(path);
@@ -925,6 +926,25 @@ static notmuch_messages_t *get_messages(notmuch_query_t *query)
   return msgs;
 }
 
+/**
+ * release_open_query - Close a paged query left open by read_mesgs_query()
+ * @param m Mailbox
+ *
+ * Destroy the parked results cursor and its query, and give up the
+ * long-running database handle that kept them alive.
+ */
+static void release_open_query(struct Mailbox *m)
+{
+  struct NmMboxData *mdata = nm_mdata_get(m);
+  if (!mdata || !mdata->open_query)
+    return;
+
+  mdata->open_msgs = NULL;
+  notmuch_query_destroy(mdata->open_query);
+  mdata->open_query = NULL;
+  nm_db_longrun_done(m);
+}
+
 /**
  * read_mesgs_query - Search for matching messages
  * @param m     Mailbox
@@ -932,6 +952,10 @@ static notmuch_messages_t *get_messages(notmuch_query_t *query)
  * @param dedup De-duplicate the results
  * @retval true  Success
  * @retval false Failure
+ *
+ * If there are more results than `$nm_db_limit`, the cursor is parked in the
+ * NmMboxData, so nm_mbox_fetch_more() can materialise the next page without
+ * re-running the query.
  */
 static bool read_mesgs_query(struct Mailbox *m, notmuch_query_t *q, bool dedup)
 {
@@ -963,9 +987,68 @@ static bool read_mesgs_query(struct Mailbox *m, notmuch_query_t *q, bool dedup)
   }
 
   nm_hcache_close(h);
+
+  if ((limit != 0) && notmuch_messages_valid(msgs))
+  {
+    /* The limit cut the results short.  Keep the database open and park the
+     * cursor, so the remaining pages can be read as the user scrolls. */
+    nm_db_longrun_init(m, false);
+    mdata->open_query = q;
+    mdata->open_msgs = msgs;
+  }
   return true;
 }
 
+/**
+ * nm_mbox_fetch_more - Materialise the next page of an open query
+ * @param m Mailbox
+ * @retval num Number of new messages
+ * @retval 0   No open query, or no more results
+ *
+ * Read another `$nm_db_limit` messages from the results cursor parked by
+ * read_mesgs_query().  When the results are exhausted, the query and the
+ * long-running database handle are released.
+ */
+int nm_mbox_fetch_more(struct Mailbox *m)
+{
+  struct NmMboxData *mdata = nm_mdata_get(m);
+  if (!mdata || !mdata->open_msgs)
+    return 0;
+
+  const int limit = get_limit(mdata);
+  const int oldmsgcount = m->msg_count;
+
+  struct HeaderCache *h = nm_hcache_open(m);
+
+  notmuch_messages_t *msgs = mdata->open_msgs;
+  for (; notmuch_messages_valid(msgs) &&
+         ((limit == 0) || (m->msg_count < (oldmsgcount + limit)));
+       notmuch_messages_move_to_next(msgs))
+  {
+    if (SigInt)
+    {
+      SigInt = false;
+      break;
+    }
+    notmuch_message_t *nm = notmuch_messages_get(msgs);
+    append_message(h, m, nm, false);
+    notmuch_message_destroy(nm);
+  }
+
+  nm_hcache_close(h);
+
+  if (!notmuch_messages_valid(msgs))
+    release_open_query(m);
+
+  if (m->msg_count > oldmsgcount)
+  {
+    mailbox_changed(m, NT_MAILBOX_INVALID);
+    mutt_debug(LL_DEBUG1, "nm: fetched %d more messages [count=%d]\n",
+               m->msg_count - oldmsgcount, m->msg_count);
+  }
+  return m->msg_count - oldmsgcount;
+}
+
 /**
  * get_threads - Load threads for a query
  * @param query Notmuch query
@@ -1823,6 +1906,20 @@ static enum MxStatus nm_mbox_check_stats(struct Mailbox *m, uint8_t flags)
   if (!db)
     goto done;
 
+#if LIBNOTMUCH_CHECK_VERSION(4, 3, 0)
+  /* If the database hasn't changed since the last check, the counts on the
+   * Mailbox are still current and the queries can be skipped entirely */
+  init_mailbox(m);
+  struct NmMboxData *mdata = nm_mdata_get(m);
+  const char *uuid = NULL;
+  const unsigned long lastmod = notmuch_database_get_revision(db, &uuid);
+  if (mdata && mdata->counts_valid && (lastmod == mdata->lastmod))
+  {
+    rc = MX_STATUS_OK;
+    goto done;
+  }
+#endif
+
   /* all emails */
   m->msg_count = count_query(db, db_query, limit);
   while (m->email_max < m->msg_count)
@@ -1845,6 +1942,14 @@ static enum MxStatus nm_mbox_check_stats(struct Mailbox *m, uint8_t flags)
   m->msg_flagged = count_query(db, qstr, limit);
   FREE(&qstr);
 
+#if LIBNOTMUCH_CHECK_VERSION(4, 3, 0)
+  if (mdata)
+  {
+    mdata->lastmod = lastmod;
+    mdata->counts_valid = true;
+  }
+#endif
+
   rc = (m->msg_new > 0) ? MX_STATUS_NEW_MAIL : MX_STATUS_OK;
 done:
   if (db)
@@ -2065,7 +2170,8 @@ static enum MxOpenReturns nm_mbox_open(struct Mailbox *m)
           rc = MX_OPEN_ABORT;
         break;
     }
-    notmuch_query_destroy(q);
+    if (mdata->open_query != q)
+      notmuch_query_destroy(q);
   }
 
   nm_db_release(m);
@@ -2345,11 +2451,10 @@ static enum MxStatus nm_mbox_sync(struct Mailbox *m)
 
 /**
  * nm_mbox_close - Close a Mailbox - Implements MxOps::mbox_close() - @ingroup mx_mbox_close
- *
- * Nothing to do.
  */
 static enum MxStatus nm_mbox_close(struct Mailbox *m)
 {
+  release_open_query(m);
   return MX_STATUS_OK;
 }
 
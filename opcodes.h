@@ -209,6 +209,7 @@ const char *opcodes_get_name       (int op);
   _fmt(OP_MAIN_READ_SUBTHREAD,                N_("mark the current subthread as read")) \
   _fmt(OP_MAIN_READ_THREAD,                   N_("mark the current thread as read")) \
   _fmt(OP_MAIN_ROOT_MESSAGE,                  N_("jump to root message in thread")) \
+  _fmt(OP_MAIN_SEARCH_MAILBOXES,              N_("search a pattern in all mailboxes")) \
   _fmt(OP_MAIN_SET_FLAG,                      N_("set a status flag on a message")) \
   _fmt(OP_MAIN_SHOW_LIMIT,                    N_("show currently active limit pattern")) \
   _fmt(OP_MAIN_SYNC_FOLDER,                   N_("save changes to mailbox")) \
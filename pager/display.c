@@ -106,22 +106,31 @@ static int comp_syntax_t(const void *m1, const void *m2)
 
 /**
  * resolve_color - Set the colour for a line of text
- * @param win       Window
- * @param lines     Line info array
- * @param line_num  Line Number (index into lines)
- * @param cnt       If true, this is a continuation line
- * @param flags     Flags, see #PagerFlags
- * @param special   Flags, e.g. A_BOLD
- * @param ansi      ANSI attributes
+ * @param[in]  win       Window
+ * @param[in]  lines     Line info array
+ * @param[in]  line_num  Line Number (index into lines)
+ * @param[in]  cnt       If true, this is a continuation line
+ * @param[in]  flags     Flags, see #PagerFlags
+ * @param[in]  special   Flags, e.g. A_BOLD
+ * @param[in]  ansi      ANSI attributes
+ * @param[out] till      First offset after cnt where the colour may differ, can be NULL
+ *
+ * The colour is constant over a run of characters - until the next syntax or
+ * search chunk boundary, or quote prefix length.  @a till lets the caller skip
+ * re-resolving (and re-searching the syntax arrays) for every character of the
+ * run, as long as its `special` and `ansi` state hasn't changed either.
  */
-static void resolve_color(struct MuttWindow *win, struct Line *lines, int line_num,
-                          int cnt, PagerFlags flags, int special, struct AnsiColor *ansi)
+static void resolve_color(struct MuttWindow *win, struct Line *lines,
+                          int line_num, int cnt, PagerFlags flags, int special,
+                          struct AnsiColor *ansi, int *till)
 {
   struct AttrColor def_color = { 0 }; /* color without syntax highlight */
   struct AttrColor color = { 0 };     /* final color */
   static struct AttrColor last_color = { 0 }; /* last color set */
   bool search = false;
   int m;
+  int till_pos = INT_MAX;
+  const int cnt_orig = cnt;
   struct TextSyntax *matching_chunk = NULL;
 
   if (cnt == 0)
@@ -162,6 +171,12 @@ static void resolve_color(struct MuttWindow *win, struct Line *lines, int line_n
     {
       def_color = attr_color_copy(qc->attr_color);
 
+      for (struct QuoteStyle *q = qc; q; q = q->up)
+      {
+        if ((q->prefix_len > cnt) && (q->prefix_len < till_pos))
+          till_pos = q->prefix_len;
+      }
+
       while (qc && (qc->prefix_len > cnt))
       {
         def_color = attr_color_copy(qc->attr_color);
@@ -179,6 +194,19 @@ static void resolve_color(struct MuttWindow *win, struct Line *lines, int line_n
         (cnt < matching_chunk->last))
     {
       color = *matching_chunk->attr_color;
+      till_pos = MIN(till_pos, matching_chunk->last);
+    }
+    else
+    {
+      // Outside every chunk; stable until the next one starts
+      for (int i = 0; i < lines[m].syntax_arr_size; i++)
+      {
+        if (lines[m].syntax[i].first > cnt)
+        {
+          till_pos = MIN(till_pos, lines[m].syntax[i].first);
+          break;
+        }
+      }
     }
   }
 
@@ -191,6 +219,18 @@ static void resolve_color(struct MuttWindow *win, struct Line *lines, int line_n
     {
       color = *simple_color_get(MT_COLOR_SEARCH);
       search = true;
+      till_pos = MIN(till_pos, matching_chunk->last);
+    }
+    else
+    {
+      for (int i = 0; i < lines[m].search_arr_size; i++)
+      {
+        if (lines[m].search[i].first > cnt)
+        {
+          till_pos = MIN(till_pos, lines[m].search[i].first);
+          break;
+        }
+      }
     }
   }
 
@@ -219,6 +259,9 @@ static void resolve_color(struct MuttWindow *win, struct Line *lines, int line_n
     mutt_curses_set_color(&color);
     last_color = color;
   }
+
+  if (till)
+    *till = (till_pos == INT_MAX) ? INT_MAX : (till_pos - (cnt - cnt_orig));
 }
 
 /**
@@ -670,15 +713,18 @@ void mutt_buffer_strip_formatting(struct Buffer *dest, const char *src, bool str
  * fill_buffer - Fill a buffer from a file
  * @param[in]     fp         File to read from
  * @param[in,out] bytes_read End of last read
- * @param[in]     offset     Position start reading from
+ * @param[in,out] line       Line to read, using its cached text if present
  * @param[out]    buf        Buffer to fill
  * @param[out]    fmt        Copy of buffer, stripped of attributes
  * @param[out]    blen       Length of the buffer
  * @param[in,out] buf_ready  true if the buffer already has data in it
  * @retval >=0 Bytes read
  * @retval -1  Error
+ *
+ * The text of each Line is cached the first time it's read, so scrolling back
+ * (or redrawing) never seeks, reads or strips the file again.
  */
-static int fill_buffer(FILE *fp, LOFF_T *bytes_read, LOFF_T offset, unsigned char **buf,
+static int fill_buffer(FILE *fp, LOFF_T *bytes_read, struct Line *line, unsigned char **buf,
                        unsigned char **fmt, size_t *blen, int *buf_ready)
 {
   static int b_read;
@@ -686,9 +732,29 @@ static int fill_buffer(FILE *fp, LOFF_T *bytes_read, LOFF_T offset, unsigned cha
 
   if (*buf_ready == 0)
   {
-    if (offset != *bytes_read)
+    if (line->text)
+    {
+      /* we've been here before - serve the line from the cache */
+      b_read = line->text_len;
+      if (*blen < ((size_t) b_read + 1))
+      {
+        *blen = b_read + 1;
+        mutt_mem_realloc(buf, *blen);
+      }
+      memcpy(*buf, line->text, b_read + 1);
+
+      const size_t fmt_len = strlen((const char *) line->fmt);
+      FREE(fmt);
+      *fmt = mutt_mem_malloc(fmt_len + 1);
+      memcpy(*fmt, line->fmt, fmt_len + 1);
+
+      *buf_ready = 1;
+      return b_read;
+    }
+
+    if (line->offset != *bytes_read)
     {
-      if (!mutt_file_seek(fp, offset, SEEK_SET))
+      if (!mutt_file_seek(fp, line->offset, SEEK_SET))
       {
         return -1;
       }
@@ -702,7 +768,7 @@ static int fill_buffer(FILE *fp, LOFF_T *bytes_read, LOFF_T offset, unsigned cha
     }
 
     *bytes_read = ftello(fp);
-    b_read = (int) (*bytes_read - offset);
+    b_read = (int) (*bytes_read - line->offset);
     *buf_ready = 1;
 
     mutt_buffer_init(&stripped);
@@ -711,6 +777,15 @@ static int fill_buffer(FILE *fp, LOFF_T *bytes_read, LOFF_T offset, unsigned cha
     /* This should be a noop, because *fmt should be NULL */
     FREE(fmt);
     *fmt = (unsigned char *) stripped.data;
+
+    /* retain a copy for the next visit */
+    line->text_len = b_read;
+    line->text = mutt_mem_malloc(b_read + 1);
+    memcpy(line->text, *buf, b_read);
+    line->text[b_read] = '\0';
+    const size_t fmt_len = strlen((const char *) *fmt);
+    line->fmt = mutt_mem_malloc(fmt_len + 1);
+    memcpy(line->fmt, *fmt, fmt_len + 1);
   }
 
   return b_read;
@@ -743,6 +818,9 @@ static int format_line(struct MuttWindow *win, struct Line **lines, int line_num
   size_t col = c_markers ? (*lines)[line_num].cont_line : 0;
   size_t k;
   int ch, vch, last_special = -1, special = 0, t;
+  int color_till = 0; // first offset where the colour must be re-resolved
+  const struct AttrColor *last_ansi_color = NULL;
+  int last_ansi_attrs = -1;
   wchar_t wc = 0;
   mbstate_t mbstate = { 0 }; // FIXME: this should come from lines
   const size_t c_wrap = cs_subset_number(NeoMutt->sub, "wrap");
@@ -845,7 +923,15 @@ static int format_line(struct MuttWindow *win, struct Line **lines, int line_num
     if (ansi && ((flags & (MUTT_SHOWCOLOR | MUTT_SEARCH | MUTT_PAGER_MARKER)) ||
                  special || last_special || ansi->attrs))
     {
-      resolve_color(win, *lines, line_num, vch, flags, special, ansi);
+      /* The colour is constant over a run of characters, so only re-resolve
+       * it at a run boundary, or when the overstrike/ansi state changes */
+      if ((vch >= color_till) || (special != last_special) ||
+          (ansi->attr_color != last_ansi_color) || (ansi->attrs != last_ansi_attrs))
+      {
+        resolve_color(win, *lines, line_num, vch, flags, special, ansi, &color_till);
+        last_ansi_color = ansi->attr_color;
+        last_ansi_attrs = ansi->attrs;
+      }
       last_special = special;
       // memset(ansi, 0, sizeof(*ansi));
     }
@@ -923,6 +1009,7 @@ static int format_line(struct MuttWindow *win, struct Line **lines, int line_num
  * @param[out] q_level         Level of quoting
  * @param[out] force_redraw    Force a repaint
  * @param[out] search_re       Regex to highlight
+ * @param[in]  search_str      String search_re was compiled from
  * @param[in]  win_pager       Window to draw into
  * @param[in]  ansi_list       List of ANSI colours/attributes
  * @retval -1 EOF was reached
@@ -932,7 +1019,7 @@ static int format_line(struct MuttWindow *win, struct Line **lines, int line_num
 int display_line(FILE *fp, LOFF_T *bytes_read, struct Line **lines,
                  int line_num, int *lines_used, int *lines_max,
                  PagerFlags flags, struct QuoteStyle **quote_list, int *q_level,
-                 bool *force_redraw, regex_t *search_re,
+                 bool *force_redraw, regex_t *search_re, const char *search_str,
                  struct MuttWindow *win_pager, struct AttrColorList *ansi_list)
 {
   unsigned char *buf = NULL, *fmt = NULL;
@@ -974,7 +1061,7 @@ int display_line(FILE *fp, LOFF_T *bytes_read, struct Line **lines,
   if (flags & MUTT_PAGER_LOGS)
   {
     /* determine the line class */
-    if (fill_buffer(fp, bytes_read, cur_line->offset, &buf, &fmt, &buflen, &buf_ready) < 0)
+    if (fill_buffer(fp, bytes_read, cur_line, &buf, &fmt, &buflen, &buf_ready) < 0)
     {
       if (change_last)
         (*lines_used)--;
@@ -998,7 +1085,7 @@ int display_line(FILE *fp, LOFF_T *bytes_read, struct Line **lines,
     if (cur_line->cid == -1)
     {
       /* determine the line class */
-      if (fill_buffer(fp, bytes_read, cur_line->offset, &buf, &fmt, &buflen, &buf_ready) < 0)
+      if (fill_buffer(fp, bytes_read, cur_line, &buf, &fmt, &buflen, &buf_ready) < 0)
       {
         if (change_last)
           (*lines_used)--;
@@ -1034,7 +1121,7 @@ int display_line(FILE *fp, LOFF_T *bytes_read, struct Line **lines,
   if ((flags & MUTT_SHOWCOLOR) && !cur_line->cont_line &&
       (cur_line->cid == MT_COLOR_QUOTED) && !cur_line->quote)
   {
-    if (fill_buffer(fp, bytes_read, cur_line->offset, &buf, &fmt, &buflen, &buf_ready) < 0)
+    if (fill_buffer(fp, bytes_read, cur_line, &buf, &fmt, &buflen, &buf_ready) < 0)
     {
       if (change_last)
         (*lines_used)--;
@@ -1057,7 +1144,7 @@ int display_line(FILE *fp, LOFF_T *bytes_read, struct Line **lines,
 
   if ((flags & MUTT_SEARCH) && !cur_line->cont_line && (cur_line->search_arr_size == -1))
   {
-    if (fill_buffer(fp, bytes_read, cur_line->offset, &buf, &fmt, &buflen, &buf_ready) < 0)
+    if (fill_buffer(fp, bytes_read, cur_line, &buf, &fmt, &buflen, &buf_ready) < 0)
     {
       if (change_last)
         (*lines_used)--;
@@ -1066,9 +1153,28 @@ int display_line(FILE *fp, LOFF_T *bytes_read, struct Line **lines,
 
     offset = 0;
     cur_line->search_arr_size = 0;
-    while (regexec(search_re, (char *) fmt + offset, 1, pmatch,
-                   (offset ? REG_NOTBOL : 0)) == 0)
+    const bool literal = mutt_regex_is_literal(search_str);
+    const bool icase = literal && mutt_mb_is_lower(search_str);
+    const size_t search_len = literal ? mutt_str_len(search_str) : 0;
+    while (true)
     {
+      if (literal)
+      {
+        /* a literal query doesn't need the regex engine - a substring scan
+         * finds the same matches */
+        const char *found = icase ? mutt_istr_find((char *) fmt + offset, search_str) :
+                                    strstr((char *) fmt + offset, search_str);
+        if (!found)
+          break;
+        pmatch[0].rm_so = found - ((char *) fmt + offset);
+        pmatch[0].rm_eo = pmatch[0].rm_so + search_len;
+      }
+      else if (regexec(search_re, (char *) fmt + offset, 1, pmatch,
+                       (offset ? REG_NOTBOL : 0)) != 0)
+      {
+        break;
+      }
+
       if (++(cur_line->search_arr_size) > 1)
       {
         mutt_mem_realloc(&(cur_line->search),
@@ -1105,7 +1211,7 @@ int display_line(FILE *fp, LOFF_T *bytes_read, struct Line **lines,
     goto out; /* fake display */
   }
 
-  b_read = fill_buffer(fp, bytes_read, cur_line->offset, &buf, &fmt, &buflen, &buf_ready);
+  b_read = fill_buffer(fp, bytes_read, cur_line, &buf, &fmt, &buflen, &buf_ready);
   if (b_read < 0)
   {
     if (change_last)
@@ -1176,7 +1282,7 @@ int display_line(FILE *fp, LOFF_T *bytes_read, struct Line **lines,
 
   /* end the last color pattern (needed by S-Lang) */
   if (special || ((col != win_pager->state.cols) && (flags & (MUTT_SHOWCOLOR | MUTT_SEARCH))))
-    resolve_color(win_pager, *lines, line_num, vch, flags, 0, &ansi);
+    resolve_color(win_pager, *lines, line_num, vch, flags, 0, &ansi, NULL);
 
   /* Fill the blank space at the end of the line with the prevailing color.
    * ncurses does an implicit clrtoeol() when you do mutt_window_addch('\n') so we have
@@ -60,11 +60,16 @@ struct Line
   struct TextSyntax *search; ///< Array of search text in the line
 
   struct QuoteStyle *quote;  ///< Quoting style for this line (pointer into PagerPrivateData->quote_list)
+
+  int text_len;              ///< Length of the cached raw text
+  unsigned char *text;       ///< Cached raw text, so back-scrolling doesn't re-read the file
+  unsigned char *fmt;        ///< Cached text, stripped of formatting
 };
 
 int display_line(FILE *fp, LOFF_T *bytes_read, struct Line **lines,
                  int line_num, int *lines_used, int *lines_max, PagerFlags flags,
                  struct QuoteStyle **quote_list, int *q_level, bool *force_redraw,
-                 regex_t *search_re, struct MuttWindow *win_pager, struct AttrColorList *ansi_list);
+                 regex_t *search_re, const char *search_str,
+                 struct MuttWindow *win_pager, struct AttrColorList *ansi_list);
 
 #endif /* MUTT_PAGER_DISPLAY_H */
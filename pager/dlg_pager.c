@@ -276,6 +276,11 @@ static void pager_custom_redraw(struct PagerPrivateData *priv)
         mutt_mem_realloc(&(priv->lines[i].syntax), sizeof(struct TextSyntax));
         if (priv->search_compiled && priv->lines[i].search)
           FREE(&(priv->lines[i].search));
+
+        /* reflowing moves the line boundaries, so the cached text is stale */
+        priv->lines[i].text_len = 0;
+        FREE(&(priv->lines[i].text));
+        FREE(&(priv->lines[i].fmt));
       }
 
       if (!repopulate)
@@ -290,7 +295,7 @@ static void pager_custom_redraw(struct PagerPrivateData *priv)
                         &priv->lines_used, &priv->lines_max,
                         priv->has_types | priv->search_flag | (priv->pview->flags & MUTT_PAGER_NOWRAP),
                         &priv->quote_list, &priv->q_level, &priv->force_redraw,
-                        &priv->search_re, priv->pview->win_pager, &priv->ansi_list) == 0)
+                        &priv->search_re, priv->search_str, priv->pview->win_pager, &priv->ansi_list) == 0)
     {
       if (!priv->lines[i].cont_line && (++j == priv->win_height))
       {
@@ -320,7 +325,7 @@ static void pager_custom_redraw(struct PagerPrivateData *priv)
                          (priv->pview->flags & MUTT_DISPLAYFLAGS) | priv->hide_quoted |
                              priv->search_flag | (priv->pview->flags & MUTT_PAGER_NOWRAP),
                          &priv->quote_list, &priv->q_level, &priv->force_redraw,
-                         &priv->search_re, priv->pview->win_pager, &priv->ansi_list) > 0)
+                         &priv->search_re, priv->search_str, priv->pview->win_pager, &priv->ansi_list) > 0)
         {
           priv->win_height++;
         }
@@ -890,6 +895,8 @@ int mutt_pager(struct PagerView *pview)
     FREE(&(priv->lines[i].syntax));
     if (priv->search_compiled && priv->lines[i].search)
       FREE(&(priv->lines[i].search));
+    FREE(&(priv->lines[i].text));
+    FREE(&(priv->lines[i].fmt));
   }
   if (priv->search_compiled)
   {
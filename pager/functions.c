@@ -200,7 +200,7 @@ bool jump_to_bottom(struct PagerPrivateData *priv, struct PagerView *pview)
                       &priv->lines_used, &priv->lines_max,
                       priv->has_types | (pview->flags & MUTT_PAGER_NOWRAP),
                       &priv->quote_list, &priv->q_level, &priv->force_redraw,
-                      &priv->search_re, priv->pview->win_pager, &priv->ansi_list) == 0)
+                      &priv->search_re, priv->search_str, priv->pview->win_pager, &priv->ansi_list) == 0)
   {
     line_num++;
   }
@@ -469,7 +469,7 @@ static int op_pager_search(struct IndexSharedData *shared,
                         MUTT_SEARCH | (pview->flags & MUTT_PAGER_NSKIP) |
                             (pview->flags & MUTT_PAGER_NOWRAP) | priv->has_types,
                         &priv->quote_list, &priv->q_level, &priv->force_redraw,
-                        &priv->search_re, priv->pview->win_pager, &priv->ansi_list) == 0)
+                        &priv->search_re, priv->search_str, priv->pview->win_pager, &priv->ansi_list) == 0)
     {
       line_num++;
     }
@@ -646,7 +646,7 @@ static int op_pager_skip_headers(struct IndexSharedData *shared,
                      priv->fp, &priv->bytes_read, &priv->lines, new_topline, &priv->lines_used,
                      &priv->lines_max, MUTT_TYPES | (pview->flags & MUTT_PAGER_NOWRAP),
                      &priv->quote_list, &priv->q_level, &priv->force_redraw,
-                     &priv->search_re, priv->pview->win_pager, &priv->ansi_list)))) &&
+                     &priv->search_re, priv->search_str, priv->pview->win_pager, &priv->ansi_list)))) &&
          simple_color_is_header(priv->lines[new_topline].cid))
   {
     new_topline++;
@@ -691,7 +691,7 @@ static int op_pager_skip_quoted(struct IndexSharedData *shared,
                        priv->fp, &priv->bytes_read, &priv->lines, new_topline, &priv->lines_used,
                        &priv->lines_max, MUTT_TYPES | (pview->flags & MUTT_PAGER_NOWRAP),
                        &priv->quote_list, &priv->q_level, &priv->force_redraw,
-                       &priv->search_re, priv->pview->win_pager, &priv->ansi_list)))) &&
+                       &priv->search_re, priv->search_str, priv->pview->win_pager, &priv->ansi_list)))) &&
            simple_color_is_header(priv->lines[new_topline].cid))
     {
       new_topline++;
@@ -709,7 +709,7 @@ static int op_pager_skip_quoted(struct IndexSharedData *shared,
                        priv->fp, &priv->bytes_read, &priv->lines, new_topline, &priv->lines_used,
                        &priv->lines_max, MUTT_TYPES | (pview->flags & MUTT_PAGER_NOWRAP),
                        &priv->quote_list, &priv->q_level, &priv->force_redraw,
-                       &priv->search_re, priv->pview->win_pager, &priv->ansi_list)))) &&
+                       &priv->search_re, priv->search_str, priv->pview->win_pager, &priv->ansi_list)))) &&
            (priv->lines[new_topline].cid == MT_COLOR_QUOTED))
     {
       new_topline++;
@@ -732,7 +732,7 @@ static int op_pager_skip_quoted(struct IndexSharedData *shared,
                        priv->fp, &priv->bytes_read, &priv->lines, new_topline, &priv->lines_used,
                        &priv->lines_max, MUTT_TYPES | (pview->flags & MUTT_PAGER_NOWRAP),
                        &priv->quote_list, &priv->q_level, &priv->force_redraw,
-                       &priv->search_re, priv->pview->win_pager, &priv->ansi_list)))) &&
+                       &priv->search_re, priv->search_str, priv->pview->win_pager, &priv->ansi_list)))) &&
            (priv->lines[new_topline].cid != MT_COLOR_QUOTED))
     {
       new_topline++;
@@ -749,7 +749,7 @@ static int op_pager_skip_quoted(struct IndexSharedData *shared,
                        priv->fp, &priv->bytes_read, &priv->lines, new_topline, &priv->lines_used,
                        &priv->lines_max, MUTT_TYPES | (pview->flags & MUTT_PAGER_NOWRAP),
                        &priv->quote_list, &priv->q_level, &priv->force_redraw,
-                       &priv->search_re, priv->pview->win_pager, &priv->ansi_list)))) &&
+                       &priv->search_re, priv->search_str, priv->pview->win_pager, &priv->ansi_list)))) &&
            (priv->lines[new_topline].cid == MT_COLOR_QUOTED))
     {
       new_topline++;
@@ -30,6 +30,7 @@
 #include <errno.h>
 #include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include <unistd.h>
 #include "mutt/lib.h"
 #include "config/lib.h"
@@ -59,6 +60,145 @@
 
 static const char *ExtPagerProgress = N_("all");
 
+/// Number of rendered messages kept for instant redisplay
+#define RENDER_CACHE_SIZE 8
+
+/**
+ * struct RenderedEmail - A fully-rendered message, kept for redisplay
+ */
+struct RenderedEmail
+{
+  size_t sequence; ///< Email::sequence of the rendered Email
+  int wrap_len;    ///< Width the message was rendered at
+  char *path;      ///< File holding the rendered text
+};
+
+/// Recently rendered messages, most recent first
+static struct RenderedEmail RenderCache[RENDER_CACHE_SIZE] = { 0 };
+/// Has render_config_observer() been registered?
+static bool RenderObserverAdded = false;
+
+/**
+ * render_cache_flush - Discard all the cached renderings
+ */
+static void render_cache_flush(void)
+{
+  for (int i = 0; i < RENDER_CACHE_SIZE; i++)
+  {
+    if (!RenderCache[i].path)
+      continue;
+    unlink(RenderCache[i].path);
+    FREE(&RenderCache[i].path);
+  }
+}
+
+/**
+ * render_config_observer - Notification that a Config Variable has changed - Implements ::observer_t - @ingroup observer_api
+ *
+ * Almost any setting can change what the handlers write, so a config change
+ * invalidates every rendered message.
+ */
+static int render_config_observer(struct NotifyCallback *nc)
+{
+  if (nc->event_type != NT_CONFIG)
+    return 0;
+
+  render_cache_flush();
+  mutt_debug(LL_DEBUG5, "config done, render cache flushed\n");
+  return 0;
+}
+
+/**
+ * render_cacheable - Can a rendering of this Email be reused?
+ * @param e Email
+ * @retval true The rendered text will be the same next time
+ *
+ * Crypto re-verifies and may prompt on every display, and the display filter
+ * need not be a pure function of the message.
+ */
+static bool render_cacheable(struct Email *e)
+{
+  if ((WithCrypto != 0) && (e->security & (SEC_ENCRYPT | SEC_SIGN)))
+    return false;
+
+  return !cs_subset_string(NeoMutt->sub, "display_filter");
+}
+
+/**
+ * render_cache_get - Fetch a rendered message from the cache
+ * @param[in]  e        Email
+ * @param[in]  wrap_len Width the message must be rendered at
+ * @param[out] tempfile Filename of a fresh copy of the rendering
+ * @retval true Success, tempfile is ready for the pager
+ *
+ * The pager deletes the file it's given, so the caller gets a hard link to
+ * the cached rendering, not the cached file itself.
+ */
+static bool render_cache_get(struct Email *e, int wrap_len, struct Buffer *tempfile)
+{
+  for (int i = 0; i < RENDER_CACHE_SIZE; i++)
+  {
+    struct RenderedEmail *re = &RenderCache[i];
+    if (!re->path || (re->sequence != e->sequence) || (re->wrap_len != wrap_len))
+      continue;
+
+    mutt_buffer_mktemp(tempfile);
+    if (link(re->path, mutt_buffer_string(tempfile)) != 0)
+      return false;
+
+    /* move the hit to the front */
+    struct RenderedEmail hit = *re;
+    memmove(&RenderCache[1], &RenderCache[0], i * sizeof(hit));
+    RenderCache[0] = hit;
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * render_cache_add - Remember a rendered message
+ * @param e        Email
+ * @param wrap_len Width the message was rendered at
+ * @param path     File holding the rendered text
+ *
+ * The cache keeps a hard link to the rendering; the pager is free to delete
+ * the original.  The least recently displayed message makes room.
+ */
+static void render_cache_add(struct Email *e, int wrap_len, const char *path)
+{
+  struct Buffer *keep = mutt_buffer_pool_get();
+  mutt_buffer_mktemp(keep);
+  if (link(path, mutt_buffer_string(keep)) == 0)
+  {
+    struct RenderedEmail *last = &RenderCache[RENDER_CACHE_SIZE - 1];
+    if (last->path)
+    {
+      unlink(last->path);
+      FREE(&last->path);
+    }
+    memmove(&RenderCache[1], &RenderCache[0],
+            (RENDER_CACHE_SIZE - 1) * sizeof(RenderCache[0]));
+    RenderCache[0].sequence = e->sequence;
+    RenderCache[0].wrap_len = wrap_len;
+    RenderCache[0].path = mutt_buffer_strdup(keep);
+  }
+  mutt_buffer_pool_release(&keep);
+}
+
+/**
+ * mutt_render_cache_cleanup - Free the rendered-message cache
+ */
+void mutt_render_cache_cleanup(void)
+{
+  if (RenderObserverAdded)
+  {
+    notify_observer_remove(NeoMutt->notify, render_config_observer, NULL);
+    RenderObserverAdded = false;
+  }
+  render_cache_flush();
+}
+
 /**
  * process_protected_headers - Get the protected header and update the index
  * @param m Mailbox
@@ -182,9 +322,6 @@ static int email_to_file(struct Message *msg, struct Buffer *tempfile,
   int rc = 0;
   pid_t filterpid = -1;
 
-  mutt_parse_mime_message(e, msg->fp);
-  mutt_message_hook(m, e, MUTT_MESSAGE_HOOK);
-
   char columns[16];
   // win_pager might not be visible and have a size yet, so use win_index
   snprintf(columns, sizeof(columns), "%d", wrap_len);
@@ -296,6 +433,8 @@ static int email_to_file(struct Message *msg, struct Buffer *tempfile,
     /* Remove color cache for this message, in case there
      * are color patterns for both ~g and ~V */
     e->attr_color = NULL;
+    e->index_color_valid = false;
+    FREE(&e->display); /* %Z shows the crypto state */
 
     /* Process protected headers and autocrypt gossip headers */
     process_protected_headers(m, e);
@@ -320,6 +459,9 @@ int external_pager(struct Mailbox *m, struct Email *e, const char *command)
   if (!msg)
     return -1;
 
+  mutt_parse_mime_message(e, msg->fp);
+  mutt_message_hook(m, e, MUTT_MESSAGE_HOOK);
+
   char buf[1024] = { 0 };
   const char *const c_pager_format =
       cs_subset_string(NeoMutt->sub, "pager_format");
@@ -414,16 +556,35 @@ int mutt_display_message(struct MuttWindow *win_index, struct MuttWindow *win_pa
   if (!msg)
     return -1;
 
+  if (!RenderObserverAdded)
+  {
+    notify_observer_add(NeoMutt->notify, NT_CONFIG, render_config_observer, NULL);
+    RenderObserverAdded = true;
+  }
+
   struct Buffer *tempfile = mutt_buffer_pool_get();
 
   CopyMessageFlags cmflags = MUTT_CM_DECODE | MUTT_CM_DISPLAY | MUTT_CM_CHARCONV;
 
+  /* hooks may change settings, which flushes the render cache */
+  mutt_parse_mime_message(e, msg->fp);
+  mutt_message_hook(m, e, MUTT_MESSAGE_HOOK);
+
   // win_pager might not be visible and have a size yet, so use win_index
-  int rc = email_to_file(msg, tempfile, m, e, NULL, win_index->state.cols, &cmflags);
-  if (rc < 0)
-    goto cleanup;
+  const int wrap_len = win_index->state.cols;
 
-  notify_crypto(e, msg, cmflags);
+  int rc = 0;
+  if (!render_cacheable(e) || !render_cache_get(e, wrap_len, tempfile))
+  {
+    rc = email_to_file(msg, tempfile, m, e, NULL, wrap_len, &cmflags);
+    if (rc < 0)
+      goto cleanup;
+
+    notify_crypto(e, msg, cmflags);
+
+    if (render_cacheable(e))
+      render_cache_add(e, wrap_len, mutt_buffer_string(tempfile));
+  }
 
   /* Invoke the builtin pager */
   struct PagerData pdata = { 0 };
@@ -0,0 +1,357 @@
+/**
+ * @file
+ * Cache of compiled patterns and their match results
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page pattern_cache Cache of compiled patterns and their match results
+ *
+ * Users apply the same few limit and search patterns over and over, but each
+ * application used to re-parse the string and re-regcomp every regex.  Keep a
+ * small table of compiled patterns, keyed by the (expanded) pattern string and
+ * compile flags, together with the last per-message match results so that
+ * re-applying an unchanged limit to an unchanged mailbox skips execution too.
+ *
+ * Cached patterns are compiled with #MUTT_PC_PATTERN_DYNAMIC, so relative
+ * date ranges such as `~d>1w` stay correct however long the entry lives.
+ * Match results are never kept for such patterns, and patterns that depend on
+ * the compile-time cursor position (message number ranges) are not cached at
+ * all.  Any config change drops the table; mailbox, email and account events
+ * invalidate the stored match results.
+ */
+
+#include "config.h"
+#include <stddef.h>
+#include <string.h>
+#include "private.h"
+#include "mutt/lib.h"
+#include "core/lib.h"
+#include "lib.h"
+
+#define PATTERN_CACHE_SIZE 16 ///< Number of compiled patterns to keep
+
+/**
+ * struct CachedPattern - A compiled pattern and its last match results
+ */
+struct CachedPattern
+{
+  char *str;               ///< Pattern string it was compiled from
+  PatternCompFlags pflags; ///< Flags it was compiled with
+  struct PatternList *pat; ///< Compiled pattern
+  short refs;              ///< References handed out by pattern_cache_comp()
+  bool stale;              ///< Flushed while referenced; free on last release
+  struct Mailbox *mailbox; ///< Mailbox the match results refer to
+  size_t gen;              ///< Value of #CacheGen when the results were stored
+  int num_matches;         ///< Number of entries in matches
+  bool *matches;           ///< Per-message match results, in Mailbox order
+};
+
+static struct CachedPattern PatCache[PATTERN_CACHE_SIZE];
+
+/// Bumped on every mailbox/email event; stored results must match to be valid
+static size_t CacheGen = 1;
+
+/// Has the cache registered its observer yet?
+static bool CacheObserverAdded = false;
+
+/**
+ * cached_pattern_free - Free one cache entry
+ * @param cp Entry to free
+ */
+static void cached_pattern_free(struct CachedPattern *cp)
+{
+  mutt_pattern_free(&cp->pat);
+  FREE(&cp->str);
+  FREE(&cp->matches);
+  memset(cp, 0, sizeof(*cp));
+}
+
+/**
+ * pattern_cache_flush - Drop every unreferenced cache entry
+ *
+ * Entries still referenced by a caller are marked stale and freed by
+ * pattern_cache_release().
+ */
+static void pattern_cache_flush(void)
+{
+  for (size_t i = 0; i < PATTERN_CACHE_SIZE; i++)
+  {
+    struct CachedPattern *cp = &PatCache[i];
+    if (!cp->pat)
+      continue;
+    if (cp->refs > 0)
+      cp->stale = true;
+    else
+      cached_pattern_free(cp);
+  }
+}
+
+/**
+ * pattern_cache_observer - Notification that something has changed - Implements ::observer_t - @ingroup observer_api
+ *
+ * Config changes may alter what a pattern string means or matches, so they
+ * drop the whole table.  Mailbox, Email and Account events only invalidate
+ * the stored match results, by bumping #CacheGen.
+ */
+static int pattern_cache_observer(struct NotifyCallback *nc)
+{
+  if (!nc)
+    return -1;
+
+  if (nc->event_type == NT_CONFIG)
+  {
+    pattern_cache_flush();
+    mutt_debug(LL_DEBUG5, "config done, pattern cache flushed\n");
+  }
+  else if ((nc->event_type == NT_MAILBOX) || (nc->event_type == NT_EMAIL) ||
+           (nc->event_type == NT_ACCOUNT))
+  {
+    CacheGen++;
+  }
+
+  return 0;
+}
+
+/**
+ * pattern_positional - Does a pattern depend on the compile-time position?
+ * @param pats Pattern list to check
+ * @retval true The pattern contains a message number range
+ *
+ * Message number ranges are resolved against the current message when the
+ * pattern is compiled, so the compiled form can't be reused later.
+ */
+static bool pattern_positional(struct PatternList *pats)
+{
+  struct Pattern *np = NULL;
+  SLIST_FOREACH(np, pats, entries)
+  {
+    if (np->op == MUTT_PAT_MESSAGE)
+      return true;
+    if (np->child && pattern_positional(np->child))
+      return true;
+  }
+  return false;
+}
+
+/**
+ * pattern_dynamic - Does a pattern contain a runtime date range?
+ * @param pats Pattern list to check
+ * @retval true The pattern matches differently as time passes
+ */
+static bool pattern_dynamic(struct PatternList *pats)
+{
+  struct Pattern *np = NULL;
+  SLIST_FOREACH(np, pats, entries)
+  {
+    if (np->dynamic)
+      return true;
+    if (np->child && pattern_dynamic(np->child))
+      return true;
+  }
+  return false;
+}
+
+/**
+ * pattern_cache_find - Find the cache entry owning a compiled pattern
+ * @param pat Compiled pattern
+ * @retval ptr  Matching entry
+ * @retval NULL Pattern isn't cached
+ */
+static struct CachedPattern *pattern_cache_find(struct PatternList *pat)
+{
+  for (size_t i = 0; i < PATTERN_CACHE_SIZE; i++)
+  {
+    if (PatCache[i].pat == pat)
+      return &PatCache[i];
+  }
+  return NULL;
+}
+
+/**
+ * pattern_cache_comp - Compile a pattern, reusing a cached copy if possible
+ * @param m     Mailbox
+ * @param menu  Current Menu
+ * @param s     Pattern string
+ * @param flags Flags, e.g. #MUTT_PC_FULL_MSG
+ * @param err   Buffer for error messages
+ * @retval ptr Compiled pattern
+ *
+ * The result must be released with pattern_cache_release(), not
+ * mutt_pattern_free().
+ *
+ * @note Pass the pattern string after mutt_check_simple() expansion, so the
+ *       cache key doesn't depend on `$simple_search`
+ */
+struct PatternList *pattern_cache_comp(struct Mailbox *m, struct Menu *menu, const char *s,
+                                       PatternCompFlags flags, struct Buffer *err)
+{
+  if (!CacheObserverAdded && NeoMutt)
+  {
+    notify_observer_add(NeoMutt->notify, NT_ALL, pattern_cache_observer, NULL);
+    CacheObserverAdded = true;
+  }
+
+  for (size_t i = 0; i < PATTERN_CACHE_SIZE; i++)
+  {
+    struct CachedPattern *cp = &PatCache[i];
+    if (cp->pat && !cp->stale && (cp->pflags == flags) && mutt_str_equal(cp->str, s))
+    {
+      cp->refs++;
+      mutt_debug(LL_DEBUG2, "pattern cache hit: %s\n", s);
+      return cp->pat;
+    }
+  }
+
+  /* Compile as dynamic, so relative date ranges stay correct on reuse */
+  struct PatternList *pat =
+      mutt_pattern_comp(m, menu, s, flags | MUTT_PC_PATTERN_DYNAMIC, err);
+  if (!pat)
+    return NULL;
+
+  if (pattern_positional(pat))
+    return pat; /* uncached; pattern_cache_release() will free it */
+
+  struct CachedPattern *empty = NULL;
+  for (size_t i = 0; i < PATTERN_CACHE_SIZE; i++)
+  {
+    struct CachedPattern *cp = &PatCache[i];
+    if (!cp->pat)
+    {
+      empty = cp;
+      break;
+    }
+    if (!empty && (cp->refs == 0))
+      empty = cp; /* evict the first unreferenced entry */
+  }
+  if (!empty)
+    return pat; /* table full of referenced entries; hand it out uncached */
+
+  if (empty->pat)
+    cached_pattern_free(empty);
+
+  empty->str = mutt_str_dup(s);
+  empty->pflags = flags;
+  empty->pat = pat;
+  empty->refs = 1;
+  return pat;
+}
+
+/**
+ * pattern_cache_release - Release a pattern obtained from pattern_cache_comp()
+ * @param[out] pat Compiled pattern to release
+ *
+ * Cached patterns stay in the table for reuse; uncached ones are freed.
+ */
+void pattern_cache_release(struct PatternList **pat)
+{
+  if (!pat || !*pat)
+    return;
+
+  struct CachedPattern *cp = pattern_cache_find(*pat);
+  if (cp)
+  {
+    cp->refs--;
+    if (cp->stale && (cp->refs == 0))
+      cached_pattern_free(cp);
+    *pat = NULL;
+  }
+  else
+  {
+    mutt_pattern_free(pat);
+  }
+}
+
+/**
+ * pattern_cache_get_results - Fetch cached match results for a pattern
+ * @param pat     Compiled pattern from pattern_cache_comp()
+ * @param m       Mailbox the pattern is being applied to
+ * @param matches Array to fill with the per-message results
+ * @param num     Number of entries in matches, i.e. Mailbox::msg_count
+ * @retval true The results were still valid and have been copied out
+ */
+bool pattern_cache_get_results(struct PatternList *pat, struct Mailbox *m,
+                               bool *matches, int num)
+{
+  struct CachedPattern *cp = pattern_cache_find(pat);
+  if (!cp || !cp->matches)
+    return false;
+  if ((cp->mailbox != m) || (cp->gen != CacheGen) || (cp->num_matches != num))
+    return false;
+
+  memcpy(matches, cp->matches, num * sizeof(bool));
+  mutt_debug(LL_DEBUG2, "pattern cache: reusing %d match results for %s\n", num, cp->str);
+  return true;
+}
+
+/**
+ * pattern_cache_set_results - Store the match results for a pattern
+ * @param pat     Compiled pattern from pattern_cache_comp()
+ * @param m       Mailbox the pattern was applied to
+ * @param matches Per-message results, in Mailbox order
+ * @param num     Number of entries in matches, i.e. Mailbox::msg_count
+ *
+ * Results for patterns with runtime date ranges are not kept: they can go
+ * stale without any mailbox event.
+ */
+void pattern_cache_set_results(struct PatternList *pat, struct Mailbox *m,
+                               const bool *matches, int num)
+{
+  struct CachedPattern *cp = pattern_cache_find(pat);
+  if (!cp || pattern_dynamic(pat))
+    return;
+
+  FREE(&cp->matches);
+  cp->matches = mutt_mem_malloc(num * sizeof(bool));
+  memcpy(cp->matches, matches, num * sizeof(bool));
+  cp->mailbox = m;
+  cp->gen = CacheGen;
+  cp->num_matches = num;
+}
+
+/**
+ * pattern_cache_generation - Get the current cache generation
+ * @retval num Generation counter
+ *
+ * The generation is bumped on every mailbox, email and account event, so any
+ * derived data tagged with it (match results, the trigram index) can tell
+ * whether the messages may have changed underneath it.
+ */
+size_t pattern_cache_generation(void)
+{
+  return CacheGen;
+}
+
+/**
+ * mutt_pattern_cache_cleanup - Free the pattern cache
+ */
+void mutt_pattern_cache_cleanup(void)
+{
+  if (CacheObserverAdded && NeoMutt)
+  {
+    notify_observer_remove(NeoMutt->notify, pattern_cache_observer, NULL);
+    CacheObserverAdded = false;
+  }
+
+  for (size_t i = 0; i < PATTERN_CACHE_SIZE; i++)
+  {
+    if (PatCache[i].pat)
+      cached_pattern_free(&PatCache[i]);
+  }
+}
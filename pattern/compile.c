@@ -97,6 +97,8 @@ static bool eat_regex(struct Pattern *pat, PatternCompFlags flags,
     return false;
   }
 
+  pat->raw_pattern = mutt_str_dup(buf.data);
+
   if (pat->string_match)
   {
     pat->p.str = mutt_str_dup(buf.data);
@@ -112,6 +114,10 @@ static bool eat_regex(struct Pattern *pat, PatternCompFlags flags,
   {
     pat->p.regex = mutt_mem_calloc(1, sizeof(regex_t));
     uint16_t case_flags = mutt_mb_is_lower(buf.data) ? REG_ICASE : 0;
+    pat->literal = mutt_regex_is_literal(buf.data);
+    pat->ign_case = (case_flags != 0);
+    if (!pat->literal)
+      pat->prefilter = mutt_regex_prefilter(buf.data);
     int rc = REG_COMP(pat->p.regex, buf.data, REG_NEWLINE | REG_NOSUB | case_flags);
     if (rc != 0)
     {
@@ -1057,6 +1063,8 @@ void mutt_pattern_free(struct PatternList **pat)
       regfree(np->p.regex);
       FREE(&np->p.regex);
     }
+    FREE(&np->raw_pattern);
+    FREE(&np->prefilter);
 
     mutt_pattern_free(&np->child);
     FREE(&np);
@@ -1067,6 +1075,111 @@ void mutt_pattern_free(struct PatternList **pat)
   FREE(pat);
 }
 
+/**
+ * pattern_prog_emit - Append one instruction to a Pattern program
+ * @param prog Program to extend
+ * @param op   Opcode, e.g. #PAT_INSTR_MATCH
+ * @param pat  Pattern node, for #PAT_INSTR_MATCH
+ * @retval num Index of the new instruction
+ */
+static int pattern_prog_emit(struct PatternProg *prog, enum PatternInstrOp op,
+                             struct Pattern *pat)
+{
+  if (prog->num_instr == prog->max_instr)
+  {
+    prog->max_instr = prog->max_instr ? (prog->max_instr * 2) : 16;
+    mutt_mem_realloc(&prog->instr, prog->max_instr * sizeof(struct PatternInstr));
+  }
+
+  struct PatternInstr *instr = &prog->instr[prog->num_instr];
+  instr->op = op;
+  instr->pat = pat;
+  instr->jump = -1;
+  return prog->num_instr++;
+}
+
+/**
+ * pattern_prog_node - Flatten one Pattern node into a program
+ * @param prog Program to extend
+ * @param pat  Pattern node to flatten
+ *
+ * AND/OR nodes become short-circuit jumps around their remaining children.
+ * Every other node, including the thread-scoped ones which carry their own
+ * sub-tree, is emitted as a single #PAT_INSTR_MATCH.
+ */
+static void pattern_prog_node(struct PatternProg *prog, struct Pattern *pat)
+{
+  if ((pat->op != MUTT_PAT_AND) && (pat->op != MUTT_PAT_OR))
+  {
+    pattern_prog_emit(prog, PAT_INSTR_MATCH, pat);
+    return;
+  }
+
+  const enum PatternInstrOp jop = (pat->op == MUTT_PAT_AND) ?
+                                      PAT_INSTR_JUMP_IF_FALSE :
+                                      PAT_INSTR_JUMP_IF_TRUE;
+
+  /* Pending jumps are chained through their jump fields, then back-patched to
+   * point past the last child */
+  int chain = -1;
+  struct Pattern *p = NULL;
+  SLIST_FOREACH(p, pat->child, entries)
+  {
+    pattern_prog_node(prog, p);
+    if (SLIST_NEXT(p, entries))
+    {
+      int idx = pattern_prog_emit(prog, jop, NULL);
+      prog->instr[idx].jump = chain;
+      chain = idx;
+    }
+  }
+
+  while (chain != -1)
+  {
+    int next = prog->instr[chain].jump;
+    prog->instr[chain].jump = prog->num_instr;
+    chain = next;
+  }
+
+  if (pat->pat_not)
+    pattern_prog_emit(prog, PAT_INSTR_NOT, NULL);
+}
+
+/**
+ * mutt_pattern_prog_compile - Flatten a Pattern into a linear program
+ * @param pat Pattern to compile
+ * @retval ptr Newly allocated program
+ *
+ * The program evaluates the head of @a pat, matching the behaviour of callers
+ * which pass `SLIST_FIRST(pat)` to mutt_pattern_exec().  It keeps pointers
+ * into @a pat, so it must be freed first.
+ */
+struct PatternProg *mutt_pattern_prog_compile(struct PatternList *pat)
+{
+  if (!pat)
+    return NULL;
+
+  struct PatternProg *prog = mutt_mem_calloc(1, sizeof(struct PatternProg));
+  pattern_prog_node(prog, SLIST_FIRST(pat));
+  return prog;
+}
+
+/**
+ * mutt_pattern_prog_free - Free a compiled Pattern program
+ * @param[out] ptr Program to free
+ *
+ * @note The Pattern nodes the program refers to are not freed
+ */
+void mutt_pattern_prog_free(struct PatternProg **ptr)
+{
+  if (!ptr || !*ptr)
+    return;
+
+  struct PatternProg *prog = *ptr;
+  FREE(&prog->instr);
+  FREE(ptr);
+}
+
 /**
  * mutt_pattern_node_new - Create a new list containing a Pattern
  * @retval ptr Newly created list containing a single node with a Pattern
@@ -36,9 +36,24 @@ static struct ConfigDef PatternVars[] = {
   { "external_search_command", DT_STRING|DT_COMMAND, 0, 0, NULL,
     "External search command"
   },
+  { "pattern_date_index", DT_BOOL, false, 0, NULL,
+    "Keep a date-sorted index so ~d/~r range limits binary-search instead of scanning"
+  },
+  { "pattern_flag_index", DT_BOOL, false, 0, NULL,
+    "Mirror message flags into packed bitmaps so flag limits (~N, ~F) skip 64 messages at a time"
+  },
   { "pattern_format", DT_STRING, IP "%2n %-15e  %d", 0, NULL,
     "printf-like format string for the pattern completion menu"
   },
+  { "pattern_threads", DT_NUMBER|DT_NOT_NEGATIVE, 0, 0, NULL,
+    "Number of worker threads for matching header-only patterns (0 = no threads)"
+  },
+  { "pattern_trigram_index", DT_BOOL, false, 0, NULL,
+    "Index the From/Subject headers so plain ~f/~s limits only scan candidates"
+  },
+  { "search_encrypted", DT_BOOL, true, 0, NULL,
+    "Decrypt encrypted messages when searching their bodies"
+  },
   { "thorough_search", DT_BOOL, true, 0, NULL,
     "Decode headers and messages before searching them"
   },
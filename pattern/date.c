@@ -0,0 +1,218 @@
+/**
+ * @file
+ * Sorted date index for date-range limits
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page pattern_date Sorted date index for date-range limits
+ *
+ * A `~d` (or `~r`) range used to compare every message's date against the
+ * range bounds - a linear scan, even though dates are a textbook binary
+ * search.  When `$pattern_date_index` is set, the message dates are copied
+ * into a side array sorted by date; a range limit then locates its first
+ * match in O(log n) and walks just the matching run.
+ *
+ * Unlike the trigram index (see @ref pattern_trigram) the result here is
+ * exact, not a superset: the node's own comparison is `min <= date <= max`,
+ * which is precisely the run found in the sorted array.  Dynamic ranges such
+ * as `~d >1w` are re-evaluated against 'now' first, the same way the
+ * executor does.
+ *
+ * The array is rebuilt when the mailbox, its message count or the pattern
+ * cache generation changes - one pass and a qsort over data already in core.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "private.h"
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "lib.h"
+
+/**
+ * struct DateEntry - One message's date, in date order
+ */
+struct DateEntry
+{
+  time_t date; ///< Date of the message
+  int msgno;   ///< Its index in Mailbox.emails
+};
+
+ARRAY_HEAD(DateEntryArray, struct DateEntry);
+
+/// The index: the Mailbox's dates in sorted order
+static struct
+{
+  struct Mailbox *mailbox;         ///< Mailbox the index was built over
+  int msg_count;                   ///< Its message count at build time
+  size_t gen;                      ///< Pattern cache generation at build time
+  bool valid;                      ///< The arrays match the Mailbox
+  struct DateEntryArray sent;      ///< Dates sent,     sorted by date
+  struct DateEntryArray received;  ///< Dates received, sorted by date
+} DateIndex;
+
+/**
+ * date_entry_cmp - Compare two DateEntry by date - Implements ::sort_t - @ingroup sort_api
+ */
+static int date_entry_cmp(const void *a, const void *b)
+{
+  const struct DateEntry *da = a;
+  const struct DateEntry *db = b;
+
+  if (da->date < db->date)
+    return -1;
+  return (da->date > db->date);
+}
+
+/**
+ * date_index_build - (Re)build the sorted date arrays for a Mailbox
+ * @param m Mailbox to index
+ */
+static void date_index_build(struct Mailbox *m)
+{
+  ARRAY_FREE(&DateIndex.sent);
+  ARRAY_FREE(&DateIndex.received);
+  ARRAY_RESERVE(&DateIndex.sent, m->msg_count);
+  ARRAY_RESERVE(&DateIndex.received, m->msg_count);
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      continue;
+
+    struct DateEntry de = { e->date_sent, i };
+    ARRAY_ADD(&DateIndex.sent, de);
+    de.date = e->received;
+    ARRAY_ADD(&DateIndex.received, de);
+  }
+
+  ARRAY_SORT(&DateIndex.sent, date_entry_cmp);
+  ARRAY_SORT(&DateIndex.received, date_entry_cmp);
+
+  DateIndex.mailbox = m;
+  DateIndex.msg_count = m->msg_count;
+  DateIndex.gen = pattern_cache_generation();
+  DateIndex.valid = true;
+  mutt_debug(LL_DEBUG2, "date index built: %d messages\n", m->msg_count);
+}
+
+/**
+ * date_lower_bound - Find the first entry at or after a date
+ * @param dea  Sorted array of DateEntry
+ * @param date Date to look for
+ * @retval num Index of the first entry with entry.date >= date
+ */
+static size_t date_lower_bound(const struct DateEntryArray *dea, time_t date)
+{
+  size_t lo = 0;
+  size_t hi = ARRAY_SIZE(dea);
+  while (lo < hi)
+  {
+    const size_t mid = lo + (hi - lo) / 2;
+    if (ARRAY_GET(dea, mid)->date < date)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+/**
+ * mutt_date_index_candidates - Narrow a limit using a date-range Pattern
+ * @param[in]     m    Mailbox to match against
+ * @param[in]     pat  Pattern node, must be `~d` or `~r`
+ * @param[in,out] cand Candidate flags, one per message; narrowed in place
+ * @param[in]     num  Number of messages, must be m->msg_count
+ * @retval true The index applied; cand keeps only messages inside the range
+ *
+ * The caller (the candidate walker in trigram.c) has already rejected
+ * negated nodes, so the node matches exactly the messages whose date lies
+ * in [min, max].
+ */
+bool mutt_date_index_candidates(struct Mailbox *m, struct Pattern *pat,
+                                bool *cand, int num)
+{
+  if (!m || !pat || !cand || (num != m->msg_count))
+    return false;
+
+  if ((pat->op != MUTT_PAT_DATE) && (pat->op != MUTT_PAT_DATE_RECEIVED))
+    return false;
+
+  const bool c_pattern_date_index =
+      cs_subset_bool(NeoMutt->sub, "pattern_date_index");
+  if (!c_pattern_date_index)
+    return false;
+
+  if (pat->dynamic)
+  {
+    /* bring min/max up to date, exactly as the executor would */
+    struct Buffer *err = mutt_buffer_pool_get();
+    const bool ok = eval_date_minmax(pat, pat->p.str, err);
+    mutt_buffer_pool_release(&err);
+    if (!ok)
+      return false;
+  }
+
+  if (!DateIndex.valid || (DateIndex.mailbox != m) ||
+      (DateIndex.msg_count != m->msg_count) ||
+      (DateIndex.gen != pattern_cache_generation()))
+  {
+    date_index_build(m);
+  }
+
+  const struct DateEntryArray *dea =
+      (pat->op == MUTT_PAT_DATE) ? &DateIndex.sent : &DateIndex.received;
+
+  bool *in_range = mutt_mem_calloc(num, sizeof(bool));
+  const size_t count = ARRAY_SIZE(dea);
+  for (size_t i = date_lower_bound(dea, pat->min); i < count; i++)
+  {
+    const struct DateEntry *de = ARRAY_GET(dea, i);
+    if (de->date > pat->max)
+      break;
+    if (de->msgno < num)
+      in_range[de->msgno] = true;
+  }
+
+  for (int i = 0; i < num; i++)
+    cand[i] = cand[i] && in_range[i];
+  FREE(&in_range);
+  return true;
+}
+
+/**
+ * mutt_date_index_cleanup - Free the date index
+ */
+void mutt_date_index_cleanup(void)
+{
+  ARRAY_FREE(&DateIndex.sent);
+  ARRAY_FREE(&DateIndex.received);
+  DateIndex.mailbox = NULL;
+  DateIndex.msg_count = 0;
+  DateIndex.gen = 0;
+  DateIndex.valid = false;
+}
@@ -51,8 +51,13 @@
 #include "copy.h"
 #include "handler.h"
 #include "maillist.h"
+#include "mutt_thread.h"
 #include "muttlib.h"
 #include "mx.h"
+#include "score.h"
+#ifdef USE_IMAP
+#include "imap/lib.h"
+#endif
 #ifndef USE_FMEMOPEN
 #include <sys/stat.h>
 #endif
@@ -76,6 +81,16 @@ static bool patmatch(const struct Pattern *pat, const char *buf)
     return pat->ign_case ? mutt_istr_find(buf, pat->p.str) : strstr(buf, pat->p.str);
   if (pat->group_match)
     return mutt_group_match(pat->p.group, buf);
+  if (pat->literal)
+  {
+    /* the regex would only ever match itself - a substring scan is cheaper */
+    return pat->ign_case ? mutt_istr_find(buf, pat->raw_pattern) :
+                           strstr(buf, pat->raw_pattern);
+  }
+  /* A string without the mandatory literal can't match; skip the engine.
+   * The scan is case-insensitive, a superset of any REG_ICASE decision. */
+  if (pat->prefilter && !mutt_istr_find(buf, pat->prefilter))
+    return false;
   return (regexec(pat->p.regex, buf, 0, NULL, 0) == 0);
 }
 
@@ -101,6 +116,28 @@ static void print_crypt_pattern_op_error(int op)
   }
 }
 
+/**
+ * msg_search_key - Identify a header/body search for the result cache
+ * @param pat Pattern being run
+ * @retval num Non-zero hash of the search parameters
+ * @retval 0   The search can't be cached
+ *
+ * A message's content never changes, so the result of searching it depends
+ * only on the pattern text and the settings that shape the search.
+ */
+static size_t msg_search_key(const struct Pattern *pat)
+{
+  if (!pat->raw_pattern)
+    return 0;
+
+  const bool c_thorough_search =
+      cs_subset_bool(NeoMutt->sub, "thorough_search");
+  size_t hash = 5381 + (pat->op * 2) + (c_thorough_search ? 1 : 0);
+  for (const char *p = pat->raw_pattern; *p; p++)
+    hash = (hash * 33) + (unsigned char) *p;
+  return hash | 1; // a key of 0 means "nothing cached"
+}
+
 /**
  * msg_search - Search an email
  * @param pat   Pattern to find
@@ -113,6 +150,10 @@ static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg
 {
   assert(msg);
 
+  const size_t key = msg_search_key(pat);
+  if (key && (e->msg_match_key == key))
+    return e->msg_match;
+
   bool match = false;
 
   FILE *fp = NULL;
@@ -142,7 +183,7 @@ static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg
       return false;
     }
 #else
-    s.fp_out = mutt_file_mkstemp();
+    s.fp_out = mutt_file_pool_get();
     if (!s.fp_out)
     {
       mutt_perror(_("Can't create temporary file"));
@@ -159,14 +200,22 @@ static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg
     {
       mutt_parse_mime_message(e, msg->fp);
 
+      /* Decrypting one message per ~b match makes limits on large encrypted
+       * folders crawl, so $search_encrypted can opt out.  Either way the
+       * message counts as unmatched but is NOT cached as such - the result
+       * cache below only ever holds real search results */
+      const bool c_search_encrypted =
+          cs_subset_bool(NeoMutt->sub, "search_encrypted");
       if ((WithCrypto != 0) && (e->security & SEC_ENCRYPT) &&
-          !crypt_valid_passphrase(e->security))
+          (!c_search_encrypted || !crypt_valid_passphrase(e->security)))
       {
         if (s.fp_out)
         {
-          mutt_file_fclose(&s.fp_out);
 #ifdef USE_FMEMOPEN
+          mutt_file_fclose(&s.fp_out);
           FREE(&temp);
+#else
+          mutt_file_pool_release(&s.fp_out);
 #endif
         }
         return false;
@@ -208,7 +257,7 @@ static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg
     if (!mutt_file_seek(fp, 0, SEEK_SET) || fstat(fileno(fp), &st))
     {
       mutt_perror(_("Error checking length of temporary file"));
-      mutt_file_fclose(&fp);
+      mutt_file_pool_release(&fp);
       return false;
     }
     len = (long) st.st_size;
@@ -264,12 +313,26 @@ static bool msg_search(struct Pattern *pat, struct Email *e, struct Message *msg
   FREE(&buf);
 
   if (c_thorough_search)
+  {
+#ifdef USE_FMEMOPEN
     mutt_file_fclose(&fp);
+#else
+    mutt_file_pool_release(&fp);
+#endif
+  }
 
 #ifdef USE_FMEMOPEN
   FREE(&temp);
 #endif
 
+  /* The error paths above return without caching anything, so a failed
+   * search (e.g. missing passphrase) will be retried */
+  if (key)
+  {
+    e->msg_match_key = key;
+    e->msg_match = match;
+  }
+
   return match;
 }
 
@@ -764,7 +827,12 @@ static bool pattern_needs_msg(const struct Mailbox *m, const struct Pattern *pat
 {
   if ((pat->op == MUTT_PAT_MIMETYPE) || (pat->op == MUTT_PAT_MIMEATTACH))
   {
+#ifdef USE_IMAP
+    /* the MIME structure can be fetched without the message text */
+    return (m->type != MUTT_IMAP);
+#else
     return true;
+#endif
   }
 
   if ((pat->op == MUTT_PAT_WHOLE_MSG) || (pat->op == MUTT_PAT_BODY) || (pat->op == MUTT_PAT_HEADER))
@@ -791,6 +859,29 @@ static bool pattern_needs_msg(const struct Mailbox *m, const struct Pattern *pat
   return false;
 }
 
+/**
+ * pattern_needs_parse - Check whether a pattern needs the MIME structure
+ * @param pat Pattern
+ * @retval true The pattern needs the message to be MIME-parsed
+ */
+static bool pattern_needs_parse(const struct Pattern *pat)
+{
+  if ((pat->op == MUTT_PAT_MIMETYPE) || (pat->op == MUTT_PAT_MIMEATTACH))
+    return true;
+
+  if ((pat->op == MUTT_PAT_AND) || (pat->op == MUTT_PAT_OR))
+  {
+    struct Pattern *p = NULL;
+    SLIST_FOREACH(p, pat->child, entries)
+    {
+      if (pattern_needs_parse(p))
+        return true;
+    }
+  }
+
+  return false;
+}
+
 /**
  * pattern_exec - Match a pattern against an email header
  * @param pat   Pattern to match
@@ -916,6 +1007,7 @@ static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
         return false;
       return pat->pat_not ^ (e->env->message_id && patmatch(pat, e->env->message_id));
     case MUTT_PAT_SCORE:
+      mutt_score_require(m, e);
       return pat->pat_not ^ (e->score >= pat->min &&
                              (pat->max == MUTT_MAXRANGE || e->score <= pat->max));
     case MUTT_PAT_SIZE:
@@ -1063,19 +1155,61 @@ static bool pattern_exec(struct Pattern *pat, PatternExecFlags flags,
         return false;
       return pat->pat_not ^ (e->env->spam.data && patmatch(pat, e->env->spam.data));
     case MUTT_PAT_DUPLICATED:
-      return pat->pat_not ^ (e->thread && e->thread->duplicate_thread);
+    {
+      if (e->thread)
+        return pat->pat_not ^ e->thread->duplicate_thread;
+      /* No threading info: use the id_hash instead.  It only ever holds the
+       * first message with a given id (duplicate inserts are rejected) and
+       * is maintained as new mail arrives, so each check is a single lookup */
+      if (!m || !e->env || !e->env->message_id)
+        return pat->pat_not ^ false;
+      if (!m->id_hash)
+        m->id_hash = mutt_make_id_hash(m);
+      struct Email *e_first = mutt_hash_find(m->id_hash, e->env->message_id);
+      return pat->pat_not ^ (e_first && (e_first != e));
+    }
     case MUTT_PAT_MIMEATTACH:
       if (!m)
         return false;
       {
-        int count = mutt_count_body_parts(m, e, msg->fp);
+        FILE *fp = msg ? msg->fp : NULL;
+        struct Message *msg2 = NULL;
+#ifdef USE_IMAP
+        /* fetch just the structure; fall back to the message text if that fails */
+        if ((m->type == MUTT_IMAP) && !msg && (imap_fetch_structure(m, e) < 0))
+        {
+          msg2 = mx_msg_open(m, e->msgno);
+          if (!msg2)
+            return false;
+          fp = msg2->fp;
+        }
+#endif
+        int count = mutt_count_body_parts(m, e, fp);
+        if (msg2)
+          mx_msg_close(m, &msg2);
         return pat->pat_not ^ (count >= pat->min &&
                                (pat->max == MUTT_MAXRANGE || count <= pat->max));
       }
     case MUTT_PAT_MIMETYPE:
       if (!m)
         return false;
-      return pat->pat_not ^ match_mime_content_type(pat, e, msg->fp);
+      {
+        FILE *fp = msg ? msg->fp : NULL;
+        struct Message *msg2 = NULL;
+#ifdef USE_IMAP
+        if ((m->type == MUTT_IMAP) && !msg && (imap_fetch_structure(m, e) < 0))
+        {
+          msg2 = mx_msg_open(m, e->msgno);
+          if (!msg2)
+            return false;
+          fp = msg2->fp;
+        }
+#endif
+        const bool rc = match_mime_content_type(pat, e, fp);
+        if (msg2)
+          mx_msg_close(m, &msg2);
+        return pat->pat_not ^ rc;
+      }
     case MUTT_PAT_UNREFERENCED:
       return pat->pat_not ^ (e->thread && !e->thread->child);
     case MUTT_PAT_BROKEN:
@@ -1119,6 +1253,151 @@ bool mutt_pattern_exec(struct Pattern *pat, PatternExecFlags flags,
   return matched;
 }
 
+/**
+ * mutt_pattern_prog_exec - Match a compiled Pattern program against an email
+ * @param prog  Program from mutt_pattern_prog_compile()
+ * @param flags Flags, e.g. #MUTT_MATCH_FULL_ADDRESS
+ * @param m     Mailbox
+ * @param e     Email
+ * @param cache Cache for common Patterns
+ * @retval true Success, pattern matched
+ * @retval false Pattern did not match
+ *
+ * Equivalent to calling mutt_pattern_exec() on the Pattern the program was
+ * compiled from, but the AND/OR structure is run as a flat instruction loop
+ * instead of a recursive tree walk.  Short-circuiting also means the message
+ * is only opened when a body-matching node is actually reached.
+ */
+bool mutt_pattern_prog_exec(const struct PatternProg *prog, PatternExecFlags flags,
+                            struct Mailbox *m, struct Email *e, struct PatternCache *cache)
+{
+  if (!prog)
+    return false;
+
+  struct Message *msg = NULL;
+  bool result = false;
+
+  for (int i = 0; i < prog->num_instr; /* jumps inside */)
+  {
+    const struct PatternInstr *instr = &prog->instr[i];
+    switch (instr->op)
+    {
+      case PAT_INSTR_MATCH:
+        if (!msg && pattern_needs_msg(m, instr->pat))
+        {
+          msg = mx_msg_open(m, e->msgno);
+          if (!msg)
+          {
+            result = false;
+            goto done;
+          }
+        }
+        result = pattern_exec(instr->pat, flags, m, e, msg, cache);
+        i++;
+        break;
+      case PAT_INSTR_NOT:
+        result = !result;
+        i++;
+        break;
+      case PAT_INSTR_JUMP_IF_FALSE:
+        i = result ? (i + 1) : instr->jump;
+        break;
+      case PAT_INSTR_JUMP_IF_TRUE:
+        i = result ? instr->jump : (i + 1);
+        break;
+    }
+  }
+
+done:
+  mx_msg_close(m, &msg);
+  return result;
+}
+
+/**
+ * struct PatternMatchData - Data shared between pattern_match_worker() threads
+ */
+struct PatternMatchData
+{
+  const struct PatternProg *prog; ///< Compiled program to run
+  PatternExecFlags flags;         ///< Flags, e.g. #MUTT_MATCH_FULL_ADDRESS
+  struct Mailbox *m;              ///< Mailbox containing the Emails
+  struct Email **emails;          ///< Emails to match
+  bool *results;                  ///< One result per Email
+};
+
+/**
+ * pattern_match_worker - Match one Email - Implements ::mutt_worker_fn_t - @ingroup worker_api
+ */
+static void pattern_match_worker(size_t index, void *wdata)
+{
+  struct PatternMatchData *pmd = wdata;
+  struct Email *e = pmd->emails[index];
+  pmd->results[index] = e && mutt_pattern_prog_exec(pmd->prog, pmd->flags,
+                                                    pmd->m, e, NULL);
+}
+
+/**
+ * mutt_pattern_prog_match_all - Match a Pattern program against many emails
+ * @param[in]  prog    Program from mutt_pattern_prog_compile()
+ * @param[in]  flags   Flags, e.g. #MUTT_MATCH_FULL_ADDRESS
+ * @param[in]  m       Mailbox containing the Emails
+ * @param[in]  emails  Array of Emails to match (NULL entries don't match)
+ * @param[in]  count   Number of Emails in the array
+ * @param[out] results One result per Email
+ *
+ * When $pattern_threads is set and no node of the program needs to open the
+ * message (e.g. ~b/~B/~H), the matching is spread across worker threads.
+ * Header-only matching is read-only on the Emails, so the workers don't need
+ * any locking.
+ *
+ * Body searches can also be threaded when each message is its own file
+ * (maildir/MH) and `$thorough_search` is unset: the raw scan in msg_search()
+ * is then pure file I/O, with no decoding, crypto or UI involved.  Anything
+ * else - decoded searches, MIME-structure patterns, mailboxes sharing one
+ * stream - is matched serially, in order.
+ */
+void mutt_pattern_prog_match_all(const struct PatternProg *prog, PatternExecFlags flags,
+                                 struct Mailbox *m, struct Email **emails,
+                                 size_t count, bool *results)
+{
+  if (!prog || !emails || !results)
+    return;
+
+  const short c_pattern_threads = cs_subset_number(NeoMutt->sub, "pattern_threads");
+  bool needs_msg = false;
+  bool needs_parse = false;
+  for (int i = 0; i < prog->num_instr; i++)
+  {
+    if (prog->instr[i].op != PAT_INSTR_MATCH)
+      continue;
+    if (pattern_needs_msg(m, prog->instr[i].pat))
+      needs_msg = true;
+    if (pattern_needs_parse(prog->instr[i].pat))
+      needs_parse = true;
+  }
+
+  const bool c_thorough_search =
+      cs_subset_bool(NeoMutt->sub, "thorough_search");
+  const bool file_per_msg = (m->type == MUTT_MAILDIR) || (m->type == MUTT_MH);
+  /* MIME-structure patterns on IMAP fetch BODYSTRUCTURE over the shared
+   * connection, so they must be matched serially */
+  const bool imap_parse = needs_parse && (m->type == MUTT_IMAP);
+  const bool can_thread =
+      (!needs_msg && !imap_parse) ||
+      (file_per_msg && !needs_parse && !c_thorough_search);
+
+  struct PatternMatchData pmd = { prog, flags, m, emails, results };
+  if (can_thread && (c_pattern_threads > 1))
+  {
+    mutt_worker_run(pattern_match_worker, &pmd, count, c_pattern_threads);
+  }
+  else
+  {
+    for (size_t i = 0; i < count; i++)
+      pattern_match_worker(i, &pmd);
+  }
+}
+
 /**
  * mutt_pattern_alias_exec - Match a pattern against an alias
  * @param pat   Pattern to match
@@ -0,0 +1,259 @@
+/**
+ * @file
+ * Packed flag bitmaps for flag limits
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page pattern_flagbits Packed flag bitmaps for flag limits
+ *
+ * A flag node such as `~N` or `~F` reads one bitfield out of every
+ * heap-allocated Email - a pointer chase per message.  When
+ * `$pattern_flag_index` is set, each flag is mirrored into a packed bitmap
+ * (one bit per message, 64 messages per word), so a flag limit touches a few
+ * contiguous words instead and can skip 64 messages at a time.
+ *
+ * Like the date index (see @ref pattern_date) the result is exact, not a
+ * superset, so even negated nodes can use it: the complement of a bitmap is
+ * just as exact.  Compound flags are derived word-wise - `~N` is
+ * `~(old | read)` - rather than stored separately.
+ *
+ * The bitmaps are rebuilt when the mailbox, its message count or the pattern
+ * cache generation changes; flag changes bump the generation through the
+ * Email events the pattern cache already observes.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "private.h"
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "mutt.h"
+#include "lib.h"
+
+/**
+ * enum FlagBitmap - The flags that are mirrored into bitmaps
+ */
+enum FlagBitmap
+{
+  FB_READ,       ///< Email::read
+  FB_OLD,        ///< Email::old
+  FB_FLAGGED,    ///< Email::flagged
+  FB_TAGGED,     ///< Email::tagged
+  FB_REPLIED,    ///< Email::replied
+  FB_DELETED,    ///< Email::deleted
+  FB_EXPIRED,    ///< Email::expired
+  FB_SUPERSEDED, ///< Email::superseded
+  FB_MAX,        ///< Number of bitmaps
+};
+
+/// The index: one bit per message, per flag
+static struct
+{
+  struct Mailbox *mailbox;   ///< Mailbox the bitmaps were built over
+  int msg_count;             ///< Its message count at build time
+  size_t gen;                ///< Pattern cache generation at build time
+  bool valid;                ///< The bitmaps match the Mailbox
+  size_t num_words;          ///< Words per bitmap
+  uint64_t *bits[FB_MAX];    ///< The bitmaps, indexed by msgno
+} FlagIndex;
+
+/**
+ * flag_index_build - (Re)build the flag bitmaps for a Mailbox
+ * @param m Mailbox to index
+ */
+static void flag_index_build(struct Mailbox *m)
+{
+  const size_t num_words = ((size_t) m->msg_count + 63) / 64;
+  for (int f = 0; f < FB_MAX; f++)
+  {
+    FREE(&FlagIndex.bits[f]);
+    FlagIndex.bits[f] = mutt_mem_calloc(MAX(num_words, 1), sizeof(uint64_t));
+  }
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      continue;
+
+    const size_t word = i / 64;
+    const uint64_t bit = 1ULL << (i % 64);
+    if (e->read)
+      FlagIndex.bits[FB_READ][word] |= bit;
+    if (e->old)
+      FlagIndex.bits[FB_OLD][word] |= bit;
+    if (e->flagged)
+      FlagIndex.bits[FB_FLAGGED][word] |= bit;
+    if (e->tagged)
+      FlagIndex.bits[FB_TAGGED][word] |= bit;
+    if (e->replied)
+      FlagIndex.bits[FB_REPLIED][word] |= bit;
+    if (e->deleted)
+      FlagIndex.bits[FB_DELETED][word] |= bit;
+    if (e->expired)
+      FlagIndex.bits[FB_EXPIRED][word] |= bit;
+    if (e->superseded)
+      FlagIndex.bits[FB_SUPERSEDED][word] |= bit;
+  }
+
+  FlagIndex.mailbox = m;
+  FlagIndex.msg_count = m->msg_count;
+  FlagIndex.gen = pattern_cache_generation();
+  FlagIndex.valid = true;
+  FlagIndex.num_words = num_words;
+  mutt_debug(LL_DEBUG2, "flag bitmaps built: %d messages\n", m->msg_count);
+}
+
+/**
+ * flag_index_word - One bitmap word of a flag node's matches
+ * @param op   Pattern op, e.g. #MUTT_NEW
+ * @param word Word index into the bitmaps
+ * @retval num 64 match bits, one per message
+ *
+ * Derives the op's word from the base bitmaps, mirroring the comparisons in
+ * pattern_exec() - `~O` is old-but-unread, not just Email::old.
+ */
+static uint64_t flag_index_word(int op, size_t word)
+{
+  switch (op)
+  {
+    case MUTT_READ:
+      return FlagIndex.bits[FB_READ][word];
+    case MUTT_UNREAD:
+      return ~FlagIndex.bits[FB_READ][word];
+    case MUTT_NEW:
+      return ~(FlagIndex.bits[FB_OLD][word] | FlagIndex.bits[FB_READ][word]);
+    case MUTT_OLD:
+      return FlagIndex.bits[FB_OLD][word] & ~FlagIndex.bits[FB_READ][word];
+    case MUTT_FLAG:
+      return FlagIndex.bits[FB_FLAGGED][word];
+    case MUTT_TAG:
+      return FlagIndex.bits[FB_TAGGED][word];
+    case MUTT_REPLIED:
+      return FlagIndex.bits[FB_REPLIED][word];
+    case MUTT_DELETED:
+      return FlagIndex.bits[FB_DELETED][word];
+    case MUTT_EXPIRED:
+      return FlagIndex.bits[FB_EXPIRED][word];
+    case MUTT_SUPERSEDED:
+      return FlagIndex.bits[FB_SUPERSEDED][word];
+    default:
+      return 0; /* not reached, flag_pattern_op() gates the callers */
+  }
+}
+
+/**
+ * flag_pattern_op - Does a pattern op have a bitmap?
+ * @param op Pattern op, e.g. #MUTT_NEW
+ * @retval true The op can be answered from the bitmaps
+ */
+static bool flag_pattern_op(int op)
+{
+  switch (op)
+  {
+    case MUTT_READ:
+    case MUTT_UNREAD:
+    case MUTT_NEW:
+    case MUTT_OLD:
+    case MUTT_FLAG:
+    case MUTT_TAG:
+    case MUTT_REPLIED:
+    case MUTT_DELETED:
+    case MUTT_EXPIRED:
+    case MUTT_SUPERSEDED:
+      return true;
+    default:
+      return false;
+  }
+}
+
+/**
+ * mutt_flag_index_candidates - Narrow a limit using a flag Pattern
+ * @param[in]     m    Mailbox to match against
+ * @param[in]     pat  Pattern node, must be a flag node such as `~N`
+ * @param[in,out] cand Candidate flags, one per message; narrowed in place
+ * @param[in]     num  Number of messages, must be m->msg_count
+ * @retval true The index applied; cand keeps only messages with the flag
+ *
+ * Unlike the needle candidates the result is exact, so negated nodes
+ * (`!~D`) are fine: their matches are the complement of the bitmap.
+ */
+bool mutt_flag_index_candidates(struct Mailbox *m, struct Pattern *pat, bool *cand, int num)
+{
+  if (!m || !pat || !cand || (num != m->msg_count))
+    return false;
+
+  if (!flag_pattern_op(pat->op))
+    return false;
+
+  const bool c_pattern_flag_index =
+      cs_subset_bool(NeoMutt->sub, "pattern_flag_index");
+  if (!c_pattern_flag_index)
+    return false;
+
+  if (!FlagIndex.valid || (FlagIndex.mailbox != m) ||
+      (FlagIndex.msg_count != m->msg_count) ||
+      (FlagIndex.gen != pattern_cache_generation()))
+  {
+    flag_index_build(m);
+  }
+
+  for (size_t w = 0; w < FlagIndex.num_words; w++)
+  {
+    uint64_t word = flag_index_word(pat->op, w);
+    if (pat->pat_not)
+      word = ~word;
+
+    if (word == UINT64_MAX)
+      continue; /* every message in this block matches; cand is unchanged */
+
+    const int base = w * 64;
+    const int end = MIN(base + 64, num);
+    if (word == 0)
+    {
+      memset(cand + base, 0, end - base);
+      continue;
+    }
+
+    for (int i = base; i < end; i++)
+      cand[i] = cand[i] && (word & (1ULL << (i % 64)));
+  }
+
+  return true;
+}
+
+/**
+ * mutt_flag_index_cleanup - Free the flag bitmaps
+ */
+void mutt_flag_index_cleanup(void)
+{
+  for (int f = 0; f < FB_MAX; f++)
+    FREE(&FlagIndex.bits[f]);
+  FlagIndex.mailbox = NULL;
+  FlagIndex.msg_count = 0;
+  FlagIndex.gen = 0;
+  FlagIndex.valid = false;
+  FlagIndex.num_words = 0;
+}
@@ -28,12 +28,16 @@
  *
  * | File                 | Description                  |
  * | :------------------- | :--------------------------- |
+ * | pattern/cache.c      | @subpage pattern_cache       |
  * | pattern/compile.c    | @subpage pattern_compile     |
  * | pattern/config.c     | @subpage pattern_config      |
+ * | pattern/date.c       | @subpage pattern_date        |
  * | pattern/dlgpattern.c | @subpage pattern_dlg_pattern |
  * | pattern/exec.c       | @subpage pattern_exec        |
  * | pattern/flags.c      | @subpage pattern_flags       |
  * | pattern/pattern.c    | @subpage pattern_pattern     |
+ * | pattern/search.c     | @subpage pattern_search      |
+ * | pattern/trigram.c    | @subpage pattern_trigram     |
  */
 
 #ifndef MUTT_PATTERN_LIB_H
@@ -72,13 +76,16 @@ struct Pattern
   bool all_addr     : 1;         ///< All Addresses in the list must match
   bool string_match : 1;         ///< Check a string for a match
   bool group_match  : 1;         ///< Check a group of Addresses
-  bool ign_case     : 1;         ///< Ignore case for local string_match searches
+  bool ign_case     : 1;         ///< Ignore case for local string_match/literal searches
   bool is_alias     : 1;         ///< Is there an alias for this Address?
   bool dynamic      : 1;         ///< Evaluate date ranges at run time
   bool sendmode     : 1;         ///< Evaluate searches in send-mode
   bool is_multi     : 1;         ///< Multiple case (only for ~I pattern now)
+  bool literal      : 1;         ///< Regex contains no metacharacters; match it as a substring
   int min;                       ///< Minimum for range checks
   int max;                       ///< Maximum for range checks
+  char *raw_pattern;             ///< Text the pattern was compiled from, for the search-result cache
+  char *prefilter;               ///< Literal substring every regex match must contain, or NULL
   struct PatternList *child;     ///< Arguments to logical operation
   union {
     regex_t *regex;              ///< Compiled regex, for non-pattern matching
@@ -114,6 +121,42 @@ struct PatternCache
   int pers_from_one;  ///<  ~P
 };
 
+/**
+ * enum PatternInstrOp - Opcodes for a compiled Pattern program
+ */
+enum PatternInstrOp
+{
+  PAT_INSTR_MATCH,         ///< Evaluate one Pattern node and store the result
+  PAT_INSTR_NOT,           ///< Invert the stored result
+  PAT_INSTR_JUMP_IF_FALSE, ///< Skip ahead if the stored result is false
+  PAT_INSTR_JUMP_IF_TRUE,  ///< Skip ahead if the stored result is true
+};
+
+/**
+ * struct PatternInstr - One instruction of a compiled Pattern program
+ */
+struct PatternInstr
+{
+  enum PatternInstrOp op; ///< Instruction, e.g. #PAT_INSTR_MATCH
+  struct Pattern *pat;    ///< Pattern node, for #PAT_INSTR_MATCH
+  int jump;               ///< Target instruction, for the jump opcodes
+};
+
+/**
+ * struct PatternProg - A Pattern flattened into a linear program
+ *
+ * The logical structure (AND/OR/NOT) of a Pattern tree is encoded as
+ * short-circuit jumps, so matching a message costs one tight loop rather than
+ * a recursive tree walk.  The program borrows the Pattern nodes; it must be
+ * freed before the PatternList it was compiled from.
+ */
+struct PatternProg
+{
+  struct PatternInstr *instr; ///< Array of instructions
+  int num_instr;              ///< Number of instructions used
+  int max_instr;              ///< Number of instructions allocated
+};
+
 /**
  * enum PatternType - Types of pattern to match
  *
@@ -178,6 +221,27 @@ bool mutt_pattern_alias_exec(struct Pattern *pat, PatternExecFlags flags,
 struct PatternList *mutt_pattern_comp(struct Mailbox *m, struct Menu *menu, const char *s, PatternCompFlags flags, struct Buffer *err);
 void mutt_check_simple(struct Buffer *s, const char *simple);
 void mutt_pattern_free(struct PatternList **pat);
+
+struct PatternList *pattern_cache_comp(struct Mailbox *m, struct Menu *menu, const char *s, PatternCompFlags flags, struct Buffer *err);
+void pattern_cache_release(struct PatternList **pat);
+bool pattern_cache_get_results(struct PatternList *pat, struct Mailbox *m, bool *matches, int num);
+void pattern_cache_set_results(struct PatternList *pat, struct Mailbox *m, const bool *matches, int num);
+size_t pattern_cache_generation(void);
+void mutt_pattern_cache_cleanup(void);
+
+bool mutt_trigram_candidates(struct Mailbox *m, struct PatternList *pat, bool *cand, int num);
+void mutt_trigram_cleanup(void);
+
+bool mutt_date_index_candidates(struct Mailbox *m, struct Pattern *pat, bool *cand, int num);
+void mutt_date_index_cleanup(void);
+
+bool mutt_flag_index_candidates(struct Mailbox *m, struct Pattern *pat, bool *cand, int num);
+void mutt_flag_index_cleanup(void);
+
+struct PatternProg *mutt_pattern_prog_compile(struct PatternList *pat);
+bool mutt_pattern_prog_exec(const struct PatternProg *prog, PatternExecFlags flags, struct Mailbox *m, struct Email *e, struct PatternCache *cache);
+void mutt_pattern_prog_match_all(const struct PatternProg *prog, PatternExecFlags flags, struct Mailbox *m, struct Email **emails, size_t count, bool *results);
+void mutt_pattern_prog_free(struct PatternProg **ptr);
 bool dlg_select_pattern(char *buf, size_t buflen);
 
 int mutt_which_case(const char *s);
@@ -187,6 +251,7 @@ int mutt_pattern_func(struct Context *ctx, int op, char *prompt);
 int mutt_pattern_alias_func(char *prompt, struct AliasMenuData *mdata, struct Menu *menu);
 int mutt_search_command(struct Mailbox *m, struct Menu *menu, int cur, int op);
 int mutt_search_alias_command(struct Menu *menu, int cur, int op);
+int mutt_pattern_search_mailboxes(struct Mailbox *m_cur, const char *s, const char *resultpath, struct Buffer *err);
 
 bool mutt_limit_current_thread(struct Context *ctx, struct Email *e);
 
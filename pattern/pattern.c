@@ -350,6 +350,7 @@ int mutt_pattern_func(struct Context *ctx, int op, char *prompt)
   struct Buffer err;
   int rc = -1;
   struct Progress *progress = NULL;
+  struct PatternProg *prog = NULL;
   struct Buffer *buf = mutt_buffer_pool_get();
 
   mutt_buffer_strcpy(buf, NONULL(ctx->pattern));
@@ -379,7 +380,7 @@ int mutt_pattern_func(struct Context *ctx, int op, char *prompt)
   err.dsize = 256;
   err.data = mutt_mem_malloc(err.dsize);
   struct PatternList *pat =
-      mutt_pattern_comp(m, ctx->menu, buf->data, MUTT_PC_FULL_MSG, &err);
+      pattern_cache_comp(m, ctx->menu, buf->data, MUTT_PC_FULL_MSG, &err);
   if (!pat)
   {
     mutt_error("%s", err.data);
@@ -391,6 +392,8 @@ int mutt_pattern_func(struct Context *ctx, int op, char *prompt)
     goto bail;
 #endif
 
+  prog = mutt_pattern_prog_compile(pat);
+
   progress = progress_new(_("Executing command on matching messages..."), MUTT_PROGRESS_READ,
                           (op == MUTT_LIMIT) ? m->msg_count : m->vcount);
 
@@ -401,6 +404,33 @@ int mutt_pattern_func(struct Context *ctx, int op, char *prompt)
     ctx->collapsed = false;
     int padding = mx_msg_padding_size(m);
 
+    bool *matches = NULL;
+    if (!match_all)
+    {
+      matches = mutt_mem_calloc(m->msg_count, sizeof(bool));
+      if (!pattern_cache_get_results(pat, m, matches, m->msg_count))
+      {
+        if (mutt_trigram_candidates(m, pat, matches, m->msg_count))
+        {
+          /* the index over-approximates; verify each candidate */
+          for (int i = 0; i < m->msg_count; i++)
+          {
+            if (matches[i])
+            {
+              matches[i] = m->emails[i] && mutt_pattern_prog_exec(prog, MUTT_MATCH_FULL_ADDRESS,
+                                                                  m, m->emails[i], NULL);
+            }
+          }
+        }
+        else
+        {
+          mutt_pattern_prog_match_all(prog, MUTT_MATCH_FULL_ADDRESS, m,
+                                      m->emails, m->msg_count, matches);
+        }
+        pattern_cache_set_results(pat, m, matches, m->msg_count);
+      }
+    }
+
     for (int i = 0; i < m->msg_count; i++)
     {
       struct Email *e = m->emails[i];
@@ -413,8 +443,7 @@ int mutt_pattern_func(struct Context *ctx, int op, char *prompt)
       e->visible = false;
       e->collapsed = false;
       e->num_hidden = 0;
-      if (match_all ||
-          mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, NULL))
+      if (match_all || matches[i])
       {
         e->vnum = m->vcount;
         e->visible = true;
@@ -424,16 +453,25 @@ int mutt_pattern_func(struct Context *ctx, int op, char *prompt)
         ctx->vsize += b->length + b->offset - b->hdr_offset + padding;
       }
     }
+    FREE(&matches);
   }
   else
   {
+    struct Email **virt = mutt_mem_calloc(m->vcount, sizeof(struct Email *));
+    bool *matches = mutt_mem_calloc(m->vcount, sizeof(bool));
+    for (int i = 0; i < m->vcount; i++)
+      virt[i] = mutt_get_virt_email(m, i);
+    mutt_pattern_prog_match_all(prog, MUTT_MATCH_FULL_ADDRESS, m, virt,
+                                m->vcount, matches);
+
+    mutt_flag_batch_begin();
     for (int i = 0; i < m->vcount; i++)
     {
-      struct Email *e = mutt_get_virt_email(m, i);
+      struct Email *e = virt[i];
       if (!e)
         continue;
       progress_update(progress, i, -1);
-      if (mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, NULL))
+      if (matches[i])
       {
         switch (op)
         {
@@ -450,6 +488,9 @@ int mutt_pattern_func(struct Context *ctx, int op, char *prompt)
         }
       }
     }
+    mutt_flag_batch_end(m);
+    FREE(&virt);
+    FREE(&matches);
   }
   progress_free(&progress);
 
@@ -479,7 +520,8 @@ int mutt_pattern_func(struct Context *ctx, int op, char *prompt)
 bail:
   mutt_buffer_pool_release(&buf);
   FREE(&simple);
-  mutt_pattern_free(&pat);
+  mutt_pattern_prog_free(&prog);
+  pattern_cache_release(&pat);
   FREE(&err.data);
 
   return rc;
@@ -0,0 +1,156 @@
+/**
+ * @file
+ * Search a pattern across all mailboxes
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page pattern_search Search a pattern across all mailboxes
+ *
+ * Run a compiled pattern over every configured mailbox and collect the
+ * matches in a results folder.
+ *
+ * Each mailbox is opened the way the periodic mail checks do - read-only,
+ * quiet, unsorted and without touching atime - scanned, and closed again.
+ * Matching messages are appended to a throwaway mbox folder, so the results
+ * can be browsed with the ordinary index regardless of which backends they
+ * came from.  Scanning reuses the header indices (see @ref pattern_trigram)
+ * to avoid running the pattern over messages that can't match.
+ */
+
+#include "config.h"
+#include <stdbool.h>
+#include <stdio.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "lib.h"
+#include "copy.h"
+#include "mx.h"
+
+/**
+ * search_one_mailbox - Copy a Mailbox's matching messages to the results folder
+ * @param m      Mailbox to scan (already open)
+ * @param pat    Compiled pattern
+ * @param m_save Results folder, open for appending
+ * @retval num Number of matching messages
+ */
+static int search_one_mailbox(struct Mailbox *m, struct PatternList *pat,
+                              struct Mailbox *m_save)
+{
+  int matches = 0;
+
+  bool *cand = NULL;
+  bool have_cand = false;
+  if (m->msg_count > 0)
+  {
+    cand = mutt_mem_calloc(m->msg_count, sizeof(bool));
+    have_cand = mutt_trigram_candidates(m, pat, cand, m->msg_count);
+  }
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      continue;
+    /* normally done when a Context attaches; needed to open the message */
+    e->msgno = i;
+    if (have_cand && !cand[i])
+      continue;
+    if (!mutt_pattern_exec(SLIST_FIRST(pat), MUTT_MATCH_FULL_ADDRESS, m, e, NULL))
+      continue;
+    if (mutt_append_message(m_save, m, e, NULL, MUTT_CM_NO_FLAGS, CH_NO_FLAGS) == 0)
+      matches++;
+  }
+
+  FREE(&cand);
+  return matches;
+}
+
+/**
+ * mutt_pattern_search_mailboxes - Search a pattern in every configured mailbox
+ * @param m_cur      Currently open Mailbox (scanned in place), or NULL
+ * @param s          Pattern string, in $simple_search shorthand or full syntax
+ * @param resultpath Path of an mbox folder to collect the matches in
+ * @param err        Buffer for an error message
+ * @retval num Number of matching messages
+ * @retval -1  Error, e.g. the pattern doesn't compile
+ *
+ * The results folder is created (or truncated) even if nothing matches;
+ * the caller should unlink it when the count is zero.
+ */
+int mutt_pattern_search_mailboxes(struct Mailbox *m_cur, const char *s,
+                                  const char *resultpath, struct Buffer *err)
+{
+  struct Buffer *buf = mutt_buffer_pool_get();
+  mutt_buffer_strcpy(buf, s);
+  const char *const c_simple_search =
+      cs_subset_string(NeoMutt->sub, "simple_search");
+  mutt_check_simple(buf, NONULL(c_simple_search));
+
+  struct PatternList *pat =
+      mutt_pattern_comp(m_cur, NULL, mutt_buffer_string(buf), MUTT_PC_FULL_MSG, err);
+  mutt_buffer_pool_release(&buf);
+  if (!pat)
+    return -1;
+
+  struct Mailbox *m_save = mx_path_resolve(resultpath);
+  if (!mx_mbox_open(m_save, MUTT_NEWFOLDER | MUTT_QUIET))
+  {
+    mutt_buffer_printf(err, _("Can't create %s"), resultpath);
+    mailbox_free(&m_save);
+    mutt_pattern_free(&pat);
+    return -1;
+  }
+  const bool old_append = m_save->append;
+  m_save->append = true;
+
+  int matches = 0;
+  struct MailboxList ml = STAILQ_HEAD_INITIALIZER(ml);
+  neomutt_mailboxlist_get_all(&ml, NeoMutt, MUTT_MAILBOX_ANY);
+  struct MailboxNode *np = NULL;
+  STAILQ_FOREACH(np, &ml, entries)
+  {
+    struct Mailbox *m = np->mailbox;
+
+    if (m_cur && mutt_str_equal(m->realpath, m_cur->realpath))
+    {
+      /* already open; scan it in place */
+      matches += search_one_mailbox(m_cur, pat, m_save);
+      continue;
+    }
+
+    mutt_message(_("Searching %s..."), mailbox_path(m));
+
+    const bool old_peek = m->peekonly;
+    if (!mx_mbox_open(m, MUTT_READONLY | MUTT_QUIET | MUTT_NOSORT | MUTT_PEEK))
+      continue;
+    matches += search_one_mailbox(m, pat, m_save);
+    mx_mbox_close(m);
+    m->peekonly = old_peek;
+  }
+  neomutt_mailboxlist_clear(&ml);
+
+  mx_mbox_close(m_save);
+  m_save->append = old_append;
+  mutt_pattern_free(&pat);
+
+  return matches;
+}
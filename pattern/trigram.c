@@ -0,0 +1,396 @@
+/**
+ * @file
+ * Trigram index over message headers for fast string limits
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/**
+ * @page pattern_trigram Trigram index over message headers
+ *
+ * A limit like `~f alice` used to scan the From header of every message with
+ * strstr/regexec - a full pass over the mailbox each time.  When
+ * `$pattern_trigram_index` is set, the substring of every plain `~f`/`~s`
+ * pattern is instead looked up in a trigram index built over the From and
+ * Subject headers: only messages containing all of the substring's trigrams
+ * can match, so the real pattern is executed on a few candidates instead of
+ * the whole mailbox.
+ *
+ * The candidate set is always a superset of the true matches - case is
+ * folded, and logical structure (AND narrows, OR unions) is only used where
+ * it keeps that guarantee - so every candidate is verified by normal pattern
+ * execution.  Regexes with metacharacters, negations and `~f`-with-`^`
+ * (all-address) patterns bypass the index entirely.
+ *
+ * The index lives in memory and is rebuilt when the mailbox, its message
+ * count or the cache generation (see @ref pattern_cache) changes; the
+ * envelopes are already parsed by then, so a rebuild is one cheap pass.
+ *
+ * The walker that maps a pattern's AND/OR structure onto candidate sets also
+ * serves `~d`/`~r` range nodes, which it hands to the sorted date index
+ * (see @ref pattern_date).
+ */
+
+#include "config.h"
+#include <ctype.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "address/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "lib.h"
+
+/// Trigram comes from a From header (address or personal name)
+#define TRI_FIELD_FROM    (1u << 24)
+/// Trigram comes from a Subject header
+#define TRI_FIELD_SUBJECT (2u << 24)
+
+ARRAY_HEAD(TriPostings, int);
+
+/// The index: one set of postings per (field, trigram), for one Mailbox
+static struct
+{
+  struct Mailbox *mailbox; ///< Mailbox the index was built over
+  int msg_count;           ///< Its message count at build time
+  size_t gen;              ///< Pattern cache generation at build time
+  struct HashTable *table; ///< Map of (field | trigram) to TriPostings
+} TriIndex;
+
+/**
+ * tri_postings_free - Free one posting list - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void tri_postings_free(int type, void *obj, intptr_t data)
+{
+  struct TriPostings *pl = obj;
+  ARRAY_FREE(pl);
+  FREE(&pl);
+}
+
+/**
+ * tri_pack - Pack three bytes of text into a trigram key
+ * @param s Text, at least three bytes long
+ * @retval num Case-folded trigram
+ */
+static inline uint32_t tri_pack(const char *s)
+{
+  return ((uint32_t) tolower((unsigned char) s[0]) << 16) |
+         ((uint32_t) tolower((unsigned char) s[1]) << 8) |
+         ((uint32_t) tolower((unsigned char) s[2]));
+}
+
+/**
+ * tri_index_text - Add the trigrams of a string to the index
+ * @param field Field tag, e.g. #TRI_FIELD_FROM
+ * @param s     Text to index
+ * @param msgno Message number the text belongs to
+ *
+ * Postings stay sorted because messages are indexed in mailbox order.
+ */
+static void tri_index_text(uint32_t field, const char *s, int msgno)
+{
+  if (!s)
+    return;
+
+  const size_t len = strlen(s);
+  for (size_t i = 0; (i + 2) < len; i++)
+  {
+    const uint32_t key = field | tri_pack(s + i);
+    struct TriPostings *pl = mutt_hash_int_find(TriIndex.table, key);
+    if (!pl)
+    {
+      pl = mutt_mem_calloc(1, sizeof(*pl));
+      mutt_hash_int_insert(TriIndex.table, key, pl);
+    }
+    int *last = ARRAY_LAST(pl);
+    if (!last || (*last != msgno))
+      ARRAY_ADD(pl, msgno);
+  }
+}
+
+/**
+ * tri_index_build - (Re)build the index over a Mailbox's headers
+ * @param m Mailbox to index
+ */
+static void tri_index_build(struct Mailbox *m)
+{
+  mutt_hash_free(&TriIndex.table);
+  TriIndex.table = mutt_hash_int_new(MAX(m->msg_count, 64), MUTT_HASH_NO_FLAGS);
+  mutt_hash_set_destructor(TriIndex.table, tri_postings_free, 0);
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e || !e->env)
+      continue;
+
+    struct Address *a = NULL;
+    TAILQ_FOREACH(a, &e->env->from, entries)
+    {
+      tri_index_text(TRI_FIELD_FROM, a->mailbox, i);
+      tri_index_text(TRI_FIELD_FROM, a->personal, i);
+    }
+    tri_index_text(TRI_FIELD_SUBJECT, e->env->subject, i);
+  }
+
+  TriIndex.mailbox = m;
+  TriIndex.msg_count = m->msg_count;
+  TriIndex.gen = pattern_cache_generation();
+  mutt_debug(LL_DEBUG2, "trigram index built: %d messages\n", m->msg_count);
+}
+
+/**
+ * tri_needle_candidates - Find the messages containing all trigrams of a substring
+ * @param[in]     field  Field tag, e.g. #TRI_FIELD_SUBJECT
+ * @param[in]     needle Substring the pattern looks for
+ * @param[in,out] cand   Candidate flags, one per message; narrowed in place
+ * @param[in]     num    Number of messages
+ * @retval true The needle was usable (at least three bytes)
+ */
+static bool tri_needle_candidates(uint32_t field, const char *needle, bool *cand, int num)
+{
+  if (!needle || !TriIndex.table)
+    return false;
+
+  const size_t len = strlen(needle);
+  if (len < 3)
+    return false;
+
+  bool *seen = mutt_mem_calloc(num, sizeof(bool));
+  for (size_t i = 0; (i + 2) < len; i++)
+  {
+    struct TriPostings *pl = mutt_hash_int_find(TriIndex.table, field | tri_pack(needle + i));
+    if (pl)
+    {
+      int *msgno = NULL;
+      ARRAY_FOREACH(msgno, pl)
+      {
+        if (*msgno < num)
+          seen[*msgno] = true;
+      }
+    }
+    for (int j = 0; j < num; j++)
+      cand[j] = cand[j] && seen[j];
+    memset(seen, 0, num * sizeof(bool));
+  }
+  FREE(&seen);
+  return true;
+}
+
+/**
+ * tri_node_needle - Get the plain substring a Pattern node searches for
+ * @param[in]  pat   Pattern node
+ * @param[out] field Field tag the node matches against
+ * @retval ptr  The substring
+ * @retval NULL The node can't use the index
+ */
+static const char *tri_node_needle(const struct Pattern *pat, uint32_t *field)
+{
+  if (pat->pat_not)
+    return NULL;
+
+  switch (pat->op)
+  {
+    case MUTT_PAT_FROM:
+      /* all_addr (~f with '^') matches messages with no From at all */
+      if (pat->all_addr)
+        return NULL;
+      *field = TRI_FIELD_FROM;
+      break;
+    case MUTT_PAT_SUBJECT:
+      *field = TRI_FIELD_SUBJECT;
+      break;
+    default:
+      return NULL;
+  }
+
+  if (pat->string_match)
+    return pat->p.str;
+  if (pat->literal)
+    return pat->raw_pattern;
+  return NULL; /* a real regex - the trigrams of its text are meaningless */
+}
+
+static bool tri_list_candidates(struct Mailbox *m, struct PatternList *list, bool *cand, int num);
+
+/**
+ * tri_or_candidates - Candidates for an OR of Patterns
+ * @param[in]  m    Mailbox to match against
+ * @param[in]  list List of alternatives
+ * @param[out] cand Candidate flags, one per message; overwritten
+ * @param[in]  num  Number of messages
+ * @retval true Every alternative was usable, so the union is a valid superset
+ */
+static bool tri_or_candidates(struct Mailbox *m, struct PatternList *list, bool *cand, int num)
+{
+  memset(cand, 0, num * sizeof(bool));
+  bool *sub = mutt_mem_calloc(num, sizeof(bool));
+
+  struct Pattern *np = NULL;
+  SLIST_FOREACH(np, list, entries)
+  {
+    bool usable = false;
+    memset(sub, true, num * sizeof(bool));
+
+    uint32_t field = 0;
+    const char *needle = NULL;
+    if (!np->pat_not && (np->op == MUTT_PAT_AND))
+      usable = tri_list_candidates(m, np->child, sub, num);
+    else if (!np->pat_not && (np->op == MUTT_PAT_OR))
+      usable = tri_or_candidates(m, np->child, sub, num);
+    else if (!np->pat_not &&
+             ((np->op == MUTT_PAT_DATE) || (np->op == MUTT_PAT_DATE_RECEIVED)))
+      usable = mutt_date_index_candidates(m, np, sub, num);
+    else if (mutt_flag_index_candidates(m, np, sub, num))
+      usable = true; /* flag bitmaps are exact, so negation is fine too */
+    else if ((needle = tri_node_needle(np, &field)))
+      usable = tri_needle_candidates(field, needle, sub, num);
+
+    if (!usable)
+    {
+      /* one un-indexable alternative makes the whole OR un-indexable */
+      FREE(&sub);
+      return false;
+    }
+
+    for (int i = 0; i < num; i++)
+      cand[i] = cand[i] || sub[i];
+  }
+
+  FREE(&sub);
+  return true;
+}
+
+/**
+ * tri_list_candidates - Candidates for an AND of Patterns
+ * @param[in]     m    Mailbox to match against
+ * @param[in]     list List of Patterns, implicitly ANDed
+ * @param[in,out] cand Candidate flags, one per message; narrowed in place
+ * @param[in]     num  Number of messages
+ * @retval true At least one Pattern could narrow the candidates
+ *
+ * Un-indexable nodes are simply skipped: dropping a conjunct can only widen
+ * the candidate set, so the superset guarantee holds.
+ */
+static bool tri_list_candidates(struct Mailbox *m, struct PatternList *list, bool *cand, int num)
+{
+  bool usable = false;
+
+  struct Pattern *np = NULL;
+  SLIST_FOREACH(np, list, entries)
+  {
+    if (!np->pat_not && (np->op == MUTT_PAT_AND))
+    {
+      usable |= tri_list_candidates(m, np->child, cand, num);
+      continue;
+    }
+
+    uint32_t field = 0;
+    const char *needle = NULL;
+    if (!np->pat_not && (np->op == MUTT_PAT_OR))
+    {
+      bool *sub = mutt_mem_calloc(num, sizeof(bool));
+      if (tri_or_candidates(m, np->child, sub, num))
+      {
+        for (int i = 0; i < num; i++)
+          cand[i] = cand[i] && sub[i];
+        usable = true;
+      }
+      FREE(&sub);
+    }
+    else if (!np->pat_not &&
+             ((np->op == MUTT_PAT_DATE) || (np->op == MUTT_PAT_DATE_RECEIVED)))
+    {
+      usable |= mutt_date_index_candidates(m, np, cand, num);
+    }
+    else if (mutt_flag_index_candidates(m, np, cand, num))
+    {
+      usable = true; /* flag bitmaps are exact, so negation is fine too */
+    }
+    else if ((needle = tri_node_needle(np, &field)))
+    {
+      usable |= tri_needle_candidates(field, needle, cand, num);
+    }
+  }
+
+  return usable;
+}
+
+/**
+ * mutt_trigram_candidates - Narrow a limit to the messages that can match
+ * @param[in]  m    Mailbox to match against
+ * @param[in]  pat  Compiled pattern of the limit
+ * @param[out] cand One flag per message; true means "verify this one"
+ * @param[in]  num  Number of messages, must be m->msg_count
+ * @retval true The index applied; only flagged messages need pattern execution
+ * @retval false The pattern can't use the index; match every message
+ */
+bool mutt_trigram_candidates(struct Mailbox *m, struct PatternList *pat,
+                             bool *cand, int num)
+{
+  if (!m || !pat || !cand || (num != m->msg_count))
+    return false;
+
+  const bool c_pattern_trigram_index =
+      cs_subset_bool(NeoMutt->sub, "pattern_trigram_index");
+  const bool c_pattern_date_index =
+      cs_subset_bool(NeoMutt->sub, "pattern_date_index");
+  const bool c_pattern_flag_index =
+      cs_subset_bool(NeoMutt->sub, "pattern_flag_index");
+  if (!c_pattern_trigram_index && !c_pattern_date_index && !c_pattern_flag_index)
+    return false;
+
+  if (c_pattern_trigram_index)
+  {
+    if ((TriIndex.mailbox != m) || (TriIndex.msg_count != m->msg_count) ||
+        (TriIndex.gen != pattern_cache_generation()) || !TriIndex.table)
+    {
+      tri_index_build(m);
+    }
+  }
+  else
+  {
+    mutt_hash_free(&TriIndex.table);
+    TriIndex.mailbox = NULL;
+  }
+
+  memset(cand, true, num * sizeof(bool));
+  if (!tri_list_candidates(m, pat, cand, num))
+    return false;
+
+  int n = 0;
+  for (int i = 0; i < num; i++)
+    if (cand[i])
+      n++;
+  mutt_debug(LL_DEBUG2, "trigram index: %d of %d candidates\n", n, num);
+  return true;
+}
+
+/**
+ * mutt_trigram_cleanup - Free the trigram index
+ */
+void mutt_trigram_cleanup(void)
+{
+  mutt_hash_free(&TriIndex.table);
+  TriIndex.mailbox = NULL;
+  TriIndex.msg_count = 0;
+  TriIndex.gen = 0;
+}
@@ -376,6 +376,7 @@ static enum PopAuthRes pop_auth_oauth(struct PopAccountData *adata, const char *
     decoded_err[len] = '\0';
     err = decoded_err;
   }
+  mutt_account_oauth_invalidate(&adata->conn->account);
   mutt_error("%s %s", _("Authentication failed"), err);
 
   return POP_A_FAILURE;
@@ -162,6 +162,8 @@ static int fetch_capa(const char *line, void *data)
     adata->cmd_uidl = 1;
   else if (mutt_istr_startswith(line, "TOP"))
     adata->cmd_top = 1;
+  else if (mutt_istr_startswith(line, "PIPELINING"))
+    adata->cmd_pipelining = true;
 
   return 0;
 }
@@ -209,6 +211,7 @@ static int pop_capabilities(struct PopAccountData *adata, int mode)
     adata->cmd_user = 0;
     adata->cmd_uidl = 0;
     adata->cmd_top = 0;
+    adata->cmd_pipelining = false;
     adata->resp_codes = false;
     adata->expire = true;
     adata->login_delay = 0;
@@ -448,6 +451,40 @@ void pop_logout(struct Mailbox *m)
   adata->status = POP_DISCONNECTED;
 }
 
+/**
+ * pop_read_response - Read a status response from the server
+ * @param adata  POP Account data
+ * @param buf    Buffer to store the response
+ * @param buflen Buffer length
+ * @param cmd    Command the response answers (for error messages), can be NULL
+ * @retval  0 Successful
+ * @retval -1 Connection lost
+ * @retval -2 Invalid command or execution error
+ *
+ * Read the reply to a command that was sent earlier, e.g. as part of a
+ * pipelined batch of commands.
+ */
+int pop_read_response(struct PopAccountData *adata, char *buf, size_t buflen,
+                      const char *cmd)
+{
+  if (adata->status != POP_CONNECTED)
+    return -1;
+
+  if (cmd)
+    snprintf(adata->err_msg, sizeof(adata->err_msg), "%s: ", cmd);
+
+  if (mutt_socket_readln_d(buf, buflen, adata->conn, MUTT_SOCK_LOG_FULL) < 0)
+  {
+    adata->status = POP_DISCONNECTED;
+    return -1;
+  }
+  if (mutt_str_startswith(buf, "+OK"))
+    return 0;
+
+  pop_error(adata, buf);
+  return -2;
+}
+
 /**
  * pop_query_d - Send data from buffer and receive answer to the same buffer
  * @param adata  POP Account data
@@ -474,18 +511,8 @@ int pop_query_d(struct PopAccountData *adata, char *buf, size_t buflen, char *ms
   char *c = strpbrk(buf, " \r\n");
   if (c)
     *c = '\0';
-  snprintf(adata->err_msg, sizeof(adata->err_msg), "%s: ", buf);
 
-  if (mutt_socket_readln_d(buf, buflen, adata->conn, MUTT_SOCK_LOG_FULL) < 0)
-  {
-    adata->status = POP_DISCONNECTED;
-    return -1;
-  }
-  if (mutt_str_startswith(buf, "+OK"))
-    return 0;
-
-  pop_error(adata, buf);
-  return -2;
+  return pop_read_response(adata, buf, buflen, buf);
 }
 
 /**
@@ -507,14 +534,36 @@ int pop_fetch_data(struct PopAccountData *adata, const char *query,
                    struct Progress *progress, pop_fetch_t callback, void *data)
 {
   char buf[1024];
-  long pos = 0;
-  size_t lenbuf = 0;
 
   mutt_str_copy(buf, query, sizeof(buf));
   int rc = pop_query(adata, buf, sizeof(buf));
   if (rc < 0)
     return rc;
 
+  return pop_fetch_reply(adata, progress, callback, data);
+}
+
+/**
+ * pop_fetch_reply - Read a multi-line reply with callback function
+ * @param adata    POP Account data
+ * @param progress Progress bar
+ * @param callback Function called for each line read
+ * @param data     Data to pass to the callback
+ * @retval  0 Successful
+ * @retval -1 Connection lost
+ * @retval -3 Error in callback(*line, *data)
+ *
+ * Read the multi-line part of the reply to a command whose status line has
+ * already been consumed, e.g. by pop_read_response().
+ */
+int pop_fetch_reply(struct PopAccountData *adata, struct Progress *progress,
+                    pop_fetch_t callback, void *data)
+{
+  char buf[1024];
+  long pos = 0;
+  size_t lenbuf = 0;
+  int rc = 0;
+
   char *inbuf = mutt_mem_malloc(sizeof(buf));
 
   while (true)
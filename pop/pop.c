@@ -106,6 +106,43 @@ static int fetch_message(const char *line, void *data)
   return 0;
 }
 
+/**
+ * fetch_null - Discard a line - Implements ::pop_fetch_t - @ingroup pop_fetch_api
+ * @param line String to discard
+ * @param data Private data (UNUSED)
+ * @retval 0 (always)
+ */
+static int fetch_null(const char *line, void *data)
+{
+  return 0;
+}
+
+/**
+ * pop_drain_reply - Discard a queued server reply
+ * @param adata     POP Account data
+ * @param multiline true, if a successful reply is multi-line
+ *
+ * When an error aborts a pipelined batch, the replies to the commands still
+ * in flight are read and thrown away (without touching err_msg), so that the
+ * connection stays usable.
+ */
+static void pop_drain_reply(struct PopAccountData *adata, bool multiline)
+{
+  char buf[1024];
+
+  if (adata->status != POP_CONNECTED)
+    return;
+
+  if (mutt_socket_readln_d(buf, sizeof(buf), adata->conn, MUTT_SOCK_LOG_FULL) < 0)
+  {
+    adata->status = POP_DISCONNECTED;
+    return;
+  }
+
+  if (multiline && mutt_str_startswith(buf, "+OK"))
+    pop_fetch_reply(adata, NULL, fetch_null, NULL);
+}
+
 /**
  * pop_read_header - Read header
  * @param adata POP Account data
@@ -190,6 +227,105 @@ static int pop_read_header(struct PopAccountData *adata, struct Email *e)
   return rc;
 }
 
+/**
+ * pop_send_header_req - Queue a request for a message's header
+ * @param adata POP Account data
+ * @param e     Email
+ * @retval  0 Success
+ * @retval -1 Connection lost
+ *
+ * The commands are buffered by the socket layer and flushed when the first
+ * reply is read, so requests for several messages cost a single round-trip.
+ * The replies are parsed, in order, by pop_read_header_reply().
+ */
+static int pop_send_header_req(struct PopAccountData *adata, struct Email *e)
+{
+  if (adata->status != POP_CONNECTED)
+    return -1;
+
+  char buf[1024];
+  struct PopEmailData *edata = pop_edata_get(e);
+
+  snprintf(buf, sizeof(buf), "LIST %d\r\nTOP %d 0\r\n", edata->refno, edata->refno);
+  if (mutt_socket_send_d(adata->conn, buf, MUTT_SOCK_LOG_FULL) < 0)
+  {
+    adata->status = POP_DISCONNECTED;
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+ * pop_read_header_reply - Parse the replies to a queued header request
+ * @param adata POP Account data
+ * @param e     Email
+ * @retval  0 Success
+ * @retval -1 Connection lost
+ * @retval -2 Invalid command or execution error
+ * @retval -3 Error writing to tempfile
+ *
+ * Counterpart of pop_send_header_req() - consumes the LIST and TOP replies.
+ */
+static int pop_read_header_reply(struct PopAccountData *adata, struct Email *e)
+{
+  FILE *fp = mutt_file_mkstemp();
+  if (!fp)
+  {
+    mutt_perror(_("Can't create temporary file"));
+    return -3;
+  }
+
+  int index = 0;
+  size_t length = 0;
+  char buf[1024];
+
+  int rc = pop_read_response(adata, buf, sizeof(buf), "LIST");
+  if (rc == 0)
+  {
+    sscanf(buf, "+OK %d %zu", &index, &length);
+
+    rc = pop_read_response(adata, buf, sizeof(buf), "TOP");
+    if (rc == 0)
+      rc = pop_fetch_reply(adata, NULL, fetch_message, fp);
+  }
+  else if (rc == -2)
+  {
+    /* the reply to the TOP command is queued behind the failed LIST */
+    pop_drain_reply(adata, true);
+  }
+
+  switch (rc)
+  {
+    case 0:
+    {
+      rewind(fp);
+      e->env = mutt_rfc822_read_header(fp, e, false, false);
+      e->body->length = length - e->body->offset + 1;
+      rewind(fp);
+      while (!feof(fp))
+      {
+        e->body->length--;
+        fgets(buf, sizeof(buf), fp);
+      }
+      break;
+    }
+    case -2:
+    {
+      mutt_error("%s", adata->err_msg);
+      break;
+    }
+    case -3:
+    {
+      mutt_error(_("Can't write header to temporary file"));
+      break;
+    }
+  }
+
+  mutt_file_fclose(&fp);
+  return rc;
+}
+
 /**
  * fetch_uidl - Parse UIDL - Implements ::pop_fetch_t - @ingroup pop_fetch_api
  * @param line String to parse
@@ -391,15 +527,36 @@ static int pop_fetch_headers(struct Mailbox *m)
     }
 
     bool hcached = false;
+#ifdef USE_HCACHE
+    /* look the new messages up in the header cache first, so that the
+     * pipelined requests below can skip over the cached ones */
+    struct HCacheEntry *hces =
+        mutt_mem_calloc(new_count - old_count + 1, sizeof(struct HCacheEntry));
+    for (i = old_count; i < new_count; i++)
+    {
+      struct PopEmailData *edata = pop_edata_get(m->emails[i]);
+      hces[i - old_count] = mutt_hcache_fetch(hc, edata->uid, strlen(edata->uid), 0);
+    }
+#endif
+
+    /* If the server supports pipelining, keep a window of LIST/TOP pairs on
+     * the wire ahead of the replies being parsed.  The socket layer
+     * coalesces the queued commands and flushes them on the first read, so
+     * a whole window costs one round-trip instead of one per message. */
+    const bool pipeline = adata->cmd_pipelining && (adata->cmd_top == 1);
+    int sent_until = old_count;
+    int inflight = 0;
+
     for (i = old_count; i < new_count; i++)
     {
       if (m->verbose)
         progress_update(progress, i + 1 - old_count, -1);
       struct PopEmailData *edata = pop_edata_get(m->emails[i]);
 #ifdef USE_HCACHE
-      struct HCacheEntry hce = mutt_hcache_fetch(hc, edata->uid, strlen(edata->uid), 0);
+      struct HCacheEntry hce = hces[i - old_count];
       if (hce.email)
       {
+        hces[i - old_count].email = NULL;
         /* Detach the private data */
         m->emails[i]->edata = NULL;
 
@@ -423,14 +580,52 @@ static int pop_fetch_headers(struct Mailbox *m)
       }
       else
 #endif
-          if ((rc = pop_read_header(adata, m->emails[i])) < 0)
-        break;
-#ifdef USE_HCACHE
-      else
       {
+        if (pipeline)
+        {
+          if (sent_until <= i)
+            sent_until = i;
+          rc = 0;
+          while ((inflight < POP_CMD_PIPELINE) && (sent_until < new_count))
+          {
+            bool cached = false;
+#ifdef USE_HCACHE
+            cached = (hces[sent_until - old_count].email != NULL);
+#endif
+            if (!cached)
+            {
+              rc = pop_send_header_req(adata, m->emails[sent_until]);
+              if (rc < 0)
+                break;
+              inflight++;
+            }
+            sent_until++;
+          }
+          if (rc == 0)
+          {
+            rc = pop_read_header_reply(adata, m->emails[i]);
+            inflight--;
+          }
+        }
+        else
+        {
+          rc = pop_read_header(adata, m->emails[i]);
+        }
+
+        if (rc < 0)
+        {
+          /* don't leave the replies to the other queued requests behind */
+          for (; inflight > 0; inflight--)
+          {
+            pop_drain_reply(adata, false);
+            pop_drain_reply(adata, true);
+          }
+          break;
+        }
+#ifdef USE_HCACHE
         mutt_hcache_store(hc, edata->uid, strlen(edata->uid), m->emails[i], 0);
-      }
 #endif
+      }
 
       /* faked support for flags works like this:
        * - if 'hcached' is true, we have the message in our hcache:
@@ -462,6 +657,13 @@ static int pop_fetch_headers(struct Mailbox *m)
 
       m->msg_count++;
     }
+
+#ifdef USE_HCACHE
+    /* free the cached headers that weren't consumed (error exit) */
+    for (int j = old_count; j < new_count; j++)
+      email_free(&hces[j - old_count].email);
+    FREE(&hces);
+#endif
   }
   progress_free(&progress);
 
@@ -612,13 +814,47 @@ void pop_fetch_mail(void)
            bytes);
   mutt_message("%s", msgbuf);
 
+  /* If the server supports pipelining, keep a window of RETR commands on
+   * the wire and match the replies in order.  The DELE commands are
+   * deferred until the whole window has drained: a DELE sent mid-window
+   * would be answered between two RETR replies and break the in-order
+   * matching. */
+  const bool pipeline = adata->cmd_pipelining;
+  int sent_until = last + 1;
+  int delete_until = last;
+
   for (int i = last + 1; i <= msgs; i++)
   {
+    if (pipeline)
+    {
+      while ((sent_until <= msgs) && ((sent_until - i) < POP_CMD_PIPELINE))
+      {
+        snprintf(buf, sizeof(buf), "RETR %d\r\n", sent_until);
+        if (mutt_socket_send_d(adata->conn, buf, MUTT_SOCK_LOG_FULL) < 0)
+        {
+          adata->status = POP_DISCONNECTED;
+          m_spool->append = old_append;
+          mx_mbox_close(m_spool);
+          goto fail;
+        }
+        sent_until++;
+      }
+    }
+
     struct Message *msg = mx_msg_open_new(m_spool, NULL, MUTT_ADD_FROM);
     if (msg)
     {
-      snprintf(buf, sizeof(buf), "RETR %d\r\n", i);
-      ret = pop_fetch_data(adata, buf, NULL, fetch_message, msg->fp);
+      if (pipeline)
+      {
+        ret = pop_read_response(adata, buf, sizeof(buf), "RETR");
+        if (ret == 0)
+          ret = pop_fetch_reply(adata, NULL, fetch_message, msg->fp);
+      }
+      else
+      {
+        snprintf(buf, sizeof(buf), "RETR %d\r\n", i);
+        ret = pop_fetch_data(adata, buf, NULL, fetch_message, msg->fp);
+      }
       if (ret == -3)
         rset = 1;
 
@@ -632,14 +868,25 @@ void pop_fetch_mail(void)
     }
     else
     {
+      /* the reply to the queued RETR still has to be consumed */
+      if (pipeline)
+        pop_drain_reply(adata, true);
       ret = -3;
     }
 
     if ((ret == 0) && (delanswer == MUTT_YES))
     {
-      /* delete the message on the server */
-      snprintf(buf, sizeof(buf), "DELE %d\r\n", i);
-      ret = pop_query(adata, buf, sizeof(buf));
+      if (pipeline)
+      {
+        /* defer the DELE until the RETR window has drained */
+        delete_until = i;
+      }
+      else
+      {
+        /* delete the message on the server */
+        snprintf(buf, sizeof(buf), "DELE %d\r\n", i);
+        ret = pop_query(adata, buf, sizeof(buf));
+      }
     }
 
     if (ret == -1)
@@ -648,14 +895,15 @@ void pop_fetch_mail(void)
       mx_mbox_close(m_spool);
       goto fail;
     }
-    if (ret == -2)
+    if ((ret == -2) || (ret == -3))
     {
-      mutt_error("%s", adata->err_msg);
-      break;
-    }
-    if (ret == -3)
-    {
-      mutt_error(_("Error while writing mailbox"));
+      /* don't leave the replies to the other queued RETRs behind */
+      for (int j = i + 1; j < sent_until; j++)
+        pop_drain_reply(adata, true);
+      if (ret == -2)
+        mutt_error("%s", adata->err_msg);
+      else
+        mutt_error(_("Error while writing mailbox"));
       break;
     }
 
@@ -666,6 +914,35 @@ void pop_fetch_mail(void)
                  msgbuf, i - last, msgs - last);
   }
 
+  /* the RETR window has drained; now delete the fetched messages, again
+   * keeping a window of commands on the wire */
+  int dele_sent = last + 1;
+  for (int i = last + 1; i <= delete_until; i++)
+  {
+    while ((dele_sent <= delete_until) && ((dele_sent - i) < POP_CMD_PIPELINE))
+    {
+      snprintf(buf, sizeof(buf), "DELE %d\r\n", dele_sent);
+      if (mutt_socket_send_d(adata->conn, buf, MUTT_SOCK_LOG_FULL) < 0)
+      {
+        adata->status = POP_DISCONNECTED;
+        m_spool->append = old_append;
+        mx_mbox_close(m_spool);
+        goto fail;
+      }
+      dele_sent++;
+    }
+
+    ret = pop_read_response(adata, buf, sizeof(buf), "DELE");
+    if (ret == -1)
+    {
+      m_spool->append = old_append;
+      mx_mbox_close(m_spool);
+      goto fail;
+    }
+    if (ret == -2)
+      mutt_error("%s", adata->err_msg);
+  }
+
   m_spool->append = old_append;
   mx_mbox_close(m_spool);
 
@@ -41,6 +41,10 @@ struct Progress;
 /* maximal length of the server response (RFC1939) */
 #define POP_CMD_RESPONSE 512
 
+/* number of commands kept on the wire ahead of their replies when the
+ * server supports pipelining (RFC2449) */
+#define POP_CMD_PIPELINE 32
+
 /**
  * enum PopStatus - POP server responses
  */
@@ -111,8 +115,12 @@ int pop_parse_path(const char *path, struct ConnAccount *acct);
 int pop_connect(struct PopAccountData *adata);
 int pop_open_connection(struct PopAccountData *adata);
 int pop_query_d(struct PopAccountData *adata, char *buf, size_t buflen, char *msg);
+int pop_read_response(struct PopAccountData *adata, char *buf, size_t buflen,
+                      const char *cmd);
 int pop_fetch_data(struct PopAccountData *adata, const char *query,
                    struct Progress *progress, pop_fetch_t callback, void *data);
+int pop_fetch_reply(struct PopAccountData *adata, struct Progress *progress,
+                    pop_fetch_t callback, void *data);
 int pop_reconnect(struct Mailbox *m);
 void pop_logout(struct Mailbox *m);
 const char *pop_get_field(enum ConnAccountField field, void *gf_data);
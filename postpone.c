@@ -39,6 +39,8 @@
 #include "email/lib.h"
 #include "core/lib.h"
 #include "mutt.h"
+#include "maildir/lib.h"
+#include "mbox/lib.h"
 #include "ncrypt/lib.h"
 #include "send/lib.h"
 #include "context.h"
@@ -144,33 +146,53 @@ int mutt_num_postponed(struct Mailbox *m, bool force)
 
   if (LastModify < st.st_mtime)
   {
-#ifdef USE_NNTP
-    int optnews = OptNews;
-#endif
     LastModify = st.st_mtime;
 
     if (access(c_postponed, R_OK | F_OK) != 0)
       return PostCount = 0;
-#ifdef USE_NNTP
-    if (optnews)
-      OptNews = false;
-#endif
-    struct Mailbox *m_post = mx_path_resolve(c_postponed);
-    if (mx_mbox_open(m_post, MUTT_NOSORT | MUTT_QUIET))
+
+    /* just count the messages; opening the mailbox would parse every draft */
+    int newpc = -1;
+    switch (mx_path_probe(c_postponed))
     {
-      PostCount = m_post->msg_count;
-      mx_fastclose_mailbox(m_post, false);
+      case MUTT_MBOX:
+        newpc = mbox_count_messages(c_postponed);
+        break;
+      case MUTT_MAILDIR:
+        newpc = maildir_count_messages(c_postponed);
+        break;
+      default:
+        break;
     }
-    else
+
+    if (newpc >= 0)
     {
-      PostCount = 0;
+      PostCount = newpc;
     }
-    mailbox_free(&m_post);
+    else
+    {
+#ifdef USE_NNTP
+      int optnews = OptNews;
+      if (optnews)
+        OptNews = false;
+#endif
+      struct Mailbox *m_post = mx_path_resolve(c_postponed);
+      if (mx_mbox_open(m_post, MUTT_NOSORT | MUTT_QUIET))
+      {
+        PostCount = m_post->msg_count;
+        mx_fastclose_mailbox(m_post, false);
+      }
+      else
+      {
+        PostCount = 0;
+      }
+      mailbox_free(&m_post);
 
 #ifdef USE_NNTP
-    if (optnews)
-      OptNews = true;
+      if (optnews)
+        OptNews = true;
 #endif
+    }
   }
 
   return PostCount;
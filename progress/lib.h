@@ -48,8 +48,10 @@ enum ProgressType
   MUTT_PROGRESS_NET    ///< Progress tracks bytes, according to `$net_inc`
 };
 
+void             progress_count (struct Progress *progress);
 void             progress_free  (struct Progress **ptr);
 struct Progress *progress_new   (const char *msg, enum ProgressType type, size_t size);
+void             progress_poll  (struct Progress *progress);
 void             progress_update(struct Progress *progress, size_t pos, int percent);
 
 #endif /* MUTT_PROGRESS_LIB_H */
@@ -28,7 +28,9 @@
  */
 
 #include "config.h"
+#include <pthread.h>
 #include <stdarg.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
@@ -56,6 +58,8 @@ struct Progress
   size_t inc;                   ///< Increment size
   uint64_t timestamp;           ///< Time of last update
   bool is_bytes;                ///< true if measuring bytes
+  atomic_size_t count;          ///< Items counted by progress_count(), any thread
+  pthread_t owner;              ///< Thread that owns the display, see progress_poll()
 };
 
 /**
@@ -225,6 +229,40 @@ void progress_update(struct Progress *progress, size_t pos, int percent)
   }
 }
 
+/**
+ * progress_count - Count one item towards the progress, from any thread
+ * @param progress Progress bar
+ *
+ * A single relaxed atomic increment; safe in tight parallel loops and never
+ * touches curses.  The display thread makes the count visible by calling
+ * progress_poll().
+ */
+void progress_count(struct Progress *progress)
+{
+  if (!progress)
+    return;
+
+  atomic_fetch_add_explicit(&progress->count, 1, memory_order_relaxed);
+}
+
+/**
+ * progress_poll - Display the progress counted so far
+ * @param progress Progress bar
+ *
+ * Sample the progress_count() counter and redraw the bar if enough items (or
+ * `$time_inc` milliseconds) have passed.  Curses isn't thread-safe, so this
+ * only has an effect on the thread that created the Progress Bar; worker
+ * threads may call it unconditionally and it will do nothing.
+ */
+void progress_poll(struct Progress *progress)
+{
+  if (!progress || !pthread_equal(pthread_self(), progress->owner))
+    return;
+
+  const size_t pos = atomic_load_explicit(&progress->count, memory_order_relaxed);
+  progress_update(progress, pos, -1);
+}
+
 /**
  * progress_free - Free a Progress Bar
  * @param ptr Progress Bar to free
@@ -262,6 +300,7 @@ struct Progress *progress_new(const char *msg, enum ProgressType type, size_t si
   progress->size = size;
   progress->inc = choose_increment(type);
   progress->is_bytes = (type == MUTT_PROGRESS_NET);
+  progress->owner = pthread_self();
   progress->old_focus = window_set_focus(progress->win);
 
   /* Generate the size string, if a total size was specified */
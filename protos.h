@@ -64,6 +64,8 @@ int mutt_set_xdg_path(enum XdgType type, struct Buffer *buf);
 void mutt_help(enum MenuType menu);
 void mutt_set_flag_update(struct Mailbox *m, struct Email *e, enum MessageType flag, bool bf, bool upd_mbox);
 #define mutt_set_flag(m, e, flag, bf) mutt_set_flag_update(m, e, flag, bf, true)
+void mutt_flag_batch_begin(void);
+void mutt_flag_batch_end(struct Mailbox *m);
 void mutt_signal_init(void);
 void mutt_emails_set_flag(struct Mailbox *m, struct EmailList *el, enum MessageType flag, bool bf);
 int mutt_change_flag(struct Mailbox *m, struct EmailList *el, bool bf);
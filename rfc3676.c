@@ -54,6 +54,76 @@ struct FlowedState
   bool delsp;
 };
 
+/**
+ * struct FlowedWord - One word of a tokenized format=flowed paragraph
+ */
+struct FlowedWord
+{
+  const char *word; ///< Word text, points into a line held by #FlowedCache
+  size_t width;     ///< Screen width of the word
+  size_t spaces;    ///< Number of spaces before the word
+  bool nobreak;     ///< Never wrap before this word (DelSp long-word continuation)
+};
+ARRAY_HEAD(FlowedWordArray, struct FlowedWord);
+
+/**
+ * enum FlowedUnitType - Type of a tokenized unit
+ */
+enum FlowedUnitType
+{
+  FUT_PARAGRAPH, ///< Flowed paragraph, re-wrap it to the current width
+  FUT_FIXED,     ///< Fixed line, reproduce it verbatim
+  FUT_EMPTY,     ///< Empty flowed line, prints just the quote indent
+};
+
+/**
+ * struct FlowedUnit - One paragraph or fixed line of a tokenized body
+ */
+struct FlowedUnit
+{
+  enum FlowedUnitType type; ///< Paragraph, fixed line or empty line
+  int quotelevel;           ///< Quote level of the unit
+  const char *line;         ///< Text of a fixed line
+  size_t first_word;        ///< Index of the first word into FlowedCache.words
+  size_t num_words;         ///< Number of words of a paragraph
+};
+ARRAY_HEAD(FlowedUnitArray, struct FlowedUnit);
+ARRAY_HEAD(FlowedLineArray, char *);
+
+/**
+ * struct FlowedCache - Tokenized copy of the last format=flowed body displayed
+ *
+ * Resizing the terminal makes the pager re-run the handler on the whole body,
+ * just to wrap it to the new width.  Splitting the text into paragraphs and
+ * words is the expensive part, so keep the structure of the last displayed
+ * body and only re-wrap it.
+ */
+static struct FlowedCache
+{
+  struct Body *body;            ///< Body the tokens belong to
+  LOFF_T offset;                ///< Offset of the Body, guards against a recycled pointer
+  LOFF_T length;                ///< Length of the Body, guards against a recycled pointer
+  struct FlowedLineArray lines; ///< Backing storage for the word and line text
+  struct FlowedUnitArray units; ///< Paragraphs and fixed lines, in order
+  struct FlowedWordArray words; ///< Words of all the paragraphs
+} FlowedCache = { 0 };
+
+/**
+ * mutt_rfc3676_cleanup - Free the format=flowed reflow cache
+ */
+void mutt_rfc3676_cleanup(void)
+{
+  char **linep = NULL;
+  ARRAY_FOREACH(linep, &FlowedCache.lines)
+  {
+    FREE(linep);
+  }
+  ARRAY_FREE(&FlowedCache.lines);
+  ARRAY_FREE(&FlowedCache.units);
+  ARRAY_FREE(&FlowedCache.words);
+  FlowedCache.body = NULL;
+}
+
 /**
  * get_quote_level - Get the quote level of a line
  * @param line Text to examine
@@ -313,6 +383,237 @@ static void print_fixed_line(const char *line, struct State *s, int ql, struct F
   fst->spaces = 0;
 }
 
+/**
+ * flowed_par_add - Record a tokenized paragraph in the cache
+ * @param ql         Quote level of the paragraph
+ * @param first_word Index of its first word in FlowedCache.words
+ *
+ * Paragraphs without any words produce no output and aren't recorded.
+ */
+static void flowed_par_add(int ql, size_t first_word)
+{
+  const size_t num = ARRAY_SIZE(&FlowedCache.words) - first_word;
+  if (num == 0)
+    return;
+
+  struct FlowedUnit unit = { FUT_PARAGRAPH, ql, NULL, first_word, num };
+  ARRAY_ADD(&FlowedCache.units, unit);
+}
+
+/**
+ * flowed_tokenize - Split a format=flowed body into paragraphs and words
+ * @param a         Body to tokenize
+ * @param s         State to read the body from
+ * @param delsp     If true, the part declares DelSp=yes
+ * @param has_delsp If true, the part declares DelSp at all
+ *
+ * This mirrors the line handling of rfc3676_handler() and print_flowed_line(),
+ * but records the paragraph structure instead of printing it.
+ */
+static void flowed_tokenize(struct Body *a, struct State *s, bool delsp, bool has_delsp)
+{
+  mutt_rfc3676_cleanup();
+
+  char *buf = NULL;
+  size_t sz = 0;
+  int quotelevel = 0;
+  bool in_par = false;    ///< A paragraph is being collected
+  bool par_words = false; ///< It already holds words, i.e. fst.width != 0
+  size_t par_first = 0;   ///< Index of its first word
+  int par_ql = 0;         ///< Its quote level
+  size_t pending = 0;     ///< Spaces seen since the last word, i.e. fst.spaces
+
+  while ((buf = mutt_file_read_line(buf, &sz, s->fp_in, NULL, MUTT_RL_NO_FLAGS)))
+  {
+    const size_t buf_len = mutt_str_len(buf);
+    const int newql = get_quote_level(buf);
+
+    if (newql != quotelevel)
+    {
+      if (in_par)
+        flowed_par_add(par_ql, par_first);
+      in_par = false;
+      par_words = false;
+      pending = 0;
+    }
+
+    quotelevel = newql;
+    int buf_off = newql;
+
+    /* respect sender's space-stuffing by removing one leading space */
+    if (buf[buf_off] == ' ')
+      buf_off++;
+
+    /* test for signature separator */
+    const bool sigsep = mutt_str_equal(buf + buf_off, "-- ");
+
+    /* a fixed line either has no trailing space or is the
+     * signature separator */
+    const bool fixed = (buf_len == buf_off) || (buf[buf_len - 1] != ' ') || sigsep;
+
+    /* fixed-and-standalone, fixed-and-empty and sigsep lines become
+     * fixed units */
+    if ((fixed && (!par_words || (buf_len == 0))) || sigsep)
+    {
+      if (in_par)
+        flowed_par_add(par_ql, par_first);
+      in_par = false;
+      par_words = false;
+      pending = 0;
+
+      char *copy = mutt_str_dup(buf + buf_off);
+      if (copy)
+        ARRAY_ADD(&FlowedCache.lines, copy);
+      struct FlowedUnit unit = { FUT_FIXED, quotelevel, copy, 0, 0 };
+      ARRAY_ADD(&FlowedCache.units, unit);
+      continue;
+    }
+
+    /* for DelSp=yes, we need to strip one SP prior to CRLF on flowed lines */
+    if (delsp && !fixed)
+      buf[buf_len - 1] = '\0';
+
+    if (buf[buf_off] == '\0')
+    {
+      /* an empty line ends the paragraph and prints only the indent */
+      if (in_par)
+        flowed_par_add(par_ql, par_first);
+      in_par = false;
+      par_words = false;
+      pending = 0;
+
+      struct FlowedUnit unit = { FUT_EMPTY, quotelevel, NULL, 0, 0 };
+      ARRAY_ADD(&FlowedCache.units, unit);
+      continue;
+    }
+
+    if (!in_par)
+    {
+      in_par = true;
+      par_first = ARRAY_SIZE(&FlowedCache.words);
+      par_ql = quotelevel;
+    }
+
+    char *copy = mutt_str_dup(buf + buf_off);
+    ARRAY_ADD(&FlowedCache.lines, copy);
+    const size_t clen = mutt_str_len(copy);
+    const char last = clen ? copy[clen - 1] : '\0';
+
+    size_t words = 0;
+    char *line = copy;
+    char *p = NULL;
+    while ((p = mutt_str_sep(&line, " ")))
+    {
+      /* remember number of spaces */
+      if (*p == '\0')
+      {
+        pending++;
+        continue;
+      }
+      /* there's exactly one space prior to every but the first word */
+      if (words)
+        pending++;
+
+      struct FlowedWord fw = {
+        .word = p,
+        .width = mutt_strwidth(p),
+        .spaces = pending,
+        .nobreak = (pending == 0) && has_delsp && (last != ' '),
+      };
+      ARRAY_ADD(&FlowedCache.words, fw);
+      pending = 0;
+      words++;
+      par_words = true;
+    }
+
+    /* a fixed line that continues a paragraph also terminates it */
+    if (fixed)
+    {
+      flowed_par_add(par_ql, par_first);
+      in_par = false;
+      par_words = false;
+      pending = 0;
+    }
+  }
+
+  if (in_par)
+    flowed_par_add(par_ql, par_first);
+
+  FREE(&buf);
+
+  FlowedCache.body = a;
+  FlowedCache.offset = a->offset;
+  FlowedCache.length = a->length;
+}
+
+/**
+ * print_flowed_cached - Re-wrap the tokenized body to the current width
+ * @param s   State to work with
+ * @param fst The state of the flowed text
+ *
+ * The wrapping decisions match print_flowed_line(), but work on the cached
+ * words, so no line reading, quote scanning or width measuring is repeated.
+ */
+static void print_flowed_cached(struct State *s, struct FlowedState *fst)
+{
+  const bool c_text_flowed = cs_subset_bool(NeoMutt->sub, "text_flowed");
+
+  struct FlowedUnit *unit = NULL;
+  ARRAY_FOREACH(unit, &FlowedCache.units)
+  {
+    const int ql = unit->quotelevel;
+
+    if (unit->type == FUT_FIXED)
+    {
+      flush_par(s, fst);
+      print_fixed_line(unit->line, s, ql, fst);
+      continue;
+    }
+
+    if (unit->type == FUT_EMPTY)
+    {
+      flush_par(s, fst);
+      print_indent(ql, s, 0);
+      state_putc(s, '\n');
+      continue;
+    }
+
+    const size_t width = quote_width(s, ql);
+    size_t words = 0;
+
+    for (size_t i = 0; i < unit->num_words; i++)
+    {
+      const struct FlowedWord *fw = ARRAY_GET(&FlowedCache.words, unit->first_word + i);
+      size_t spaces = fw->spaces;
+
+      /* see if we need to break the line but make sure the first word is put
+       * on the line regardless */
+      if (!fw->nobreak && (fw->width < width) &&
+          (fw->width + fst->width + spaces > width))
+      {
+        /* only honor trailing spaces for format=flowed replies */
+        if (c_text_flowed)
+          for (; spaces; spaces--)
+            state_putc(s, ' ');
+        state_putc(s, '\n');
+        fst->width = 0;
+        spaces = 0;
+        words = 0;
+      }
+
+      if (!words && !fst->width)
+        fst->width = print_indent(ql, s, add_quote_suffix(s, ql));
+      fst->width += fw->width + spaces;
+      for (; spaces; spaces--)
+        state_putc(s, ' ');
+      state_puts(s, fw->word);
+      words++;
+    }
+
+    flush_par(s, fst);
+  }
+}
+
 /**
  * rfc3676_handler - Body handler implementing RFC3676 for format=flowed - Implements ::handler_t - @ingroup handler_api
  * @retval 0 Always
@@ -336,6 +637,20 @@ int rfc3676_handler(struct Body *a, struct State *s)
 
   mutt_debug(LL_DEBUG3, "f=f: DelSp: %s\n", delsp ? "yes" : "no");
 
+  /* The pager re-runs the handler on the whole body every time the window is
+   * resized.  For display, tokenize the body once and re-wrap the cached
+   * paragraphs to the current width. */
+  if ((s->flags & MUTT_DISPLAY) && !s->prefix)
+  {
+    if ((FlowedCache.body != a) || (FlowedCache.offset != a->offset) ||
+        (FlowedCache.length != a->length))
+    {
+      flowed_tokenize(a, s, delsp, fst.delsp);
+    }
+    print_flowed_cached(s, &fst);
+    return 0;
+  }
+
   while ((buf = mutt_file_read_line(buf, &sz, s->fp_in, NULL, MUTT_RL_NO_FLAGS)))
   {
     const size_t buf_len = mutt_str_len(buf);
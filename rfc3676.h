@@ -32,6 +32,7 @@ struct Email;
 struct State;
 
 int rfc3676_handler(struct Body *a, struct State *s);
+void mutt_rfc3676_cleanup(void);
 bool mutt_rfc3676_is_format_flowed(struct Body *b);
 void mutt_rfc3676_space_stuff (struct Email *e);
 void mutt_rfc3676_space_unstuff (struct Email *e);
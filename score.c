@@ -58,6 +58,100 @@ struct Score
 
 static struct Score *ScoreList = NULL;
 
+/**
+ * score_max_possible - Highest score any email can reach
+ * @retval num Maximum achievable score
+ *
+ * An email's score is the sum of the values of all matching rules, unless an
+ * exact (or +/-9999) rule matches, in which case it's that rule's value.
+ * Negative totals are clamped to zero.
+ */
+static int score_max_possible(void)
+{
+  int sum = 0;
+  int max = 0;
+
+  for (struct Score *tmp = ScoreList; tmp; tmp = tmp->next)
+  {
+    if (tmp->exact || (tmp->val == 9999) || (tmp->val == -9999))
+    {
+      if (tmp->val > max)
+        max = tmp->val;
+    }
+    else if (tmp->val > 0)
+    {
+      sum += tmp->val;
+    }
+  }
+
+  return (sum > max) ? sum : max;
+}
+
+/**
+ * mutt_score_deferrable - Can scoring of an email be postponed?
+ * @retval true Scoring has no side effects and may be done on demand
+ *
+ * Scoring must happen eagerly if any of the `$score_threshold_delete`,
+ * `$score_threshold_read` or `$score_threshold_flag` thresholds could fire, as
+ * those change the email's flags.  Otherwise a message's score is only needed
+ * when it's displayed, matched or sorted, so callers with many messages can
+ * skip scoring the invisible ones and rely on mutt_score_require() instead.
+ */
+bool mutt_score_deferrable(void)
+{
+  const short c_score_threshold_delete =
+      cs_subset_number(NeoMutt->sub, "score_threshold_delete");
+  const short c_score_threshold_read =
+      cs_subset_number(NeoMutt->sub, "score_threshold_read");
+
+  /* scores are never negative, so these fire for any message */
+  if ((c_score_threshold_delete >= 0) || (c_score_threshold_read >= 0))
+    return false;
+
+  const short c_score_threshold_flag =
+      cs_subset_number(NeoMutt->sub, "score_threshold_flag");
+
+  return c_score_threshold_flag > score_max_possible();
+}
+
+/**
+ * mutt_score_require - Score an email whose scoring was deferred
+ * @param m Mailbox
+ * @param e Email
+ *
+ * Emails whose scoring was skipped at mailbox-open time, see
+ * mutt_score_deferrable(), are scored here on first use of Email::score.
+ */
+void mutt_score_require(struct Mailbox *m, struct Email *e)
+{
+  if (!e || e->scored)
+    return;
+
+  const bool c_score = cs_subset_bool(NeoMutt->sub, "score");
+  if (!c_score)
+    return;
+
+  mutt_score_message(m, e, true);
+}
+
+/**
+ * mutt_score_require_all - Score all the emails whose scoring was deferred
+ * @param m Mailbox
+ */
+void mutt_score_require_all(struct Mailbox *m)
+{
+  if (!m)
+    return;
+
+  for (int i = 0; i < m->msg_count; i++)
+  {
+    struct Email *e = m->emails[i];
+    if (!e)
+      break;
+    mutt_score_require(m, e);
+  }
+}
+
 /**
  * mutt_check_rescore - Do the emails need to have their scores recalculated?
  * @param m Mailbox
@@ -165,6 +259,7 @@ void mutt_score_message(struct Mailbox *m, struct Email *e, bool upd_mbox)
   struct PatternCache cache = { 0 };
 
   e->score = 0; /* in case of re-scoring */
+  e->scored = true;
   for (tmp = ScoreList; tmp; tmp = tmp->next)
   {
     if (mutt_pattern_exec(SLIST_FIRST(tmp->pat), MUTT_MATCH_FULL_ADDRESS, NULL, e, &cache) > 0)
@@ -31,8 +31,11 @@ struct Buffer;
 struct Email;
 
 void mutt_check_rescore(struct Mailbox *m);
+bool mutt_score_deferrable(void);
 enum CommandResult mutt_parse_score(struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
 enum CommandResult mutt_parse_unscore(struct Buffer *buf, struct Buffer *s, intptr_t data, struct Buffer *err);
 void mutt_score_message(struct Mailbox *m, struct Email *e, bool upd_ctx);
+void mutt_score_require(struct Mailbox *m, struct Email *e);
+void mutt_score_require_all(struct Mailbox *m);
 
 #endif /* MUTT_SCORE_H */
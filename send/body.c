@@ -42,9 +42,8 @@
  */
 struct B64Context
 {
-  char buffer[3];
+  char buffer[54]; ///< One output line's worth of raw bytes (54 * 4/3 = 72)
   short size;
-  short linelen;
 };
 
 /**
@@ -56,7 +55,6 @@ static int b64_init(struct B64Context *bctx)
 {
   memset(bctx->buffer, '\0', sizeof(bctx->buffer));
   bctx->size = 0;
-  bctx->linelen = 0;
 
   return 0;
 }
@@ -65,32 +63,21 @@ static int b64_init(struct B64Context *bctx)
  * b64_flush - Save the bytes to the file
  * @param bctx   Cursor for the base64 conversion
  * @param fp_out File to save the output
+ *
+ * Encode the buffered bytes as one line of output, at most 72 characters.
  */
 static void b64_flush(struct B64Context *bctx, FILE *fp_out)
 {
-  /* for some reasons, mutt_b64_encode expects the
-   * output buffer to be larger than 10B */
-  char encoded[11];
+  /* mutt_b64_encode() needs room for the terminating NUL, too */
+  char encoded[(sizeof(bctx->buffer) / 3) * 4 + 1];
   size_t ret;
 
   if (bctx->size == 0)
     return;
 
-  if (bctx->linelen >= 72)
-  {
-    fputc('\n', fp_out);
-    bctx->linelen = 0;
-  }
-
-  /* ret should always be equal to 4 here, because bctx->size
-   * is a value between 1 and 3 (included), but let's not hardcode it
-   * and prefer the return value of the function */
   ret = mutt_b64_encode(bctx->buffer, bctx->size, encoded, sizeof(encoded));
-  for (size_t i = 0; i < ret; i++)
-  {
-    fputc(encoded[i], fp_out);
-    bctx->linelen++;
-  }
+  fwrite(encoded, 1, ret, fp_out);
+  fputc('\n', fp_out);
 
   bctx->size = 0;
 }
@@ -103,7 +90,7 @@ static void b64_flush(struct B64Context *bctx, FILE *fp_out)
  */
 static void b64_putc(struct B64Context *bctx, char c, FILE *fp_out)
 {
-  if (bctx->size == 3)
+  if (bctx->size == sizeof(bctx->buffer))
     b64_flush(bctx, fp_out);
 
   bctx->buffer[bctx->size++] = c;
@@ -134,8 +121,10 @@ static void encode_base64(struct FgetConv *fc, FILE *fp_out, int istext)
     b64_putc(&bctx, ch, fp_out);
     ch1 = ch;
   }
-  b64_flush(&bctx, fp_out);
-  fputc('\n', fp_out);
+  if (bctx.size)
+    b64_flush(&bctx, fp_out);
+  else
+    fputc('\n', fp_out);
 }
 
 /**
@@ -321,6 +321,9 @@ static struct ConfigDef SendVarsSmtp[] = {
   { "smtp_pass", DT_STRING|DT_SENSITIVE, 0, 0, NULL,
     "(smtp) Password for the SMTP server"
   },
+  { "smtp_persist", DT_BOOL, false, 0, NULL,
+    "(smtp) Keep the server connection open between messages"
+  },
   { "smtp_url", DT_STRING|DT_SENSITIVE, 0, 0, NULL,
     "(smtp) Url of the SMTP server"
   },
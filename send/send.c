@@ -31,6 +31,7 @@
 #include <errno.h>
 #include <locale.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
@@ -1749,6 +1750,57 @@ static bool search_attach_keyword(char *filename, struct ConfigSubset *sub)
   return found;
 }
 
+/**
+ * struct AttachScan - Memoised result of an attachment keyword scan
+ */
+struct AttachScan
+{
+  char *filename;        ///< File that was scanned
+  struct timespec mtime; ///< Modification time of the file when it was scanned
+  off_t size;            ///< Size of the file when it was scanned
+  uint64_t generation;   ///< Config generation the regexes were read at
+  bool found;            ///< The regex matched
+};
+
+/// The last attachment keyword scan - the draft body rarely changes between
+/// the editor exiting and the user pressing send
+static struct AttachScan AttachScanCache = { 0 };
+
+/**
+ * search_attach_keyword_cached - Memoised version of search_attach_keyword()
+ * @param filename Filename
+ * @param sub      Config Subset
+ * @retval true The regex matches in the email
+ *
+ * The scan is repeated only if the file, or the config, has changed since the
+ * last call.  mutt_attach_keyword_prescan() uses this to pay the scan cost
+ * when the editor exits, so sending is not delayed by it.
+ */
+static bool search_attach_keyword_cached(char *filename, struct ConfigSubset *sub)
+{
+  struct stat st = { 0 };
+  if (stat(filename, &st) != 0)
+    return search_attach_keyword(filename, sub);
+
+  const uint64_t generation = cs_subset_generation();
+  if (mutt_str_equal(AttachScanCache.filename, filename) &&
+      (AttachScanCache.size == st.st_size) &&
+      (AttachScanCache.generation == generation) &&
+      (mutt_file_stat_timespec_compare(&st, MUTT_STAT_MTIME, &AttachScanCache.mtime) == 0))
+  {
+    return AttachScanCache.found;
+  }
+
+  const bool found = search_attach_keyword(filename, sub);
+
+  mutt_str_replace(&AttachScanCache.filename, filename);
+  mutt_file_get_stat_timespec(&AttachScanCache.mtime, &st, MUTT_STAT_MTIME);
+  AttachScanCache.size = st.st_size;
+  AttachScanCache.generation = generation;
+  AttachScanCache.found = found;
+  return found;
+}
+
 /**
  * save_fcc - Save an Email to a 'sent mail' folder
  * @param[in]  m             Current Mailbox
@@ -2104,7 +2156,7 @@ static bool abort_for_missing_attachments(const struct Body *b, struct ConfigSub
   /* search text/plain parts, whether they are main or alternative parts */
   if (is_text_plain(b))
   {
-    has_keyword |= search_attach_keyword(b->filename, sub);
+    has_keyword |= search_attach_keyword_cached(b->filename, sub);
   }
   else
   {
@@ -2112,7 +2164,7 @@ static bool abort_for_missing_attachments(const struct Body *b, struct ConfigSub
     {
       if (is_text_plain(b))
       {
-        has_keyword |= search_attach_keyword(b->filename, sub);
+        has_keyword |= search_attach_keyword_cached(b->filename, sub);
       }
     }
   }
@@ -2131,6 +2183,37 @@ static bool abort_for_missing_attachments(const struct Body *b, struct ConfigSub
                           _("No attachments, cancel sending?")) != MUTT_NO;
 }
 
+/**
+ * mutt_attach_keyword_prescan - Scan a draft for attachment keywords ahead of time
+ * @param b   Body of the Email
+ * @param sub Config Subset
+ *
+ * Called when the editor exits, while the user is still looking at the
+ * compose menu.  The scan result is memoised, so by the time
+ * abort_for_missing_attachments() runs at send time, the answer is already
+ * known and even a large draft adds no latency to sending.
+ */
+void mutt_attach_keyword_prescan(struct Body *b, struct ConfigSubset *sub)
+{
+  const enum QuadOption c_abort_noattach = cs_subset_quad(sub, "abort_noattach");
+
+  if ((c_abort_noattach == MUTT_NO) || !b || b->next)
+    return;
+
+  if (is_text_plain(b))
+  {
+    search_attach_keyword_cached(b->filename, sub);
+  }
+  else
+  {
+    for (b = b->parts; b; b = b->next)
+    {
+      if (is_text_plain(b))
+        search_attach_keyword_cached(b->filename, sub);
+    }
+  }
+}
+
 /**
  * mutt_send_message - Send an email
  * @param flags    Send mode, see #SendFlags
@@ -2568,6 +2651,9 @@ int mutt_send_message(SendFlags flags, struct Email *e_templ, const char *tempfi
         }
       }
 
+      /* Scan the draft now, while the user reviews the compose menu */
+      mutt_attach_keyword_prescan(e_templ->body, sub);
+
       mutt_message_hook(NULL, e_templ, MUTT_SEND2_HOOK);
     }
 
@@ -53,6 +53,7 @@ typedef uint16_t SendFlags;             ///< Flags for mutt_send_message(), e.g.
 #define SEND_NEWS             (1 << 13) ///< Reply to a news article
 
 void            mutt_add_to_reference_headers(struct Envelope *env, struct Envelope *curenv, struct ConfigSubset *sub);
+void            mutt_attach_keyword_prescan(struct Body *b, struct ConfigSubset *sub);
 struct Address *mutt_default_from(struct ConfigSubset *sub);
 int             mutt_edit_address(struct AddressList *al, const char *field, bool expand_aliases);
 void            mutt_encode_descriptions(struct Body *b, bool recurse, struct ConfigSubset *sub);
@@ -95,9 +95,32 @@ static void update_content_info(struct Content *info, struct ContentState *s,
     return;
   }
 
-  for (; buflen; buf++, buflen--)
+  while (buflen)
   {
-    char ch = *buf;
+    /* Bulk-skip runs of printable, non-space ASCII.  Once a line is longer
+     * than the "From " detection zone, such bytes only bump the counters */
+    if (!was_cr && (linelen > 4))
+    {
+      size_t run = 0;
+      while ((run < buflen) && ((unsigned char) buf[run] > 0x20) &&
+             ((unsigned char) buf[run] < 0x7f))
+      {
+        run++;
+      }
+      if (run > 0)
+      {
+        info->ascii += run;
+        linelen += run;
+        whitespace = 0;
+        dot = false;
+        buf += run;
+        buflen -= run;
+        continue;
+      }
+    }
+
+    char ch = *buf++;
+    buflen--;
 
     if (was_cr)
     {
@@ -470,7 +493,6 @@ struct Content *mutt_get_content_info(const char *fname, struct Body *b,
   FILE *fp = NULL;
   char *fromcode = NULL;
   char *tocode = NULL;
-  char buf[100];
   size_t r;
 
   struct stat st = { 0 };
@@ -531,9 +553,11 @@ struct Content *mutt_get_content_info(const char *fname, struct Body *b,
   }
 
   rewind(fp);
-  while ((r = fread(buf, 1, sizeof(buf), fp)))
+  char *buf = mutt_mem_malloc(65536);
+  while ((r = fread(buf, 1, 65536, fp)))
     update_content_info(info, &state, buf, r);
   update_content_info(info, &state, 0, 0);
+  FREE(&buf);
 
   mutt_file_fclose(&fp);
 
@@ -550,129 +574,223 @@ struct Content *mutt_get_content_info(const char *fname, struct Body *b,
 }
 
 /**
- * mutt_lookup_mime_type - Find the MIME type for an attachment
- * @param att  Email with attachment
- * @param path Path to attachment
- * @retval num MIME type, e.g. #TYPE_IMAGE
+ * struct MimeTypeEntry - Cached mime.types entry for one file extension
+ */
+struct MimeTypeEntry
+{
+  enum ContentType type; ///< Content type, e.g. #TYPE_IMAGE
+  char *subtype;         ///< Content subtype, e.g. "jpeg"
+  char *xtype;           ///< Unrecognised content type, e.g. "chemical"
+};
+
+/// Number of mime.types files to check
+#define MIME_TYPES_FILES 4
+
+/// Map of file extension to MimeTypeEntry, compiled from the mime.types files
+static struct HashTable *MimeTypes = NULL;
+/// Was at least one mime.types file found when the cache was compiled?
+static bool MimeTypesFound = false;
+/// mtimes of the mime.types files when the cache was compiled (0 if absent)
+static time_t MimeTypesMtime[MIME_TYPES_FILES];
+
+/**
+ * mime_types_filename - Get the path of one of the mime.types files
+ * @param count  Index of the file, 0 to #MIME_TYPES_FILES - 1
+ * @param buf    Buffer for the result
+ * @param buflen Length of the buffer
+ */
+static void mime_types_filename(int count, char *buf, size_t buflen)
+{
+  switch (count)
+  {
+    case 0:
+      /* check default unix mimetypes location first */
+      mutt_str_copy(buf, "/etc/mime.types", buflen);
+      break;
+    case 1:
+      mutt_str_copy(buf, SYSCONFDIR "/mime.types", buflen);
+      break;
+    case 2:
+      mutt_str_copy(buf, PKGDATADIR "/mime.types", buflen);
+      break;
+    case 3:
+      snprintf(buf, buflen, "%s/.mime.types", NONULL(HomeDir));
+      break;
+    default:
+      mutt_debug(LL_DEBUG1, "Internal error, count = %d\n", count);
+      *buf = '\0'; /* shouldn't happen */
+      break;
+  }
+}
+
+/**
+ * mime_type_entry_free - Free a MimeTypeEntry - Implements ::hash_hdata_free_t - @ingroup hash_hdata_free_api
+ */
+static void mime_type_entry_free(int type, void *obj, intptr_t data)
+{
+  struct MimeTypeEntry *entry = obj;
+
+  FREE(&entry->subtype);
+  FREE(&entry->xtype);
+  FREE(&entry);
+}
+
+/**
+ * mime_types_stale - Check if the mime.types cache needs rebuilding
+ * @retval true A mime.types file has been added, removed or modified
+ */
+static bool mime_types_stale(void)
+{
+  char buf[PATH_MAX];
+  struct stat st = { 0 };
+
+  for (int count = 0; count < MIME_TYPES_FILES; count++)
+  {
+    mime_types_filename(count, buf, sizeof(buf));
+    time_t mtime = (stat(buf, &st) == 0) ? st.st_mtime : 0;
+    if (mtime != MimeTypesMtime[count])
+      return true;
+  }
+
+  return false;
+}
+
+/**
+ * mime_types_compile - Parse the mime.types files into a Hash Table
  *
- * Given a file at 'path', see if there is a registered MIME type.
- * Returns the major MIME type, and copies the subtype to "d".  First look
- * in a system mime.types if we can find one, then look for ~/.mime.types.
- * The longest match is used so that we can match 'ps.gz' when 'gz' also
- * exists.
+ * Read each of the mime.types files once and index every extension.
+ * The first entry for an extension wins, matching the precedence of the
+ * old linear scan ("last file with last entry" only won with a strictly
+ * longer extension, i.e. a different key).
  */
-enum ContentType mutt_lookup_mime_type(struct Body *att, const char *path)
+static void mime_types_compile(void)
 {
   FILE *fp = NULL;
   char *p = NULL, *q = NULL, *ct = NULL;
   char buf[PATH_MAX];
-  char subtype[256] = { 0 };
-  char xtype[256] = { 0 };
-  int sze, cur_sze = 0;
-  bool found_mimetypes = false;
-  enum ContentType type = TYPE_OTHER;
 
-  int szf = mutt_str_len(path);
+  mutt_hash_free(&MimeTypes);
+  MimeTypes = mutt_hash_new(512, MUTT_HASH_STRCASECMP | MUTT_HASH_STRDUP_KEYS);
+  mutt_hash_set_destructor(MimeTypes, mime_type_entry_free, 0);
+  MimeTypesFound = false;
 
-  for (int count = 0; count < 4; count++)
+  for (int count = 0; count < MIME_TYPES_FILES; count++)
   {
-    /* can't use strtok() because we use it in an inner loop below, so use
-     * a switch statement here instead.  */
-    switch (count)
-    {
-      /* last file with last entry to match wins type/xtype */
-      case 0:
-        /* check default unix mimetypes location first */
-        mutt_str_copy(buf, "/etc/mime.types", sizeof(buf));
-        break;
-      case 1:
-        mutt_str_copy(buf, SYSCONFDIR "/mime.types", sizeof(buf));
-        break;
-      case 2:
-        mutt_str_copy(buf, PKGDATADIR "/mime.types", sizeof(buf));
-        break;
-      case 3:
-        snprintf(buf, sizeof(buf), "%s/.mime.types", NONULL(HomeDir));
-        break;
-      default:
-        mutt_debug(LL_DEBUG1, "Internal error, count = %d\n", count);
-        goto bye; /* shouldn't happen */
-    }
+    mime_types_filename(count, buf, sizeof(buf));
+
+    struct stat st = { 0 };
+    MimeTypesMtime[count] = (stat(buf, &st) == 0) ? st.st_mtime : 0;
 
     fp = fopen(buf, "r");
-    if (fp)
+    if (!fp)
+      continue;
+    MimeTypesFound = true;
+
+    while (fgets(buf, sizeof(buf) - 1, fp))
     {
-      found_mimetypes = true;
+      /* weed out any comments */
+      p = strchr(buf, '#');
+      if (p)
+        *p = '\0';
+
+      /* remove any leading space. */
+      ct = buf;
+      SKIPWS(ct);
+
+      /* position on the next field in this line */
+      p = strpbrk(ct, " \t");
+      if (!p)
+        continue;
+      *p++ = 0;
+      SKIPWS(p);
+
+      /* get the content-type */
+      char *slash = strchr(ct, '/');
+      if (!slash)
+      {
+        /* malformed line, just skip it. */
+        continue;
+      }
+      *slash++ = 0;
+
+      for (q = slash; *q && !IS_SPACE(*q); q++)
+        ; // do nothing
+      *q = '\0';
 
-      while (fgets(buf, sizeof(buf) - 1, fp))
+      enum ContentType type = mutt_check_mime_type(ct);
+
+      /* cycle through the file extensions */
+      while ((p = strtok(p, " \t\n")))
       {
-        /* weed out any comments */
-        p = strchr(buf, '#');
-        if (p)
-          *p = '\0';
-
-        /* remove any leading space. */
-        ct = buf;
-        SKIPWS(ct);
-
-        /* position on the next field in this line */
-        p = strpbrk(ct, " \t");
-        if (!p)
-          continue;
-        *p++ = 0;
-        SKIPWS(p);
-
-        /* cycle through the file extensions */
-        while ((p = strtok(p, " \t\n")))
+        if (!mutt_hash_find(MimeTypes, p))
         {
-          sze = mutt_str_len(p);
-          if ((sze > cur_sze) && (szf >= sze) && mutt_istr_equal(path + szf - sze, p) &&
-              ((szf == sze) || (path[szf - sze - 1] == '.')))
-          {
-            /* get the content-type */
-
-            p = strchr(ct, '/');
-            if (!p)
-            {
-              /* malformed line, just skip it. */
-              break;
-            }
-            *p++ = 0;
-
-            for (q = p; *q && !IS_SPACE(*q); q++)
-              ; // do nothing
-
-            mutt_strn_copy(subtype, p, q - p, sizeof(subtype));
-
-            type = mutt_check_mime_type(ct);
-            if (type == TYPE_OTHER)
-              mutt_str_copy(xtype, ct, sizeof(xtype));
-
-            cur_sze = sze;
-          }
-          p = NULL;
+          struct MimeTypeEntry *entry = mutt_mem_calloc(1, sizeof(struct MimeTypeEntry));
+          entry->type = type;
+          entry->subtype = mutt_str_dup(slash);
+          if (type == TYPE_OTHER)
+            entry->xtype = mutt_str_dup(ct);
+          mutt_hash_insert(MimeTypes, p, entry);
         }
+        p = NULL;
       }
-      mutt_file_fclose(&fp);
     }
+    mutt_file_fclose(&fp);
   }
+}
 
-bye:
+/**
+ * mutt_mime_types_cleanup - Free the cached mime.types data
+ */
+void mutt_mime_types_cleanup(void)
+{
+  mutt_hash_free(&MimeTypes);
+}
+
+/**
+ * mutt_lookup_mime_type - Find the MIME type for an attachment
+ * @param att  Email with attachment
+ * @param path Path to attachment
+ * @retval num MIME type, e.g. #TYPE_IMAGE
+ *
+ * Given a file at 'path', see if there is a registered MIME type.
+ * Returns the major MIME type, and copies the subtype to "d".  First look
+ * in a system mime.types if we can find one, then look for ~/.mime.types.
+ * The longest match is used so that we can match 'ps.gz' when 'gz' also
+ * exists.
+ *
+ * The mime.types files are parsed once into a Hash Table, which is reused
+ * until one of the files changes on disk.
+ */
+enum ContentType mutt_lookup_mime_type(struct Body *att, const char *path)
+{
+  if (!MimeTypes || mime_types_stale())
+    mime_types_compile();
 
   /* no mime.types file found */
-  if (!found_mimetypes)
+  if (!MimeTypesFound)
   {
     mutt_error(_("Could not find any mime.types file"));
   }
 
-  if ((type != TYPE_OTHER) || (*xtype != '\0'))
+  /* try ever-shorter '.'-separated suffixes, so "ps.gz" beats "gz" */
+  struct MimeTypeEntry *entry = path ? mutt_hash_find(MimeTypes, path) : NULL;
+  for (const char *dot = strchr(NONULL(path), '.'); !entry && dot;
+       dot = strchr(dot + 1, '.'))
+  {
+    entry = mutt_hash_find(MimeTypes, dot + 1);
+  }
+
+  if (!entry)
+    return TYPE_OTHER;
+
+  if ((entry->type != TYPE_OTHER) || entry->xtype)
   {
-    att->type = type;
-    mutt_str_replace(&att->subtype, subtype);
-    mutt_str_replace(&att->xtype, xtype);
+    att->type = entry->type;
+    mutt_str_replace(&att->subtype, entry->subtype);
+    mutt_str_replace(&att->xtype, entry->xtype);
   }
 
-  return type;
+  return entry->type;
 }
 
 /**
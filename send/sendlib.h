@@ -41,6 +41,7 @@ enum ContentType mutt_lookup_mime_type(struct Body *att, const char *path);
 struct Body *    mutt_make_file_attach(const char *path, struct ConfigSubset *sub);
 struct Body *    mutt_make_message_attach(struct Mailbox *m, struct Email *e, bool attach_msg, struct ConfigSubset *sub);
 void             mutt_message_to_7bit(struct Body *a, FILE *fp, struct ConfigSubset *sub);
+void             mutt_mime_types_cleanup(void);
 void             mutt_prepare_envelope(struct Envelope *env, bool final, struct ConfigSubset *sub);
 void             mutt_stamp_attachment(struct Body *a);
 void             mutt_unprepare_envelope(struct Envelope *env);
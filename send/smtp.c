@@ -83,8 +83,10 @@ typedef uint8_t SmtpCapFlags;          ///< Flags, e.g. #SMTP_CAP_STARTTLS
 #define SMTP_CAP_DSN          (1 << 2) ///< Server supports Delivery Status Notification
 #define SMTP_CAP_EIGHTBITMIME (1 << 3) ///< Server supports 8-bit MIME content
 #define SMTP_CAP_SMTPUTF8     (1 << 4) ///< Server accepts UTF-8 strings
+#define SMTP_CAP_PIPELINING   (1 << 5) ///< Server accepts pipelined commands
+#define SMTP_CAP_CHUNKING     (1 << 6) ///< Server supports the BDAT command
 
-#define SMTP_CAP_ALL         ((1 << 5) - 1)
+#define SMTP_CAP_ALL         ((1 << 7) - 1)
 // clang-format on
 
 /**
@@ -116,6 +118,15 @@ struct SmtpAuth
       ///< If this is not null, authenticate may ignore the second parameter.
 };
 
+/// Connection kept open between messages when $smtp_persist is set
+static struct Connection *PersistConn = NULL;
+/// Capabilities of the server behind #PersistConn
+static SmtpCapFlags PersistCaps = SMTP_CAP_NO_FLAGS;
+/// Whether #PersistConn was opened for 8-bit delivery
+static bool PersistEightBit = false;
+/// Account that #PersistConn belongs to
+static struct ConnAccount PersistAccount;
+
 /**
  * valid_smtp_code - Is the is a valid SMTP return code?
  * @param[in]  buf String to check
@@ -164,6 +175,10 @@ static int smtp_get_resp(struct SmtpAccountData *adata)
       adata->capabilities |= SMTP_CAP_STARTTLS;
     else if (mutt_istr_startswith(s, "SMTPUTF8"))
       adata->capabilities |= SMTP_CAP_SMTPUTF8;
+    else if (mutt_istr_startswith(s, "PIPELINING"))
+      adata->capabilities |= SMTP_CAP_PIPELINING;
+    else if (mutt_istr_startswith(s, "CHUNKING"))
+      adata->capabilities |= SMTP_CAP_CHUNKING;
 
     if (!valid_smtp_code(buf, n, &n))
       return SMTP_ERR_CODE;
@@ -179,12 +194,18 @@ static int smtp_get_resp(struct SmtpAccountData *adata)
 
 /**
  * smtp_rcpt_to - Set the recipient to an Address
- * @param adata SMTP Account data
- * @param al    AddressList to use
+ * @param adata   SMTP Account data
+ * @param al      AddressList to use
+ * @param nqueued Count of pipelined commands, or NULL to wait for each response
  * @retval  0 Success
  * @retval <0 Error, e.g. #SMTP_ERR_WRITE
+ *
+ * If nqueued is given, the commands are pipelined (RFC2920): they're sent
+ * without waiting and the count is increased for each, so that the caller can
+ * collect the responses, in order, later.
  */
-static int smtp_rcpt_to(struct SmtpAccountData *adata, const struct AddressList *al)
+static int smtp_rcpt_to(struct SmtpAccountData *adata,
+                        const struct AddressList *al, int *nqueued)
 {
   if (!al)
     return 0;
@@ -206,6 +227,11 @@ static int smtp_rcpt_to(struct SmtpAccountData *adata, const struct AddressList
       snprintf(buf, sizeof(buf), "RCPT TO:<%s>\r\n", a->mailbox);
     if (mutt_socket_send(adata->conn, buf) == -1)
       return SMTP_ERR_WRITE;
+    if (nqueued)
+    {
+      (*nqueued)++;
+      continue;
+    }
     int rc = smtp_get_resp(adata);
     if (rc != 0)
       return rc;
@@ -218,10 +244,11 @@ static int smtp_rcpt_to(struct SmtpAccountData *adata, const struct AddressList
  * smtp_data - Send data to an SMTP server
  * @param adata   SMTP Account data
  * @param msgfile Filename containing data
+ * @param nqueued Responses to pipelined commands still to be collected
  * @retval  0 Success
  * @retval <0 Error, e.g. #SMTP_ERR_WRITE
  */
-static int smtp_data(struct SmtpAccountData *adata, const char *msgfile)
+static int smtp_data(struct SmtpAccountData *adata, const char *msgfile, int nqueued)
 {
   char buf[1024];
   struct Progress *progress = NULL;
@@ -250,6 +277,17 @@ static int smtp_data(struct SmtpAccountData *adata, const char *msgfile)
     mutt_file_fclose(&fp);
     goto done;
   }
+  /* collect the responses to the pipelined MAIL FROM/RCPT TO commands; on
+   * failure the session is abandoned, so the unread ones don't matter */
+  for (; nqueued > 0; nqueued--)
+  {
+    rc = smtp_get_resp(adata);
+    if (rc != 0)
+    {
+      mutt_file_fclose(&fp);
+      goto done;
+    }
+  }
   rc = smtp_get_resp(adata);
   if (rc != 0)
   {
@@ -298,6 +336,105 @@ done:
   return rc;
 }
 
+/* size of the raw chunks sent with the BDAT command */
+#define SMTP_CHUNK_SIZE 65536
+
+/**
+ * smtp_bdat - Send data to an SMTP server using CHUNKING
+ * @param adata   SMTP Account data
+ * @param msgfile Filename containing data
+ * @param nqueued Responses to pipelined commands still to be collected
+ * @retval  0 Success
+ * @retval <0 Error, e.g. #SMTP_ERR_WRITE
+ *
+ * The BDAT command (RFC3030) replaces DATA: the message goes out in large
+ * chunks, each preceded by its byte count, so no per-line dot-stuffing is
+ * needed.  The chunks are sent back-to-back and their responses are
+ * collected at the end, together with those to any pipelined envelope
+ * commands sent before - which is why this is only used when the server
+ * also supports PIPELINING.
+ */
+static int smtp_bdat(struct SmtpAccountData *adata, const char *msgfile, int nqueued)
+{
+  char line[1024];
+  struct Progress *progress = NULL;
+  int rc = SMTP_ERR_WRITE;
+
+  FILE *fp = fopen(msgfile, "r");
+  if (!fp)
+  {
+    mutt_error(_("SMTP session failed: unable to open %s"), msgfile);
+    return -1;
+  }
+  const long size = mutt_file_get_size_fp(fp);
+  if (size == 0)
+  {
+    mutt_file_fclose(&fp);
+    return -1;
+  }
+  unlink(msgfile);
+  progress = progress_new(_("Sending message..."), MUTT_PROGRESS_NET, size);
+
+  char *chunk = mutt_mem_malloc(SMTP_CHUNK_SIZE);
+  bool last = false;
+
+  while (!last)
+  {
+    /* fill the chunk with CRLF-terminated lines */
+    size_t clen = 0;
+    while ((clen + sizeof(line) + 1) < SMTP_CHUNK_SIZE)
+    {
+      if (!fgets(line, sizeof(line) - 1, fp))
+      {
+        last = true;
+        break;
+      }
+      size_t linelen = mutt_str_len(line);
+      const bool term = linelen && (line[linelen - 1] == '\n');
+      if (term && ((linelen == 1) || (line[linelen - 2] != '\r')))
+      {
+        line[linelen - 1] = '\r';
+        line[linelen] = '\n';
+        linelen++;
+      }
+      memcpy(chunk + clen, line, linelen);
+      clen += linelen;
+    }
+    if (last && clen && (chunk[clen - 1] != '\n'))
+    {
+      /* terminate the final line */
+      chunk[clen++] = '\r';
+      chunk[clen++] = '\n';
+    }
+
+    snprintf(line, sizeof(line), "BDAT %zu%s\r\n", clen, last ? " LAST" : "");
+    if ((mutt_socket_send(adata->conn, line) == -1) ||
+        (mutt_socket_write_d(adata->conn, chunk, clen, MUTT_SOCK_LOG_FULL) == -1))
+    {
+      mutt_file_fclose(&fp);
+      FREE(&chunk);
+      goto done;
+    }
+    nqueued++;
+    progress_update(progress, MAX(0, ftell(fp)), -1);
+  }
+  mutt_file_fclose(&fp);
+  FREE(&chunk);
+
+  /* collect the responses to the pipelined envelope and BDAT commands; on
+   * failure the session is abandoned, so the unread ones don't matter */
+  for (; nqueued > 0; nqueued--)
+  {
+    rc = smtp_get_resp(adata);
+    if (rc != 0)
+      goto done;
+  }
+
+done:
+  progress_free(&progress);
+  return rc;
+}
+
 /**
  * smtp_get_field - Get connection login credentials - Implements ConnAccount::get_field()
  */
@@ -567,7 +704,10 @@ static int smtp_auth_oauth_xoauth2(struct SmtpAccountData *adata, const char *me
   if (rc == -1)
     return SMTP_AUTH_FAIL;
   if (smtp_get_resp(adata) != 0)
+  {
+    mutt_account_oauth_invalidate(&adata->conn->account);
     return SMTP_AUTH_FAIL;
+  }
 
   return SMTP_AUTH_SUCCESS;
 }
@@ -891,6 +1031,67 @@ static int smtp_open(struct SmtpAccountData *adata, bool esmtp)
   return 0;
 }
 
+/**
+ * mutt_smtp_cleanup - Close the persistent SMTP connection, if any
+ *
+ * Politely ends the session kept open by $smtp_persist.  Called on
+ * shutdown, and when a send needs a different account.
+ */
+void mutt_smtp_cleanup(void)
+{
+  if (!PersistConn)
+    return;
+
+  mutt_socket_send(PersistConn, "QUIT\r\n");
+  mutt_socket_close(PersistConn);
+  FREE(&PersistConn);
+  PersistCaps = SMTP_CAP_NO_FLAGS;
+}
+
+/**
+ * smtp_persist_reuse - Try to reuse the connection of a previous send
+ * @param adata    SMTP Account data
+ * @param cac      Account for the message about to be sent
+ * @param eightbit If true, an 8-bit friendly connection is needed
+ * @retval true @a adata now holds an open, reset connection
+ *
+ * The saved connection is only reused for the same account, and is verified
+ * with an RSET first; a dead one is discarded so the caller can open a fresh
+ * session.
+ */
+static bool smtp_persist_reuse(struct SmtpAccountData *adata,
+                               const struct ConnAccount *cac, bool eightbit)
+{
+  if (!PersistConn)
+    return false;
+
+  if (!mutt_str_equal(PersistAccount.host, cac->host) ||
+      (PersistAccount.port != cac->port) ||
+      !mutt_str_equal(PersistAccount.user, cac->user) || (eightbit && !PersistEightBit))
+  {
+    mutt_smtp_cleanup();
+    return false;
+  }
+
+  adata->conn = PersistConn;
+  adata->capabilities = PersistCaps;
+
+  /* make sure the server is still there */
+  if ((mutt_socket_send(adata->conn, "RSET\r\n") == -1) || (smtp_get_resp(adata) != 0))
+  {
+    mutt_debug(LL_DEBUG1, "persistent connection died, reconnecting\n");
+    mutt_socket_close(PersistConn);
+    FREE(&PersistConn);
+    PersistCaps = SMTP_CAP_NO_FLAGS;
+    adata->conn = NULL;
+    adata->capabilities = SMTP_CAP_NO_FLAGS;
+    return false;
+  }
+
+  PersistConn = NULL; /* the caller owns it until the send finishes */
+  return true;
+}
+
 /**
  * mutt_smtp_send - Send a message using SMTP
  * @param from     From Address
@@ -936,19 +1137,33 @@ int mutt_smtp_send(const struct AddressList *from, const struct AddressList *to,
   if (smtp_fill_account(&adata, &cac) < 0)
     return rc;
 
-  adata.conn = mutt_conn_find(&cac);
-  if (!adata.conn)
-    return -1;
+  const bool c_smtp_persist = cs_subset_bool(adata.sub, "smtp_persist");
+  const bool reused = c_smtp_persist && smtp_persist_reuse(&adata, &cac, eightbit);
+  if (!reused)
+  {
+    adata.conn = mutt_conn_find(&cac);
+    if (!adata.conn)
+      return -1;
+  }
 
   const char *const c_dsn_return = cs_subset_string(adata.sub, "dsn_return");
 
   do
   {
-    /* send our greeting */
-    rc = smtp_open(&adata, eightbit);
-    if (rc != 0)
-      break;
-    FREE(&adata.auth_mechs);
+    if (!reused)
+    {
+      /* send our greeting */
+      rc = smtp_open(&adata, eightbit);
+      if (rc != 0)
+        break;
+      FREE(&adata.auth_mechs);
+    }
+
+    /* if the server supports it, pipeline the whole envelope (RFC2920):
+     * MAIL FROM, all the RCPT TO commands and DATA go out in one flight and
+     * the responses are collected afterwards, saving a round-trip each */
+    const bool pipeline = (adata.capabilities & SMTP_CAP_PIPELINING);
+    int nqueued = 0;
 
     /* send the sender's address */
     int len = snprintf(buf, sizeof(buf), "MAIL FROM:<%s>", envfrom);
@@ -971,29 +1186,53 @@ int mutt_smtp_send(const struct AddressList *from, const struct AddressList *to,
       rc = SMTP_ERR_WRITE;
       break;
     }
-    rc = smtp_get_resp(&adata);
-    if (rc != 0)
-      break;
+    if (pipeline)
+    {
+      nqueued++;
+    }
+    else
+    {
+      rc = smtp_get_resp(&adata);
+      if (rc != 0)
+        break;
+    }
 
     /* send the recipient list */
-    if ((rc = smtp_rcpt_to(&adata, to)) || (rc = smtp_rcpt_to(&adata, cc)) ||
-        (rc = smtp_rcpt_to(&adata, bcc)))
+    int *queued = pipeline ? &nqueued : NULL;
+    if ((rc = smtp_rcpt_to(&adata, to, queued)) ||
+        (rc = smtp_rcpt_to(&adata, cc, queued)) ||
+        (rc = smtp_rcpt_to(&adata, bcc, queued)))
     {
       break;
     }
 
     /* send the message data */
-    rc = smtp_data(&adata, msgfile);
+    if (pipeline && (adata.capabilities & SMTP_CAP_CHUNKING))
+      rc = smtp_bdat(&adata, msgfile, nqueued);
+    else
+      rc = smtp_data(&adata, msgfile, nqueued);
     if (rc != 0)
       break;
 
-    mutt_socket_send(adata.conn, "QUIT\r\n");
-
     rc = 0;
   } while (false);
 
-  mutt_socket_close(adata.conn);
-  FREE(&adata.conn);
+  if ((rc == 0) && c_smtp_persist)
+  {
+    /* keep the session open for the next message */
+    PersistConn = adata.conn;
+    PersistCaps = adata.capabilities;
+    if (!reused)
+      PersistEightBit = eightbit;
+    PersistAccount = cac;
+  }
+  else
+  {
+    if (rc == 0)
+      mutt_socket_send(adata.conn, "QUIT\r\n");
+    mutt_socket_close(adata.conn);
+    FREE(&adata.conn);
+  }
 
   if (rc == SMTP_ERR_READ)
     mutt_error(_("SMTP session failed: read error"));
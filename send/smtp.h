@@ -32,6 +32,7 @@ struct AddressList;
 struct ConfigSubset;
 
 bool smtp_auth_is_valid(const char *authenticator);
+void mutt_smtp_cleanup(void);
 int mutt_smtp_send(const struct AddressList *from, const struct AddressList *to,
                    const struct AddressList *cc, const struct AddressList *bcc,
                    const char *msgfile, bool eightbit, struct ConfigSubset *sub);
@@ -337,7 +337,8 @@ static int sb_config_observer(struct NotifyCallback *nc)
     return 0;
   }
 
-  // All the remaining config changes...
+  // All the remaining config changes affect every display string
+  sb_set_dirty(sb_wdata_get(win));
   win->actions |= WA_RECALC;
   mutt_debug(LL_DEBUG5, "config done, request WA_RECALC\n");
   return 0;
@@ -396,6 +397,52 @@ static int sb_mailbox_observer(struct NotifyCallback *nc)
   {
     sb_remove_mailbox(wdata, ev_m->mailbox);
   }
+  else if (ev_m->mailbox)
+  {
+    // A Mailbox's counters may have changed; patch just its entry
+    struct Mailbox *m = ev_m->mailbox;
+    struct SbEntry *entry = NULL;
+    int idx = -1;
+    struct SbEntry **sbep = NULL;
+    ARRAY_FOREACH(sbep, &wdata->entries)
+    {
+      if (mutt_str_equal((*sbep)->mailbox->realpath, m->realpath))
+      {
+        entry = *sbep;
+        idx = ARRAY_FOREACH_IDX;
+        break;
+      }
+    }
+    if (!entry)
+      return 0; // Not shown in the Sidebar
+
+    if ((idx != wdata->opn_index) && (idx != wdata->hil_index) &&
+        (entry->last_count == m->msg_count) && (entry->last_unread == m->msg_unread) &&
+        (entry->last_flagged == m->msg_flagged) &&
+        (entry->last_new == m->msg_new) && (entry->last_has_new == m->has_new))
+    {
+      return 0; // Nothing the Sidebar displays has changed
+    }
+
+    entry->dirty = true;
+
+    const short c_sidebar_sort_method =
+        cs_subset_sort(NeoMutt->sub, "sidebar_sort_method");
+    const short sort = (c_sidebar_sort_method & SORT_MASK);
+    if ((sort == SORT_COUNT) || (sort == SORT_UNREAD) || (sort == SORT_FLAGGED))
+      wdata->resort = true;
+
+    const bool c_sidebar_new_mail_only =
+        cs_subset_bool(NeoMutt->sub, "sidebar_new_mail_only");
+    const bool c_sidebar_non_empty_mailbox_only =
+        cs_subset_bool(NeoMutt->sub, "sidebar_non_empty_mailbox_only");
+    if (!wdata->resort && !c_sidebar_new_mail_only && !c_sidebar_non_empty_mailbox_only &&
+        ((idx < wdata->top_index) || (idx > wdata->bot_index)))
+    {
+      // Order and visibility are stable and the entry is off-page
+      return 0;
+    }
+  }
 
   win->actions |= WA_RECALC;
   mutt_debug(LL_DEBUG5, "mailbox done, request WA_RECALC\n");
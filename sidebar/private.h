@@ -45,6 +45,14 @@ struct SbEntry
   struct Mailbox *mailbox; ///< Mailbox this represents
   bool is_hidden;          ///< Don't show, e.g. $sidebar_new_mail_only
   struct AttrColor *color; ///< Colour to use
+
+  bool dirty;              ///< Display string needs rebuilding
+  int last_width;          ///< Width the display string was built for
+  int last_count;          ///< Mailbox msg_count when last displayed
+  int last_unread;         ///< Mailbox msg_unread when last displayed
+  int last_flagged;        ///< Mailbox msg_flagged when last displayed
+  int last_new;            ///< Mailbox msg_new when last displayed
+  bool last_has_new;       ///< Mailbox has_new when last displayed
 };
 ARRAY_HEAD(SbEntryArray, struct SbEntry *);
 
@@ -73,6 +81,7 @@ struct SidebarWindowData
   int bot_index;             ///< Last mailbox visible in sidebar
 
   short previous_sort;       ///< Old `$sidebar_sort_method`
+  bool resort;               ///< Sort order may be stale; re-sort on the next recalc
   enum DivType divider_type; ///< Type of divider to use, e.g. #SB_DIV_ASCII
   short divider_width;       ///< Width of the divider in screen columns
 };
@@ -81,6 +90,7 @@ struct SidebarWindowData
 void sb_add_mailbox        (struct SidebarWindowData *wdata, struct Mailbox *m);
 void sb_remove_mailbox     (struct SidebarWindowData *wdata, struct Mailbox *m);
 void sb_set_current_mailbox(struct SidebarWindowData *wdata, struct Mailbox *m);
+void sb_set_dirty          (struct SidebarWindowData *wdata);
 struct Mailbox *sb_get_highlight(struct MuttWindow *win);
 
 // commands.c
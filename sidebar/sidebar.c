@@ -99,6 +99,8 @@ void sb_add_mailbox(struct SidebarWindowData *wdata, struct Mailbox *m)
   struct IndexSharedData *shared = wdata->shared;
   struct SbEntry *entry = mutt_mem_calloc(1, sizeof(struct SbEntry));
   entry->mailbox = m;
+  entry->dirty = true;
+  wdata->resort = true;
 
   if (wdata->top_index < 0)
     wdata->top_index = ARRAY_SIZE(&wdata->entries);
@@ -173,6 +175,7 @@ void sb_remove_mailbox(struct SidebarWindowData *wdata, struct Mailbox *m)
  */
 void sb_set_current_mailbox(struct SidebarWindowData *wdata, struct Mailbox *m)
 {
+  const int old_opn = wdata->opn_index;
   wdata->opn_index = -1;
 
   struct SbEntry **sbep = NULL;
@@ -184,11 +187,36 @@ void sb_set_current_mailbox(struct SidebarWindowData *wdata, struct Mailbox *m)
       {
         wdata->opn_index = ARRAY_FOREACH_IDX;
         wdata->hil_index = ARRAY_FOREACH_IDX;
+        (*sbep)->dirty = true; // gains the open-mailbox counts, e.g. %d
         break;
       }
     }
     (*sbep)->is_hidden = !(*sbep)->mailbox->visible;
   }
+
+  if ((old_opn >= 0) && (old_opn != wdata->opn_index))
+  {
+    sbep = ARRAY_GET(&wdata->entries, old_opn);
+    if (sbep)
+      (*sbep)->dirty = true; // loses the open-mailbox counts
+  }
+}
+
+/**
+ * sb_set_dirty - Flag all the sidebar entries for regeneration
+ * @param wdata Sidebar data
+ *
+ * Use after an event, e.g. a config change, that invalidates every display
+ * string at once.
+ */
+void sb_set_dirty(struct SidebarWindowData *wdata)
+{
+  struct SbEntry **sbep = NULL;
+  ARRAY_FOREACH(sbep, &wdata->entries)
+  {
+    (*sbep)->dirty = true;
+  }
+  wdata->resort = true;
 }
 
 /**
@@ -655,7 +655,11 @@ static bool prepare_sidebar(struct SidebarWindowData *wdata, int page_size)
   update_entries_visibility(wdata);
   const short c_sidebar_sort_method =
       cs_subset_sort(NeoMutt->sub, "sidebar_sort_method");
-  sb_sort_entries(wdata, c_sidebar_sort_method);
+  if (wdata->resort || (c_sidebar_sort_method != wdata->previous_sort))
+  {
+    sb_sort_entries(wdata, c_sidebar_sort_method);
+    wdata->resort = false;
+  }
 
   if (opn_entry || hil_entry)
   {
@@ -785,6 +789,13 @@ int sb_recalc(struct MuttWindow *win)
       m->msg_flagged = m_cur->msg_flagged;
     }
 
+    // The display string is only rebuilt when stale
+    if (!entry->dirty && (entry->last_width == width))
+    {
+      row++;
+      continue;
+    }
+
     const char *path = mailbox_path(m);
 
     const char *const c_folder = cs_subset_string(NeoMutt->sub, "folder");
@@ -824,6 +835,14 @@ int sb_recalc(struct MuttWindow *win)
 
     mutt_str_copy(entry->box, short_path, sizeof(entry->box));
     make_sidebar_entry(entry->display, sizeof(entry->display), width, entry, shared);
+
+    entry->dirty = false;
+    entry->last_width = width;
+    entry->last_count = m->msg_count;
+    entry->last_unread = m->msg_unread;
+    entry->last_flagged = m->msg_flagged;
+    entry->last_new = m->msg_new;
+    entry->last_has_new = m->has_new;
     row++;
   }
 
@@ -950,7 +969,6 @@ int sb_repaint(struct MuttWindow *win)
       mutt_window_move(win, col, row);
       mutt_curses_set_color(entry->color);
       mutt_window_printf(win, "%s", entry->display);
-      mutt_refresh();
       row++;
     }
   }
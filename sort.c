@@ -29,7 +29,9 @@
  */
 
 #include "config.h"
+#include <ctype.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include "mutt/lib.h"
@@ -47,6 +49,9 @@
 #ifdef USE_NNTP
 #include "nntp/lib.h"
 #endif
+#ifdef USE_DEBUG_TIMING
+#include "debug/lib.h"
+#endif
 
 /**
  * struct EmailCompare - Context for compare_email_shim()
@@ -139,7 +144,10 @@ const char *mutt_get_name(const struct Address *a)
 
   if (a)
   {
-    const bool c_reverse_alias = cs_subset_bool(NeoMutt->sub, "reverse_alias");
+    /* called from sort comparators, i.e. O(n log n) times per sort */
+    static struct ConfigCache ReverseAliasCache = { 0 };
+    const bool c_reverse_alias =
+        cs_subset_cached(NeoMutt->sub, "reverse_alias", &ReverseAliasCache);
     if (c_reverse_alias && (ali = alias_reverse_lookup(a)) && ali->personal)
       return ali->personal;
     if (a->personal)
@@ -314,6 +322,140 @@ static sort_mail_t get_sort_func(enum SortType method, enum MailboxType type)
   /* not reached */
 }
 
+/**
+ * struct EmailKey - An Email and its precomputed sort key
+ */
+struct EmailKey
+{
+  struct Email *email; ///< The Email being sorted
+  char *key;           ///< Case-folded copy of the Email's primary sort field
+};
+
+/**
+ * compare_key_shim - qsort_r() comparator for precomputed sort keys
+ * @param a   Pointer to first EmailKey
+ * @param b   Pointer to second EmailKey
+ * @param arg EmailCompare with needed context
+ * @retval <0 a precedes b
+ * @retval >0 b precedes a
+ *
+ * The keys are pre-folded, so the common case is a plain strcmp().  Ties drop
+ * back to mutt_compare_emails() for the $sort_aux and index-order fallbacks.
+ */
+static int compare_key_shim(const void *a, const void *b, void *arg)
+{
+  const struct EmailKey *ka = a;
+  const struct EmailKey *kb = b;
+  const struct EmailCompare *cmp = arg;
+
+  int rc = strcmp(NONULL(ka->key), NONULL(kb->key)); /* empty keys are NULL */
+  if (cmp->sort & SORT_REVERSE)
+    rc = -rc;
+  if (rc == 0)
+    rc = mutt_compare_emails(ka->email, kb->email, cmp->type, cmp->sort, cmp->sort_aux);
+  return rc;
+}
+
+/**
+ * append_folded - Append a case-folded copy of a string to a Buffer
+ * @param buf    Buffer for the result
+ * @param s      String to fold
+ * @param maxlen Maximum number of bytes to append
+ */
+static void append_folded(struct Buffer *buf, const char *s, size_t maxlen)
+{
+  for (size_t i = 0; s && s[i] && (i < maxlen); i++)
+    mutt_buffer_addch(buf, tolower((unsigned char) s[i]));
+}
+
+/**
+ * sort_with_keys - Sort a mailbox's emails using precomputed sort keys
+ * @param m   Mailbox
+ * @param cmp Sort settings
+ * @retval true The mailbox was sorted
+ * @retval false The sort method gains nothing from precomputation
+ *
+ * The string-keyed sort methods re-derive their sort field (display name,
+ * folded subject, ...) inside the comparator, costing O(n log n) strcasecmp()
+ * calls and alias lookups.  For those methods, extract each Email's key once
+ * into a contiguous array and sort that with a cheap comparator instead.
+ *
+ * Methods with a presence bias (subject, label) get a '0'/'1' key prefix so
+ * that the biased group sorts together, exactly as their comparators order
+ * it.  Ties are resolved by the original comparator chain, so the result is
+ * identical to sorting with mutt_compare_emails() directly.
+ */
+static bool sort_with_keys(struct Mailbox *m, const struct EmailCompare *cmp)
+{
+  const enum SortType method = cmp->sort & SORT_MASK;
+  switch (method)
+  {
+    case SORT_SUBJECT:
+    case SORT_FROM:
+    case SORT_TO:
+    case SORT_LABEL:
+      break;
+    default:
+      return false; /* numeric keys are already cheap to compare */
+  }
+
+  struct EmailKey *keys = mutt_mem_calloc(m->msg_count, sizeof(struct EmailKey));
+  struct Buffer *buf = mutt_buffer_pool_get();
+
+  int count = 0;
+  for (; count < m->msg_count; count++)
+  {
+    struct Email *e = m->emails[count];
+    if (!e)
+      break;
+
+    mutt_buffer_reset(buf);
+    switch (method)
+    {
+      case SORT_SUBJECT:
+        if (e->env->real_subj)
+        {
+          mutt_buffer_addch(buf, '1');
+          append_folded(buf, e->env->real_subj, SIZE_MAX);
+        }
+        else
+          mutt_buffer_addch(buf, '0'); /* sorts before any real subject */
+        break;
+      case SORT_FROM:
+        append_folded(buf, mutt_get_name(TAILQ_FIRST(&e->env->from)), 127);
+        break;
+      case SORT_TO:
+        append_folded(buf, mutt_get_name(TAILQ_FIRST(&e->env->to)), 127);
+        break;
+      case SORT_LABEL:
+      {
+        const bool has = e->env->x_label && *e->env->x_label;
+        mutt_buffer_addch(buf, has ? '0' : '1'); /* labelled sorts first */
+        if (has)
+          append_folded(buf, e->env->x_label, SIZE_MAX);
+        break;
+      }
+      default:
+        break;
+    }
+
+    keys[count].email = e;
+    keys[count].key = mutt_buffer_strdup(buf);
+  }
+
+  mutt_qsort_r(keys, count, sizeof(struct EmailKey), compare_key_shim, (void *) cmp);
+
+  for (int i = 0; i < count; i++)
+  {
+    m->emails[i] = keys[i].email;
+    FREE(&keys[i].key);
+  }
+
+  mutt_buffer_pool_release(&buf);
+  FREE(&keys);
+  return true;
+}
+
 /**
  * mutt_compare_emails - Compare two emails using up to two sort methods
  * @param a        First email
@@ -388,6 +530,14 @@ void mutt_sort_headers(struct Mailbox *m, struct ThreadsContext *threads,
   }
   OptNeedRescore = false;
 
+  if (c_score)
+  {
+    const short c_sort = cs_subset_sort(NeoMutt->sub, "sort");
+    const short c_sort_aux = cs_subset_sort(NeoMutt->sub, "sort_aux");
+    if (((c_sort & SORT_MASK) == SORT_SCORE) || ((c_sort_aux & SORT_MASK) == SORT_SCORE))
+      mutt_score_require_all(m);
+  }
+
   if (OptResortInit)
   {
     OptResortInit = false;
@@ -398,6 +548,9 @@ void mutt_sort_headers(struct Mailbox *m, struct ThreadsContext *threads,
     mutt_clear_threads(threads);
 
   const bool threaded = mutt_using_threads();
+#ifdef USE_DEBUG_TIMING
+  timing_start(threaded ? "thread" : "sort");
+#endif
   if (threaded)
   {
     mutt_sort_threads(threads, init);
@@ -408,9 +561,15 @@ void mutt_sort_headers(struct Mailbox *m, struct ThreadsContext *threads,
     cmp.type = mx_type(m);
     cmp.sort = cs_subset_sort(NeoMutt->sub, "sort");
     cmp.sort_aux = cs_subset_sort(NeoMutt->sub, "sort_aux");
-    mutt_qsort_r((void *) m->emails, m->msg_count, sizeof(struct Email *),
-                 compare_email_shim, &cmp);
+    if (!sort_with_keys(m, &cmp))
+    {
+      mutt_qsort_r((void *) m->emails, m->msg_count, sizeof(struct Email *),
+                   compare_email_shim, &cmp);
+    }
   }
+#ifdef USE_DEBUG_TIMING
+  timing_stop(threaded ? "thread" : "sort");
+#endif
 
   /* adjust the virtual message numbers */
   m->vcount = 0;
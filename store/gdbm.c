@@ -123,6 +123,35 @@ static int store_gdbm_delete_record(void *store, const char *key, size_t klen)
   return gdbm_delete(db, dkey);
 }
 
+/**
+ * store_gdbm_foreach - Implements StoreOps::foreach() - @ingroup store_foreach
+ */
+static int store_gdbm_foreach(void *store, store_foreach_t cb, void *data)
+{
+  if (!store)
+    return -1;
+
+  GDBM_FILE db = store;
+
+  int rc = 0;
+  datum dkey = gdbm_firstkey(db);
+  while (dkey.dptr)
+  {
+    rc = cb(dkey.dptr, dkey.dsize, data);
+    if (rc != 0)
+    {
+      free(dkey.dptr);
+      break;
+    }
+
+    datum dnext = gdbm_nextkey(db, dkey);
+    free(dkey.dptr);
+    dkey = dnext;
+  }
+
+  return rc;
+}
+
 /**
  * store_gdbm_close - Implements StoreOps::close() - @ingroup store_close
  */
@@ -144,4 +173,4 @@ static const char *store_gdbm_version(void)
   return gdbm_version;
 }
 
-STORE_BACKEND_OPS(gdbm)
+STORE_BACKEND_OPS(gdbm, .foreach = store_gdbm_foreach)
@@ -57,6 +57,19 @@
 #include <stdbool.h>
 #include <stdlib.h>
 
+/**
+ * @defgroup store_foreach_api store_foreach_t API
+ *
+ * Prototype for a StoreOps::foreach() callback
+ *
+ * @param key  Key of the visited record
+ * @param klen Length of the Key string
+ * @param data Private data passed to foreach()
+ * @retval 0   Continue with the next key
+ * @retval num Stop the walk; returned from foreach()
+ */
+typedef int (*store_foreach_t)(const char *key, size_t klen, void *data);
+
 /**
  * @defgroup store_api Key Value Store API
  *
@@ -95,6 +108,28 @@ struct StoreOps
    */
   void *(*fetch)(void *store, const char *key, size_t klen, size_t *vlen);
 
+  /**
+   * @defgroup store_fetch_batch fetch_batch()
+   * @ingroup store_api
+   *
+   * fetch_batch - Fetch many Values from the Store in one transaction
+   * @param[in]  store  Store retrieved via open()
+   * @param[in]  keys   Array of Keys identifying the records (NULL Keys are skipped)
+   * @param[in]  klens  Array of Key lengths
+   * @param[out] values Array to be filled with the Values (NULL for a miss)
+   * @param[out] vlens  Array to be filled with the Value lengths
+   * @param[in]  count  Number of Keys
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   *
+   * Optional; may be NULL if the backend has no advantage over repeated
+   * fetch() calls, in which case the caller must do the looping itself.
+   * Each returned Value has the same ownership as one returned by fetch()
+   * and must be freed with free().
+   */
+  int (*fetch_batch)(void *store, const char **keys, const size_t *klens,
+                     void **values, size_t *vlens, size_t count);
+
   /**
    * @defgroup store_free free()
    * @ingroup store_api
@@ -120,6 +155,33 @@ struct StoreOps
    */
   int (*store)(void *store, const char *key, size_t klen, void *value, size_t vlen);
 
+  /**
+   * @defgroup store_txn_begin txn_begin()
+   * @ingroup store_api
+   *
+   * txn_begin - Start grouping writes into one transaction
+   * @param[in] store Store retrieved via open()
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   *
+   * Optional; may be NULL if the backend can't batch writes, in which case
+   * the caller just issues the individual store() calls.  After a successful
+   * txn_begin(), store() and delete_record() accumulate in the transaction
+   * until txn_commit() makes them durable in one go.
+   */
+  int (*txn_begin)(void *store);
+
+  /**
+   * @defgroup store_txn_commit txn_commit()
+   * @ingroup store_api
+   *
+   * txn_commit - Commit the writes grouped since txn_begin()
+   * @param[in] store Store retrieved via open()
+   * @retval 0   Success
+   * @retval num Error, a backend-specific error code
+   */
+  int (*txn_commit)(void *store);
+
   /**
    * @defgroup store_delete_record delete_record()
    * @ingroup store_api
@@ -133,6 +195,23 @@ struct StoreOps
    */
   int (*delete_record)(void *store, const char *key, size_t klen);
 
+  /**
+   * @defgroup store_foreach foreach()
+   * @ingroup store_api
+   *
+   * foreach - Visit every key in the Store
+   * @param[in] store Store retrieved via open()
+   * @param[in] cb    Callback to invoke for each key
+   * @param[in] data  Private data to pass to the callback
+   * @retval 0   Success
+   * @retval num Error, or the callback's non-zero return
+   *
+   * Optional; may be NULL if the backend can't enumerate its keys.  Keys are
+   * visited in no defined order.  The callback must not store or delete
+   * records during the walk.
+   */
+  int (*foreach)(void *store, store_foreach_t cb, void *data);
+
   /**
    * @defgroup store_close close()
    * @ingroup store_api
@@ -156,7 +235,9 @@ const char *           store_backend_list(void);
 const struct StoreOps *store_get_backend_ops(const char *str);
 bool                   store_is_valid_backend(const char *str);
 
-#define STORE_BACKEND_OPS(_name)                                               \
+/* Extra designated initialisers, e.g. optional fetch_batch(), may be passed
+ * after the backend name. */
+#define STORE_BACKEND_OPS(_name, ...)                                          \
   const struct StoreOps store_##_name##_ops = {                                \
     .name           = #_name,                                                  \
     .open           = store_##_name##_open,                                    \
@@ -166,6 +247,7 @@ bool                   store_is_valid_backend(const char *str);
     .delete_record  = store_##_name##_delete_record,                           \
     .close          = store_##_name##_close,                                   \
     .version        = store_##_name##_version,                                 \
+    __VA_ARGS__                                                                \
   };
 
 #endif /* MUTT_STORE_LIB_H */
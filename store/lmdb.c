@@ -28,9 +28,19 @@
  *
  * Lightning Memory-Mapped Database (LMDB) backend for the key/value Store.
  * https://symas.com/lmdb/
+ *
+ * LMDB allows any number of concurrent readers, so this backend is the one to
+ * pick when several NeoMutt instances share a header cache.  Writes are
+ * arbitrated by LMDB's single writer lock: to keep concurrent instances from
+ * serializing on it for the length of a mailbox sync, write transactions are
+ * committed every #LMDB_WRITE_BATCH operations, so the lock is only ever held
+ * in short bursts.  If the database isn't writable at all, it's reopened
+ * read-only and updates are silently skipped.
  */
 
 #include "config.h"
+#include <errno.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <lmdb.h>
 #include "mutt/lib.h"
@@ -40,6 +50,11 @@
  * The file is mmap(2)'d into memory. */
 const size_t LMDB_DB_SIZE = 2147483648;
 
+/** Number of updates after which a write transaction is committed.
+ * Committing releases LMDB's single writer lock, letting concurrent
+ * NeoMutt instances interleave their updates. */
+const size_t LMDB_WRITE_BATCH = 1000;
+
 /**
  * enum MdbTxnMode - LMDB transaction state
  */
@@ -59,6 +74,9 @@ struct StoreLmdbCtx
   MDB_txn *txn;
   MDB_dbi db;
   enum MdbTxnMode txn_mode;
+  bool readonly;  ///< Database was opened read-only
+  bool in_txn;    ///< Caller opened an explicit transaction
+  size_t pending; ///< Updates in the current write transaction
 };
 
 /**
@@ -98,6 +116,9 @@ static int mdb_get_w_txn(struct StoreLmdbCtx *ctx)
 {
   int rc;
 
+  if (ctx->readonly)
+    return EACCES;
+
   if (ctx->txn)
   {
     if (ctx->txn_mode == TXN_WRITE)
@@ -116,6 +137,33 @@ static int mdb_get_w_txn(struct StoreLmdbCtx *ctx)
   return rc;
 }
 
+/**
+ * mdb_put_batch - Commit the write transaction once enough has accumulated
+ * @param ctx LMDB context
+ *
+ * Holding a write transaction open for a whole mailbox sync keeps LMDB's
+ * single writer lock, stalling every other instance that shares the cache.
+ * Committing every #LMDB_WRITE_BATCH updates bounds how long the lock is held.
+ */
+static void mdb_put_batch(struct StoreLmdbCtx *ctx)
+{
+  /* an explicit transaction commits in store_lmdb_txn_commit() instead */
+  if (ctx->in_txn)
+    return;
+
+  ctx->pending++;
+  if (ctx->pending < LMDB_WRITE_BATCH)
+    return;
+
+  int rc = mdb_txn_commit(ctx->txn);
+  if (rc != MDB_SUCCESS)
+    mutt_debug(LL_DEBUG2, "mdb_txn_commit: %s\n", mdb_strerror(rc));
+
+  ctx->txn_mode = TXN_UNINITIALIZED;
+  ctx->txn = NULL;
+  ctx->pending = 0;
+}
+
 /**
  * store_lmdb_open - Implements StoreOps::open() - @ingroup store_open
  */
@@ -139,6 +187,13 @@ static void *store_lmdb_open(const char *path)
   mdb_env_set_mapsize(ctx->env, LMDB_DB_SIZE);
 
   rc = mdb_env_open(ctx->env, path, MDB_NOSUBDIR, 0644);
+  if ((rc == EACCES) || (rc == EROFS))
+  {
+    /* e.g. a cache shared from another account - use it for reading */
+    rc = mdb_env_open(ctx->env, path, MDB_NOSUBDIR | MDB_RDONLY, 0644);
+    if (rc == MDB_SUCCESS)
+      ctx->readonly = true;
+  }
   if (rc != MDB_SUCCESS)
   {
     mutt_debug(LL_DEBUG2, "mdb_env_open: %s\n", mdb_strerror(rc));
@@ -152,7 +207,7 @@ static void *store_lmdb_open(const char *path)
     goto fail_env;
   }
 
-  rc = mdb_dbi_open(ctx->txn, NULL, MDB_CREATE, &ctx->db);
+  rc = mdb_dbi_open(ctx->txn, NULL, ctx->readonly ? 0 : MDB_CREATE, &ctx->db);
   if (rc != MDB_SUCCESS)
   {
     mutt_debug(LL_DEBUG2, "mdb_dbi_open: %s\n", mdb_strerror(rc));
@@ -213,6 +268,54 @@ static void *store_lmdb_fetch(void *store, const char *key, size_t klen, size_t
   return data.mv_data;
 }
 
+/**
+ * store_lmdb_fetch_batch - Implements StoreOps::fetch_batch() - @ingroup store_fetch_batch
+ *
+ * All the lookups share one read transaction, instead of renewing it once per
+ * key.  The returned pointers reference the database map, just like fetch().
+ */
+static int store_lmdb_fetch_batch(void *store, const char **keys, const size_t *klens,
+                                  void **values, size_t *vlens, size_t count)
+{
+  if (!store)
+    return -1;
+
+  struct StoreLmdbCtx *ctx = store;
+
+  int rc = mdb_get_r_txn(ctx);
+  if (rc != MDB_SUCCESS)
+  {
+    ctx->txn = NULL;
+    mutt_debug(LL_DEBUG2, "txn_renew: %s\n", mdb_strerror(rc));
+    return rc;
+  }
+
+  for (size_t i = 0; i < count; i++)
+  {
+    values[i] = NULL;
+    vlens[i] = 0;
+    if (!keys[i])
+      continue;
+
+    MDB_val dkey = { klens[i], (void *) keys[i] };
+    MDB_val data = { 0, NULL };
+
+    rc = mdb_get(ctx->txn, ctx->db, &dkey, &data);
+    if (rc == MDB_SUCCESS)
+    {
+      values[i] = data.mv_data;
+      vlens[i] = data.mv_size;
+    }
+    else if (rc != MDB_NOTFOUND)
+    {
+      mutt_debug(LL_DEBUG2, "mdb_get: %s\n", mdb_strerror(rc));
+      return rc;
+    }
+  }
+
+  return MDB_SUCCESS;
+}
+
 /**
  * store_lmdb_free - Implements StoreOps::free() - @ingroup store_free
  */
@@ -245,12 +348,17 @@ static int store_lmdb_store(void *store, const char *key, size_t klen, void *val
     return rc;
   }
   rc = mdb_put(ctx->txn, ctx->db, &dkey, &databuf, 0);
-  if (rc != MDB_SUCCESS)
+  if (rc == MDB_SUCCESS)
+  {
+    mdb_put_batch(ctx);
+  }
+  else
   {
     mutt_debug(LL_DEBUG2, "mdb_put: %s\n", mdb_strerror(rc));
     mdb_txn_abort(ctx->txn);
     ctx->txn_mode = TXN_UNINITIALIZED;
     ctx->txn = NULL;
+    ctx->pending = 0;
   }
   return rc;
 }
@@ -276,17 +384,106 @@ static int store_lmdb_delete_record(void *store, const char *key, size_t klen)
     return rc;
   }
   rc = mdb_del(ctx->txn, ctx->db, &dkey, NULL);
-  if ((rc != MDB_SUCCESS) && (rc != MDB_NOTFOUND))
+  if ((rc == MDB_SUCCESS) || (rc == MDB_NOTFOUND))
+  {
+    mdb_put_batch(ctx);
+  }
+  else
   {
     mutt_debug(LL_DEBUG2, "mdb_del: %s\n", mdb_strerror(rc));
     mdb_txn_abort(ctx->txn);
     ctx->txn_mode = TXN_UNINITIALIZED;
     ctx->txn = NULL;
+    ctx->pending = 0;
   }
 
   return rc;
 }
 
+/**
+ * store_lmdb_foreach - Implements StoreOps::foreach() - @ingroup store_foreach
+ *
+ * The walk uses a cursor in a read transaction, so a callback that collects
+ * keys for later deletion doesn't deadlock against the writer lock.
+ */
+static int store_lmdb_foreach(void *store, store_foreach_t cb, void *data)
+{
+  if (!store)
+    return -1;
+
+  struct StoreLmdbCtx *ctx = store;
+
+  int rc = mdb_get_r_txn(ctx);
+  if (rc != MDB_SUCCESS)
+  {
+    ctx->txn = NULL;
+    mutt_debug(LL_DEBUG2, "txn_renew: %s\n", mdb_strerror(rc));
+    return rc;
+  }
+
+  MDB_cursor *cursor = NULL;
+  rc = mdb_cursor_open(ctx->txn, ctx->db, &cursor);
+  if (rc != MDB_SUCCESS)
+  {
+    mutt_debug(LL_DEBUG2, "mdb_cursor_open: %s\n", mdb_strerror(rc));
+    return rc;
+  }
+
+  MDB_val dkey = { 0, NULL };
+  MDB_val data2 = { 0, NULL };
+  while ((rc = mdb_cursor_get(cursor, &dkey, &data2, MDB_NEXT)) == MDB_SUCCESS)
+  {
+    rc = cb(dkey.mv_data, dkey.mv_size, data);
+    if (rc != 0)
+      break;
+  }
+  if (rc == MDB_NOTFOUND)
+    rc = MDB_SUCCESS; // the cursor ran off the end
+
+  mdb_cursor_close(cursor);
+  return rc;
+}
+
+/**
+ * store_lmdb_txn_begin - Implements StoreOps::txn_begin() - @ingroup store_txn_begin
+ */
+static int store_lmdb_txn_begin(void *store)
+{
+  if (!store)
+    return -1;
+
+  struct StoreLmdbCtx *ctx = store;
+
+  int rc = mdb_get_w_txn(ctx);
+  if (rc == MDB_SUCCESS)
+    ctx->in_txn = true;
+  return rc;
+}
+
+/**
+ * store_lmdb_txn_commit - Implements StoreOps::txn_commit() - @ingroup store_txn_commit
+ */
+static int store_lmdb_txn_commit(void *store)
+{
+  if (!store)
+    return -1;
+
+  struct StoreLmdbCtx *ctx = store;
+
+  ctx->in_txn = false;
+  if (!ctx->txn || (ctx->txn_mode != TXN_WRITE))
+    return MDB_SUCCESS;
+
+  int rc = mdb_txn_commit(ctx->txn);
+  if (rc != MDB_SUCCESS)
+    mutt_debug(LL_DEBUG2, "mdb_txn_commit: %s\n", mdb_strerror(rc));
+
+  ctx->txn_mode = TXN_UNINITIALIZED;
+  ctx->txn = NULL;
+  ctx->pending = 0;
+  return rc;
+}
+
 /**
  * store_lmdb_close - Implements StoreOps::close() - @ingroup store_close
  */
@@ -320,4 +517,6 @@ static const char *store_lmdb_version(void)
   return "lmdb " MDB_VERSION_STRING;
 }
 
-STORE_BACKEND_OPS(lmdb)
+STORE_BACKEND_OPS(lmdb, .fetch_batch = store_lmdb_fetch_batch,
+                  .foreach = store_lmdb_foreach,
+                  .txn_begin = store_lmdb_txn_begin, .txn_commit = store_lmdb_txn_commit)
@@ -31,6 +31,8 @@
 #include <stddef.h>
 #include <rocksdb/c.h>
 #include "mutt/lib.h"
+#include "config/lib.h"
+#include "core/lib.h"
 #include "lib.h"
 
 /**
@@ -42,9 +44,46 @@ struct RocksDbCtx
   rocksdb_options_t *options;
   rocksdb_readoptions_t *read_options;
   rocksdb_writeoptions_t *write_options;
+  rocksdb_block_based_table_options_t *table_options;
+  rocksdb_cache_t *cache;      ///< Block cache, `$header_cache_rocksdb_block_cache_size`
+  rocksdb_writebatch_t *batch; ///< Open transaction, StoreOps::txn_begin()
   char *err;
 };
 
+/**
+ * rocksdb_compression_type - Look up a compression method by name
+ * @param name Method name, e.g. "zstd"
+ * @retval num RocksDB compression constant, e.g. `rocksdb_zstd_compression`
+ *
+ * Unknown or unset names give `rocksdb_no_compression`.
+ */
+static int rocksdb_compression_type(const char *name)
+{
+  static const struct
+  {
+    const char *name;
+    int type;
+  } methods[] = {
+    // clang-format off
+    { "snappy", rocksdb_snappy_compression },
+    { "zlib",   rocksdb_zlib_compression   },
+    { "bzip2",  rocksdb_bz2_compression    },
+    { "lz4",    rocksdb_lz4_compression    },
+    { "lz4hc",  rocksdb_lz4hc_compression  },
+    { "xpress", rocksdb_xpress_compression },
+    { "zstd",   rocksdb_zstd_compression   },
+    // clang-format on
+  };
+
+  for (size_t i = 0; i < mutt_array_size(methods); i++)
+  {
+    if (mutt_istr_equal(name, methods[i].name))
+      return methods[i].type;
+  }
+
+  return rocksdb_no_compression;
+}
+
 /**
  * store_rocksdb_open - Implements StoreOps::open() - @ingroup store_open
  */
@@ -57,12 +96,33 @@ static void *store_rocksdb_open(const char *path)
 
   /* RocksDB store errors in form of strings */
   ctx->err = NULL;
+  ctx->batch = NULL;
+  ctx->cache = NULL;
 
   /* setup generic options, create new db and limit log to one file */
   ctx->options = rocksdb_options_create();
   rocksdb_options_set_create_if_missing(ctx->options, 1);
   rocksdb_options_set_keep_log_file_num(ctx->options, 1);
 
+  /* block cache and bloom filters; the latter keep misses (every new
+   * message) from touching the disk at all */
+  const long c_block_cache_size =
+      cs_subset_long(NeoMutt->sub, "header_cache_rocksdb_block_cache_size");
+  const short c_bloom_bits =
+      cs_subset_number(NeoMutt->sub, "header_cache_rocksdb_bloom_bits");
+  ctx->table_options = rocksdb_block_based_options_create();
+  if (c_block_cache_size > 0)
+  {
+    ctx->cache = rocksdb_cache_create_lru(c_block_cache_size);
+    rocksdb_block_based_options_set_block_cache(ctx->table_options, ctx->cache);
+  }
+  if (c_bloom_bits > 0)
+  {
+    rocksdb_block_based_options_set_filter_policy(
+        ctx->table_options, rocksdb_filterpolicy_create_bloom_full(c_bloom_bits));
+  }
+  rocksdb_options_set_block_based_table_factory(ctx->options, ctx->table_options);
+
   /* setup read options, we verify with checksums */
   ctx->read_options = rocksdb_readoptions_create();
   rocksdb_readoptions_set_verify_checksums(ctx->read_options, 1);
@@ -72,7 +132,9 @@ static void *store_rocksdb_open(const char *path)
   rocksdb_writeoptions_set_sync(ctx->write_options, 0);
   rocksdb_writeoptions_disable_WAL(ctx->write_options, 1);
 
-  rocksdb_options_set_compression(ctx->options, rocksdb_no_compression);
+  const char *const c_compression =
+      cs_subset_string(NeoMutt->sub, "header_cache_rocksdb_compression");
+  rocksdb_options_set_compression(ctx->options, rocksdb_compression_type(c_compression));
 
   /* open database and check for error in ctx->error */
   ctx->db = rocksdb_open(ctx->options, path, &ctx->err);
@@ -126,6 +188,12 @@ static int store_rocksdb_store(void *store, const char *key, size_t klen,
 
   struct RocksDbCtx *ctx = store;
 
+  if (ctx->batch)
+  {
+    rocksdb_writebatch_put(ctx->batch, key, klen, value, vlen);
+    return 0;
+  }
+
   rocksdb_put(ctx->db, ctx->write_options, key, klen, value, vlen, &ctx->err);
   if (ctx->err)
   {
@@ -147,6 +215,12 @@ static int store_rocksdb_delete_record(void *store, const char *key, size_t klen
 
   struct RocksDbCtx *ctx = store;
 
+  if (ctx->batch)
+  {
+    rocksdb_writebatch_delete(ctx->batch, key, klen);
+    return 0;
+  }
+
   rocksdb_delete(ctx->db, ctx->write_options, key, klen, &ctx->err);
   if (ctx->err)
   {
@@ -158,6 +232,76 @@ static int store_rocksdb_delete_record(void *store, const char *key, size_t klen
   return 0;
 }
 
+/**
+ * store_rocksdb_foreach - Implements StoreOps::foreach() - @ingroup store_foreach
+ */
+static int store_rocksdb_foreach(void *store, store_foreach_t cb, void *data)
+{
+  if (!store)
+    return -1;
+
+  struct RocksDbCtx *ctx = store;
+
+  rocksdb_iterator_t *iter = rocksdb_create_iterator(ctx->db, ctx->read_options);
+  if (!iter)
+    return -1;
+
+  int rc = 0;
+  for (rocksdb_iter_seek_to_first(iter); rocksdb_iter_valid(iter);
+       rocksdb_iter_next(iter))
+  {
+    size_t klen = 0;
+    const char *key = rocksdb_iter_key(iter, &klen);
+    rc = cb(key, klen, data);
+    if (rc != 0)
+      break;
+  }
+
+  rocksdb_iter_destroy(iter);
+  return rc;
+}
+
+/**
+ * store_rocksdb_txn_begin - Implements StoreOps::txn_begin() - @ingroup store_txn_begin
+ */
+static int store_rocksdb_txn_begin(void *store)
+{
+  if (!store)
+    return -1;
+
+  struct RocksDbCtx *ctx = store;
+
+  if (!ctx->batch)
+    ctx->batch = rocksdb_writebatch_create();
+  return 0;
+}
+
+/**
+ * store_rocksdb_txn_commit - Implements StoreOps::txn_commit() - @ingroup store_txn_commit
+ */
+static int store_rocksdb_txn_commit(void *store)
+{
+  if (!store)
+    return -1;
+
+  struct RocksDbCtx *ctx = store;
+
+  if (!ctx->batch)
+    return 0;
+
+  rocksdb_write(ctx->db, ctx->write_options, ctx->batch, &ctx->err);
+  rocksdb_writebatch_destroy(ctx->batch);
+  ctx->batch = NULL;
+  if (ctx->err)
+  {
+    rocksdb_free(ctx->err);
+    ctx->err = NULL;
+    return -1;
+  }
+
+  return 0;
+}
+
 /**
  * store_rocksdb_close - Implements StoreOps::close() - @ingroup store_close
  */
@@ -168,11 +312,17 @@ static void store_rocksdb_close(void **ptr)
 
   struct RocksDbCtx *ctx = *ptr;
 
+  /* flush a transaction that was never committed */
+  store_rocksdb_txn_commit(ctx);
+
   /* close database and free resources */
   rocksdb_close(ctx->db);
   rocksdb_options_destroy(ctx->options);
   rocksdb_readoptions_destroy(ctx->read_options);
   rocksdb_writeoptions_destroy(ctx->write_options);
+  rocksdb_block_based_options_destroy(ctx->table_options);
+  if (ctx->cache)
+    rocksdb_cache_destroy(ctx->cache);
 
   FREE(ptr);
   *ptr = NULL;
@@ -188,4 +338,6 @@ static const char *store_rocksdb_version(void)
   return "RocksDB " RDBVER(ROCKSDB_MAJOR, ROCKSDB_MINOR, ROCKSDB_PATCH);
 }
 
-STORE_BACKEND_OPS(rocksdb)
+STORE_BACKEND_OPS(rocksdb, .foreach = store_rocksdb_foreach,
+                  .txn_begin = store_rocksdb_txn_begin,
+                  .txn_commit = store_rocksdb_txn_commit)
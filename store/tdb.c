@@ -117,6 +117,46 @@ static int store_tdb_delete_record(void *store, const char *key, size_t klen)
   return tdb_delete(db, dkey);
 }
 
+/**
+ * struct TdbTraverse - State for store_tdb_foreach()
+ */
+struct TdbTraverse
+{
+  store_foreach_t cb; ///< Caller's callback
+  void *data;         ///< Caller's private data
+};
+
+/**
+ * tdb_traverse_cb - Pass one key to the caller's callback - tdb_traverse_func
+ * @param db    TDB database
+ * @param dkey  Key of the visited record
+ * @param dval  Value of the visited record (unused)
+ * @param state TdbTraverse state
+ * @retval 0   Continue
+ * @retval num Stop the traversal
+ */
+static int tdb_traverse_cb(TDB_CONTEXT *db, TDB_DATA dkey, TDB_DATA dval, void *state)
+{
+  struct TdbTraverse *tt = state;
+  return tt->cb((const char *) dkey.dptr, dkey.dsize, tt->data);
+}
+
+/**
+ * store_tdb_foreach - Implements StoreOps::foreach() - @ingroup store_foreach
+ */
+static int store_tdb_foreach(void *store, store_foreach_t cb, void *data)
+{
+  if (!store)
+    return -1;
+
+  TDB_CONTEXT *db = store;
+  struct TdbTraverse tt = { cb, data };
+
+  /* tdb_traverse_read() takes no write locks */
+  int rc = tdb_traverse_read(db, tdb_traverse_cb, &tt);
+  return (rc < 0) ? -1 : 0;
+}
+
 /**
  * store_tdb_close - Implements StoreOps::close() - @ingroup store_close
  */
@@ -139,4 +179,4 @@ static const char *store_tdb_version(void)
   return "tdb";
 }
 
-STORE_BACKEND_OPS(tdb)
+STORE_BACKEND_OPS(tdb, .foreach = store_tdb_foreach)
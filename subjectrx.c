@@ -157,6 +157,23 @@ void subjrx_clear_mods(struct Mailbox *m)
   }
 }
 
+/**
+ * subjrx_fingerprint - Mix the subjectrx rules into an MD5 digest
+ * @param md5ctx MD5 context to update
+ *
+ * The header cache stores Envelope::disp_subj, so its version has to change
+ * when the rules that produced it change.
+ */
+void subjrx_fingerprint(struct Md5Ctx *md5ctx)
+{
+  struct Replace *np = NULL;
+  STAILQ_FOREACH(np, &SubjectRegexList, entries)
+  {
+    mutt_md5_process(np->regex->pattern, md5ctx);
+    mutt_md5_process(np->templ, md5ctx);
+  }
+}
+
 /**
  * parse_subjectrx_list - Parse the 'subjectrx' command - Implements Command::parse() - @ingroup command_parse
  */
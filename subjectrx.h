@@ -29,6 +29,7 @@
 
 struct Buffer;
 struct Envelope;
+struct Md5Ctx;
 
 /**
  * enum NotifySubjRx - Subject Regex notification types
@@ -52,5 +53,6 @@ enum CommandResult parse_unsubjectrx_list(struct Buffer *buf, struct Buffer *s,
 
 bool subjrx_apply_mods(struct Envelope *env);
 void subjrx_clear_mods(struct Mailbox *m);
+void subjrx_fingerprint(struct Md5Ctx *md5ctx);
 
 #endif /* MUTT_SUBJECTRX_H */
@@ -0,0 +1,72 @@
+/**
+ * @file
+ * Test code for mutt_addrlist_move()
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+#include "address/lib.h"
+#include "test_common.h"
+
+void test_mutt_addrlist_move(void)
+{
+  // void mutt_addrlist_move(struct AddressList *dst, struct AddressList *src);
+
+  {
+    struct AddressList al = { 0 };
+    mutt_addrlist_move(NULL, &al);
+    TEST_CHECK_(1, "mutt_addrlist_move(NULL, &al)");
+  }
+
+  {
+    struct AddressList al = { 0 };
+    mutt_addrlist_move(&al, NULL);
+    TEST_CHECK_(1, "mutt_addrlist_move(&al, NULL)");
+  }
+
+  {
+    struct AddressList src = TAILQ_HEAD_INITIALIZER(src);
+    struct AddressList dst = TAILQ_HEAD_INITIALIZER(dst);
+    mutt_addrlist_move(&dst, &src);
+    TEST_CHECK(TAILQ_EMPTY(&src));
+    TEST_CHECK(TAILQ_EMPTY(&dst));
+  }
+
+  {
+    struct AddressList src = TAILQ_HEAD_INITIALIZER(src);
+    struct AddressList dst = TAILQ_HEAD_INITIALIZER(dst);
+    mutt_addrlist_append(&src, mutt_addr_create(NULL, "test@example.com"));
+    mutt_addrlist_append(&src, mutt_addr_create(NULL, "john@doe.org"));
+    mutt_addrlist_append(&dst, mutt_addr_create(NULL, "the-who@stage.co.uk"));
+    mutt_addrlist_move(&dst, &src);
+    TEST_CHECK(TAILQ_EMPTY(&src));
+    TEST_CHECK(!TAILQ_EMPTY(&dst));
+    struct Address *adst = TAILQ_FIRST(&dst);
+    TEST_CHECK_STR_EQ("the-who@stage.co.uk", adst->mailbox);
+    adst = TAILQ_NEXT(adst, entries);
+    TEST_CHECK_STR_EQ("test@example.com", adst->mailbox);
+    adst = TAILQ_NEXT(adst, entries);
+    TEST_CHECK_STR_EQ("john@doe.org", adst->mailbox);
+    TEST_CHECK(TAILQ_NEXT(adst, entries) == NULL);
+    mutt_addrlist_clear(&dst);
+  }
+}
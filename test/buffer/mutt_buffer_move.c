@@ -0,0 +1,81 @@
+/**
+ * @file
+ * Test code for mutt_buffer_move()
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+
+void test_mutt_buffer_move(void)
+{
+  // void mutt_buffer_move(struct Buffer *dst, struct Buffer *src);
+
+  {
+    struct Buffer buf = mutt_buffer_make(0);
+    mutt_buffer_move(NULL, &buf);
+    TEST_CHECK_(1, "mutt_buffer_move(NULL, &buf)");
+  }
+
+  {
+    struct Buffer buf = mutt_buffer_make(0);
+    mutt_buffer_move(&buf, NULL);
+    TEST_CHECK_(1, "mutt_buffer_move(&buf, NULL)");
+  }
+
+  {
+    struct Buffer buf = mutt_buffer_make(32);
+    mutt_buffer_strcpy(&buf, "apple");
+    mutt_buffer_move(&buf, &buf);
+    TEST_CHECK(mutt_str_equal(mutt_buffer_string(&buf), "apple"));
+    mutt_buffer_dealloc(&buf);
+  }
+
+  {
+    struct Buffer src = mutt_buffer_make(32);
+    struct Buffer dst = mutt_buffer_make(0);
+    mutt_buffer_strcpy(&src, "apple");
+    char *data = src.data;
+
+    mutt_buffer_move(&dst, &src);
+
+    TEST_CHECK(mutt_str_equal(mutt_buffer_string(&dst), "apple"));
+    TEST_CHECK(dst.data == data);
+    TEST_CHECK(mutt_buffer_is_empty(&src));
+    TEST_CHECK(src.data == NULL);
+
+    mutt_buffer_dealloc(&dst);
+  }
+
+  {
+    struct Buffer src = mutt_buffer_make(32);
+    struct Buffer dst = mutt_buffer_make(32);
+    mutt_buffer_strcpy(&src, "apple");
+    mutt_buffer_strcpy(&dst, "banana");
+
+    mutt_buffer_move(&dst, &src);
+
+    TEST_CHECK(mutt_str_equal(mutt_buffer_string(&dst), "apple"));
+    TEST_CHECK(mutt_buffer_is_empty(&src));
+
+    mutt_buffer_dealloc(&dst);
+  }
+}
@@ -140,6 +140,15 @@ void test_config_helpers(void)
   TEST_CHECK(cs_subset_sort(sub, "Mango") == 1);
   TEST_CHECK(mutt_str_equal(cs_subset_string(sub, "Nectarine"), "nectarine"));
 
+  // Cached lookups resolve once, then follow config changes
+  struct ConfigCache cache = { 0 };
+  TEST_CHECK((bool) cs_subset_cached(sub, "Apple", &cache) == false);
+  TEST_CHECK(cache.generation == cs_subset_generation());
+  TEST_CHECK((bool) cs_subset_cached(sub, "Apple", &cache) == false);
+  cs_subset_str_native_set(sub, "Apple", true, NULL);
+  TEST_CHECK(cache.generation != cs_subset_generation());
+  TEST_CHECK((bool) cs_subset_cached(sub, "Apple", &cache) == true);
+
   neomutt_free(&NeoMutt);
   cs_subset_free(&sub);
   cs_free(&cs);
@@ -94,6 +94,8 @@ void test_mutt_date_parse_date(void)
 
      /* Good stuff */
      { "Wed, 13 Jun 2007 12:34:56 +0100",            1181734496 },
+     { "13 Jun 2007 12:34:56 +0100",                 1181734496 },
+     { "Thu, 27 Aug 2026 10:23:45 +0200",            1787819025 },
      { "Wed, 13 Jun 2007 12:34:56 MET DST",          1181734496 },
      { "Wed, 13 Jun 20 12:34:56 +0100",              1592048096 },
      { "Wed, 13 Jun 2007 12:34 +0100",               1181734440 },
@@ -38,4 +38,29 @@ void test_mutt_file_copy_bytes(void)
     FILE fp = { 0 };
     TEST_CHECK(mutt_file_copy_bytes(&fp, NULL, 10) != 0);
   }
+
+  {
+    // Copy part of a real file, with a byte already in the read buffer
+    FILE *fp_in = tmpfile();
+    FILE *fp_out = tmpfile();
+    TEST_CHECK(fp_in && fp_out);
+
+    char data[4100];
+    for (size_t i = 0; i < sizeof(data); i++)
+      data[i] = 'a' + (i % 26);
+    TEST_CHECK(fwrite(data, 1, sizeof(data), fp_in) == sizeof(data));
+    rewind(fp_in);
+
+    TEST_CHECK(fgetc(fp_in) == 'a');
+    TEST_CHECK(mutt_file_copy_bytes(fp_in, fp_out, sizeof(data) - 2) == 0);
+    TEST_CHECK(ftello(fp_in) == (off_t) (sizeof(data) - 1));
+
+    char copy[4100] = { 0 };
+    rewind(fp_out);
+    TEST_CHECK(fread(copy, 1, sizeof(copy), fp_out) == (sizeof(data) - 2));
+    TEST_CHECK(memcmp(copy, data + 1, sizeof(data) - 2) == 0);
+
+    fclose(fp_in);
+    fclose(fp_out);
+  }
 }
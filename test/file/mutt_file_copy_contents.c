@@ -0,0 +1,64 @@
+/**
+ * @file
+ * Test code for mutt_file_copy_contents()
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <string.h>
+#include "mutt/lib.h"
+
+void test_mutt_file_copy_contents(void)
+{
+  // int mutt_file_copy_contents(FILE *fp_in, FILE *fp_out);
+
+  {
+    FILE fp = { 0 };
+    TEST_CHECK(mutt_file_copy_contents(NULL, &fp) != 0);
+  }
+
+  {
+    FILE fp = { 0 };
+    TEST_CHECK(mutt_file_copy_contents(&fp, NULL) != 0);
+  }
+
+  {
+    const char *src = "The quick brown fox jumps over the lazy dog";
+
+    FILE *fp_in = tmpfile();
+    FILE *fp_out = tmpfile();
+    TEST_CHECK(fp_in && fp_out);
+
+    fputs(src, fp_in);
+    fflush(fp_in);
+    rewind(fp_in);
+
+    TEST_CHECK(mutt_file_copy_contents(fp_in, fp_out) == (int) strlen(src));
+
+    char buf[128] = { 0 };
+    rewind(fp_out);
+    TEST_CHECK(fread(buf, 1, sizeof(buf), fp_out) == strlen(src));
+    TEST_CHECK(mutt_str_equal(buf, src));
+
+    fclose(fp_in);
+    fclose(fp_out);
+  }
+}
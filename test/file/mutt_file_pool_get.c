@@ -0,0 +1,63 @@
+/**
+ * @file
+ * Test code for mutt_file_pool_get()
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <string.h>
+#include "mutt/lib.h"
+
+void test_mutt_file_pool_get(void)
+{
+  // FILE *mutt_file_pool_get(void);
+  // void mutt_file_pool_release(FILE **ptr);
+  // void mutt_file_pool_free(void);
+
+  {
+    mutt_file_pool_release(NULL);
+    TEST_CHECK_(1, "mutt_file_pool_release(NULL)");
+  }
+
+  {
+    FILE *fp = NULL;
+    mutt_file_pool_release(&fp);
+    TEST_CHECK_(1, "mutt_file_pool_release(&fp)");
+  }
+
+  {
+    FILE *fp = mutt_file_pool_get();
+    TEST_CHECK(fp != NULL);
+
+    fputs("hello", fp);
+    mutt_file_pool_release(&fp);
+    TEST_CHECK(fp == NULL);
+
+    // The handle is recycled - empty and rewound
+    FILE *fp2 = mutt_file_pool_get();
+    TEST_CHECK(fp2 != NULL);
+    TEST_CHECK(ftell(fp2) == 0);
+    TEST_CHECK(fgetc(fp2) == EOF);
+
+    mutt_file_pool_release(&fp2);
+    mutt_file_pool_free();
+  }
+}
@@ -64,4 +64,23 @@ void test_mutt_hash_new(void)
     mutt_hash_insert(table, "apple", &dummy3);
     mutt_hash_free(&table);
   }
+
+  {
+    struct HashTable *table = mutt_hash_new(2, MUTT_HASH_OPEN_ADDR | MUTT_HASH_STRDUP_KEYS);
+    char buf[32];
+    for (size_t i = 0; i < 50; i++)
+    {
+      snprintf(buf, sizeof(buf), "apple%zu", i);
+      mutt_hash_insert(table, buf, &dummy1);
+    }
+    for (size_t i = 0; i < 50; i++)
+    {
+      snprintf(buf, sizeof(buf), "apple%zu", i);
+      TEST_CHECK(mutt_hash_find(table, buf) == &dummy1);
+    }
+    mutt_hash_delete(table, "apple25", NULL);
+    TEST_CHECK(!mutt_hash_find(table, "apple25"));
+    TEST_CHECK(mutt_hash_find(table, "apple26") == &dummy1);
+    mutt_hash_free(&table);
+  }
 }
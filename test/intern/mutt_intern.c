@@ -0,0 +1,54 @@
+/**
+ * @file
+ * Test code for mutt_intern()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <string.h>
+#include "mutt/lib.h"
+
+void test_mutt_intern(void)
+{
+  // char *mutt_intern(const char *s);
+
+  {
+    TEST_CHECK(mutt_intern(NULL) == NULL);
+  }
+
+  {
+    char *first = mutt_intern("apple");
+    TEST_CHECK(first != NULL);
+    TEST_CHECK(strcmp(first, "apple") == 0);
+
+    // A second intern of equal contents returns the same pointer
+    char *second = mutt_intern("apple");
+    TEST_CHECK(second == first);
+
+    char *other = mutt_intern("banana");
+    TEST_CHECK(other != first);
+
+    mutt_intern_release(&first);
+    mutt_intern_release(&second);
+    mutt_intern_release(&other);
+    mutt_intern_cleanup();
+  }
+}
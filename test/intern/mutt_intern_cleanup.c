@@ -0,0 +1,46 @@
+/**
+ * @file
+ * Test code for mutt_intern_cleanup()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include "mutt/lib.h"
+
+void test_mutt_intern_cleanup(void)
+{
+  // void mutt_intern_cleanup(void);
+
+  {
+    // Safe to call with nothing interned
+    mutt_intern_cleanup();
+
+    char *str = mutt_intern("fig");
+    mutt_intern_release(&str);
+    mutt_intern_cleanup();
+
+    // The table is recreated on demand afterwards
+    str = mutt_intern("fig");
+    TEST_CHECK(str != NULL);
+    mutt_intern_release(&str);
+    mutt_intern_cleanup();
+  }
+}
@@ -0,0 +1,69 @@
+/**
+ * @file
+ * Test code for mutt_intern_release()
+ *
+ * @authors
+ * Copyright (C) 2026 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <string.h>
+#include "mutt/lib.h"
+
+void test_mutt_intern_release(void)
+{
+  // void mutt_intern_release(char **ptr);
+
+  {
+    mutt_intern_release(NULL);
+    char *str = NULL;
+    mutt_intern_release(&str);
+  }
+
+  {
+    // Releasing one reference keeps the others valid
+    char *first = mutt_intern("cherry");
+    char *second = mutt_intern("cherry");
+    mutt_intern_release(&first);
+    TEST_CHECK(first == NULL);
+    TEST_CHECK(strcmp(second, "cherry") == 0);
+    mutt_intern_release(&second);
+    TEST_CHECK(second == NULL);
+
+    // A fresh intern after full release allocates anew
+    char *third = mutt_intern("cherry");
+    TEST_CHECK(strcmp(third, "cherry") == 0);
+    mutt_intern_release(&third);
+  }
+
+  {
+    // An ordinary heap string is freed, not looked up
+    char *plain = mutt_str_dup("damson");
+    mutt_intern_release(&plain);
+    TEST_CHECK(plain == NULL);
+
+    // Even one that matches an interned value by contents
+    char *interned = mutt_intern("elderberry");
+    char *copy = mutt_str_dup("elderberry");
+    mutt_intern_release(&copy);
+    TEST_CHECK(strcmp(interned, "elderberry") == 0);
+    mutt_intern_release(&interned);
+    mutt_intern_cleanup();
+  }
+}
@@ -55,6 +55,7 @@
   NEOMUTT_TEST_ITEM(test_mutt_addrlist_count_recips)                           \
   NEOMUTT_TEST_ITEM(test_mutt_addrlist_dedupe)                                 \
   NEOMUTT_TEST_ITEM(test_mutt_addrlist_equal)                                  \
+  NEOMUTT_TEST_ITEM(test_mutt_addrlist_move)                                   \
   NEOMUTT_TEST_ITEM(test_mutt_addrlist_parse)                                  \
   NEOMUTT_TEST_ITEM(test_mutt_addrlist_parse2)                                 \
   NEOMUTT_TEST_ITEM(test_mutt_addrlist_prepend)                                \
@@ -104,6 +105,7 @@
   NEOMUTT_TEST_ITEM(test_mutt_buffer_is_empty)                                 \
   NEOMUTT_TEST_ITEM(test_mutt_buffer_len)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_buffer_make)                                     \
+  NEOMUTT_TEST_ITEM(test_mutt_buffer_move)                                     \
   NEOMUTT_TEST_ITEM(test_mutt_buffer_pool_free)                                \
   NEOMUTT_TEST_ITEM(test_mutt_buffer_pool_get)                                 \
   NEOMUTT_TEST_ITEM(test_mutt_buffer_pool_release)                             \
@@ -216,6 +218,7 @@
   NEOMUTT_TEST_ITEM(test_mutt_file_chmod_rm)                                   \
   NEOMUTT_TEST_ITEM(test_mutt_file_chmod_rm_stat)                              \
   NEOMUTT_TEST_ITEM(test_mutt_file_copy_bytes)                                 \
+  NEOMUTT_TEST_ITEM(test_mutt_file_copy_contents)                              \
   NEOMUTT_TEST_ITEM(test_mutt_file_copy_stream)                                \
   NEOMUTT_TEST_ITEM(test_mutt_file_decrease_mtime)                             \
   NEOMUTT_TEST_ITEM(test_mutt_file_expand_fmt)                                 \
@@ -230,6 +233,7 @@
   NEOMUTT_TEST_ITEM(test_mutt_file_mkdir)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_file_mkstemp_full)                               \
   NEOMUTT_TEST_ITEM(test_mutt_file_open)                                       \
+  NEOMUTT_TEST_ITEM(test_mutt_file_pool_get)                                   \
   NEOMUTT_TEST_ITEM(test_mutt_file_quote_filename)                             \
   NEOMUTT_TEST_ITEM(test_mutt_file_read_keyword)                               \
   NEOMUTT_TEST_ITEM(test_mutt_file_read_line)                                  \
@@ -308,6 +312,11 @@
   NEOMUTT_TEST_ITEM(test_mutt_idna_print_version)                              \
   NEOMUTT_TEST_ITEM(test_mutt_idna_to_ascii_lz)                                \
                                                                                \
+  /* intern */                                                                 \
+  NEOMUTT_TEST_ITEM(test_mutt_intern)                                          \
+  NEOMUTT_TEST_ITEM(test_mutt_intern_cleanup)                                  \
+  NEOMUTT_TEST_ITEM(test_mutt_intern_release)                                  \
+                                                                               \
   /* list */                                                                   \
   NEOMUTT_TEST_ITEM(test_mutt_list_clear)                                      \
   NEOMUTT_TEST_ITEM(test_mutt_list_compare)                                    \
@@ -443,6 +452,10 @@
                                                                                \
   /* pattern */                                                                \
   NEOMUTT_TEST_ITEM(test_mutt_pattern_comp)                                    \
+  NEOMUTT_TEST_ITEM(test_pattern_cache)                                        \
+  NEOMUTT_TEST_ITEM(test_pattern_date_index)                                   \
+  NEOMUTT_TEST_ITEM(test_pattern_flag_index)                                   \
+  NEOMUTT_TEST_ITEM(test_pattern_trigram)                                      \
                                                                                \
   /* prex */                                                                   \
   NEOMUTT_TEST_ITEM(test_mutt_prex_capture)                                    \
@@ -25,7 +25,58 @@
 #include "acutest.h"
 #include "mutt/lib.h"
 
+static int AccountCalls = 0;
+static int AllCalls = 0;
+static int MailboxCalls = 0;
+
+static int observe_account(struct NotifyCallback *nc)
+{
+  AccountCalls++;
+  return 0;
+}
+
+static int observe_all(struct NotifyCallback *nc)
+{
+  AllCalls++;
+  return 0;
+}
+
+static int observe_mailbox(struct NotifyCallback *nc)
+{
+  MailboxCalls++;
+  return 0;
+}
+
 void test_notify_send(void)
 {
-  // bool notify_send(struct Notify *notify, enum NotifyType event_type,;
+  // bool notify_send(struct Notify *notify, enum NotifyType event_type, int event_subtype, void *event_data);
+
+  struct Notify *parent = notify_new();
+  struct Notify *child = notify_new();
+  notify_set_parent(child, parent);
+
+  TEST_CHECK(notify_observer_add(child, NT_ACCOUNT, observe_account, NULL));
+  TEST_CHECK(notify_observer_add(parent, NT_ALL, observe_all, NULL));
+  TEST_CHECK(notify_observer_add(parent, NT_MAILBOX, observe_mailbox, NULL));
+
+  // Matching observers are called, events propagate to the parent
+  TEST_CHECK(notify_send(child, NT_ACCOUNT, 0, NULL));
+  TEST_CHECK(AccountCalls == 1);
+  TEST_CHECK(AllCalls == 1);
+  TEST_CHECK(MailboxCalls == 0);
+
+  // Observers of other types are not called
+  TEST_CHECK(notify_send(child, NT_MAILBOX, 0, NULL));
+  TEST_CHECK(AccountCalls == 1);
+  TEST_CHECK(AllCalls == 2);
+  TEST_CHECK(MailboxCalls == 1);
+
+  // Removed observers are not called
+  TEST_CHECK(notify_observer_remove(child, observe_account, NULL));
+  TEST_CHECK(notify_send(child, NT_ACCOUNT, 0, NULL));
+  TEST_CHECK(AccountCalls == 1);
+  TEST_CHECK(AllCalls == 3);
+
+  notify_free(&child);
+  notify_free(&parent);
 }
@@ -34,4 +34,30 @@ void test_mutt_matches_ignore(void)
   {
     TEST_CHECK(!mutt_matches_ignore(NULL));
   }
+
+  {
+    mutt_list_insert_tail(&Ignore, mutt_str_dup("x-"));
+    mutt_list_insert_tail(&Ignore, mutt_str_dup("Received"));
+    mutt_list_insert_tail(&UnIgnore, mutt_str_dup("X-Spam"));
+    mutt_matches_ignore_flush();
+
+    TEST_CHECK(mutt_matches_ignore("Received"));
+    TEST_CHECK(mutt_matches_ignore("received-spf")); // prefix, any case
+    TEST_CHECK(mutt_matches_ignore("X-Mailer"));
+    TEST_CHECK(!mutt_matches_ignore("X-Spam-Status")); // unignore wins
+    TEST_CHECK(!mutt_matches_ignore("Receive"));       // shorter than the entry
+    TEST_CHECK(!mutt_matches_ignore("Subject"));
+
+    mutt_list_insert_tail(&Ignore, mutt_str_dup("*"));
+    mutt_matches_ignore_flush();
+
+    TEST_CHECK(mutt_matches_ignore("Subject"));
+    TEST_CHECK(!mutt_matches_ignore("X-Spam-Status"));
+
+    mutt_list_free(&Ignore);
+    mutt_list_free(&UnIgnore);
+    mutt_matches_ignore_flush();
+
+    TEST_CHECK(!mutt_matches_ignore("Received"));
+  }
 }
@@ -0,0 +1,105 @@
+/**
+ * @file
+ * Test code for the compiled pattern cache
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <string.h>
+#include "mutt/buffer.h"
+#include "pattern/lib.h"
+
+void test_pattern_cache(void)
+{
+  struct Buffer err = mutt_buffer_make(256);
+  struct Mailbox *m = (struct Mailbox *) &err; /* only used as a key */
+
+  { /* a repeated pattern reuses the compiled copy */
+    struct PatternList *p1 =
+        pattern_cache_comp(NULL, NULL, "~f neomutt", MUTT_PC_NO_FLAGS, &err);
+    TEST_CHECK(p1 != NULL);
+
+    struct PatternList *p2 =
+        pattern_cache_comp(NULL, NULL, "~f neomutt", MUTT_PC_NO_FLAGS, &err);
+    TEST_CHECK(p2 == p1);
+
+    /* different flags means a different entry */
+    struct PatternList *p3 =
+        pattern_cache_comp(NULL, NULL, "~f neomutt", MUTT_PC_FULL_MSG, &err);
+    TEST_CHECK(p3 != NULL);
+    TEST_CHECK(p3 != p1);
+
+    pattern_cache_release(&p1);
+    pattern_cache_release(&p2);
+    pattern_cache_release(&p3);
+    TEST_CHECK(!p1 && !p2 && !p3);
+  }
+
+  { /* match results survive a round trip, keyed by mailbox and count */
+    struct PatternList *pat =
+        pattern_cache_comp(NULL, NULL, "~s wibble", MUTT_PC_NO_FLAGS, &err);
+    TEST_CHECK(pat != NULL);
+
+    bool set[4] = { true, false, true, false };
+    bool got[4] = { false, false, false, false };
+
+    TEST_CHECK(!pattern_cache_get_results(pat, m, got, 4));
+    pattern_cache_set_results(pat, m, set, 4);
+    TEST_CHECK(pattern_cache_get_results(pat, m, got, 4));
+    TEST_CHECK(memcmp(got, set, sizeof(set)) == 0);
+
+    /* wrong mailbox or wrong message count must miss */
+    TEST_CHECK(!pattern_cache_get_results(pat, (struct Mailbox *) &set, got, 4));
+    TEST_CHECK(!pattern_cache_get_results(pat, m, got, 3));
+
+    pattern_cache_release(&pat);
+  }
+
+  { /* results of runtime date ranges are never kept */
+    struct PatternList *pat =
+        pattern_cache_comp(NULL, NULL, "~d >1w", MUTT_PC_NO_FLAGS, &err);
+    TEST_CHECK(pat != NULL);
+
+    bool set[2] = { true, true };
+    bool got[2] = { false, false };
+
+    pattern_cache_set_results(pat, m, set, 2);
+    TEST_CHECK(!pattern_cache_get_results(pat, m, got, 2));
+
+    pattern_cache_release(&pat);
+  }
+
+  { /* a failed compile isn't cached */
+    mutt_buffer_reset(&err);
+    struct PatternList *bad =
+        pattern_cache_comp(NULL, NULL, "x", MUTT_PC_NO_FLAGS, &err);
+    TEST_CHECK(bad == NULL);
+
+    struct PatternList *good =
+        pattern_cache_comp(NULL, NULL, "~f neomutt", MUTT_PC_NO_FLAGS, &err);
+    TEST_CHECK(good != NULL);
+    pattern_cache_release(&good);
+  }
+
+  mutt_pattern_cache_cleanup();
+  mutt_buffer_dealloc(&err);
+}
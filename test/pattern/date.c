@@ -0,0 +1,134 @@
+/**
+ * @file
+ * Test code for the sorted date index
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "pattern/lib.h"
+#include "test_common.h"
+
+static struct ConfigDef Vars[] = {
+  // clang-format off
+  { "pattern_date_index", DT_BOOL, false, 0, NULL, NULL },
+  { "pattern_trigram_index", DT_BOOL, false, 0, NULL, NULL },
+  { "pattern_flag_index", DT_BOOL, false, 0, NULL, NULL },
+  { NULL },
+  // clang-format on
+};
+
+/**
+ * add_email - Add a fake Email with the given dates to a Mailbox
+ */
+static void add_email(struct Mailbox *m, time_t sent, time_t received, const char *subject)
+{
+  struct Email *e = email_new();
+  e->env = mutt_env_new();
+  e->env->subject = mutt_str_dup(subject);
+  e->date_sent = sent;
+  e->received = received;
+  m->emails[m->msg_count++] = e;
+}
+
+/**
+ * candidates - Shorthand: compile a pattern and ask the indices for candidates
+ */
+static bool candidates(struct Mailbox *m, const char *s, PatternCompFlags flags, bool *cand)
+{
+  struct Buffer err = mutt_buffer_make(256);
+  struct PatternList *pat = mutt_pattern_comp(NULL, NULL, s, flags, &err);
+  TEST_CHECK(pat != NULL);
+  TEST_MSG("%s: %s", s, mutt_buffer_string(&err));
+
+  bool rc = mutt_trigram_candidates(m, pat, cand, m->msg_count);
+
+  mutt_pattern_free(&pat);
+  mutt_buffer_dealloc(&err);
+  return rc;
+}
+
+void test_pattern_date_index(void)
+{
+  NeoMutt = test_neomutt_create();
+  cs_register_variables(NeoMutt->sub->cs, Vars, 0);
+
+  const time_t now = mutt_date_epoch();
+  const time_t day = 24 * 60 * 60;
+
+  struct Mailbox *m = mailbox_new();
+  m->emails = mutt_mem_calloc(8, sizeof(struct Email *));
+  m->email_max = 8;
+
+  /* deliberately not in date order */
+  add_email(m, now - (30 * day), now - (29 * day), "old report");
+  add_email(m, now - (1 * day) + 600, now - (1 * day) + 700, "recent lunch");
+  add_email(m, now - (400 * day), now - (399 * day), "ancient scroll");
+  add_email(m, now - (2 * day), now - (40 * day), "recent but slow post");
+  m->msg_count++; /* a NULL slot, as after an expunge */
+
+  bool cand[8];
+
+  { /* disabled by default */
+    TEST_CHECK(!candidates(m, "~d <1w", MUTT_PC_NO_FLAGS, cand));
+  }
+
+  cs_subset_str_string_set(NeoMutt->sub, "pattern_date_index", "yes", NULL);
+
+  { /* ~d finds exactly the messages sent inside the range */
+    TEST_CHECK(candidates(m, "~d <1w", MUTT_PC_NO_FLAGS, cand));
+    TEST_CHECK(!cand[0] && cand[1] && !cand[2] && cand[3] && !cand[4]);
+
+    TEST_CHECK(candidates(m, "~d >2w", MUTT_PC_NO_FLAGS, cand));
+    TEST_CHECK(cand[0] && !cand[1] && cand[2] && !cand[3]);
+  }
+
+  { /* ~r uses the received dates */
+    TEST_CHECK(candidates(m, "~r <1w", MUTT_PC_NO_FLAGS, cand));
+    TEST_CHECK(!cand[0] && cand[1] && !cand[2] && !cand[3]);
+  }
+
+  { /* dynamic ranges are re-evaluated before the search */
+    TEST_CHECK(candidates(m, "~d <1w", MUTT_PC_PATTERN_DYNAMIC, cand));
+    TEST_CHECK(!cand[0] && cand[1] && !cand[2] && cand[3]);
+  }
+
+  { /* a negated range can't use the index */
+    TEST_CHECK(!candidates(m, "!~d <1w", MUTT_PC_NO_FLAGS, cand));
+  }
+
+  { /* combining with the trigram index narrows further */
+    cs_subset_str_string_set(NeoMutt->sub, "pattern_trigram_index", "yes", NULL);
+    TEST_CHECK(candidates(m, "~d <1w ~s lunch", MUTT_PC_NO_FLAGS, cand));
+    TEST_CHECK(!cand[0] && cand[1] && !cand[2] && !cand[3]);
+  }
+
+  mutt_date_index_cleanup();
+  mutt_trigram_cleanup();
+  mailbox_free(&m); /* frees the Emails too */
+  test_neomutt_destroy(&NeoMutt);
+}
@@ -78,6 +78,11 @@ int crypt_valid_passphrase(int flags)
   return 0;
 }
 
+int imap_fetch_structure(struct Mailbox *m, struct Email *e)
+{
+  return -1;
+}
+
 bool imap_search(struct Mailbox *m, const struct Pattern *pat)
 {
   return false;
@@ -134,6 +139,23 @@ void mutt_set_flag_update(struct Mailbox *m, struct Email *e, int flag, bool bf,
 {
 }
 
+void mutt_flag_batch_begin(void)
+{
+}
+
+void mutt_flag_batch_end(struct Mailbox *m)
+{
+}
+
+void mutt_score_require(struct Mailbox *m, struct Email *e)
+{
+}
+
+struct HashTable *mutt_make_id_hash(struct Mailbox *m)
+{
+  return NULL;
+}
+
 int mx_msg_close(struct Mailbox *m, struct Message **msg)
 {
   return 0;
@@ -0,0 +1,131 @@
+/**
+ * @file
+ * Test code for the packed flag bitmaps
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "pattern/lib.h"
+#include "test_common.h"
+
+static struct ConfigDef Vars[] = {
+  // clang-format off
+  { "pattern_flag_index", DT_BOOL, false, 0, NULL, NULL },
+  { "pattern_trigram_index", DT_BOOL, false, 0, NULL, NULL },
+  { "pattern_date_index", DT_BOOL, false, 0, NULL, NULL },
+  { NULL },
+  // clang-format on
+};
+
+/**
+ * add_email - Add a fake Email with the given flags to a Mailbox
+ */
+static void add_email(struct Mailbox *m, bool read, bool old, bool flagged)
+{
+  struct Email *e = email_new();
+  e->env = mutt_env_new();
+  e->read = read;
+  e->old = old;
+  e->flagged = flagged;
+  m->emails[m->msg_count++] = e;
+}
+
+/**
+ * candidates - Shorthand: compile a pattern and ask the indices for candidates
+ */
+static bool candidates(struct Mailbox *m, const char *s, bool *cand)
+{
+  struct Buffer err = mutt_buffer_make(256);
+  struct PatternList *pat = mutt_pattern_comp(NULL, NULL, s, MUTT_PC_NO_FLAGS, &err);
+  TEST_CHECK(pat != NULL);
+  TEST_MSG("%s: %s", s, mutt_buffer_string(&err));
+
+  memset(cand, true, m->msg_count * sizeof(bool));
+  bool rc = mutt_trigram_candidates(m, pat, cand, m->msg_count);
+
+  mutt_pattern_free(&pat);
+  mutt_buffer_dealloc(&err);
+  return rc;
+}
+
+void test_pattern_flag_index(void)
+{
+  NeoMutt = test_neomutt_create();
+  cs_register_variables(NeoMutt->sub->cs, Vars, 0);
+
+  struct Mailbox *m = mailbox_new();
+  m->emails = mutt_mem_calloc(8, sizeof(struct Email *));
+  m->email_max = 8;
+
+  add_email(m, false, false, false); /* new */
+  add_email(m, true, false, true);   /* read, flagged */
+  add_email(m, false, true, false);  /* old */
+  add_email(m, true, true, false);   /* read (old is ignored once read) */
+
+  bool cand[8];
+
+  { /* disabled by default */
+    TEST_CHECK(!candidates(m, "~N", cand));
+  }
+
+  cs_subset_str_string_set(NeoMutt->sub, "pattern_flag_index", "yes", NULL);
+
+  { /* each op mirrors the executor's comparison */
+    TEST_CHECK(candidates(m, "~N", cand));
+    TEST_CHECK(cand[0] && !cand[1] && !cand[2] && !cand[3]);
+
+    TEST_CHECK(candidates(m, "~O", cand));
+    TEST_CHECK(!cand[0] && !cand[1] && cand[2] && !cand[3]);
+
+    TEST_CHECK(candidates(m, "~U", cand));
+    TEST_CHECK(cand[0] && !cand[1] && cand[2] && !cand[3]);
+
+    TEST_CHECK(candidates(m, "~F", cand));
+    TEST_CHECK(!cand[0] && cand[1] && !cand[2] && !cand[3]);
+  }
+
+  { /* the bitmaps are exact, so negation works too */
+    TEST_CHECK(candidates(m, "!~F", cand));
+    TEST_CHECK(cand[0] && !cand[1] && cand[2] && cand[3]);
+  }
+
+  { /* conjunctions intersect the bitmaps */
+    TEST_CHECK(candidates(m, "~U ~F", cand));
+    TEST_CHECK(!cand[0] && !cand[1] && !cand[2] && !cand[3]);
+  }
+
+  { /* a changed mailbox rebuilds the bitmaps */
+    add_email(m, false, false, true); /* new, flagged */
+    TEST_CHECK(candidates(m, "~F", cand));
+    TEST_CHECK(!cand[0] && cand[1] && !cand[2] && !cand[3] && cand[4]);
+  }
+
+  mutt_flag_index_cleanup();
+  mutt_trigram_cleanup();
+  mailbox_free(&m); /* frees the Emails too */
+  test_neomutt_destroy(&NeoMutt);
+}
@@ -0,0 +1,131 @@
+/**
+ * @file
+ * Test code for the trigram index over message headers
+ *
+ * @authors
+ * Copyright (C) 2022 Richard Russon <rich@flatcap.org>
+ *
+ * @copyright
+ * This program is free software: you can redistribute it and/or modify it under
+ * the terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 2 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define TEST_NO_MAIN
+#include "config.h"
+#include "acutest.h"
+#include <stdbool.h>
+#include <string.h>
+#include "mutt/lib.h"
+#include "address/lib.h"
+#include "config/lib.h"
+#include "email/lib.h"
+#include "core/lib.h"
+#include "pattern/lib.h"
+#include "test_common.h"
+
+static struct ConfigDef Vars[] = {
+  // clang-format off
+  { "pattern_date_index", DT_BOOL, false, 0, NULL, NULL },
+  { "pattern_trigram_index", DT_BOOL, false, 0, NULL, NULL },
+  { "pattern_flag_index", DT_BOOL, false, 0, NULL, NULL },
+  { NULL },
+  // clang-format on
+};
+
+/**
+ * add_email - Add a fake Email to a Mailbox
+ */
+static void add_email(struct Mailbox *m, const char *from, const char *subject)
+{
+  struct Email *e = email_new();
+  e->env = mutt_env_new();
+  if (from)
+    mutt_addrlist_parse(&e->env->from, from);
+  e->env->subject = mutt_str_dup(subject);
+  m->emails[m->msg_count++] = e;
+}
+
+/**
+ * candidates - Shorthand: compile a pattern and ask the index for candidates
+ */
+static bool candidates(struct Mailbox *m, const char *s, bool *cand)
+{
+  struct Buffer err = mutt_buffer_make(256);
+  struct PatternList *pat = mutt_pattern_comp(NULL, NULL, s, MUTT_PC_NO_FLAGS, &err);
+  TEST_CHECK(pat != NULL);
+  TEST_MSG("%s: %s", s, mutt_buffer_string(&err));
+
+  bool rc = mutt_trigram_candidates(m, pat, cand, m->msg_count);
+
+  mutt_pattern_free(&pat);
+  mutt_buffer_dealloc(&err);
+  return rc;
+}
+
+void test_pattern_trigram(void)
+{
+  NeoMutt = test_neomutt_create();
+  cs_register_variables(NeoMutt->sub->cs, Vars, 0);
+
+  struct Mailbox *m = mailbox_new();
+  m->emails = mutt_mem_calloc(8, sizeof(struct Email *));
+  m->email_max = 8;
+
+  add_email(m, "Alice Agreeable <alice@example.com>", "meeting minutes");
+  add_email(m, "Bob <bob@example.com>", "lunch plans");
+  add_email(m, "Carol <carol@example.net>", "Alice in wonderland");
+  add_email(m, "<dave@malice.org>", "grudge report");
+  m->msg_count++; /* a NULL slot, as after an expunge */
+
+  bool cand[8];
+
+  { /* disabled by default */
+    TEST_CHECK(!candidates(m, "~f alice", cand));
+  }
+
+  cs_subset_str_string_set(NeoMutt->sub, "pattern_trigram_index", "yes", NULL);
+
+  { /* plain ~f narrows to messages whose From contains the trigrams */
+    TEST_CHECK(candidates(m, "~f alice", cand));
+    TEST_CHECK(cand[0]);  /* alice@example.com */
+    TEST_CHECK(!cand[1]);
+    TEST_CHECK(!cand[2]); /* "Alice" only in the Subject */
+    TEST_CHECK(cand[3]);  /* m-alice-.org really does contain "alice" */
+    TEST_CHECK(!cand[4]); /* the NULL slot can never be a candidate */
+  }
+
+  { /* ~s looks at the Subject index, case-folded */
+    TEST_CHECK(candidates(m, "~s alice", cand));
+    TEST_CHECK(!cand[0] && !cand[1] && cand[2] && !cand[3]);
+  }
+
+  { /* AND narrows, OR unions */
+    TEST_CHECK(candidates(m, "~f alice ~s meeting", cand));
+    TEST_CHECK(cand[0] && !cand[1] && !cand[2] && !cand[3]);
+
+    TEST_CHECK(candidates(m, "~f alice | ~s lunch", cand));
+    TEST_CHECK(cand[0] && cand[1] && !cand[2] && cand[3]);
+  }
+
+  { /* anything the index can't bound must fall back to a full scan */
+    TEST_CHECK(!candidates(m, "!~f alice", cand));   /* negation */
+    TEST_CHECK(!candidates(m, "~s al.ce", cand));    /* real regex */
+    TEST_CHECK(!candidates(m, "~s ab", cand));       /* too short */
+    TEST_CHECK(!candidates(m, "~N", cand));          /* not indexed */
+    TEST_CHECK(!candidates(m, "~N | ~s lunch", cand)); /* unbounded alternative */
+  }
+
+  mutt_trigram_cleanup();
+  mailbox_free(&m); /* frees the Emails too */
+  test_neomutt_destroy(&NeoMutt);
+}
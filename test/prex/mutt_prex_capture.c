@@ -23,8 +23,114 @@
 #define TEST_NO_MAIN
 #include "config.h"
 #include "acutest.h"
+#include <string.h>
+#include "mutt/lib.h"
+
+/**
+ * check_capture - Check that a capture group matched the expected text
+ * @param matches  Matches returned by mutt_prex_capture()
+ * @param str      String the regex was applied to
+ * @param idx      Capture group to check
+ * @param expected Expected text, or NULL if the group shouldn't participate
+ */
+static bool check_capture(const regmatch_t *matches, const char *str, int idx,
+                          const char *expected)
+{
+  const regmatch_t *m = &matches[idx];
+  if (!expected)
+    return (m->rm_so == -1) && (m->rm_eo == -1);
+
+  const size_t len = strlen(expected);
+  return (m->rm_so >= 0) && ((size_t) (m->rm_eo - m->rm_so) == len) &&
+         (strncmp(str + m->rm_so, expected, len) == 0);
+}
 
 void test_mutt_prex_capture(void)
 {
   // regmatch_t *mutt_prex_capture(enum Prex which, const char *str);
+
+  {
+    const char *str = "From god@heaven.af.mil Sat Jan  3 01:05:34 1996";
+    regmatch_t *m = mutt_prex_capture(PREX_MBOX_FROM, str);
+    TEST_CHECK(m != NULL);
+    TEST_CHECK(check_capture(m, str, PREX_MBOX_FROM_MATCH_FULL, str));
+    TEST_CHECK(check_capture(m, str, PREX_MBOX_FROM_MATCH_ENVSENDER, "god@heaven.af.mil"));
+    TEST_CHECK(check_capture(m, str, PREX_MBOX_FROM_MATCH_DOW, "Sat"));
+    TEST_CHECK(check_capture(m, str, PREX_MBOX_FROM_MATCH_MONTH, "Jan"));
+    TEST_CHECK(check_capture(m, str, PREX_MBOX_FROM_MATCH_DAY1, "3"));
+    TEST_CHECK(check_capture(m, str, PREX_MBOX_FROM_MATCH_DAY2, NULL));
+    TEST_CHECK(check_capture(m, str, PREX_MBOX_FROM_MATCH_TIME, "01:05:34"));
+    TEST_CHECK(check_capture(m, str, PREX_MBOX_FROM_MATCH_YEAR, "1996"));
+  }
+
+  {
+    const char *str = "From a@b Mon Mar 10 01:05:34 1996";
+    regmatch_t *m = mutt_prex_capture(PREX_MBOX_FROM, str);
+    TEST_CHECK(m != NULL);
+    TEST_CHECK(check_capture(m, str, PREX_MBOX_FROM_MATCH_DAY1, NULL));
+    TEST_CHECK(check_capture(m, str, PREX_MBOX_FROM_MATCH_DAY2, "10"));
+  }
+
+  {
+    TEST_CHECK(!mutt_prex_capture(PREX_MBOX_FROM, "From here to eternity"));
+  }
+
+  {
+    const char *str = "Mon, 16 Mar 2020 15:09:35 -0700";
+    regmatch_t *m = mutt_prex_capture(PREX_RFC5322_DATE, str);
+    TEST_CHECK(m != NULL);
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_FULL, str));
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_DOW, "Mon"));
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_DAY, "16"));
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_MONTH, "Mar"));
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_YEAR, "2020"));
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_HOUR, "15"));
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_MINUTE, "09"));
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_SECOND, "35"));
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_TZ, "-0700"));
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_TZ_OBS, NULL));
+  }
+
+  {
+    // No day of week, no seconds, obsolete timezone
+    const char *str = "16 Mar 2020 15:09 UT";
+    regmatch_t *m = mutt_prex_capture(PREX_RFC5322_DATE, str);
+    TEST_CHECK(m != NULL);
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_MAYBE_DOW, NULL));
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_COLONSECOND, NULL));
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_SECOND, NULL));
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_TZ, NULL));
+    TEST_CHECK(check_capture(m, str, PREX_RFC5322_DATE_MATCH_TZ_OBS, "UT"));
+  }
+
+  {
+    TEST_CHECK(!mutt_prex_capture(PREX_RFC5322_DATE, "not a date"));
+  }
+
+  {
+    const char *str = "16-Mar-2020 15:09:35 -0700";
+    regmatch_t *m = mutt_prex_capture(PREX_IMAP_DATE, str);
+    TEST_CHECK(m != NULL);
+    TEST_CHECK(check_capture(m, str, PREX_IMAP_DATE_MATCH_DAY2, "16"));
+    TEST_CHECK(check_capture(m, str, PREX_IMAP_DATE_MATCH_MONTH, "Mar"));
+    TEST_CHECK(check_capture(m, str, PREX_IMAP_DATE_MATCH_YEAR, "2020"));
+    TEST_CHECK(check_capture(m, str, PREX_IMAP_DATE_MATCH_TIME, "15:09:35"));
+    TEST_CHECK(check_capture(m, str, PREX_IMAP_DATE_MATCH_TZ, "-0700"));
+  }
+
+  {
+    const char *str = " 4-Mar-2020 15:09:35 -0700";
+    regmatch_t *m = mutt_prex_capture(PREX_IMAP_DATE, str);
+    TEST_CHECK(m != NULL);
+    TEST_CHECK(check_capture(m, str, PREX_IMAP_DATE_MATCH_DAY1, "4"));
+    TEST_CHECK(check_capture(m, str, PREX_IMAP_DATE_MATCH_DAY2, NULL));
+  }
+
+  {
+    // The scanner only matches at the start - the regex finds this one
+    const char *str = "xx16-Mar-2020 15:09:35 -0700";
+    regmatch_t *m = mutt_prex_capture(PREX_IMAP_DATE, str);
+    TEST_CHECK(m != NULL);
+    TEST_CHECK(m[PREX_IMAP_DATE_MATCH_FULL].rm_so == 2);
+  }
 }
@@ -58,4 +58,36 @@ void test_mutt_qsort_r(void)
   TEST_CHECK(array[0] == 3);
   TEST_CHECK(array[1] == 2);
   TEST_CHECK(array[2] == 1);
+
+  // Large arrays exercise the presorted-prefix fast paths
+  int big[100];
+  exparg = NULL;
+
+  // already sorted
+  for (int i = 0; i < 100; i++)
+    big[i] = i;
+  mutt_qsort_r(big, 100, sizeof(int), compare_ints, exparg);
+  for (int i = 0; i < 100; i++)
+    TEST_CHECK(big[i] == i);
+
+  // a few unsorted newcomers at the end get merged into the run
+  for (int i = 0; i < 95; i++)
+    big[i] = i * 2;
+  big[95] = 3;
+  big[96] = 189;
+  big[97] = 1;
+  big[98] = 100;
+  big[99] = 50;
+  mutt_qsort_r(big, 100, sizeof(int), compare_ints, exparg);
+  for (int i = 0; i < 99; i++)
+    TEST_CHECK(big[i] <= big[i + 1]);
+  TEST_CHECK(big[0] == 0);
+  TEST_CHECK(big[99] == 189);
+
+  // fully reversed input falls back to a full sort
+  for (int i = 0; i < 100; i++)
+    big[i] = 100 - i;
+  mutt_qsort_r(big, 100, sizeof(int), compare_ints, exparg);
+  for (int i = 0; i < 100; i++)
+    TEST_CHECK(big[i] == i + 1);
 }
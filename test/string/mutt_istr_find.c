@@ -77,4 +77,16 @@ void test_mutt_istr_find(void)
       TEST_CHECK(result == (t->str + t->offset));
     }
   }
+
+  {
+    // Haystack shorter than the needle
+    TEST_CHECK(mutt_istr_find("app", "apple") == NULL);
+  }
+
+  {
+    // Non-ASCII needles still work, using the locale's case rules
+    const char *haystack = "TEXTr\xc3\xa9sum\xc3\xa9TEXT";
+    TEST_CHECK(mutt_istr_find(haystack, "r\xc3\xa9sum\xc3\xa9") == (haystack + 4));
+    TEST_CHECK(mutt_istr_find(haystack, "R\xc3\xa9SUM\xc3\xa9") == (haystack + 4));
+  }
 }